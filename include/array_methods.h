@@ -1,25 +1,42 @@
 #pragma once
 
 #include "value.h"
+#include <span>
 #include <vector>
 
 namespace lightjs {
 
-// Array prototype methods
-Value Array_push(const std::vector<Value>& args);
-Value Array_pop(const std::vector<Value>& args);
-Value Array_shift(const std::vector<Value>& args);
-Value Array_unshift(const std::vector<Value>& args);
-Value Array_slice(const std::vector<Value>& args);
-Value Array_splice(const std::vector<Value>& args);
-Value Array_join(const std::vector<Value>& args);
-Value Array_indexOf(const std::vector<Value>& args);
-Value Array_includes(const std::vector<Value>& args);
-Value Array_reverse(const std::vector<Value>& args);
-Value Array_concat(const std::vector<Value>& args);
-Value Array_map(const std::vector<Value>& args);
-Value Array_filter(const std::vector<Value>& args);
-Value Array_reduce(const std::vector<Value>& args);
-Value Array_forEach(const std::vector<Value>& args);
+// Array prototype methods, in the FastNativeFunction convention: `this` is
+// passed separately and errors are reported through `thrown`.
+Value Array_push(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                 NativeThrow& thrown);
+Value Array_pop(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                NativeThrow& thrown);
+Value Array_shift(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                  NativeThrow& thrown);
+Value Array_unshift(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                    NativeThrow& thrown);
+Value Array_slice(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                  NativeThrow& thrown);
+Value Array_splice(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                   NativeThrow& thrown);
+Value Array_join(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                 NativeThrow& thrown);
+Value Array_indexOf(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                    NativeThrow& thrown);
+Value Array_includes(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                     NativeThrow& thrown);
+Value Array_reverse(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                    NativeThrow& thrown);
+Value Array_concat(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                   NativeThrow& thrown);
+Value Array_map(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                NativeThrow& thrown);
+Value Array_filter(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                   NativeThrow& thrown);
+Value Array_reduce(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                   NativeThrow& thrown);
+Value Array_forEach(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                    NativeThrow& thrown);
 
-} // namespace lightjs
\ No newline at end of file
+} // namespace lightjs
@@ -26,8 +26,35 @@ struct Statement;
 using ExprPtr = std::unique_ptr<Expression>;
 using StmtPtr = std::unique_ptr<Statement>;
 
+class Environment;
+struct SharedFunctionInfo;
+
+// Inline cache for a name that resolved to a binding of the global (root)
+// scope: the root and the binding's slot there. Every scope knows its root,
+// so a hit reads the binding without walking the scope chain.
+struct GlobalBindingCache {
+  static constexpr uint32_t kNotGlobal = UINT32_MAX;  // Resolves below the root
+  const Environment* root = nullptr;
+  uint32_t slot = kNotGlobal;
+};
+
 struct Identifier {
   std::string name;
+  // Atom for `name`, filled in by resolveScopes() (or on first lookup for
+  // nodes that were built without it).
+  mutable Atom atom = kNoAtom;
+  // Set by resolveScopes() when no enclosing scope contains a direct eval or
+  // a with statement, so a read always resolves to the same (hops, slot)
+  // position in the environment chain. The position is cached on the first
+  // lookup and re-validated on every hit (see Environment::slotValue).
+  bool staticScope = false;
+  mutable uint32_t scopeHops = UINT32_MAX;
+  mutable uint32_t scopeSlot = 0;
+  // Static references to globals are served from this instead.
+  mutable GlobalBindingCache globalCache;
+  // Set by resolveScopes() when the binding's declaration always runs
+  // before this reference, so reads and writes skip the TDZ check.
+  bool tdzFree = false;
 };
 
 struct NumberLiteral {
@@ -184,6 +211,10 @@ struct FunctionExpr {
   bool isGenerator;  // Generator function (function*)
   bool isArrow;  // Arrow function expression (e.g., (x) => x * 2)
   bool isMethod;  // Concise object/class method semantics
+  // Cleared by resolveScopes() when calls never need an arguments object.
+  bool usesArguments = true;
+  // Template shared by every closure created from this node, built on first evaluation.
+  mutable std::shared_ptr<const SharedFunctionInfo> sharedInfo;
   FunctionExpr() : isAsync(false), isGenerator(false), isArrow(false), isMethod(false) {}
 };
 
@@ -215,6 +246,8 @@ struct MethodDefinition {
   bool isGenerator;
   bool isPrivate;
   bool computed;
+  bool usesArguments = true;  // See FunctionExpr::usesArguments
+  mutable std::shared_ptr<const SharedFunctionInfo> sharedInfo;  // See FunctionExpr::sharedInfo
   MethodDefinition()
       : kind(Kind::Method),
         isStatic(false),
@@ -302,6 +335,9 @@ struct Expression {
 
   SourceLocation loc;
   bool parenthesized = false;
+  // Cleared by resolveScopes() when the subtree has no yield/await outside
+  // nested functions; such expressions are evaluated without coroutine frames.
+  bool canSuspend = true;
 
   template<typename T>
   Expression(T&& n) : node(std::forward<T>(n)) {}
@@ -327,6 +363,8 @@ struct FunctionDeclaration {
   std::string sourceText;  // Original source text for Function.prototype.toString
   bool isAsync;
   bool isGenerator;  // Generator function (function*)
+  bool usesArguments = true;  // See FunctionExpr::usesArguments
+  mutable std::shared_ptr<const SharedFunctionInfo> sharedInfo;  // See FunctionExpr::sharedInfo
   FunctionDeclaration() : isAsync(false), isGenerator(false) {}
 };
 
@@ -366,6 +404,10 @@ struct ForStmt {
   ExprPtr test;
   ExprPtr update;
   StmtPtr body;
+  // Cleared by resolveScopes() when nothing in the loop can capture its let
+  // bindings (no function, class or direct eval), so one environment serves
+  // every iteration instead of a fresh copy per iteration.
+  bool perIterationBindings = true;
 };
 
 struct WithStmt {
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "ast.h"
+#include "value.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace lightjs {
+
+/**
+ * Register-based bytecode for hot ordinary functions.
+ *
+ * A BytecodeFunction is compiled from a Function's AST body the first time
+ * the function gets hot (see Interpreter::prepareBytecode). Every local
+ * binding (parameters, vars, block-scoped let/const) lives in a numbered
+ * register of the frame, so the VM never creates an Environment for the
+ * call. Names that are not local (globals, outer closure bindings) are
+ * still resolved through the closure environment.
+ *
+ * Only a subset of the language is compiled; anything else (nested
+ * functions, arguments, eval, try, generators, ...) keeps the function on
+ * the tree walker. See compileFunctionBytecode().
+ *
+ * Operand conventions: `a` is the destination register unless noted,
+ * `b`/`c` are source registers, constant indices or name indices.
+ */
+enum class Opcode : uint8_t {
+  LoadConst,         // a = constants[b]
+  LoadUndefined,     // a = undefined
+  LoadEmpty,         // a = <uninitialized> (start of a let/const TDZ)
+  Move,              // a = b
+  LoadThis,          // a = this
+  CheckInit,         // throw ReferenceError if a is uninitialized; b = name
+  LoadName,          // a = lookup(names[b]) through the closure environment
+  TypeofName,        // a = typeof names[b] (unresolvable -> "undefined")
+  LoadCallee,        // a = callee for names[b], a + 1 = its this value
+  Binary,            // a = b <sub:BinaryExpr::Op> c
+  Unary,             // a = <sub:UnaryExpr::Op> b
+  Compound,          // a = b <sub:AssignmentExpr::Op> c
+  Update,            // a = b +/- 1 (sub:UpdateExpr::Op), c = ToNumeric(b)
+  GetProp,           // a = b[names[c]]
+  GetElem,           // a = b[c]
+  SetProp,           // a[names[b]] = c
+  SetElem,           // a[b] = c
+  NewObject,         // a = {}
+  InitProp,          // define a[names[b]] = c on a fresh object literal
+  NewArray,          // a = [b, b + 1, ..., b + c - 1]
+  Call,              // a = b(b + 2, ..., b + 1 + c) with this = b + 1
+  TailCall,          // return b(...) reusing the frame for strict self-calls
+  New,               // a = new b(b + 1, ..., b + c)
+  Jump,              // pc = a
+  JumpIfFalse,       // if !ToBoolean(b) pc = a
+  JumpIfTrue,        // if ToBoolean(b) pc = a
+  JumpIfNotNullish,  // if b is neither null nor undefined pc = a
+  LoopInit,          // a = 0 (loop iteration counter)
+  LoopCheck,         // ++a, throw RangeError past the iteration limit
+  Throw,             // throw a
+  ThrowConstAssign,  // throw TypeError for assignment to const names[a]
+  Return,            // return a
+};
+
+struct Instruction {
+  Opcode op;
+  uint8_t sub = 0;
+  uint32_t a = 0;
+  uint32_t b = 0;
+  uint32_t c = 0;
+};
+
+struct BytecodeFunction {
+  std::vector<Instruction> code;
+  std::vector<SourceLocation> locations;  // Parallel to code, for error messages
+  std::vector<Value> constants;
+  std::vector<std::string> names;
+  // Inline caches for GetProp, one per name (parallel to names).
+  mutable std::vector<PropertyCache> propertyCaches;
+  // Global binding caches for LoadName and LoadCallee (parallel to names).
+  // A name's atom is kNoAtom when its cache must not be used.
+  std::vector<Atom> globalNameAtoms;
+  mutable std::vector<GlobalBindingCache> globalCaches;
+  uint32_t registerCount = 0;
+  uint32_t paramCount = 0;
+  // Registers [paramCount, varEnd) hold hoisted vars (initialized to
+  // undefined); the rest start out uninitialized.
+  uint32_t varEnd = 0;
+  bool usesThis = false;
+  bool lexicalThis = false;  // Arrow function: `this` comes from the closure
+};
+
+// Compile the body of an ordinary (non-async, non-generator) function.
+// Returns nullptr when the function uses a construct the VM does not handle.
+std::shared_ptr<BytecodeFunction> compileFunctionBytecode(const Function& func);
+
+} // namespace lightjs
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "value.h"
+#include "ast.h"
 #include <unordered_map>
 #include <memory>
 #include <optional>
+#include <vector>
 
 namespace lightjs {
 
@@ -15,6 +17,21 @@ class Interpreter;
 void setGlobalModuleLoader(std::shared_ptr<ModuleLoader> loader);
 void setGlobalInterpreter(Interpreter* interpreter);
 Interpreter* getGlobalInterpreter();
+// Makes `interpreter` the global interpreter while a native runs, so the
+// builtins and callbacks it reaches through getGlobalInterpreter() run on
+// the interpreter that called it; the previous one is restored on exit.
+class GlobalInterpreterScope {
+public:
+  explicit GlobalInterpreterScope(Interpreter* interpreter) : previous_(getGlobalInterpreter()) {
+    setGlobalInterpreter(interpreter);
+  }
+  ~GlobalInterpreterScope() { setGlobalInterpreter(previous_); }
+  GlobalInterpreterScope(const GlobalInterpreterScope&) = delete;
+  GlobalInterpreterScope& operator=(const GlobalInterpreterScope&) = delete;
+
+private:
+  Interpreter* previous_;
+};
 void setGlobalArrayPrototype(const Value& proto);
 Value getGlobalArrayPrototype();
 GCPtr<Array> makeArrayWithPrototype();
@@ -24,6 +41,7 @@ class Environment : public GCObject, public std::enable_shared_from_this<Environ
 public:
   Environment() = default;
   explicit Environment(Environment* parent);
+  ~Environment() override;
 
   void define(const std::string& name, const Value& value, bool isConst = false);
   // Set binding directly without syncing to globalThis (for hoisting existing properties)
@@ -61,24 +79,113 @@ public:
   // Resolve where a name would be written (returns with-scope object if applicable)
   GCPtr<Object> resolveWithScopeObject(const std::string& name) const;
 
+  // Find the scope coordinates (parent hops, slot) of the declarative binding
+  // for `name`. Fails when the name is unbound or a with-scope object sits
+  // between this scope and the binding.
+  bool resolveSlot(Atom name, uint32_t& hops, uint32_t& slot) const;
+  // Read the binding at previously resolved coordinates. Returns nullptr when
+  // the coordinates no longer name `name` (different scope layout, deleted
+  // binding, with-scope in between); the caller falls back to a by-name lookup.
+  const Value* slotValue(uint32_t hops, uint32_t slot, Atom name,
+                         bool& inTDZ) const;
+  // Global bindings are read straight from the root scope. resolveGlobal
+  // fills `cache` when `name` resolves to a root binding, or marks it as
+  // resolving below the root so later misses skip the walk. globalSlotValue
+  // reads through a filled cache and returns nullptr when it does not apply
+  // (other realm, binding deleted); the binding slot itself acts as the
+  // global's property cell.
+  bool resolveGlobal(Atom name, GlobalBindingCache& cache) const;
+  const Value* globalSlotValue(const GlobalBindingCache& cache, Atom name,
+                               bool& inTDZ) const;
+
   static GCPtr<Environment> createGlobal();
   GCPtr<Environment> createChild();
   Environment* getParent() const { return parent_.get(); }
   GCPtr<Environment> getParentPtr() const { return parent_; }
   GCPtr<Object> getGlobal() const;
-  Environment* getRoot();
+  Environment* getRoot() const { return root_; }
+  // Function scopes are marked as variable environments so that direct eval
+  // can find where its var declarations belong.
+  void markVarScope() { isVarScope_ = true; }
+  bool isVarScope() const { return isVarScope_; }
 
   // GCObject interface
   const char* typeName() const override { return "Environment"; }
   void getReferences(std::vector<GCObject*>& refs) const override;
+  void clearReferences() override;
 
 private:
+  enum BindingFlag : uint8_t {
+    kConstBinding = 1 << 0,
+    kSilentImmutableBinding = 1 << 1,  // NFE name bindings
+    kTDZBinding = 1 << 2,  // temporal dead zone
+    kLexicalBinding = 1 << 3,
+  };
+
+  struct Binding {
+    Value value;
+    Atom name;  // kNoAtom once deleted
+    uint8_t flags;  // BindingFlag bits
+  };
+
+  // Scopes this small are searched linearly instead of through slotIndex_.
+  static constexpr size_t kLinearScanLimit = 8;
+
+  // Block, call and loop scopes are created and dropped constantly. The
+  // object itself comes from the GC arena; a scope that dies without being
+  // captured hands its binding array to the next scope created through
+  // this free list. Defined in environment.cc.
+  struct Pool;
+  static Pool& pool();
+
+  int findSlot(Atom atom) const;
+  Value* findBinding(const std::string& name);
+  const Value* findBinding(const std::string& name) const;
+  // Slot of `name`, appending a fresh slot when the name is unbound.
+  uint32_t bindingSlot(const std::string& name);
+
   GCPtr<Environment> parent_;
-  std::unordered_map<std::string, Value> bindings_;
-  std::unordered_map<std::string, bool> constants_;
-  std::unordered_map<std::string, bool> silentImmutables_;  // NFE name bindings
-  std::unordered_map<std::string, bool> tdzBindings_;  // temporal dead zone
-  std::unordered_map<std::string, bool> lexicalBindings_;
+  Environment* root_ = this;  // Outlives this scope through the parent chain
+  // Bindings live in one flat array keyed by atom. Small scopes are
+  // searched linearly; past kLinearScanLimit slotIndex_ maps atoms to
+  // slots. A slot keeps its index for as long as the binding exists, which
+  // is what lets resolved identifiers address it by (hops, slot).
+  std::unordered_map<Atom, uint32_t> slotIndex_;
+  std::vector<Binding> bindings_;
+  bool hasWithScope_ = false;
+  bool isVarScope_ = false;
 };
 
+inline const Value* Environment::slotValue(uint32_t hops, uint32_t slot,
+                                           Atom name,
+                                           bool& inTDZ) const {
+  const Environment* env = this;
+  for (uint32_t i = 0; i < hops; ++i) {
+    if (env->hasWithScope_ || !env->parent_) {
+      return nullptr;
+    }
+    env = env->parent_.get();
+  }
+  if (slot >= env->bindings_.size()) {
+    return nullptr;
+  }
+  if (env->bindings_[slot].name != name) {
+    return nullptr;
+  }
+  inTDZ = (env->bindings_[slot].flags & kTDZBinding) != 0;
+  return &env->bindings_[slot].value;
+}
+
+inline const Value* Environment::globalSlotValue(const GlobalBindingCache& cache,
+                                                 Atom name,
+                                                 bool& inTDZ) const {
+  const Environment* root = root_;
+  if (cache.root != root || cache.slot >= root->bindings_.size() ||
+      root->bindings_[cache.slot].name != name) {
+    return nullptr;
+  }
+  inTDZ = (root->bindings_[cache.slot].flags & kTDZBinding) != 0;
+  return &root->bindings_[cache.slot].value;
+}
+
 }
@@ -9,22 +9,33 @@
 namespace lightjs {
 
 /**
- * Stack frame for error reporting
+ * Stack frame for error reporting. One is recorded on every call, so it owns
+ * no strings: the function name is taken from its template only when a
+ * trace is formatted.
  */
 struct StackFrame {
-  std::string functionName;     // Function name or "<anonymous>"
-  std::string filename;         // Source filename or "<eval>"
+  const SharedFunctionInfo* function = nullptr;  // Template of the called function, if any
+  const char* label = "<anonymous>";  // Shown when the template has no name
+  const char* filename = "<script>";  // Source filename or "<eval>"
   uint32_t line = 0;           // Line number (1-indexed)
   uint32_t column = 0;         // Column number (1-indexed)
 
-  StackFrame() = default;
-  StackFrame(std::string fn, std::string file, uint32_t l, uint32_t c)
-    : functionName(std::move(fn)), filename(std::move(file)), line(l), column(c) {}
+  std::string functionName() const;
 
   // Format as "at functionName (filename:line:column)"
   std::string toString() const;
 };
 
+/**
+ * Stack captured when an error is thrown: the outermost frames a formatted
+ * trace shows, with their templates pinned, and the full depth.
+ */
+struct CapturedStack {
+  std::vector<StackFrame> frames;
+  std::vector<std::shared_ptr<const SharedFunctionInfo>> functions;  // Keep frames' templates alive
+  size_t depth = 0;
+};
+
 /**
  * Source code context for error display
  */
@@ -72,6 +83,15 @@ public:
     uint32_t errorColumn = 0          // Column where error occurred
   );
 
+  /**
+   * Format a stack captured at throw time, as formatError() would have
+   */
+  static std::string formatCapturedStack(
+    const std::string& errorType,
+    const std::string& message,
+    const CapturedStack* stack
+  );
+
   /**
    * Format source context with line numbers and error marker
    */
@@ -87,6 +107,9 @@ public:
    */
   static std::string createColumnMarker(uint32_t column, uint32_t length = 3);
 
+  // Frames shown before the rest are summarized as "... N more frames"
+  static constexpr size_t MAX_STACK_FRAMES = 10;
+
 private:
   // Get line number width for formatting
   static size_t getLineNumberWidth(uint32_t maxLine);
@@ -103,15 +126,21 @@ public:
   StackTraceManager() = default;
 
   // Push a new stack frame
-  void pushFrame(const StackFrame& frame);
-  void pushFrame(std::string functionName, std::string filename, uint32_t line, uint32_t column);
+  void pushFrame(const StackFrame& frame) { frames_.push_back(frame); }
 
   // Pop the top stack frame
-  void popFrame();
+  void popFrame() {
+    if (!frames_.empty()) {
+      frames_.pop_back();
+    }
+  }
 
   // Get the current stack trace
   const std::vector<StackFrame>& getStackTrace() const { return frames_; }
 
+  // Snapshot for an error being thrown; null when no frames are active
+  std::shared_ptr<const CapturedStack> capture() const;
+
   // Clear the stack trace
   void clear() { frames_.clear(); }
 
@@ -137,12 +166,6 @@ public:
     manager_.pushFrame(frame);
   }
 
-  StackFrameGuard(StackTraceManager& manager, std::string functionName,
-                  std::string filename, uint32_t line, uint32_t column)
-    : manager_(manager) {
-    manager_.pushFrame(std::move(functionName), std::move(filename), line, column);
-  }
-
   ~StackFrameGuard() {
     manager_.popFrame();
   }
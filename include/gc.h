@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <memory>
 #include <unordered_set>
 #include <unordered_map>
@@ -48,38 +49,113 @@ struct GCStats {
     size_t objectCount = 0;          // Current number of GC objects
     size_t peakObjectCount = 0;      // Peak number of GC objects
     size_t collectionsTriggered = 0;
-    size_t cyclesDetected = 0;
+    size_t youngCollections = 0;     // Collections of the young generation only
+    size_t fullCollections = 0;      // Collections of both generations
+    size_t objectsPromoted = 0;      // Young survivors moved to the old generation
+    size_t objectsReclaimed = 0;     // Unreachable objects freed by collections
+    size_t cyclesDetected = 0;       // Collections that found unreachable cycles
     size_t heapLimitExceeded = 0;    // Number of times heap limit was hit
     std::chrono::microseconds totalGCTime{0};
-    std::chrono::microseconds lastGCTime{0};
+    std::chrono::microseconds lastGCTime{0};  // Sum of the pauses of the last collection
+
+    // Every stop-the-world collection and every incremental slice is one
+    // pause. pauseHistogram[i] counts pauses shorter than 2^i microseconds
+    // (the last bucket also takes all longer ones).
+    static constexpr size_t kPauseBuckets = 16;
+    std::array<size_t, kPauseBuckets> pauseHistogram{};
+    std::chrono::microseconds maxPause{0};
+    size_t incrementalSlices = 0;
+
+    // Time spent in each phase of a collection, summed over all of its
+    // pauses. The mark time includes finding the roots.
+    struct PhaseTimes {
+        std::chrono::microseconds subtract{0};
+        std::chrono::microseconds mark{0};
+        std::chrono::microseconds sweep{0};
+    };
+    PhaseTimes lastPhaseTimes;   // Of the last collection
+    PhaseTimes totalPhaseTimes;
+    size_t parallelCollections = 0;  // Collections marked by the worker pool
+
+    size_t arenaPages = 0;  // Pages currently held by the object arena
 };
 
-// Base class for garbage-collected objects
+// Base class for garbage-collected objects. Acyclic garbage is freed by
+// reference counting as soon as the last GCPtr goes away; the collector only
+// has to find cycles. Objects are only ever touched by the interpreter
+// thread, so the count is a plain integer. The collector's own per-object
+// state is atomic because its worker threads mark in parallel.
 class GCObject {
 public:
     GCObject();
     virtual ~GCObject();
 
-    // Reference counting
-    void addRef();
-    void release();
+    // GC objects live in the collector's size-class arena.
+    static void* operator new(size_t size);
+    static void operator delete(void* ptr, size_t size);
+
+    // Reference counting. Every new reference, including one moved out of
+    // another object, passes the write barrier.
+    void addRef() {
+        ++refCount_;
+        writeBarrier();
+    }
+    void writeBarrier() {
+        if (barrierActive_) writeBarrierSlow();
+    }
+    void release() {
+        if (--refCount_ == 0) {
+            delete this;
+        }
+    }
     size_t refCount() const { return refCount_; }
 
-    // Mark-and-sweep support
-    void mark();
-    bool isMarked() const { return marked_; }
-    void clearMark() { marked_ = false; }
+    bool isMarked() const { return color() == Color::Black; }
 
-    // Get all referenced GC objects (for cycle detection)
+    // Get all referenced GC objects. Every entry must be a counted
+    // reference held by this object: the collector subtracts them from the
+    // targets' counts to tell heap-internal references from roots.
     virtual void getReferences(std::vector<GCObject*>& refs) const {}
 
+    // Drop (some of) the references reported by getReferences. Called on
+    // unreachable objects so that their cycles fall apart.
+    virtual void clearReferences() {}
+
     // Type identification for debugging
     virtual const char* typeName() const = 0;
 
 protected:
-    std::atomic<size_t> refCount_{1};
-    bool marked_ = false;
-    bool inCycleCheck_ = false;
+    size_t refCount_ = 1;
+
+private:
+    enum class Generation : uint8_t { Untracked, Young, Old };
+    // Tri-color state during a collection. Objects outside the collected
+    // set (including ones allocated while an incremental collection runs)
+    // stay None and are treated as live.
+    enum class Color : uint8_t { None, White, Gray, Black };
+
+    // Set while an incremental collection is marking: a new reference to a
+    // white object then turns it gray, so that the mutator cannot hide it
+    // behind an object that has already been scanned.
+    static inline bool barrierActive_ = false;
+    void writeBarrierSlow();
+
+    Color color() const { return gcColor_.load(std::memory_order_relaxed); }
+    void setColor(Color color) { gcColor_.store(color, std::memory_order_relaxed); }
+    // White to gray; false if another thread got there first.
+    bool tryShade() {
+        Color expected = Color::White;
+        return color() == Color::White &&
+               gcColor_.compare_exchange_strong(expected, Color::Gray, std::memory_order_relaxed);
+    }
+
+    // Intrusive links of the generation list this object is on.
+    GCObject* gcPrev_ = nullptr;
+    GCObject* gcNext_ = nullptr;
+    std::atomic<int64_t> gcRefs_{0};  // References from outside the collected set
+    size_t gcIndex_ = 0;  // Position in the collector's candidate list
+    Generation generation_ = Generation::Untracked;
+    std::atomic<Color> gcColor_{Color::None};
 
     friend class GarbageCollector;
 };
@@ -100,6 +176,7 @@ public:
 
     GCPtr(GCPtr&& other) noexcept : ptr_(other.ptr_) {
         other.ptr_ = nullptr;
+        if (ptr_) reinterpret_cast<GCObject*>(ptr_)->writeBarrier();
     }
 
     ~GCPtr() {
@@ -120,6 +197,7 @@ public:
             if (ptr_) reinterpret_cast<GCObject*>(ptr_)->release();
             ptr_ = other.ptr_;
             other.ptr_ = nullptr;
+            if (ptr_) reinterpret_cast<GCObject*>(ptr_)->writeBarrier();
         }
         return *this;
     }
@@ -176,14 +254,41 @@ public:
     void registerObject(GCObject* obj);
     void unregisterObject(GCObject* obj);
 
-    // Manual collection triggers
+    // Manual collection triggers. collect() looks at the whole heap;
+    // collectYoung() only at objects allocated since the last collection.
+    // Both finish an incremental collection that is under way first.
     void collect();
+    void collectYoung();
     void collectIfNeeded();
 
+    // Incremental mode: once the allocation threshold is reached, a
+    // collection is spread over slices of at most the slice budget (plus
+    // the final sweep). step() runs one slice; the event loop calls it
+    // between turns, and allocation drives it too so that a collection
+    // also finishes in code that never yields.
+    void setIncremental(bool enabled) { incremental_ = enabled; }
+    bool isIncremental() const { return incremental_; }
+    void setSliceBudget(std::chrono::microseconds budget) { sliceBudget_ = budget; }
+    std::chrono::microseconds getSliceBudget() const { return sliceBudget_; }
+    void startIncrementalCollection(bool full = false);
+    void step();
+    bool isCollecting() const { return phase_ != Phase::Idle; }
+
+    // Stop-the-world collections of large heaps subtract, mark and find
+    // garbage on this many threads, the calling one included. 0 picks a
+    // default from the hardware; 1 keeps collection on the calling thread.
+    // Worker threads are started at the first collection that uses them.
+    void setThreadCount(size_t threads);
+    size_t getThreadCount() const { return threadCount_; }
+
     // Configuration
     void setThreshold(size_t threshold) { allocationThreshold_ = threshold; }
     size_t getThreshold() const { return allocationThreshold_; }
 
+    // Every this many young collections, the next one is a full collection.
+    void setFullCollectionInterval(size_t interval) { fullCollectionInterval_ = interval ? interval : 1; }
+    size_t getFullCollectionInterval() const { return fullCollectionInterval_; }
+
     void setAutoCollect(bool enabled) { autoCollectEnabled_ = enabled; }
     bool isAutoCollectEnabled() const { return autoCollectEnabled_; }
 
@@ -235,32 +340,84 @@ public:
 
 private:
     GarbageCollector();
-    ~GarbageCollector() = default;
+    ~GarbageCollector();
 
     // Prevent copying
     GarbageCollector(const GarbageCollector&) = delete;
     GarbageCollector& operator=(const GarbageCollector&) = delete;
 
-    // Mark-and-sweep implementation
-    void markPhase();
-    void sweepPhase();
-    void detectCycles();
+    friend class GCObject;
+
+    struct GenerationList {
+        GCObject* head = nullptr;
+        size_t count = 0;
+    };
+
+    enum class Phase : uint8_t { Idle, Subtract, Roots, Mark, Sweep };
+    using Clock = std::chrono::steady_clock;
+
+    class WorkerPool;
+    struct MarkQueue;
+    class Arena;
 
-    // Find root objects (those with external references)
-    void findRoots(std::unordered_set<GCObject*>& roots);
+    void* allocateObject(size_t size);
+    void freeObject(void* ptr, size_t size);
+
+    void link(GCObject* obj, GenerationList& list, GCObject::Generation generation);
+    void unlink(GCObject* obj);
+    GenerationList& listFor(GCObject::Generation generation) {
+        return generation == GCObject::Generation::Young ? young_ : old_;
+    }
 
-    // Cycle detection using Tarjan's algorithm
-    void strongConnect(GCObject* obj,
-                       int& index,
-                       std::unordered_map<GCObject*, int>& indices,
-                       std::unordered_map<GCObject*, int>& lowlinks,
-                       std::vector<GCObject*>& stack,
-                       std::unordered_set<GCObject*>& onStack,
-                       std::vector<std::vector<GCObject*>>& sccs);
+    // Stop-the-world collection of the young generation, or of both when
+    // `full`
+    void collectGenerations(bool full);
+
+    // A collection runs as beginCycle(), advanceCycle() until it returns
+    // true, then finishCycle():
+    // - Subtract: trial deletion. References between collected objects are
+    //   subtracted from their counts; what is left comes from roots
+    //   outside the set.
+    // - Roots: objects with references left turn gray.
+    // - Mark: gray objects are scanned and turn black, shading their
+    //   white references.
+    // - Sweep: white objects are freed by breaking their cycles, and young
+    //   survivors are promoted.
+    void beginCycle(bool full);
+    bool advanceCycle(const Clock::time_point* deadline);
+    void finishCycle();
+    void shade(GCObject* obj);
+    void sweep(const std::vector<GCObject*>& garbage);
+    void recordPause(std::chrono::microseconds pause);
+
+    // The worker pool, if the candidate set is large enough to be worth
+    // splitting across it.
+    WorkerPool* workersFor(size_t objects);
+    // Runs the Subtract, Roots and Mark phases of a stop-the-world
+    // collection on the worker pool. Marking is balanced by work stealing.
+    void markParallel(WorkerPool& pool);
 
 private:
-    std::unordered_set<GCObject*> objects_;
-    std::unordered_set<GCObject*> roots_;
+    GenerationList young_;
+    GenerationList old_;
+    std::vector<GCObject*> candidates_;  // Objects being collected; null once freed
+    std::vector<size_t> markStack_;      // Indices of gray candidates
+    std::vector<GCObject*> refs_;
+    Phase phase_ = Phase::Idle;
+    bool fullCycle_ = false;
+    size_t cursor_ = 0;  // Next candidate for the Subtract and Roots phases
+    bool incremental_ = false;
+    std::chrono::microseconds sliceBudget_{1000};
+    std::chrono::microseconds cyclePause_{0};
+    // Phase times of the running collection
+    Clock::duration subtractTime_{0};
+    Clock::duration markTime_{0};
+    Clock::duration sweepTime_{0};
+    size_t threadCount_;
+    std::unique_ptr<WorkerPool> workers_;
+    std::unique_ptr<Arena> arena_;
+    size_t youngCollectionsSinceFull_ = 0;
+    size_t fullCollectionInterval_ = 8;
 
     size_t allocationThreshold_ = 1024 * 1024;  // 1MB default threshold
     size_t bytesAllocatedSinceGC_ = 0;
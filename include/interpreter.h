@@ -47,8 +47,12 @@ struct Task {
   };
 
   std::coroutine_handle<promise_type> handle;
+  Value value_;  // Result of a task that completed without a coroutine frame
 
   Task(std::coroutine_handle<promise_type> h) : handle(h) {}
+  // An already completed task; used by the synchronous evaluation path so
+  // non-suspending code does not allocate a coroutine frame.
+  explicit Task(Value v) : handle(nullptr), value_(std::move(v)) {}
 
   ~Task() {
     if (handle) handle.destroy();
@@ -57,7 +61,7 @@ struct Task {
   Task(const Task&) = delete;
   Task& operator=(const Task&) = delete;
 
-  Task(Task&& other) noexcept : handle(other.handle) {
+  Task(Task&& other) noexcept : handle(other.handle), value_(std::move(other.value_)) {
     other.handle = nullptr;
   }
 
@@ -65,13 +69,17 @@ struct Task {
     if (this != &other) {
       if (handle) handle.destroy();
       handle = other.handle;
+      value_ = std::move(other.value_);
       other.handle = nullptr;
     }
     return *this;
   }
 
   Value result() {
-    if (handle && handle.done()) {
+    if (!handle) {
+      return value_;
+    }
+    if (handle.done()) {
       if (handle.promise().exception) {
         std::rethrow_exception(handle.promise().exception);
       }
@@ -89,19 +97,23 @@ struct Task {
   void getReferences(std::vector<GCObject*>& refs) const {
     if (handle) {
       handle.promise().result.getReferences(refs);
+    } else {
+      value_.getReferences(refs);
     }
   }
 
   bool done() const {
-    return handle && handle.done();
+    return !handle || handle.done();
   }
 };
 
 // C++20 macros for coroutine operations
 #define LIGHTJS_RETURN(val) co_return (val)
 
+// The yielded value travels through ControlFlow; the awaiter itself is kept
+// trivially destructible because GCC 12 can destroy awaiter temporaries twice
+// across a suspension point.
 struct YieldAwaiter {
-  Value yieldedValue;
   bool await_ready() const noexcept { return false; }
   void await_suspend(std::coroutine_handle<>) const noexcept {}
   void await_resume() const noexcept {}
@@ -130,7 +142,7 @@ struct TaskAwaiter {
   do { \
     while (!(taskvar).done()) { \
       (taskvar).resume(); \
-      if (this->flow_.type == ControlFlow::Type::Yield) co_await YieldAwaiter{Value(Undefined{})}; \
+      if (this->flow_.type == ControlFlow::Type::Yield) co_await YieldAwaiter{}; \
     } \
     (outvar) = (taskvar).result(); \
   } while (0)
@@ -139,7 +151,7 @@ struct TaskAwaiter {
   do { \
     while (!(task).done()) { \
       (task).resume(); \
-      if (this->flow_.type == ControlFlow::Type::Yield) co_await YieldAwaiter{Value(Undefined{})}; \
+      if (this->flow_.type == ControlFlow::Type::Yield) co_await YieldAwaiter{}; \
     } \
   } while (0)
 
@@ -302,6 +314,13 @@ public:
   // Keep this well below what would cause a C stack overflow (~3000-4000 on typical systems)
 #if defined(__SANITIZE_ADDRESS__)
   static constexpr size_t MAX_STACK_DEPTH = 256;
+#elif !defined(__OPTIMIZE__)
+  // A JS call on the bytecode tier nests runBytecodeFunction and
+  // executeBytecode under the tree walker's own call frames, and
+  // unoptimized builds keep every one of those frames at full size. At
+  // 2000 calls they overflow an 8 MB stack before this limit trips, so
+  // debug builds report RangeError earlier instead of crashing.
+  static constexpr size_t MAX_STACK_DEPTH = 600;
 #elif defined(__has_feature)
 #if __has_feature(address_sanitizer)
   static constexpr size_t MAX_STACK_DEPTH = 256;
@@ -360,6 +379,14 @@ private:
     return 0; // unlimited by default
   }
 
+  // Bytecode tier switch (on by default). Set LIGHTJS_DISABLE_BYTECODE=1 to
+  // force every call through the tree walker.
+  bool bytecodeEnabled_ = true;
+  static bool getBytecodeEnabled() {
+    const char* env = std::getenv("LIGHTJS_DISABLE_BYTECODE");
+    return !(env && *env != '\0' && *env != '0');
+  }
+
   // RAII helper for stack depth tracking
   struct StackGuard {
     size_t& depth_;
@@ -525,6 +552,76 @@ private:
   Task initializeClassStaticFields(const GCPtr<Class>& cls,
                                    const std::vector<Class::FieldInit>& staticFields);
 
+  // Operation helpers shared by the tree walker and the bytecode VM. They
+  // take already-evaluated operands and report failures through flow_.
+  // checkTDZ is false for reads the resolver proved to follow the binding's
+  // declaration (Identifier::tdzFree).
+  Value lookupIdentifier(const std::string& name, const SourceLocation& loc,
+                         bool checkTDZ = true);
+  // Same, using the scope coordinates cached on a statically resolved node.
+  Value lookupIdentifier(const Identifier& id, const SourceLocation& loc);
+  // Binding of a statically resolved identifier read through its cached
+  // global cell or scope coordinates; nullptr when the by-name path must
+  // run (dynamic scope, TDZ, module bindings).
+  const Value* staticBinding(const Identifier& id);
+  // Global binding for `name` through `cache`, filling it on a miss.
+  const Value* cachedGlobal(GlobalBindingCache& cache, Atom name);
+  bool lookupCallee(const std::string& name, Value& callee, Value& thisValue);
+  bool isUnresolvableReference(const std::string& name);
+  Value resolveThisBinding();
+  Value binaryOperation(BinaryExpr::Op op, const Value& left, const Value& right);
+  Value unaryOperation(UnaryExpr::Op op, const Value& arg);
+  bool computeCompoundAssignment(AssignmentExpr::Op op, const Value& current,
+                                 const Value& rhsValue, Value& result);
+  bool updateNumericValue(UpdateExpr::Op op, const Value& currentValue,
+                          Value& oldValue, Value& newValue);
+  Value getMemberValue(Value obj, const std::string& propName,
+                       std::optional<size_t> typedArrayNumericIndex,
+                       bool privateIdentifier, bool isSuperAccess);
+  Value assignMemberValue(AssignmentExpr::Op op, Value obj, const std::string& propName,
+                          std::optional<size_t> typedArrayNumericIndex, const Value& right,
+                          bool privateIdentifier, bool isSuperTarget, const Value& superReceiver);
+  Value callValue(const Value& callee, const std::vector<Value>& args,
+                  const Value& thisValue, bool isDirectEvalCall = false);
+
+  // Integer-keyed element access on Array and TypedArray storage that skips
+  // building the property-key string. They return false when the access
+  // needs the generic property path (holes, accessors, markers, out of
+  // range); the caller then falls back to getMemberValue/assignMemberValue.
+  static std::optional<size_t> arrayIndexKey(const Value& key);
+  bool getIndexedElement(const Value& obj, size_t index, Value& out);
+  bool setIndexedElement(const Value& obj, size_t index, const Value& value);
+
+  // Named reads of a data property on an ordinary Object, served from an
+  // inline cache keyed by the object's shape. Properties found on the
+  // prototype chain are cached with validity cells for the maps walked.
+  // Returns false when the caller must take the getMemberValue path.
+  bool getCachedProperty(PropertyCache& cache, const Value& obj,
+                         const std::string& name, Value& out);
+
+  // Bytecode tier (interpreter_bytecode.cc). Hot, eligible functions are
+  // compiled and run on the register VM from then on. Every call and every
+  // loop iteration the tree walker runs in a function counts toward the
+  // threshold: a function called only once but looping a lot compiles on
+  // its next call, without the VM having to enter code mid-loop.
+  static constexpr uint32_t BYTECODE_HOTNESS_THRESHOLD = 64;
+  void countLoopIteration() {
+    if (activeFunction_) activeFunction_->shared->hotness++;
+  }
+  const BytecodeFunction* prepareBytecode(const GCPtr<Function>& func, const Value& thisValue);
+  Value runBytecodeFunction(const GCPtr<Function>& func, const BytecodeFunction& code,
+                            std::vector<Value> args, Value thisValue, bool pushNamedExpr);
+  Value executeBytecode(const GCPtr<Function>& func, const BytecodeFunction& code,
+                        std::vector<Value>& args, Value& thisValue);
+
+  // evaluate(const Expression&) runs expressions that cannot suspend
+  // (Expression::canSuspend is false) through evaluateSync as plain calls and
+  // only creates a coroutine frame for the ones that can.
+  Task evaluateSuspendable(const Expression& expr);
+  Value evaluateSync(const Expression& expr);
+  Value evaluateBinarySync(const BinaryExpr& expr);
+  Value evaluateMemberSync(const MemberExpr& expr);
+
   Task evaluateBinary(const BinaryExpr& expr);
   Task evaluateUnary(const UnaryExpr& expr);
   Task evaluateAssignment(const AssignmentExpr& expr);
@@ -571,6 +668,11 @@ private:
 
   // Helper to invoke a JavaScript function (used by native functions to call JS callbacks)
   Value invokeFunction(GCPtr<Function> func, const std::vector<Value>& args, const Value& thisValue = Value(Undefined{}));
+  // Call a FastNativeFunction builtin and turn its throw completion (or a
+  // C++ exception escaping it) into flow_.
+  Value callFastNative(const Function& func, const Value& thisValue, std::span<const Value> args);
+  // Set flow_ from a native's "TypeError: ..." style exception.
+  void throwNativeException(const std::exception& e);
 
   // Helper to format error message with line number
   static std::string formatError(const std::string& msg, const SourceLocation& loc) {
@@ -584,29 +686,20 @@ private:
   // Returns true if allocation is safe, sets error and returns false otherwise
   bool checkMemoryLimit(size_t additionalBytes = 0);
 
-  // Helper to throw error with stack trace
+  // Helper to throw error with stack trace. Only the frames are captured
+  // here; Error::stack() formats them if anything reads the trace.
   void throwError(ErrorType type, const std::string& message) {
     auto error = GarbageCollector::makeGC<Error>(type, message);
-    // Format stack trace using ErrorFormatter
-    error->stack = ErrorFormatter::formatError(
-      error->getName(),
-      message,
-      stackTrace_.getStackTrace()
-    );
+    error->capturedStack = stackTrace_.capture();
     flow_.type = ControlFlow::Type::Throw;
     flow_.value = Value(error);
   }
 
   // Helper to push stack frame (RAII)
-  StackFrameGuard pushStackFrame(const std::string& functionName,
-                                  const std::string& filename = "<script>",
-                                  uint32_t line = 0,
-                                  uint32_t column = 0) {
+  StackFrameGuard pushStackFrame(const SharedFunctionInfo* function, const char* label) {
     StackFrame frame;
-    frame.functionName = functionName;
-    frame.filename = filename;
-    frame.line = line;
-    frame.column = column;
+    frame.function = function;
+    frame.label = label;
     return StackFrameGuard(stackTrace_, frame);
   }
 };
@@ -616,4 +709,10 @@ private:
 // might be an object (ES spec requires ToPrimitive(input, "number") first).
 double toNumberES(const Value& v);
 
+// Template shared by every closure created from `node` (a FunctionExpr,
+// FunctionDeclaration or MethodDefinition). Built on first use and cached on
+// the node.
+template <typename FunctionNode>
+const std::shared_ptr<const SharedFunctionInfo>& sharedFunctionInfo(const FunctionNode& node);
+
 }
@@ -1,12 +1,14 @@
 #pragma once
 
 #include "value.h"
+#include <span>
 #include <vector>
 
 namespace lightjs {
 
 // JSON object methods
-Value JSON_parse(const std::vector<Value>& args);
+Value JSON_parse(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                 NativeThrow& thrown);
 Value JSON_stringify(const std::vector<Value>& args);
 
 } // namespace lightjs
\ No newline at end of file
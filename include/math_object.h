@@ -1,47 +1,47 @@
 #pragma once
 
 #include "value.h"
-#include <vector>
+#include <span>
 
 namespace lightjs {
 
-// Math object methods
-Value Math_abs(const std::vector<Value>& args);
-Value Math_ceil(const std::vector<Value>& args);
-Value Math_floor(const std::vector<Value>& args);
-Value Math_round(const std::vector<Value>& args);
-Value Math_trunc(const std::vector<Value>& args);
-Value Math_max(const std::vector<Value>& args);
-Value Math_min(const std::vector<Value>& args);
-Value Math_pow(const std::vector<Value>& args);
-Value Math_sqrt(const std::vector<Value>& args);
-Value Math_sin(const std::vector<Value>& args);
-Value Math_cos(const std::vector<Value>& args);
-Value Math_tan(const std::vector<Value>& args);
-Value Math_random(const std::vector<Value>& args);
-Value Math_sign(const std::vector<Value>& args);
-Value Math_log(const std::vector<Value>& args);
-Value Math_log10(const std::vector<Value>& args);
-Value Math_exp(const std::vector<Value>& args);
-Value Math_cbrt(const std::vector<Value>& args);
-Value Math_log2(const std::vector<Value>& args);
-Value Math_hypot(const std::vector<Value>& args);
-Value Math_expm1(const std::vector<Value>& args);
-Value Math_log1p(const std::vector<Value>& args);
-Value Math_fround(const std::vector<Value>& args);
-Value Math_clz32(const std::vector<Value>& args);
-Value Math_imul(const std::vector<Value>& args);
-Value Math_asin(const std::vector<Value>& args);
-Value Math_acos(const std::vector<Value>& args);
-Value Math_atan(const std::vector<Value>& args);
-Value Math_atan2(const std::vector<Value>& args);
-Value Math_sinh(const std::vector<Value>& args);
-Value Math_cosh(const std::vector<Value>& args);
-Value Math_tanh(const std::vector<Value>& args);
-Value Math_asinh(const std::vector<Value>& args);
-Value Math_acosh(const std::vector<Value>& args);
-Value Math_atanh(const std::vector<Value>& args);
-Value Math_f16round(const std::vector<Value>& args);
-Value Math_sumPrecise(const std::vector<Value>& args);
+// Math object methods, in the FastNativeFunction convention
+Value Math_abs(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_ceil(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_floor(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_round(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_trunc(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_max(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_min(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_pow(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_sqrt(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_sin(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_cos(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_tan(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_random(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_sign(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_log(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_log10(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_exp(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_cbrt(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_log2(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_hypot(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_expm1(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_log1p(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_fround(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_clz32(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_imul(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_asin(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_acos(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_atan(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_atan2(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_sinh(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_cosh(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_tanh(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_asinh(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_acosh(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_atanh(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_f16round(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
+Value Math_sumPrecise(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown);
 
 } // namespace lightjs
\ No newline at end of file
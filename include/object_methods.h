@@ -1,6 +1,7 @@
 #pragma once
 
 #include "value.h"
+#include <span>
 #include <vector>
 
 namespace lightjs {
@@ -10,7 +11,8 @@ Value Object_keys(const std::vector<Value>& args);
 Value Object_values(const std::vector<Value>& args);
 Value Object_entries(const std::vector<Value>& args);
 Value Object_assign(const std::vector<Value>& args);
-Value Object_hasOwnProperty(const std::vector<Value>& args);
+Value Object_hasOwnProperty(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                            NativeThrow& thrown);
 Value Object_getOwnPropertyNames(const std::vector<Value>& args);
 Value Object_create(const std::vector<Value>& args);
 Value Object_fromEntries(const std::vector<Value>& args);
@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include <memory>
 #include <cstdint>
+#include "string_table.h"
 
 namespace lightjs {
 
@@ -34,10 +35,14 @@ public:
   ShapeId getId() const { return id_; }
 
   // Get property offset (-1 if not found)
-  int getPropertyOffset(const std::string& name) const;
+  int getPropertyOffset(Atom atom) const;
+  int getPropertyOffset(const std::string& name) const {
+    return getPropertyOffset(AtomTable::instance().find(name));
+  }
 
   // Check if shape has property
-  bool hasProperty(const std::string& name) const;
+  bool hasProperty(Atom atom) const { return getPropertyOffset(atom) >= 0; }
+  bool hasProperty(const std::string& name) const { return getPropertyOffset(name) >= 0; }
 
   // Get all property names in order
   const std::vector<std::string>& getPropertyNames() const { return properties_; }
@@ -45,8 +50,16 @@ public:
   // Get property count
   size_t getPropertyCount() const { return properties_.size(); }
 
+  // Number of getter/setter keys, and the offset of "__proto__" (-1 if
+  // absent). Both are fixed per shape, so reading them costs no lookup.
+  uint32_t getAccessorCount() const { return accessorCount_; }
+  int getPrototypeOffset() const { return prototypeOffset_; }
+
   // Transition: add a new property, returns new shape
-  std::shared_ptr<ObjectShape> addProperty(const std::string& name);
+  std::shared_ptr<ObjectShape> addProperty(Atom atom);
+  std::shared_ptr<ObjectShape> addProperty(const std::string& name) {
+    return addProperty(atomize(name));
+  }
 
   // Get parent shape (for prototype chain)
   std::shared_ptr<ObjectShape> getParent() const { return parent_; }
@@ -77,21 +90,45 @@ private:
     }
   };
 
+  // Shapes this small are searched linearly; comparing a few atoms beats
+  // hashing.
+  static constexpr size_t kLinearScanLimit = 8;
+
   ShapeId id_;
   std::vector<std::string> properties_;  // Property names in order
-  std::unordered_map<std::string, size_t> propertyMap_;  // Name -> offset
+  std::vector<Atom> atoms_;  // Parallel to properties_
+  std::unordered_map<Atom, uint32_t> propertyMap_;  // Atom -> offset, past kLinearScanLimit
+  uint32_t accessorCount_ = 0;
+  int prototypeOffset_ = -1;
   std::shared_ptr<ObjectShape> parent_;  // Parent shape
 
-  // Shape transitions: propertyName -> new shape
-  std::unordered_map<std::string, std::shared_ptr<ObjectShape>> transitions_;
+  void appendProperty(Atom atom);
+
+  // Shape transitions: property atom -> new shape. Children keep their
+  // parent alive, not the other way round, so shapes no object uses die.
+  std::unordered_map<Atom, std::weak_ptr<ObjectShape>> transitions_;
+  size_t transitionSweepThreshold_ = 16;
 
   // Global shape cache and ID counter
   static ShapeId nextShapeId_;
   static std::unordered_map<std::vector<std::string>, std::shared_ptr<ObjectShape>, VectorHash> shapeCache_;
 };
 
-// Note: ShapedObject is defined in value.h after Value is complete
-// This avoids circular dependency issues
+// Note: PropertyMap (property_map.h) pairs a shape with per-object slot
+// storage; it is the property container of every heap object.
+class PropertyMap;
+
+/**
+ * Validity cell for prototype-chain inline caches
+ *
+ * A PropertyMap hands out one cell at a time and clears it as soon as its
+ * keys or its prototype may have changed, or when the map is destroyed.
+ * Cache entries that looked through the map hold its cell and stop
+ * hitting once the cell is invalid.
+ */
+struct ValidityCell {
+  bool valid = true;
+};
 
 /**
  * Polymorphic inline cache for property access
@@ -102,9 +139,26 @@ private:
 struct PropertyCache {
   static constexpr size_t MAX_ENTRIES = 4;  // Maximum cache entries (polymorphic)
 
+  // A property found on the receiver's prototype chain. The entry's offset
+  // then indexes the holder's slots, and the hit stands only while the
+  // receiver still has `prototype` and every map walked is unchanged.
+  struct PrototypeHit {
+    const PropertyMap* prototype = nullptr;
+    const PropertyMap* holder = nullptr;
+    std::vector<std::shared_ptr<ValidityCell>> cells;  // One per map walked, holder last
+
+    bool valid() const {
+      for (const auto& cell : cells) {
+        if (!cell->valid) return false;
+      }
+      return true;
+    }
+  };
+
   struct CacheEntry {
     ObjectShape::ShapeId shapeId = 0;
     int offset = -1;
+    std::shared_ptr<const PrototypeHit> prototypeHit;  // Null for own properties
   };
 
   CacheEntry entries[MAX_ENTRIES];
@@ -114,34 +168,39 @@ struct PropertyCache {
 
   PropertyCache() = default;
 
-  // Try to use cache - check all entries
-  bool tryGet(ObjectShape::ShapeId currentShapeId, int& outOffset) {
+  // Try to use cache - check all entries. Prototype hits whose validity
+  // cells were cleared count as misses.
+  const CacheEntry* find(ObjectShape::ShapeId currentShapeId) {
     // Check all cached entries
     for (size_t i = 0; i < entryCount; ++i) {
       if (entries[i].shapeId == currentShapeId && entries[i].offset >= 0) {
+        if (entries[i].prototypeHit && !entries[i].prototypeHit->valid()) {
+          break;
+        }
         hitCount++;
-        outOffset = entries[i].offset;
         // Move to front for better locality (most recently used first)
         if (i > 0) {
-          CacheEntry temp = entries[i];
+          CacheEntry temp = std::move(entries[i]);
           for (size_t j = i; j > 0; --j) {
-            entries[j] = entries[j - 1];
+            entries[j] = std::move(entries[j - 1]);
           }
-          entries[0] = temp;
+          entries[0] = std::move(temp);
         }
-        return true;
+        return &entries[0];
       }
     }
     missCount++;
-    return false;
+    return nullptr;
   }
 
   // Update cache - add new entry or update existing
-  void update(ObjectShape::ShapeId newShapeId, int newOffset) {
+  void update(ObjectShape::ShapeId newShapeId, int newOffset,
+              std::shared_ptr<const PrototypeHit> prototypeHit = nullptr) {
     // Check if already in cache
     for (size_t i = 0; i < entryCount; ++i) {
       if (entries[i].shapeId == newShapeId) {
         entries[i].offset = newOffset;
+        entries[i].prototypeHit = std::move(prototypeHit);
         return;
       }
     }
@@ -150,16 +209,16 @@ struct PropertyCache {
     if (entryCount < MAX_ENTRIES) {
       // Shift entries down to make room at front
       for (size_t i = entryCount; i > 0; --i) {
-        entries[i] = entries[i - 1];
+        entries[i] = std::move(entries[i - 1]);
       }
-      entries[0] = {newShapeId, newOffset};
+      entries[0] = {newShapeId, newOffset, std::move(prototypeHit)};
       entryCount++;
     } else {
       // Cache full - replace oldest entry (last one)
       for (size_t i = MAX_ENTRIES - 1; i > 0; --i) {
-        entries[i] = entries[i - 1];
+        entries[i] = std::move(entries[i - 1]);
       }
-      entries[0] = {newShapeId, newOffset};
+      entries[0] = {newShapeId, newOffset, std::move(prototypeHit)};
     }
   }
 
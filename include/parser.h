@@ -8,6 +8,13 @@
 
 namespace lightjs {
 
+// Mark identifier references that cannot be affected by direct eval or with
+// (see Identifier::staticScope) and expressions that may suspend (see
+// Expression::canSuspend). Parser::parse() runs this on every program; eval
+// code only gets the suspension analysis since its scope chain is only known
+// at the call site.
+void resolveScopes(Program& program, bool isEvalCode = false);
+
 class Parser {
 public:
   explicit Parser(std::vector<Token> tokens, bool isModule = false);
@@ -0,0 +1,277 @@
+#pragma once
+
+#include "object_shape.h"
+#include "ordered_map.h"
+#include "value_core.h"
+#include <bit>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace lightjs {
+
+/**
+ * PropertyMap - shape-based property storage for heap objects
+ *
+ * Offers the OrderedMap<std::string, Value> interface, but keeps the keys
+ * in a shared ObjectShape and only the values in a per-object slot vector.
+ * Every map starts at the root shape and moves along the transition tree as
+ * keys are added, so objects built the same way share one shape and
+ * inline caches can key on its id.
+ *
+ * Removing any key but the most recently added one, or growing beyond
+ * kMaxShapeProperties keys, switches the map to dictionary mode (a plain
+ * OrderedMap) for good. Dictionary maps report shape id 0.
+ *
+ * Accessor halves and the prototype keep their reserved "__get_<name>",
+ * "__set_<name>" and "__proto__" keys, but the shape (or, in dictionary
+ * mode, the map itself) counts accessor keys and records where "__proto__"
+ * lives. getter(), setter() and prototype() use that to answer without
+ * building key strings, and a map with no accessors answers with no
+ * lookup at all.
+ *
+ * Slots live in segments that never move, so as with the unordered_map
+ * this replaced, references returned by operator[] and at() survive later
+ * insertions. Erasing a key or the switch to dictionary mode invalidates
+ * them.
+ */
+class PropertyMap {
+ public:
+  static constexpr size_t kMaxShapeProperties = 64;
+
+  // Segmented slot vector: segment k holds kFirstSegment << k values, so an
+  // offset maps to its segment with one bit_width and nothing is relocated.
+  class SlotStorage {
+   public:
+    SlotStorage() = default;
+    SlotStorage(const SlotStorage& other) {
+      for (size_t i = 0; i < other.size_; ++i) push_back() = other[i];
+    }
+    SlotStorage& operator=(const SlotStorage& other) {
+      if (this != &other) {
+        SlotStorage copy(other);
+        *this = std::move(copy);
+      }
+      return *this;
+    }
+    SlotStorage(SlotStorage&& other) noexcept
+        : segments_(std::move(other.segments_)), size_(std::exchange(other.size_, 0)) {}
+    SlotStorage& operator=(SlotStorage&& other) noexcept {
+      segments_ = std::move(other.segments_);
+      size_ = std::exchange(other.size_, 0);
+      return *this;
+    }
+
+    size_t size() const { return size_; }
+    Value& operator[](size_t offset) {
+      size_t segment = std::bit_width(offset / kFirstSegment + 1) - 1;
+      return segments_[segment][offset - kFirstSegment * ((size_t{1} << segment) - 1)];
+    }
+    const Value& operator[](size_t offset) const {
+      return const_cast<SlotStorage&>(*this)[offset];
+    }
+    Value& push_back() {
+      if (size_ == kFirstSegment * ((size_t{1} << segments_.size()) - 1)) {
+        segments_.push_back(std::make_unique<Value[]>(kFirstSegment << segments_.size()));
+      }
+      return (*this)[size_++];
+    }
+    void pop_back() { (*this)[--size_] = Value(Undefined{}); }
+    void clear() {
+      segments_.clear();
+      size_ = 0;
+    }
+
+   private:
+    static constexpr size_t kFirstSegment = 4;
+    std::vector<std::unique_ptr<Value[]>> segments_;
+    size_t size_ = 0;
+  };
+
+  using key_type = std::string;
+  using mapped_type = Value;
+  using size_type = size_t;
+
+  // Iterators dereference to a {first, second} pair of references.
+  struct Entry {
+    const std::string& first;
+    Value& second;
+  };
+  struct ConstEntry {
+    const std::string& first;
+    const Value& second;
+  };
+
+  template <bool IsConst>
+  class Iterator {
+   public:
+    using Map = std::conditional_t<IsConst, const PropertyMap, PropertyMap>;
+    using DictionaryIterator =
+        std::conditional_t<IsConst, OrderedMap<std::string, Value>::const_iterator,
+                           OrderedMap<std::string, Value>::iterator>;
+    using EntryType = std::conditional_t<IsConst, ConstEntry, Entry>;
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = EntryType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = EntryType*;
+    using reference = EntryType&;
+
+    Iterator() = default;
+    Iterator(Map* map, size_t index) : map_(map), index_(index) {}
+    Iterator(Map* map, DictionaryIterator it) : map_(map), index_(kDictionaryIndex), dictionaryIt_(it) {}
+    Iterator(const Iterator& other) : map_(other.map_), index_(other.index_), dictionaryIt_(other.dictionaryIt_) {}
+    // A mutable iterator converts to a const one.
+    template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+    Iterator(const Iterator<OtherConst>& other)
+        : map_(other.map_), index_(other.index_), dictionaryIt_(other.dictionaryIt_) {}
+
+    Iterator& operator=(const Iterator& other) {
+      map_ = other.map_;
+      index_ = other.index_;
+      dictionaryIt_ = other.dictionaryIt_;
+      entry_.reset();
+      return *this;
+    }
+
+    EntryType& operator*() const {
+      entry_.reset();
+      if (index_ == kDictionaryIndex) {
+        entry_.emplace(EntryType{dictionaryIt_->first, dictionaryIt_->second});
+      } else {
+        entry_.emplace(EntryType{map_->shape_->getPropertyNames()[index_], map_->slots_[index_]});
+      }
+      return *entry_;
+    }
+    EntryType* operator->() const { return &**this; }
+
+    Iterator& operator++() {
+      if (index_ == kDictionaryIndex) {
+        ++dictionaryIt_;
+      } else {
+        ++index_;
+      }
+      entry_.reset();
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator old = *this;
+      ++*this;
+      return old;
+    }
+
+    friend bool operator==(const Iterator& a, const Iterator& b) {
+      if (a.index_ != b.index_) return false;
+      return a.index_ != kDictionaryIndex || a.dictionaryIt_ == b.dictionaryIt_;
+    }
+    friend bool operator!=(const Iterator& a, const Iterator& b) { return !(a == b); }
+
+   private:
+    template <bool>
+    friend class Iterator;
+
+    // Dictionary-mode iterators never compare equal to shape-mode positions.
+    static constexpr size_t kDictionaryIndex = static_cast<size_t>(-1);
+
+    Map* map_ = nullptr;
+    size_t index_ = 0;
+    DictionaryIterator dictionaryIt_{};
+    mutable std::optional<EntryType> entry_;
+  };
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  PropertyMap() : shape_(ObjectShape::createRootShape()) {}
+  PropertyMap(const PropertyMap& other);
+  PropertyMap& operator=(const PropertyMap& other);
+  PropertyMap(PropertyMap&& other) noexcept;
+  PropertyMap& operator=(PropertyMap&& other) noexcept;
+  ~PropertyMap() { invalidate(); }
+
+  Value& operator[](const std::string& key);
+
+  iterator find(const std::string& key);
+  const_iterator find(const std::string& key) const;
+  // Lookups by atom skip hashing the key in shape mode.
+  iterator find(Atom atom);
+
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  size_type count(const std::string& key) const;
+  size_type count(Atom atom) const;
+  size_type size() const { return dictionary_ ? dictionary_->size() : slots_.size(); }
+  bool empty() const { return size() == 0; }
+
+  Value& at(const std::string& key);
+  const Value& at(const std::string& key) const;
+
+  size_type erase(const std::string& key);
+  void clear();
+
+  // Keys in insertion order (re-inserted keys appear at new position)
+  const std::vector<std::string>& orderedKeys() const {
+    return dictionary_ ? dictionary_->orderedKeys() : shape_->getPropertyNames();
+  }
+
+  // Shape access for inline caches. A slot offset is only meaningful
+  // together with the shape id it was read under.
+  ObjectShape::ShapeId shapeId() const { return dictionary_ ? 0 : shape_->getId(); }
+  int slotOffset(const std::string& key) const {
+    return dictionary_ ? -1 : shape_->getPropertyOffset(key);
+  }
+  int slotOffset(Atom atom) const { return dictionary_ ? -1 : shape_->getPropertyOffset(atom); }
+  const Value& slot(size_t offset) const { return slots_[offset]; }
+  Value& slot(size_t offset) { return slots_[offset]; }
+
+  // Value stored under `key`, or null. One probe, no allocation.
+  const Value* lookup(const std::string& key) const;
+
+  // Accessor and prototype slots, or null when absent.
+  bool hasAccessors() const {
+    return dictionary_ ? dictionaryAccessors_ != 0 : shape_->getAccessorCount() != 0;
+  }
+  const Value* getter(const std::string& name) const {
+    return hasAccessors() ? accessorSlot(name, AtomKind::Getter) : nullptr;
+  }
+  const Value* setter(const std::string& name) const {
+    return hasAccessors() ? accessorSlot(name, AtomKind::Setter) : nullptr;
+  }
+  const Value* prototype() const;
+
+  // Cell for prototype-chain inline caches that look through this map. It
+  // is cleared when a key is added or removed, when "__proto__" is written
+  // through operator[], and when the map dies.
+  std::shared_ptr<ValidityCell> validityCell() const {
+    if (!validityCell_) {
+      validityCell_ = std::make_shared<ValidityCell>();
+    }
+    return validityCell_;
+  }
+
+ private:
+  std::shared_ptr<ObjectShape> shape_;  // Unused in dictionary mode
+  SlotStorage slots_;
+  std::unique_ptr<OrderedMap<std::string, Value>> dictionary_;
+  uint32_t dictionaryAccessors_ = 0;  // Accessor keys held by dictionary_
+  mutable std::shared_ptr<ValidityCell> validityCell_;
+
+  void invalidate() {
+    if (validityCell_) {
+      validityCell_->valid = false;
+      validityCell_.reset();
+    }
+  }
+
+  const Value* accessorSlot(const std::string& name, AtomKind kind) const;
+  Value& dictionaryInsert(const std::string& key);
+  size_type dictionaryErase(const std::string& key);
+  void makeDictionary();
+};
+
+}  // namespace lightjs
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "value.h"
+#include <span>
 #include <vector>
 
 namespace lightjs {
@@ -8,24 +9,36 @@ namespace lightjs {
 size_t String_utf16Length(const std::string& str);
 std::string String_utf16CodeUnitStringAt(const std::string& str, size_t targetIndex);
 
-// String prototype methods
-Value String_charAt(const std::vector<Value>& args);
-Value String_charCodeAt(const std::vector<Value>& args);
-Value String_codePointAt(const std::vector<Value>& args);
-Value String_at(const std::vector<Value>& args);
+// String prototype methods. The index, search, slicing and case methods use
+// the FastNativeFunction convention; the rest take `this` as args[0].
+Value String_charAt(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                 NativeThrow& thrown);
+Value String_charCodeAt(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                 NativeThrow& thrown);
+Value String_codePointAt(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                 NativeThrow& thrown);
+Value String_at(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                 NativeThrow& thrown);
 Value String_iterator(const std::vector<Value>& args);
-Value String_indexOf(const std::vector<Value>& args);
-Value String_lastIndexOf(const std::vector<Value>& args);
-Value String_substring(const std::vector<Value>& args);
-Value String_substr(const std::vector<Value>& args);
-Value String_slice(const std::vector<Value>& args);
+Value String_indexOf(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                 NativeThrow& thrown);
+Value String_lastIndexOf(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                 NativeThrow& thrown);
+Value String_substring(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                 NativeThrow& thrown);
+Value String_substr(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                 NativeThrow& thrown);
+Value String_slice(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                 NativeThrow& thrown);
 Value String_split(const std::vector<Value>& args);
 Value String_search(const std::vector<Value>& args);
 Value String_match(const std::vector<Value>& args);
 Value String_replace(const std::vector<Value>& args);
 Value String_replaceAll(const std::vector<Value>& args);
-Value String_toLowerCase(const std::vector<Value>& args);
-Value String_toUpperCase(const std::vector<Value>& args);
+Value String_toLowerCase(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                 NativeThrow& thrown);
+Value String_toUpperCase(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                 NativeThrow& thrown);
 Value String_trim(const std::vector<Value>& args);
 
 // String static methods
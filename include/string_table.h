@@ -1,8 +1,12 @@
 #pragma once
 
+#include <cstdint>
+#include <deque>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #include <memory>
 #include <mutex>
 
@@ -88,4 +92,71 @@ inline std::shared_ptr<std::string> intern(std::string_view str) {
   return StringTable::instance().intern(str);
 }
 
+/**
+ * Runtime-wide atom table for property keys and binding names
+ *
+ * An atom is a dense 32-bit id for a string. Equal strings always map to
+ * the same atom, so shapes and environments key on atoms and lookups that
+ * already hold one (identifiers are atomized after parsing) compare
+ * integers instead of hashing strings. Atoms are never freed.
+ *
+ * Like the rest of the runtime, the table is used from the interpreter
+ * thread only and takes no lock.
+ */
+using Atom = uint32_t;
+inline constexpr Atom kNoAtom = UINT32_MAX;
+
+// What a property key atom names. Accessor halves and the prototype are
+// stored under reserved keys ("__get_<name>", "__set_<name>", "__proto__");
+// the kind is decided once when the atom is created so property maps can
+// track those slots without looking at key text again.
+enum class AtomKind : uint8_t { Plain, Getter, Setter, Prototype };
+
+class AtomTable {
+public:
+  static AtomTable& instance();
+
+  // Atom for `str`, creating it on first use.
+  Atom atomize(std::string_view str);
+
+  // Atom for `str`, or kNoAtom if it was never atomized. A key that has no
+  // atom cannot be present in any shape or environment.
+  Atom find(std::string_view str) const {
+    auto it = index_.find(str);
+    return it != index_.end() ? it->second : kNoAtom;
+  }
+
+  const std::string& name(Atom atom) const { return names_[atom]; }
+  AtomKind kind(Atom atom) const { return kinds_[atom]; }
+  size_t size() const { return names_.size(); }
+
+  // Atom of the "__get_<name>" or "__set_<name>" key for the atom `name`,
+  // or kNoAtom if that key was never atomized. Atomizing an accessor key
+  // records it here, so accessor lookups never build the key string.
+  Atom accessorAtom(Atom name, AtomKind kind) const {
+    if (name >= accessorAtoms_.size()) {
+      return kNoAtom;
+    }
+    return kind == AtomKind::Getter ? accessorAtoms_[name].first : accessorAtoms_[name].second;
+  }
+
+  // "__proto__" is always the first atom.
+  static constexpr Atom kProtoAtom = 0;
+
+private:
+  AtomTable();
+
+  AtomTable(const AtomTable&) = delete;
+  AtomTable& operator=(const AtomTable&) = delete;
+
+  std::deque<std::string> names_;  // Stable storage; index_ keys view into it
+  std::vector<AtomKind> kinds_;  // Parallel to names_
+  std::vector<std::pair<Atom, Atom>> accessorAtoms_;  // Getter/setter atom per name atom
+  std::unordered_map<std::string_view, Atom> index_;
+};
+
+inline Atom atomize(std::string_view str) {
+  return AtomTable::instance().atomize(str);
+}
+
 } // namespace lightjs
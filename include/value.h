@@ -8,13 +8,16 @@
 #include <cmath>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "object_shape.h"
 #include "ordered_map.h"
+#include "property_map.h"
 #include "regex_utils.h"
 #include "checked_arithmetic.h"
 #include "value_core.h"
@@ -29,16 +32,54 @@ namespace lightjs {
 
 using NativeFunction = std::function<Value(const std::vector<Value>&)>;
 
+class Interpreter;
+struct NativeThrow;
+
+// Allocation-free native calling convention. The receiver comes separately
+// and the arguments are a view over the caller's values, so a call builds
+// no argument vector and goes through no std::function. A builtin that
+// throws fills `thrown` and returns; the caller turns it into a throw
+// completion.
+using FastNativeFunction = Value (*)(const Value& thisValue, std::span<const Value> args,
+                                     Interpreter& interpreter, NativeThrow& thrown);
+
+struct BytecodeFunction;
+struct CapturedStack;
+
 struct FunctionParam {
   std::string name;
   std::shared_ptr<void> defaultValue;  // Stores ExprPtr for default value
 };
 
-struct Function : public GCObject {
+// Immutable per-site function template: everything a closure needs that
+// depends only on the function's source, not on the scope it closes over.
+// Every closure created from the same function expression, declaration or
+// class method shares one, so creating a closure in a loop copies no
+// parameter names or source text. params/body point into the AST, which the
+// closure's astOwner keeps alive where needed.
+struct SharedFunctionInfo : std::enable_shared_from_this<SharedFunctionInfo> {
+  std::string name;  // Declared name, if any; used by stack traces
   std::vector<FunctionParam> params;
   std::optional<std::string> restParam;
   std::shared_ptr<void> body;
   std::shared_ptr<void> destructurePrologue;  // Synthetic bindings for destructuring params
+  size_t length = 0;  // Params before the first default, for .length
+  bool usesArguments = true;  // False when no call can observe an arguments object
+  std::string_view sourceText;  // Slice of the AST's source text
+
+  // Bytecode tier state, kept per site so closures from a hot site compile
+  // once between them. Compiled code depends only on the template.
+  // hotness counts calls plus loop iterations run by the tree walker.
+  mutable std::shared_ptr<BytecodeFunction> bytecode;
+  mutable uint32_t hotness = 0;
+  mutable bool bytecodeIneligible = false;
+
+  // Template with no params and no body, used by native functions.
+  static const std::shared_ptr<const SharedFunctionInfo>& empty();
+};
+
+struct Function : public GCObject {
+  std::shared_ptr<const SharedFunctionInfo> shared = SharedFunctionInfo::empty();
   // Keeps parsed AST storage alive when params/body point into transient parses
   // (e.g. Function constructor-created functions).
   std::shared_ptr<void> astOwner;
@@ -48,15 +89,17 @@ struct Function : public GCObject {
   bool isGenerator;
   bool isStrict;
   bool isConstructor = false;  // Can be called with 'new'
-  std::string sourceText;  // Original source for Function.prototype.toString
   NativeFunction nativeFunc;
-  OrderedMap<std::string, Value> properties;
+  // Preferred over nativeFunc by the interpreter when set. See setFastNative().
+  FastNativeFunction fastNative = nullptr;
+  PropertyMap properties;
 
   Function() : isNative(false), isAsync(false), isGenerator(false), isStrict(false), isConstructor(false) {}
 
   // GCObject interface
   const char* typeName() const override { return "Function"; }
   void getReferences(std::vector<GCObject*>& refs) const override;
+  void clearReferences() override;
 };
 
 // Class structure for ES6 classes
@@ -70,7 +113,7 @@ struct Class : public GCObject {
   std::unordered_map<std::string, GCPtr<Function>> staticMethods;  // Static methods
   std::unordered_map<std::string, GCPtr<Function>> getters;        // Getter methods
   std::unordered_map<std::string, GCPtr<Function>> setters;        // Setter methods
-  OrderedMap<std::string, Value> properties;  // Own properties (name, length, prototype, etc.)
+  PropertyMap properties;  // Own properties (name, length, prototype, etc.)
   std::shared_ptr<void> astOwner;  // Keeps class method/field AST storage alive.
   GCPtr<Environment> closure;  // Closure environment
 
@@ -87,82 +130,181 @@ struct Class : public GCObject {
 
   // GCObject interface
   const char* typeName() const override { return "Class"; }
-  void getReferences(std::vector<GCObject*>& refs) const override {
-    if (constructor) refs.push_back(constructor.get());
-    if (superClass) refs.push_back(superClass.get());
-    if (lexicalParentClass) refs.push_back(lexicalParentClass.get());
-    for (const auto& [_, method] : methods) {
-      if (method) refs.push_back(method.get());
-    }
-    for (const auto& [_, method] : staticMethods) {
-      if (method) refs.push_back(method.get());
-    }
-  }
+  void getReferences(std::vector<GCObject*>& refs) const override;
+  void clearReferences() override;
 };
 
 struct Array : public GCObject {
-  std::vector<Value> elements;
-  OrderedMap<std::string, Value> properties;
+  // Element kinds. A new array stores int32 elements unboxed and widens one
+  // way (PackedInt32 -> PackedDouble -> Generic) when a value that does not
+  // fit is stored, so numeric arrays take 4 or 8 bytes per element instead
+  // of a full Value.
+  enum class ElementKind : uint8_t { PackedInt32, PackedDouble, Generic };
+
+  PropertyMap properties;
+
+  ElementKind elementKind() const { return elementKind_; }
+  size_t elementCount() const {
+    switch (elementKind_) {
+      case ElementKind::PackedInt32: return int32Elements_.size();
+      case ElementKind::PackedDouble: return doubleElements_.size();
+      case ElementKind::Generic: break;
+    }
+    return elements_.size();
+  }
+  // Kind-aware element access; `index` must be below elementCount().
+  Value element(size_t index) const {
+    switch (elementKind_) {
+      case ElementKind::PackedInt32: return Value(int32Elements_[index]);
+      case ElementKind::PackedDouble: return Value(doubleElements_[index]);
+      case ElementKind::Generic: break;
+    }
+    return elements_[index];
+  }
+  void setElement(size_t index, const Value& value);
+  void pushElement(const Value& value);
+  // Truncate, or pad with undefined (which makes the array Generic).
+  void resizeElements(size_t count);
+  // Replace the contents, using the narrowest kind that holds all of them.
+  void assignElements(std::vector<Value> values);
+  // Stack and splice operations that keep the current kind, widening only
+  // as far as inserted values need. `index`/`count` must be in range.
+  Value popElement();
+  void eraseElements(size_t index, size_t count);
+  void insertElements(size_t index, std::span<const Value> values);
+  void reverseElements();
+  // Go back to the narrowest kind after a Generic array (e.g. one created
+  // padded with holes) has been filled with numbers.
+  void narrowElements();
+
+  // Elements as Values. Packed storage is converted to Generic on first
+  // use, so callers that need references or vector operations keep working.
+  std::vector<Value>& elements() {
+    if (elementKind_ != ElementKind::Generic) {
+      makeGeneric();
+    }
+    return elements_;
+  }
 
   // GCObject interface
   const char* typeName() const override { return "Array"; }
   void getReferences(std::vector<GCObject*>& refs) const override;
+  void clearReferences() override;
+
+private:
+  ElementKind elementKind_ = ElementKind::PackedInt32;
+  std::vector<int32_t> int32Elements_;
+  std::vector<double> doubleElements_;
+  std::vector<Value> elements_;
+
+  void makeDouble();
+  void makeGeneric();
 };
 
 struct Object : public GCObject {
-  OrderedMap<std::string, Value> properties;  // Fallback for dynamic properties
-  std::vector<Value> slots;  // Fast slot-based storage for known properties
-  std::shared_ptr<ObjectShape> shape;  // Shape for inline caching optimization
+  PropertyMap properties;  // Shape + slots; dictionary fallback
   bool isModuleNamespace = false;  // Special handling for ES module namespace objects.
   bool isDeferredModuleNamespace = false;  // Distinguish defer-phase namespace objects.
   std::vector<std::string> moduleExportNames;  // Sorted string export keys.
   bool frozen = false;  // Object.freeze() prevents adding/removing/modifying properties
   bool sealed = false;  // Object.seal() prevents adding/removing properties (can still modify)
   bool nonExtensible = false;  // Object.preventExtensions() prevents adding new properties only
-  bool useSlots = false;  // Whether to use slot-based storage
-
-  Object() : shape(nullptr) {}  // Shape created lazily when needed
-
-  // Fast property access using slots (defined after Value is complete)
-  bool getSlot(int offset, Value& out) const;
-  void setSlot(int offset, const Value& value);
 
   // GCObject interface
   const char* typeName() const override { return "Object"; }
   void getReferences(std::vector<GCObject*>& refs) const override;
+  void clearReferences() override;
+};
+
+// Insertion-ordered hash table behind Map and Set, keyed by SameValueZero.
+// Entries are appended to a vector in insertion order and each bucket chains
+// through it by index. Deleting leaves a tombstone that is compacted away on
+// the next rehash. Every entry is stamped with an ordinal that is never
+// reused, so iteration cursors survive deletes, clear() and compaction.
+class OrderedHashTable {
+public:
+  struct Entry {
+    Value key;
+    Value value;
+    size_t ordinal = 0;
+    uint32_t chain = 0;
+    bool deleted = false;
+  };
+
+  const Entry* find(const Value& key) const;
+  // Returns false when the key was already present (its value is replaced).
+  bool set(const Value& key, const Value& value);
+  bool remove(const Value& key);
+  void clear();
+  size_t size() const { return liveCount_; }
+
+  // Returns the first live entry at or after `cursor` and moves the cursor
+  // past it, or nullptr at the end. Start iteration with cursor 0. The entry
+  // pointer is invalidated by the next insertion.
+  const Entry* next(size_t& cursor) const;
+
+  // Calls fn(key, value) for each entry in insertion order. fn may mutate
+  // the table; entries added during the walk are visited as well.
+  template <typename Fn>
+  void forEach(Fn&& fn) const {
+    size_t cursor = 0;
+    while (const Entry* entry = next(cursor)) {
+      Value key = entry->key;
+      Value value = entry->value;
+      fn(key, value);
+    }
+  }
+
+  // Snapshot of the live keys in insertion order.
+  std::vector<Value> keys() const;
+
+  void getReferences(std::vector<GCObject*>& refs) const;
+
+private:
+  static constexpr uint32_t kNoEntry = UINT32_MAX;
+
+  std::vector<Entry> entries_;
+  std::vector<uint32_t> buckets_;
+  size_t liveCount_ = 0;
+  size_t nextOrdinal_ = 0;
+
+  Entry* lookup(const Value& key, size_t hash);
+  void rehash(size_t bucketCount);
 };
 
 // Map collection - maintains insertion order
 struct Map : public GCObject {
-  std::vector<std::pair<Value, Value>> entries;
-  OrderedMap<std::string, Value> properties;
+  OrderedHashTable table;
+  PropertyMap properties;
 
-  void set(const Value& key, const Value& value);
-  bool has(const Value& key) const;
+  void set(const Value& key, const Value& value) { table.set(key, value); }
+  bool has(const Value& key) const { return table.find(key) != nullptr; }
   Value get(const Value& key) const;
-  bool deleteKey(const Value& key);
-  void clear() { entries.clear(); }
-  size_t size() const { return entries.size(); }
+  bool deleteKey(const Value& key) { return table.remove(key); }
+  void clear() { table.clear(); }
+  size_t size() const { return table.size(); }
 
   // GCObject interface
   const char* typeName() const override { return "Map"; }
   void getReferences(std::vector<GCObject*>& refs) const override;
+  void clearReferences() override;
 };
 
 // Set collection - maintains insertion order
 struct Set : public GCObject {
-  std::vector<Value> values;
-  OrderedMap<std::string, Value> properties;
+  OrderedHashTable table;  // Entry values are unused
+  PropertyMap properties;
 
-  bool add(const Value& value);
-  bool has(const Value& value) const;
-  bool deleteValue(const Value& value);
-  void clear() { values.clear(); }
-  size_t size() const { return values.size(); }
+  bool add(const Value& value) { return table.set(value, Value(Undefined{})); }
+  bool has(const Value& value) const { return table.find(value) != nullptr; }
+  bool deleteValue(const Value& value) { return table.remove(value); }
+  void clear() { table.clear(); }
+  size_t size() const { return table.size(); }
 
   // GCObject interface
   const char* typeName() const override { return "Set"; }
   void getReferences(std::vector<GCObject*>& refs) const override;
+  void clearReferences() override;
 };
 
 // WeakMap - weak references to object keys (keys can be garbage collected)
@@ -171,7 +313,7 @@ struct Set : public GCObject {
 struct WeakMap : public GCObject {
   std::unordered_map<GCObject*, Value> entries;  // Map from object pointer to value
   std::unordered_map<size_t, Value> symbolEntries;  // Map from Symbol::id to value
-  OrderedMap<std::string, Value> properties;
+  PropertyMap properties;
 
   void set(const Value& key, const Value& value);
   bool has(const Value& key) const;
@@ -182,13 +324,14 @@ struct WeakMap : public GCObject {
   // GCObject interface
   const char* typeName() const override { return "WeakMap"; }
   void getReferences(std::vector<GCObject*>& refs) const override;
+  void clearReferences() override;
 };
 
 // WeakSet - weak references to objects
 struct WeakSet : public GCObject {
   std::unordered_set<GCObject*> values;  // Set of object pointers
   std::unordered_set<size_t> symbolValues;  // Set of Symbol::id values
-  OrderedMap<std::string, Value> properties;
+  PropertyMap properties;
 
   bool add(const Value& value);
   bool has(const Value& value) const;
@@ -198,6 +341,7 @@ struct WeakSet : public GCObject {
   // GCObject interface
   const char* typeName() const override { return "WeakSet"; }
   void getReferences(std::vector<GCObject*>& refs) const override;
+  void clearReferences() override;
 };
 
 struct Regex : public GCObject {
@@ -209,7 +353,7 @@ struct Regex : public GCObject {
   std::string pattern;
   std::string flags;
   std::vector<std::string> captureGroupNames;
-  OrderedMap<std::string, Value> properties;
+  PropertyMap properties;
 
   Regex(const std::string& p, const std::string& f = "")
     : pattern(p),
@@ -298,6 +442,7 @@ struct Regex : public GCObject {
   // GCObject interface
   const char* typeName() const override { return "Regex"; }
   void getReferences(std::vector<GCObject*>& refs) const override;
+  void clearReferences() override;
 };
 
 // Error types for JavaScript exceptions
@@ -311,11 +456,46 @@ enum class ErrorType {
   EvalError        // eval() errors (legacy)
 };
 
+// Throw completion reported by a FastNativeFunction: either an error to
+// create from a type and message, or an arbitrary thrown value.
+struct NativeThrow {
+  bool pending = false;
+  ErrorType type = ErrorType::Error;
+  std::string message;
+  std::optional<Value> value;
+
+  Value error(ErrorType errorType, std::string errorMessage) {
+    pending = true;
+    type = errorType;
+    message = std::move(errorMessage);
+    return Value(Undefined{});
+  }
+  Value throwValue(Value thrownValue) {
+    pending = true;
+    value = std::move(thrownValue);
+    return Value(Undefined{});
+  }
+};
+
+// Install `fn` as `func`'s fast entry point, with an adapter in nativeFunc
+// for C++ callers that still use the vector convention. With `usesThis`,
+// that adapter takes the receiver as args[0], as "__uses_this_arg__"
+// natives do.
+void setFastNative(Function& func, FastNativeFunction fn, bool usesThis);
+
+// Calls `fn` for native code that still reports errors as exceptions: a
+// pending NativeThrow is rethrown as JsValueException or a "TypeError: ..."
+// style runtime_error.
+Value invokeFastNative(FastNativeFunction fn, const Value& thisValue, std::span<const Value> args);
+
 struct Error : public GCObject {
   ErrorType type;
   std::string message;
-  std::string stack;  // Optional stack trace
-  OrderedMap<std::string, Value> properties;
+  PropertyMap properties;
+  // Call frames captured at throw time. Formatting them is deferred to the
+  // first stack() read, so throws that are caught and discarded never build
+  // the string.
+  mutable std::shared_ptr<const CapturedStack> capturedStack;
 
   Error(ErrorType t = ErrorType::Error, const std::string& msg = "")
     : type(t), message(msg) {}
@@ -340,9 +520,16 @@ struct Error : public GCObject {
     return getName() + ": " + message;
   }
 
+  // "Name: message" followed by the captured frames
+  const std::string& stack() const;
+
   // GCObject interface
   const char* typeName() const override { return "Error"; }
   void getReferences(std::vector<GCObject*>& refs) const override;
+  void clearReferences() override;
+
+private:
+  mutable std::optional<std::string> formattedStack_;
 };
 
 // Generator state for iterator protocol
@@ -359,7 +546,7 @@ struct Generator : public GCObject {
   std::shared_ptr<Value> currentValue;  // Last yielded or returned value
   size_t yieldIndex;   // Index of last yield point (for resumption)
   std::shared_ptr<void> suspendedTask;  // Suspended C++ coroutine (Task)
-  OrderedMap<std::string, Value> properties;
+  PropertyMap properties;
 
   Generator(GCPtr<Function> func, GCPtr<Environment> ctx)
     : function(func), context(ctx), state(GeneratorState::SuspendedStart),
@@ -372,6 +559,7 @@ struct Generator : public GCObject {
   // GCObject interface
   const char* typeName() const override { return "Generator"; }
   void getReferences(std::vector<GCObject*>& refs) const override;
+  void clearReferences() override;
 };
 
 // Proxy for intercept operations on objects
@@ -389,6 +577,7 @@ struct Proxy : public GCObject {
   // GCObject interface
   const char* typeName() const override { return "Proxy"; }
   void getReferences(std::vector<GCObject*>& refs) const override;
+  void clearReferences() override;
 };
 
 // ArrayBuffer - Fixed-length raw binary data buffer
@@ -400,7 +589,7 @@ struct ArrayBuffer : public GCObject {
   bool detached;
   bool immutable;
   std::vector<GCPtr<TypedArray>> views;
-  OrderedMap<std::string, Value> properties;
+  PropertyMap properties;
 
   ArrayBuffer(size_t length, size_t maxLength = 0)
     : byteLength(length),
@@ -445,6 +634,7 @@ struct ArrayBuffer : public GCObject {
   // GCObject interface
   const char* typeName() const override { return "ArrayBuffer"; }
   void getReferences(std::vector<GCObject*>& refs) const override;
+  void clearReferences() override;
 };
 
 // DataView - Low-level interface for reading/writing multiple number types in an ArrayBuffer
@@ -453,7 +643,7 @@ struct DataView : public GCObject {
   size_t byteOffset;
   size_t byteLength;
   bool lengthTracking;
-  OrderedMap<std::string, Value> properties;
+  PropertyMap properties;
 
   DataView(GCPtr<ArrayBuffer> buf, size_t offset = 0, size_t length = 0)
     : buffer(buf), byteOffset(offset), byteLength(length), lengthTracking(false) {
@@ -501,6 +691,7 @@ struct DataView : public GCObject {
   // GCObject interface
   const char* typeName() const override { return "DataView"; }
   void getReferences(std::vector<GCObject*>& refs) const override;
+  void clearReferences() override;
 };
 
 enum class TypedArrayType {
@@ -618,7 +809,7 @@ struct TypedArray : public GCObject {
   size_t byteOffset;
   size_t length;
   bool lengthTracking;
-  OrderedMap<std::string, Value> properties;
+  PropertyMap properties;
 
   TypedArray(TypedArrayType t, size_t len)
     : type(t), byteOffset(0), length(len), lengthTracking(false) {
@@ -690,6 +881,7 @@ struct TypedArray : public GCObject {
   // GCObject interface
   const char* typeName() const override { return "TypedArray"; }
   void getReferences(std::vector<GCObject*>& refs) const override;
+  void clearReferences() override;
 };
 
 enum class PromiseState {
@@ -704,7 +896,7 @@ struct Promise : public GCObject {
   std::vector<std::function<Value(Value)>> fulfilledCallbacks;
   std::vector<std::function<Value(Value)>> rejectedCallbacks;
   std::vector<GCPtr<Promise>> chainedPromises;
-  OrderedMap<std::string, Value> properties;
+  PropertyMap properties;
 
   Promise() : state(PromiseState::Pending), result(Undefined{}) {}
 
@@ -727,6 +919,7 @@ struct Promise : public GCObject {
   // GCObject interface
   const char* typeName() const override { return "Promise"; }
   void getReferences(std::vector<GCObject*>& refs) const override;
+  void clearReferences() override;
 };
 
 // Pre-allocated common values to avoid repeated allocation
@@ -773,41 +966,9 @@ public:
   }
 };
 
-// Small integer cache for frequently used values (0-255)
-class SmallIntCache {
-public:
-  static constexpr int MIN_CACHED = 0;
-  static constexpr int MAX_CACHED = 255;
-
-  static const Value& get(int n) {
-    static SmallIntCache instance;
-    if (n >= MIN_CACHED && n <= MAX_CACHED) {
-      return instance.cache_[n - MIN_CACHED];
-    }
-    // Return a reference to a static value for out-of-range
-    static Value outOfRange;
-    outOfRange = Value(static_cast<double>(n));
-    return outOfRange;
-  }
-
-  static bool inRange(double d) {
-    int i = static_cast<int>(d);
-    return d == static_cast<double>(i) && i >= MIN_CACHED && i <= MAX_CACHED;
-  }
-
-private:
-  SmallIntCache() {
-    for (int i = MIN_CACHED; i <= MAX_CACHED; ++i) {
-      cache_[i - MIN_CACHED] = Value(static_cast<double>(i));
-    }
-  }
-
-  Value cache_[MAX_CACHED - MIN_CACHED + 1];
-};
-
 // Internal property-key helpers used by runtime objects/builtins.
 // Symbol keys are encoded as stable internal strings so different symbols with
-// the same description don't collide in OrderedMap<string, Value>.
+// the same description don't collide in PropertyMap.
 std::string symbolToPropertyKey(const Symbol& symbol);
 bool isSymbolPropertyKey(const std::string& key);
 bool propertyKeyToSymbol(const std::string& key, Symbol& outSymbol);
@@ -14,6 +14,7 @@
 #include <functional>
 #include <optional>
 #include <cstdint>
+#include <cmath>
 #include <cstring>
 #include "bigint.h"
 #include "gc.h"
@@ -94,6 +95,64 @@ struct ModuleBinding {
 struct TypedArray; // forward for variant
 struct Date;
 
+// Immutable, reference-counted out-of-line storage for the Value payloads
+// that are wider than a pointer (strings, symbols, BigInts, module
+// bindings). Keeping them behind one pointer makes every Value alternative
+// 8 bytes, so a Value is a payload word plus the variant tag and copying
+// one never allocates. The payload is never mutated after construction,
+// which is what lets copies share it. Like GCObject's count, the reference
+// count is plain: Values are only copied on the interpreter thread (the
+// parallel collector traces objects but never copies a Value).
+template<typename T>
+class ValueBox {
+public:
+  ValueBox(T value) : node_(new Node{std::move(value), 1}) {}
+  ValueBox(const ValueBox& other) noexcept : node_(other.node_) { retain(); }
+  ValueBox(ValueBox&& other) noexcept : node_(other.node_) { other.node_ = nullptr; }
+  ~ValueBox() { drop(); }
+
+  ValueBox& operator=(const ValueBox& other) noexcept {
+    if (node_ != other.node_) {
+      other.retain();
+      drop();
+      node_ = other.node_;
+    }
+    return *this;
+  }
+  ValueBox& operator=(ValueBox&& other) noexcept {
+    if (this != &other) {
+      drop();
+      node_ = other.node_;
+      other.node_ = nullptr;
+    }
+    return *this;
+  }
+
+  // A moved-from box reads as a default-constructed payload.
+  const T& get() const { return node_ ? node_->value : empty(); }
+
+private:
+  struct Node {
+    T value;
+    uint32_t refs;
+  };
+  Node* node_;
+
+  void retain() const {
+    if (node_) ++node_->refs;
+  }
+  void drop() {
+    if (node_ && --node_->refs == 0) {
+      delete node_;
+    }
+    node_ = nullptr;
+  }
+  static const T& empty() {
+    static const T value{};
+    return value;
+  }
+};
+
 struct Value {
   std::variant<
     Undefined,
@@ -101,10 +160,11 @@ struct Value {
     Null,
     bool,
     double,
-    BigInt,
-    Symbol,
-    ModuleBinding,
-    std::string,
+    int32_t,
+    ValueBox<BigInt>,
+    ValueBox<Symbol>,
+    ValueBox<ModuleBinding>,
+    ValueBox<std::string>,
     GCPtr<Function>,
     GCPtr<Array>,
     GCPtr<Object>,
@@ -126,8 +186,7 @@ struct Value {
     GCPtr<ReadableStream>,
     GCPtr<WritableStream>,
     GCPtr<TransformStream>,
-    GCPtr<Environment>,
-    std::shared_ptr<void>
+    GCPtr<Environment>
   > data;
 
   Value() : data(Undefined{}) {}
@@ -136,14 +195,15 @@ struct Value {
   Value(Null n) : data(n) {}
   Value(bool b) : data(b) {}
   Value(double d) : data(d) {}
-  Value(int i) : data(static_cast<double>(i)) {}
-  Value(BigInt bi) : data(bi) {}
+  Value(int32_t i) : data(std::in_place_type<int32_t>, i) {}
+  Value(BigInt bi) : data(ValueBox<BigInt>(std::move(bi))) {}
   Value(const bigint::BigIntValue& bi) : data(BigInt(bi)) {}
   Value(int64_t i) : data(BigInt(i)) {}
-  Value(Symbol sym) : data(sym) {}
-  Value(ModuleBinding binding) : data(std::move(binding)) {}
-  Value(const std::string& s) : data(s) {}
-  Value(const char* s) : data(std::string(s)) {}
+  Value(Symbol sym) : data(ValueBox<Symbol>(std::move(sym))) {}
+  Value(ModuleBinding binding) : data(ValueBox<ModuleBinding>(std::move(binding))) {}
+  Value(const std::string& s) : data(ValueBox<std::string>(s)) {}
+  Value(std::string&& s) : data(ValueBox<std::string>(std::move(s))) {}
+  Value(const char* s) : data(ValueBox<std::string>(std::string(s))) {}
 
   // Backwards compatibility constructors (temporary)
   Value(GCPtr<Function> f) : data(f) {}
@@ -168,17 +228,22 @@ struct Value {
   Value(GCPtr<ReadableStream> rs) : data(rs) {}
   Value(GCPtr<WritableStream> ws) : data(ws) {}
   Value(GCPtr<TransformStream> ts) : data(ts) {}
-  Value(std::shared_ptr<void> d) : data(d) {}
 
   bool isUndefined() const { return std::holds_alternative<Undefined>(data); }
   bool isEmpty() const { return std::holds_alternative<Empty>(data); }
   bool isNull() const { return std::holds_alternative<Null>(data); }
   bool isBool() const { return std::holds_alternative<bool>(data); }
-  bool isNumber() const { return std::holds_alternative<double>(data); }
-  bool isBigInt() const { return std::holds_alternative<BigInt>(data); }
-  bool isSymbol() const { return std::holds_alternative<Symbol>(data); }
-  bool isModuleBinding() const { return std::holds_alternative<ModuleBinding>(data); }
-  bool isString() const { return std::holds_alternative<std::string>(data); }
+  // Numbers have two representations: int32 for integral values that fit
+  // (never -0), double for everything else. Both are the Number type; code
+  // that needs the numeric value reads it through asNumber().
+  bool isNumber() const {
+    return std::holds_alternative<double>(data) || std::holds_alternative<int32_t>(data);
+  }
+  bool isInt32() const { return std::holds_alternative<int32_t>(data); }
+  bool isBigInt() const { return std::holds_alternative<ValueBox<BigInt>>(data); }
+  bool isSymbol() const { return std::holds_alternative<ValueBox<Symbol>>(data); }
+  bool isModuleBinding() const { return std::holds_alternative<ValueBox<ModuleBinding>>(data); }
+  bool isString() const { return std::holds_alternative<ValueBox<std::string>>(data); }
   bool isFunction() const { return std::holds_alternative<GCPtr<Function>>(data); }
   bool isArray() const { return std::holds_alternative<GCPtr<Array>>(data); }
   bool isObject() const { return std::holds_alternative<GCPtr<Object>>(data); }
@@ -201,6 +266,17 @@ struct Value {
   bool isWritableStream() const { return std::holds_alternative<GCPtr<WritableStream>>(data); }
   bool isTransformStream() const { return std::holds_alternative<GCPtr<TransformStream>>(data); }
 
+  // Payload accessors; the caller must have checked the matching isX().
+  double asNumber() const {
+    if (auto* i = std::get_if<int32_t>(&data)) return *i;
+    return std::get<double>(data);
+  }
+  int32_t asInt32() const { return std::get<int32_t>(data); }
+  const std::string& asString() const { return std::get<ValueBox<std::string>>(data).get(); }
+  const Symbol& asSymbol() const { return std::get<ValueBox<Symbol>>(data).get(); }
+  const BigInt& asBigInt() const { return std::get<ValueBox<BigInt>>(data).get(); }
+  const ModuleBinding& asModuleBinding() const { return std::get<ValueBox<ModuleBinding>>(data).get(); }
+
   template<typename T>
   GCPtr<T> getGC() const {
     if (auto* ptr = std::get_if<GCPtr<T>>(&data)) {
@@ -209,6 +285,12 @@ struct Value {
     return GCPtr<T>{};
   }
 
+  // Same ECMAScript type: like comparing data.index(), except that the int32
+  // and double representations are both Number.
+  bool hasSameType(const Value& other) const {
+    return data.index() == other.data.index() || (isNumber() && other.isNumber());
+  }
+
   bool toBool() const;
   double toNumber() const;
   bigint::BigIntValue toBigInt() const;
@@ -219,6 +301,20 @@ struct Value {
   void getReferences(std::vector<GCObject*>& refs) const;
 };
 
+static_assert(sizeof(Value) <= 16, "Value should stay a tagged machine word");
+
+// Number value in its canonical representation: int32 when `d` is integral,
+// in range and not -0, double otherwise.
+inline Value numberValue(double d) {
+  if (d >= -2147483648.0 && d <= 2147483647.0) {
+    auto i = static_cast<int32_t>(d);
+    if (static_cast<double>(i) == d && (i != 0 || !std::signbit(d))) {
+      return Value(i);
+    }
+  }
+  return Value(d);
+}
+
 using ValuePtr = std::shared_ptr<Value>;
 
 }
@@ -1,195 +1,203 @@
-#include "value.h"
-#include "streams.h"
-#include "wasm_js.h"
+#include "array_methods.h"
+#include "interpreter.h"
 #include "gc.h"
-#include <stdexcept>
 #include <algorithm>
 
 namespace lightjs {
 
-// Array.prototype.push
-Value Array_push(const std::vector<Value>& args) {
-    if (args.empty() || !args[0].isArray()) {
-        throw std::runtime_error("Array.push called on non-array");
+namespace {
+
+// Every method here works on real arrays only; false once `thrown` is set
+bool requireArray(const Value& thisValue, const char* methodName, NativeThrow& thrown) {
+    if (thisValue.isArray()) return true;
+    thrown.error(ErrorType::TypeError, std::string("Array.") + methodName + " called on non-array");
+    return false;
+}
+
+bool requireCallback(std::span<const Value> args, const char* methodName, NativeThrow& thrown) {
+    if (!args.empty() && args[0].isFunction()) return true;
+    thrown.error(ErrorType::TypeError, std::string("Array.") + methodName + " requires a callback function");
+    return false;
+}
+
+// Calls `callback` on the interpreter; an exception it throws is moved into
+// `thrown`, so callers check thrown.pending afterwards.
+Value callCallback(Interpreter& interpreter, const Value& callback, const std::vector<Value>& callArgs,
+                   NativeThrow& thrown) {
+    Value result = interpreter.callForHarness(callback, callArgs, Value(Undefined{}));
+    if (interpreter.hasError()) {
+        Value error = interpreter.getError();
+        interpreter.clearError();
+        thrown.throwValue(error);
     }
+    return result;
+}
+
+} // namespace
+
+// Array.prototype.push
+Value Array_push(const Value& thisValue, std::span<const Value> args, Interpreter&, NativeThrow& thrown) {
+    if (!requireArray(thisValue, "push", thrown)) return Value(Undefined{});
 
-    auto arr = args[0].getGC<Array>();
+    auto arr = thisValue.getGC<Array>();
 
     // Push all arguments to the array
-    for (size_t i = 1; i < args.size(); ++i) {
-        arr->elements.push_back(args[i]);
+    for (const Value& arg : args) {
+        arr->pushElement(arg);
     }
 
-    return Value(static_cast<double>(arr->elements.size()));
+    return Value(static_cast<double>(arr->elementCount()));
 }
 
 // Array.prototype.pop
-Value Array_pop(const std::vector<Value>& args) {
-    if (args.empty() || !args[0].isArray()) {
-        throw std::runtime_error("Array.pop called on non-array");
-    }
+Value Array_pop(const Value& thisValue, std::span<const Value>, Interpreter&, NativeThrow& thrown) {
+    if (!requireArray(thisValue, "pop", thrown)) return Value(Undefined{});
 
-    auto arr = args[0].getGC<Array>();
+    auto arr = thisValue.getGC<Array>();
 
-    if (arr->elements.empty()) {
+    if (arr->elementCount() == 0) {
         return Value(Undefined{});
     }
 
-    Value result = arr->elements.back();
-    arr->elements.pop_back();
-    return result;
+    return arr->popElement();
 }
 
 // Array.prototype.shift
-Value Array_shift(const std::vector<Value>& args) {
-    if (args.empty() || !args[0].isArray()) {
-        throw std::runtime_error("Array.shift called on non-array");
-    }
+Value Array_shift(const Value& thisValue, std::span<const Value>, Interpreter&, NativeThrow& thrown) {
+    if (!requireArray(thisValue, "shift", thrown)) return Value(Undefined{});
 
-    auto arr = args[0].getGC<Array>();
+    auto arr = thisValue.getGC<Array>();
 
-    if (arr->elements.empty()) {
+    if (arr->elementCount() == 0) {
         return Value(Undefined{});
     }
 
-    Value result = arr->elements.front();
-    arr->elements.erase(arr->elements.begin());
+    Value result = arr->element(0);
+    arr->eraseElements(0, 1);
     return result;
 }
 
 // Array.prototype.unshift
-Value Array_unshift(const std::vector<Value>& args) {
-    if (args.empty() || !args[0].isArray()) {
-        throw std::runtime_error("Array.unshift called on non-array");
-    }
+Value Array_unshift(const Value& thisValue, std::span<const Value> args, Interpreter&, NativeThrow& thrown) {
+    if (!requireArray(thisValue, "unshift", thrown)) return Value(Undefined{});
 
-    auto arr = args[0].getGC<Array>();
+    auto arr = thisValue.getGC<Array>();
 
     // Insert all arguments at the beginning
-    for (size_t i = 1; i < args.size(); ++i) {
-        arr->elements.insert(arr->elements.begin() + (i - 1), args[i]);
-    }
+    arr->insertElements(0, args);
 
-    return Value(static_cast<double>(arr->elements.size()));
+    return Value(static_cast<double>(arr->elementCount()));
 }
 
 // Array.prototype.slice
-Value Array_slice(const std::vector<Value>& args) {
-    if (args.empty() || !args[0].isArray()) {
-        throw std::runtime_error("Array.slice called on non-array");
-    }
+Value Array_slice(const Value& thisValue, std::span<const Value> args, Interpreter&, NativeThrow& thrown) {
+    if (!requireArray(thisValue, "slice", thrown)) return Value(Undefined{});
 
-    auto arr = args[0].getGC<Array>();
+    auto arr = thisValue.getGC<Array>();
     auto result = GarbageCollector::makeGC<Array>();
     GarbageCollector::instance().reportAllocation(sizeof(Array));
 
-    size_t len = arr->elements.size();
+    size_t len = arr->elementCount();
     int start = 0;
     int end = static_cast<int>(len);
 
-    if (args.size() > 1 && args[1].isNumber()) {
-        start = static_cast<int>(std::get<double>(args[1].data));
+    if (args.size() > 0 && args[0].isNumber()) {
+        start = static_cast<int>(args[0].asNumber());
         if (start < 0) start = std::max(0, static_cast<int>(len) + start);
         if (start > static_cast<int>(len)) start = len;
     }
 
-    if (args.size() > 2 && args[2].isNumber()) {
-        end = static_cast<int>(std::get<double>(args[2].data));
+    if (args.size() > 1 && args[1].isNumber()) {
+        end = static_cast<int>(args[1].asNumber());
         if (end < 0) end = std::max(0, static_cast<int>(len) + end);
         if (end > static_cast<int>(len)) end = len;
     }
 
     for (int i = start; i < end; ++i) {
-        result->elements.push_back(arr->elements[i]);
+        result->pushElement(arr->element(i));
     }
 
     return Value(result);
 }
 
 // Array.prototype.splice
-Value Array_splice(const std::vector<Value>& args) {
-    if (args.empty() || !args[0].isArray()) {
-        throw std::runtime_error("Array.splice called on non-array");
-    }
+Value Array_splice(const Value& thisValue, std::span<const Value> args, Interpreter&, NativeThrow& thrown) {
+    if (!requireArray(thisValue, "splice", thrown)) return Value(Undefined{});
 
-    auto arr = args[0].getGC<Array>();
+    auto arr = thisValue.getGC<Array>();
     auto removed = GarbageCollector::makeGC<Array>();
     GarbageCollector::instance().reportAllocation(sizeof(Array));
 
-    size_t len = arr->elements.size();
+    size_t len = arr->elementCount();
     int start = 0;
     int deleteCount = len;
 
-    if (args.size() > 1 && args[1].isNumber()) {
-        start = static_cast<int>(std::get<double>(args[1].data));
+    if (args.size() > 0 && args[0].isNumber()) {
+        start = static_cast<int>(args[0].asNumber());
         if (start < 0) start = std::max(0, static_cast<int>(len) + start);
         if (start > static_cast<int>(len)) start = len;
     }
 
-    if (args.size() > 2 && args[2].isNumber()) {
-        deleteCount = std::max(0, static_cast<int>(std::get<double>(args[2].data)));
-        deleteCount = std::min(deleteCount, static_cast<int>(len) - start);
+    if (args.size() > 1 && args[1].isNumber()) {
+        deleteCount = std::max(0, static_cast<int>(args[1].asNumber()));
     }
+    deleteCount = std::min(deleteCount, static_cast<int>(len) - start);
 
     // Remove elements and store them
     for (int i = 0; i < deleteCount; ++i) {
-        removed->elements.push_back(arr->elements[start]);
-        arr->elements.erase(arr->elements.begin() + start);
+        removed->pushElement(arr->element(start + i));
     }
+    arr->eraseElements(start, deleteCount);
 
     // Insert new elements
-    for (size_t i = 3; i < args.size(); ++i) {
-        arr->elements.insert(arr->elements.begin() + start + (i - 3), args[i]);
+    if (args.size() > 2) {
+        arr->insertElements(start, args.subspan(2));
     }
 
     return Value(removed);
 }
 
 // Array.prototype.join
-Value Array_join(const std::vector<Value>& args) {
-    if (args.empty() || !args[0].isArray()) {
-        throw std::runtime_error("Array.join called on non-array");
-    }
+Value Array_join(const Value& thisValue, std::span<const Value> args, Interpreter&, NativeThrow& thrown) {
+    if (!requireArray(thisValue, "join", thrown)) return Value(Undefined{});
 
-    auto arr = args[0].getGC<Array>();
+    auto arr = thisValue.getGC<Array>();
     std::string separator = ",";
 
-    if (args.size() > 1 && args[1].isString()) {
-        separator = std::get<std::string>(args[1].data);
+    if (args.size() > 0 && args[0].isString()) {
+        separator = args[0].asString();
     }
 
     std::string result;
-    for (size_t i = 0; i < arr->elements.size(); ++i) {
+    for (size_t i = 0; i < arr->elementCount(); ++i) {
         if (i > 0) result += separator;
-        result += arr->elements[i].toString();
+        result += arr->element(i).toString();
     }
 
     return Value(result);
 }
 
 // Array.prototype.indexOf
-Value Array_indexOf(const std::vector<Value>& args) {
-    if (args.empty() || !args[0].isArray()) {
-        throw std::runtime_error("Array.indexOf called on non-array");
-    }
+Value Array_indexOf(const Value& thisValue, std::span<const Value> args, Interpreter&, NativeThrow& thrown) {
+    if (!requireArray(thisValue, "indexOf", thrown)) return Value(Undefined{});
 
-    auto arr = args[0].getGC<Array>();
+    auto arr = thisValue.getGC<Array>();
 
-    if (args.size() < 2) {
+    if (args.empty()) {
         return Value(-1.0);
     }
 
-    Value searchElement = args[1];
+    Value searchElement = args[0];
     int fromIndex = 0;
 
-    if (args.size() > 2 && args[2].isNumber()) {
-        fromIndex = static_cast<int>(std::get<double>(args[2].data));
-        if (fromIndex < 0) fromIndex = std::max(0, static_cast<int>(arr->elements.size()) + fromIndex);
+    if (args.size() > 1 && args[1].isNumber()) {
+        fromIndex = static_cast<int>(args[1].asNumber());
+        if (fromIndex < 0) fromIndex = std::max(0, static_cast<int>(arr->elementCount()) + fromIndex);
     }
 
-    for (size_t i = fromIndex; i < arr->elements.size(); ++i) {
+    for (size_t i = fromIndex; i < arr->elementCount(); ++i) {
         // Simple equality check - should use SameValueZero
-        if (arr->elements[i].toString() == searchElement.toString()) {
+        if (arr->element(i).toString() == searchElement.toString()) {
             return Value(static_cast<double>(i));
         }
     }
@@ -198,28 +206,26 @@ Value Array_indexOf(const std::vector<Value>& args) {
 }
 
 // Array.prototype.includes
-Value Array_includes(const std::vector<Value>& args) {
-    if (args.empty() || !args[0].isArray()) {
-        throw std::runtime_error("Array.includes called on non-array");
-    }
+Value Array_includes(const Value& thisValue, std::span<const Value> args, Interpreter&, NativeThrow& thrown) {
+    if (!requireArray(thisValue, "includes", thrown)) return Value(Undefined{});
 
-    auto arr = args[0].getGC<Array>();
+    auto arr = thisValue.getGC<Array>();
 
-    if (args.size() < 2) {
+    if (args.empty()) {
         return Value(false);
     }
 
-    Value searchElement = args[1];
+    Value searchElement = args[0];
     int fromIndex = 0;
 
-    if (args.size() > 2 && args[2].isNumber()) {
-        fromIndex = static_cast<int>(std::get<double>(args[2].data));
-        if (fromIndex < 0) fromIndex = std::max(0, static_cast<int>(arr->elements.size()) + fromIndex);
+    if (args.size() > 1 && args[1].isNumber()) {
+        fromIndex = static_cast<int>(args[1].asNumber());
+        if (fromIndex < 0) fromIndex = std::max(0, static_cast<int>(arr->elementCount()) + fromIndex);
     }
 
-    for (size_t i = fromIndex; i < arr->elements.size(); ++i) {
+    for (size_t i = fromIndex; i < arr->elementCount(); ++i) {
         // Simple equality check
-        if (arr->elements[i].toString() == searchElement.toString()) {
+        if (arr->element(i).toString() == searchElement.toString()) {
             return Value(true);
         }
     }
@@ -228,38 +234,35 @@ Value Array_includes(const std::vector<Value>& args) {
 }
 
 // Array.prototype.reverse
-Value Array_reverse(const std::vector<Value>& args) {
-    if (args.empty() || !args[0].isArray()) {
-        throw std::runtime_error("Array.reverse called on non-array");
-    }
+Value Array_reverse(const Value& thisValue, std::span<const Value>, Interpreter&, NativeThrow& thrown) {
+    if (!requireArray(thisValue, "reverse", thrown)) return Value(Undefined{});
 
-    auto arr = args[0].getGC<Array>();
-    std::reverse(arr->elements.begin(), arr->elements.end());
-    return args[0]; // Return the array itself
+    thisValue.getGC<Array>()->reverseElements();
+    return thisValue; // Return the array itself
 }
 
 // Array.prototype.concat
-Value Array_concat(const std::vector<Value>& args) {
-    if (args.empty() || !args[0].isArray()) {
-        throw std::runtime_error("Array.concat called on non-array");
-    }
+Value Array_concat(const Value& thisValue, std::span<const Value> args, Interpreter&, NativeThrow& thrown) {
+    if (!requireArray(thisValue, "concat", thrown)) return Value(Undefined{});
 
-    auto arr = args[0].getGC<Array>();
+    auto arr = thisValue.getGC<Array>();
     auto result = GarbageCollector::makeGC<Array>();
     GarbageCollector::instance().reportAllocation(sizeof(Array));
 
     // Copy original array elements
-    result->elements = arr->elements;
+    for (size_t i = 0; i < arr->elementCount(); ++i) {
+        result->pushElement(arr->element(i));
+    }
 
     // Add all arguments
-    for (size_t i = 1; i < args.size(); ++i) {
-        if (args[i].isArray()) {
-            auto otherArr = args[i].getGC<Array>();
-            result->elements.insert(result->elements.end(),
-                                  otherArr->elements.begin(),
-                                  otherArr->elements.end());
+    for (const Value& arg : args) {
+        if (arg.isArray()) {
+            auto otherArr = arg.getGC<Array>();
+            for (size_t j = 0; j < otherArr->elementCount(); ++j) {
+                result->pushElement(otherArr->element(j));
+            }
         } else {
-            result->elements.push_back(args[i]);
+            result->pushElement(arg);
         }
     }
 
@@ -267,47 +270,43 @@ Value Array_concat(const std::vector<Value>& args) {
 }
 
 // Array.prototype.map
-Value Array_map(const std::vector<Value>& args) {
-    if (args.empty() || !args[0].isArray()) {
-        throw std::runtime_error("Array.map called on non-array");
-    }
-    if (args.size() < 2 || !args[1].isFunction()) {
-        throw std::runtime_error("Array.map requires a callback function");
+Value Array_map(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                NativeThrow& thrown) {
+    if (!requireArray(thisValue, "map", thrown) || !requireCallback(args, "map", thrown)) {
+        return Value(Undefined{});
     }
 
-    auto arr = args[0].getGC<Array>();
-    auto callback = args[1].getGC<Function>();
+    auto arr = thisValue.getGC<Array>();
     auto result = GarbageCollector::makeGC<Array>();
     GarbageCollector::instance().reportAllocation(sizeof(Array));
 
-    for (size_t i = 0; i < arr->elements.size(); ++i) {
-        std::vector<Value> callArgs = {arr->elements[i], Value(static_cast<double>(i)), args[0]};
-        Value mapped = callback->nativeFunc ? callback->nativeFunc(callArgs) : Value(Undefined{});
-        result->elements.push_back(mapped);
+    for (size_t i = 0; i < arr->elementCount(); ++i) {
+        Value mapped = callCallback(interpreter, args[0], {arr->element(i), Value(static_cast<double>(i)), thisValue},
+                                    thrown);
+        if (thrown.pending) return Value(Undefined{});
+        result->pushElement(mapped);
     }
 
     return Value(result);
 }
 
 // Array.prototype.filter
-Value Array_filter(const std::vector<Value>& args) {
-    if (args.empty() || !args[0].isArray()) {
-        throw std::runtime_error("Array.filter called on non-array");
-    }
-    if (args.size() < 2 || !args[1].isFunction()) {
-        throw std::runtime_error("Array.filter requires a callback function");
+Value Array_filter(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                   NativeThrow& thrown) {
+    if (!requireArray(thisValue, "filter", thrown) || !requireCallback(args, "filter", thrown)) {
+        return Value(Undefined{});
     }
 
-    auto arr = args[0].getGC<Array>();
-    auto callback = args[1].getGC<Function>();
+    auto arr = thisValue.getGC<Array>();
     auto result = GarbageCollector::makeGC<Array>();
     GarbageCollector::instance().reportAllocation(sizeof(Array));
 
-    for (size_t i = 0; i < arr->elements.size(); ++i) {
-        std::vector<Value> callArgs = {arr->elements[i], Value(static_cast<double>(i)), args[0]};
-        Value keep = callback->nativeFunc ? callback->nativeFunc(callArgs) : Value(Undefined{});
+    for (size_t i = 0; i < arr->elementCount(); ++i) {
+        Value element = arr->element(i);
+        Value keep = callCallback(interpreter, args[0], {element, Value(static_cast<double>(i)), thisValue}, thrown);
+        if (thrown.pending) return Value(Undefined{});
         if (keep.toBool()) {
-            result->elements.push_back(arr->elements[i]);
+            result->pushElement(element);
         }
     }
 
@@ -315,52 +314,45 @@ Value Array_filter(const std::vector<Value>& args) {
 }
 
 // Array.prototype.reduce
-Value Array_reduce(const std::vector<Value>& args) {
-    if (args.empty() || !args[0].isArray()) {
-        throw std::runtime_error("Array.reduce called on non-array");
-    }
-    if (args.size() < 2 || !args[1].isFunction()) {
-        throw std::runtime_error("Array.reduce requires a callback function");
+Value Array_reduce(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                   NativeThrow& thrown) {
+    if (!requireArray(thisValue, "reduce", thrown) || !requireCallback(args, "reduce", thrown)) {
+        return Value(Undefined{});
     }
 
-    auto arr = args[0].getGC<Array>();
-    auto callback = args[1].getGC<Function>();
+    auto arr = thisValue.getGC<Array>();
 
-    if (arr->elements.empty()) {
-        return args.size() > 2 ? args[2] : Value(Undefined{});
+    if (arr->elementCount() == 0) {
+        return args.size() > 1 ? args[1] : Value(Undefined{});
     }
 
-    Value accumulator = args.size() > 2 ? args[2] : arr->elements[0];
-    size_t start = args.size() > 2 ? 0 : 1;
+    Value accumulator = args.size() > 1 ? args[1] : arr->element(0);
+    size_t start = args.size() > 1 ? 0 : 1;
 
-    for (size_t i = start; i < arr->elements.size(); ++i) {
-        std::vector<Value> callArgs = {accumulator, arr->elements[i], Value(static_cast<double>(i)), args[0]};
-        accumulator = callback->nativeFunc ? callback->nativeFunc(callArgs) : Value(Undefined{});
+    for (size_t i = start; i < arr->elementCount(); ++i) {
+        accumulator = callCallback(interpreter, args[0],
+                                   {accumulator, arr->element(i), Value(static_cast<double>(i)), thisValue}, thrown);
+        if (thrown.pending) return Value(Undefined{});
     }
 
     return accumulator;
 }
 
 // Array.prototype.forEach
-Value Array_forEach(const std::vector<Value>& args) {
-    if (args.empty() || !args[0].isArray()) {
-        throw std::runtime_error("Array.forEach called on non-array");
-    }
-    if (args.size() < 2 || !args[1].isFunction()) {
-        throw std::runtime_error("Array.forEach requires a callback function");
+Value Array_forEach(const Value& thisValue, std::span<const Value> args, Interpreter& interpreter,
+                    NativeThrow& thrown) {
+    if (!requireArray(thisValue, "forEach", thrown) || !requireCallback(args, "forEach", thrown)) {
+        return Value(Undefined{});
     }
 
-    auto arr = args[0].getGC<Array>();
-    auto callback = args[1].getGC<Function>();
+    auto arr = thisValue.getGC<Array>();
 
-    for (size_t i = 0; i < arr->elements.size(); ++i) {
-        std::vector<Value> callArgs = {arr->elements[i], Value(static_cast<double>(i)), args[0]};
-        if (callback->nativeFunc) {
-            callback->nativeFunc(callArgs);
-        }
+    for (size_t i = 0; i < arr->elementCount(); ++i) {
+        callCallback(interpreter, args[0], {arr->element(i), Value(static_cast<double>(i)), thisValue}, thrown);
+        if (thrown.pending) return Value(Undefined{});
     }
 
     return Value(Undefined{});
 }
 
-} // namespace lightjs
\ No newline at end of file
+} // namespace lightjs
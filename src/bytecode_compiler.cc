@@ -0,0 +1,812 @@
+#include "bytecode.h"
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace lightjs {
+
+namespace {
+
+// Thrown while compiling when the body uses a construct the VM does not
+// support. compileFunctionBytecode() turns it into a nullptr result.
+struct UnsupportedConstruct {};
+
+// Returns true if `pred` holds for `expr` or any nested expression. Nodes the
+// compiler rejects anyway are treated as matching so callers stay conservative.
+template <typename Pred>
+bool anyExpression(const Expression& expr, const Pred& pred) {
+  if (pred(expr)) {
+    return true;
+  }
+  auto any = [&](const ExprPtr& child) { return child && anyExpression(*child, pred); };
+  if (std::holds_alternative<Identifier>(expr.node) ||
+      std::holds_alternative<NumberLiteral>(expr.node) ||
+      std::holds_alternative<BigIntLiteral>(expr.node) ||
+      std::holds_alternative<StringLiteral>(expr.node) ||
+      std::holds_alternative<BoolLiteral>(expr.node) ||
+      std::holds_alternative<NullLiteral>(expr.node) ||
+      std::holds_alternative<ThisExpr>(expr.node)) {
+    return false;
+  }
+  if (auto* node = std::get_if<BinaryExpr>(&expr.node)) {
+    return any(node->left) || any(node->right);
+  }
+  if (auto* node = std::get_if<UnaryExpr>(&expr.node)) {
+    return any(node->argument);
+  }
+  if (auto* node = std::get_if<AssignmentExpr>(&expr.node)) {
+    return any(node->left) || any(node->right);
+  }
+  if (auto* node = std::get_if<UpdateExpr>(&expr.node)) {
+    return any(node->argument);
+  }
+  if (auto* node = std::get_if<CallExpr>(&expr.node)) {
+    return any(node->callee) || std::any_of(node->arguments.begin(), node->arguments.end(), any);
+  }
+  if (auto* node = std::get_if<NewExpr>(&expr.node)) {
+    return any(node->callee) || std::any_of(node->arguments.begin(), node->arguments.end(), any);
+  }
+  if (auto* node = std::get_if<MemberExpr>(&expr.node)) {
+    return any(node->object) || (node->computed && any(node->property));
+  }
+  if (auto* node = std::get_if<ConditionalExpr>(&expr.node)) {
+    return any(node->test) || any(node->consequent) || any(node->alternate);
+  }
+  if (auto* node = std::get_if<SequenceExpr>(&expr.node)) {
+    return std::any_of(node->expressions.begin(), node->expressions.end(), any);
+  }
+  if (auto* node = std::get_if<ArrayExpr>(&expr.node)) {
+    return std::any_of(node->elements.begin(), node->elements.end(), any);
+  }
+  if (auto* node = std::get_if<ObjectExpr>(&expr.node)) {
+    return std::any_of(node->properties.begin(), node->properties.end(),
+                       [&](const ObjectProperty& prop) { return any(prop.value); });
+  }
+  return true;
+}
+
+bool mentionsName(const Expression& expr, const std::string& name) {
+  return anyExpression(expr, [&](const Expression& e) {
+    auto* id = std::get_if<Identifier>(&e.node);
+    return id && id->name == name;
+  });
+}
+
+// Locals can only change through assignment or update expressions: the
+// compiled subset has no closures, eval or arguments object.
+bool mayWriteLocals(const Expression& expr) {
+  return anyExpression(expr, [](const Expression& e) {
+    return std::holds_alternative<AssignmentExpr>(e.node) ||
+           std::holds_alternative<UpdateExpr>(e.node);
+  });
+}
+
+class BytecodeCompiler {
+public:
+  explicit BytecodeCompiler(const Function& func) : func_(func) {}
+
+  std::shared_ptr<BytecodeFunction> compile() {
+    auto arrowIt = func_.properties.find("__is_arrow_function__");
+    out_->lexicalThis = arrowIt != func_.properties.end() &&
+                        arrowIt->second.isBool() && arrowIt->second.toBool();
+
+    scopes_.emplace_back();
+    for (const auto& param : func_.shared->params) {
+      if (param.defaultValue || param.name.empty() || param.name.rfind("__param_", 0) == 0 ||
+          scopes_.back().count(param.name) > 0) {
+        throw UnsupportedConstruct{};
+      }
+      scopes_.back()[param.name] = Binding{allocRegister(), false, true};
+    }
+    out_->paramCount = nextReg_;
+
+    const auto& body = *std::static_pointer_cast<std::vector<StmtPtr>>(func_.shared->body);
+    for (const auto& stmt : body) {
+      hoistVars(*stmt);
+    }
+    out_->varEnd = nextReg_;
+
+    compileStatements(body, false);
+    loc_ = SourceLocation();
+    uint32_t result = allocRegister();
+    emit(Opcode::LoadUndefined, result);
+    emit(Opcode::Return, result);
+    return out_;
+  }
+
+private:
+  struct Binding {
+    uint32_t reg;
+    bool isConst;
+    bool initialized;  // Initialized on every path reaching the current position
+  };
+  using Scope = std::unordered_map<std::string, Binding>;
+
+  struct LoopContext {
+    size_t continueTarget = 0;
+    std::vector<size_t> breakJumps;
+    std::vector<size_t> continueJumps;
+  };
+
+  // Restores the current source location when an expression finishes, so
+  // instructions emitted by a parent node report the parent's position.
+  struct LocationScope {
+    BytecodeCompiler& compiler;
+    SourceLocation saved;
+    LocationScope(BytecodeCompiler& c, const SourceLocation& loc) : compiler(c), saved(c.loc_) {
+      if (loc.line > 0) compiler.loc_ = loc;
+    }
+    ~LocationScope() { compiler.loc_ = saved; }
+  };
+
+  const Function& func_;
+  std::shared_ptr<BytecodeFunction> out_ = std::make_shared<BytecodeFunction>();
+  std::vector<Scope> scopes_;
+  std::vector<LoopContext> loops_;
+  std::unordered_map<std::string, uint32_t> nameIndex_;
+  std::unordered_set<uint32_t> dynamicNames_;
+  uint32_t nextReg_ = 0;
+  SourceLocation loc_;
+
+  uint32_t allocRegister() {
+    uint32_t reg = nextReg_++;
+    out_->registerCount = std::max(out_->registerCount, nextReg_);
+    return reg;
+  }
+
+  uint32_t allocRegisters(uint32_t count) {
+    uint32_t base = nextReg_;
+    nextReg_ += count;
+    out_->registerCount = std::max(out_->registerCount, nextReg_);
+    return base;
+  }
+
+  size_t emit(Opcode op, uint32_t a = 0, uint32_t b = 0, uint32_t c = 0, uint8_t sub = 0) {
+    out_->code.push_back(Instruction{op, sub, a, b, c});
+    out_->locations.push_back(loc_);
+    return out_->code.size() - 1;
+  }
+
+  size_t here() const { return out_->code.size(); }
+  void patchJump(size_t at) { out_->code[at].a = static_cast<uint32_t>(here()); }
+
+  uint32_t constant(Value value) {
+    out_->constants.push_back(std::move(value));
+    return static_cast<uint32_t>(out_->constants.size() - 1);
+  }
+
+  uint32_t name(const std::string& n) {
+    auto it = nameIndex_.find(n);
+    if (it != nameIndex_.end()) {
+      return it->second;
+    }
+    out_->names.push_back(n);
+    out_->propertyCaches.emplace_back();
+    out_->globalNameAtoms.push_back(kNoAtom);
+    out_->globalCaches.emplace_back();
+    uint32_t index = static_cast<uint32_t>(out_->names.size() - 1);
+    nameIndex_[n] = index;
+    return index;
+  }
+
+  // Name operand for loading the free variable `id`. Statically scoped
+  // references may read globals through the name's global cache; a single
+  // dynamic reference rules it out for the name.
+  uint32_t identifierName(const Identifier& id) {
+    uint32_t index = name(id.name);
+    if (!id.staticScope) {
+      dynamicNames_.insert(index);
+      out_->globalNameAtoms[index] = kNoAtom;
+    } else if (!dynamicNames_.count(index)) {
+      out_->globalNameAtoms[index] = atomize(id.name);
+    }
+    return index;
+  }
+
+  Binding* findLocal(const std::string& n) {
+    for (auto it = scopes_.rbegin(); it != scopes_.rend(); ++it) {
+      auto found = it->find(n);
+      if (found != it->end()) {
+        return &found->second;
+      }
+    }
+    return nullptr;
+  }
+
+  // Emits a TDZ check for reads that may run before the declaration.
+  uint32_t readLocal(Binding& binding, const std::string& n) {
+    if (!binding.initialized) {
+      emit(Opcode::CheckInit, binding.reg, name(n));
+    }
+    return binding.reg;
+  }
+
+  void hoistVars(const Statement& stmt) {
+    if (auto* decl = std::get_if<VarDeclaration>(&stmt.node)) {
+      if (decl->kind != VarDeclaration::Kind::Var) {
+        return;
+      }
+      for (const auto& d : decl->declarations) {
+        auto* id = d.pattern ? std::get_if<Identifier>(&d.pattern->node) : nullptr;
+        if (!id) {
+          throw UnsupportedConstruct{};
+        }
+        if (scopes_.front().count(id->name) == 0) {
+          scopes_.front()[id->name] = Binding{allocRegister(), false, true};
+        }
+      }
+    } else if (auto* node = std::get_if<BlockStmt>(&stmt.node)) {
+      for (const auto& s : node->body) hoistVars(*s);
+    } else if (auto* node = std::get_if<IfStmt>(&stmt.node)) {
+      if (node->consequent) hoistVars(*node->consequent);
+      if (node->alternate) hoistVars(*node->alternate);
+    } else if (auto* node = std::get_if<WhileStmt>(&stmt.node)) {
+      if (node->body) hoistVars(*node->body);
+    } else if (auto* node = std::get_if<DoWhileStmt>(&stmt.node)) {
+      if (node->body) hoistVars(*node->body);
+    } else if (auto* node = std::get_if<ForStmt>(&stmt.node)) {
+      if (node->init) hoistVars(*node->init);
+      if (node->body) hoistVars(*node->body);
+    }
+  }
+
+  void declareLexical(const Statement& stmt, bool resetRegisters) {
+    auto* decl = std::get_if<VarDeclaration>(&stmt.node);
+    if (!decl) {
+      return;
+    }
+    if (decl->kind == VarDeclaration::Kind::Using || decl->kind == VarDeclaration::Kind::AwaitUsing) {
+      throw UnsupportedConstruct{};
+    }
+    if (decl->kind == VarDeclaration::Kind::Var) {
+      return;
+    }
+    for (const auto& d : decl->declarations) {
+      auto* id = d.pattern ? std::get_if<Identifier>(&d.pattern->node) : nullptr;
+      if (!id || scopes_.back().count(id->name) > 0) {
+        throw UnsupportedConstruct{};
+      }
+      uint32_t reg = allocRegister();
+      scopes_.back()[id->name] = Binding{reg, decl->kind == VarDeclaration::Kind::Const, false};
+      if (resetRegisters) {
+        emit(Opcode::LoadEmpty, reg);
+      }
+    }
+  }
+
+  // Compiles a statement list in a new lexical scope. Registers of nested
+  // scopes are reused, so their let/const bindings are reset on entry.
+  void compileStatements(const std::vector<StmtPtr>& body, bool nested) {
+    uint32_t mark = nextReg_;
+    scopes_.emplace_back();
+    for (const auto& stmt : body) {
+      LocationScope location(*this, stmt->loc);
+      declareLexical(*stmt, nested);
+    }
+    for (const auto& stmt : body) {
+      compileStatement(*stmt);
+    }
+    scopes_.pop_back();
+    nextReg_ = mark;
+  }
+
+  void compileStatement(const Statement& stmt) {
+    LocationScope location(*this, stmt.loc);
+    uint32_t mark = nextReg_;
+
+    if (auto* node = std::get_if<VarDeclaration>(&stmt.node)) {
+      compileVarDeclaration(*node);
+    } else if (auto* node = std::get_if<ExpressionStmt>(&stmt.node)) {
+      compileExpr(*node->expression, allocRegister());
+    } else if (auto* node = std::get_if<ReturnStmt>(&stmt.node)) {
+      if (!node->argument) {
+        uint32_t reg = allocRegister();
+        emit(Opcode::LoadUndefined, reg);
+        emit(Opcode::Return, reg);
+      } else if (auto* call = std::get_if<CallExpr>(&node->argument->node)) {
+        LocationScope callLocation(*this, node->argument->loc);
+        compileCall(*call, 0, true);
+      } else {
+        emit(Opcode::Return, operand(*node->argument, false));
+      }
+    } else if (auto* node = std::get_if<IfStmt>(&stmt.node)) {
+      size_t toElse = emit(Opcode::JumpIfFalse, 0, operand(*node->test, false));
+      nextReg_ = mark;
+      compileStatement(*node->consequent);
+      if (node->alternate) {
+        size_t toEnd = emit(Opcode::Jump);
+        patchJump(toElse);
+        compileStatement(*node->alternate);
+        patchJump(toEnd);
+      } else {
+        patchJump(toElse);
+      }
+    } else if (auto* node = std::get_if<BlockStmt>(&stmt.node)) {
+      compileStatements(node->body, true);
+    } else if (auto* node = std::get_if<WhileStmt>(&stmt.node)) {
+      uint32_t counter = allocRegister();
+      emit(Opcode::LoopInit, counter);
+      size_t top = here();
+      emit(Opcode::LoopCheck, counter);
+      size_t toEnd = emit(Opcode::JumpIfFalse, 0, operand(*node->test, false));
+      compileLoopBody(*node->body, top);
+      emit(Opcode::Jump, static_cast<uint32_t>(top));
+      patchJump(toEnd);
+      finishLoop();
+    } else if (auto* node = std::get_if<DoWhileStmt>(&stmt.node)) {
+      uint32_t counter = allocRegister();
+      emit(Opcode::LoopInit, counter);
+      size_t top = here();
+      emit(Opcode::LoopCheck, counter);
+      loops_.emplace_back();
+      compileStatement(*node->body);
+      loops_.back().continueTarget = here();
+      emit(Opcode::JumpIfTrue, static_cast<uint32_t>(top), operand(*node->test, false));
+      finishLoop();
+    } else if (auto* node = std::get_if<ForStmt>(&stmt.node)) {
+      compileFor(*node);
+    } else if (auto* node = std::get_if<BreakStmt>(&stmt.node)) {
+      if (!node->label.empty() || loops_.empty()) {
+        throw UnsupportedConstruct{};
+      }
+      loops_.back().breakJumps.push_back(emit(Opcode::Jump));
+    } else if (auto* node = std::get_if<ContinueStmt>(&stmt.node)) {
+      if (!node->label.empty() || loops_.empty()) {
+        throw UnsupportedConstruct{};
+      }
+      loops_.back().continueJumps.push_back(emit(Opcode::Jump));
+    } else if (auto* node = std::get_if<ThrowStmt>(&stmt.node)) {
+      emit(Opcode::Throw, operand(*node->argument, false));
+    } else if (std::holds_alternative<EmptyStmt>(stmt.node) ||
+               std::holds_alternative<DebuggerStmt>(stmt.node)) {
+      // Nothing to do.
+    } else {
+      throw UnsupportedConstruct{};
+    }
+
+    nextReg_ = mark;
+  }
+
+  // The body runs with `continueTarget` unset until the caller knows it;
+  // continue jumps are patched in finishLoop().
+  void compileLoopBody(const Statement& body, size_t continueTarget) {
+    loops_.emplace_back();
+    loops_.back().continueTarget = continueTarget;
+    compileStatement(body);
+  }
+
+  void finishLoop() {
+    LoopContext loop = std::move(loops_.back());
+    loops_.pop_back();
+    for (size_t at : loop.breakJumps) {
+      patchJump(at);
+    }
+    for (size_t at : loop.continueJumps) {
+      out_->code[at].a = static_cast<uint32_t>(loop.continueTarget);
+    }
+  }
+
+  void compileFor(const ForStmt& node) {
+    scopes_.emplace_back();
+    if (node.init) {
+      declareLexical(*node.init, true);
+      compileStatement(*node.init);
+    }
+    uint32_t counter = allocRegister();
+    emit(Opcode::LoopInit, counter);
+    size_t top = here();
+    emit(Opcode::LoopCheck, counter);
+    size_t toEnd = 0;
+    if (node.test) {
+      uint32_t mark = nextReg_;
+      toEnd = emit(Opcode::JumpIfFalse, 0, operand(*node.test, false));
+      nextReg_ = mark;
+    }
+    loops_.emplace_back();
+    compileStatement(*node.body);
+    loops_.back().continueTarget = here();
+    if (node.update) {
+      uint32_t mark = nextReg_;
+      compileExpr(*node.update, allocRegister());
+      nextReg_ = mark;
+    }
+    emit(Opcode::Jump, static_cast<uint32_t>(top));
+    if (node.test) {
+      patchJump(toEnd);
+    }
+    finishLoop();
+    scopes_.pop_back();
+  }
+
+  void compileVarDeclaration(const VarDeclaration& decl) {
+    for (const auto& d : decl.declarations) {
+      const auto& n = std::get<Identifier>(d.pattern->node).name;
+      Scope& scope = decl.kind == VarDeclaration::Kind::Var ? scopes_.front() : scopes_.back();
+      auto it = scope.find(n);
+      if (it == scope.end()) {
+        throw UnsupportedConstruct{};
+      }
+      Binding* binding = &it->second;
+      if (d.init) {
+        storeLocal(binding->reg, *d.init, n);
+      } else if (decl.kind != VarDeclaration::Kind::Var) {
+        emit(Opcode::LoadUndefined, binding->reg);
+      }
+      binding->initialized = true;
+    }
+  }
+
+  // Evaluates `value` into a local register. Goes through a temporary when
+  // the expression reads the binding, since compileExpr may use its
+  // destination as scratch space before the final value is known.
+  void storeLocal(uint32_t reg, const Expression& value, const std::string& n) {
+    if (mentionsName(value, n)) {
+      uint32_t tmp = allocRegister();
+      compileExpr(value, tmp);
+      emit(Opcode::Move, reg, tmp);
+    } else {
+      compileExpr(value, reg);
+    }
+  }
+
+  // Returns a register holding the value of `expr`. Initialized locals are
+  // used in place unless a later operand may overwrite them.
+  uint32_t operand(const Expression& expr, bool laterWritesLocals) {
+    if (auto* id = std::get_if<Identifier>(&expr.node); id && !laterWritesLocals) {
+      if (Binding* binding = findLocal(id->name)) {
+        LocationScope location(*this, expr.loc);
+        return readLocal(*binding, id->name);
+      }
+    }
+    uint32_t reg = allocRegister();
+    compileExpr(expr, reg);
+    return reg;
+  }
+
+  void move(uint32_t dst, uint32_t src) {
+    if (dst != src) {
+      emit(Opcode::Move, dst, src);
+    }
+  }
+
+  void compileExpr(const Expression& expr, uint32_t dst) {
+    LocationScope location(*this, expr.loc);
+
+    if (auto* node = std::get_if<Identifier>(&expr.node)) {
+      if (Binding* binding = findLocal(node->name)) {
+        move(dst, readLocal(*binding, node->name));
+      } else if (node->name == "arguments") {
+        throw UnsupportedConstruct{};
+      } else {
+        emit(Opcode::LoadName, dst, identifierName(*node));
+      }
+    } else if (auto* node = std::get_if<NumberLiteral>(&expr.node)) {
+      emit(Opcode::LoadConst, dst, constant(numberValue(node->value)));
+    } else if (auto* node = std::get_if<BigIntLiteral>(&expr.node)) {
+      emit(Opcode::LoadConst, dst, constant(Value(BigInt(node->value))));
+    } else if (auto* node = std::get_if<StringLiteral>(&expr.node)) {
+      emit(Opcode::LoadConst, dst, constant(Value(node->value)));
+    } else if (auto* node = std::get_if<BoolLiteral>(&expr.node)) {
+      emit(Opcode::LoadConst, dst, constant(Value(node->value)));
+    } else if (std::holds_alternative<NullLiteral>(expr.node)) {
+      emit(Opcode::LoadConst, dst, constant(Value(Null{})));
+    } else if (std::holds_alternative<ThisExpr>(expr.node)) {
+      out_->usesThis = true;
+      emit(Opcode::LoadThis, dst);
+    } else if (auto* node = std::get_if<BinaryExpr>(&expr.node)) {
+      compileBinary(*node, dst);
+    } else if (auto* node = std::get_if<UnaryExpr>(&expr.node)) {
+      compileUnary(*node, dst);
+    } else if (auto* node = std::get_if<AssignmentExpr>(&expr.node)) {
+      compileAssignment(*node, dst);
+    } else if (auto* node = std::get_if<UpdateExpr>(&expr.node)) {
+      compileUpdate(*node, dst);
+    } else if (auto* node = std::get_if<CallExpr>(&expr.node)) {
+      compileCall(*node, dst, false);
+    } else if (auto* node = std::get_if<MemberExpr>(&expr.node)) {
+      checkMember(*node);
+      uint32_t obj = operand(*node->object, node->computed && mayWriteLocals(*node->property));
+      if (node->computed) {
+        emit(Opcode::GetElem, dst, obj, operand(*node->property, false));
+      } else {
+        emit(Opcode::GetProp, dst, obj, name(propertyName(*node)));
+      }
+    } else if (auto* node = std::get_if<ConditionalExpr>(&expr.node)) {
+      uint32_t mark = nextReg_;
+      size_t toElse = emit(Opcode::JumpIfFalse, 0, operand(*node->test, false));
+      nextReg_ = mark;
+      compileExpr(*node->consequent, dst);
+      size_t toEnd = emit(Opcode::Jump);
+      patchJump(toElse);
+      compileExpr(*node->alternate, dst);
+      patchJump(toEnd);
+    } else if (auto* node = std::get_if<SequenceExpr>(&expr.node)) {
+      for (size_t i = 0; i + 1 < node->expressions.size(); ++i) {
+        uint32_t mark = nextReg_;
+        compileExpr(*node->expressions[i], allocRegister());
+        nextReg_ = mark;
+      }
+      compileExpr(*node->expressions.back(), dst);
+    } else if (auto* node = std::get_if<ArrayExpr>(&expr.node)) {
+      uint32_t count = static_cast<uint32_t>(node->elements.size());
+      uint32_t base = allocRegisters(count);
+      for (uint32_t i = 0; i < count; ++i) {
+        const auto& elem = node->elements[i];
+        if (!elem || std::holds_alternative<SpreadElement>(elem->node)) {
+          throw UnsupportedConstruct{};
+        }
+        compileExpr(*elem, base + i);
+      }
+      emit(Opcode::NewArray, dst, base, count);
+    } else if (auto* node = std::get_if<ObjectExpr>(&expr.node)) {
+      compileObject(*node, dst);
+    } else if (auto* node = std::get_if<NewExpr>(&expr.node)) {
+      uint32_t argc = static_cast<uint32_t>(node->arguments.size());
+      uint32_t base = allocRegisters(argc + 1);
+      compileExpr(*node->callee, base);
+      for (uint32_t i = 0; i < argc; ++i) {
+        if (std::holds_alternative<SpreadElement>(node->arguments[i]->node)) {
+          throw UnsupportedConstruct{};
+        }
+        compileExpr(*node->arguments[i], base + 1 + i);
+      }
+      emit(Opcode::New, dst, base, argc);
+    } else {
+      throw UnsupportedConstruct{};
+    }
+  }
+
+  void compileBinary(const BinaryExpr& node, uint32_t dst) {
+    Opcode shortCircuit;
+    switch (node.op) {
+      case BinaryExpr::Op::LogicalAnd: shortCircuit = Opcode::JumpIfFalse; break;
+      case BinaryExpr::Op::LogicalOr: shortCircuit = Opcode::JumpIfTrue; break;
+      case BinaryExpr::Op::NullishCoalescing: shortCircuit = Opcode::JumpIfNotNullish; break;
+      default: {
+        if (auto* id = std::get_if<Identifier>(&node.left->node);
+            id && !id->name.empty() && id->name[0] == '#') {
+          throw UnsupportedConstruct{};
+        }
+        uint32_t left = operand(*node.left, mayWriteLocals(*node.right));
+        uint32_t right = operand(*node.right, false);
+        emit(Opcode::Binary, dst, left, right, static_cast<uint8_t>(node.op));
+        return;
+      }
+    }
+    compileExpr(*node.left, dst);
+    size_t toEnd = emit(shortCircuit, 0, dst);
+    compileExpr(*node.right, dst);
+    patchJump(toEnd);
+  }
+
+  void compileUnary(const UnaryExpr& node, uint32_t dst) {
+    if (node.op == UnaryExpr::Op::Delete) {
+      throw UnsupportedConstruct{};
+    }
+    if (auto* id = std::get_if<Identifier>(&node.argument->node);
+        id && node.op == UnaryExpr::Op::Typeof && !findLocal(id->name)) {
+      LocationScope location(*this, node.argument->loc);
+      emit(Opcode::TypeofName, dst, name(id->name));
+      return;
+    }
+    emit(Opcode::Unary, dst, operand(*node.argument, false), 0, static_cast<uint8_t>(node.op));
+  }
+
+  static bool isLogicalAssignment(AssignmentExpr::Op op) {
+    return op == AssignmentExpr::Op::AndAssign || op == AssignmentExpr::Op::OrAssign ||
+           op == AssignmentExpr::Op::NullishAssign;
+  }
+
+  static Opcode logicalAssignmentSkip(AssignmentExpr::Op op) {
+    switch (op) {
+      case AssignmentExpr::Op::AndAssign: return Opcode::JumpIfFalse;
+      case AssignmentExpr::Op::OrAssign: return Opcode::JumpIfTrue;
+      default: return Opcode::JumpIfNotNullish;
+    }
+  }
+
+  void compileAssignment(const AssignmentExpr& node, uint32_t dst) {
+    if (auto* id = std::get_if<Identifier>(&node.left->node)) {
+      Binding* binding = findLocal(id->name);
+      if (!binding) {
+        throw UnsupportedConstruct{};
+      }
+      uint32_t reg = readLocal(*binding, id->name);
+      if (binding->isConst) {
+        if (node.op != AssignmentExpr::Op::Assign) {
+          throw UnsupportedConstruct{};
+        }
+        compileExpr(*node.right, allocRegister());
+        emit(Opcode::ThrowConstAssign, name(id->name));
+        return;
+      }
+      if (node.op == AssignmentExpr::Op::Assign) {
+        storeLocal(reg, *node.right, id->name);
+        move(dst, reg);
+      } else if (isLogicalAssignment(node.op)) {
+        size_t toEnd = emit(logicalAssignmentSkip(node.op), 0, reg);
+        storeLocal(reg, *node.right, id->name);
+        patchJump(toEnd);
+        move(dst, reg);
+      } else {
+        uint32_t current = reg;
+        if (mayWriteLocals(*node.right)) {
+          current = allocRegister();
+          emit(Opcode::Move, current, reg);
+        }
+        uint32_t right = operand(*node.right, false);
+        emit(Opcode::Compound, reg, current, right, static_cast<uint8_t>(node.op));
+        move(dst, reg);
+      }
+      return;
+    }
+
+    auto* member = std::get_if<MemberExpr>(&node.left->node);
+    if (!member || isLogicalAssignment(node.op)) {
+      throw UnsupportedConstruct{};
+    }
+    checkMember(*member);
+    bool rightWrites = mayWriteLocals(*node.right);
+    uint32_t obj = operand(*member->object,
+                           rightWrites || (member->computed && mayWriteLocals(*member->property)));
+    uint32_t key = member->computed ? operand(*member->property, rightWrites)
+                                    : name(propertyName(*member));
+    Opcode get = member->computed ? Opcode::GetElem : Opcode::GetProp;
+    Opcode set = member->computed ? Opcode::SetElem : Opcode::SetProp;
+    if (node.op == AssignmentExpr::Op::Assign) {
+      uint32_t value = operand(*node.right, false);
+      emit(set, obj, key, value);
+      move(dst, value);
+      return;
+    }
+    uint32_t current = allocRegister();
+    emit(get, current, obj, key);
+    uint32_t right = operand(*node.right, false);
+    emit(Opcode::Compound, current, current, right, static_cast<uint8_t>(node.op));
+    emit(set, obj, key, current);
+    move(dst, current);
+  }
+
+  void compileUpdate(const UpdateExpr& node, uint32_t dst) {
+    uint8_t op = static_cast<uint8_t>(node.op);
+    if (auto* id = std::get_if<Identifier>(&node.argument->node)) {
+      Binding* binding = findLocal(id->name);
+      if (!binding) {
+        throw UnsupportedConstruct{};
+      }
+      if (binding->isConst) {
+        emit(Opcode::ThrowConstAssign, name(id->name));
+        return;
+      }
+      uint32_t reg = readLocal(*binding, id->name);
+      if (node.prefix) {
+        uint32_t old = allocRegister();
+        emit(Opcode::Update, reg, reg, old, op);
+        move(dst, reg);
+      } else {
+        emit(Opcode::Update, reg, reg, dst, op);
+      }
+      return;
+    }
+
+    auto* member = std::get_if<MemberExpr>(&node.argument->node);
+    if (!member) {
+      throw UnsupportedConstruct{};
+    }
+    checkMember(*member);
+    uint32_t obj = operand(*member->object, member->computed && mayWriteLocals(*member->property));
+    uint32_t key = member->computed ? operand(*member->property, false)
+                                    : name(propertyName(*member));
+    uint32_t current = allocRegister();
+    uint32_t old = allocRegister();
+    emit(member->computed ? Opcode::GetElem : Opcode::GetProp, current, obj, key);
+    emit(Opcode::Update, current, current, old, op);
+    emit(member->computed ? Opcode::SetElem : Opcode::SetProp, obj, key, current);
+    move(dst, node.prefix ? current : old);
+  }
+
+  // Call window layout: base = callee, base + 1 = this, then the arguments.
+  void compileCall(const CallExpr& node, uint32_t dst, bool tail) {
+    if (node.optional || node.inOptionalChain) {
+      throw UnsupportedConstruct{};
+    }
+    uint32_t argc = static_cast<uint32_t>(node.arguments.size());
+    uint32_t base = allocRegisters(argc + 2);
+
+    if (auto* member = std::get_if<MemberExpr>(&node.callee->node)) {
+      checkMember(*member);
+      compileExpr(*member->object, base + 1);
+      LocationScope location(*this, node.callee->loc);
+      if (member->computed) {
+        emit(Opcode::GetElem, base, base + 1, operand(*member->property, false));
+      } else {
+        emit(Opcode::GetProp, base, base + 1, name(propertyName(*member)));
+      }
+    } else if (auto* id = std::get_if<Identifier>(&node.callee->node)) {
+      LocationScope location(*this, node.callee->loc);
+      if (Binding* binding = findLocal(id->name)) {
+        move(base, readLocal(*binding, id->name));
+        emit(Opcode::LoadUndefined, base + 1);
+      } else if (id->name == "eval" || id->name == "import" || id->name == "arguments") {
+        throw UnsupportedConstruct{};
+      } else {
+        emit(Opcode::LoadCallee, base, identifierName(*id));
+      }
+    } else if (std::holds_alternative<SuperExpr>(node.callee->node)) {
+      throw UnsupportedConstruct{};
+    } else {
+      compileExpr(*node.callee, base);
+      emit(Opcode::LoadUndefined, base + 1);
+    }
+
+    for (uint32_t i = 0; i < argc; ++i) {
+      if (std::holds_alternative<SpreadElement>(node.arguments[i]->node)) {
+        throw UnsupportedConstruct{};
+      }
+      compileExpr(*node.arguments[i], base + 2 + i);
+    }
+    emit(tail ? Opcode::TailCall : Opcode::Call, dst, base, argc);
+  }
+
+  void compileObject(const ObjectExpr& node, uint32_t dst) {
+    uint32_t obj = allocRegister();
+    emit(Opcode::NewObject, obj);
+    for (const auto& prop : node.properties) {
+      if (prop.isSpread || prop.isComputed || prop.isGetter || prop.isSetter ||
+          prop.isProtoSetter || !prop.key || !prop.value) {
+        throw UnsupportedConstruct{};
+      }
+      std::string key;
+      if (auto* id = std::get_if<Identifier>(&prop.key->node)) {
+        key = id->name;
+      } else if (auto* str = std::get_if<StringLiteral>(&prop.key->node)) {
+        key = str->value;
+      } else {
+        throw UnsupportedConstruct{};
+      }
+      // Keys that collide with internal property encodings stay on the
+      // tree walker, which knows how to store them.
+      if (key.rfind("__", 0) == 0) {
+        throw UnsupportedConstruct{};
+      }
+      uint32_t mark = nextReg_;
+      emit(Opcode::InitProp, obj, name(key), operand(*prop.value, false));
+      nextReg_ = mark;
+    }
+    move(dst, obj);
+  }
+
+  static void checkMember(const MemberExpr& member) {
+    if (member.optional || member.inOptionalChain || member.privateIdentifier ||
+        std::holds_alternative<SuperExpr>(member.object->node)) {
+      throw UnsupportedConstruct{};
+    }
+  }
+
+  static const std::string& propertyName(const MemberExpr& member) {
+    auto* id = std::get_if<Identifier>(&member.property->node);
+    if (!id) {
+      throw UnsupportedConstruct{};
+    }
+    return id->name;
+  }
+};
+
+}  // namespace
+
+std::shared_ptr<BytecodeFunction> compileFunctionBytecode(const Function& func) {
+  if (func.isNative || func.isAsync || func.isGenerator || !func.shared->body || func.shared->restParam) {
+    return nullptr;
+  }
+  if (func.shared->destructurePrologue &&
+      !std::static_pointer_cast<std::vector<StmtPtr>>(func.shared->destructurePrologue)->empty()) {
+    return nullptr;
+  }
+  try {
+    return BytecodeCompiler(func).compile();
+  } catch (const UnsupportedConstruct&) {
+    return nullptr;
+  }
+}
+
+} // namespace lightjs
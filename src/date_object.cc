@@ -56,7 +56,7 @@ Value Date_parse(const std::vector<Value>& args) {
         return Value(std::numeric_limits<double>::quiet_NaN());
     }
 
-    const std::string& input = std::get<std::string>(args[0].data);
+    const std::string& input = args[0].asString();
     if (input.empty()) {
         return Value(std::numeric_limits<double>::quiet_NaN());
     }
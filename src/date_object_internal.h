@@ -103,7 +103,7 @@ bool isObjectLike(const Value& value) {
     return value.isObject() || value.isArray() || value.isFunction();
 }
 
-OrderedMap<std::string, Value>* propertiesForValue(const Value& value) {
+PropertyMap* propertiesForValue(const Value& value) {
     if (value.isObject()) return &value.getGC<Object>()->properties;
     if (value.isFunction()) return &value.getGC<Function>()->properties;
     if (value.isArray()) return &value.getGC<Array>()->properties;
@@ -421,7 +421,7 @@ bool hasOwnPropertyNoInvoke(const Value& receiver, const std::string& name) {
     if (arr->properties.count("__get_" + name) > 0) return true;
     if (arr->properties.count("__set_" + name) > 0) return true;
     size_t index = 0;
-    if (parseArrayIndexKey(name, index) && index < arr->elements.size()) return true;
+    if (parseArrayIndexKey(name, index) && index < arr->elementCount()) return true;
     return arr->properties.count(name) > 0;
   }
   if (receiver.isFunction()) {
@@ -490,7 +490,7 @@ std::pair<bool, Value> getOwnPropertyLike(const Value& receiver,
     if (name == "length") {
       auto storedLen = arr->properties.find("__array_length__");
       if (storedLen != arr->properties.end()) return {true, storedLen->second};
-      return {true, Value(static_cast<double>(arr->elements.size()))};
+      return {true, Value(static_cast<double>(arr->elementCount()))};
     }
     auto getterIt = arr->properties.find("__get_" + name);
     if (getterIt != arr->properties.end()) {
@@ -499,8 +499,8 @@ std::pair<bool, Value> getOwnPropertyLike(const Value& receiver,
     }
     if (arr->properties.find("__set_" + name) != arr->properties.end()) return {true, Value(Undefined{})};
     size_t index = 0;
-    if (parseArrayIndexKey(name, index) && index < arr->elements.size()) {
-      return {true, arr->elements[index]};
+    if (parseArrayIndexKey(name, index) && index < arr->elementCount()) {
+      return {true, arr->element(index)};
     }
     auto it = arr->properties.find(name);
     if (it != arr->properties.end()) return {true, it->second};
@@ -566,7 +566,7 @@ std::pair<bool, Value> getOwnPropertyLike(const Value& receiver,
     if (name == "message") return {true, Value(err->message)};
     return {false, Value(Undefined{})};
   }
-  auto getFromBag = [&](const OrderedMap<std::string, Value>& bag) -> std::pair<bool, Value> {
+  auto getFromBag = [&](const PropertyMap& bag) -> std::pair<bool, Value> {
     auto getterIt = bag.find("__get_" + name);
     if (getterIt != bag.end()) {
       if (getterIt->second.isFunction()) return {true, callGetter(getterIt->second)};
@@ -809,10 +809,10 @@ bool setPropertyLike(const Value& receiver, const std::string& name, const Value
         interpreter->callForHarness(setterIt->second, {value}, receiver);
         return !interpreter->hasError();
       }
-      if (index >= arr->elements.size()) {
-        arr->elements.resize(index + 1, Value(Undefined{}));
+      if (index >= arr->elementCount()) {
+        arr->elements().resize(index + 1, Value(Undefined{}));
       }
-      arr->elements[index] = value;
+      arr->setElement(index, value);
       return true;
     }
     if (hasOwnWritableEntry(arr->properties)) {
@@ -2174,6 +2174,7 @@ static std::shared_ptr<ModuleLoader> g_moduleLoader;
 static Interpreter* g_interpreter = nullptr;
 static Value g_arrayPrototype;
 static Value g_objectPrototype;
+static Value g_arrayIteratorPrototype;
 
 void setGlobalModuleLoader(std::shared_ptr<ModuleLoader> loader) {
   g_moduleLoader = loader;
@@ -2217,71 +2218,356 @@ GCPtr<Object> makeObjectWithPrototype() {
   return obj;
 }
 
+namespace {
+
+// Shared steps of the Array.prototype builtins. They run on the calling
+// interpreter and report JS exceptions through `thrown`, so callers check
+// thrown.pending after each one.
+
+// Moves an exception pending on the interpreter into `thrown`.
+bool takeInterpreterError(Interpreter& interp, NativeThrow& thrown) {
+  if (!interp.hasError()) return false;
+  Value err = interp.getError();
+  interp.clearError();
+  thrown.throwValue(err);
+  return true;
+}
+
+// ToObject for `this`: TypeError on null/undefined, primitives are boxed
+Value arrayToObject(const Value& thisVal, const char* methodName, Interpreter& interp, NativeThrow& thrown) {
+  if (thisVal.isNull() || thisVal.isUndefined()) {
+    return thrown.error(ErrorType::TypeError,
+                        std::string("Array.prototype.") + methodName + " called on null or undefined");
+  }
+  if (!thisVal.isBool() && !thisVal.isNumber() && !thisVal.isString() && !thisVal.isSymbol() &&
+      !thisVal.isBigInt()) {
+    return thisVal;
+  }
+  const char* ctorName = "BigInt";
+  if (thisVal.isBool()) ctorName = "Boolean";
+  else if (thisVal.isNumber()) ctorName = "Number";
+  else if (thisVal.isString()) ctorName = "String";
+  else if (thisVal.isSymbol()) ctorName = "Symbol";
+  auto wrapper = GarbageCollector::makeGC<Object>();
+  GarbageCollector::instance().reportAllocation(sizeof(Object));
+  wrapper->properties["__primitive_value__"] = thisVal;
+  if (auto ctor = interp.resolveVariable(ctorName)) {
+    auto [hasProto, proto] = interp.getPropertyForExternal(*ctor, "prototype");
+    if (hasProto && (proto.isObject() || proto.isNull())) {
+      wrapper->properties["__proto__"] = proto;
+    }
+  }
+  // For String, set length and indexed properties
+  if (thisVal.isString()) {
+    const std::string& str = thisVal.asString();
+    size_t strLen = String_utf16Length(str);
+    for (size_t i = 0; i < strLen; i++) {
+      std::string idx = std::to_string(i);
+      wrapper->properties[idx] = Value(String_utf16CodeUnitStringAt(str, i));
+      wrapper->properties["__non_writable_" + idx] = Value(true);
+      wrapper->properties["__non_enum_" + idx] = Value(true);
+      wrapper->properties["__non_configurable_" + idx] = Value(true);
+    }
+    wrapper->properties["length"] = Value(static_cast<double>(strLen));
+    wrapper->properties["__non_writable_length"] = Value(true);
+    wrapper->properties["__non_enum_length"] = Value(true);
+    wrapper->properties["__non_configurable_length"] = Value(true);
+  }
+  return Value(wrapper);
+}
+
+// Length of any array-like value using [[Get]]
+size_t arrayLikeLength(const Value& obj, Interpreter& interp, NativeThrow& thrown) {
+  auto [found, lenVal] = interp.getPropertyForExternal(obj, "length");
+  if (takeInterpreterError(interp, thrown) || !found) return 0;
+  double d = lenVal.toNumber();
+  if (std::isnan(d) || d < 0) return 0;
+  if (d > 4294967295.0) return 4294967295u;
+  return static_cast<size_t>(d);
+}
+
+// Element at `idx` of an array-like value using [[Get]]
+std::pair<bool, Value> arrayLikeElement(const Value& obj, size_t idx, Interpreter& interp,
+                                        NativeThrow& thrown) {
+  auto result = interp.getPropertyForExternal(obj, std::to_string(idx));
+  if (takeInterpreterError(interp, thrown)) return {false, Value(Undefined{})};
+  return result;
+}
+
+// Calls a callback with the element/index/array arguments; check
+// thrown.pending afterwards.
+Value callArrayCallback(const Value& callback, std::vector<Value> callArgs, const Value& thisArg,
+                        Interpreter& interp, NativeThrow& thrown) {
+  Value result = interp.callForHarness(callback, callArgs, thisArg);
+  takeInterpreterError(interp, thrown);
+  return result;
+}
+
+// Strict equality for search methods
+bool arrayStrictEqual(const Value& lhs, const Value& rhs) {
+  if (!lhs.hasSameType(rhs)) return false;
+  if (lhs.isNumber() && rhs.isNumber()) return lhs.toNumber() == rhs.toNumber();
+  if (lhs.isString() && rhs.isString()) return lhs.toString() == rhs.toString();
+  if (lhs.isBool() && rhs.isBool()) return lhs.toBool() == rhs.toBool();
+  if (lhs.isSymbol() && rhs.isSymbol()) return lhs.asSymbol().id == rhs.asSymbol().id;
+  if (lhs.isBigInt() && rhs.isBigInt()) return lhs.toBigInt() == rhs.toBigInt();
+  if ((lhs.isNull() && rhs.isNull()) || (lhs.isUndefined() && rhs.isUndefined())) return true;
+  if (lhs.isObject() && rhs.isObject()) return lhs.getGC<Object>().get() == rhs.getGC<Object>().get();
+  if (lhs.isArray() && rhs.isArray()) return lhs.getGC<Array>().get() == rhs.getGC<Array>().get();
+  if (lhs.isFunction() && rhs.isFunction()) return lhs.getGC<Function>().get() == rhs.getGC<Function>().get();
+  if (lhs.isClass() && rhs.isClass()) return lhs.getGC<Class>().get() == rhs.getGC<Class>().get();
+  if (lhs.isError() && rhs.isError()) return lhs.getGC<Error>().get() == rhs.getGC<Error>().get();
+  if (lhs.isRegex() && rhs.isRegex()) return lhs.getGC<Regex>().get() == rhs.getGC<Regex>().get();
+  if (lhs.isMap() && rhs.isMap()) return lhs.getGC<Map>().get() == rhs.getGC<Map>().get();
+  if (lhs.isSet() && rhs.isSet()) return lhs.getGC<Set>().get() == rhs.getGC<Set>().get();
+  if (lhs.isPromise() && rhs.isPromise()) return lhs.getGC<Promise>().get() == rhs.getGC<Promise>().get();
+  if (lhs.isTypedArray() && rhs.isTypedArray()) return lhs.getGC<TypedArray>().get() == rhs.getGC<TypedArray>().get();
+  if (lhs.isArrayBuffer() && rhs.isArrayBuffer()) return lhs.getGC<ArrayBuffer>().get() == rhs.getGC<ArrayBuffer>().get();
+  if (lhs.isProxy() && rhs.isProxy()) return lhs.getGC<Proxy>().get() == rhs.getGC<Proxy>().get();
+  if (lhs.isGenerator() && rhs.isGenerator()) return lhs.getGC<Generator>().get() == rhs.getGC<Generator>().get();
+  if (lhs.isWeakMap() && rhs.isWeakMap()) return lhs.getGC<WeakMap>().get() == rhs.getGC<WeakMap>().get();
+  if (lhs.isWeakSet() && rhs.isWeakSet()) return lhs.getGC<WeakSet>().get() == rhs.getGC<WeakSet>().get();
+  if (lhs.isDataView() && rhs.isDataView()) return lhs.getGC<DataView>().get() == rhs.getGC<DataView>().get();
+  if (lhs.isWasmInstance() && rhs.isWasmInstance()) return lhs.getGC<WasmInstanceJS>().get() == rhs.getGC<WasmInstanceJS>().get();
+  if (lhs.isWasmMemory() && rhs.isWasmMemory()) return lhs.getGC<WasmMemoryJS>().get() == rhs.getGC<WasmMemoryJS>().get();
+  if (lhs.isReadableStream() && rhs.isReadableStream()) return lhs.getGC<ReadableStream>().get() == rhs.getGC<ReadableStream>().get();
+  if (lhs.isWritableStream() && rhs.isWritableStream()) return lhs.getGC<WritableStream>().get() == rhs.getGC<WritableStream>().get();
+  if (lhs.isTransformStream() && rhs.isTransformStream()) return lhs.getGC<TransformStream>().get() == rhs.getGC<TransformStream>().get();
+  return false;
+}
+
+// A fresh array of `length` holes
+Value makeHoleyArray(size_t length) {
+  auto result = makeArrayWithPrototype();
+  if (length > 0) {
+    result->resizeElements(length);
+    for (size_t i = 0; i < length; i++) {
+      result->properties["__hole_" + std::to_string(i) + "__"] = Value(true);
+    }
+  }
+  return Value(result);
+}
+
+// ArraySpeciesCreate per spec 9.4.2.3
+// Creates result array using species constructor if available
+Value arraySpeciesCreate(const Value& originalArray, size_t length, Interpreter& interp, NativeThrow& thrown) {
+  // Step 2: If originalArray is not an array, return ArrayCreate(length)
+  if (!originalArray.isArray()) {
+    return makeHoleyArray(length);
+  }
+
+  // Step 5: Let C = Get(originalArray, "constructor")
+  auto [hasCtor, ctorVal] = interp.getPropertyForExternal(originalArray, "constructor");
+  if (takeInterpreterError(interp, thrown)) return Value(Undefined{});
+
+  if (hasCtor && !ctorVal.isUndefined()) {
+    // Step 6: If IsConstructor(C), check cross-realm (skip for now)
+
+    // Step 7: If C is an Object, get @@species
+    if (isObjectLikeValue(ctorVal)) {
+      auto [hasSpecies, speciesVal] = interp.getPropertyForExternal(ctorVal, WellKnownSymbols::speciesKey());
+      if (takeInterpreterError(interp, thrown)) return Value(Undefined{});
+      if (hasSpecies && !speciesVal.isUndefined() && !speciesVal.isNull()) {
+        // null means use default
+        if (speciesVal.isFunction() || speciesVal.isClass() ||
+            (speciesVal.isObject() && speciesVal.getGC<Object>()->properties.count("__callable_object__"))) {
+          // Step 10: Construct(C, [length])
+          Value result = interp.constructFromNative(speciesVal, {Value(static_cast<double>(length))});
+          if (takeInterpreterError(interp, thrown)) return Value(Undefined{});
+          return result;
+        }
+        return thrown.error(ErrorType::TypeError, "Species is not a constructor");
+      }
+    } else if (!ctorVal.isFunction() && !ctorVal.isClass() && !ctorVal.isNull()) {
+      // Step 6 check: constructor must be Object or undefined
+      if (ctorVal.isNumber() || ctorVal.isString() || ctorVal.isBool() || ctorVal.isSymbol() || ctorVal.isBigInt()) {
+        return thrown.error(ErrorType::TypeError, "constructor is not an object");
+      }
+    }
+  }
+
+  // Default: create regular array
+  return makeHoleyArray(length);
+}
+
+// A fresh %ArrayIteratorPrototype% iterator over `target`; `kind` is 0 for
+// values, 1 for keys and 2 for entries
+Value makeArrayIterator(const Value& target, int kind, NativeThrow& thrown) {
+  if (target.isNull() || target.isUndefined()) {
+    return thrown.error(ErrorType::TypeError, "Cannot convert undefined or null to object");
+  }
+  auto iterObj = GarbageCollector::makeGC<Object>();
+  iterObj->properties["__proto__"] = g_arrayIteratorPrototype;
+  iterObj->properties["__array_iterator_target__"] = target;
+  iterObj->properties["__array_iterator_next_index__"] = Value(0.0);
+  iterObj->properties["__array_iterator_kind__"] = Value(static_cast<double>(kind));
+  return Value(iterObj);
+}
+
+// Relative index argument (start/end/target) clamped to [0, len]
+int arrayRelativeIndex(std::span<const Value> args, size_t pos, int len, int fallback) {
+  if (args.size() <= pos || args[pos].isUndefined()) return fallback;
+  double d = args[pos].toNumber();
+  int index = std::isnan(d) ? 0 : static_cast<int>(d);
+  if (index < 0) index = std::max(0, len + index);
+  return std::min(index, len);
+}
+
+}  // namespace
+
+struct Environment::Pool {
+  // Caps on what is kept around between scopes
+  static constexpr size_t kMaxFreeArrays = 1024;
+  static constexpr size_t kMaxRecycledCapacity = 32;
+
+  std::vector<std::vector<Binding>> freeArrays;
+};
+
+Environment::Pool& Environment::pool() {
+  // Never destroyed: scopes may still be released during static destruction.
+  static Pool* instance = new Pool();
+  return *instance;
+}
+
 Environment::Environment(Environment* parent)
-  : parent_(parent) {
+  : parent_(parent), root_(parent ? parent->root_ : this) {
   GarbageCollector::instance().reportAllocation(sizeof(Environment));
+  auto& arrays = pool().freeArrays;
+  if (!arrays.empty()) {
+    bindings_ = std::move(arrays.back());
+    arrays.pop_back();
+  }
+}
+
+// Reached only once nothing references the scope, i.e. no closure captured
+// it or every capturing closure is gone.
+Environment::~Environment() {
+  // Releasing the values can drop other scopes, which use the pool too, so
+  // the array is emptied before it is handed back.
+  bindings_.clear();
+  auto& arrays = pool().freeArrays;
+  if (bindings_.capacity() != 0 && bindings_.capacity() <= Pool::kMaxRecycledCapacity &&
+      arrays.size() < Pool::kMaxFreeArrays) {
+    arrays.push_back(std::move(bindings_));
+  }
+}
+
+int Environment::findSlot(Atom atom) const {
+  if (atom == kNoAtom) {
+    return -1;
+  }
+  if (slotIndex_.empty()) {
+    for (size_t slot = 0; slot < bindings_.size(); ++slot) {
+      if (bindings_[slot].name == atom) {
+        return static_cast<int>(slot);
+      }
+    }
+    return -1;
+  }
+  auto it = slotIndex_.find(atom);
+  return it != slotIndex_.end() ? static_cast<int>(it->second) : -1;
+}
+
+Value* Environment::findBinding(const std::string& name) {
+  int slot = findSlot(AtomTable::instance().find(name));
+  return slot >= 0 ? &bindings_[slot].value : nullptr;
+}
+
+const Value* Environment::findBinding(const std::string& name) const {
+  int slot = findSlot(AtomTable::instance().find(name));
+  return slot >= 0 ? &bindings_[slot].value : nullptr;
+}
+
+uint32_t Environment::bindingSlot(const std::string& name) {
+  Atom atom = atomize(name);
+  int existing = findSlot(atom);
+  if (existing >= 0) {
+    return static_cast<uint32_t>(existing);
+  }
+  uint32_t slot = static_cast<uint32_t>(bindings_.size());
+  bindings_.push_back(Binding{Value(Undefined{}), atom, 0});
+  if (bindings_.size() > kLinearScanLimit) {
+    if (slotIndex_.empty()) {
+      for (size_t i = 0; i < bindings_.size(); ++i) {
+        if (bindings_[i].name != kNoAtom) {
+          slotIndex_[bindings_[i].name] = static_cast<uint32_t>(i);
+        }
+      }
+    } else {
+      slotIndex_[atom] = slot;
+    }
+  }
+  if (name == kWithScopeObjectBinding) {
+    hasWithScope_ = true;
+  }
+  return slot;
 }
 
 void Environment::define(const std::string& name, const Value& value, bool isConst) {
-  bindings_[name] = value;
-  tdzBindings_.erase(name);  // Remove TDZ when initialized
+  uint32_t slot = bindingSlot(name);
+  bindings_[slot].value = value;
+  uint8_t& flags = bindings_[slot].flags;
+  flags &= ~(kTDZBinding | kSilentImmutableBinding);  // Remove TDZ when initialized
   if (isConst) {
-    constants_[name] = true;
+    flags |= kConstBinding;
   } else {
-    constants_.erase(name);
+    flags &= ~kConstBinding;
   }
-  silentImmutables_.erase(name);
   if (!parent_) {
-    auto it = bindings_.find("globalThis");
-    if (it != bindings_.end() && it->second.isObject()) {
-      auto globalObj = it->second.getGC<Object>();
+    auto* globalThisValue = findBinding("globalThis");
+    if (globalThisValue && globalThisValue->isObject()) {
+      auto globalObj = globalThisValue->getGC<Object>();
       globalObj->properties[name] = value;
     }
   }
 }
 
 void Environment::setBindingDirect(const std::string& name, const Value& value) {
-  bindings_[name] = value;
-  tdzBindings_.erase(name);
-  constants_.erase(name);
-  silentImmutables_.erase(name);
+  uint32_t slot = bindingSlot(name);
+  bindings_[slot].value = value;
+  bindings_[slot].flags &= ~(kTDZBinding | kConstBinding | kSilentImmutableBinding);
   // Do NOT sync to globalThis - caller manages that
 }
 
 void Environment::defineImmutableNFE(const std::string& name, const Value& value) {
-  bindings_[name] = value;
-  silentImmutables_[name] = true;
+  uint32_t slot = bindingSlot(name);
+  bindings_[slot].value = value;
+  bindings_[slot].flags |= kSilentImmutableBinding;
 }
 
 void Environment::defineLexical(const std::string& name, const Value& value, bool isConst) {
-  bindings_[name] = value;
-  tdzBindings_.erase(name);
-  lexicalBindings_[name] = true;
+  uint32_t slot = bindingSlot(name);
+  bindings_[slot].value = value;
+  uint8_t& flags = bindings_[slot].flags;
+  flags &= ~(kTDZBinding | kSilentImmutableBinding);
+  flags |= kLexicalBinding;
   if (isConst) {
-    constants_[name] = true;
+    flags |= kConstBinding;
   } else {
-    constants_.erase(name);
+    flags &= ~kConstBinding;
   }
-  silentImmutables_.erase(name);
 }
 
 void Environment::defineTDZ(const std::string& name) {
-  bindings_[name] = Value(Undefined{});
-  tdzBindings_[name] = true;
-  lexicalBindings_[name] = true;
-  constants_.erase(name);
-  silentImmutables_.erase(name);
+  uint32_t slot = bindingSlot(name);
+  bindings_[slot].value = Value(Undefined{});
+  uint8_t& flags = bindings_[slot].flags;
+  flags |= kTDZBinding | kLexicalBinding;
+  flags &= ~(kConstBinding | kSilentImmutableBinding);
 }
 
 void Environment::removeTDZ(const std::string& name) {
-  tdzBindings_.erase(name);
+  int slot = findSlot(AtomTable::instance().find(name));
+  if (slot >= 0) {
+    bindings_[slot].flags &= ~kTDZBinding;
+  }
 }
 
 bool Environment::isTDZ(const std::string& name) const {
   // Check if binding exists in this scope and is in TDZ
-  auto bindIt = bindings_.find(name);
-  if (bindIt != bindings_.end()) {
-    return tdzBindings_.find(name) != tdzBindings_.end();
+  int slot = findSlot(AtomTable::instance().find(name));
+  if (slot >= 0) {
+    return (bindings_[slot].flags & kTDZBinding) != 0;
   }
   // If not found in this scope, check parent
   if (parent_) {
@@ -2291,12 +2577,10 @@ bool Environment::isTDZ(const std::string& name) const {
 }
 
 std::optional<Value> Environment::get(const std::string& name) const {
-  auto it = bindings_.find(name);
-  if (it != bindings_.end()) {
-    return it->second;
+  if (auto* value = findBinding(name)) {
+    return *value;
   }
-  auto withScopeIt = bindings_.find(kWithScopeObjectBinding);
-  if (withScopeIt != bindings_.end()) {
+  if (hasWithScope_) {
     if (auto scopeValue = resolveWithScopeValue(name)) {
       auto withValue = getWithScopeBindingValue(*scopeValue, name, false);
       if (withValue.has_value()) {
@@ -2310,71 +2594,75 @@ std::optional<Value> Environment::get(const std::string& name) const {
   // At global scope, fall back to globalThis properties.
   // In JavaScript, the global object acts as the variable environment
   // for global code, so properties on globalThis are accessible as variables.
-  auto globalIt = bindings_.find("globalThis");
-  if (globalIt != bindings_.end() && globalIt->second.isObject()) {
-    auto globalObj = globalIt->second.getGC<Object>();
-    auto getterIt = globalObj->properties.find("__get_" + name);
-    if (getterIt != globalObj->properties.end() && getterIt->second.isFunction()) {
-      if (auto* interpreter = getGlobalInterpreter()) {
-        return interpreter->callForHarness(getterIt->second, {}, Value(globalObj));
+  auto* globalThisValue = findBinding("globalThis");
+  if (globalThisValue && globalThisValue->isObject()) {
+    auto globalObj = globalThisValue->getGC<Object>();
+    const auto& props = globalObj->properties;
+    if (props.hasAccessors()) {
+      if (const Value* getter = props.getter(name); getter && getter->isFunction()) {
+        if (auto* interpreter = getGlobalInterpreter()) {
+          Value fn = *getter;
+          return interpreter->callForHarness(fn, {}, Value(globalObj));
+        }
+        return Value(Undefined{});
+      }
+      if (props.setter(name)) {
+        return Value(Undefined{});
       }
-      return Value(Undefined{});
-    }
-    if (globalObj->properties.find("__set_" + name) != globalObj->properties.end()) {
-      return Value(Undefined{});
     }
-    auto propIt = globalObj->properties.find(name);
-    if (propIt != globalObj->properties.end()) {
-      return propIt->second;
+    if (const Value* value = props.lookup(name)) {
+      return *value;
     }
   }
   return std::nullopt;
 }
 
 std::optional<Value> Environment::getIgnoringWith(const std::string& name) const {
-  auto it = bindings_.find(name);
-  if (it != bindings_.end()) {
-    return it->second;
+  if (auto* value = findBinding(name)) {
+    return *value;
   }
   if (parent_) {
     return parent_->getIgnoringWith(name);
   }
-  auto globalIt = bindings_.find("globalThis");
-  if (globalIt != bindings_.end() && globalIt->second.isObject()) {
-    auto globalObj = globalIt->second.getGC<Object>();
-    auto getterIt = globalObj->properties.find("__get_" + name);
-    if (getterIt != globalObj->properties.end() && getterIt->second.isFunction()) {
-      if (auto* interpreter = getGlobalInterpreter()) {
-        return interpreter->callForHarness(getterIt->second, {}, Value(globalObj));
+  auto* globalThisValue = findBinding("globalThis");
+  if (globalThisValue && globalThisValue->isObject()) {
+    auto globalObj = globalThisValue->getGC<Object>();
+    const auto& props = globalObj->properties;
+    if (props.hasAccessors()) {
+      if (const Value* getter = props.getter(name); getter && getter->isFunction()) {
+        if (auto* interpreter = getGlobalInterpreter()) {
+          Value fn = *getter;
+          return interpreter->callForHarness(fn, {}, Value(globalObj));
+        }
+        return Value(Undefined{});
+      }
+      if (props.setter(name)) {
+        return Value(Undefined{});
       }
-      return Value(Undefined{});
-    }
-    if (globalObj->properties.find("__set_" + name) != globalObj->properties.end()) {
-      return Value(Undefined{});
     }
-    auto propIt = globalObj->properties.find(name);
-    if (propIt != globalObj->properties.end()) {
-      return propIt->second;
+    if (const Value* value = props.lookup(name)) {
+      return *value;
     }
   }
   return std::nullopt;
 }
 
 bool Environment::set(const std::string& name, const Value& value) {
-  auto it = bindings_.find(name);
-  if (it != bindings_.end()) {
-    if (silentImmutables_.find(name) != silentImmutables_.end()) {
+  int slot = findSlot(AtomTable::instance().find(name));
+  if (slot >= 0) {
+    uint8_t flags = bindings_[slot].flags;
+    if (flags & kSilentImmutableBinding) {
       return false;  // silently ignore writes to NFE name bindings
     }
-    if (constants_.find(name) != constants_.end()) {
+    if (flags & kConstBinding) {
       return false;
     }
-    bindings_[name] = value;
+    bindings_[slot].value = value;
     // Keep existing global object properties in sync with root-scope bindings.
     if (!parent_) {
-      auto globalIt = bindings_.find("globalThis");
-      if (globalIt != bindings_.end() && globalIt->second.isObject()) {
-        auto globalObj = globalIt->second.getGC<Object>();
+      auto* globalThisValue = findBinding("globalThis");
+      if (globalThisValue && globalThisValue->isObject()) {
+        auto globalObj = globalThisValue->getGC<Object>();
         if (globalObj->properties.find(name) != globalObj->properties.end()) {
           globalObj->properties[name] = value;
         }
@@ -2392,9 +2680,9 @@ bool Environment::set(const std::string& name, const Value& value) {
   }
   // At global scope, also check/set globalThis properties
   if (!parent_) {
-    auto globalIt = bindings_.find("globalThis");
-    if (globalIt != bindings_.end() && globalIt->second.isObject()) {
-      auto globalObj = globalIt->second.getGC<Object>();
+    auto* globalThisValue = findBinding("globalThis");
+    if (globalThisValue && globalThisValue->isObject()) {
+      auto globalObj = globalThisValue->getGC<Object>();
       auto propIt = globalObj->properties.find(name);
       if (propIt != globalObj->properties.end()) {
         propIt->second = value;
@@ -2406,21 +2694,19 @@ bool Environment::set(const std::string& name, const Value& value) {
 }
 
 bool Environment::has(const std::string& name) const {
-  if (bindings_.find(name) != bindings_.end()) {
+  if (findBinding(name)) {
     return true;
   }
-  auto withScopeIt = bindings_.find(kWithScopeObjectBinding);
-  if (withScopeIt != bindings_.end() &&
-      resolveWithScopeValue(name).has_value()) {
+  if (hasWithScope_ && resolveWithScopeValue(name).has_value()) {
     return true;
   }
   if (parent_) {
     return parent_->has(name);
   }
   // At global scope, also check globalThis properties
-  auto globalIt = bindings_.find("globalThis");
-  if (globalIt != bindings_.end() && globalIt->second.isObject()) {
-    auto globalObj = globalIt->second.getGC<Object>();
+  auto* globalThisValue = findBinding("globalThis");
+  if (globalThisValue && globalThisValue->isObject()) {
+    auto globalObj = globalThisValue->getGC<Object>();
     if (globalObj->properties.find(name) != globalObj->properties.end()) {
       return true;
     }
@@ -2429,41 +2715,35 @@ bool Environment::has(const std::string& name) const {
 }
 
 bool Environment::hasLocal(const std::string& name) const {
-  return bindings_.find(name) != bindings_.end();
+  return findBinding(name) != nullptr;
 }
 
 bool Environment::hasLexicalLocal(const std::string& name) const {
-  auto it = lexicalBindings_.find(name);
-  return it != lexicalBindings_.end() && it->second;
+  int slot = findSlot(AtomTable::instance().find(name));
+  return slot >= 0 && (bindings_[slot].flags & kLexicalBinding) != 0;
 }
 
 bool Environment::deleteLocalMutable(const std::string& name) {
-  auto it = bindings_.find(name);
-  if (it == bindings_.end()) {
-    return false;
-  }
-  if (constants_.find(name) != constants_.end()) {
+  int slot = findSlot(AtomTable::instance().find(name));
+  if (slot < 0) {
     return false;
   }
-  auto lexIt = lexicalBindings_.find(name);
-  if (lexIt != lexicalBindings_.end() && lexIt->second) {
+  if (bindings_[slot].flags & (kConstBinding | kLexicalBinding)) {
     return false;
   }
-  bindings_.erase(it);
-  constants_.erase(name);
-  lexicalBindings_.erase(name);
-  tdzBindings_.erase(name);
+  // The slot itself stays in place (unnamed) so other slot indices are stable.
+  slotIndex_.erase(bindings_[slot].name);
+  bindings_[slot] = Binding{Value(Undefined{}), kNoAtom, 0};
   return true;
 }
 
 int Environment::deleteFromWithScope(const std::string& name) {
-  auto withScopeIt = bindings_.find(kWithScopeObjectBinding);
-  if (withScopeIt != bindings_.end()) {
-    if (deleteWithScopeProperty(withScopeIt->second, name)) {
+  if (auto* withScopeValue = hasWithScope_ ? findBinding(kWithScopeObjectBinding) : nullptr) {
+    if (deleteWithScopeProperty(*withScopeValue, name)) {
       return 1;  // deleted
     }
     // Check if it exists but is non-configurable
-    if (lookupWithScopeProperty(withScopeIt->second, name).has_value()) {
+    if (lookupWithScopeProperty(*withScopeValue, name).has_value()) {
       return -1;  // exists but non-configurable
     }
   }
@@ -2477,13 +2757,12 @@ bool Environment::setVar(const std::string& name, const Value& value) {
   // For var declarations: walk the scope chain looking for bindings,
   // but skip with-scope objects. This ensures var assignments go to the
   // hoisted variable in the function/global scope, not to with-scope properties.
-  auto it = bindings_.find(name);
-  if (it != bindings_.end()) {
-    it->second = value;
+  if (auto* binding = findBinding(name)) {
+    *binding = value;
     if (!parent_) {
-      auto globalIt = bindings_.find("globalThis");
-      if (globalIt != bindings_.end() && globalIt->second.isObject()) {
-        auto globalObj = globalIt->second.getGC<Object>();
+      auto* globalThisValue = findBinding("globalThis");
+      if (globalThisValue && globalThisValue->isObject()) {
+        auto globalObj = globalThisValue->getGC<Object>();
         globalObj->properties[name] = value;
       }
     }
@@ -2496,7 +2775,7 @@ bool Environment::setVar(const std::string& name, const Value& value) {
 }
 
 Environment* Environment::resolveBindingEnvironment(const std::string& name) {
-  if (bindings_.find(name) != bindings_.end()) {
+  if (findBinding(name)) {
     return this;
   }
   if (parent_) {
@@ -2506,24 +2785,22 @@ Environment* Environment::resolveBindingEnvironment(const std::string& name) {
 }
 
 std::optional<Value> Environment::resolveWithScopeValue(const std::string& name) const {
-  auto it = bindings_.find(name);
-  if (it != bindings_.end()) {
+  if (findBinding(name)) {
     return std::nullopt;
   }
-  auto withScopeIt = bindings_.find(kWithScopeObjectBinding);
-  if (withScopeIt != bindings_.end()) {
-    if (hasPropertyLike(withScopeIt->second, name)) {
+  if (auto* withScopeValue = hasWithScope_ ? findBinding(kWithScopeObjectBinding) : nullptr) {
+    if (hasPropertyLike(*withScopeValue, name)) {
       if (auto* interpreter = getGlobalInterpreter(); interpreter && interpreter->hasError()) {
-        return withScopeIt->second;
+        return *withScopeValue;
       }
-      if (!isBlockedByUnscopables(withScopeIt->second, name)) {
+      if (!isBlockedByUnscopables(*withScopeValue, name)) {
         if (auto* interpreter = getGlobalInterpreter(); interpreter && interpreter->hasError()) {
-          return withScopeIt->second;
+          return *withScopeValue;
         }
-        return withScopeIt->second;
+        return *withScopeValue;
       }
       if (auto* interpreter = getGlobalInterpreter(); interpreter && interpreter->hasError()) {
-        return withScopeIt->second;
+        return *withScopeValue;
       }
     }
   }
@@ -2573,8 +2850,46 @@ GCPtr<Object> Environment::resolveWithScopeObject(const std::string& name) const
   return nullptr;
 }
 
+bool Environment::resolveSlot(Atom atom, uint32_t& hops, uint32_t& slot) const {
+  if (atom == kNoAtom) {
+    return false;
+  }
+  uint32_t depth = 0;
+  for (const Environment* env = this; env; env = env->parent_.get(), ++depth) {
+    int found = env->findSlot(atom);
+    if (found >= 0) {
+      hops = depth;
+      slot = static_cast<uint32_t>(found);
+      return true;
+    }
+    if (env->hasWithScope_) {
+      return false;
+    }
+  }
+  return false;
+}
+
+bool Environment::resolveGlobal(Atom atom, GlobalBindingCache& cache) const {
+  if (atom == kNoAtom) {
+    return false;
+  }
+  for (const Environment* env = this; env; env = env->parent_.get()) {
+    int found = env->findSlot(atom);
+    if (found >= 0) {
+      cache.root = root_;
+      cache.slot = env->parent_ ? GlobalBindingCache::kNotGlobal : static_cast<uint32_t>(found);
+      return !env->parent_;
+    }
+    if (env->hasWithScope_) {
+      return false;
+    }
+  }
+  return false;
+}
+
 bool Environment::isConst(const std::string& name) const {
-  if (constants_.find(name) != constants_.end()) {
+  int slot = findSlot(AtomTable::instance().find(name));
+  if (slot >= 0 && (bindings_[slot].flags & kConstBinding)) {
     return true;
   }
   if (parent_) {
@@ -2584,7 +2899,8 @@ bool Environment::isConst(const std::string& name) const {
 }
 
 bool Environment::isSilentImmutable(const std::string& name) const {
-  if (silentImmutables_.find(name) != silentImmutables_.end()) {
+  int slot = findSlot(AtomTable::instance().find(name));
+  if (slot >= 0 && (bindings_[slot].flags & kSilentImmutableBinding)) {
     return true;
   }
   if (parent_) {
@@ -2771,7 +3087,7 @@ GCPtr<Environment> Environment::createGlobal() {
     auto varEnv = evalEnv;
     if (isDirectEval) {
       auto scope = evalEnv;
-      while (scope && !scope->hasLocal("__var_scope__")) {
+      while (scope && !scope->isVarScope()) {
         auto parent = scope->getParentPtr();
         if (!parent) {
           break;
@@ -3018,7 +3334,7 @@ GCPtr<Environment> Environment::createGlobal() {
           continue;
         }
         // For direct eval in function scope, var declarations are instantiated in
-        // the variable environment record (the nearest __var_scope__), and must
+        // the variable environment record (the nearest var scope), and must
         // not observe bindings in outer environments (Test262 S11.13.1_A6_T1).
         // For global eval, preserve existing global bindings/properties.
         bool varExistsInVarEnv = false;
@@ -3235,14 +3551,14 @@ GCPtr<Environment> Environment::createGlobal() {
       if (args.empty()) return nullptr;
       const auto& thisVal = args[0];
       if (thisVal.isSymbol()) {
-        return &std::get<Symbol>(thisVal.data);
+        return &thisVal.asSymbol();
       }
       // Symbol wrapper object: has __primitive_value__ that is a Symbol
       if (thisVal.isObject()) {
         auto obj = thisVal.getGC<Object>();
         auto it = obj->properties.find("__primitive_value__");
         if (it != obj->properties.end() && it->second.isSymbol()) {
-          return &std::get<Symbol>(it->second.data);
+          return &it->second.asSymbol();
         }
       }
       return nullptr;
@@ -3464,9 +3780,9 @@ GCPtr<Environment> Environment::createGlobal() {
     if (args.empty() || !args[0].isSymbol()) {
       throw std::runtime_error("TypeError: Symbol.keyFor requires a Symbol argument");
     }
-    const auto& sym = std::get<Symbol>(args[0].data);
+    const auto& sym = args[0].asSymbol();
     for (const auto& [key, val] : globalSymbolRegistry) {
-      const auto& regSym = std::get<Symbol>(val.data);
+      const auto& regSym = val.asSymbol();
       if (sym.id == regSym.id) {
         return Value(key);
       }
@@ -3483,9 +3799,9 @@ GCPtr<Environment> Environment::createGlobal() {
 
   auto arrayToString = [](const GCPtr<Array>& arr) -> std::string {
     std::string out;
-    for (size_t i = 0; i < arr->elements.size(); i++) {
+    for (size_t i = 0; i < arr->elementCount(); i++) {
       if (i > 0) out += ",";
-      out += arr->elements[i].toString();
+      out += arr->element(i).toString();
     }
     return out;
   };
@@ -3568,7 +3884,7 @@ GCPtr<Environment> Environment::createGlobal() {
   };
 
   auto getPropertyFromBag = [getObjectProperty, callChecked](const Value& receiver,
-                                                            OrderedMap<std::string, Value>& bag,
+                                                            PropertyMap& bag,
                                                             const std::string& key) -> std::pair<bool, Value> {
     std::string getterKey = "__get_" + key;
     auto getterIt = bag.find(getterKey);
@@ -3754,7 +4070,7 @@ GCPtr<Environment> Environment::createGlobal() {
     }
     if (v.isString()) {
       bigint::BigIntValue parsed = 0;
-      if (!bigint::parseBigIntString(std::get<std::string>(v.data), parsed)) {
+      if (!bigint::parseBigIntString(v.asString(), parsed)) {
         throw std::runtime_error("SyntaxError: Cannot convert string to BigInt");
       }
       return parsed;
@@ -4009,16 +4325,16 @@ GCPtr<Environment> Environment::createGlobal() {
       // Check if first argument is an array
       if (std::holds_alternative<GCPtr<Array>>(args[0].data)) {
         auto arr = args[0].getGC<Array>();
-        auto typedArray = makeStandaloneTypedArray(arr->elements.size());
+        auto typedArray = makeStandaloneTypedArray(arr->elementCount());
 
         // Fill the typed array with values from the regular array
-        for (size_t i = 0; i < arr->elements.size(); ++i) {
+        for (size_t i = 0; i < arr->elementCount(); ++i) {
           if (type == TypedArrayType::BigInt64) {
-            typedArray->setBigIntElement(i, bigint::toInt64Trunc(arr->elements[i].toBigInt()));
+            typedArray->setBigIntElement(i, bigint::toInt64Trunc(arr->element(i).toBigInt()));
           } else if (type == TypedArrayType::BigUint64) {
-            typedArray->setBigUintElement(i, bigint::toUint64Trunc(arr->elements[i].toBigInt()));
+            typedArray->setBigUintElement(i, bigint::toUint64Trunc(arr->element(i).toBigInt()));
           } else {
-            typedArray->setElement(i, arr->elements[i].toNumber());
+            typedArray->setElement(i, arr->element(i).toNumber());
           }
         }
 
@@ -4144,7 +4460,7 @@ GCPtr<Environment> Environment::createGlobal() {
         }
         if (primitive.isString()) {
           bigint::BigIntValue parsed = 0;
-          if (!bigint::parseBigIntString(std::get<std::string>(primitive.data), parsed)) {
+          if (!bigint::parseBigIntString(primitive.asString(), parsed)) {
             throw std::runtime_error("SyntaxError: Cannot convert string to BigInt");
           }
           return parsed;
@@ -4237,7 +4553,7 @@ GCPtr<Environment> Environment::createGlobal() {
         }
         if (primitive.isString()) {
           bigint::BigIntValue parsed = 0;
-          if (!bigint::parseBigIntString(std::get<std::string>(primitive.data), parsed)) {
+          if (!bigint::parseBigIntString(primitive.asString(), parsed)) {
             throw std::runtime_error("SyntaxError: Cannot convert string to BigInt");
           }
           return parsed;
@@ -4648,17 +4964,17 @@ GCPtr<Environment> Environment::createGlobal() {
     };
 
     auto strictEqualValue = [](const Value& left, const Value& right) -> bool {
-      if (left.data.index() != right.data.index()) {
+      if (!left.hasSameType(right)) {
         return false;
       }
       if (left.isSymbol() && right.isSymbol()) {
-        auto& lsym = std::get<Symbol>(left.data);
-        auto& rsym = std::get<Symbol>(right.data);
+        auto& lsym = left.asSymbol();
+        auto& rsym = right.asSymbol();
         return lsym.id == rsym.id;
       }
       if (left.isBigInt() && right.isBigInt()) return left.toBigInt() == right.toBigInt();
       if (left.isNumber() && right.isNumber()) return left.toNumber() == right.toNumber();
-      if (left.isString() && right.isString()) return std::get<std::string>(left.data) == std::get<std::string>(right.data);
+      if (left.isString() && right.isString()) return left.asString() == right.asString();
       if (left.isBool() && right.isBool()) return std::get<bool>(left.data) == std::get<bool>(right.data);
       if ((left.isNull() && right.isNull()) || (left.isUndefined() && right.isUndefined())) return true;
       if (left.isObject() && right.isObject()) return left.getGC<Object>().get() == right.getGC<Object>().get();
@@ -6566,8 +6882,8 @@ GCPtr<Environment> Environment::createGlobal() {
             if (kind == 2) {
               auto pair = GarbageCollector::makeGC<Array>();
               GarbageCollector::instance().reportAllocation(sizeof(Array));
-              pair->elements.push_back(Value(static_cast<double>(current)));
-              pair->elements.push_back(value);
+              pair->pushElement(Value(static_cast<double>(current)));
+              pair->pushElement(value);
               return makeIteratorResultObject(Value(pair), false);
             }
             return makeIteratorResultObject(value, false);
@@ -8107,7 +8423,7 @@ GCPtr<Environment> Environment::createGlobal() {
     bool hasImportOptions = false;
     Value importOptions = Value(Undefined{});
     if (args.size() > 1 && args[1].isString()) {
-      const std::string& maybePhase = std::get<std::string>(args[1].data);
+      const std::string& maybePhase = args[1].asString();
       if (maybePhase == kImportPhaseSourceSentinel) {
         importPhase = ImportPhase::Source;
       } else if (maybePhase == kImportPhaseDeferSentinel) {
@@ -8412,9 +8728,9 @@ GCPtr<Environment> Environment::createGlobal() {
             std::vector<std::string> candidateKeys;
             if (ownKeysResult.isArray()) {
               auto arr = ownKeysResult.getGC<Array>();
-              for (const auto& entry : arr->elements) {
+              for (const auto& entry : arr->elements()) {
                 if (entry.isString()) {
-                  candidateKeys.push_back(std::get<std::string>(entry.data));
+                  candidateKeys.push_back(entry.asString());
                 }
               }
             }
@@ -8466,7 +8782,7 @@ GCPtr<Environment> Environment::createGlobal() {
         }
       } else if (source.isArray()) {
         auto arr = source.getGC<Array>();
-        for (size_t i = 0; i < arr->elements.size(); ++i) {
+        for (size_t i = 0; i < arr->elementCount(); ++i) {
           pushKey(std::to_string(i));
         }
       } else if (source.isFunction()) {
@@ -8555,7 +8871,7 @@ GCPtr<Environment> Environment::createGlobal() {
               promise->reject(Value(err));
               return Value(promise);
             }
-            importAttributes[key] = std::get<std::string>(attrValue.data);
+            importAttributes[key] = attrValue.asString();
           }
         }
       }
@@ -8768,12 +9084,12 @@ GCPtr<Environment> Environment::createGlobal() {
       auto matches = matchesIt->second.getGC<Array>();
       auto idxIt = thisObj->properties.find("__regexp_string_iterator_index__");
       size_t idx = idxIt != thisObj->properties.end() ? static_cast<size_t>(idxIt->second.toNumber()) : 0;
-      if (idx >= matches->elements.size()) {
+      if (idx >= matches->elementCount()) {
         thisObj->properties["__regexp_string_iterator_done__"] = Value(true);
         return makeIteratorResultObject(Value(Undefined{}), true);
       }
       thisObj->properties["__regexp_string_iterator_index__"] = Value(static_cast<double>(idx + 1));
-      return makeIteratorResultObject(matches->elements[idx], false);
+      return makeIteratorResultObject(matches->element(idx), false);
     };
     regExpStringIteratorPrototype->properties["next"] = Value(reIterNext);
     regExpStringIteratorPrototype->properties["__non_enum_next"] = Value(true);
@@ -8962,7 +9278,7 @@ GCPtr<Environment> Environment::createGlobal() {
       if (execResult.isNull()) {
         break;
       }
-      allMatches->elements.push_back(execResult);
+      allMatches->pushElement(execResult);
       if (!global) {
         break;
       }
@@ -9076,10 +9392,10 @@ GCPtr<Environment> Environment::createGlobal() {
     auto buildSpecialResult = [regexPtr, &str, &utf16IndexFromByteOffset](
                                   const SpecialRegexMatchResult& special) {
       auto arr = makeArrayWithPrototype();
-      arr->elements.push_back(Value(special.value));
+      arr->pushElement(Value(special.value));
       for (const auto& capture : special.captures) {
-        if (capture.matched) arr->elements.push_back(Value(capture.value));
-        else arr->elements.push_back(Value(Undefined{}));
+        if (capture.matched) arr->pushElement(Value(capture.value));
+        else arr->pushElement(Value(Undefined{}));
       }
       arr->properties["index"] = Value(utf16IndexFromByteOffset(special.index));
       arr->properties["input"] = Value(str);
@@ -9113,14 +9429,14 @@ GCPtr<Environment> Environment::createGlobal() {
         auto indices = makeArrayWithPrototype();
         auto pushIndexPair = [&](const GCPtr<Array>& target, size_t start, size_t end) {
           auto pair = makeArrayWithPrototype();
-          pair->elements.push_back(Value(utf16IndexFromByteOffset(start)));
-          pair->elements.push_back(Value(utf16IndexFromByteOffset(end)));
-          target->elements.push_back(Value(pair));
+          pair->pushElement(Value(utf16IndexFromByteOffset(start)));
+          pair->pushElement(Value(utf16IndexFromByteOffset(end)));
+          target->pushElement(Value(pair));
         };
         pushIndexPair(indices, special.index, special.end);
         for (const auto& capture : special.captures) {
           if (capture.matched) pushIndexPair(indices, capture.start, capture.end);
-          else indices->elements.push_back(Value(Undefined{}));
+          else indices->pushElement(Value(Undefined{}));
         }
         if (hasNamedCaptures) {
           auto groups = makeNullPrototypeObject();
@@ -9134,8 +9450,8 @@ GCPtr<Environment> Environment::createGlobal() {
             const std::string& name = regexPtr->captureGroupNames[i];
             if (!name.empty() && special.captures[i].matched) {
               auto pair = makeArrayWithPrototype();
-              pair->elements.push_back(Value(utf16IndexFromByteOffset(special.captures[i].start)));
-              pair->elements.push_back(Value(utf16IndexFromByteOffset(special.captures[i].end)));
+              pair->pushElement(Value(utf16IndexFromByteOffset(special.captures[i].start)));
+              pair->pushElement(Value(utf16IndexFromByteOffset(special.captures[i].end)));
               groups->properties[name] = Value(pair);
             }
           }
@@ -9278,15 +9594,15 @@ GCPtr<Environment> Environment::createGlobal() {
       auto arr = makeArrayWithPrototype();
       size_t matchStart = searchByteOffset + static_cast<size_t>(match.position(0));
       size_t matchEnd = matchStart + static_cast<size_t>(match.length(0));
-      arr->elements.push_back(Value(
+      arr->pushElement(Value(
           substringFromEngineSpan(matchStart, static_cast<size_t>(match.length(0)))));
       for (size_t i = 1; i < match.size(); ++i) {
         if (match[i].matched) {
           size_t captureStart = searchByteOffset + static_cast<size_t>(match.position(i));
-          arr->elements.push_back(Value(
+          arr->pushElement(Value(
               substringFromEngineSpan(captureStart, static_cast<size_t>(match.length(i)))));
         } else {
-          arr->elements.push_back(Value(Undefined{}));
+          arr->pushElement(Value(Undefined{}));
         }
       }
       arr->properties["index"] = Value(utf16IndexFromEngineByteOffset(matchStart));
@@ -9322,9 +9638,9 @@ GCPtr<Environment> Environment::createGlobal() {
         auto indices = makeArrayWithPrototype();
         auto pushIndexPair = [&](const GCPtr<Array>& target, size_t start, size_t end) {
           auto pair = makeArrayWithPrototype();
-          pair->elements.push_back(Value(utf16IndexFromEngineByteOffset(start)));
-          pair->elements.push_back(Value(utf16IndexFromEngineByteOffset(end)));
-          target->elements.push_back(Value(pair));
+          pair->pushElement(Value(utf16IndexFromEngineByteOffset(start)));
+          pair->pushElement(Value(utf16IndexFromEngineByteOffset(end)));
+          target->pushElement(Value(pair));
         };
         pushIndexPair(indices, matchStart, matchEnd);
         for (size_t i = 1; i < match.size(); ++i) {
@@ -9332,7 +9648,7 @@ GCPtr<Environment> Environment::createGlobal() {
             size_t start = searchByteOffset + static_cast<size_t>(match.position(i));
             pushIndexPair(indices, start, start + static_cast<size_t>(match.length(i)));
           } else {
-            indices->elements.push_back(Value(Undefined{}));
+            indices->pushElement(Value(Undefined{}));
           }
         }
         if (hasNamedCaptures) {
@@ -9348,8 +9664,8 @@ GCPtr<Environment> Environment::createGlobal() {
             if (!name.empty() && match[i].matched) {
               size_t start = searchByteOffset + static_cast<size_t>(match.position(i));
               auto pair = makeArrayWithPrototype();
-              pair->elements.push_back(Value(utf16IndexFromEngineByteOffset(start)));
-              pair->elements.push_back(Value(utf16IndexFromEngineByteOffset(
+              pair->pushElement(Value(utf16IndexFromEngineByteOffset(start)));
+              pair->pushElement(Value(utf16IndexFromEngineByteOffset(
                   start + static_cast<size_t>(match.length(i)))));
               groups->properties[name] = Value(pair);
             }
@@ -9706,7 +10022,7 @@ GCPtr<Environment> Environment::createGlobal() {
       while (true) {
         Value execResult = callExec();
         if (execResult.isNull()) {
-          if (result->elements.empty()) {
+          if (result->elements().empty()) {
             return Value(Null{});
           }
           return Value(result);
@@ -9715,7 +10031,7 @@ GCPtr<Environment> Environment::createGlobal() {
         auto [hasZero, zeroValue] = getPropertyLike(execResult, "0", execResult);
         throwPendingError();
         std::string matchStr = toStringForStringBuiltinArg(hasZero ? zeroValue : Value(Undefined{}));
-        result->elements.push_back(Value(matchStr));
+        result->pushElement(Value(matchStr));
 
         if (matchStr.empty()) {
           size_t thisIndex = getLastIndex();
@@ -9771,7 +10087,7 @@ GCPtr<Environment> Environment::createGlobal() {
         if (left.isBool() && right.isBool()) return left.toBool() == right.toBool();
         if (left.isNull() && right.isNull()) return true;
         if (left.isUndefined() && right.isUndefined()) return true;
-        if (left.isSymbol() && right.isSymbol()) return std::get<Symbol>(left.data) == std::get<Symbol>(right.data);
+        if (left.isSymbol() && right.isSymbol()) return left.asSymbol() == right.asSymbol();
         if (left.isBigInt() && right.isBigInt()) return left.toBigInt() == right.toBigInt();
         if (left.isObject() && right.isObject()) return left.getGC<Object>().get() == right.getGC<Object>().get();
         if (left.isArray() && right.isArray()) return left.getGC<Array>().get() == right.getGC<Array>().get();
@@ -9993,7 +10309,7 @@ GCPtr<Environment> Environment::createGlobal() {
           }
         }
         if (value.isString()) {
-          const std::string& wrapped = std::get<std::string>(value.data);
+          const std::string& wrapped = value.asString();
           size_t wrappedLength = String_utf16Length(wrapped);
           for (size_t i = 0; i < wrappedLength; ++i) {
             std::string idx = std::to_string(i);
@@ -10407,10 +10723,10 @@ GCPtr<Environment> Environment::createGlobal() {
         size_t length = 0;
         if (execResult.isArray()) {
           auto arr = execResult.getGC<Array>();
-          length = arr ? arr->elements.size() : 0;
+          length = arr ? arr->elementCount() : 0;
           for (size_t i = 1; i < length; ++i) {
-            result->elements.push_back(arr->elements[i]);
-            if (result->elements.size() >= limit) {
+            result->pushElement(arr->element(i));
+            if (result->elementCount() >= limit) {
               return true;
             }
           }
@@ -10426,8 +10742,8 @@ GCPtr<Environment> Environment::createGlobal() {
           auto [hasCapture, captureValue] =
               interp->getPropertyForExternal(execResult, std::to_string(i));
           throwPendingError();
-          result->elements.push_back(hasCapture ? captureValue : Value(Undefined{}));
-          if (result->elements.size() >= limit) {
+          result->pushElement(hasCapture ? captureValue : Value(Undefined{}));
+          if (result->elementCount() >= limit) {
             return true;
           }
         }
@@ -10437,7 +10753,7 @@ GCPtr<Environment> Environment::createGlobal() {
       if (size == 0) {
         Value match = callExec();
         if (match.isNull()) {
-          result->elements.push_back(Value(str));
+          result->pushElement(Value(str));
         }
         return Value(result);
       }
@@ -10460,8 +10776,8 @@ GCPtr<Environment> Environment::createGlobal() {
 
         size_t pByte = byteOffsetFromUtf16Index(p);
         size_t qByte = byteOffsetFromUtf16Index(q);
-        result->elements.push_back(Value(str.substr(pByte, qByte - pByte)));
-        if (result->elements.size() >= limit) {
+        result->pushElement(Value(str.substr(pByte, qByte - pByte)));
+        if (result->elementCount() >= limit) {
           return Value(result);
         }
 
@@ -10473,7 +10789,7 @@ GCPtr<Environment> Environment::createGlobal() {
       }
 
       size_t pByte = byteOffsetFromUtf16Index(p);
-      result->elements.push_back(Value(str.substr(pByte)));
+      result->pushElement(Value(str.substr(pByte)));
       return Value(result);
     };
     const auto& splitKey = WellKnownSymbols::splitKey();
@@ -11015,8 +11331,8 @@ GCPtr<Environment> Environment::createGlobal() {
       auto resources = resourcesIt->second.getGC<Array>();
       auto* interp = getGlobalInterpreter();
       Value accumulatedError(Undefined{});
-      for (size_t i = resources->elements.size(); i > 0; --i) {
-        Value recordValue = resources->elements[i - 1];
+      for (size_t i = resources->elementCount(); i > 0; --i) {
+        Value recordValue = resources->element(i - 1);
         if (!recordValue.isObject()) continue;
         auto record = recordValue.getGC<Object>();
         auto kindIt = record->properties.find("__dispose_kind__");
@@ -11053,7 +11369,7 @@ GCPtr<Environment> Environment::createGlobal() {
           }
         }
       }
-      resources->elements.clear();
+      resources->elements().clear();
       if (!accumulatedError.isUndefined()) {
         throw JsValueException(accumulatedError);
       }
@@ -11090,7 +11406,7 @@ GCPtr<Environment> Environment::createGlobal() {
       GarbageCollector::instance().reportAllocation(sizeof(Object));
       record->properties["__dispose_kind__"] = Value(std::string("defer"));
       record->properties["__dispose_method__"] = args[1];
-      resources->elements.push_back(Value(record));
+      resources->pushElement(Value(record));
       return Value(Undefined{});
     };
     disposableStackProto->properties["defer"] = Value(disposableDefer);
@@ -11123,7 +11439,7 @@ GCPtr<Environment> Environment::createGlobal() {
       record->properties["__dispose_kind__"] = Value(std::string("adopt"));
       record->properties["__dispose_method__"] = args[2];
       record->properties["__dispose_value__"] = args.size() > 1 ? args[1] : Value(Undefined{});
-      resources->elements.push_back(Value(record));
+      resources->pushElement(Value(record));
       return args.size() > 1 ? args[1] : Value(Undefined{});
     };
     disposableStackProto->properties["adopt"] = Value(disposableAdopt);
@@ -11184,7 +11500,7 @@ GCPtr<Environment> Environment::createGlobal() {
       record->properties["__dispose_kind__"] = Value(std::string("use"));
       record->properties["__dispose_method__"] = method;
       record->properties["__dispose_value__"] = valueArg;
-      resources->elements.push_back(Value(record));
+      resources->pushElement(Value(record));
       return valueArg;
     };
     disposableStackProto->properties["use"] = Value(disposableUse);
@@ -11318,12 +11634,12 @@ GCPtr<Environment> Environment::createGlobal() {
         }
 
         auto accumulatedError = std::make_shared<Value>(Undefined{});
-        auto index = std::make_shared<size_t>(resources->elements.size());
+        auto index = std::make_shared<size_t>(resources->elementCount());
         auto settlePromise = std::make_shared<std::function<void()>>();
         auto processNext = std::make_shared<std::function<void()>>();
 
         *settlePromise = [promise, resources, accumulatedError]() {
-          resources->elements.clear();
+          resources->elements().clear();
           if (accumulatedError->isUndefined()) {
             promise->resolve(Value(Undefined{}));
           } else {
@@ -11343,7 +11659,7 @@ GCPtr<Environment> Environment::createGlobal() {
           };
 
           while (*index > 0) {
-            Value recordValue = resources->elements[*index - 1];
+            Value recordValue = resources->element(*index - 1);
             --(*index);
             if (!recordValue.isObject()) {
               continue;
@@ -11486,7 +11802,7 @@ GCPtr<Environment> Environment::createGlobal() {
       record->properties["__dispose_kind__"] = Value(std::string("use"));
       record->properties["__dispose_method__"] = method;
       record->properties["__dispose_value__"] = valueArg;
-      resources->elements.push_back(Value(record));
+      resources->pushElement(Value(record));
       return valueArg;
     };
     asyncDisposableStackProto->properties["use"] = Value(asyncDisposableUse);
@@ -11521,7 +11837,7 @@ GCPtr<Environment> Environment::createGlobal() {
       record->properties["__dispose_kind__"] = Value(std::string("adopt"));
       record->properties["__dispose_method__"] = args[2];
       record->properties["__dispose_value__"] = args.size() > 1 ? args[1] : Value(Undefined{});
-      resources->elements.push_back(Value(record));
+      resources->pushElement(Value(record));
       return args.size() > 1 ? args[1] : Value(Undefined{});
     };
     asyncDisposableStackProto->properties["adopt"] = Value(asyncDisposableAdopt);
@@ -11555,7 +11871,7 @@ GCPtr<Environment> Environment::createGlobal() {
       GarbageCollector::instance().reportAllocation(sizeof(Object));
       record->properties["__dispose_kind__"] = Value(std::string("defer"));
       record->properties["__dispose_method__"] = args[1];
-      resources->elements.push_back(Value(record));
+      resources->pushElement(Value(record));
       return Value(Undefined{});
     };
     asyncDisposableStackProto->properties["defer"] = Value(asyncDisposableDefer);
@@ -11725,45 +12041,63 @@ GCPtr<Environment> Environment::createGlobal() {
   };
 
   // Helper to define a Map prototype method
-  auto defineMapMethod = [&](const std::string& name, int length, std::function<Value(const std::vector<Value>&)> impl) {
-    auto fn = GarbageCollector::makeGC<Function>();
-    fn->isNative = true;
-    fn->properties["__uses_this_arg__"] = Value(true);
+  auto installMapMethod = [&](const GCPtr<Function>& fn, const std::string& name, int length) {
     fn->properties["name"] = Value(name);
     fn->properties["__non_writable_name"] = Value(true);
     fn->properties["__non_enum_name"] = Value(true);
     fn->properties["length"] = Value(static_cast<double>(length));
     fn->properties["__non_writable_length"] = Value(true);
     fn->properties["__non_enum_length"] = Value(true);
-    fn->nativeFunc = impl;
     mapPrototype->properties[name] = Value(fn);
     mapPrototype->properties["__non_enum_" + name] = Value(true);
   };
+  auto defineMapMethod = [&](const std::string& name, int length, std::function<Value(const std::vector<Value>&)> impl) {
+    auto fn = GarbageCollector::makeGC<Function>();
+    fn->isNative = true;
+    fn->properties["__uses_this_arg__"] = Value(true);
+    fn->nativeFunc = impl;
+    installMapMethod(fn, name, length);
+  };
+  // get/set/has/delete sit on hot paths, so they use the fast convention.
+  auto defineFastMapMethod = [&](const std::string& name, int length, FastNativeFunction impl) {
+    auto fn = GarbageCollector::makeGC<Function>();
+    setFastNative(*fn, impl, true);
+    installMapMethod(fn, name, length);
+  };
 
-  defineMapMethod("get", 1, [validateMapThis](const std::vector<Value>& args) -> Value {
-    auto m = validateMapThis(args, "get");
-    if (args.size() < 2) return Value(Undefined{});
-    return m->get(args[1]);
+  defineFastMapMethod("get", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter&,
+                                   NativeThrow& thrown) -> Value {
+    if (!thisValue.isMap()) {
+      return thrown.error(ErrorType::TypeError, "Method Map.prototype.get called on incompatible receiver");
+    }
+    return thisValue.getGC<Map>()->get(args.empty() ? Value(Undefined{}) : args[0]);
   });
 
-  defineMapMethod("set", 2, [validateMapThis](const std::vector<Value>& args) -> Value {
-    auto m = validateMapThis(args, "set");
-    Value key = args.size() > 1 ? args[1] : Value(Undefined{});
-    Value val = args.size() > 2 ? args[2] : Value(Undefined{});
-    m->set(key, val);
-    return Value(m);
+  defineFastMapMethod("set", 2, [](const Value& thisValue, std::span<const Value> args, Interpreter&,
+                                   NativeThrow& thrown) -> Value {
+    if (!thisValue.isMap()) {
+      return thrown.error(ErrorType::TypeError, "Method Map.prototype.set called on incompatible receiver");
+    }
+    Value key = args.size() > 0 ? args[0] : Value(Undefined{});
+    Value val = args.size() > 1 ? args[1] : Value(Undefined{});
+    thisValue.getGC<Map>()->set(key, val);
+    return thisValue;
   });
 
-  defineMapMethod("has", 1, [validateMapThis](const std::vector<Value>& args) -> Value {
-    auto m = validateMapThis(args, "has");
-    if (args.size() < 2) return Value(m->has(Value(Undefined{})));
-    return Value(m->has(args[1]));
+  defineFastMapMethod("has", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter&,
+                                   NativeThrow& thrown) -> Value {
+    if (!thisValue.isMap()) {
+      return thrown.error(ErrorType::TypeError, "Method Map.prototype.has called on incompatible receiver");
+    }
+    return Value(thisValue.getGC<Map>()->has(args.empty() ? Value(Undefined{}) : args[0]));
   });
 
-  defineMapMethod("delete", 1, [validateMapThis](const std::vector<Value>& args) -> Value {
-    auto m = validateMapThis(args, "delete");
-    if (args.size() < 2) return Value(false);
-    return Value(m->deleteKey(args[1]));
+  defineFastMapMethod("delete", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter&,
+                                      NativeThrow& thrown) -> Value {
+    if (!thisValue.isMap()) {
+      return thrown.error(ErrorType::TypeError, "Method Map.prototype.delete called on incompatible receiver");
+    }
+    return Value(thisValue.getGC<Map>()->deleteKey(args.empty() ? Value(Undefined{}) : args[0]));
   });
 
   defineMapMethod("clear", 0, [validateMapThis](const std::vector<Value>& args) -> Value {
@@ -11783,10 +12117,9 @@ GCPtr<Environment> Environment::createGlobal() {
     if (!interp) return Value(Undefined{});
     auto callback = args[1].getGC<Function>();
     Value thisArg = args.size() > 2 ? args[2] : Value(Undefined{});
-    for (size_t i = 0; i < m->entries.size(); ++i) {
-      auto& entry = m->entries[i];
-      interp->callForHarness(Value(callback), {entry.second, entry.first, Value(m)}, thisArg);
-    }
+    m->table.forEach([&](const Value& key, const Value& value) {
+      interp->callForHarness(Value(callback), {value, key, Value(m)}, thisArg);
+    });
     return Value(Undefined{});
   });
 
@@ -12083,7 +12416,7 @@ GCPtr<Environment> Environment::createGlobal() {
       while (true) {
         auto [done, val] = iterStep(interp, nextMethod, iter);
         if (done) break;
-        result->elements.push_back(val);
+        result->pushElement(val);
       }
       return Value(result);
     });
@@ -12859,14 +13192,15 @@ GCPtr<Environment> Environment::createGlobal() {
       }
       auto m = mapIt->second.getGC<Map>();
       size_t idx = static_cast<size_t>(idxIt->second.toNumber());
-      std::string kind = kindIt->second.isString() ? std::get<std::string>(kindIt->second.data) : "key+value";
+      std::string kind = kindIt->second.isString() ? kindIt->second.asString() : "key+value";
 
-      if (idx >= m->entries.size()) {
+      const auto* entryPtr = m->table.next(idx);
+      if (!entryPtr) {
         thisObj->properties["__map_iterator_done__"] = Value(true);
         return makeIteratorResultObject(Value(Undefined{}), true);
       }
-      auto& entry = m->entries[idx];
-      thisObj->properties["__map_iterator_index__"] = Value(static_cast<double>(idx + 1));
+      std::pair<Value, Value> entry{entryPtr->key, entryPtr->value};
+      thisObj->properties["__map_iterator_index__"] = Value(static_cast<double>(idx));
 
       if (kind == "key") {
         return makeIteratorResultObject(entry.first, false);
@@ -12874,8 +13208,8 @@ GCPtr<Environment> Environment::createGlobal() {
         return makeIteratorResultObject(entry.second, false);
       } else {
         auto pair = GarbageCollector::makeGC<Array>();
-        pair->elements.push_back(entry.first);
-        pair->elements.push_back(entry.second);
+        pair->pushElement(entry.first);
+        pair->pushElement(entry.second);
         return makeIteratorResultObject(Value(pair), false);
       }
     };
@@ -13013,23 +13347,23 @@ GCPtr<Environment> Environment::createGlobal() {
         if (resultMap->has(key)) {
           Value existing = resultMap->get(key);
           if (existing.isArray()) {
-            existing.getGC<Array>()->elements.push_back(item);
+            existing.getGC<Array>()->pushElement(item);
           }
         } else {
           auto group = GarbageCollector::makeGC<Array>();
-          group->elements.push_back(item);
+          group->pushElement(item);
           resultMap->set(key, Value(group));
         }
       };
 
       if (items.isArray()) {
         auto arr = items.getGC<Array>();
-        for (size_t i = 0; i < arr->elements.size(); ++i) {
-          addToGroup(arr->elements[i], i);
+        for (size_t i = 0; i < arr->elementCount(); ++i) {
+          addToGroup(arr->element(i), i);
         }
       } else if (items.isString()) {
         // Iterate string by code points
-        const std::string& str = std::get<std::string>(items.data);
+        const std::string& str = items.asString();
         size_t bytePos = 0;
         size_t idx = 0;
         while (bytePos < str.size()) {
@@ -13195,38 +13529,54 @@ GCPtr<Environment> Environment::createGlobal() {
     return args[0].getGC<Set>();
   };
 
-  auto defineSetMethod = [&](const std::string& name, int length, std::function<Value(const std::vector<Value>&)> impl) {
-    auto fn = GarbageCollector::makeGC<Function>();
-    fn->isNative = true;
-    fn->properties["__uses_this_arg__"] = Value(true);
+  // Helper to define a Set prototype method
+  auto installSetMethod = [&](const GCPtr<Function>& fn, const std::string& name, int length) {
     fn->properties["name"] = Value(name);
     fn->properties["__non_writable_name"] = Value(true);
     fn->properties["__non_enum_name"] = Value(true);
     fn->properties["length"] = Value(static_cast<double>(length));
     fn->properties["__non_writable_length"] = Value(true);
     fn->properties["__non_enum_length"] = Value(true);
-    fn->nativeFunc = impl;
     setPrototype->properties[name] = Value(fn);
     setPrototype->properties["__non_enum_" + name] = Value(true);
   };
+  auto defineSetMethod = [&](const std::string& name, int length, std::function<Value(const std::vector<Value>&)> impl) {
+    auto fn = GarbageCollector::makeGC<Function>();
+    fn->isNative = true;
+    fn->properties["__uses_this_arg__"] = Value(true);
+    fn->nativeFunc = impl;
+    installSetMethod(fn, name, length);
+  };
+  // add/has/delete sit on hot paths, so they use the fast convention.
+  auto defineFastSetMethod = [&](const std::string& name, int length, FastNativeFunction impl) {
+    auto fn = GarbageCollector::makeGC<Function>();
+    setFastNative(*fn, impl, true);
+    installSetMethod(fn, name, length);
+  };
 
-  defineSetMethod("add", 1, [validateSetThis](const std::vector<Value>& args) -> Value {
-    auto s = validateSetThis(args, "add");
-    Value val = args.size() > 1 ? args[1] : Value(Undefined{});
-    s->add(val);
-    return Value(s);
+  defineFastSetMethod("add", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter&,
+                                   NativeThrow& thrown) -> Value {
+    if (!thisValue.isSet()) {
+      return thrown.error(ErrorType::TypeError, "Method Set.prototype.add called on incompatible receiver");
+    }
+    thisValue.getGC<Set>()->add(args.empty() ? Value(Undefined{}) : args[0]);
+    return thisValue;
   });
 
-  defineSetMethod("has", 1, [validateSetThis](const std::vector<Value>& args) -> Value {
-    auto s = validateSetThis(args, "has");
-    if (args.size() < 2) return Value(s->has(Value(Undefined{})));
-    return Value(s->has(args[1]));
+  defineFastSetMethod("has", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter&,
+                                   NativeThrow& thrown) -> Value {
+    if (!thisValue.isSet()) {
+      return thrown.error(ErrorType::TypeError, "Method Set.prototype.has called on incompatible receiver");
+    }
+    return Value(thisValue.getGC<Set>()->has(args.empty() ? Value(Undefined{}) : args[0]));
   });
 
-  defineSetMethod("delete", 1, [validateSetThis](const std::vector<Value>& args) -> Value {
-    auto s = validateSetThis(args, "delete");
-    if (args.size() < 2) return Value(false);
-    return Value(s->deleteValue(args[1]));
+  defineFastSetMethod("delete", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter&,
+                                      NativeThrow& thrown) -> Value {
+    if (!thisValue.isSet()) {
+      return thrown.error(ErrorType::TypeError, "Method Set.prototype.delete called on incompatible receiver");
+    }
+    return Value(thisValue.getGC<Set>()->deleteValue(args.empty() ? Value(Undefined{}) : args[0]));
   });
 
   defineSetMethod("clear", 0, [validateSetThis](const std::vector<Value>& args) -> Value {
@@ -13244,9 +13594,9 @@ GCPtr<Environment> Environment::createGlobal() {
     if (!interp) return Value(Undefined{});
     auto callback = args[1].getGC<Function>();
     Value thisArg = args.size() > 2 ? args[2] : Value(Undefined{});
-    for (size_t i = 0; i < s->values.size(); ++i) {
-      interp->callForHarness(Value(callback), {s->values[i], s->values[i], Value(s)}, thisArg);
-    }
+    s->table.forEach([&](const Value& value, const Value&) {
+      interp->callForHarness(Value(callback), {value, value, Value(s)}, thisArg);
+    });
     return Value(Undefined{});
   });
 
@@ -13291,19 +13641,20 @@ GCPtr<Environment> Environment::createGlobal() {
       }
       auto s = setIt->second.getGC<Set>();
       size_t idx = static_cast<size_t>(idxIt->second.toNumber());
-      std::string kind = kindIt->second.isString() ? std::get<std::string>(kindIt->second.data) : "value";
+      std::string kind = kindIt->second.isString() ? kindIt->second.asString() : "value";
 
-      if (idx >= s->values.size()) {
+      const auto* entry = s->table.next(idx);
+      if (!entry) {
         thisObj->properties["__set_iterator_done__"] = Value(true);
         return makeIteratorResultObject(Value(Undefined{}), true);
       }
-      auto& elem = s->values[idx];
-      thisObj->properties["__set_iterator_index__"] = Value(static_cast<double>(idx + 1));
+      Value elem = entry->key;
+      thisObj->properties["__set_iterator_index__"] = Value(static_cast<double>(idx));
 
       if (kind == "key+value") {
         auto pair = GarbageCollector::makeGC<Array>();
-        pair->elements.push_back(elem);
-        pair->elements.push_back(elem);
+        pair->pushElement(elem);
+        pair->pushElement(elem);
         return makeIteratorResultObject(Value(pair), false);
       } else {
         return makeIteratorResultObject(elem, false);
@@ -13368,7 +13719,7 @@ GCPtr<Environment> Environment::createGlobal() {
     sizeGetter->properties["__uses_this_arg__"] = Value(true);
     sizeGetter->nativeFunc = [validateSetThis](const std::vector<Value>& args) -> Value {
       auto s = validateSetThis(args, "size");
-      return Value(static_cast<double>(s->values.size()));
+      return Value(static_cast<double>(s->size()));
     };
     sizeGetter->properties["name"] = Value(std::string("get size"));
     sizeGetter->properties["__non_writable_name"] = Value(true);
@@ -13410,7 +13761,7 @@ GCPtr<Environment> Environment::createGlobal() {
         throw std::runtime_error("TypeError: Cannot convert a BigInt value to a number");
       }
       if (sizeRaw.isNumber()) {
-        sizeVal = std::get<double>(sizeRaw.data);
+        sizeVal = sizeRaw.asNumber();
       } else if (sizeRaw.isObject() || sizeRaw.isArray() || sizeRaw.isFunction()) {
         Value prim = toPrimitiveFromNative(sizeRaw, false);
         if (prim.isBigInt()) {
@@ -13473,7 +13824,7 @@ GCPtr<Environment> Environment::createGlobal() {
     // If it's a Set, get values directly
     if (rec.obj.isSet()) {
       auto s = rec.obj.getGC<Set>();
-      result.keys = s->values;
+      result.keys = s->table.keys();
       return result;
     }
     // Otherwise call keys() and iterate
@@ -13537,7 +13888,7 @@ GCPtr<Environment> Environment::createGlobal() {
     if (args.size() < 2) throw std::runtime_error("TypeError: union requires an argument");
     auto rec = getSetRecord(args[1]);
     auto result = makeNewSet();
-    for (const auto& v : s->values) result->add(v);
+    for (const auto& v : s->table.keys()) result->add(v);
     auto otherKeys = setRecordKeys(rec);
     for (const auto& v : otherKeys) result->add(v);
     return Value(result);
@@ -13549,8 +13900,8 @@ GCPtr<Environment> Environment::createGlobal() {
     if (args.size() < 2) throw std::runtime_error("TypeError: intersection requires an argument");
     auto rec = getSetRecord(args[1]);
     auto result = makeNewSet();
-    if (static_cast<double>(s->values.size()) <= rec.size) {
-      for (const auto& v : s->values) {
+    if (static_cast<double>(s->size()) <= rec.size) {
+      for (const auto& v : s->table.keys()) {
         if (setRecordHas(rec, v)) result->add(v);
       }
     } else {
@@ -13568,12 +13919,12 @@ GCPtr<Environment> Environment::createGlobal() {
     if (args.size() < 2) throw std::runtime_error("TypeError: difference requires an argument");
     auto rec = getSetRecord(args[1]);
     auto result = makeNewSet();
-    if (static_cast<double>(s->values.size()) <= rec.size) {
-      for (const auto& v : s->values) {
+    if (static_cast<double>(s->size()) <= rec.size) {
+      for (const auto& v : s->table.keys()) {
         if (!setRecordHas(rec, v)) result->add(v);
       }
     } else {
-      for (const auto& v : s->values) result->add(v);
+      for (const auto& v : s->table.keys()) result->add(v);
       auto otherKeys = setRecordKeys(rec);
       for (const auto& v : otherKeys) {
         result->deleteValue(v);
@@ -13588,7 +13939,7 @@ GCPtr<Environment> Environment::createGlobal() {
     if (args.size() < 2) throw std::runtime_error("TypeError: symmetricDifference requires an argument");
     auto rec = getSetRecord(args[1]);
     auto result = makeNewSet();
-    for (const auto& v : s->values) result->add(v);
+    for (const auto& v : s->table.keys()) result->add(v);
     auto otherKeys = setRecordKeys(rec);
     for (const auto& v : otherKeys) {
       if (s->has(v)) {
@@ -13605,8 +13956,8 @@ GCPtr<Environment> Environment::createGlobal() {
     auto s = validateSetThis(args, "isSubsetOf");
     if (args.size() < 2) throw std::runtime_error("TypeError: isSubsetOf requires an argument");
     auto rec = getSetRecord(args[1]);
-    if (static_cast<double>(s->values.size()) > rec.size) return Value(false);
-    for (const auto& v : s->values) {
+    if (static_cast<double>(s->size()) > rec.size) return Value(false);
+    for (const auto& v : s->table.keys()) {
       if (!setRecordHas(rec, v)) return Value(false);
     }
     return Value(true);
@@ -13618,7 +13969,7 @@ GCPtr<Environment> Environment::createGlobal() {
     if (!interp) return;
     if (rec.obj.isSet()) {
       auto s = rec.obj.getGC<Set>();
-      for (const auto& v : s->values) {
+      for (const auto& v : s->table.keys()) {
         if (fn(v)) return;
       }
       return;
@@ -13671,7 +14022,7 @@ GCPtr<Environment> Environment::createGlobal() {
     if (args.size() < 2) throw std::runtime_error("TypeError: isSupersetOf requires an argument");
     auto rec = getSetRecord(args[1]);
     // Step 3: If thisSize < otherRec.[[Size]], return false
-    if (static_cast<double>(s->values.size()) < rec.size) return Value(false);
+    if (static_cast<double>(s->size()) < rec.size) return Value(false);
     bool isSuperset = true;
     iterateSetRecordKeys(rec, [&](const Value& v) -> bool {
       if (!s->has(v)) { isSuperset = false; return true; }
@@ -13685,8 +14036,8 @@ GCPtr<Environment> Environment::createGlobal() {
     auto s = validateSetThis(args, "isDisjointFrom");
     if (args.size() < 2) throw std::runtime_error("TypeError: isDisjointFrom requires an argument");
     auto rec = getSetRecord(args[1]);
-    if (static_cast<double>(s->values.size()) <= rec.size) {
-      for (const auto& v : s->values) {
+    if (static_cast<double>(s->size()) <= rec.size) {
+      for (const auto& v : s->table.keys()) {
         if (setRecordHas(rec, v)) return Value(false);
       }
     } else {
@@ -13725,9 +14076,9 @@ GCPtr<Environment> Environment::createGlobal() {
   // Shared canBeHeldWeakly check for WeakMap/WeakSet/WeakRef
   auto canBeHeldWeakly = [&globalSymbolRegistry](const Value& v) -> bool {
     if (v.isSymbol()) {
-      const auto& sym = std::get<Symbol>(v.data);
+      const auto& sym = v.asSymbol();
       for (const auto& [key, val] : globalSymbolRegistry) {
-        if (val.isSymbol() && std::get<Symbol>(val.data).id == sym.id) {
+        if (val.isSymbol() && val.asSymbol().id == sym.id) {
           return false;
         }
       }
@@ -13937,9 +14288,9 @@ GCPtr<Environment> Environment::createGlobal() {
   env->define("WeakMap", Value(weakMapConstructor));
   // Mark as non-enumerable on globalThis
   {
-    auto it = env->bindings_.find("globalThis");
-    if (it != env->bindings_.end() && it->second.isObject()) {
-      auto gobj = it->second.getGC<Object>();
+    auto* globalThisValue = env->findBinding("globalThis");
+    if (globalThisValue && globalThisValue->isObject()) {
+      auto gobj = globalThisValue->getGC<Object>();
       gobj->properties["__non_enum_WeakMap"] = Value(true);
     }
   }
@@ -14076,9 +14427,9 @@ GCPtr<Environment> Environment::createGlobal() {
   }
   env->define("WeakSet", Value(weakSetConstructor));
   {
-    auto it = env->bindings_.find("globalThis");
-    if (it != env->bindings_.end() && it->second.isObject()) {
-      auto gobj = it->second.getGC<Object>();
+    auto* globalThisValue = env->findBinding("globalThis");
+    if (globalThisValue && globalThisValue->isObject()) {
+      auto gobj = globalThisValue->getGC<Object>();
       gobj->properties["__non_enum_WeakSet"] = Value(true);
     }
   }
@@ -14098,9 +14449,9 @@ GCPtr<Environment> Environment::createGlobal() {
     auto canBeHeldWeakly = [&globalSymbolRegistry](const Value& v) -> bool {
       if (v.isSymbol()) {
         // Registered symbols (from Symbol.for) can't be held weakly
-        const auto& sym = std::get<Symbol>(v.data);
+        const auto& sym = v.asSymbol();
         for (const auto& [key, val] : globalSymbolRegistry) {
-          if (val.isSymbol() && std::get<Symbol>(val.data).id == sym.id) {
+          if (val.isSymbol() && val.asSymbol().id == sym.id) {
             return false;
           }
         }
@@ -14200,9 +14551,9 @@ GCPtr<Environment> Environment::createGlobal() {
     auto canBeHeldWeakly = [&globalSymbolRegistry](const Value& v) -> bool {
       if (v.isSymbol()) {
         // Registered symbols (from Symbol.for) can't be held weakly
-        const auto& sym = std::get<Symbol>(v.data);
+        const auto& sym = v.asSymbol();
         for (const auto& [key, val] : globalSymbolRegistry) {
-          if (val.isSymbol() && std::get<Symbol>(val.data).id == sym.id) {
+          if (val.isSymbol() && val.asSymbol().id == sym.id) {
             return false;
           }
         }
@@ -14239,7 +14590,7 @@ GCPtr<Environment> Environment::createGlobal() {
         const auto& target = args[1];
         const auto& held = args[2];
         if (target.isSymbol() && held.isSymbol()) {
-          same = std::get<Symbol>(target.data).id == std::get<Symbol>(held.data).id;
+          same = target.asSymbol().id == held.asSymbol().id;
         } else if (target.isObject() && held.isObject()) {
           same = target.getGC<Object>().get() == held.getGC<Object>().get();
         } else if (target.isArray() && held.isArray()) {
@@ -14270,7 +14621,7 @@ GCPtr<Environment> Environment::createGlobal() {
         if (!unregisterToken.isUndefined()) {
           entry->properties["unregisterToken"] = unregisterToken;
         }
-        cells->elements.push_back(Value(entry));
+        cells->pushElement(Value(entry));
       }
       return Value(Undefined{});
     };
@@ -14304,7 +14655,7 @@ GCPtr<Environment> Environment::createGlobal() {
         std::vector<Value> remaining;
         auto sameValue = [](const Value& a, const Value& b) -> bool {
           if (a.isSymbol() && b.isSymbol()) {
-            return std::get<Symbol>(a.data).id == std::get<Symbol>(b.data).id;
+            return a.asSymbol().id == b.asSymbol().id;
           }
           if (a.isObject() && b.isObject()) return a.getGC<Object>().get() == b.getGC<Object>().get();
           if (a.isArray() && b.isArray()) return a.getGC<Array>().get() == b.getGC<Array>().get();
@@ -14313,7 +14664,7 @@ GCPtr<Environment> Environment::createGlobal() {
           if (a.isSet() && b.isSet()) return a.getGC<Set>().get() == b.getGC<Set>().get();
           return false;
         };
-        for (auto& cell : cells->elements) {
+        for (auto& cell : cells->elements()) {
           if (cell.isObject()) {
             auto entry = cell.getGC<Object>();
             auto tokenIt = entry->properties.find("unregisterToken");
@@ -14324,7 +14675,7 @@ GCPtr<Environment> Environment::createGlobal() {
           }
           remaining.push_back(cell);
         }
-        cells->elements = remaining;
+        cells->assignElements(remaining);
       }
       return Value(removed);
     };
@@ -14557,8 +14908,12 @@ GCPtr<Environment> Environment::createGlobal() {
     }
     return false;
   };
-  std::function<ReflectOwnPropertyDescriptor(const Value&, const Value&)> getReflectOwnDescriptor =
-    [&](const Value& objectValue, const Value& keyValue) -> ReflectOwnPropertyDescriptor {
+  // Heap-owned recursion: Reflect.set keeps these after this setup scope ends.
+  auto getReflectOwnDescriptor =
+    std::make_shared<std::function<ReflectOwnPropertyDescriptor(const Value&, const Value&)>>();
+  *getReflectOwnDescriptor =
+    [getReflectOwnDescriptor, callObjectStatic](const Value& objectValue,
+                                                const Value& keyValue) -> ReflectOwnPropertyDescriptor {
     ReflectOwnPropertyDescriptor desc;
     if (objectValue.isProxy()) {
       auto proxy = objectValue.getGC<Proxy>();
@@ -14602,7 +14957,7 @@ GCPtr<Environment> Environment::createGlobal() {
         }
       }
       if (proxy && proxy->target) {
-        return getReflectOwnDescriptor(*proxy->target, keyValue);
+        return (*getReflectOwnDescriptor)(*proxy->target, keyValue);
       }
     }
     Value descriptor = callObjectStatic("getOwnPropertyDescriptor", {objectValue, keyValue});
@@ -14632,11 +14987,13 @@ GCPtr<Environment> Environment::createGlobal() {
     Value result = callObjectStatic("isExtensible", {target});
     return result.toBool();
   };
-  std::function<bool(const Value&, const std::string&, const Value&, bool)> putReflectOwnDataProperty =
-    [&](const Value& target,
-        const std::string& key,
-        const Value& value,
-        bool allowCreate) -> bool {
+  auto putReflectOwnDataProperty =
+    std::make_shared<std::function<bool(const Value&, const std::string&, const Value&, bool)>>();
+  *putReflectOwnDataProperty =
+    [putReflectOwnDataProperty](const Value& target,
+                                const std::string& key,
+                                const Value& value,
+                                bool allowCreate) -> bool {
     if (target.isProxy()) {
       auto proxy = target.getGC<Proxy>();
       if (proxy && proxy->handler && proxy->handler->isObject()) {
@@ -14668,7 +15025,7 @@ GCPtr<Environment> Environment::createGlobal() {
         }
       }
       if (proxy && proxy->target) {
-        return putReflectOwnDataProperty(*proxy->target, key, value, allowCreate);
+        return (*putReflectOwnDataProperty)(*proxy->target, key, value, allowCreate);
       }
       return false;
     }
@@ -14708,16 +15065,16 @@ GCPtr<Environment> Environment::createGlobal() {
       }
       size_t index = 0;
       if (parseArrayIndexKey(key, index)) {
-        if (!allowCreate && index >= arr->elements.size()) {
+        if (!allowCreate && index >= arr->elementCount()) {
           return false;
         }
-        if (index >= arr->elements.size()) {
+        if (index >= arr->elementCount()) {
           if (arr->properties.find("__non_writable_length") != arr->properties.end()) {
             return false;
           }
-          arr->elements.resize(index + 1, Value(Undefined{}));
+          arr->elements().resize(index + 1, Value(Undefined{}));
         }
-        arr->elements[index] = value;
+        arr->setElement(index, value);
         arr->properties.erase("__hole_" + key + "__");
         return true;
       }
@@ -14824,8 +15181,8 @@ GCPtr<Environment> Environment::createGlobal() {
         return false;
       }
       size_t index = 0;
-      if (parseArrayIndexKey(key, index) && index < arr->elements.size()) {
-        arr->elements[index] = Value(Undefined{});
+      if (parseArrayIndexKey(key, index) && index < arr->elementCount()) {
+        arr->setElement(index, Value(Undefined{}));
         arr->properties["__hole_" + key + "__"] = Value(true);
       }
       eraseBag(arr->properties);
@@ -15050,7 +15407,7 @@ GCPtr<Environment> Environment::createGlobal() {
         return false;
       }
 
-      ReflectOwnPropertyDescriptor ownDesc = getReflectOwnDescriptor(currentTarget, keyValue);
+      ReflectOwnPropertyDescriptor ownDesc = (*getReflectOwnDescriptor)(currentTarget, keyValue);
       if (!ownDesc.exists) {
         auto parent = getPrototypeValue(currentTarget);
         if (parent.has_value() && !parent->isNull() && !parent->isUndefined() &&
@@ -15085,18 +15442,18 @@ GCPtr<Environment> Environment::createGlobal() {
         return false;
       }
 
-      ReflectOwnPropertyDescriptor receiverDesc = getReflectOwnDescriptor(currentReceiver, keyValue);
+      ReflectOwnPropertyDescriptor receiverDesc = (*getReflectOwnDescriptor)(currentReceiver, keyValue);
       if (receiverDesc.exists) {
         if (receiverDesc.isAccessor || !receiverDesc.writable) {
           return false;
         }
-        return putReflectOwnDataProperty(currentReceiver, key, setValue, false);
+        return (*putReflectOwnDataProperty)(currentReceiver, key, setValue, false);
       }
 
       if (!isReflectExtensible(currentReceiver)) {
         return false;
       }
-      return putReflectOwnDataProperty(currentReceiver, key, setValue, true);
+      return (*putReflectOwnDataProperty)(currentReceiver, key, setValue, true);
     };
 
     return Value(ordinaryReflectSet(target, prop, value, receiver));
@@ -15180,7 +15537,7 @@ GCPtr<Environment> Environment::createGlobal() {
       throw std::runtime_error("TypeError: CreateListFromArrayLike called on non-object");
     }
     if (argArray.isArray()) {
-      callArgs = argArray.getGC<Array>()->elements;
+      callArgs = argArray.getGC<Array>()->elements();
     } else {
       auto* interp = getGlobalInterpreter();
       if (!interp) {
@@ -15247,7 +15604,7 @@ GCPtr<Environment> Environment::createGlobal() {
     std::vector<Value> callArgs;
     if (args[1].isArray()) {
       auto arr = args[1].getGC<Array>();
-      callArgs = arr->elements;
+      callArgs = arr->elements();
     }
 
     if (func->isNative) {
@@ -15476,14 +15833,14 @@ GCPtr<Environment> Environment::createGlobal() {
     auto result = makeArrayWithPrototype();
     Value names = callObjectStatic("getOwnPropertyNames", {args[0]});
     if (names.isArray()) {
-      for (const auto& element : names.getGC<Array>()->elements) {
-        result->elements.push_back(element);
+      for (const auto& element : names.getGC<Array>()->elements()) {
+        result->pushElement(element);
       }
     }
     Value symbols = callObjectStatic("getOwnPropertySymbols", {args[0]});
     if (symbols.isArray()) {
-      for (const auto& element : symbols.getGC<Array>()->elements) {
-        result->elements.push_back(element);
+      for (const auto& element : symbols.getGC<Array>()->elements()) {
+        result->pushElement(element);
       }
     }
     return Value(result);
@@ -15781,7 +16138,7 @@ GCPtr<Environment> Environment::createGlobal() {
   isNaNFn->isNative = true;
   isNaNFn->nativeFunc = [](const std::vector<Value>& args) -> Value {
     if (args.empty() || !args[0].isNumber()) return Value(false);
-    double num = std::get<double>(args[0].data);
+    double num = args[0].asNumber();
     return Value(std::isnan(num));
   };
   isNaNFn->properties["name"] = Value(std::string("isNaN"));
@@ -15794,7 +16151,7 @@ GCPtr<Environment> Environment::createGlobal() {
   isFiniteFn->isNative = true;
   isFiniteFn->nativeFunc = [](const std::vector<Value>& args) -> Value {
     if (args.empty() || !args[0].isNumber()) return Value(false);
-    double num = std::get<double>(args[0].data);
+    double num = args[0].asNumber();
     return Value(std::isfinite(num));
   };
   isFiniteFn->properties["name"] = Value(std::string("isFinite"));
@@ -15807,7 +16164,7 @@ GCPtr<Environment> Environment::createGlobal() {
   isIntegerFn->isNative = true;
   isIntegerFn->nativeFunc = [](const std::vector<Value>& args) -> Value {
     if (args.empty() || !args[0].isNumber()) return Value(false);
-    double num = std::get<double>(args[0].data);
+    double num = args[0].asNumber();
     return Value(std::isfinite(num) && std::floor(num) == num);
   };
   isIntegerFn->properties["name"] = Value(std::string("isInteger"));
@@ -15820,7 +16177,7 @@ GCPtr<Environment> Environment::createGlobal() {
   isSafeIntegerFn->isNative = true;
   isSafeIntegerFn->nativeFunc = [](const std::vector<Value>& args) -> Value {
     if (args.empty() || !args[0].isNumber()) return Value(false);
-    double num = std::get<double>(args[0].data);
+    double num = args[0].asNumber();
     const double MAX_SAFE_INTEGER = 9007199254740991.0;
     return Value(std::isfinite(num) && std::floor(num) == num &&
                  num >= -MAX_SAFE_INTEGER && num <= MAX_SAFE_INTEGER);
@@ -16415,7 +16772,8 @@ GCPtr<Environment> Environment::createGlobal() {
   arrayConstructorFn->isConstructor = true;
   arrayConstructorFn->properties["name"] = Value(std::string("Array"));
   arrayConstructorFn->properties["length"] = Value(1.0);
-  arrayConstructorFn->nativeFunc = [](const std::vector<Value>& args) -> Value {
+  setFastNative(*arrayConstructorFn, [](const Value&, std::span<const Value> args, Interpreter&,
+                                         NativeThrow& thrown) -> Value {
     auto result = GarbageCollector::makeGC<Array>();
     GarbageCollector::instance().reportAllocation(sizeof(Array));
 
@@ -16426,10 +16784,10 @@ GCPtr<Environment> Environment::createGlobal() {
     if (args.size() == 1 && args[0].isNumber()) {
       double lengthNum = args[0].toNumber();
       if (!std::isfinite(lengthNum) || lengthNum < 0 || std::floor(lengthNum) != lengthNum) {
-        throw std::runtime_error("RangeError: Invalid array length");
+        return thrown.error(ErrorType::RangeError, "Invalid array length");
       }
       size_t len = static_cast<size_t>(lengthNum);
-      result->elements.resize(len, Value(Undefined{}));
+      result->resizeElements(len);
       // Mark all indices as holes (never-assigned)
       for (size_t i = 0; i < len; i++) {
         result->properties["__hole_" + std::to_string(i) + "__"] = Value(true);
@@ -16437,9 +16795,9 @@ GCPtr<Environment> Environment::createGlobal() {
       return Value(result);
     }
 
-    result->elements = args;
+    result->assignElements(std::vector<Value>(args.begin(), args.end()));
     return Value(result);
-  };
+  }, false);
 
   auto arrayConstructorObj = GarbageCollector::makeGC<Object>();
   GarbageCollector::instance().reportAllocation(sizeof(Object));
@@ -16478,49 +16836,53 @@ GCPtr<Environment> Environment::createGlobal() {
   env->define("__array_prototype__", Value(arrayPrototype));
   setGlobalArrayPrototype(Value(arrayPrototype));
 
+  // Array.prototype builtins take `this` separately and run on the calling
+  // interpreter (FastNativeFunction), so a call allocates no argument vector.
+  auto installArrayMethod = [&](const std::string& name, int length, FastNativeFunction impl) {
+    auto fn = GarbageCollector::makeGC<Function>();
+    setFastNative(*fn, impl, true);
+    fn->properties["name"] = Value(name);
+    fn->properties["length"] = Value(static_cast<double>(length));
+    fn->properties["__non_writable_name"] = Value(true);
+    fn->properties["__non_enum_name"] = Value(true);
+    fn->properties["__non_writable_length"] = Value(true);
+    fn->properties["__non_enum_length"] = Value(true);
+    arrayPrototype->properties[name] = Value(fn);
+    arrayPrototype->properties["__non_enum_" + name] = Value(true);
+  };
+
   // Array.prototype.push - generic (works with array-like objects)
-  auto arrayProtoPush = GarbageCollector::makeGC<Function>();
-  arrayProtoPush->isNative = true;
-  arrayProtoPush->properties["__uses_this_arg__"] = Value(true);
-  arrayProtoPush->properties["name"] = Value(std::string("push"));
-  arrayProtoPush->properties["length"] = Value(1.0);
-  arrayProtoPush->nativeFunc = [](const std::vector<Value>& args) -> Value {
-    if (args.empty()) {
-      throw std::runtime_error("TypeError: Array.prototype.push called on null or undefined");
-    }
-    Value thisVal = args[0];
+  installArrayMethod("push", 1, [](const Value& thisVal, std::span<const Value> args, Interpreter& interp,
+                                   NativeThrow& thrown) -> Value {
     if (thisVal.isNull() || thisVal.isUndefined()) {
-      throw std::runtime_error("TypeError: Array.prototype.push called on null or undefined");
+      return thrown.error(ErrorType::TypeError, "Array.prototype.push called on null or undefined");
     }
     if (thisVal.isString()) {
-      throw std::runtime_error("TypeError: Cannot assign to read only property 'length' of string");
+      return thrown.error(ErrorType::TypeError, "Cannot assign to read only property 'length' of string");
     }
     if (thisVal.isArray()) {
       auto arr = thisVal.getGC<Array>();
       if (arr->properties.count("__non_writable_length")) {
-        throw std::runtime_error("TypeError: Cannot assign to read only property 'length'");
+        return thrown.error(ErrorType::TypeError, "Cannot assign to read only property 'length'");
       }
-      for (size_t i = 1; i < args.size(); ++i) {
-        arr->elements.push_back(args[i]);
+      for (const Value& arg : args) {
+        arr->pushElement(arg);
       }
-      return Value(static_cast<double>(arr->elements.size()));
+      return Value(static_cast<double>(arr->elementCount()));
     }
     // Generic object: get length, set properties, update length
-    Interpreter* interp = getGlobalInterpreter();
     size_t len = 0;
-    if (interp) {
-      auto [found, lenVal] = interp->getPropertyForExternal(thisVal, "length");
-      if (found) {
-        double d = lenVal.toNumber();
-        if (!std::isnan(d) && d >= 0) len = static_cast<size_t>(d);
-      }
+    auto [found, lenVal] = interp.getPropertyForExternal(thisVal, "length");
+    if (found) {
+      double d = lenVal.toNumber();
+      if (!std::isnan(d) && d >= 0) len = static_cast<size_t>(d);
     }
     // Set each argument at increasing indices
-    for (size_t i = 1; i < args.size(); ++i) {
+    for (const Value& arg : args) {
       if (thisVal.isObject()) {
-        thisVal.getGC<Object>()->properties[std::to_string(len)] = args[i];
+        thisVal.getGC<Object>()->properties[std::to_string(len)] = arg;
       } else if (thisVal.isFunction()) {
-        thisVal.getGC<Function>()->properties[std::to_string(len)] = args[i];
+        thisVal.getGC<Function>()->properties[std::to_string(len)] = arg;
       }
       len++;
     }
@@ -16531,284 +16893,227 @@ GCPtr<Environment> Environment::createGlobal() {
       thisVal.getGC<Function>()->properties["length"] = newLen;
     }
     return newLen;
-  };
-  arrayProtoPush->properties["__non_writable_name"] = Value(true);
-  arrayProtoPush->properties["__non_enum_name"] = Value(true);
-  arrayProtoPush->properties["__non_writable_length"] = Value(true);
-  arrayProtoPush->properties["__non_enum_length"] = Value(true);
-  arrayPrototype->properties["push"] = Value(arrayProtoPush);
-  arrayPrototype->properties["__non_enum_push"] = Value(true);
+  });
 
   // Array.prototype.join
-  auto arrayProtoJoin = GarbageCollector::makeGC<Function>();
-  arrayProtoJoin->isNative = true;
-  arrayProtoJoin->properties["__uses_this_arg__"] = Value(true);
-  arrayProtoJoin->properties["name"] = Value(std::string("join"));
-  arrayProtoJoin->properties["length"] = Value(1.0);
-
-  arrayProtoJoin->properties["__non_writable_name"] = Value(true);
-  arrayProtoJoin->properties["__non_enum_name"] = Value(true);
-  arrayProtoJoin->properties["__non_writable_length"] = Value(true);
-  arrayProtoJoin->properties["__non_enum_length"] = Value(true);
-  arrayProtoJoin->nativeFunc = [toPrimitive](const std::vector<Value>& args) -> Value {
-    auto toStringForJoin = [toPrimitive](const Value& input) -> std::string {
-      Value primitive = isObjectLikeValue(input) ? toPrimitive(input, true) : input;
+  installArrayMethod("join", 1, [](const Value& thisVal, std::span<const Value> args, Interpreter& interp,
+                                   NativeThrow& thrown) -> Value {
+    // ToString of one element; false once `thrown` is set
+    auto appendJoined = [&](std::string& out, const Value& input) -> bool {
+      Value primitive = input;
+      if (isObjectLikeValue(input)) {
+        primitive = interp.toPrimitive(input, true);
+        if (takeInterpreterError(interp, thrown)) return false;
+      }
       if (primitive.isSymbol()) {
-        throw std::runtime_error("TypeError: Cannot convert Symbol to string");
+        thrown.error(ErrorType::TypeError, "Cannot convert Symbol to string");
+        return false;
       }
-      return primitive.toString();
+      out += primitive.toString();
+      return true;
     };
 
-    if (args.empty() || (args[0].isNull() || args[0].isUndefined())) {
-      throw std::runtime_error("TypeError: Array.prototype.join called on null or undefined");
+    if (thisVal.isNull() || thisVal.isUndefined()) {
+      return thrown.error(ErrorType::TypeError, "Array.prototype.join called on null or undefined");
+    }
+    std::string separator = ",";
+    if (!args.empty() && !args[0].isUndefined()) {
+      separator.clear();
+      if (!appendJoined(separator, args[0])) return Value(Undefined{});
     }
-    Value thisVal = args[0];
-    std::string separator = args.size() > 1 && !args[1].isUndefined() ? toStringForJoin(args[1]) : ",";
     std::string result;
     if (thisVal.isArray()) {
       auto arr = thisVal.getGC<Array>();
-      for (size_t i = 0; i < arr->elements.size(); ++i) {
+      for (size_t i = 0; i < arr->elementCount(); ++i) {
         if (i > 0) result += separator;
-        if (!arr->elements[i].isUndefined() && !arr->elements[i].isNull()) {
-          result += toStringForJoin(arr->elements[i]);
-        }
-      }
-    } else {
-      // Generic: read .length, iterate
-      Interpreter* interp = getGlobalInterpreter();
-      size_t len = 0;
-      if (interp) {
-        auto [found, lenVal] = interp->getPropertyForExternal(thisVal, "length");
-        if (found) {
-          double d = lenVal.toNumber();
-          if (!std::isnan(d) && d >= 0) len = static_cast<size_t>(d);
+        Value elem = arr->element(i);
+        if (!elem.isUndefined() && !elem.isNull() && !appendJoined(result, elem)) {
+          return Value(Undefined{});
         }
       }
-      for (size_t i = 0; i < len; ++i) {
-        if (i > 0) result += separator;
-        if (interp) {
-          auto [found, elem] = interp->getPropertyForExternal(thisVal, std::to_string(i));
-          if (found && !elem.isUndefined() && !elem.isNull()) {
-            result += toStringForJoin(elem);
-          }
-        }
+      return Value(result);
+    }
+    // Generic: read .length, iterate
+    size_t len = 0;
+    auto [found, lenVal] = interp.getPropertyForExternal(thisVal, "length");
+    if (found) {
+      double d = lenVal.toNumber();
+      if (!std::isnan(d) && d >= 0) len = static_cast<size_t>(d);
+    }
+    for (size_t i = 0; i < len; ++i) {
+      if (i > 0) result += separator;
+      auto [foundElem, elem] = interp.getPropertyForExternal(thisVal, std::to_string(i));
+      if (foundElem && !elem.isUndefined() && !elem.isNull() && !appendJoined(result, elem)) {
+        return Value(Undefined{});
       }
     }
     return Value(result);
-  };
-  arrayPrototype->properties["join"] = Value(arrayProtoJoin);
-  arrayPrototype->properties["__non_enum_join"] = Value(true);
-
-  auto arrayProtoReverse = GarbageCollector::makeGC<Function>();
-  arrayProtoReverse->isNative = true;
-  arrayProtoReverse->properties["__uses_this_arg__"] = Value(true);
-  arrayProtoReverse->properties["name"] = Value(std::string("reverse"));
-  arrayProtoReverse->properties["length"] = Value(0.0);
-
-  arrayProtoReverse->properties["__non_writable_name"] = Value(true);
-  arrayProtoReverse->properties["__non_enum_name"] = Value(true);
-  arrayProtoReverse->properties["__non_writable_length"] = Value(true);
-  arrayProtoReverse->properties["__non_enum_length"] = Value(true);
-  arrayProtoReverse->nativeFunc = [](const std::vector<Value>& args) -> Value {
-    if (args.empty() || args[0].isNull() || args[0].isUndefined()) {
-      throw std::runtime_error("TypeError: Array.prototype.reverse called on null or undefined");
+  });
+
+  installArrayMethod("reverse", 0, [](const Value& thisVal, std::span<const Value>, Interpreter& interp,
+                                      NativeThrow& thrown) -> Value {
+    if (thisVal.isNull() || thisVal.isUndefined()) {
+      return thrown.error(ErrorType::TypeError, "Array.prototype.reverse called on null or undefined");
     }
-    if (!args[0].isArray()) {
-      // Generic object: reverse by swapping properties
-      Interpreter* interp = getGlobalInterpreter();
-      if (interp && args[0].isObject()) {
-        auto obj = args[0].getGC<Object>();
-        auto [found, lenVal] = interp->getPropertyForExternal(args[0], "length");
-        if (found) {
-          size_t len = static_cast<size_t>(lenVal.toNumber());
-          for (size_t i = 0; i < len / 2; ++i) {
-            size_t j = len - 1 - i;
-            std::string ki = std::to_string(i), kj = std::to_string(j);
-            bool hasI = obj->properties.count(ki) > 0;
-            bool hasJ = obj->properties.count(kj) > 0;
-            if (hasI && hasJ) {
-              std::swap(obj->properties[ki], obj->properties[kj]);
-            } else if (hasI) {
-              obj->properties[kj] = obj->properties[ki];
-              obj->properties.erase(ki);
-            } else if (hasJ) {
-              obj->properties[ki] = obj->properties[kj];
-              obj->properties.erase(kj);
-            }
+    if (thisVal.isArray()) {
+      thisVal.getGC<Array>()->reverseElements();
+      return thisVal;
+    }
+    // Generic object: reverse by swapping properties
+    if (thisVal.isObject()) {
+      auto obj = thisVal.getGC<Object>();
+      auto [found, lenVal] = interp.getPropertyForExternal(thisVal, "length");
+      if (found) {
+        size_t len = static_cast<size_t>(lenVal.toNumber());
+        for (size_t i = 0; i < len / 2; ++i) {
+          size_t j = len - 1 - i;
+          std::string ki = std::to_string(i), kj = std::to_string(j);
+          bool hasI = obj->properties.count(ki) > 0;
+          bool hasJ = obj->properties.count(kj) > 0;
+          if (hasI && hasJ) {
+            std::swap(obj->properties[ki], obj->properties[kj]);
+          } else if (hasI) {
+            obj->properties[kj] = obj->properties[ki];
+            obj->properties.erase(ki);
+          } else if (hasJ) {
+            obj->properties[ki] = obj->properties[kj];
+            obj->properties.erase(kj);
           }
         }
       }
-      return args[0];
     }
-    auto arr = args[0].getGC<Array>();
-    std::reverse(arr->elements.begin(), arr->elements.end());
-    return args[0];
-  };
-  arrayPrototype->properties["reverse"] = Value(arrayProtoReverse);
-  arrayPrototype->properties["__non_enum_reverse"] = Value(true);
-
-  auto arrayProtoSort = GarbageCollector::makeGC<Function>();
-  arrayProtoSort->isNative = true;
-  arrayProtoSort->properties["__uses_this_arg__"] = Value(true);
-  arrayProtoSort->properties["name"] = Value(std::string("sort"));
-  arrayProtoSort->properties["length"] = Value(1.0);
-
-  arrayProtoSort->properties["__non_writable_name"] = Value(true);
-  arrayProtoSort->properties["__non_enum_name"] = Value(true);
-  arrayProtoSort->properties["__non_writable_length"] = Value(true);
-  arrayProtoSort->properties["__non_enum_length"] = Value(true);
-  arrayProtoSort->nativeFunc = [toPrimitive](const std::vector<Value>& args) -> Value {
-    if (args.empty() || args[0].isNull() || args[0].isUndefined()) {
-      throw std::runtime_error("TypeError: Array.prototype.sort called on null or undefined");
+    return thisVal;
+  });
+
+  installArrayMethod("sort", 1, [](const Value& thisVal, std::span<const Value> args, Interpreter& interp,
+                                   NativeThrow& thrown) -> Value {
+    if (thisVal.isNull() || thisVal.isUndefined()) {
+      return thrown.error(ErrorType::TypeError, "Array.prototype.sort called on null or undefined");
     }
 
-    Value compareFn = args.size() > 1 ? args[1] : Value(Undefined{});
+    Value compareFn = args.empty() ? Value(Undefined{}) : args[0];
     // Step 1: Validate comparefn before anything else
     if (!compareFn.isUndefined() && !compareFn.isFunction()) {
-      throw std::runtime_error("TypeError: Array.prototype.sort comparator must be a function or undefined");
+      return thrown.error(ErrorType::TypeError, "Array.prototype.sort comparator must be a function or undefined");
     }
 
-    Value thisVal = args[0];
-    Interpreter* interpreter = getGlobalInterpreter();
-
     // Get length
     size_t len = 0;
-    if (interpreter) {
-      auto [found, lenVal] = interpreter->getPropertyForExternal(thisVal, "length");
-      if (found) {
-        double d = lenVal.toNumber();
-        if (!std::isnan(d) && d >= 0) len = static_cast<size_t>(d);
-      }
+    auto [found, lenVal] = interp.getPropertyForExternal(thisVal, "length");
+    if (found) {
+      double d = lenVal.toNumber();
+      if (!std::isnan(d) && d >= 0) len = static_cast<size_t>(d);
     }
     if (len <= 1) return thisVal;
 
     // Collect elements using [[Get]]
     std::vector<std::pair<size_t, Value>> items;
     for (size_t i = 0; i < len; i++) {
-      auto [found, val] = interpreter->getPropertyForExternal(thisVal, std::to_string(i));
-      if (interpreter->hasError()) { Value err = interpreter->getError(); interpreter->clearError(); throw JsValueException(err); }
-      if (found) {
+      auto [exists, val] = arrayLikeElement(thisVal, i, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
+      if (exists) {
         items.push_back({i, val});
       }
     }
 
-    auto elementToString = [toPrimitive](const Value& value) -> std::string {
+    // The comparator cannot stop std::stable_sort; once something throws,
+    // the remaining comparisons are no-ops and the error is reported after.
+    auto elementToString = [&](const Value& value) -> std::string {
       if (value.isUndefined()) return std::string("undefined");
-      Value primitive = isObjectLikeValue(value) ? toPrimitive(value, true) : value;
+      Value primitive = value;
+      if (isObjectLikeValue(value)) {
+        primitive = interp.toPrimitive(value, true);
+        if (takeInterpreterError(interp, thrown)) return std::string();
+      }
       if (primitive.isSymbol()) {
-        throw std::runtime_error("TypeError: Cannot convert Symbol to string");
+        thrown.error(ErrorType::TypeError, "Cannot convert Symbol to string");
+        return std::string();
       }
       return primitive.toString();
     };
 
     std::stable_sort(items.begin(), items.end(),
       [&](const std::pair<size_t, Value>& lhs, const std::pair<size_t, Value>& rhs) {
+        if (thrown.pending) return false;
         // Undefined sorts to end
         if (lhs.second.isUndefined() && rhs.second.isUndefined()) return false;
         if (lhs.second.isUndefined()) return false;
         if (rhs.second.isUndefined()) return true;
         if (compareFn.isFunction()) {
-          if (!interpreter) return false;
-          Value result = interpreter->callForHarness(compareFn, {lhs.second, rhs.second}, Value(Undefined{}));
-          if (interpreter->hasError()) {
-            Value err = interpreter->getError();
-            interpreter->clearError();
-            throw JsValueException(err);
-          }
+          Value result = callArrayCallback(compareFn, {lhs.second, rhs.second}, Value(Undefined{}), interp, thrown);
+          if (thrown.pending) return false;
           double number = result.toNumber();
           if (std::isnan(number) || number == 0.0) return false;
           return number < 0.0;
         }
-        return elementToString(lhs.second) < elementToString(rhs.second);
+        std::string lhsString = elementToString(lhs.second);
+        std::string rhsString = elementToString(rhs.second);
+        return !thrown.pending && lhsString < rhsString;
       });
+    if (thrown.pending) return Value(Undefined{});
 
     // Write sorted elements back using [[Set]]
     if (thisVal.isArray()) {
       auto arr = thisVal.getGC<Array>();
       // Fast path for arrays
       for (size_t i = 0; i < items.size(); i++) {
-        if (i < arr->elements.size()) {
-          arr->elements[i] = items[i].second;
+        if (i < arr->elementCount()) {
+          arr->setElement(i, items[i].second);
         }
       }
       // Delete excess elements (holes after sorted items)
-      for (size_t i = items.size(); i < len && i < arr->elements.size(); i++) {
-        arr->elements[i] = Value(Undefined{});
+      for (size_t i = items.size(); i < len && i < arr->elementCount(); i++) {
+        arr->setElement(i, Value(Undefined{}));
         arr->properties["__hole_" + std::to_string(i) + "__"] = Value(true);
       }
-    } else if (interpreter) {
-      // Generic: write back via [[Set]]
+    } else if (thisVal.isObject()) {
+      // Generic: write back via direct property set, then delete the rest
+      auto obj = thisVal.getGC<Object>();
       for (size_t i = 0; i < items.size(); i++) {
-        interpreter->callForHarness(Value(Undefined{}), {}, Value(Undefined{})); // dummy to check
-        // Use direct property set for objects
-        if (thisVal.isObject()) {
-          thisVal.getGC<Object>()->properties[std::to_string(i)] = items[i].second;
-        }
+        obj->properties[std::to_string(i)] = items[i].second;
       }
-      // Delete remaining indices
       for (size_t i = items.size(); i < len; i++) {
-        if (thisVal.isObject()) {
-          thisVal.getGC<Object>()->properties.erase(std::to_string(i));
-        }
+        obj->properties.erase(std::to_string(i));
       }
     }
 
     return thisVal;
-  };
-  arrayPrototype->properties["sort"] = Value(arrayProtoSort);
-  arrayPrototype->properties["__non_enum_sort"] = Value(true);
+  });
 
   // Array.prototype.toString - calls join()
-  auto arrayProtoToString = GarbageCollector::makeGC<Function>();
-  arrayProtoToString->isNative = true;
-  arrayProtoToString->properties["__uses_this_arg__"] = Value(true);
-  arrayProtoToString->properties["name"] = Value(std::string("toString"));
-  arrayProtoToString->properties["length"] = Value(0.0);
-
-  arrayProtoToString->properties["__non_writable_name"] = Value(true);
-  arrayProtoToString->properties["__non_enum_name"] = Value(true);
-  arrayProtoToString->properties["__non_writable_length"] = Value(true);
-  arrayProtoToString->properties["__non_enum_length"] = Value(true);
-  arrayProtoToString->nativeFunc = [env, callChecked](const std::vector<Value>& args) -> Value {
-    if (args.empty() || args[0].isUndefined() || args[0].isNull()) {
-      throw std::runtime_error("TypeError: Array.prototype.toString called on null or undefined");
+  installArrayMethod("toString", 0, [](const Value& thisVal, std::span<const Value>, Interpreter& interp,
+                                       NativeThrow& thrown) -> Value {
+    if (thisVal.isUndefined() || thisVal.isNull()) {
+      return thrown.error(ErrorType::TypeError, "Array.prototype.toString called on null or undefined");
     }
 
-    auto [foundJoin, join] = getPropertyLike(args[0], "join", args[0]);
+    auto [foundJoin, join] = getPropertyLike(thisVal, "join", thisVal);
+    if (takeInterpreterError(interp, thrown)) return Value(Undefined{});
     if (foundJoin && join.isFunction()) {
-      return callChecked(join, {}, args[0]);
+      return callArrayCallback(join, {}, thisVal, interp, thrown);
     }
 
-    if (auto objectProto = env->get("__object_prototype__"); objectProto.has_value()) {
+    if (auto objectProto = interp.resolveVariable("__object_prototype__")) {
       auto [foundToString, objectToString] = getPropertyLike(*objectProto, "toString", *objectProto);
+      if (takeInterpreterError(interp, thrown)) return Value(Undefined{});
       if (foundToString && objectToString.isFunction()) {
-        return callChecked(objectToString, {}, args[0]);
+        return callArrayCallback(objectToString, {}, thisVal, interp, thrown);
       }
     }
 
     return Value(std::string("[object Object]"));
-  };
-  arrayPrototype->properties["toString"] = Value(arrayProtoToString);
-  arrayPrototype->properties["__non_enum_toString"] = Value(true);
-
-  auto arrayProtoToLocaleString = GarbageCollector::makeGC<Function>();
-  arrayProtoToLocaleString->isNative = true;
-  arrayProtoToLocaleString->properties["__uses_this_arg__"] = Value(true);
-  arrayProtoToLocaleString->properties["name"] = Value(std::string("toLocaleString"));
-  arrayProtoToLocaleString->properties["length"] = Value(0.0);
+  });
+  Value arrayProtoToString = arrayPrototype->properties["toString"];
 
-  arrayProtoToLocaleString->properties["__non_writable_name"] = Value(true);
-  arrayProtoToLocaleString->properties["__non_enum_name"] = Value(true);
-  arrayProtoToLocaleString->properties["__non_writable_length"] = Value(true);
-  arrayProtoToLocaleString->properties["__non_enum_length"] = Value(true);
-  arrayProtoToLocaleString->nativeFunc = [env, toPrimitive, callChecked](const std::vector<Value>& args) -> Value {
-    if (args.empty() || !args[0].isArray()) {
-      throw std::runtime_error("TypeError: Array.prototype.toLocaleString called on non-array");
+  installArrayMethod("toLocaleString", 0, [](const Value& thisVal, std::span<const Value>, Interpreter& interp,
+                                             NativeThrow& thrown) -> Value {
+    if (!thisVal.isArray()) {
+      return thrown.error(ErrorType::TypeError, "Array.prototype.toLocaleString called on non-array");
     }
 
     auto lookupPrimitiveLocaleMethod = [&](const Value& element) -> Value {
       auto lookupFromCtor = [&](const char* ctorName) -> Value {
-        if (auto ctor = env->get(ctorName); ctor.has_value()) {
+        if (auto ctor = interp.resolveVariable(ctorName)) {
           auto [foundProto, proto] = getPropertyLike(*ctor, "prototype", element);
           if (foundProto) {
             auto [foundMethod, method] = getPropertyLike(proto, "toLocaleString", element);
@@ -16827,9 +17132,10 @@ GCPtr<Environment> Environment::createGlobal() {
       return Value(Undefined{});
     };
 
-    auto elementToLocaleString = [&](const Value& element) -> std::string {
+    // ToString(Invoke(element, "toLocaleString")); false once `thrown` is set
+    auto appendLocaleString = [&](std::string& out, const Value& element) -> bool {
       if (element.isUndefined() || element.isNull()) {
-        return std::string("");
+        return true;
       }
 
       Value method = isObjectLikeValue(element)
@@ -16838,166 +17144,73 @@ GCPtr<Environment> Environment::createGlobal() {
             return foundMethod ? value : Value(Undefined{});
           }()
         : lookupPrimitiveLocaleMethod(element);
+      if (takeInterpreterError(interp, thrown)) return false;
 
       if (!method.isFunction()) {
-        throw std::runtime_error("TypeError: undefined is not a function");
+        thrown.error(ErrorType::TypeError, "undefined is not a function");
+        return false;
       }
 
-      Value result = callChecked(method, {}, element);
-      Value primitive = isObjectLikeValue(result) ? toPrimitive(result, true) : result;
-      return primitive.toString();
-    };
+      Value result = callArrayCallback(method, {}, element, interp, thrown);
+      if (thrown.pending) return false;
+      if (isObjectLikeValue(result)) {
+        result = interp.toPrimitive(result, true);
+        if (takeInterpreterError(interp, thrown)) return false;
+      }
+      out += result.toString();
+      return true;
+    };
 
-    auto arr = args[0].getGC<Array>();
+    auto arr = thisVal.getGC<Array>();
     std::string result;
-    for (size_t i = 0; i < arr->elements.size(); ++i) {
+    for (size_t i = 0; i < arr->elementCount(); ++i) {
       if (i > 0) result += ",";
-      result += elementToLocaleString(arr->elements[i]);
+      if (!appendLocaleString(result, arr->element(i))) return Value(Undefined{});
     }
     return Value(result);
-  };
-  arrayPrototype->properties["toLocaleString"] = Value(arrayProtoToLocaleString);
-  arrayPrototype->properties["__non_enum_toLocaleString"] = Value(true);
+  });
 
   if (auto typedArrayCtor = env->get("TypedArray"); typedArrayCtor.has_value()) {
     auto [foundProto, typedArrayProto] = getPropertyLike(*typedArrayCtor, "prototype", *typedArrayCtor);
     if (foundProto && typedArrayProto.isObject()) {
       auto typedArrayPrototype = typedArrayProto.getGC<Object>();
-      typedArrayPrototype->properties["toString"] = Value(arrayProtoToString);
+      typedArrayPrototype->properties["toString"] = arrayProtoToString;
       typedArrayPrototype->properties["__non_enum_toString"] = Value(true);
     }
   }
 
-  // Array.prototype.reduce - placeholder (installed below via installArrayMethod)
-
   // Array.prototype.indexOf
-  auto arrayProtoIndexOf = GarbageCollector::makeGC<Function>();
-  arrayProtoIndexOf->isNative = true;
-  arrayProtoIndexOf->properties["__uses_this_arg__"] = Value(true);
-  arrayProtoIndexOf->properties["name"] = Value(std::string("indexOf"));
-  arrayProtoIndexOf->properties["length"] = Value(1.0);
-  arrayProtoIndexOf->properties["__non_writable_name"] = Value(true);
-  arrayProtoIndexOf->properties["__non_enum_name"] = Value(true);
-  arrayProtoIndexOf->properties["__non_writable_length"] = Value(true);
-  arrayProtoIndexOf->properties["__non_enum_length"] = Value(true);
-  arrayProtoIndexOf->nativeFunc = [](const std::vector<Value>& args) -> Value {
-    if (args.empty() || args[0].isUndefined() || args[0].isNull()) {
-      throw std::runtime_error("TypeError: Array.prototype.indexOf called on null or undefined");
-    }
-
-    auto strictEqual = [](const Value& lhs, const Value& rhs) -> bool {
-      if (lhs.data.index() != rhs.data.index()) return false;
-      if (lhs.isSymbol() && rhs.isSymbol()) return std::get<Symbol>(lhs.data).id == std::get<Symbol>(rhs.data).id;
-      if (lhs.isBigInt() && rhs.isBigInt()) return lhs.toBigInt() == rhs.toBigInt();
-      if (lhs.isNumber() && rhs.isNumber()) return lhs.toNumber() == rhs.toNumber();
-      if (lhs.isString() && rhs.isString()) return lhs.toString() == rhs.toString();
-      if (lhs.isBool() && rhs.isBool()) return lhs.toBool() == rhs.toBool();
-      if ((lhs.isNull() && rhs.isNull()) || (lhs.isUndefined() && rhs.isUndefined())) return true;
-      if (lhs.isObject() && rhs.isObject()) return lhs.getGC<Object>().get() == rhs.getGC<Object>().get();
-      if (lhs.isArray() && rhs.isArray()) return lhs.getGC<Array>().get() == rhs.getGC<Array>().get();
-      if (lhs.isFunction() && rhs.isFunction()) return lhs.getGC<Function>().get() == rhs.getGC<Function>().get();
-      if (lhs.isTypedArray() && rhs.isTypedArray()) return lhs.getGC<TypedArray>().get() == rhs.getGC<TypedArray>().get();
-      if (lhs.isPromise() && rhs.isPromise()) return lhs.getGC<Promise>().get() == rhs.getGC<Promise>().get();
-      if (lhs.isRegex() && rhs.isRegex()) return lhs.getGC<Regex>().get() == rhs.getGC<Regex>().get();
-      if (lhs.isMap() && rhs.isMap()) return lhs.getGC<Map>().get() == rhs.getGC<Map>().get();
-      if (lhs.isSet() && rhs.isSet()) return lhs.getGC<Set>().get() == rhs.getGC<Set>().get();
-      if (lhs.isError() && rhs.isError()) return lhs.getGC<Error>().get() == rhs.getGC<Error>().get();
-      if (lhs.isGenerator() && rhs.isGenerator()) return lhs.getGC<Generator>().get() == rhs.getGC<Generator>().get();
-      if (lhs.isProxy() && rhs.isProxy()) return lhs.getGC<Proxy>().get() == rhs.getGC<Proxy>().get();
-      if (lhs.isWeakMap() && rhs.isWeakMap()) return lhs.getGC<WeakMap>().get() == rhs.getGC<WeakMap>().get();
-      if (lhs.isWeakSet() && rhs.isWeakSet()) return lhs.getGC<WeakSet>().get() == rhs.getGC<WeakSet>().get();
-      if (lhs.isArrayBuffer() && rhs.isArrayBuffer()) return lhs.getGC<ArrayBuffer>().get() == rhs.getGC<ArrayBuffer>().get();
-      if (lhs.isDataView() && rhs.isDataView()) return lhs.getGC<DataView>().get() == rhs.getGC<DataView>().get();
-      if (lhs.isClass() && rhs.isClass()) return lhs.getGC<Class>().get() == rhs.getGC<Class>().get();
-      if (lhs.isWasmInstance() && rhs.isWasmInstance()) return lhs.getGC<WasmInstanceJS>().get() == rhs.getGC<WasmInstanceJS>().get();
-      if (lhs.isWasmMemory() && rhs.isWasmMemory()) return lhs.getGC<WasmMemoryJS>().get() == rhs.getGC<WasmMemoryJS>().get();
-      if (lhs.isReadableStream() && rhs.isReadableStream()) return lhs.getGC<ReadableStream>().get() == rhs.getGC<ReadableStream>().get();
-      if (lhs.isWritableStream() && rhs.isWritableStream()) return lhs.getGC<WritableStream>().get() == rhs.getGC<WritableStream>().get();
-      if (lhs.isTransformStream() && rhs.isTransformStream()) return lhs.getGC<TransformStream>().get() == rhs.getGC<TransformStream>().get();
-      return false;
-    };
-
-    auto toArrayLikeObject = [](const Value& input) -> Value {
-      if (isObjectLikeValue(input)) {
-        return input;
-      }
-      // Box primitives per spec ToObject
-      if (input.isBool() || input.isNumber() || input.isString() || input.isSymbol() || input.isBigInt()) {
-        auto* interp = getGlobalInterpreter();
-        if (interp) {
-          std::string ctorName;
-          if (input.isBool()) ctorName = "Boolean";
-          else if (input.isNumber()) ctorName = "Number";
-          else if (input.isString()) ctorName = "String";
-          else if (input.isSymbol()) ctorName = "Symbol";
-          else ctorName = "BigInt";
-          auto wrapper = GarbageCollector::makeGC<Object>();
-          GarbageCollector::instance().reportAllocation(sizeof(Object));
-          wrapper->properties["__primitive_value__"] = input;
-          auto ctor = interp->resolveVariable(ctorName);
-          if (ctor) {
-            auto [hasProto, proto] = interp->getPropertyForExternal(*ctor, "prototype");
-            if (hasProto && (proto.isObject() || proto.isNull())) {
-              wrapper->properties["__proto__"] = proto;
-            }
-          }
-          if (input.isString()) {
-            const std::string& str = std::get<std::string>(input.data);
-            size_t strLen = String_utf16Length(str);
-            for (size_t i = 0; i < strLen; i++) {
-              wrapper->properties[std::to_string(i)] = Value(String_utf16CodeUnitStringAt(str, i));
-            }
-            wrapper->properties["length"] = Value(static_cast<double>(strLen));
-          }
-          return Value(wrapper);
-        }
-      }
-      auto obj = GarbageCollector::makeGC<Object>();
-      GarbageCollector::instance().reportAllocation(sizeof(Object));
-      return Value(obj);
-    };
-
-    auto toLength = [](const Value& value) -> size_t {
-      double number = value.toNumber();
-      if (std::isnan(number) || number <= 0.0) {
-        return 0;
-      }
-      if (!std::isfinite(number)) {
-        return std::numeric_limits<size_t>::max();
-      }
-      double truncated = std::floor(number);
-      if (truncated >= static_cast<double>(std::numeric_limits<size_t>::max())) {
-        return std::numeric_limits<size_t>::max();
-      }
-      return static_cast<size_t>(truncated);
-    };
+  installArrayMethod("indexOf", 1, [](const Value& thisVal, std::span<const Value> args, Interpreter& interp,
+                                      NativeThrow& thrown) -> Value {
+    Value arrayLike = arrayToObject(thisVal, "indexOf", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    Value searchElement = args.empty() ? Value(Undefined{}) : args[0];
+    auto [foundLength, lengthValue] = getPropertyLike(arrayLike, "length", arrayLike);
+    if (takeInterpreterError(interp, thrown)) return Value(Undefined{});
 
-    auto toIntegerOrInfinity = [](const Value& value) -> double {
-      double number = value.toNumber();
-      if (std::isnan(number) || number == 0.0) {
-        return 0.0;
-      }
+    // ToLength
+    size_t length = 0;
+    if (foundLength) {
+      double number = lengthValue.toNumber();
       if (!std::isfinite(number)) {
-        return number;
+        length = number > 0.0 ? std::numeric_limits<size_t>::max() : 0;
+      } else if (number > 0.0) {
+        double truncated = std::floor(number);
+        length = truncated >= static_cast<double>(std::numeric_limits<size_t>::max())
+                   ? std::numeric_limits<size_t>::max()
+                   : static_cast<size_t>(truncated);
       }
-      return std::trunc(number);
-    };
-
-    Value receiver = args[0];
-    Value searchElement = args.size() > 1 ? args[1] : Value(Undefined{});
-    Value arrayLike = toArrayLikeObject(receiver);
-    auto [foundLength, lengthValue] = getPropertyLike(arrayLike, "length", arrayLike);
-    if (auto* interpreter = getGlobalInterpreter(); interpreter && interpreter->hasError()) {
-      Value err = interpreter->getError();
-      interpreter->clearError();
-      throw JsValueException(err);
     }
-    size_t length = foundLength ? toLength(lengthValue) : 0;
     if (length == 0) {
       return Value(-1.0);
     }
 
-    double fromIndex = args.size() > 2 ? toIntegerOrInfinity(args[2]) : 0.0;
+    // ToIntegerOrInfinity
+    double fromIndex = 0.0;
+    if (args.size() > 1) {
+      double number = args[1].toNumber();
+      fromIndex = std::isnan(number) ? 0.0 : (std::isfinite(number) ? std::trunc(number) : number);
+    }
     if (fromIndex == std::numeric_limits<double>::infinity()) {
       return Value(-1.0);
     }
@@ -17012,282 +17225,85 @@ GCPtr<Environment> Environment::createGlobal() {
 
     for (size_t i = start; i < length; ++i) {
       std::string key = std::to_string(i);
-      if (!hasPropertyLike(arrayLike, key)) {
-        if (auto* interpreter = getGlobalInterpreter(); interpreter && interpreter->hasError()) {
-          Value err = interpreter->getError();
-          interpreter->clearError();
-          throw JsValueException(err);
-        }
-        continue;
-      }
+      bool present = hasPropertyLike(arrayLike, key);
+      if (takeInterpreterError(interp, thrown)) return Value(Undefined{});
+      if (!present) continue;
       auto [found, element] = getPropertyLike(arrayLike, key, arrayLike);
-      if (auto* interpreter = getGlobalInterpreter(); interpreter && interpreter->hasError()) {
-        Value err = interpreter->getError();
-        interpreter->clearError();
-        throw JsValueException(err);
-      }
-      if (found && strictEqual(element, searchElement)) {
+      if (takeInterpreterError(interp, thrown)) return Value(Undefined{});
+      if (found && arrayStrictEqual(element, searchElement)) {
         return Value(static_cast<double>(i));
       }
     }
     return Value(-1.0);
-  };
-  arrayPrototype->properties["indexOf"] = Value(arrayProtoIndexOf);
-  arrayPrototype->properties["__non_enum_indexOf"] = Value(true);
-
-  // --- Generic array-like helpers for ES spec Array prototype methods ---
-  // These allow Array.prototype.map.call(obj, fn) etc. to work on any object with .length
-
-  // Strict equality for search methods
-  auto arrayStrictEqual = [](const Value& lhs, const Value& rhs) -> bool {
-    if (lhs.data.index() != rhs.data.index()) return false;
-    if (lhs.isNumber() && rhs.isNumber()) return lhs.toNumber() == rhs.toNumber();
-    if (lhs.isString() && rhs.isString()) return lhs.toString() == rhs.toString();
-    if (lhs.isBool() && rhs.isBool()) return lhs.toBool() == rhs.toBool();
-    if (lhs.isSymbol() && rhs.isSymbol()) return std::get<Symbol>(lhs.data).id == std::get<Symbol>(rhs.data).id;
-    if (lhs.isBigInt() && rhs.isBigInt()) return lhs.toBigInt() == rhs.toBigInt();
-    if ((lhs.isNull() && rhs.isNull()) || (lhs.isUndefined() && rhs.isUndefined())) return true;
-    if (lhs.isObject() && rhs.isObject()) return lhs.getGC<Object>().get() == rhs.getGC<Object>().get();
-    if (lhs.isArray() && rhs.isArray()) return lhs.getGC<Array>().get() == rhs.getGC<Array>().get();
-    if (lhs.isFunction() && rhs.isFunction()) return lhs.getGC<Function>().get() == rhs.getGC<Function>().get();
-    if (lhs.isClass() && rhs.isClass()) return lhs.getGC<Class>().get() == rhs.getGC<Class>().get();
-    if (lhs.isError() && rhs.isError()) return lhs.getGC<Error>().get() == rhs.getGC<Error>().get();
-    if (lhs.isRegex() && rhs.isRegex()) return lhs.getGC<Regex>().get() == rhs.getGC<Regex>().get();
-    if (lhs.isMap() && rhs.isMap()) return lhs.getGC<Map>().get() == rhs.getGC<Map>().get();
-    if (lhs.isSet() && rhs.isSet()) return lhs.getGC<Set>().get() == rhs.getGC<Set>().get();
-    if (lhs.isPromise() && rhs.isPromise()) return lhs.getGC<Promise>().get() == rhs.getGC<Promise>().get();
-    if (lhs.isTypedArray() && rhs.isTypedArray()) return lhs.getGC<TypedArray>().get() == rhs.getGC<TypedArray>().get();
-    if (lhs.isArrayBuffer() && rhs.isArrayBuffer()) return lhs.getGC<ArrayBuffer>().get() == rhs.getGC<ArrayBuffer>().get();
-    if (lhs.isProxy() && rhs.isProxy()) return lhs.getGC<Proxy>().get() == rhs.getGC<Proxy>().get();
-    if (lhs.isGenerator() && rhs.isGenerator()) return lhs.getGC<Generator>().get() == rhs.getGC<Generator>().get();
-    if (lhs.isWeakMap() && rhs.isWeakMap()) return lhs.getGC<WeakMap>().get() == rhs.getGC<WeakMap>().get();
-    if (lhs.isWeakSet() && rhs.isWeakSet()) return lhs.getGC<WeakSet>().get() == rhs.getGC<WeakSet>().get();
-    if (lhs.isDataView() && rhs.isDataView()) return lhs.getGC<DataView>().get() == rhs.getGC<DataView>().get();
-    return false;
-  };
-
-  // ToObject: throw TypeError on null/undefined, return this otherwise
-  auto toObjectChecked = [](const Value& thisVal, const std::string& methodName) -> Value {
-    if (thisVal.isNull() || thisVal.isUndefined()) {
-      throw std::runtime_error("TypeError: Array.prototype." + methodName + " called on null or undefined");
-    }
-    // Box primitives to wrapper objects per spec ToObject
-    if (thisVal.isBool() || thisVal.isNumber() || thisVal.isString() || thisVal.isSymbol() || thisVal.isBigInt()) {
-      auto* interp = getGlobalInterpreter();
-      if (interp) {
-        std::string ctorName;
-        if (thisVal.isBool()) ctorName = "Boolean";
-        else if (thisVal.isNumber()) ctorName = "Number";
-        else if (thisVal.isString()) ctorName = "String";
-        else if (thisVal.isSymbol()) ctorName = "Symbol";
-        else ctorName = "BigInt";
-        auto wrapper = GarbageCollector::makeGC<Object>();
-        GarbageCollector::instance().reportAllocation(sizeof(Object));
-        wrapper->properties["__primitive_value__"] = thisVal;
-        auto ctor = interp->resolveVariable(ctorName);
-        if (ctor) {
-          auto [hasProto, proto] = interp->getPropertyForExternal(*ctor, "prototype");
-          if (hasProto && (proto.isObject() || proto.isNull())) {
-            wrapper->properties["__proto__"] = proto;
-          }
-        }
-        // For String, set length and indexed properties
-        if (thisVal.isString()) {
-          const std::string& str = std::get<std::string>(thisVal.data);
-          size_t strLen = String_utf16Length(str);
-          for (size_t i = 0; i < strLen; i++) {
-            std::string idx = std::to_string(i);
-            wrapper->properties[idx] = Value(String_utf16CodeUnitStringAt(str, i));
-            wrapper->properties["__non_writable_" + idx] = Value(true);
-            wrapper->properties["__non_enum_" + idx] = Value(true);
-            wrapper->properties["__non_configurable_" + idx] = Value(true);
-          }
-          wrapper->properties["length"] = Value(static_cast<double>(strLen));
-          wrapper->properties["__non_writable_length"] = Value(true);
-          wrapper->properties["__non_enum_length"] = Value(true);
-          wrapper->properties["__non_configurable_length"] = Value(true);
-        }
-        return Value(wrapper);
-      }
-    }
-    return thisVal;
-  };
-
-  // Get length from any array-like value using [[Get]]
-  auto getArrayLikeLength = [](const Value& obj) -> size_t {
-    Interpreter* interp = getGlobalInterpreter();
-    if (!interp) return 0;
-    auto [found, lenVal] = interp->getPropertyForExternal(obj, "length");
-    if (interp->hasError()) { Value err = interp->getError(); interp->clearError(); throw JsValueException(err); }
-    if (!found) return 0;
-    double d = lenVal.toNumber();
-    if (std::isnan(d) || d < 0) return 0;
-    if (d > 4294967295.0) return 4294967295u;
-    return static_cast<size_t>(d);
-  };
-
-  // Check if index exists on array-like value using [[HasProperty]]
-  auto hasArrayLikeElement = [](const Value& obj, size_t idx) -> bool {
-    Interpreter* interp = getGlobalInterpreter();
-    if (!interp) return false;
-    auto [found, val] = interp->getPropertyForExternal(obj, std::to_string(idx));
-    if (interp->hasError()) { interp->clearError(); return false; }
-    return found;
-  };
-
-  // Get element at index from array-like value using [[Get]]
-  auto getArrayLikeElement = [](const Value& obj, size_t idx) -> std::pair<bool, Value> {
-    Interpreter* interp = getGlobalInterpreter();
-    if (!interp) return {false, Value(Undefined{})};
-    auto [found, val] = interp->getPropertyForExternal(obj, std::to_string(idx));
-    if (interp->hasError()) { Value err = interp->getError(); interp->clearError(); throw JsValueException(err); }
-    return {found, val};
-  };
-
-  // ArraySpeciesCreate per spec 9.4.2.3
-  // Creates result array using species constructor if available
-  auto arraySpeciesCreate = [](const Value& originalArray, size_t length) -> Value {
-    // Step 2: If originalArray is not an array, return ArrayCreate(length)
-    if (!originalArray.isArray()) {
-      auto result = makeArrayWithPrototype();
-      result->elements.resize(length, Value(Undefined{}));
-      for (size_t i = 0; i < length; i++) {
-        result->properties["__hole_" + std::to_string(i) + "__"] = Value(true);
-      }
-      return Value(result);
-    }
-
-    Interpreter* interp = getGlobalInterpreter();
-    if (!interp) {
-      auto result = makeArrayWithPrototype();
-      return Value(result);
-    }
-
-    // Step 5: Let C = Get(originalArray, "constructor")
-    auto [hasCtor, ctorVal] = interp->getPropertyForExternal(originalArray, "constructor");
-    if (interp->hasError()) { Value err = interp->getError(); interp->clearError(); throw JsValueException(err); }
-
-    if (hasCtor && !ctorVal.isUndefined()) {
-      // Step 6: If IsConstructor(C), check cross-realm (skip for now)
-
-      // Step 7: If C is an Object, get @@species
-      if (isObjectLikeValue(ctorVal)) {
-        auto [hasSpecies, speciesVal] = interp->getPropertyForExternal(ctorVal, WellKnownSymbols::speciesKey());
-        if (interp->hasError()) { Value err = interp->getError(); interp->clearError(); throw JsValueException(err); }
-        if (hasSpecies && !speciesVal.isUndefined()) {
-          if (speciesVal.isNull()) {
-            // null means use default
-          } else if (speciesVal.isFunction() || speciesVal.isClass() ||
-                     (speciesVal.isObject() && speciesVal.getGC<Object>()->properties.count("__callable_object__"))) {
-            // Step 10: Construct(C, [length])
-            Value result = interp->constructFromNative(speciesVal, {Value(static_cast<double>(length))});
-            if (interp->hasError()) { Value err = interp->getError(); interp->clearError(); throw JsValueException(err); }
-            return result;
-          } else {
-            throw std::runtime_error("TypeError: Species is not a constructor");
-          }
-        }
-      } else if (!ctorVal.isFunction() && !ctorVal.isClass() && !ctorVal.isNull()) {
-        // Step 6 check: constructor must be Object or undefined
-        if (ctorVal.isNumber() || ctorVal.isString() || ctorVal.isBool() || ctorVal.isSymbol() || ctorVal.isBigInt()) {
-          throw std::runtime_error("TypeError: constructor is not an object");
-        }
-      }
-    }
-
-    // Default: create regular array
-    auto result = makeArrayWithPrototype();
-    if (length > 0) {
-      result->elements.resize(length, Value(Undefined{}));
-      for (size_t i = 0; i < length; i++) {
-        result->properties["__hole_" + std::to_string(i) + "__"] = Value(true);
-      }
-    }
-    return Value(result);
-  };
+  });
 
-  // Helper lambda for installing Array prototype methods that need callback support
-  auto installArrayMethod = [&](const std::string& name, int length,
-      std::function<Value(const std::vector<Value>&)> impl) {
-    auto fn = GarbageCollector::makeGC<Function>();
-    fn->isNative = true;
-    fn->properties["__uses_this_arg__"] = Value(true);
-    fn->properties["name"] = Value(name);
-    fn->properties["length"] = Value(static_cast<double>(length));
-    fn->properties["__non_writable_name"] = Value(true);
-    fn->properties["__non_enum_name"] = Value(true);
-    fn->properties["__non_writable_length"] = Value(true);
-    fn->properties["__non_enum_length"] = Value(true);
-    fn->nativeFunc = impl;
-    arrayPrototype->properties[name] = Value(fn);
-    arrayPrototype->properties["__non_enum_" + name] = Value(true);
-  };
+  // --- Generic array-like builtins ---
+  // These allow Array.prototype.map.call(obj, fn) etc. to work on any object
+  // with .length; the shared steps are the array helpers at file scope.
 
   // Array.prototype.map - generic (works on any array-like)
-  installArrayMethod("map", 1, [toObjectChecked, getArrayLikeLength, getArrayLikeElement, arraySpeciesCreate](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "map");
-    if (args.size() < 2 || !args[1].isFunction()) {
-      throw std::runtime_error("TypeError: undefined is not a function");
+  installArrayMethod("map", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                  NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "map", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    if (args.empty() || !args[0].isFunction()) {
+      return thrown.error(ErrorType::TypeError, "undefined is not a function");
     }
-    Value callback = args[1];
-    Value thisArg = args.size() > 2 ? args[2] : Value(Undefined{});
-    size_t len = getArrayLikeLength(thisVal);
-    Value resultVal = arraySpeciesCreate(thisVal, len);
-    Interpreter* interpreter = getGlobalInterpreter();
-    if (!interpreter) throw std::runtime_error("TypeError: Interpreter unavailable");
+    Value callback = args[0];
+    Value thisArg = args.size() > 1 ? args[1] : Value(Undefined{});
+    size_t len = arrayLikeLength(thisVal, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    Value resultVal = arraySpeciesCreate(thisVal, len, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
     for (size_t i = 0; i < len; ++i) {
-      auto [exists, elem] = getArrayLikeElement(thisVal, i);
+      auto [exists, elem] = arrayLikeElement(thisVal, i, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       if (!exists) continue;
-      std::vector<Value> callArgs = {elem, Value(static_cast<double>(i)), thisVal};
-      Value mapped = interpreter->callForHarness(callback, callArgs, thisArg);
-      if (interpreter->hasError()) {
-        Value err = interpreter->getError();
-        interpreter->clearError();
-        throw JsValueException(err);
-      }
+      Value mapped = callArrayCallback(callback, {elem, Value(static_cast<double>(i)), thisVal}, thisArg, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       // Set on result via [[DefineOwnProperty]]
       if (resultVal.isArray()) {
         auto resultArr = resultVal.getGC<Array>();
-        if (i < resultArr->elements.size()) {
-          resultArr->elements[i] = mapped;
+        if (i < resultArr->elementCount()) {
+          resultArr->setElement(i, mapped);
           resultArr->properties.erase("__hole_" + std::to_string(i) + "__");
         } else {
-          while (resultArr->elements.size() < i) resultArr->elements.push_back(Value(Undefined{}));
-          resultArr->elements.push_back(mapped);
+          while (resultArr->elementCount() < i) resultArr->pushElement(Value(Undefined{}));
+          resultArr->pushElement(mapped);
         }
       } else if (resultVal.isObject()) {
         resultVal.getGC<Object>()->properties[std::to_string(i)] = mapped;
       }
     }
+    // The default species result starts out as holes, which are Generic
+    if (resultVal.isArray()) resultVal.getGC<Array>()->narrowElements();
     return resultVal;
   });
 
   // Array.prototype.filter - generic
-  installArrayMethod("filter", 1, [toObjectChecked, getArrayLikeLength, getArrayLikeElement, arraySpeciesCreate](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "filter");
-    if (args.size() < 2 || !args[1].isFunction()) {
-      throw std::runtime_error("TypeError: undefined is not a function");
+  installArrayMethod("filter", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                     NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "filter", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    if (args.empty() || !args[0].isFunction()) {
+      return thrown.error(ErrorType::TypeError, "undefined is not a function");
     }
-    Value callback = args[1];
-    Value thisArg = args.size() > 2 ? args[2] : Value(Undefined{});
-    size_t len = getArrayLikeLength(thisVal);
-    Value resultVal = arraySpeciesCreate(thisVal, 0);
-    Interpreter* interpreter = getGlobalInterpreter();
-    if (!interpreter) throw std::runtime_error("TypeError: Interpreter unavailable");
+    Value callback = args[0];
+    Value thisArg = args.size() > 1 ? args[1] : Value(Undefined{});
+    size_t len = arrayLikeLength(thisVal, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    Value resultVal = arraySpeciesCreate(thisVal, 0, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
     size_t to = 0;
     for (size_t i = 0; i < len; ++i) {
-      auto [exists, elem] = getArrayLikeElement(thisVal, i);
+      auto [exists, elem] = arrayLikeElement(thisVal, i, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       if (!exists) continue;
-      std::vector<Value> callArgs = {elem, Value(static_cast<double>(i)), thisVal};
-      Value keep = interpreter->callForHarness(callback, callArgs, thisArg);
-      if (interpreter->hasError()) {
-        Value err = interpreter->getError();
-        interpreter->clearError();
-        throw JsValueException(err);
-      }
+      Value keep = callArrayCallback(callback, {elem, Value(static_cast<double>(i)), thisVal}, thisArg, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       if (keep.toBool()) {
         if (resultVal.isArray()) {
-          resultVal.getGC<Array>()->elements.push_back(elem);
+          resultVal.getGC<Array>()->pushElement(elem);
         } else if (resultVal.isObject()) {
           resultVal.getGC<Object>()->properties[std::to_string(to)] = elem;
         }
@@ -17298,196 +17314,178 @@ GCPtr<Environment> Environment::createGlobal() {
   });
 
   // Array.prototype.forEach - generic
-  installArrayMethod("forEach", 1, [toObjectChecked, getArrayLikeLength, getArrayLikeElement](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "forEach");
-    if (args.size() < 2 || !args[1].isFunction()) {
-      throw std::runtime_error("TypeError: undefined is not a function");
+  installArrayMethod("forEach", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                      NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "forEach", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    if (args.empty() || !args[0].isFunction()) {
+      return thrown.error(ErrorType::TypeError, "undefined is not a function");
     }
-    Value callback = args[1];
-    Value thisArg = args.size() > 2 ? args[2] : Value(Undefined{});
-    size_t len = getArrayLikeLength(thisVal);
-    Interpreter* interpreter = getGlobalInterpreter();
-    if (!interpreter) throw std::runtime_error("TypeError: Interpreter unavailable");
+    Value callback = args[0];
+    Value thisArg = args.size() > 1 ? args[1] : Value(Undefined{});
+    size_t len = arrayLikeLength(thisVal, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
     for (size_t i = 0; i < len; ++i) {
-      auto [exists, elem] = getArrayLikeElement(thisVal, i);
+      auto [exists, elem] = arrayLikeElement(thisVal, i, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       if (!exists) continue;
-      std::vector<Value> callArgs = {elem, Value(static_cast<double>(i)), thisVal};
-      interpreter->callForHarness(callback, callArgs, thisArg);
-      if (interpreter->hasError()) {
-        Value err = interpreter->getError();
-        interpreter->clearError();
-        throw std::runtime_error(err.toString());
-      }
+      callArrayCallback(callback, {elem, Value(static_cast<double>(i)), thisVal}, thisArg, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
     }
     return Value(Undefined{});
   });
 
   // Array.prototype.some - generic
-  installArrayMethod("some", 1, [toObjectChecked, getArrayLikeLength, getArrayLikeElement](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "some");
-    if (args.size() < 2 || !args[1].isFunction()) {
-      throw std::runtime_error("TypeError: undefined is not a function");
+  installArrayMethod("some", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                   NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "some", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    if (args.empty() || !args[0].isFunction()) {
+      return thrown.error(ErrorType::TypeError, "undefined is not a function");
     }
-    Value callback = args[1];
-    Value thisArg = args.size() > 2 ? args[2] : Value(Undefined{});
-    size_t len = getArrayLikeLength(thisVal);
-    Interpreter* interpreter = getGlobalInterpreter();
-    if (!interpreter) throw std::runtime_error("TypeError: Interpreter unavailable");
+    Value callback = args[0];
+    Value thisArg = args.size() > 1 ? args[1] : Value(Undefined{});
+    size_t len = arrayLikeLength(thisVal, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
     for (size_t i = 0; i < len; ++i) {
-      auto [exists, elem] = getArrayLikeElement(thisVal, i);
+      auto [exists, elem] = arrayLikeElement(thisVal, i, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       if (!exists) continue;
-      std::vector<Value> callArgs = {elem, Value(static_cast<double>(i)), thisVal};
-      Value result = interpreter->callForHarness(callback, callArgs, thisArg);
-      if (interpreter->hasError()) {
-        Value err = interpreter->getError();
-        interpreter->clearError();
-        throw std::runtime_error(err.toString());
-      }
+      Value result = callArrayCallback(callback, {elem, Value(static_cast<double>(i)), thisVal}, thisArg, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       if (result.toBool()) return Value(true);
     }
     return Value(false);
   });
 
   // Array.prototype.every - generic
-  installArrayMethod("every", 1, [toObjectChecked, getArrayLikeLength, getArrayLikeElement](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "every");
-    if (args.size() < 2 || !args[1].isFunction()) {
-      throw std::runtime_error("TypeError: undefined is not a function");
+  installArrayMethod("every", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                    NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "every", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    if (args.empty() || !args[0].isFunction()) {
+      return thrown.error(ErrorType::TypeError, "undefined is not a function");
     }
-    Value callback = args[1];
-    Value thisArg = args.size() > 2 ? args[2] : Value(Undefined{});
-    size_t len = getArrayLikeLength(thisVal);
-    Interpreter* interpreter = getGlobalInterpreter();
-    if (!interpreter) throw std::runtime_error("TypeError: Interpreter unavailable");
+    Value callback = args[0];
+    Value thisArg = args.size() > 1 ? args[1] : Value(Undefined{});
+    size_t len = arrayLikeLength(thisVal, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
     for (size_t i = 0; i < len; ++i) {
-      auto [exists, elem] = getArrayLikeElement(thisVal, i);
+      auto [exists, elem] = arrayLikeElement(thisVal, i, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       if (!exists) continue;
-      std::vector<Value> callArgs = {elem, Value(static_cast<double>(i)), thisVal};
-      Value result = interpreter->callForHarness(callback, callArgs, thisArg);
-      if (interpreter->hasError()) {
-        Value err = interpreter->getError();
-        interpreter->clearError();
-        throw std::runtime_error(err.toString());
-      }
+      Value result = callArrayCallback(callback, {elem, Value(static_cast<double>(i)), thisVal}, thisArg, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       if (!result.toBool()) return Value(false);
     }
     return Value(true);
   });
 
   // Array.prototype.find - generic
-  installArrayMethod("find", 1, [toObjectChecked, getArrayLikeLength, getArrayLikeElement](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "find");
-    if (args.size() < 2 || !args[1].isFunction()) {
-      throw std::runtime_error("TypeError: undefined is not a function");
+  installArrayMethod("find", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                   NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "find", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    if (args.empty() || !args[0].isFunction()) {
+      return thrown.error(ErrorType::TypeError, "undefined is not a function");
     }
-    Value callback = args[1];
-    Value thisArg = args.size() > 2 ? args[2] : Value(Undefined{});
-    size_t len = getArrayLikeLength(thisVal);
-    Interpreter* interpreter = getGlobalInterpreter();
-    if (!interpreter) throw std::runtime_error("TypeError: Interpreter unavailable");
+    Value callback = args[0];
+    Value thisArg = args.size() > 1 ? args[1] : Value(Undefined{});
+    size_t len = arrayLikeLength(thisVal, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
     for (size_t i = 0; i < len; ++i) {
-      auto [exists, elem] = getArrayLikeElement(thisVal, i);
+      auto [exists, elem] = arrayLikeElement(thisVal, i, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       Value kValue = exists ? elem : Value(Undefined{});
-      std::vector<Value> callArgs = {kValue, Value(static_cast<double>(i)), thisVal};
-      Value result = interpreter->callForHarness(callback, callArgs, thisArg);
-      if (interpreter->hasError()) {
-        Value err = interpreter->getError();
-        interpreter->clearError();
-        throw std::runtime_error(err.toString());
-      }
+      Value result = callArrayCallback(callback, {kValue, Value(static_cast<double>(i)), thisVal}, thisArg, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       if (result.toBool()) return kValue;
     }
     return Value(Undefined{});
   });
 
   // Array.prototype.findIndex - generic
-  installArrayMethod("findIndex", 1, [toObjectChecked, getArrayLikeLength, getArrayLikeElement](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "findIndex");
-    if (args.size() < 2 || !args[1].isFunction()) {
-      throw std::runtime_error("TypeError: undefined is not a function");
+  installArrayMethod("findIndex", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                        NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "findIndex", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    if (args.empty() || !args[0].isFunction()) {
+      return thrown.error(ErrorType::TypeError, "undefined is not a function");
     }
-    Value callback = args[1];
-    Value thisArg = args.size() > 2 ? args[2] : Value(Undefined{});
-    size_t len = getArrayLikeLength(thisVal);
-    Interpreter* interpreter = getGlobalInterpreter();
-    if (!interpreter) throw std::runtime_error("TypeError: Interpreter unavailable");
+    Value callback = args[0];
+    Value thisArg = args.size() > 1 ? args[1] : Value(Undefined{});
+    size_t len = arrayLikeLength(thisVal, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
     for (size_t i = 0; i < len; ++i) {
-      auto [exists, elem] = getArrayLikeElement(thisVal, i);
+      auto [exists, elem] = arrayLikeElement(thisVal, i, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       Value kValue = exists ? elem : Value(Undefined{});
-      std::vector<Value> callArgs = {kValue, Value(static_cast<double>(i)), thisVal};
-      Value result = interpreter->callForHarness(callback, callArgs, thisArg);
-      if (interpreter->hasError()) {
-        Value err = interpreter->getError();
-        interpreter->clearError();
-        throw std::runtime_error(err.toString());
-      }
+      Value result = callArrayCallback(callback, {kValue, Value(static_cast<double>(i)), thisVal}, thisArg, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       if (result.toBool()) return Value(static_cast<double>(i));
     }
     return Value(-1.0);
   });
 
   // Array.prototype.findLast - generic
-  installArrayMethod("findLast", 1, [toObjectChecked, getArrayLikeLength, getArrayLikeElement](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "findLast");
-    if (args.size() < 2 || !args[1].isFunction()) {
-      throw std::runtime_error("TypeError: undefined is not a function");
+  installArrayMethod("findLast", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                       NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "findLast", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    if (args.empty() || !args[0].isFunction()) {
+      return thrown.error(ErrorType::TypeError, "undefined is not a function");
     }
-    Value callback = args[1];
-    Value thisArg = args.size() > 2 ? args[2] : Value(Undefined{});
-    size_t len = getArrayLikeLength(thisVal);
-    Interpreter* interpreter = getGlobalInterpreter();
-    if (!interpreter) throw std::runtime_error("TypeError: Interpreter unavailable");
+    Value callback = args[0];
+    Value thisArg = args.size() > 1 ? args[1] : Value(Undefined{});
+    size_t len = arrayLikeLength(thisVal, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
     for (int i = static_cast<int>(len) - 1; i >= 0; --i) {
-      auto [exists, elem] = getArrayLikeElement(thisVal, static_cast<size_t>(i));
+      auto [exists, elem] = arrayLikeElement(thisVal, static_cast<size_t>(i), interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       Value kValue = exists ? elem : Value(Undefined{});
-      std::vector<Value> callArgs = {kValue, Value(static_cast<double>(i)), thisVal};
-      Value result = interpreter->callForHarness(callback, callArgs, thisArg);
-      if (interpreter->hasError()) {
-        Value err = interpreter->getError();
-        interpreter->clearError();
-        throw std::runtime_error(err.toString());
-      }
+      Value result = callArrayCallback(callback, {kValue, Value(static_cast<double>(i)), thisVal}, thisArg, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       if (result.toBool()) return kValue;
     }
     return Value(Undefined{});
   });
 
   // Array.prototype.findLastIndex - generic
-  installArrayMethod("findLastIndex", 1, [toObjectChecked, getArrayLikeLength, getArrayLikeElement](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "findLastIndex");
-    if (args.size() < 2 || !args[1].isFunction()) {
-      throw std::runtime_error("TypeError: undefined is not a function");
+  installArrayMethod("findLastIndex", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                            NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "findLastIndex", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    if (args.empty() || !args[0].isFunction()) {
+      return thrown.error(ErrorType::TypeError, "undefined is not a function");
     }
-    Value callback = args[1];
-    Value thisArg = args.size() > 2 ? args[2] : Value(Undefined{});
-    size_t len = getArrayLikeLength(thisVal);
-    Interpreter* interpreter = getGlobalInterpreter();
-    if (!interpreter) throw std::runtime_error("TypeError: Interpreter unavailable");
+    Value callback = args[0];
+    Value thisArg = args.size() > 1 ? args[1] : Value(Undefined{});
+    size_t len = arrayLikeLength(thisVal, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
     for (int i = static_cast<int>(len) - 1; i >= 0; --i) {
-      auto [exists, elem] = getArrayLikeElement(thisVal, static_cast<size_t>(i));
+      auto [exists, elem] = arrayLikeElement(thisVal, static_cast<size_t>(i), interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       Value kValue = exists ? elem : Value(Undefined{});
-      std::vector<Value> callArgs = {kValue, Value(static_cast<double>(i)), thisVal};
-      Value result = interpreter->callForHarness(callback, callArgs, thisArg);
-      if (interpreter->hasError()) {
-        Value err = interpreter->getError();
-        interpreter->clearError();
-        throw std::runtime_error(err.toString());
-      }
+      Value result = callArrayCallback(callback, {kValue, Value(static_cast<double>(i)), thisVal}, thisArg, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       if (result.toBool()) return Value(static_cast<double>(i));
     }
     return Value(-1.0);
   });
 
   // Array.prototype.includes - generic
-  installArrayMethod("includes", 1, [toObjectChecked, getArrayLikeLength, getArrayLikeElement](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "includes");
-    Value searchElement = args.size() > 1 ? args[1] : Value(Undefined{});
-    size_t len = getArrayLikeLength(thisVal);
+  installArrayMethod("includes", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                       NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "includes", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    Value searchElement = args.empty() ? Value(Undefined{}) : args[0];
+    size_t len = arrayLikeLength(thisVal, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
     if (len == 0) return Value(false);
     // ToIntegerOrInfinity for fromIndex
     double n = 0;
-    if (args.size() > 2) {
-      double fi = args[2].toNumber();
+    if (args.size() > 1) {
+      double fi = args[1].toNumber();
       if (std::isnan(fi)) n = 0;
       else n = std::trunc(fi);
     }
@@ -17501,22 +17499,23 @@ GCPtr<Environment> Environment::createGlobal() {
     }
     auto sameValueZero = [](const Value& a, const Value& b) -> bool {
       if (a.isNumber() && b.isNumber()) {
-        double x = std::get<double>(a.data), y = std::get<double>(b.data);
+        double x = a.asNumber(), y = b.asNumber();
         if (std::isnan(x) && std::isnan(y)) return true;
         return x == y;
       }
-      if (a.data.index() != b.data.index()) return false;
-      if (a.isString()) return std::get<std::string>(a.data) == std::get<std::string>(b.data);
+      if (!a.hasSameType(b)) return false;
+      if (a.isString()) return a.asString() == b.asString();
       if (a.isBool()) return std::get<bool>(a.data) == std::get<bool>(b.data);
       if (a.isNull() || a.isUndefined()) return true;
       if (a.isObject()) return a.getGC<Object>().get() == b.getGC<Object>().get();
       if (a.isArray()) return a.getGC<Array>().get() == b.getGC<Array>().get();
       if (a.isFunction()) return a.getGC<Function>().get() == b.getGC<Function>().get();
-      if (a.isSymbol()) return std::get<Symbol>(a.data).id == std::get<Symbol>(b.data).id;
+      if (a.isSymbol()) return a.asSymbol().id == b.asSymbol().id;
       return false;
     };
     for (size_t i = k; i < len; ++i) {
-      auto [exists, elem] = getArrayLikeElement(thisVal, i);
+      auto [exists, elem] = arrayLikeElement(thisVal, i, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       if (!exists) {
         if (searchElement.isUndefined()) return Value(true);
         continue;
@@ -17527,97 +17526,97 @@ GCPtr<Environment> Environment::createGlobal() {
   });
 
   // Array.prototype.reduceRight - generic
-  installArrayMethod("reduceRight", 1, [toObjectChecked, getArrayLikeLength, getArrayLikeElement](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "reduceRight");
-    if (args.size() < 2 || !args[1].isFunction()) {
-      throw std::runtime_error("TypeError: undefined is not a function");
+  installArrayMethod("reduceRight", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                          NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "reduceRight", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    if (args.empty() || !args[0].isFunction()) {
+      return thrown.error(ErrorType::TypeError, "undefined is not a function");
     }
-    Value callback = args[1];
-    size_t len = getArrayLikeLength(thisVal);
-    bool hasInitial = args.size() >= 3;
+    Value callback = args[0];
+    size_t len = arrayLikeLength(thisVal, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
     Value accumulator(Undefined{});
     int k = static_cast<int>(len) - 1;
-    if (hasInitial) {
-      accumulator = args[2];
+    if (args.size() >= 2) {
+      accumulator = args[1];
     } else {
       bool found = false;
       while (k >= 0 && !found) {
-        auto [exists, elem] = getArrayLikeElement(thisVal, static_cast<size_t>(k));
+        auto [exists, elem] = arrayLikeElement(thisVal, static_cast<size_t>(k), interp, thrown);
+        if (thrown.pending) return Value(Undefined{});
         if (exists) { accumulator = elem; found = true; }
         k--;
       }
-      if (!found) throw std::runtime_error("TypeError: Reduce of empty array with no initial value");
+      if (!found) return thrown.error(ErrorType::TypeError, "Reduce of empty array with no initial value");
     }
-    Interpreter* interpreter = getGlobalInterpreter();
-    if (!interpreter) throw std::runtime_error("TypeError: Interpreter unavailable");
     for (; k >= 0; --k) {
-      auto [exists, elem] = getArrayLikeElement(thisVal, static_cast<size_t>(k));
+      auto [exists, elem] = arrayLikeElement(thisVal, static_cast<size_t>(k), interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       if (!exists) continue;
-      std::vector<Value> callArgs = {accumulator, elem, Value(static_cast<double>(k)), thisVal};
-      accumulator = interpreter->callForHarness(callback, callArgs, Value(Undefined{}));
-      if (interpreter->hasError()) {
-        Value err = interpreter->getError();
-        interpreter->clearError();
-        throw std::runtime_error(err.toString());
-      }
+      accumulator = callArrayCallback(callback, {accumulator, elem, Value(static_cast<double>(k)), thisVal},
+                                      Value(Undefined{}), interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
     }
     return accumulator;
   });
 
   // Array.prototype.reduce - generic
-  installArrayMethod("reduce", 1, [toObjectChecked, getArrayLikeLength, getArrayLikeElement](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "reduce");
-    if (args.size() < 2 || !args[1].isFunction()) {
-      throw std::runtime_error("TypeError: undefined is not a function");
+  installArrayMethod("reduce", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                     NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "reduce", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    if (args.empty() || !args[0].isFunction()) {
+      return thrown.error(ErrorType::TypeError, "undefined is not a function");
     }
-    Value callback = args[1];
-    size_t len = getArrayLikeLength(thisVal);
-    bool hasInitial = args.size() >= 3;
+    Value callback = args[0];
+    size_t len = arrayLikeLength(thisVal, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
     Value accumulator(Undefined{});
     size_t k = 0;
-    if (hasInitial) {
-      accumulator = args[2];
+    if (args.size() >= 2) {
+      accumulator = args[1];
     } else {
       bool found = false;
       while (k < len && !found) {
-        auto [exists, elem] = getArrayLikeElement(thisVal, k);
+        auto [exists, elem] = arrayLikeElement(thisVal, k, interp, thrown);
+        if (thrown.pending) return Value(Undefined{});
         if (exists) { accumulator = elem; found = true; }
         k++;
       }
-      if (!found) throw std::runtime_error("TypeError: Reduce of empty array with no initial value");
+      if (!found) return thrown.error(ErrorType::TypeError, "Reduce of empty array with no initial value");
     }
-    Interpreter* interpreter = getGlobalInterpreter();
-    if (!interpreter) throw std::runtime_error("TypeError: Interpreter unavailable");
     for (; k < len; ++k) {
-      auto [exists, elem] = getArrayLikeElement(thisVal, k);
+      auto [exists, elem] = arrayLikeElement(thisVal, k, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       if (!exists) continue;
-      std::vector<Value> callArgs = {accumulator, elem, Value(static_cast<double>(k)), thisVal};
-      accumulator = interpreter->callForHarness(callback, callArgs, Value(Undefined{}));
-      if (interpreter->hasError()) {
-        Value err = interpreter->getError();
-        interpreter->clearError();
-        throw JsValueException(err);
-      }
+      accumulator = callArrayCallback(callback, {accumulator, elem, Value(static_cast<double>(k)), thisVal},
+                                      Value(Undefined{}), interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
     }
     return accumulator;
   });
 
   // Array.prototype.lastIndexOf - generic
-  installArrayMethod("lastIndexOf", 1, [toObjectChecked, getArrayLikeLength, getArrayLikeElement, arrayStrictEqual](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "lastIndexOf");
-    Value searchElement = args.size() > 1 ? args[1] : Value(Undefined{});
-    int len = static_cast<int>(getArrayLikeLength(thisVal));
+  installArrayMethod("lastIndexOf", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                          NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "lastIndexOf", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    Value searchElement = args.empty() ? Value(Undefined{}) : args[0];
+    int len = static_cast<int>(arrayLikeLength(thisVal, interp, thrown));
+    if (thrown.pending) return Value(Undefined{});
     if (len == 0) return Value(-1.0);
     int fromIndex = len - 1;
-    if (args.size() > 2) {
-      double fi = args[2].toNumber();
+    if (args.size() > 1) {
+      double fi = args[1].toNumber();
       if (std::isnan(fi)) return Value(-1.0);
       fromIndex = static_cast<int>(fi);
       if (fromIndex < 0) fromIndex = len + fromIndex;
     }
     if (fromIndex >= len) fromIndex = len - 1;
     for (int i = fromIndex; i >= 0; --i) {
-      auto [exists, elem] = getArrayLikeElement(thisVal, static_cast<size_t>(i));
+      auto [exists, elem] = arrayLikeElement(thisVal, static_cast<size_t>(i), interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       if (!exists) continue;
       if (arrayStrictEqual(elem, searchElement)) return Value(static_cast<double>(i));
     }
@@ -17625,41 +17624,41 @@ GCPtr<Environment> Environment::createGlobal() {
   });
 
   // Array.prototype.flat
-  installArrayMethod("flat", 0, [toObjectChecked, getArrayLikeLength, getArrayLikeElement](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "flat");
+  installArrayMethod("flat", 0, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                   NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "flat", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
     double depth = 1;
-    if (args.size() > 1 && !args[1].isUndefined()) {
-      depth = args[1].toNumber();
+    if (!args.empty() && !args[0].isUndefined()) {
+      depth = args[0].toNumber();
       if (std::isnan(depth) || depth < 0) depth = 0;
       depth = std::floor(depth);
     }
     auto result = makeArrayWithPrototype();
     std::function<void(const Value&, double)> flatten;
     flatten = [&](const Value& src, double d) {
-      auto* interp = getGlobalInterpreter();
-      if (!interp) return;
       size_t len = 0;
-      auto [found, lenVal] = interp->getPropertyForExternal(src, "length");
+      auto [found, lenVal] = interp.getPropertyForExternal(src, "length");
       if (found) {
         double dl = lenVal.toNumber();
         if (!std::isnan(dl) && dl >= 0) len = static_cast<size_t>(dl);
       }
       for (size_t i = 0; i < len; i++) {
-        auto [exists, elem] = interp->getPropertyForExternal(src, std::to_string(i));
+        auto [exists, elem] = interp.getPropertyForExternal(src, std::to_string(i));
         if (!exists) {
-          result->elements.push_back(Value(Undefined{}));
-          result->properties["__hole_" + std::to_string(result->elements.size() - 1) + "__"] = Value(true);
+          result->pushElement(Value(Undefined{}));
+          result->properties["__hole_" + std::to_string(result->elementCount() - 1) + "__"] = Value(true);
           continue;
         }
         if (d > 0 && (elem.isArray() || (isObjectLikeValue(elem) && !elem.isFunction()))) {
           // Check if element is array-like (has length)
-          auto [hasLen, eLenVal] = interp->getPropertyForExternal(elem, "length");
+          auto [hasLen, eLenVal] = interp.getPropertyForExternal(elem, "length");
           if (elem.isArray() || (hasLen && eLenVal.isNumber())) {
             flatten(elem, d - 1);
             continue;
           }
         }
-        result->elements.push_back(elem);
+        result->pushElement(elem);
       }
     };
     flatten(thisVal, depth);
@@ -17667,62 +17666,51 @@ GCPtr<Environment> Environment::createGlobal() {
   });
 
   // Array.prototype.flatMap
-  installArrayMethod("flatMap", 1, [toObjectChecked, getArrayLikeLength, getArrayLikeElement](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "flatMap");
-    if (args.size() < 2 || !args[1].isFunction()) {
-      throw std::runtime_error("TypeError: Array.prototype.flatMap requires a callback function");
+  installArrayMethod("flatMap", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                      NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "flatMap", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    if (args.empty() || !args[0].isFunction()) {
+      return thrown.error(ErrorType::TypeError, "Array.prototype.flatMap requires a callback function");
     }
-    Value callback = args[1];
-    Value thisArg = args.size() > 2 ? args[2] : Value(Undefined{});
-    size_t len = getArrayLikeLength(thisVal);
+    Value callback = args[0];
+    Value thisArg = args.size() > 1 ? args[1] : Value(Undefined{});
+    size_t len = arrayLikeLength(thisVal, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
     auto result = makeArrayWithPrototype();
-    Interpreter* interpreter = getGlobalInterpreter();
-    if (!interpreter) throw std::runtime_error("TypeError: Interpreter unavailable");
     for (size_t i = 0; i < len; ++i) {
-      auto [exists, elem] = getArrayLikeElement(thisVal, i);
+      auto [exists, elem] = arrayLikeElement(thisVal, i, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       if (!exists) continue;
-      std::vector<Value> callArgs = {elem, Value(static_cast<double>(i)), thisVal};
-      Value mapped = interpreter->callForHarness(callback, callArgs, thisArg);
-      if (interpreter->hasError()) {
-        Value err = interpreter->getError();
-        interpreter->clearError();
-        throw JsValueException(err);
-      }
+      Value mapped = callArrayCallback(callback, {elem, Value(static_cast<double>(i)), thisVal}, thisArg, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       if (mapped.isArray()) {
         auto mappedArr = mapped.getGC<Array>();
-        for (const auto& e : mappedArr->elements) {
-          result->elements.push_back(e);
+        for (size_t j = 0; j < mappedArr->elementCount(); ++j) {
+          result->pushElement(mappedArr->element(j));
         }
       } else {
-        result->elements.push_back(mapped);
+        result->pushElement(mapped);
       }
     }
     return Value(result);
   });
 
   // Array.prototype.fill
-  installArrayMethod("fill", 1, [toObjectChecked, getArrayLikeLength](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "fill");
-    int len = static_cast<int>(getArrayLikeLength(thisVal));
-    Value fillValue = args.size() > 1 ? args[1] : Value(Undefined{});
-    int start = 0, end = len;
-    if (args.size() > 2 && !args[2].isUndefined()) {
-      double s = args[2].toNumber();
-      start = std::isnan(s) ? 0 : static_cast<int>(s);
-      if (start < 0) start = std::max(0, len + start);
-    }
-    if (args.size() > 3 && !args[3].isUndefined()) {
-      double e = args[3].toNumber();
-      end = std::isnan(e) ? 0 : static_cast<int>(e);
-      if (end < 0) end = std::max(0, len + end);
-    }
-    start = std::min(start, len);
-    end = std::min(end, len);
+  installArrayMethod("fill", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                   NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "fill", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    int len = static_cast<int>(arrayLikeLength(thisVal, interp, thrown));
+    if (thrown.pending) return Value(Undefined{});
+    Value fillValue = args.empty() ? Value(Undefined{}) : args[0];
+    int start = arrayRelativeIndex(args, 1, len, 0);
+    int end = arrayRelativeIndex(args, 2, len, len);
     if (thisVal.isArray()) {
       auto arr = thisVal.getGC<Array>();
       for (int i = start; i < end; ++i) {
-        if (i < static_cast<int>(arr->elements.size())) {
-          arr->elements[i] = fillValue;
+        if (i < static_cast<int>(arr->elementCount())) {
+          arr->setElement(i, fillValue);
           arr->properties.erase("__hole_" + std::to_string(i) + "__");
         }
       }
@@ -17736,34 +17724,29 @@ GCPtr<Environment> Environment::createGlobal() {
   });
 
   // Array.prototype.copyWithin
-  installArrayMethod("copyWithin", 2, [toObjectChecked, getArrayLikeLength, getArrayLikeElement](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "copyWithin");
-    int len = static_cast<int>(getArrayLikeLength(thisVal));
-    double tD = args.size() > 1 ? args[1].toNumber() : 0;
-    double sD = args.size() > 2 ? args[2].toNumber() : 0;
-    double eD = args.size() > 3 && !args[3].isUndefined() ? args[3].toNumber() : len;
-    int target = std::isnan(tD) ? 0 : static_cast<int>(tD);
-    int start = std::isnan(sD) ? 0 : static_cast<int>(sD);
-    int end = std::isnan(eD) ? 0 : static_cast<int>(eD);
-    if (target < 0) target = std::max(0, len + target);
-    if (start < 0) start = std::max(0, len + start);
-    if (end < 0) end = std::max(0, len + end);
-    target = std::min(target, len);
-    start = std::min(start, len);
-    end = std::min(end, len);
+  installArrayMethod("copyWithin", 2, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                         NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "copyWithin", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    int len = static_cast<int>(arrayLikeLength(thisVal, interp, thrown));
+    if (thrown.pending) return Value(Undefined{});
+    int target = arrayRelativeIndex(args, 0, len, 0);
+    int start = arrayRelativeIndex(args, 1, len, 0);
+    int end = arrayRelativeIndex(args, 2, len, len);
     int count = std::min(end - start, len - target);
     if (count <= 0) return thisVal;
     // Read source elements via [[Get]]
     std::vector<std::pair<bool, Value>> temp;
     for (int i = 0; i < count; ++i) {
-      temp.push_back(getArrayLikeElement(thisVal, start + i));
+      temp.push_back(arrayLikeElement(thisVal, start + i, interp, thrown));
+      if (thrown.pending) return Value(Undefined{});
     }
     // Write to target positions
     if (thisVal.isArray()) {
       auto arr = thisVal.getGC<Array>();
       for (int i = 0; i < count; ++i) {
-        if (target + i < static_cast<int>(arr->elements.size())) {
-          arr->elements[target + i] = temp[i].first ? temp[i].second : Value(Undefined{});
+        if (target + i < static_cast<int>(arr->elementCount())) {
+          arr->setElement(target + i, temp[i].first ? temp[i].second : Value(Undefined{}));
         }
       }
     } else if (thisVal.isObject()) {
@@ -17781,56 +17764,66 @@ GCPtr<Environment> Environment::createGlobal() {
   });
 
   // Array.prototype.at
-  installArrayMethod("at", 1, [toObjectChecked, getArrayLikeLength, getArrayLikeElement](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "at");
-    size_t len = getArrayLikeLength(thisVal);
-    double index = args.size() > 1 ? args[1].toNumber() : 0;
+  installArrayMethod("at", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                 NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "at", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    size_t len = arrayLikeLength(thisVal, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    double index = args.empty() ? 0 : args[0].toNumber();
     int idx = std::isnan(index) ? 0 : static_cast<int>(index);
     if (idx < 0) idx = static_cast<int>(len) + idx;
     if (idx < 0 || static_cast<size_t>(idx) >= len) return Value(Undefined{});
-    auto [exists, elem] = getArrayLikeElement(thisVal, static_cast<size_t>(idx));
+    auto [exists, elem] = arrayLikeElement(thisVal, static_cast<size_t>(idx), interp, thrown);
     return exists ? elem : Value(Undefined{});
   });
 
   // Array.prototype.with
-  installArrayMethod("with", 2, [toObjectChecked, getArrayLikeLength, getArrayLikeElement](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "with");
-    size_t len = getArrayLikeLength(thisVal);
-    double index = args.size() > 1 ? args[1].toNumber() : 0;
-    Value value = args.size() > 2 ? args[2] : Value(Undefined{});
+  installArrayMethod("with", 2, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                   NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "with", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    size_t len = arrayLikeLength(thisVal, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    double index = args.empty() ? 0 : args[0].toNumber();
+    Value value = args.size() > 1 ? args[1] : Value(Undefined{});
     int iLen = static_cast<int>(len);
     int idx = std::isnan(index) ? 0 : static_cast<int>(index);
     if (idx < 0) idx = iLen + idx;
     if (idx < 0 || idx >= iLen) {
-      throw std::runtime_error("RangeError: Invalid index");
+      return thrown.error(ErrorType::RangeError, "Invalid index");
     }
     auto result = makeArrayWithPrototype();
     for (size_t i = 0; i < len; i++) {
       if (static_cast<int>(i) == idx) {
-        result->elements.push_back(value);
+        result->pushElement(value);
       } else {
-        auto [exists, elem] = getArrayLikeElement(thisVal, i);
-        result->elements.push_back(exists ? elem : Value(Undefined{}));
+        auto [exists, elem] = arrayLikeElement(thisVal, i, interp, thrown);
+        if (thrown.pending) return Value(Undefined{});
+        result->pushElement(exists ? elem : Value(Undefined{}));
       }
     }
     return Value(result);
   });
 
   // Array.prototype.splice
-  installArrayMethod("splice", 2, [toObjectChecked, getArrayLikeLength, getArrayLikeElement, arraySpeciesCreate](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "splice");
+  installArrayMethod("splice", 2, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                     NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "splice", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    std::span<const Value> newItems = args.size() > 2 ? args.subspan(2) : std::span<const Value>();
     if (thisVal.isArray()) {
       auto arr = thisVal.getGC<Array>();
-      int len = static_cast<int>(arr->elements.size());
+      int len = static_cast<int>(arr->elementCount());
       auto result = makeArrayWithPrototype();
-      if (args.size() < 2) return Value(result);
-      double startD = args[1].toNumber();
+      if (args.empty()) return Value(result);
+      double startD = args[0].toNumber();
       int start = std::isnan(startD) ? 0 : static_cast<int>(startD);
       if (start < 0) start = std::max(0, len + start);
       if (start > len) start = len;
       int deleteCount = 0;
-      if (args.size() >= 3) {
-        double dcD = args[2].toNumber();
+      if (args.size() >= 2) {
+        double dcD = args[1].toNumber();
         deleteCount = std::isnan(dcD) ? 0 : static_cast<int>(dcD);
         if (deleteCount < 0) deleteCount = 0;
         if (deleteCount > len - start) deleteCount = len - start;
@@ -17838,32 +17831,25 @@ GCPtr<Environment> Environment::createGlobal() {
         deleteCount = len - start;
       }
       for (int i = 0; i < deleteCount; ++i) {
-        result->elements.push_back(arr->elements[start + i]);
-      }
-      std::vector<Value> newItems;
-      for (size_t i = 3; i < args.size(); ++i) {
-        newItems.push_back(args[i]);
+        result->pushElement(arr->element(start + i));
       }
-      arr->elements.erase(arr->elements.begin() + start, arr->elements.begin() + start + deleteCount);
-      arr->elements.insert(arr->elements.begin() + start, newItems.begin(), newItems.end());
+      arr->eraseElements(start, deleteCount);
+      arr->insertElements(start, newItems);
       return Value(result);
     }
     // Generic: work with object properties
-    int len = static_cast<int>(getArrayLikeLength(thisVal));
+    int len = static_cast<int>(arrayLikeLength(thisVal, interp, thrown));
+    if (thrown.pending) return Value(Undefined{});
     auto result = makeArrayWithPrototype();
-    if (args.size() < 2) return Value(result);
-    int start = static_cast<int>(args[1].toNumber());
+    if (args.empty()) return Value(result);
+    int start = static_cast<int>(args[0].toNumber());
     if (start < 0) start = std::max(0, len + start);
     if (start > len) start = len;
-    int deleteCount = (args.size() >= 3) ? std::max(0, std::min(static_cast<int>(args[2].toNumber()), len - start)) : len - start;
+    int deleteCount = (args.size() >= 2) ? std::max(0, std::min(static_cast<int>(args[1].toNumber()), len - start)) : len - start;
     for (int i = 0; i < deleteCount; ++i) {
-      auto [exists, elem] = getArrayLikeElement(thisVal, start + i);
-      result->elements.push_back(exists ? elem : Value(Undefined{}));
-    }
-    // Collect items to insert
-    std::vector<Value> newItems;
-    for (size_t i = 3; i < args.size(); ++i) {
-      newItems.push_back(args[i]);
+      auto [exists, elem] = arrayLikeElement(thisVal, start + i, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
+      result->pushElement(exists ? elem : Value(Undefined{}));
     }
     int insertCount = static_cast<int>(newItems.size());
     int itemDelta = insertCount - deleteCount;
@@ -17909,35 +17895,29 @@ GCPtr<Environment> Environment::createGlobal() {
   });
 
   // Array.prototype.slice
-  installArrayMethod("slice", 2, [toObjectChecked, getArrayLikeLength, getArrayLikeElement, arraySpeciesCreate](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "slice");
-    int len = static_cast<int>(getArrayLikeLength(thisVal));
-    int start = 0, end = len;
-    if (args.size() > 1 && !args[1].isUndefined()) {
-      double s = args[1].toNumber();
-      start = std::isnan(s) ? 0 : static_cast<int>(s);
-      if (start < 0) start = std::max(0, len + start);
-    }
-    if (args.size() > 2 && !args[2].isUndefined()) {
-      double e = args[2].toNumber();
-      end = std::isnan(e) ? 0 : static_cast<int>(e);
-      if (end < 0) end = std::max(0, len + end);
-    }
-    start = std::min(start, len);
-    end = std::min(end, len);
+  installArrayMethod("slice", 2, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                    NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "slice", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    int len = static_cast<int>(arrayLikeLength(thisVal, interp, thrown));
+    if (thrown.pending) return Value(Undefined{});
+    int start = arrayRelativeIndex(args, 0, len, 0);
+    int end = arrayRelativeIndex(args, 1, len, len);
     int count = std::max(0, end - start);
-    Value resultVal = arraySpeciesCreate(thisVal, static_cast<size_t>(count));
+    Value resultVal = arraySpeciesCreate(thisVal, static_cast<size_t>(count), interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
     size_t n = 0;
     for (int i = start; i < end; ++i) {
-      auto [exists, elem] = getArrayLikeElement(thisVal, static_cast<size_t>(i));
+      auto [exists, elem] = arrayLikeElement(thisVal, static_cast<size_t>(i), interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
       if (resultVal.isArray()) {
         auto resultArr = resultVal.getGC<Array>();
-        if (n < resultArr->elements.size()) {
-          if (exists) { resultArr->elements[n] = elem; resultArr->properties.erase("__hole_" + std::to_string(n) + "__"); }
+        if (n < resultArr->elementCount()) {
+          if (exists) { resultArr->setElement(n, elem); resultArr->properties.erase("__hole_" + std::to_string(n) + "__"); }
         } else {
-          if (exists) resultArr->elements.push_back(elem);
+          if (exists) resultArr->pushElement(elem);
           else {
-            resultArr->elements.push_back(Value(Undefined{}));
+            resultArr->pushElement(Value(Undefined{}));
             resultArr->properties["__hole_" + std::to_string(n) + "__"] = Value(true);
           }
         }
@@ -17946,42 +17926,39 @@ GCPtr<Environment> Environment::createGlobal() {
       }
       n++;
     }
+    // The default species result starts out as holes, which are Generic
+    if (resultVal.isArray()) resultVal.getGC<Array>()->narrowElements();
     return resultVal;
   });
 
   // Array.prototype.pop - generic
-  installArrayMethod("pop", 0, [toObjectChecked, getArrayLikeLength, getArrayLikeElement](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "pop");
-    size_t len = getArrayLikeLength(thisVal);
+  installArrayMethod("pop", 0, [](const Value& thisValue, std::span<const Value>, Interpreter& interp,
+                                  NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "pop", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    size_t len = arrayLikeLength(thisVal, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    if (thisVal.isArray() && thisVal.getGC<Array>()->properties.count("__non_writable_length")) {
+      return thrown.error(ErrorType::TypeError, "Cannot assign to read only property 'length'");
+    }
     if (len == 0) {
       // Set length to 0
-      if (thisVal.isArray()) {
-        auto arr = thisVal.getGC<Array>();
-        if (arr->properties.count("__non_writable_length")) {
-          throw std::runtime_error("TypeError: Cannot assign to read only property 'length'");
-        }
-      }
       if (thisVal.isObject()) thisVal.getGC<Object>()->properties["length"] = Value(0.0);
       return Value(Undefined{});
     }
     if (thisVal.isArray()) {
       auto arr = thisVal.getGC<Array>();
-      if (arr->properties.count("__non_writable_length")) {
-        throw std::runtime_error("TypeError: Cannot assign to read only property 'length'");
-      }
       // Use [[Get]] for last element (accessor support)
-      auto [exists, last] = getArrayLikeElement(thisVal, len - 1);
-      arr->elements.pop_back();
+      auto [exists, last] = arrayLikeElement(thisVal, len - 1, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
+      if (arr->elementCount() > 0) arr->popElement();
       return exists ? last : Value(Undefined{});
     }
     // Generic object
-    Interpreter* interp = getGlobalInterpreter();
     std::string lastKey = std::to_string(len - 1);
     Value result(Undefined{});
-    if (interp) {
-      auto [found, val] = interp->getPropertyForExternal(thisVal, lastKey);
-      if (found) result = val;
-    }
+    auto [found, val] = interp.getPropertyForExternal(thisVal, lastKey);
+    if (found) result = val;
     if (thisVal.isObject()) {
       thisVal.getGC<Object>()->properties.erase(lastKey);
       thisVal.getGC<Object>()->properties["length"] = Value(static_cast<double>(len - 1));
@@ -17990,32 +17967,29 @@ GCPtr<Environment> Environment::createGlobal() {
   });
 
   // Array.prototype.shift - generic
-  installArrayMethod("shift", 0, [toObjectChecked, getArrayLikeLength, getArrayLikeElement](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "shift");
+  installArrayMethod("shift", 0, [](const Value& thisValue, std::span<const Value>, Interpreter& interp,
+                                    NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "shift", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
     if (thisVal.isArray()) {
       auto arr = thisVal.getGC<Array>();
       if (arr->properties.count("__non_writable_length")) {
-        if (arr->elements.empty()) {
-          throw std::runtime_error("TypeError: Cannot assign to read only property 'length'");
-        }
-        throw std::runtime_error("TypeError: Cannot assign to read only property 'length'");
+        return thrown.error(ErrorType::TypeError, "Cannot assign to read only property 'length'");
       }
-      if (arr->elements.empty()) return Value(Undefined{});
-      Value first = arr->elements.front();
-      arr->elements.erase(arr->elements.begin());
+      if (arr->elementCount() == 0) return Value(Undefined{});
+      Value first = arr->element(0);
+      arr->eraseElements(0, 1);
       return first;
     }
-    size_t len = getArrayLikeLength(thisVal);
+    size_t len = arrayLikeLength(thisVal, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
     if (len == 0) {
       if (thisVal.isObject()) thisVal.getGC<Object>()->properties["length"] = Value(0.0);
       return Value(Undefined{});
     }
     Value first(Undefined{});
-    Interpreter* interp = getGlobalInterpreter();
-    if (interp) {
-      auto [found, val] = interp->getPropertyForExternal(thisVal, "0");
-      if (found) first = val;
-    }
+    auto [found, val] = interp.getPropertyForExternal(thisVal, "0");
+    if (found) first = val;
     if (thisVal.isObject()) {
       auto obj = thisVal.getGC<Object>();
       for (size_t i = 1; i < len; ++i) {
@@ -18033,17 +18007,18 @@ GCPtr<Environment> Environment::createGlobal() {
   });
 
   // Array.prototype.unshift - generic
-  installArrayMethod("unshift", 1, [toObjectChecked, getArrayLikeLength](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "unshift");
+  installArrayMethod("unshift", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                      NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "unshift", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
     if (thisVal.isArray()) {
       auto arr = thisVal.getGC<Array>();
-      for (size_t i = args.size() - 1; i >= 1; --i) {
-        arr->elements.insert(arr->elements.begin(), args[i]);
-      }
-      return Value(static_cast<double>(arr->elements.size()));
+      arr->insertElements(0, args);
+      return Value(static_cast<double>(arr->elementCount()));
     }
-    size_t len = getArrayLikeLength(thisVal);
-    size_t argCount = args.size() - 1;
+    size_t len = arrayLikeLength(thisVal, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    size_t argCount = args.size();
     if (thisVal.isObject()) {
       auto obj = thisVal.getGC<Object>();
       // Shift existing elements up
@@ -18057,7 +18032,7 @@ GCPtr<Environment> Environment::createGlobal() {
       }
       // Insert new elements
       for (size_t i = 0; i < argCount; ++i) {
-        obj->properties[std::to_string(i)] = args[i + 1];
+        obj->properties[std::to_string(i)] = args[i];
       }
       size_t newLen = len + argCount;
       obj->properties["length"] = Value(static_cast<double>(newLen));
@@ -18067,120 +18042,133 @@ GCPtr<Environment> Environment::createGlobal() {
   });
 
   // Array.prototype.concat
-  installArrayMethod("concat", 1, [toObjectChecked, getArrayLikeLength, getArrayLikeElement, arraySpeciesCreate](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "concat");
-    Value resultVal = arraySpeciesCreate(thisVal, 0);
+  installArrayMethod("concat", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                     NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "concat", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    Value resultVal = arraySpeciesCreate(thisVal, 0, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
     auto result = resultVal.isArray() ? resultVal.getGC<Array>() : makeArrayWithPrototype();
-    Interpreter* interp = getGlobalInterpreter();
     // Helper: check if value is concat-spreadable per spec
-    auto isConcatSpreadable = [interp](const Value& val) -> bool {
+    auto isConcatSpreadable = [&](const Value& val) -> bool {
       if (!isObjectLikeValue(val) && !val.isArray()) return false;
-      if (interp) {
-        auto [found, spreadable] = interp->getPropertyForExternal(val, WellKnownSymbols::isConcatSpreadableKey());
-        if (interp->hasError()) { interp->clearError(); }
-        if (found && !spreadable.isUndefined()) {
-          return spreadable.toBool();
-        }
+      auto [found, spreadable] = interp.getPropertyForExternal(val, WellKnownSymbols::isConcatSpreadableKey());
+      if (interp.hasError()) { interp.clearError(); }
+      if (found && !spreadable.isUndefined()) {
+        return spreadable.toBool();
       }
       return val.isArray();
     };
-    // Helper: spread an array-like into result
-    auto spreadInto = [&](const Value& val) {
-      if (isConcatSpreadable(val)) {
-        size_t len = getArrayLikeLength(val);
-        for (size_t i = 0; i < len; ++i) {
-          auto [exists, elem] = getArrayLikeElement(val, i);
-          if (exists) {
-            result->elements.push_back(elem);
-          } else {
-            result->elements.push_back(Value(Undefined{}));
-            result->properties["__hole_" + std::to_string(result->elements.size() - 1) + "__"] = Value(true);
-          }
+    // Helper: spread an array-like into result; false once `thrown` is set
+    auto spreadInto = [&](const Value& val) -> bool {
+      if (!isConcatSpreadable(val)) {
+        result->pushElement(val);
+        return true;
+      }
+      size_t len = arrayLikeLength(val, interp, thrown);
+      if (thrown.pending) return false;
+      for (size_t i = 0; i < len; ++i) {
+        auto [exists, elem] = arrayLikeElement(val, i, interp, thrown);
+        if (thrown.pending) return false;
+        if (exists) {
+          result->pushElement(elem);
+        } else {
+          result->pushElement(Value(Undefined{}));
+          result->properties["__hole_" + std::to_string(result->elementCount() - 1) + "__"] = Value(true);
         }
-      } else {
-        result->elements.push_back(val);
       }
+      return true;
     };
-    spreadInto(thisVal);
-    for (size_t i = 1; i < args.size(); ++i) {
-      spreadInto(args[i]);
+    if (!spreadInto(thisVal)) return Value(Undefined{});
+    for (const Value& arg : args) {
+      if (!spreadInto(arg)) return Value(Undefined{});
     }
     return Value(result);
   });
 
   // Array.prototype.toReversed
-  installArrayMethod("toReversed", 0, [toObjectChecked, getArrayLikeLength, getArrayLikeElement](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "toReversed");
-    size_t len = getArrayLikeLength(thisVal);
+  installArrayMethod("toReversed", 0, [](const Value& thisValue, std::span<const Value>, Interpreter& interp,
+                                         NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "toReversed", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    size_t len = arrayLikeLength(thisVal, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
     auto result = makeArrayWithPrototype();
     for (size_t i = len; i > 0; i--) {
-      auto [exists, elem] = getArrayLikeElement(thisVal, i - 1);
-      result->elements.push_back(exists ? elem : Value(Undefined{}));
+      auto [exists, elem] = arrayLikeElement(thisVal, i - 1, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
+      result->pushElement(exists ? elem : Value(Undefined{}));
     }
     return Value(result);
   });
 
   // Array.prototype.toSorted
-  installArrayMethod("toSorted", 1, [toObjectChecked, getArrayLikeLength, getArrayLikeElement](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "toSorted");
-    size_t len = getArrayLikeLength(thisVal);
-    auto result = makeArrayWithPrototype();
+  installArrayMethod("toSorted", 1, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                       NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "toSorted", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    size_t len = arrayLikeLength(thisVal, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    std::vector<Value> sorted;
+    sorted.reserve(len);
     for (size_t i = 0; i < len; i++) {
-      auto [exists, elem] = getArrayLikeElement(thisVal, i);
-      result->elements.push_back(exists ? elem : Value(Undefined{}));
+      auto [exists, elem] = arrayLikeElement(thisVal, i, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
+      sorted.push_back(exists ? elem : Value(Undefined{}));
     }
-    bool hasCompareFn = args.size() > 1 && args[1].isFunction();
-    Value compareFn = hasCompareFn ? args[1] : Value(Undefined{});
-    Interpreter* interpreter = hasCompareFn ? getGlobalInterpreter() : nullptr;
-    std::sort(result->elements.begin(), result->elements.end(),
+    bool hasCompareFn = !args.empty() && args[0].isFunction();
+    Value compareFn = hasCompareFn ? args[0] : Value(Undefined{});
+    std::sort(sorted.begin(), sorted.end(),
       [&](const Value& a, const Value& b) -> bool {
         if (a.isUndefined() && b.isUndefined()) return false;
         if (a.isUndefined()) return false;
         if (b.isUndefined()) return true;
-        if (hasCompareFn && interpreter) {
-          Value cmpResult = interpreter->callForHarness(compareFn, {a, b}, Value(Undefined{}));
-          if (interpreter->hasError()) {
-            interpreter->clearError();
+        if (hasCompareFn) {
+          Value cmpResult = interp.callForHarness(compareFn, {a, b}, Value(Undefined{}));
+          if (interp.hasError()) {
+            interp.clearError();
             return false;
           }
           return cmpResult.toNumber() < 0;
         }
         return a.toString() < b.toString();
       });
+    auto result = makeArrayWithPrototype();
+    result->assignElements(std::move(sorted));
     return Value(result);
   });
 
   // Array.prototype.toSpliced
-  installArrayMethod("toSpliced", 2, [toObjectChecked, getArrayLikeLength, getArrayLikeElement](const std::vector<Value>& args) -> Value {
-    Value thisVal = toObjectChecked(args.empty() ? Value(Undefined{}) : args[0], "toSpliced");
-    size_t len = getArrayLikeLength(thisVal);
+  installArrayMethod("toSpliced", 2, [](const Value& thisValue, std::span<const Value> args, Interpreter& interp,
+                                        NativeThrow& thrown) -> Value {
+    Value thisVal = arrayToObject(thisValue, "toSpliced", interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
+    size_t len = arrayLikeLength(thisVal, interp, thrown);
+    if (thrown.pending) return Value(Undefined{});
     auto result = makeArrayWithPrototype();
     // Read all elements
     for (size_t i = 0; i < len; i++) {
-      auto [exists, elem] = getArrayLikeElement(thisVal, i);
-      result->elements.push_back(exists ? elem : Value(Undefined{}));
+      auto [exists, elem] = arrayLikeElement(thisVal, i, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
+      result->pushElement(exists ? elem : Value(Undefined{}));
     }
     int iLen = static_cast<int>(len);
-    if (args.size() < 2) return Value(result);
-    double startD = args[1].toNumber();
+    if (args.empty()) return Value(result);
+    double startD = args[0].toNumber();
     int start = std::isnan(startD) ? 0 : static_cast<int>(startD);
     if (start < 0) start = std::max(0, iLen + start);
     if (start > iLen) start = iLen;
     int deleteCount = 0;
-    if (args.size() >= 3) {
-      double dcD = args[2].toNumber();
+    if (args.size() >= 2) {
+      double dcD = args[1].toNumber();
       deleteCount = std::isnan(dcD) ? 0 : static_cast<int>(dcD);
       if (deleteCount < 0) deleteCount = 0;
       if (deleteCount > iLen - start) deleteCount = iLen - start;
     } else {
       deleteCount = iLen - start;
     }
-    std::vector<Value> newItems;
-    for (size_t i = 3; i < args.size(); ++i) {
-      newItems.push_back(args[i]);
-    }
-    result->elements.erase(result->elements.begin() + start, result->elements.begin() + start + deleteCount);
-    result->elements.insert(result->elements.begin() + start, newItems.begin(), newItems.end());
+    result->eraseElements(start, deleteCount);
+    if (args.size() > 2) result->insertElements(start, args.subspan(2));
     return Value(result);
   });
 
@@ -18203,20 +18191,20 @@ GCPtr<Environment> Environment::createGlobal() {
     arrayIteratorNext->properties["__non_enum_name"] = Value(true);
     arrayIteratorNext->properties["__non_writable_length"] = Value(true);
     arrayIteratorNext->properties["__non_enum_length"] = Value(true);
-    arrayIteratorNext->properties["__uses_this_arg__"] = Value(true);
     arrayIteratorNext->properties["__throw_on_new__"] = Value(true);
-    arrayIteratorNext->nativeFunc = [](const std::vector<Value>& args) -> Value {
-      if (args.empty() || !args[0].isObject()) {
-        throw std::runtime_error("TypeError: Array Iterator.prototype.next called on incompatible receiver");
+    setFastNative(*arrayIteratorNext, [](const Value& thisVal, std::span<const Value>, Interpreter& interp,
+                                         NativeThrow& thrown) -> Value {
+      if (!thisVal.isObject()) {
+        return thrown.error(ErrorType::TypeError, "Array Iterator.prototype.next called on incompatible receiver");
       }
-      auto iterObj = args[0].getGC<Object>();
+      auto iterObj = thisVal.getGC<Object>();
       auto targetIt = iterObj->properties.find("__array_iterator_target__");
       auto indexIt = iterObj->properties.find("__array_iterator_next_index__");
       auto kindIt = iterObj->properties.find("__array_iterator_kind__");
       if (targetIt == iterObj->properties.end() ||
           indexIt == iterObj->properties.end() ||
           kindIt == iterObj->properties.end()) {
-        throw std::runtime_error("TypeError: Array Iterator.prototype.next called on incompatible receiver");
+        return thrown.error(ErrorType::TypeError, "Array Iterator.prototype.next called on incompatible receiver");
       }
 
       Value target = targetIt->second;
@@ -18229,24 +18217,18 @@ GCPtr<Environment> Environment::createGlobal() {
       if (target.isTypedArray()) {
         auto ta = target.getGC<TypedArray>();
         if (ta->viewedBuffer && ta->viewedBuffer->detached) {
-          throw std::runtime_error("TypeError: Cannot perform Array Iterator.prototype.next on a detached TypedArray");
+          return thrown.error(ErrorType::TypeError,
+                              "Cannot perform Array Iterator.prototype.next on a detached TypedArray");
         }
       }
 
-      auto* interp = getGlobalInterpreter();
       size_t len = 0;
-      if (interp) {
-        auto [foundLen, lenVal] = interp->getPropertyForExternal(target, "length");
-        if (interp->hasError()) {
-          Value err = interp->getError();
-          interp->clearError();
-          throw JsValueException(err);
-        }
-        if (foundLen) {
-          double d = lenVal.toNumber();
-          if (!std::isnan(d) && d >= 0) {
-            len = static_cast<size_t>(d);
-          }
+      auto [foundLen, lenVal] = interp.getPropertyForExternal(target, "length");
+      if (takeInterpreterError(interp, thrown)) return Value(Undefined{});
+      if (foundLen) {
+        double d = lenVal.toNumber();
+        if (!std::isnan(d) && d >= 0) {
+          len = static_cast<size_t>(d);
         }
       }
 
@@ -18260,48 +18242,32 @@ GCPtr<Environment> Environment::createGlobal() {
         return makeIteratorResultObject(Value(static_cast<double>(index)), false);
       }
 
-      Value element = Value(Undefined{});
-      if (interp) {
-        auto [foundValue, value] = interp->getPropertyForExternal(target, std::to_string(index));
-        if (interp->hasError()) {
-          Value err = interp->getError();
-          interp->clearError();
-          throw JsValueException(err);
-        }
-        if (foundValue) {
-          element = value;
-        }
+      auto [foundValue, element] = arrayLikeElement(target, index, interp, thrown);
+      if (thrown.pending) return Value(Undefined{});
+      if (!foundValue) {
+        element = Value(Undefined{});
       }
 
       if (kind == 2) {
         auto entry = GarbageCollector::makeGC<Array>();
         GarbageCollector::instance().reportAllocation(sizeof(Array));
-        entry->elements.push_back(Value(static_cast<double>(index)));
-        entry->elements.push_back(element);
+        entry->pushElement(Value(static_cast<double>(index)));
+        entry->pushElement(element);
         return makeIteratorResultObject(Value(entry), false);
       }
 
       return makeIteratorResultObject(element, false);
-    };
+    }, true);
     arrayIteratorPrototype->properties["next"] = Value(arrayIteratorNext);
     arrayIteratorPrototype->properties["__non_enum_next"] = Value(true);
+    g_arrayIteratorPrototype = Value(arrayIteratorPrototype);
 
     auto arrayProtoIterator = GarbageCollector::makeGC<Function>();
-    arrayProtoIterator->isNative = true;
-    arrayProtoIterator->properties["__uses_this_arg__"] = Value(true);
     arrayProtoIterator->properties["__builtin_array_iterator__"] = Value(true);
-    arrayProtoIterator->nativeFunc = [arrayIteratorPrototype](const std::vector<Value>& args) -> Value {
-      Value thisVal = args.empty() ? Value(Undefined{}) : args[0];
-      if (thisVal.isNull() || thisVal.isUndefined()) {
-        throw std::runtime_error("TypeError: Cannot convert undefined or null to object");
-      }
-      auto iterObj = GarbageCollector::makeGC<Object>();
-      iterObj->properties["__proto__"] = Value(arrayIteratorPrototype);
-      iterObj->properties["__array_iterator_target__"] = thisVal;
-      iterObj->properties["__array_iterator_next_index__"] = Value(0.0);
-      iterObj->properties["__array_iterator_kind__"] = Value(0.0);
-      return Value(iterObj);
-    };
+    setFastNative(*arrayProtoIterator, [](const Value& thisVal, std::span<const Value>, Interpreter&,
+                          NativeThrow& thrown) -> Value {
+      return makeArrayIterator(thisVal, 0, thrown);
+    }, true);
     arrayPrototype->properties[iterKey] = Value(arrayProtoIterator);
     arrayPrototype->properties["__non_enum_" + iterKey] = Value(true);
 
@@ -18317,62 +18283,40 @@ GCPtr<Environment> Environment::createGlobal() {
 
     // Array.prototype.keys
     auto arrayProtoKeys = GarbageCollector::makeGC<Function>();
-    arrayProtoKeys->isNative = true;
-    arrayProtoKeys->properties["__uses_this_arg__"] = Value(true);
     arrayProtoKeys->properties["name"] = Value(std::string("keys"));
     arrayProtoKeys->properties["length"] = Value(0.0);
     arrayProtoKeys->properties["__non_writable_name"] = Value(true);
     arrayProtoKeys->properties["__non_enum_name"] = Value(true);
     arrayProtoKeys->properties["__non_writable_length"] = Value(true);
     arrayProtoKeys->properties["__non_enum_length"] = Value(true);
-    arrayProtoKeys->nativeFunc = [arrayIteratorPrototype](const std::vector<Value>& args) -> Value {
-      Value thisVal = args.empty() ? Value(Undefined{}) : args[0];
-      if (thisVal.isNull() || thisVal.isUndefined()) {
-        throw std::runtime_error("TypeError: Cannot convert undefined or null to object");
-      }
-      auto iterObj = GarbageCollector::makeGC<Object>();
-      iterObj->properties["__proto__"] = Value(arrayIteratorPrototype);
-      iterObj->properties["__array_iterator_target__"] = thisVal;
-      iterObj->properties["__array_iterator_next_index__"] = Value(0.0);
-      iterObj->properties["__array_iterator_kind__"] = Value(1.0);
-      return Value(iterObj);
-    };
+    setFastNative(*arrayProtoKeys, [](const Value& thisVal, std::span<const Value>, Interpreter&,
+                          NativeThrow& thrown) -> Value {
+      return makeArrayIterator(thisVal, 1, thrown);
+    }, true);
     arrayPrototype->properties["keys"] = Value(arrayProtoKeys);
     arrayPrototype->properties["__non_enum_keys"] = Value(true);
 
     // Array.prototype.entries
     auto arrayProtoEntries = GarbageCollector::makeGC<Function>();
-    arrayProtoEntries->isNative = true;
-    arrayProtoEntries->properties["__uses_this_arg__"] = Value(true);
     arrayProtoEntries->properties["name"] = Value(std::string("entries"));
     arrayProtoEntries->properties["length"] = Value(0.0);
     arrayProtoEntries->properties["__non_writable_name"] = Value(true);
     arrayProtoEntries->properties["__non_enum_name"] = Value(true);
     arrayProtoEntries->properties["__non_writable_length"] = Value(true);
     arrayProtoEntries->properties["__non_enum_length"] = Value(true);
-    arrayProtoEntries->nativeFunc = [arrayIteratorPrototype](const std::vector<Value>& args) -> Value {
-      Value thisVal = args.empty() ? Value(Undefined{}) : args[0];
-      if (thisVal.isNull() || thisVal.isUndefined()) {
-        throw std::runtime_error("TypeError: Cannot convert undefined or null to object");
-      }
-      auto iterObj = GarbageCollector::makeGC<Object>();
-      iterObj->properties["__proto__"] = Value(arrayIteratorPrototype);
-      iterObj->properties["__array_iterator_target__"] = thisVal;
-      iterObj->properties["__array_iterator_next_index__"] = Value(0.0);
-      iterObj->properties["__array_iterator_kind__"] = Value(2.0);
-      return Value(iterObj);
-    };
+    setFastNative(*arrayProtoEntries, [](const Value& thisVal, std::span<const Value>, Interpreter&,
+                          NativeThrow& thrown) -> Value {
+      return makeArrayIterator(thisVal, 2, thrown);
+    }, true);
     arrayPrototype->properties["entries"] = Value(arrayProtoEntries);
     arrayPrototype->properties["__non_enum_entries"] = Value(true);
   }
 
   // Array.isArray
   auto isArrayFn = GarbageCollector::makeGC<Function>();
-  isArrayFn->isNative = true;
-  isArrayFn->nativeFunc = [](const std::vector<Value>& args) -> Value {
-    if (args.empty()) return Value(false);
-    return Value(args[0].isArray());
-  };
+  setFastNative(*isArrayFn, [](const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) -> Value {
+    return Value(!args.empty() && args[0].isArray());
+  }, false);
   isArrayFn->properties["name"] = Value(std::string("isArray"));
   isArrayFn->properties["length"] = Value(1.0);
   isArrayFn->properties["__non_writable_name"] = Value(true);
@@ -18384,8 +18328,8 @@ GCPtr<Environment> Environment::createGlobal() {
 
   // Array.from - creates array from array-like or iterable object
   auto fromFn = GarbageCollector::makeGC<Function>();
-  fromFn->isNative = true;
-  fromFn->nativeFunc = [toPrimitive](const std::vector<Value>& args) -> Value {
+  setFastNative(*fromFn, [](const Value&, std::span<const Value> args, Interpreter& interp,
+                             NativeThrow& thrown) -> Value {
     auto result = GarbageCollector::makeGC<Array>();
 
     if (args.empty()) {
@@ -18398,69 +18342,45 @@ GCPtr<Environment> Environment::createGlobal() {
     bool hasMapFn = !mapFn.isUndefined();
 
     if (hasMapFn && !mapFn.isFunction()) {
-      throw std::runtime_error("TypeError: Array.from mapper must be a function");
+      return thrown.error(ErrorType::TypeError, "Array.from mapper must be a function");
     }
 
-    auto applyMap = [&](const Value& value, size_t index) -> Value {
+    // Appends value (mapped if there is a mapper); false once `thrown` is set
+    auto append = [&](const Value& value, size_t index) -> bool {
       if (!hasMapFn) {
-        return value;
-      }
-
-      std::vector<Value> mapperArgs = {value, Value(static_cast<double>(index))};
-      Interpreter* interpreter = getGlobalInterpreter();
-      if (interpreter) {
-        Value mapped = interpreter->callForHarness(mapFn, mapperArgs, thisArg);
-        if (interpreter->hasError()) {
-          Value err = interpreter->getError();
-          interpreter->clearError();
-          throw std::runtime_error(err.toString());
-        }
-        return mapped;
-      }
-
-      auto mapper = mapFn.getGC<Function>();
-      if (mapper->isNative) {
-        auto itUsesThis = mapper->properties.find("__uses_this_arg__");
-        if (itUsesThis != mapper->properties.end() && itUsesThis->second.isBool() && itUsesThis->second.toBool()) {
-          std::vector<Value> nativeArgs;
-          nativeArgs.reserve(mapperArgs.size() + 1);
-          nativeArgs.push_back(thisArg);
-          nativeArgs.insert(nativeArgs.end(), mapperArgs.begin(), mapperArgs.end());
-          return mapper->nativeFunc(nativeArgs);
-        }
-        return mapper->nativeFunc(mapperArgs);
+        result->pushElement(value);
+        return true;
       }
-
-      return value;
+      Value mapped = callArrayCallback(mapFn, {value, Value(static_cast<double>(index))}, thisArg, interp, thrown);
+      if (thrown.pending) return false;
+      result->pushElement(mapped);
+      return true;
     };
 
     // If it's already an array, copy it
     if (arrayLike.isArray()) {
       auto srcArray = arrayLike.getGC<Array>();
-      size_t index = 0;
-      for (const auto& elem : srcArray->elements) {
-        result->elements.push_back(applyMap(elem, index++));
+      for (size_t index = 0; index < srcArray->elementCount(); ++index) {
+        if (!append(srcArray->element(index), index)) return Value(Undefined{});
       }
       return Value(result);
     }
 
     if (arrayLike.isTypedArray()) {
       auto srcTypedArray = arrayLike.getGC<TypedArray>();
-      size_t index = 0;
       size_t length = srcTypedArray->currentLength();
       for (size_t i = 0; i < length; ++i) {
-        result->elements.push_back(
-          applyMap(Value(srcTypedArray->getElement(i)), index++));
+        if (!append(Value(srcTypedArray->getElement(i)), i)) return Value(Undefined{});
       }
       return Value(result);
     }
 
     // If it's a string, convert each character to array element
     if (arrayLike.isString()) {
-      std::string str = std::get<std::string>(arrayLike.data);
+      const std::string& str = arrayLike.asString();
       size_t index = 0;
       for (char c : str) {
-        result->elements.push_back(applyMap(Value(std::string(1, c)), index++));
+        if (!append(Value(std::string(1, c)), index++)) return Value(Undefined{});
       }
       return Value(result);
     }
@@ -18477,25 +18397,13 @@ GCPtr<Environment> Environment::createGlobal() {
       if (iteratorMethodIt != srcObj->properties.end()) {
         iteratorMethod = iteratorMethodIt->second;
       } else {
-        Interpreter* interpForIter = getGlobalInterpreter();
-        if (interpForIter) {
-          auto [found, val] = interpForIter->getPropertyForExternal(arrayLike, iteratorKey);
-          if (found) iteratorMethod = val;
-        }
+        auto [found, val] = interp.getPropertyForExternal(arrayLike, iteratorKey);
+        if (takeInterpreterError(interp, thrown)) return Value(Undefined{});
+        if (found) iteratorMethod = val;
       }
       if (iteratorMethod.isFunction()) {
-        Interpreter* interpreter = getGlobalInterpreter();
-        if (interpreter) {
-          iteratorValue = interpreter->callForHarness(iteratorMethod, {}, arrayLike);
-          if (interpreter->hasError()) {
-            Value err = interpreter->getError();
-            interpreter->clearError();
-            throw std::runtime_error(err.toString());
-          }
-        } else {
-          auto iterMethod = iteratorMethod.getGC<Function>();
-          iteratorValue = iterMethod->isNative ? iterMethod->nativeFunc({}) : Value(Undefined{});
-        }
+        iteratorValue = callArrayCallback(iteratorMethod, {}, arrayLike, interp, thrown);
+        if (thrown.pending) return Value(Undefined{});
       }
 
       if (iteratorValue.isObject()) {
@@ -18507,24 +18415,14 @@ GCPtr<Environment> Environment::createGlobal() {
           nextMethod = nextIt->second;
         } else {
           auto [foundN, nv] = getPropertyLike(iteratorValue, "next", iteratorValue);
+          if (takeInterpreterError(interp, thrown)) return Value(Undefined{});
           if (foundN) nextMethod = nv;
         }
         if (nextMethod.isFunction()) {
           size_t index = 0;
           while (true) {
-            Value stepResult;
-            Interpreter* interpreter = getGlobalInterpreter();
-            if (interpreter) {
-              stepResult = interpreter->callForHarness(nextMethod, {}, iteratorValue);
-              if (interpreter->hasError()) {
-                Value err = interpreter->getError();
-                interpreter->clearError();
-                throw std::runtime_error(err.toString());
-              }
-            } else {
-              auto nextFn = nextMethod.getGC<Function>();
-              stepResult = nextFn->isNative ? nextFn->nativeFunc({}) : Value(Undefined{});
-            }
+            Value stepResult = callArrayCallback(nextMethod, {}, iteratorValue, interp, thrown);
+            if (thrown.pending) return Value(Undefined{});
 
             if (!stepResult.isObject()) break;
             auto stepObj = stepResult.getGC<Object>();
@@ -18538,17 +18436,22 @@ GCPtr<Environment> Environment::createGlobal() {
             if (auto valueIt = stepObj->properties.find("value"); valueIt != stepObj->properties.end()) {
               element = valueIt->second;
             }
-            result->elements.push_back(applyMap(element, index++));
+            if (!append(element, index++)) return Value(Undefined{});
           }
           return Value(result);
         }
       }
 
       auto [foundLength, lengthValue] = getPropertyLike(arrayLike, "length", arrayLike);
+      if (takeInterpreterError(interp, thrown)) return Value(Undefined{});
       if (foundLength) {
-        Value numericLength = isObjectLikeValue(lengthValue) ? toPrimitive(lengthValue, false) : lengthValue;
+        Value numericLength = lengthValue;
+        if (isObjectLikeValue(lengthValue)) {
+          numericLength = interp.toPrimitive(lengthValue, false);
+          if (takeInterpreterError(interp, thrown)) return Value(Undefined{});
+        }
         if (numericLength.isBigInt() || numericLength.isSymbol()) {
-          throw std::runtime_error("TypeError: Invalid array-like length");
+          return thrown.error(ErrorType::TypeError, "Invalid array-like length");
         }
         double rawLength = numericLength.toNumber();
         size_t length = 0;
@@ -18566,7 +18469,8 @@ GCPtr<Environment> Environment::createGlobal() {
 
         for (size_t i = 0; i < length; ++i) {
           auto [foundValue, element] = getPropertyLike(arrayLike, std::to_string(i), arrayLike);
-          result->elements.push_back(applyMap(foundValue ? element : Value(Undefined{}), i));
+          if (takeInterpreterError(interp, thrown)) return Value(Undefined{});
+          if (!append(foundValue ? element : Value(Undefined{}), i)) return Value(Undefined{});
         }
         return Value(result);
       }
@@ -18574,7 +18478,7 @@ GCPtr<Environment> Environment::createGlobal() {
 
     // Otherwise return empty array
     return Value(result);
-  };
+  }, false);
   fromFn->properties["name"] = Value(std::string("from"));
   fromFn->properties["length"] = Value(1.0);
   fromFn->properties["__non_writable_name"] = Value(true);
@@ -18586,12 +18490,11 @@ GCPtr<Environment> Environment::createGlobal() {
 
   // Array.of - creates array from arguments
   auto ofFn = GarbageCollector::makeGC<Function>();
-  ofFn->isNative = true;
-  ofFn->nativeFunc = [](const std::vector<Value>& args) -> Value {
+  setFastNative(*ofFn, [](const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) -> Value {
     auto result = GarbageCollector::makeGC<Array>();
-    result->elements = args;
+    result->assignElements(std::vector<Value>(args.begin(), args.end()));
     return Value(result);
-  };
+  }, false);
   ofFn->properties["name"] = Value(std::string("of"));
   ofFn->properties["length"] = Value(0.0);
   ofFn->properties["__non_writable_name"] = Value(true);
@@ -18688,7 +18591,7 @@ GCPtr<Environment> Environment::createGlobal() {
     int depth = 0;
     while (isObjectLikeValue(current) && depth <= 16) {
       depth++;
-      OrderedMap<std::string, Value>* bag = nullptr;
+      PropertyMap* bag = nullptr;
       if (current.isObject()) {
         bag = &current.getGC<Object>()->properties;
       } else if (current.isFunction()) {
@@ -19459,7 +19362,7 @@ GCPtr<Environment> Environment::createGlobal() {
         }
         if (key == "length") {
           found = true;
-          out = Value(static_cast<double>(arr->elements.size()));
+          out = Value(static_cast<double>(arr->elementCount()));
           return true;
         }
         if (auto arrayCtor = env->get("Array"); arrayCtor && arrayCtor->isObject()) {
@@ -19572,7 +19475,7 @@ GCPtr<Environment> Environment::createGlobal() {
     auto finalizeIfDone = [env, remaining, values, fulfillResult]() {
       if (*remaining == 0) {
         auto resultArray = GarbageCollector::makeGC<Array>();
-        resultArray->elements = values->elements;
+        resultArray->assignElements(values->elements());
         if (auto arrayCtor = env->get("Array"); arrayCtor && arrayCtor->isObject()) {
           auto arrayObjPtr = std::get<GCPtr<Object>>(arrayCtor->data);
           auto protoIt = arrayObjPtr->properties.find("prototype");
@@ -19585,8 +19488,8 @@ GCPtr<Environment> Environment::createGlobal() {
     };
 
     auto processElement = [&](size_t index, const Value& nextValue, Value& failureReason) -> bool {
-      if (values->elements.size() <= index) {
-        values->elements.resize(index + 1, Value(Undefined{}));
+      if (values->elementCount() <= index) {
+        values->elements().resize(index + 1, Value(Undefined{}));
       }
 
       (*remaining)++;
@@ -19607,7 +19510,7 @@ GCPtr<Environment> Environment::createGlobal() {
           return Value(Undefined{});
         }
         *alreadyCalled = true;
-        values->elements[index] = innerArgs.empty() ? Value(Undefined{}) : innerArgs[0];
+        values->setElement(index, innerArgs.empty() ? Value(Undefined{}) : innerArgs[0]);
         (*remaining)--;
         finalizeIfDone();
         return Value(Undefined{});
@@ -19725,14 +19628,14 @@ GCPtr<Environment> Environment::createGlobal() {
     }
     if (useArrayFastPath) {
       auto arr = iterable.getGC<Array>();
-      for (const auto& value : arr->elements) {
+      for (const auto& value : arr->elements()) {
         Value failureReason;
         if (!processElement(nextIndex++, value, failureReason)) {
           return rejectAndReturn(failureReason);
         }
       }
     } else if (iterable.isString()) {
-      const auto& str = std::get<std::string>(iterable.data);
+      const auto& str = iterable.asString();
       for (char c : str) {
         Value failureReason;
         if (!processElement(nextIndex++, Value(std::string(1, c)), failureReason)) {
@@ -20023,7 +19926,7 @@ GCPtr<Environment> Environment::createGlobal() {
         }
         if (key == "length") {
           found = true;
-          out = Value(static_cast<double>(arr->elements.size()));
+          out = Value(static_cast<double>(arr->elementCount()));
           return true;
         }
         if (auto arrayCtor = env->get("Array"); arrayCtor && arrayCtor->isObject()) {
@@ -20178,14 +20081,14 @@ GCPtr<Environment> Environment::createGlobal() {
     auto finalizeIfDone = [remaining, results, resolveResultPromise]() {
       if (*remaining == 0) {
         auto valuesArray = makeArrayWithPrototype();
-        valuesArray->elements = results->elements;
+        valuesArray->assignElements(results->elements());
         (*resolveResultPromise)(Value(valuesArray));
       }
     };
 
     auto processElement = [&](size_t index, const Value& nextValue, Value& failureReason) -> bool {
-      if (results->elements.size() <= index) {
-        results->elements.resize(index + 1, Value(Undefined{}));
+      if (results->elementCount() <= index) {
+        results->elements().resize(index + 1, Value(Undefined{}));
       }
 
       (*remaining)++;
@@ -20210,7 +20113,7 @@ GCPtr<Environment> Environment::createGlobal() {
         auto entry = GarbageCollector::makeGC<Object>();
         entry->properties["status"] = Value(std::string("fulfilled"));
         entry->properties["value"] = settledValue;
-        results->elements[index] = Value(entry);
+        results->setElement(index, Value(entry));
         (*remaining)--;
         finalizeIfDone();
         return Value(Undefined{});
@@ -20229,7 +20132,7 @@ GCPtr<Environment> Environment::createGlobal() {
         auto entry = GarbageCollector::makeGC<Object>();
         entry->properties["status"] = Value(std::string("rejected"));
         entry->properties["reason"] = settledReason;
-        results->elements[index] = Value(entry);
+        results->setElement(index, Value(entry));
         (*remaining)--;
         finalizeIfDone();
         return Value(Undefined{});
@@ -20344,14 +20247,14 @@ GCPtr<Environment> Environment::createGlobal() {
     }
     if (useArrayFastPath) {
       auto arr = iterable.getGC<Array>();
-      for (const auto& value : arr->elements) {
+      for (const auto& value : arr->elements()) {
         Value failureReason;
         if (!processElement(nextIndex++, value, failureReason)) {
           return rejectAndReturn(failureReason);
         }
       }
     } else if (iterable.isString()) {
-      const auto& str = std::get<std::string>(iterable.data);
+      const auto& str = iterable.asString();
       for (char c : str) {
         Value failureReason;
         if (!processElement(nextIndex++, Value(std::string(1, c)), failureReason)) {
@@ -20492,7 +20395,7 @@ GCPtr<Environment> Environment::createGlobal() {
 
     auto keysArray = keysValue.getGC<Array>();
     auto resultObject = makeObjectWithPrototype();
-    if (keysArray->elements.empty()) {
+    if (keysArray->elements().empty()) {
       try {
         callChecked(resolve, {Value(resultObject)}, Value(Undefined{}));
       } catch (...) {
@@ -20500,7 +20403,7 @@ GCPtr<Environment> Environment::createGlobal() {
       return resultPromise;
     }
 
-    auto remaining = std::make_shared<size_t>(keysArray->elements.size());
+    auto remaining = std::make_shared<size_t>(keysArray->elementCount());
     auto alreadyRejected = std::make_shared<bool>(false);
     auto resolveIfDone = [remaining, alreadyRejected, resolve, resultObject, callChecked]() {
       if (*remaining != 0 || *alreadyRejected) {
@@ -20522,7 +20425,7 @@ GCPtr<Environment> Environment::createGlobal() {
       }
     };
 
-    for (const auto& keyValue : keysArray->elements) {
+    for (const auto& keyValue : keysArray->elements()) {
       std::string key = keyValue.toString();
       Value nextValue = Value(Undefined{});
       try {
@@ -20665,7 +20568,7 @@ GCPtr<Environment> Environment::createGlobal() {
 
     auto keysArray = keysValue.getGC<Array>();
     auto resultObject = makeObjectWithPrototype();
-    if (keysArray->elements.empty()) {
+    if (keysArray->elements().empty()) {
       try {
         callChecked(resolve, {Value(resultObject)}, Value(Undefined{}));
       } catch (...) {
@@ -20673,7 +20576,7 @@ GCPtr<Environment> Environment::createGlobal() {
       return resultPromise;
     }
 
-    auto remaining = std::make_shared<size_t>(keysArray->elements.size());
+    auto remaining = std::make_shared<size_t>(keysArray->elementCount());
     auto alreadyRejected = std::make_shared<bool>(false);
     auto resolveIfDone = [remaining, alreadyRejected, resolve, resultObject, callChecked]() {
       if (*remaining != 0 || *alreadyRejected) {
@@ -20695,7 +20598,7 @@ GCPtr<Environment> Environment::createGlobal() {
       }
     };
 
-    for (const auto& keyValue : keysArray->elements) {
+    for (const auto& keyValue : keysArray->elements()) {
       std::string key = keyValue.toString();
       Value nextValue = Value(Undefined{});
       try {
@@ -20940,7 +20843,7 @@ GCPtr<Environment> Environment::createGlobal() {
         }
         if (key == "length") {
           found = true;
-          out = Value(static_cast<double>(arr->elements.size()));
+          out = Value(static_cast<double>(arr->elementCount()));
           return true;
         }
         if (auto arrayCtor = env->get("Array"); arrayCtor && arrayCtor->isObject()) {
@@ -20976,7 +20879,7 @@ GCPtr<Environment> Environment::createGlobal() {
 
     auto makeArrayWithProto = [env](const std::vector<Value>& elements) -> Value {
       auto array = GarbageCollector::makeGC<Array>();
-      array->elements = elements;
+      array->assignElements(elements);
       if (auto arrayCtor = env->get("Array"); arrayCtor && arrayCtor->isObject()) {
         auto arrayObjPtr = std::get<GCPtr<Object>>(arrayCtor->data);
         auto protoIt = arrayObjPtr->properties.find("prototype");
@@ -21219,14 +21122,14 @@ GCPtr<Environment> Environment::createGlobal() {
     }
     if (useArrayFastPath) {
       auto arr = iterable.getGC<Array>();
-      for (const auto& value : arr->elements) {
+      for (const auto& value : arr->elements()) {
         Value failureReason;
         if (!processElement(nextIndex++, value, failureReason)) {
           return rejectAndReturn(failureReason);
         }
       }
     } else if (iterable.isString()) {
-      const auto& str = std::get<std::string>(iterable.data);
+      const auto& str = iterable.asString();
       for (char c : str) {
         Value failureReason;
         if (!processElement(nextIndex++, Value(std::string(1, c)), failureReason)) {
@@ -21460,7 +21363,7 @@ GCPtr<Environment> Environment::createGlobal() {
         }
         if (key == "length") {
           found = true;
-          out = Value(static_cast<double>(arr->elements.size()));
+          out = Value(static_cast<double>(arr->elementCount()));
           return true;
         }
         if (auto arrayCtor = env->get("Array"); arrayCtor && arrayCtor->isObject()) {
@@ -21669,7 +21572,7 @@ GCPtr<Environment> Environment::createGlobal() {
     }
     if (useArrayFastPath) {
       auto arr = iterable.getGC<Array>();
-      for (const auto& value : arr->elements) {
+      for (const auto& value : arr->elements()) {
         Value failureReason;
         if (!processElement(value, failureReason)) {
           return rejectAndReturn(failureReason);
@@ -21679,7 +21582,7 @@ GCPtr<Environment> Environment::createGlobal() {
     }
 
     if (iterable.isString()) {
-      const auto& str = std::get<std::string>(iterable.data);
+      const auto& str = iterable.asString();
       for (char c : str) {
         Value failureReason;
         if (!processElement(Value(std::string(1, c)), failureReason)) {
@@ -21939,8 +21842,7 @@ GCPtr<Environment> Environment::createGlobal() {
 
   // JSON.parse
   auto jsonParse = GarbageCollector::makeGC<Function>();
-  jsonParse->isNative = true;
-  jsonParse->nativeFunc = JSON_parse;
+  setFastNative(*jsonParse, JSON_parse, false);
   jsonParse->properties["name"] = Value(std::string("parse"));
   jsonParse->properties["length"] = Value(2.0);
   jsonParse->properties["__non_writable_name"] = Value(true);
@@ -22142,7 +22044,7 @@ GCPtr<Environment> Environment::createGlobal() {
 
     if (!ctorName.empty()) {
       if (auto ctor = env->get(ctorName)) {
-        OrderedMap<std::string, Value>* ctorProps = nullptr;
+        PropertyMap* ctorProps = nullptr;
         if (ctor->isFunction()) {
           ctorProps = &ctor->getGC<Function>()->properties;
         } else if (ctor->isObject()) {
@@ -22223,7 +22125,7 @@ GCPtr<Environment> Environment::createGlobal() {
       auto isSameProto = [&]() -> bool {
         if (!currentProto.has_value()) return proto.isNull();
         if (currentProto->isNull() && proto.isNull()) return true;
-        if (currentProto->data.index() != proto.data.index()) return false;
+        if (!currentProto->hasSameType(proto)) return false;
         if (currentProto->isObject() && proto.isObject())
           return currentProto->getGC<Object>().get() == proto.getGC<Object>().get();
         if (currentProto->isFunction() && proto.isFunction())
@@ -22239,7 +22141,7 @@ GCPtr<Environment> Environment::createGlobal() {
           return !o->nonExtensible && !o->sealed && !o->frozen &&
                  o->properties.find("__non_extensible__") == o->properties.end();
         }
-        auto getProps = [](const Value& val) -> const OrderedMap<std::string, Value>* {
+        auto getProps = [](const Value& val) -> const PropertyMap* {
           if (val.isArray()) return &val.getGC<Array>()->properties;
           if (val.isFunction()) return &val.getGC<Function>()->properties;
           if (val.isClass()) return &val.getGC<Class>()->properties;
@@ -22259,7 +22161,7 @@ GCPtr<Environment> Environment::createGlobal() {
       Value checkProto = proto;
       for (int depth = 0; depth < 100 && !checkProto.isNull() && !checkProto.isUndefined(); ++depth) {
         // SameValue(p, O)
-        if (checkProto.data.index() == thisVal.data.index()) {
+        if (checkProto.hasSameType(thisVal)) {
           bool same = false;
           if (checkProto.isObject() && thisVal.isObject())
             same = checkProto.getGC<Object>().get() == thisVal.getGC<Object>().get();
@@ -22448,7 +22350,7 @@ GCPtr<Environment> Environment::createGlobal() {
   objectProtoHasOwnProperty->properties["length"] = Value(1.0);
   objectProtoHasOwnProperty->properties["__non_writable_length"] = Value(true);
   objectProtoHasOwnProperty->properties["__non_enum_length"] = Value(true);
-  objectProtoHasOwnProperty->nativeFunc = Object_hasOwnProperty;
+  setFastNative(*objectProtoHasOwnProperty, Object_hasOwnProperty, true);
   objectPrototype->properties["hasOwnProperty"] = Value(objectProtoHasOwnProperty);
   objectPrototype->properties["__non_enum_hasOwnProperty"] = Value(true);
 
@@ -22470,7 +22372,7 @@ GCPtr<Environment> Environment::createGlobal() {
              value.isDataView() || value.isError() || value.isProxy();
     };
     auto sameReference = [](const Value& a, const Value& b) -> bool {
-      if (a.data.index() != b.data.index()) return false;
+      if (!a.hasSameType(b)) return false;
       if (a.isObject()) return a.getGC<Object>().get() == b.getGC<Object>().get();
       if (a.isArray()) return a.getGC<Array>().get() == b.getGC<Array>().get();
       if (a.isFunction()) return a.getGC<Function>().get() == b.getGC<Function>().get();
@@ -22608,7 +22510,7 @@ GCPtr<Environment> Environment::createGlobal() {
       else if (v.isBigInt()) ctorName = "BigInt";
       else if (v.isSymbol()) ctorName = "Symbol";
       if (auto ctor = env->get(ctorName)) {
-        OrderedMap<std::string, Value>* ctorProps = nullptr;
+        PropertyMap* ctorProps = nullptr;
         if (ctor->isFunction()) ctorProps = &ctor->getGC<Function>()->properties;
         else if (ctor->isObject()) ctorProps = &ctor->getGC<Object>()->properties;
         else if (ctor->isClass()) ctorProps = &ctor->getGC<Class>()->properties;
@@ -22718,7 +22620,7 @@ GCPtr<Environment> Environment::createGlobal() {
         throw JsValueException(err);
       }
       if (found && tagVal.isString()) {
-        tag = std::get<std::string>(tagVal.data);
+        tag = tagVal.asString();
       }
     }
 
@@ -22903,7 +22805,7 @@ GCPtr<Environment> Environment::createGlobal() {
       };
       size_t idx = 0;
       if (isCanonicalArrayIndex(key, idx)) {
-        bool exists = idx < arr->elements.size() ||
+        bool exists = idx < arr->elementCount() ||
                       arr->properties.find(key) != arr->properties.end() ||
                       arr->properties.find("__get_" + key) != arr->properties.end() ||
                       arr->properties.find("__set_" + key) != arr->properties.end();
@@ -22939,7 +22841,7 @@ GCPtr<Environment> Environment::createGlobal() {
     Value current = args[0];
     std::string key = valueToPropertyKey(args[1]);
 
-    auto getProps = [](const Value& v) -> OrderedMap<std::string, Value>* {
+    auto getProps = [](const Value& v) -> PropertyMap* {
       if (v.isObject()) return &v.getGC<Object>()->properties;
       if (v.isArray()) return &v.getGC<Array>()->properties;
       if (v.isFunction()) return &v.getGC<Function>()->properties;
@@ -22982,7 +22884,7 @@ GCPtr<Environment> Environment::createGlobal() {
     }
     std::string key = valueToPropertyKey(args[1]);
     std::string markerPrefix = isGetter ? "__get_" : "__set_";
-    auto setOnProps = [&](OrderedMap<std::string, Value>& props) {
+    auto setOnProps = [&](PropertyMap& props) {
       if (props.find("__non_configurable_" + key) != props.end()) {
         throw std::runtime_error("TypeError: Cannot redefine property: " + key);
       }
@@ -23063,7 +22965,7 @@ GCPtr<Environment> Environment::createGlobal() {
     Value current = args[0];
     std::string key = valueToPropertyKey(args[1]);
 
-    auto getProps = [](const Value& v) -> OrderedMap<std::string, Value>* {
+    auto getProps = [](const Value& v) -> PropertyMap* {
       if (v.isObject()) return &v.getGC<Object>()->properties;
       if (v.isArray()) return &v.getGC<Array>()->properties;
       if (v.isFunction()) return &v.getGC<Function>()->properties;
@@ -23145,7 +23047,7 @@ GCPtr<Environment> Environment::createGlobal() {
   // Object.hasOwnProperty (for prototypal access)
   auto objectHasOwnProperty = GarbageCollector::makeGC<Function>();
   objectHasOwnProperty->isNative = true;
-  objectHasOwnProperty->nativeFunc = Object_hasOwnProperty;
+  objectHasOwnProperty->nativeFunc = objectProtoHasOwnProperty->nativeFunc;
   objectConstructor->properties["hasOwnProperty"] = Value(objectHasOwnProperty);
 
   // Object.getOwnPropertyNames
@@ -23168,7 +23070,7 @@ GCPtr<Environment> Environment::createGlobal() {
       throw std::runtime_error("TypeError: Cannot convert undefined or null to object");
     }
     Value target = args[0];
-    OrderedMap<std::string, Value>* props = nullptr;
+    PropertyMap* props = nullptr;
     GCPtr<Object> obj;
     if (target.isObject()) {
       obj = target.getGC<Object>();
@@ -23191,19 +23093,19 @@ GCPtr<Environment> Environment::createGlobal() {
     }
     auto appendSymbolForKey = [&](const std::string& key) {
       if (key == WellKnownSymbols::iteratorKey()) {
-        result->elements.push_back(WellKnownSymbols::iterator());
+        result->pushElement(WellKnownSymbols::iterator());
       } else if (key == WellKnownSymbols::asyncIteratorKey()) {
-        result->elements.push_back(WellKnownSymbols::asyncIterator());
+        result->pushElement(WellKnownSymbols::asyncIterator());
       } else if (key == WellKnownSymbols::toStringTagKey()) {
-        result->elements.push_back(WellKnownSymbols::toStringTag());
+        result->pushElement(WellKnownSymbols::toStringTag());
       } else if (key == WellKnownSymbols::toPrimitiveKey()) {
-        result->elements.push_back(WellKnownSymbols::toPrimitive());
+        result->pushElement(WellKnownSymbols::toPrimitive());
       } else if (key == WellKnownSymbols::matchAllKey()) {
-        result->elements.push_back(WellKnownSymbols::matchAll());
+        result->pushElement(WellKnownSymbols::matchAll());
       } else {
         Symbol symbolValue;
         if (propertyKeyToSymbol(key, symbolValue)) {
-          result->elements.push_back(Value(symbolValue));
+          result->pushElement(Value(symbolValue));
         }
       }
     };
@@ -23262,7 +23164,7 @@ GCPtr<Environment> Environment::createGlobal() {
           group = makeArrayWithPrototype();
           result->properties[key] = Value(group);
         }
-        group->elements.push_back(element);
+        group->pushElement(element);
       };
 
       // Use iterator protocol
@@ -23342,7 +23244,7 @@ GCPtr<Environment> Environment::createGlobal() {
       if (isNum) {
         try {
           size_t idx = std::stoul(key);
-          if (idx < arr->elements.size()) return Value(true);
+          if (idx < arr->elementCount()) return Value(true);
         } catch (...) {}
       }
       // Check named properties (including symbol keys)
@@ -23575,7 +23477,7 @@ GCPtr<Environment> Environment::createGlobal() {
       else if (args[0].isNumber()) ctorName = "Number";
       else ctorName = "Boolean";
       if (auto ctor = env->get(ctorName)) {
-        OrderedMap<std::string, Value>* ctorProps = nullptr;
+        PropertyMap* ctorProps = nullptr;
         if (ctor->isFunction()) ctorProps = &ctor->getGC<Function>()->properties;
         else if (ctor->isObject()) ctorProps = &ctor->getGC<Object>()->properties;
         else if (ctor->isClass()) ctorProps = &ctor->getGC<Class>()->properties;
@@ -23688,7 +23590,7 @@ GCPtr<Environment> Environment::createGlobal() {
       return Value(false);
     }
     // Check __non_extensible__ flag on properties
-    auto checkExtensible = [](const OrderedMap<std::string, Value>& props) -> bool {
+    auto checkExtensible = [](const PropertyMap& props) -> bool {
       auto it = props.find("__non_extensible__");
       return !(it != props.end() && it->second.isBool() && it->second.toBool());
     };
@@ -23721,7 +23623,7 @@ GCPtr<Environment> Environment::createGlobal() {
         target.isNumber() || target.isString() || target.isBigInt() || target.isSymbol()) {
       return target;
     }
-    auto setNonExtensible = [](OrderedMap<std::string, Value>& props) {
+    auto setNonExtensible = [](PropertyMap& props) {
       props["__non_extensible__"] = Value(true);
     };
     if (target.isObject()) {
@@ -23755,7 +23657,7 @@ GCPtr<Environment> Environment::createGlobal() {
       return target;
     }
     // Set frozen/sealed flags on the appropriate properties map
-    auto setFrozen = [](OrderedMap<std::string, Value>& props) {
+    auto setFrozen = [](PropertyMap& props) {
       props["__frozen__"] = Value(true);
       props["__sealed__"] = Value(true);
       props["__non_extensible__"] = Value(true);
@@ -23784,7 +23686,7 @@ GCPtr<Environment> Environment::createGlobal() {
       auto arr = target.getGC<Array>();
       setFrozen(arr->properties);
       // Freeze array elements (make non-writable)
-      for (size_t i = 0; i < arr->elements.size(); ++i) {
+      for (size_t i = 0; i < arr->elementCount(); ++i) {
         arr->properties["__non_writable_" + std::to_string(i)] = Value(true);
         arr->properties["__non_configurable_" + std::to_string(i)] = Value(true);
       }
@@ -23819,7 +23721,7 @@ GCPtr<Environment> Environment::createGlobal() {
         target.isNumber() || target.isString() || target.isBigInt() || target.isSymbol()) {
       return target;
     }
-    auto setSealed = [](OrderedMap<std::string, Value>& props) {
+    auto setSealed = [](PropertyMap& props) {
       props["__sealed__"] = Value(true);
       props["__non_extensible__"] = Value(true);
       auto keys = props.orderedKeys(); // copy to avoid modification during iteration
@@ -24004,7 +23906,7 @@ GCPtr<Environment> Environment::createGlobal() {
     Value b = args.size() > 1 ? args[1] : Value(Undefined{});
 
     // Check for same type
-    if (a.data.index() != b.data.index()) return Value(false);
+    if (!a.hasSameType(b)) return Value(false);
 
     // Handle numbers specially (NaN === NaN, +0 !== -0)
     if (a.isNumber() && b.isNumber()) {
@@ -24023,13 +23925,13 @@ GCPtr<Environment> Environment::createGlobal() {
       return Value(std::get<bool>(a.data) == std::get<bool>(b.data));
     }
     if (a.isString() && b.isString()) {
-      return Value(std::get<std::string>(a.data) == std::get<std::string>(b.data));
+      return Value(a.asString() == b.asString());
     }
     if (a.isBigInt() && b.isBigInt()) {
       return Value(a.toBigInt() == b.toBigInt());
     }
     if (a.isSymbol() && b.isSymbol()) {
-      return Value(std::get<Symbol>(a.data) == std::get<Symbol>(b.data));
+      return Value(a.asSymbol() == b.asSymbol());
     }
     // For objects, check reference equality
     if (a.isObject() && b.isObject()) {
@@ -24081,7 +23983,7 @@ GCPtr<Environment> Environment::createGlobal() {
     }
     // Handle string primitives: box to object with indexed char properties
     if (args[0].isString()) {
-      const std::string& str = std::get<std::string>(args[0].data);
+      const std::string& str = args[0].asString();
       auto descriptor = GarbageCollector::makeGC<Object>();
       GarbageCollector::instance().reportAllocation(sizeof(Object));
       // Check for numeric index
@@ -24333,7 +24235,7 @@ GCPtr<Environment> Environment::createGlobal() {
         if (overriddenIt != arr->properties.end()) {
           descriptor->properties["value"] = overriddenIt->second;
         } else {
-          descriptor->properties["value"] = Value(static_cast<double>(arr->elements.size()));
+          descriptor->properties["value"] = Value(static_cast<double>(arr->elementCount()));
         }
         bool writable = arr->properties.find("__non_writable_length") == arr->properties.end();
         descriptor->properties["writable"] = Value(writable);
@@ -24380,7 +24282,7 @@ GCPtr<Environment> Environment::createGlobal() {
         auto setterIt = arr->properties.find("__set_" + key);
         bool hasAccessor = getterIt != arr->properties.end() || setterIt != arr->properties.end();
         bool isDeleted = arr->properties.find("__deleted_" + key + "__") != arr->properties.end();
-        bool hasData = (idx < arr->elements.size() && !isDeleted) || arr->properties.find(key) != arr->properties.end();
+        bool hasData = (idx < arr->elementCount() && !isDeleted) || arr->properties.find(key) != arr->properties.end();
         if (!hasAccessor && !hasData) {
           return Value(Undefined{});
         }
@@ -24405,8 +24307,8 @@ GCPtr<Environment> Environment::createGlobal() {
             descriptor->properties["set"] = Value(Undefined{});
           }
         } else {
-          if (idx < arr->elements.size()) {
-            descriptor->properties["value"] = arr->elements[idx];
+          if (idx < arr->elementCount()) {
+            descriptor->properties["value"] = arr->element(idx);
           } else {
             descriptor->properties["value"] = arr->properties.at(key);
           }
@@ -24505,7 +24407,7 @@ GCPtr<Environment> Environment::createGlobal() {
     }
 
     if (args[0].isTypedArray() || args[0].isArrayBuffer() || args[0].isDataView()) {
-      const OrderedMap<std::string, Value>* bag = nullptr;
+      const PropertyMap* bag = nullptr;
       if (args[0].isTypedArray()) {
         bag = &args[0].getGC<TypedArray>()->properties;
       } else if (args[0].isArrayBuffer()) {
@@ -24541,7 +24443,7 @@ GCPtr<Environment> Environment::createGlobal() {
 
     // Generic handler for Map, Set, WeakMap, WeakSet, Generator (all use OrderedMap properties)
     if (args[0].isMap() || args[0].isSet() || args[0].isWeakMap() || args[0].isWeakSet() || args[0].isGenerator()) {
-      const OrderedMap<std::string, Value>* bag = nullptr;
+      const PropertyMap* bag = nullptr;
       if (args[0].isMap()) bag = &args[0].getGC<Map>()->properties;
       else if (args[0].isSet()) bag = &args[0].getGC<Set>()->properties;
       else if (args[0].isWeakMap()) bag = &args[0].getGC<WeakMap>()->properties;
@@ -24587,7 +24489,7 @@ GCPtr<Environment> Environment::createGlobal() {
       // String wrapper objects: expose indexed character properties
       auto primIt = obj->properties.find("__primitive_value__");
       if (primIt != obj->properties.end() && primIt->second.isString()) {
-        const std::string& str = std::get<std::string>(primIt->second.data);
+        const std::string& str = primIt->second.asString();
         if (!key.empty() && key[0] >= '0' && key[0] <= '9') {
           bool allDigits = true;
           for (char c : key) { if (!std::isdigit(static_cast<unsigned char>(c))) { allDigits = false; break; } }
@@ -24814,7 +24716,7 @@ GCPtr<Environment> Environment::createGlobal() {
 
     // Handle string primitives: enumerate indices + length
     if (args[0].isString()) {
-      const std::string& str = std::get<std::string>(args[0].data);
+      const std::string& str = args[0].asString();
       size_t cpCount = 0;
       size_t bytePos = 0;
       while (bytePos < str.size()) {
@@ -24841,7 +24743,7 @@ GCPtr<Environment> Environment::createGlobal() {
     }
 
     // Collect keys from the target object
-    OrderedMap<std::string, Value>* props = nullptr;
+    PropertyMap* props = nullptr;
     if (args[0].isObject()) {
       props = &args[0].getGC<Object>()->properties;
     } else if (args[0].isFunction()) {
@@ -25178,7 +25080,7 @@ GCPtr<Environment> Environment::createGlobal() {
                       else if (a == 0.0 && b == 0.0) sameValue = (std::signbit(a) == std::signbit(b));
                       else sameValue = (a == b);
                     } else if (currentVal.isString() && newVal.isString()) {
-                      sameValue = (std::get<std::string>(currentVal.data) == std::get<std::string>(newVal.data));
+                      sameValue = (currentVal.asString() == newVal.asString());
                     } else if (currentVal.isBool() && newVal.isBool()) {
                       sameValue = (currentVal.toBool() == newVal.toBool());
                     } else if (currentVal.isUndefined() && newVal.isUndefined()) {
@@ -25194,7 +25096,7 @@ GCPtr<Environment> Environment::createGlobal() {
                     } else if (currentVal.isRegex() && newVal.isRegex()) {
                       sameValue = currentVal.getGC<Regex>().get() == newVal.getGC<Regex>().get();
                     } else if (currentVal.isSymbol() && newVal.isSymbol()) {
-                      sameValue = std::get<Symbol>(currentVal.data) == std::get<Symbol>(newVal.data);
+                      sameValue = currentVal.asSymbol() == newVal.asSymbol();
                     } else if (currentVal.isBigInt() && newVal.isBigInt()) {
                       sameValue = currentVal.toBigInt() == newVal.toBigInt();
                     } else {
@@ -25365,24 +25267,24 @@ GCPtr<Environment> Environment::createGlobal() {
               throw std::runtime_error("RangeError: Invalid array length");
             }
 
-            if (lengthNonWritable && newLen != static_cast<uint32_t>(arr->elements.size())) {
+            if (lengthNonWritable && newLen != static_cast<uint32_t>(arr->elementCount())) {
               throw std::runtime_error("TypeError: Cannot redefine property: length");
             }
 
             // Get effective length (may be stored as __array_length__ for sparse arrays)
             auto storedLenIt = arr->properties.find("__array_length__");
             size_t oldLen = storedLenIt != arr->properties.end() ?
-              static_cast<size_t>(storedLenIt->second.toNumber()) : arr->elements.size();
+              static_cast<size_t>(storedLenIt->second.toNumber()) : arr->elementCount();
             if (newLen < oldLen) {
               // Check for non-configurable elements blocking length decrease
               // Per spec 15.4.5.1 step 3.l: find last non-deletable index
-              size_t effectiveOldLen = std::min(oldLen, arr->elements.size());
+              size_t effectiveOldLen = std::min(oldLen, arr->elementCount());
               for (size_t i = effectiveOldLen; i > newLen; --i) {
                 size_t idx = i - 1;
                 std::string idxStr = std::to_string(idx);
                 if (arr->properties.find("__non_configurable_" + idxStr) != arr->properties.end()) {
                   // Cannot delete this element; set length to idx+1
-                  arr->elements.resize(idx + 1);
+                  arr->elements().resize(idx + 1);
                   arr->properties.erase("__array_length__");
                   // If writable was requested to be false, set it
                   if (writableField.has_value() && !writableField->toBool()) {
@@ -25391,15 +25293,15 @@ GCPtr<Environment> Environment::createGlobal() {
                   throw std::runtime_error("TypeError: Cannot redefine property: length");
                 }
               }
-              if (newLen < arr->elements.size()) {
-                arr->elements.resize(newLen);
+              if (newLen < arr->elementCount()) {
+                arr->elements().resize(newLen);
               }
               arr->properties.erase("__array_length__");
             } else if (newLen > oldLen) {
               // For very large arrays, don't materialize - store as __array_length__
               static const size_t kMaxMaterialize = 1024 * 1024; // 1M elements
               if (newLen <= kMaxMaterialize) {
-                arr->elements.resize(newLen, Value(Undefined{}));
+                arr->elements().resize(newLen, Value(Undefined{}));
                 arr->properties.erase("__array_length__");
               } else {
                 arr->properties["__array_length__"] = Value(static_cast<double>(newLen));
@@ -25449,9 +25351,9 @@ GCPtr<Environment> Environment::createGlobal() {
         if (isIndexKey) {
           try {
             size_t idx = std::stoul(key);
-            hadExistingProperty = (idx < arr->elements.size());
+            hadExistingProperty = (idx < arr->elementCount());
             // Array spec 15.4.5.1 step 4: if index >= oldLen and length is non-writable, reject
-            if (!hadExistingProperty && idx >= arr->elements.size()) {
+            if (!hadExistingProperty && idx >= arr->elementCount()) {
               bool lengthNonWritableNow = arr->properties.find("__non_writable_length") != arr->properties.end();
               if (lengthNonWritableNow) {
                 throw std::runtime_error("TypeError: Cannot define property: " + key + ", length is not writable");
@@ -25469,7 +25371,7 @@ GCPtr<Environment> Environment::createGlobal() {
         // DefineOwnProperty invariants (minimal): reject invalid redefinitions of
         // non-configurable properties so Test262's define-failure tests pass.
         auto sameValue = [](const Value& a, const Value& b) -> bool {
-          if (a.data.index() != b.data.index()) return false;
+          if (!a.hasSameType(b)) return false;
           if (a.isNumber() && b.isNumber()) {
             double x = a.toNumber();
             double y = b.toNumber();
@@ -25480,9 +25382,9 @@ GCPtr<Environment> Environment::createGlobal() {
           if (a.isUndefined() && b.isUndefined()) return true;
           if (a.isNull() && b.isNull()) return true;
           if (a.isBool() && b.isBool()) return std::get<bool>(a.data) == std::get<bool>(b.data);
-          if (a.isString() && b.isString()) return std::get<std::string>(a.data) == std::get<std::string>(b.data);
+          if (a.isString() && b.isString()) return a.asString() == b.asString();
           if (a.isBigInt() && b.isBigInt()) return a.toBigInt() == b.toBigInt();
-          if (a.isSymbol() && b.isSymbol()) return std::get<Symbol>(a.data) == std::get<Symbol>(b.data);
+          if (a.isSymbol() && b.isSymbol()) return a.asSymbol() == b.asSymbol();
           // Objects compare by reference identity in SameValue.
           if (a.isFunction() && b.isFunction()) return a.getGC<Function>().get() == b.getGC<Function>().get();
           if (a.isArray() && b.isArray()) return a.getGC<Array>().get() == b.getGC<Array>().get();
@@ -25513,8 +25415,8 @@ GCPtr<Environment> Environment::createGlobal() {
           bool isNumeric = true;
           size_t idx = 0;
           try { idx = std::stoul(key); } catch (...) { isNumeric = false; }
-          if (isNumeric && idx < arr->elements.size()) {
-            return arr->elements[idx];
+          if (isNumeric && idx < arr->elementCount()) {
+            return arr->element(idx);
           }
           auto it = arr->properties.find(key);
           if (it != arr->properties.end()) return it->second;
@@ -25598,12 +25500,12 @@ GCPtr<Environment> Environment::createGlobal() {
             arr->properties.erase("__get_" + key);
             arr->properties.erase("__set_" + key);
           }
-          if (isNumeric && idx < arr->elements.size()) {
-            arr->elements[idx] = *valueField;
-          } else if (isNumeric && idx < arr->elements.size() + 1024 && idx < 1024 * 1024) {
+          if (isNumeric && idx < arr->elementCount()) {
+            arr->setElement(idx, *valueField);
+          } else if (isNumeric && idx < arr->elementCount() + 1024 && idx < 1024 * 1024) {
             // Extend elements array for nearby numeric indices (but cap at 1M)
-            arr->elements.resize(idx + 1, Value(Undefined{}));
-            arr->elements[idx] = *valueField;
+            arr->elements().resize(idx + 1, Value(Undefined{}));
+            arr->setElement(idx, *valueField);
           } else {
             arr->properties[key] = *valueField;
           }
@@ -25611,10 +25513,10 @@ GCPtr<Environment> Environment::createGlobal() {
           if (isNumeric) {
             auto storedLenIt = arr->properties.find("__array_length__");
             size_t currentLen = storedLenIt != arr->properties.end() ?
-              static_cast<size_t>(storedLenIt->second.toNumber()) : arr->elements.size();
+              static_cast<size_t>(storedLenIt->second.toNumber()) : arr->elementCount();
             if (idx >= currentLen) {
               size_t newLen = idx + 1;
-              if (newLen > arr->elements.size()) {
+              if (newLen > arr->elementCount()) {
                 arr->properties["__array_length__"] = Value(static_cast<double>(newLen));
               }
             }
@@ -25633,8 +25535,8 @@ GCPtr<Environment> Environment::createGlobal() {
           if (isIndexKey) {
             try {
               size_t gIdx = std::stoul(key);
-              if (gIdx >= arr->elements.size()) {
-                arr->elements.resize(gIdx + 1, Value(Undefined{}));
+              if (gIdx >= arr->elementCount()) {
+                arr->elements().resize(gIdx + 1, Value(Undefined{}));
               }
             } catch (...) {}
           }
@@ -25661,8 +25563,8 @@ GCPtr<Environment> Environment::createGlobal() {
           if (isIndexKey) {
             try {
               size_t idx = std::stoul(key);
-              if (idx < arr->elements.size() + 1024) {
-                arr->elements.resize(idx + 1, Value(Undefined{}));
+              if (idx < arr->elementCount() + 1024) {
+                arr->elements().resize(idx + 1, Value(Undefined{}));
               } else {
                 arr->properties[key] = Value(Undefined{});
               }
@@ -25744,8 +25646,8 @@ GCPtr<Environment> Environment::createGlobal() {
               bool isNumeric = true;
               size_t idx = 0;
               try { idx = std::stoul(key); } catch (...) { isNumeric = false; }
-              if (isNumeric && idx < arr->elements.size()) {
-                arr->elements[idx] = cur;
+              if (isNumeric && idx < arr->elementCount()) {
+                arr->setElement(idx, cur);
               } else if (isNumeric) {
                 arr->properties[key] = cur;
               }
@@ -25822,8 +25724,8 @@ GCPtr<Environment> Environment::createGlobal() {
       iterateOwnEnumerable(args[1], args[1].getGC<Function>()->properties);
     } else if (args[1].isArray()) {
       auto arr = args[1].getGC<Array>();
-      for (size_t i = 0; i < arr->elements.size(); ++i) {
-        objectDefineProperty->nativeFunc({target, Value(std::to_string(i)), arr->elements[i]});
+      for (size_t i = 0; i < arr->elementCount(); ++i) {
+        objectDefineProperty->nativeFunc({target, Value(std::to_string(i)), arr->element(i)});
       }
       iterateOwnEnumerable(args[1], arr->properties);
     }
@@ -25927,7 +25829,7 @@ GCPtr<Environment> Environment::createGlobal() {
           doIterate(propsArg.getGC<Promise>()->properties);
         } else if (propsArg.isString()) {
           // ToObject(string) → String object with indexed chars as enumerable own properties
-          const std::string& str = std::get<std::string>(propsArg.data);
+          const std::string& str = propsArg.asString();
           size_t cpIdx = 0, bytePos = 0;
           while (bytePos < str.size()) {
             unsigned char c = str[bytePos];
@@ -26007,10 +25909,9 @@ GCPtr<Environment> Environment::createGlobal() {
 
   // Math methods - use registerMathFn for proper name/length/non-enum
   // (registerMathFn is defined below, so forward-reference via lambda)
-  auto registerMathMethod = [&](const std::string& name, std::function<Value(const std::vector<Value>&)> fn, int length = 1) {
+  auto registerMathMethod = [&](const std::string& name, FastNativeFunction fn, int length = 1) {
     auto f = GarbageCollector::makeGC<Function>();
-    f->isNative = true;
-    f->nativeFunc = fn;
+    setFastNative(*f, fn, false);
     f->properties["name"] = Value(name);
     f->properties["length"] = Value(static_cast<double>(length));
     f->properties["__non_writable_name"] = Value(true);
@@ -26090,7 +25991,7 @@ GCPtr<Environment> Environment::createGlobal() {
   dateConstruct->nativeFunc = [toPrimitive, getProperty, callChecked, isObjectLike](const std::vector<Value>& args) -> Value {
     auto hasDateValueSlot = [&](const Value& input) -> bool {
       if (!isObjectLike(input)) return false;
-      const OrderedMap<std::string, Value>* props = nullptr;
+      const PropertyMap* props = nullptr;
       if (input.isObject()) props = &input.getGC<Object>()->properties;
       else if (input.isFunction()) props = &input.getGC<Function>()->properties;
       else if (input.isArray()) props = &input.getGC<Array>()->properties;
@@ -26245,7 +26146,7 @@ GCPtr<Environment> Environment::createGlobal() {
         if (args.size() <= 1 || !args[1].isString()) {
           throw std::runtime_error("TypeError: Invalid hint");
         }
-        std::string hint = std::get<std::string>(args[1].data);
+        std::string hint = args[1].asString();
         if (hint != "string" && hint != "number" && hint != "default") {
           throw std::runtime_error("TypeError: Invalid hint");
         }
@@ -26464,7 +26365,7 @@ GCPtr<Environment> Environment::createGlobal() {
     // Step 7-8: Get length from raw, ToLength(length)
     double literalSegments = 0;
     if (rawVal.isArray()) {
-      literalSegments = static_cast<double>(rawVal.getGC<Array>()->elements.size());
+      literalSegments = static_cast<double>(rawVal.getGC<Array>()->elementCount());
     } else if (rawVal.isObject()) {
       Value lenVal = getProp(rawVal, "length");
       if (lenVal.isSymbol()) {
@@ -26519,7 +26420,7 @@ GCPtr<Environment> Environment::createGlobal() {
     if (args.empty() || args[0].isUndefined() || args[0].isNull()) {
       throw std::runtime_error(std::string("TypeError: String.prototype.") + methodName + " called on null or undefined");
     }
-    if (args[0].isString()) return std::get<std::string>(args[0].data);
+    if (args[0].isString()) return args[0].asString();
     Value prim = toPrimitiveForStringBuiltin(args[0], true);
     if (prim.isSymbol()) {
       throw std::runtime_error("TypeError: Cannot convert a Symbol value to a string");
@@ -26582,10 +26483,28 @@ GCPtr<Environment> Environment::createGlobal() {
         stringPrototype->properties["__non_enum_" + name] = Value(true);
       };
 
-  installStringPrototypeMethod("charAt", 1, String_charAt, true);
-  installStringPrototypeMethod("charCodeAt", 1, String_charCodeAt, true);
-  installStringPrototypeMethod("codePointAt", 1, String_codePointAt, true);
-  installStringPrototypeMethod("at", 1, String_at, true);
+  // Index, search, slicing and case methods skip the vector round trip and
+  // coerce `this` themselves.
+  auto installFastStringPrototypeMethod = [&](const std::string& name, int length,
+                                              FastNativeFunction nativeFunc) {
+    auto fn = GarbageCollector::makeGC<Function>();
+    setFastNative(*fn, nativeFunc, true);
+    fn->isConstructor = false;
+    fn->properties["name"] = Value(name);
+    fn->properties["length"] = Value(static_cast<double>(length));
+    fn->properties["__non_writable_name"] = Value(true);
+    fn->properties["__non_enum_name"] = Value(true);
+    fn->properties["__non_writable_length"] = Value(true);
+    fn->properties["__non_enum_length"] = Value(true);
+    fn->properties["__throw_on_new__"] = Value(true);
+    stringPrototype->properties[name] = Value(fn);
+    stringPrototype->properties["__non_enum_" + name] = Value(true);
+  };
+
+  installFastStringPrototypeMethod("charAt", 1, String_charAt);
+  installFastStringPrototypeMethod("charCodeAt", 1, String_charCodeAt);
+  installFastStringPrototypeMethod("codePointAt", 1, String_codePointAt);
+  installFastStringPrototypeMethod("at", 1, String_at);
   installStringPrototypeMethod("toString", 0, [](const std::vector<Value>& args) -> Value {
     if (args.empty() || args[0].isUndefined() || args[0].isNull()) {
       throw std::runtime_error("TypeError: String.prototype.toString called on null or undefined");
@@ -26614,14 +26533,14 @@ GCPtr<Environment> Environment::createGlobal() {
     }
     throw std::runtime_error("TypeError: String.prototype.valueOf requires a String");
   });
-  installStringPrototypeMethod("indexOf", 1, String_indexOf, true);
-  installStringPrototypeMethod("lastIndexOf", 1, String_lastIndexOf, true);
+  installFastStringPrototypeMethod("indexOf", 1, String_indexOf);
+  installFastStringPrototypeMethod("lastIndexOf", 1, String_lastIndexOf);
   installStringPrototypeMethod("split", 2, String_split, false);
-  installStringPrototypeMethod("substring", 2, String_substring, true);
-  installStringPrototypeMethod("toLowerCase", 0, String_toLowerCase, true);
-  installStringPrototypeMethod("toUpperCase", 0, String_toUpperCase, true);
-  installStringPrototypeMethod("toLocaleLowerCase", 0, String_toLowerCase, true);
-  installStringPrototypeMethod("toLocaleUpperCase", 0, String_toUpperCase, true);
+  installFastStringPrototypeMethod("substring", 2, String_substring);
+  installFastStringPrototypeMethod("toLowerCase", 0, String_toLowerCase);
+  installFastStringPrototypeMethod("toUpperCase", 0, String_toUpperCase);
+  installFastStringPrototypeMethod("toLocaleLowerCase", 0, String_toLowerCase);
+  installFastStringPrototypeMethod("toLocaleUpperCase", 0, String_toUpperCase);
   installStringPrototypeMethod("localeCompare", 1, [thisToString](const std::vector<Value>& args) -> Value {
     std::string self = thisToString(args, "localeCompare");
     std::string that = args.size() > 1 ? toStringForStringBuiltinArg(args[1]) : "undefined";
@@ -26652,10 +26571,10 @@ GCPtr<Environment> Environment::createGlobal() {
   }, false);
 
   // String.prototype.slice
-  installStringPrototypeMethod("slice", 2, String_slice, true);
+  installFastStringPrototypeMethod("slice", 2, String_slice);
 
   // String.prototype.substr
-  installStringPrototypeMethod("substr", 2, String_substr, true);
+  installFastStringPrototypeMethod("substr", 2, String_substr);
 
   // String.prototype.replace
   installStringPrototypeMethod("replace", 2, String_replace, true);
@@ -26921,7 +26840,7 @@ GCPtr<Environment> Environment::createGlobal() {
       if (doneIt != thisObj->properties.end() && doneIt->second.isBool() && doneIt->second.toBool()) {
         return Interpreter::makeIteratorResult(Value(Undefined{}), true);
       }
-      const std::string& str = std::get<std::string>(strIt->second.data);
+      const std::string& str = strIt->second.asString();
       auto posIt = thisObj->properties.find("__string_iterator_pos__");
       size_t bytePos = posIt != thisObj->properties.end() ? static_cast<size_t>(posIt->second.toNumber()) : 0;
       if (bytePos >= str.size()) {
@@ -26957,7 +26876,7 @@ GCPtr<Environment> Environment::createGlobal() {
       }
       std::string str;
       if (args[0].isString()) {
-        str = std::get<std::string>(args[0].data);
+        str = args[0].asString();
       } else {
         str = args[0].toString();
       }
@@ -27172,8 +27091,10 @@ GCPtr<Environment> Environment::createGlobal() {
   GarbageCollector::instance().reportAllocation(sizeof(Object));
 
   // Copy all current global bindings into globalThis
-  for (const auto& [name, value] : env->bindings_) {
-    globalThisObj->properties[name] = value;
+  for (size_t slot = 0; slot < env->bindings_.size(); ++slot) {
+    if (env->bindings_[slot].name != kNoAtom) {
+      globalThisObj->properties[AtomTable::instance().name(env->bindings_[slot].name)] = env->bindings_[slot].value;
+    }
   }
   // Expose selected intrinsics as configurable global properties.
   // (We keep the intrinsic itself off `globalThis` to avoid leaking internal names.)
@@ -27206,7 +27127,7 @@ GCPtr<Environment> Environment::createGlobal() {
   env->define("globalThis", Value(globalThisObj));
   // 'this' at global scope should be globalThis
   env->define("this", Value(globalThisObj));
-  env->define("__var_scope__", Value(true), true);
+  env->markVarScope();
 
   // Also add globalThis to itself
   globalThisObj->properties["globalThis"] = Value(globalThisObj);
@@ -27349,7 +27270,7 @@ GCPtr<Environment> Environment::createGlobal() {
     addEventListenerFn->isNative = true;
     addEventListenerFn->nativeFunc = [listeners](const std::vector<Value>& args) -> Value {
       if (args.size() >= 2 && args[0].toString() == "abort" && args[1].isFunction()) {
-        listeners->elements.push_back(args[1]);
+        listeners->pushElement(args[1]);
       }
       return Value(Undefined{});
     };
@@ -27380,7 +27301,7 @@ GCPtr<Environment> Environment::createGlobal() {
           Value(std::string("AbortError: The operation was aborted")) : args[0];
 
       // Call all abort listeners
-      for (const auto& listener : listeners->elements) {
+      for (const auto& listener : listeners->elements()) {
         if (listener.isFunction()) {
           auto fn = listener.getGC<Function>();
           if (fn->isNative && fn->nativeFunc) {
@@ -27586,8 +27507,8 @@ GCPtr<Environment> Environment::createGlobal() {
       auto arr = val.getGC<Array>();
       auto newArr = GarbageCollector::makeGC<Array>();
       GarbageCollector::instance().reportAllocation(sizeof(Array));
-      for (const auto& elem : arr->elements) {
-        newArr->elements.push_back((*deepClone)(elem));
+      for (const auto& elem : arr->elements()) {
+        newArr->pushElement((*deepClone)(elem));
       }
       // Copy __proto__ so prototype chain works
       auto protoIt = arr->properties.find("__proto__");
@@ -27910,7 +27831,7 @@ GCPtr<Environment> Environment::createGlobal() {
 
     // Per spec: ToString() on each argument, which invokes ToPrimitive for objects
     auto argToString = [](const Value& v) -> std::string {
-      if (v.isString()) return std::get<std::string>(v.data);
+      if (v.isString()) return v.asString();
       if (v.isUndefined()) return "undefined";
       if (v.isNull()) return "null";
       if (v.isBool()) return v.toBool() ? "true" : "false";
@@ -27983,27 +27904,10 @@ GCPtr<Environment> Environment::createGlobal() {
     };
     fn->isStrict = hasUseStrictDirective(fnDecl->body);
 
-    for (const auto& param : fnDecl->params) {
-      FunctionParam funcParam;
-      funcParam.name = param.name.name;
-      if (param.defaultValue) {
-        funcParam.defaultValue = std::shared_ptr<void>(
-          const_cast<Expression*>(param.defaultValue.get()),
-          [](void*) {});
-      }
-      fn->params.push_back(funcParam);
-    }
-
-    if (fnDecl->restParam.has_value()) {
-      fn->restParam = fnDecl->restParam->name;
-    }
-
-    fn->body = std::shared_ptr<void>(
-      const_cast<std::vector<StmtPtr>*>(&fnDecl->body),
-      [](void*) {});
+    fn->shared = sharedFunctionInfo(*fnDecl);
     fn->astOwner = compiledProgram;
     fn->properties["name"] = Value(std::string("anonymous"));
-    fn->properties["length"] = Value(static_cast<double>(fn->params.size()));
+    fn->properties["length"] = Value(static_cast<double>(fn->shared->params.size()));
 
     auto fnPrototype = GarbageCollector::makeGC<Object>();
     GarbageCollector::instance().reportAllocation(sizeof(Object));
@@ -28074,17 +27978,17 @@ GCPtr<Environment> Environment::createGlobal() {
       auto fn = args[0].getGC<Function>();
       auto nameIt = fn->properties.find("name");
       if (nameIt != fn->properties.end() && nameIt->second.isString()) {
-        name = std::get<std::string>(nameIt->second.data);
+        name = nameIt->second.asString();
       }
       // For native functions, return NativeFunction format
       if (fn->isNative) {
         return Value("function " + name + "() { [native code] }");
       }
-      // Source text is stored in fn->sourceText but returning it would break
+      // Source text is stored in fn->shared->sourceText but returning it would break
       // ToPrimitive/computed property key compatibility since Value::toString()
       // returns "[Function]". Once Value::toString() is updated to be consistent,
       // uncomment:
-      // if (!fn->sourceText.empty()) return Value(fn->sourceText);
+      // if (!fn->shared->sourceText.empty()) return Value(std::string(fn->shared->sourceText));
       return Value(args[0].toString());
     } else if (args[0].isClass()) {
       auto cls = args[0].getGC<Class>();
@@ -28160,7 +28064,7 @@ GCPtr<Environment> Environment::createGlobal() {
         throw std::runtime_error("TypeError: CreateListFromArrayLike called on non-object");
       }
       if (argArray.isArray()) {
-        callArgs = argArray.getGC<Array>()->elements;
+        callArgs = argArray.getGC<Array>()->elements();
       } else {
         auto* interp = getGlobalInterpreter();
         if (interp) {
@@ -28246,7 +28150,7 @@ GCPtr<Environment> Environment::createGlobal() {
     boundFn->properties["__bound_target__"] = target;
     boundFn->properties["__bound_this__"] = boundThis;
     auto boundArgsArr = GarbageCollector::makeGC<Array>();
-    boundArgsArr->elements = boundArgs;
+    boundArgsArr->assignElements(boundArgs);
     boundFn->properties["__bound_args__"] = Value(boundArgsArr);
 
     auto* interpreter = getGlobalInterpreter();
@@ -28276,7 +28180,7 @@ GCPtr<Environment> Environment::createGlobal() {
     std::string targetName;
     Value targetNameValue = getPropertyValue(target, "name");
     if (targetNameValue.isString()) {
-      targetName = std::get<std::string>(targetNameValue.data);
+      targetName = targetNameValue.asString();
     } else if (targetCls) {
       targetName = targetCls->name;
     }
@@ -28338,7 +28242,7 @@ GCPtr<Environment> Environment::createGlobal() {
     };
     Value targetLenValue = getOwnLengthValue(target);
     if (hasOwnLength && targetLenValue.isNumber()) {
-      targetLen = std::get<double>(targetLenValue.data);
+      targetLen = targetLenValue.asNumber();
     }
     double L = 0.0;
     if (std::isnan(targetLen) || targetLen == 0.0) {
@@ -28786,25 +28690,10 @@ GCPtr<Environment> Environment::createGlobal() {
     };
     fn->isStrict = hasUseStrictDirective(fnDecl->body);
 
-    for (const auto& param : fnDecl->params) {
-      FunctionParam funcParam;
-      funcParam.name = param.name.name;
-      if (param.defaultValue) {
-        funcParam.defaultValue = std::shared_ptr<void>(
-          const_cast<Expression*>(param.defaultValue.get()),
-          [](void*) {});
-      }
-      fn->params.push_back(funcParam);
-    }
-    if (fnDecl->restParam.has_value()) {
-      fn->restParam = fnDecl->restParam->name;
-    }
-    fn->body = std::shared_ptr<void>(
-      const_cast<std::vector<StmtPtr>*>(&fnDecl->body),
-      [](void*) {});
+    fn->shared = sharedFunctionInfo(*fnDecl);
     fn->astOwner = compiledProgram;
     fn->properties["name"] = Value(std::string("anonymous"));
-    fn->properties["length"] = Value(static_cast<double>(fn->params.size()));
+    fn->properties["length"] = Value(static_cast<double>(fn->shared->params.size()));
 
     // Generator functions have a `.prototype` that is the generator object prototype.
     auto genProtoObj = GarbageCollector::makeGC<Object>();
@@ -28954,13 +28843,6 @@ GCPtr<Environment> Environment::createGlobal() {
   return env;
 }
 
-Environment* Environment::getRoot() {
-  Environment* current = this;
-  while (current->parent_) {
-    current = current->parent_.get();
-  }
-  return current;
-}
 
 GCPtr<Object> Environment::getGlobal() const {
   // Walk up to the root environment
@@ -28970,17 +28852,19 @@ GCPtr<Object> Environment::getGlobal() const {
   }
 
   // Use the live global object when available.
-  auto globalThisIt = current->bindings_.find("globalThis");
-  if (globalThisIt != current->bindings_.end() && globalThisIt->second.isObject()) {
-    return globalThisIt->second.getGC<Object>();
+  auto* globalThisValue = current->findBinding("globalThis");
+  if (globalThisValue && globalThisValue->isObject()) {
+    return globalThisValue->getGC<Object>();
   }
 
   auto globalObj = GarbageCollector::makeGC<Object>();
   GarbageCollector::instance().reportAllocation(sizeof(Object));
 
   // Add all global bindings to the object
-  for (const auto& [name, value] : current->bindings_) {
-    globalObj->properties[name] = value;
+  for (size_t slot = 0; slot < current->bindings_.size(); ++slot) {
+    if (current->bindings_[slot].name != kNoAtom) {
+      globalObj->properties[AtomTable::instance().name(current->bindings_[slot].name)] = current->bindings_[slot].value;
+    }
   }
 
   return GCPtr<Object>(globalObj);
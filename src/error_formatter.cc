@@ -6,18 +6,43 @@
 namespace lightjs {
 
 // StackFrame implementation
+std::string StackFrame::functionName() const {
+  if (function && !function->name.empty()) {
+    return function->name;
+  }
+  return label;
+}
+
 std::string StackFrame::toString() const {
   std::ostringstream oss;
   oss << "  at ";
 
-  if (!functionName.empty() && functionName != "<anonymous>") {
-    oss << functionName << " ";
+  std::string name = functionName();
+  if (!name.empty() && name != "<anonymous>") {
+    oss << name << " ";
   }
 
   oss << "(" << filename << ":" << line << ":" << column << ")";
   return oss.str();
 }
 
+namespace {
+
+// Outermost frames first, truncated to MAX_STACK_FRAMES of `depth`
+void appendStackFrames(std::ostringstream& oss, const std::vector<StackFrame>& frames, size_t depth) {
+  size_t displayCount = std::min(frames.size(), ErrorFormatter::MAX_STACK_FRAMES);
+  for (size_t i = 0; i < displayCount; i++) {
+    oss << frames[i].toString() << "\n";
+  }
+
+  // Show how many frames were omitted
+  if (depth > ErrorFormatter::MAX_STACK_FRAMES) {
+    oss << "  ... " << (depth - ErrorFormatter::MAX_STACK_FRAMES) << " more frames\n";
+  }
+}
+
+}  // namespace
+
 // SourceContext implementation
 SourceContext::SourceContext(std::string file, std::string source)
   : filename(std::move(file)) {
@@ -142,18 +167,7 @@ std::string ErrorFormatter::formatError(
   oss << errorType << ": " << message << "\n";
 
   // Stack trace (limit to MAX_STACK_FRAMES to prevent excessive output)
-  constexpr size_t MAX_STACK_FRAMES = 10;
-  size_t frameCount = stackTrace.size();
-  size_t displayCount = std::min(frameCount, MAX_STACK_FRAMES);
-
-  for (size_t i = 0; i < displayCount; i++) {
-    oss << stackTrace[i].toString() << "\n";
-  }
-
-  // Show how many frames were omitted
-  if (frameCount > MAX_STACK_FRAMES) {
-    oss << "  ... " << (frameCount - MAX_STACK_FRAMES) << " more frames\n";
-  }
+  appendStackFrames(oss, stackTrace, stackTrace.size());
 
   // Source context (if available)
   if (context && errorLine > 0) {
@@ -163,20 +177,43 @@ std::string ErrorFormatter::formatError(
   return oss.str();
 }
 
-// StackTraceManager implementation
-void StackTraceManager::pushFrame(const StackFrame& frame) {
-  frames_.push_back(frame);
+std::string ErrorFormatter::formatCapturedStack(
+  const std::string& errorType,
+  const std::string& message,
+  const CapturedStack* stack
+) {
+  std::ostringstream oss;
+  oss << errorType << ": " << message << "\n";
+  if (stack) {
+    appendStackFrames(oss, stack->frames, stack->depth);
+  }
+  return oss.str();
 }
 
-void StackTraceManager::pushFrame(std::string functionName, std::string filename,
-                                  uint32_t line, uint32_t column) {
-  frames_.emplace_back(std::move(functionName), std::move(filename), line, column);
+// StackTraceManager implementation
+std::shared_ptr<const CapturedStack> StackTraceManager::capture() const {
+  if (frames_.empty()) {
+    return nullptr;
+  }
+  auto captured = std::make_shared<CapturedStack>();
+  captured->depth = frames_.size();
+  size_t count = std::min(frames_.size(), ErrorFormatter::MAX_STACK_FRAMES);
+  captured->frames.assign(frames_.begin(), frames_.begin() + static_cast<std::ptrdiff_t>(count));
+  for (const auto& frame : captured->frames) {
+    if (frame.function) {
+      captured->functions.push_back(frame.function->shared_from_this());
+    }
+  }
+  return captured;
 }
 
-void StackTraceManager::popFrame() {
-  if (!frames_.empty()) {
-    frames_.pop_back();
+// Error::stack is declared with the value types but formatted here
+const std::string& Error::stack() const {
+  if (!formattedStack_) {
+    formattedStack_ = ErrorFormatter::formatCapturedStack(getName(), message, capturedStack.get());
+    capturedStack.reset();
   }
+  return *formattedStack_;
 }
 
 } // namespace lightjs
@@ -1,4 +1,5 @@
 #include "event_loop.h"
+#include "gc.h"
 #include <thread>
 #include <algorithm>
 
@@ -109,6 +110,9 @@ bool EventLoop::runOnce() {
   // 2. Process all microtasks (this includes Promise callbacks)
   processMicrotasks();
 
+  // 3. Give a running incremental collection a slice between turns
+  GarbageCollector::instance().step();
+
   bool hasWork = hasPendingWork();
   if (!hasWork) {
     running_ = false;
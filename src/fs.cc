@@ -71,8 +71,8 @@ void writeFileSync(const std::string& path, const Value& data) {
     }
 
     // Handle string data
-    if (auto* str = std::get_if<std::string>(&data.data)) {
-      file << *str;
+    if (data.isString()) {
+      file << data.asString();
     }
     // Handle TypedArray data
     else if (auto* typedArray = std::get_if<GCPtr<TypedArray>>(&data.data)) {
@@ -102,8 +102,8 @@ void appendFileSync(const std::string& path, const Value& data) {
       throw std::runtime_error("Cannot open file for appending: " + path);
     }
 
-    if (auto* str = std::get_if<std::string>(&data.data)) {
-      file << *str;
+    if (data.isString()) {
+      file << data.asString();
     } else {
       file << data.toString();
     }
@@ -153,7 +153,7 @@ Value readdirSync(const std::string& path) {
 
     auto entries = fs_compat::readDirectory(path);
     for (const auto& entry : entries) {
-      arr->elements.push_back(Value(entry.name));
+      arr->pushElement(Value(entry.name));
     }
 
     return Value(arr);
@@ -3,9 +3,14 @@
 #include "streams.h"
 #include "wasm_js.h"
 #include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <iostream>
 #include <fstream>
+#include <mutex>
+#include <new>
 #include <string>
+#include <thread>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -91,39 +96,340 @@ GCObject::~GCObject() {
     GarbageCollector::instance().unregisterObject(this);
 }
 
-void GCObject::addRef() {
-    refCount_.fetch_add(1, std::memory_order_relaxed);
+// ============================================================================
+// Parallel collection
+// ============================================================================
+
+namespace {
+
+// Below this many candidates, handing a phase to the worker pool costs more
+// than it saves.
+constexpr size_t kMinParallelObjects = 8192;
+// More threads than this mostly contend on the mark queues.
+constexpr size_t kMaxDefaultThreads = 8;
+
+size_t defaultThreadCount() {
+    size_t hardware = std::thread::hardware_concurrency();
+    return std::max<size_t>(1, std::min(hardware, kMaxDefaultThreads));
+}
+
+// The contiguous share of [0, size) that `worker` of `workers` handles.
+std::pair<size_t, size_t> chunkFor(size_t worker, size_t workers, size_t size) {
+    size_t chunk = (size + workers - 1) / workers;
+    size_t begin = std::min(size, worker * chunk);
+    return {begin, std::min(size, begin + chunk)};
 }
 
-void GCObject::release() {
-    if (refCount_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
-        delete this;
+} // namespace
+
+// Threads that run the parallel phases of a collection. The collecting
+// thread takes part as worker 0.
+class GarbageCollector::WorkerPool {
+public:
+    explicit WorkerPool(size_t threads) {
+        for (size_t i = 1; i < threads; i++) {
+            threads_.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+            generation_++;
+        }
+        wake_.notify_all();
+        for (auto& thread : threads_) thread.join();
+    }
+
+    size_t size() const { return threads_.size() + 1; }
+
+    // Calls task(worker) once for every worker and returns when all calls
+    // are done.
+    void run(const std::function<void(size_t)>& task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            pending_ = threads_.size();
+            generation_++;
+        }
+        wake_.notify_all();
+        task(0);
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return pending_ == 0; });
+        task_ = nullptr;
+    }
+
+private:
+    void workerLoop(size_t worker) {
+        uint64_t seen = 0;
+        for (;;) {
+            const std::function<void(size_t)>* task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&] { return generation_ != seen; });
+                seen = generation_;
+                if (stopping_) return;
+                task = task_;
+            }
+            (*task)(worker);
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0) done_.notify_one();
+        }
+    }
+
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    const std::function<void(size_t)>* task_ = nullptr;
+    size_t pending_ = 0;
+    uint64_t generation_ = 0;
+    bool stopping_ = false;
+};
+
+// Gray objects of one marking worker. The owner works off its private
+// stack and publishes the older half of it whenever its shared deque runs
+// dry; idle workers steal from the front of the other workers' deques.
+struct alignas(64) GarbageCollector::MarkQueue {
+    static constexpr size_t kPublishThreshold = 64;
+
+    std::vector<GCObject*> local;
+    std::mutex mutex;
+    std::deque<GCObject*> shared;
+    std::atomic<size_t> sharedSize{0};
+
+    void publish() {
+        if (local.size() < kPublishThreshold || sharedSize.load() != 0) return;
+        size_t half = local.size() / 2;
+        std::lock_guard<std::mutex> lock(mutex);
+        shared.insert(shared.end(), local.begin(), local.begin() + half);
+        local.erase(local.begin(), local.begin() + half);
+        sharedSize.store(shared.size());
+    }
+
+    GCObject* pop() {
+        if (!local.empty()) {
+            GCObject* obj = local.back();
+            local.pop_back();
+            return obj;
+        }
+        return take(false);
+    }
+
+    GCObject* take(bool front) {
+        if (sharedSize.load() == 0) return nullptr;
+        std::lock_guard<std::mutex> lock(mutex);
+        if (shared.empty()) return nullptr;
+        GCObject* obj;
+        if (front) {
+            obj = shared.front();
+            shared.pop_front();
+        } else {
+            obj = shared.back();
+            shared.pop_back();
+        }
+        sharedSize.store(shared.size());
+        return obj;
+    }
+};
+
+// ============================================================================
+// Object arena
+// ============================================================================
+
+// GC objects are carved out of 64KB pages that each hold one size class.
+// Sizes are rounded up to 16 bytes; objects above kMaxSize come from the
+// general allocator. Every page keeps its own free list and live count, so
+// allocation is a free-list pop (or a bump into a fresh page) and a page
+// goes back to the system once it is empty, beyond one spare per class.
+class GarbageCollector::Arena {
+public:
+    static constexpr size_t kPageSize = 64 * 1024;
+    static constexpr size_t kGranule = 16;
+    static constexpr size_t kMaxSize = 512;
+    static constexpr size_t kClasses = kMaxSize / kGranule;
+
+    static bool handles(size_t size) { return size <= kMaxSize; }
+
+    size_t pageCount() const { return pageCount_; }
+
+    void* allocate(size_t size) {
+        size_t index = (std::max<size_t>(size, 1) + kGranule - 1) / kGranule - 1;
+        SizeClass& sizeClass = classes_[index];
+        Page* page = sizeClass.available;
+        if (!page) page = newPage(sizeClass, index);
+
+        void* slot;
+        if (page->freeList) {
+            slot = page->freeList;
+            page->freeList = page->freeList->next;
+        } else {
+            slot = page->bump;
+            page->bump += page->slotSize;
+        }
+        if (page->live++ == 0) sizeClass.emptyPages--;
+        if (!page->freeList && page->bump + page->slotSize > pageEnd(page)) {
+            unlinkAvailable(sizeClass, page);
+        }
+        return slot;
+    }
+
+    void free(void* ptr) {
+        auto* page = reinterpret_cast<Page*>(reinterpret_cast<uintptr_t>(ptr) & ~(kPageSize - 1));
+        SizeClass& sizeClass = classes_[page->sizeClass];
+        auto* slot = static_cast<FreeSlot*>(ptr);
+        slot->next = page->freeList;
+        page->freeList = slot;
+        if (!page->available) linkAvailable(sizeClass, page);
+        if (--page->live == 0) {
+            if (sizeClass.emptyPages >= kSparePages) {
+                unlinkAvailable(sizeClass, page);
+                ::operator delete(page, std::align_val_t(kPageSize));
+                pageCount_--;
+            } else {
+                sizeClass.emptyPages++;
+            }
+        }
+    }
+
+private:
+    static constexpr size_t kSparePages = 1;
+
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    // Header at the start of every page
+    struct Page {
+        Page* prev;  // On the class's list of pages with free slots
+        Page* next;
+        FreeSlot* freeList;
+        char* bump;  // Start of the never-used tail
+        uint32_t slotSize;
+        uint32_t sizeClass;
+        uint32_t live;
+        bool available;
+    };
+    static constexpr size_t kHeaderSize = (sizeof(Page) + kGranule - 1) / kGranule * kGranule;
+
+    struct SizeClass {
+        Page* available = nullptr;
+        size_t emptyPages = 0;
+    };
+
+    static char* pageEnd(Page* page) { return reinterpret_cast<char*>(page) + kPageSize; }
+
+    Page* newPage(SizeClass& sizeClass, size_t index) {
+        void* memory = ::operator new(kPageSize, std::align_val_t(kPageSize));
+        Page* page = new (memory) Page{};
+        page->bump = static_cast<char*>(memory) + kHeaderSize;
+        page->slotSize = static_cast<uint32_t>((index + 1) * kGranule);
+        page->sizeClass = static_cast<uint32_t>(index);
+        linkAvailable(sizeClass, page);
+        sizeClass.emptyPages++;
+        pageCount_++;
+        return page;
+    }
+
+    void linkAvailable(SizeClass& sizeClass, Page* page) {
+        page->prev = nullptr;
+        page->next = sizeClass.available;
+        if (sizeClass.available) sizeClass.available->prev = page;
+        sizeClass.available = page;
+        page->available = true;
+    }
+
+    void unlinkAvailable(SizeClass& sizeClass, Page* page) {
+        if (page->prev) {
+            page->prev->next = page->next;
+        } else {
+            sizeClass.available = page->next;
+        }
+        if (page->next) page->next->prev = page->prev;
+        page->prev = page->next = nullptr;
+        page->available = false;
     }
+
+    std::array<SizeClass, kClasses> classes_{};
+    size_t pageCount_ = 0;
+};
+
+void* GCObject::operator new(size_t size) {
+    return GarbageCollector::instance().allocateObject(size);
 }
 
-void GCObject::mark() {
-    if (marked_) return;
-    marked_ = true;
+void GCObject::operator delete(void* ptr, size_t size) {
+    GarbageCollector::instance().freeObject(ptr, size);
+}
+
+void* GarbageCollector::allocateObject(size_t size) {
+    if (!Arena::handles(size)) return ::operator new(size);
+    void* ptr = arena_->allocate(size);
+    stats_.arenaPages = arena_->pageCount();
+    return ptr;
+}
 
-    // Mark all referenced objects
-    std::vector<GCObject*> refs;
-    getReferences(refs);
-    for (auto* ref : refs) {
-        if (ref) ref->mark();
+void GarbageCollector::freeObject(void* ptr, size_t size) {
+    if (!Arena::handles(size)) {
+        ::operator delete(ptr);
+        return;
     }
+    arena_->free(ptr);
+    stats_.arenaPages = arena_->pageCount();
 }
 
 // GarbageCollector implementation
 GarbageCollector& GarbageCollector::instance() {
-    static GarbageCollector instance;
-    return instance;
+    // Leaked so that objects released during static destruction can still
+    // unregister themselves.
+    static GarbageCollector* instance = new GarbageCollector();
+    return *instance;
+}
+
+GarbageCollector::GarbageCollector()
+    : threadCount_(defaultThreadCount()), arena_(std::make_unique<Arena>()) {}
+
+GarbageCollector::~GarbageCollector() = default;
+
+void GarbageCollector::setThreadCount(size_t threads) {
+    threads = threads ? threads : defaultThreadCount();
+    if (threads == threadCount_) return;
+    threadCount_ = threads;
+    workers_.reset();
+}
+
+GarbageCollector::WorkerPool* GarbageCollector::workersFor(size_t objects) {
+    if (threadCount_ < 2 || objects < kMinParallelObjects) return nullptr;
+    if (!workers_) workers_ = std::make_unique<WorkerPool>(threadCount_);
+    return workers_.get();
+}
+
+void GarbageCollector::link(GCObject* obj, GenerationList& list, GCObject::Generation generation) {
+    obj->generation_ = generation;
+    obj->gcPrev_ = nullptr;
+    obj->gcNext_ = list.head;
+    if (list.head) list.head->gcPrev_ = obj;
+    list.head = obj;
+    list.count++;
 }
 
-GarbageCollector::GarbageCollector() {}
+void GarbageCollector::unlink(GCObject* obj) {
+    GenerationList& list = listFor(obj->generation_);
+    if (obj->gcPrev_) {
+        obj->gcPrev_->gcNext_ = obj->gcNext_;
+    } else {
+        list.head = obj->gcNext_;
+    }
+    if (obj->gcNext_) obj->gcNext_->gcPrev_ = obj->gcPrev_;
+    obj->gcPrev_ = obj->gcNext_ = nullptr;
+    obj->generation_ = GCObject::Generation::Untracked;
+    list.count--;
+}
 
 void GarbageCollector::registerObject(GCObject* obj) {
     if (!obj || gcDisabled_) return;
-    objects_.insert(obj);
+    link(obj, young_, GCObject::Generation::Young);
     stats_.objectCount++;
     stats_.totalAllocated += sizeof(GCObject);  // Base object size
     stats_.currentlyAllocated += sizeof(GCObject);
@@ -136,8 +442,14 @@ void GarbageCollector::registerObject(GCObject* obj) {
 }
 
 void GarbageCollector::unregisterObject(GCObject* obj) {
-    if (!obj) return;
-    objects_.erase(obj);
+    if (!obj || obj->generation_ == GCObject::Generation::Untracked) return;
+    // An object freed by refcounting in the middle of a collection leaves
+    // the candidate list.
+    if (phase_ != Phase::Idle && obj->gcIndex_ < candidates_.size() &&
+        candidates_[obj->gcIndex_] == obj) {
+        candidates_[obj->gcIndex_] = nullptr;
+    }
+    unlink(obj);
     stats_.objectCount--;
     if (stats_.currentlyAllocated >= sizeof(GCObject)) {
         stats_.currentlyAllocated -= sizeof(GCObject);
@@ -145,161 +457,373 @@ void GarbageCollector::unregisterObject(GCObject* obj) {
     stats_.totalFreed += sizeof(GCObject);
 }
 
+void GCObject::writeBarrierSlow() {
+    if (color() == Color::White) {
+        GarbageCollector::instance().shade(this);
+    }
+}
+
 void GarbageCollector::collect() {
-    if (collectInProgress_ || !autoCollectEnabled_) return;
+    collectGenerations(true);
+}
 
-    collectInProgress_ = true;
-    auto startTime = std::chrono::high_resolution_clock::now();
+void GarbageCollector::collectYoung() {
+    collectGenerations(false);
+}
 
-    // Phase 1: Clear all marks
-    for (auto* obj : objects_) {
-        obj->clearMark();
+void GarbageCollector::collectIfNeeded() {
+    bool nextIsFull = youngCollectionsSinceFull_ + 1 >= fullCollectionInterval_;
+    if (incremental_) {
+        // A running collection gets a slice every eighth of the threshold.
+        size_t trigger = phase_ == Phase::Idle ? allocationThreshold_ : allocationThreshold_ / 8;
+        if (bytesAllocatedSinceGC_ >= trigger) {
+            if (phase_ == Phase::Idle) startIncrementalCollection(nextIsFull);
+            step();
+        }
+        return;
     }
+    if (bytesAllocatedSinceGC_ >= allocationThreshold_) {
+        collectGenerations(nextIsFull);
+    }
+}
 
-    // Phase 2: Mark phase - find and mark all reachable objects
-    markPhase();
-
-    // Phase 3: Detect and handle cycles
-    detectCycles();
+// Collection works on the set of young objects, or on all objects for a
+// full collection. Anything outside the set (the interpreter's GCPtrs,
+// native closures, untracked objects, and old objects in a young
+// collection) is treated as a root through the references it holds, so
+// the old generation needs no remembered set: a young object stored into
+// an old one simply shows up with an external reference.
+void GarbageCollector::collectGenerations(bool full) {
+    if (collectInProgress_ || !autoCollectEnabled_) return;
 
-    // Phase 4: Sweep phase - collect unmarked objects
-    sweepPhase();
+    collectInProgress_ = true;
+    auto startTime = Clock::now();
 
-    // Update statistics
-    auto endTime = std::chrono::high_resolution_clock::now();
-    stats_.lastGCTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
-    stats_.totalGCTime += stats_.lastGCTime;
-    stats_.collectionsTriggered++;
+    bool done = false;
+    if (phase_ != Phase::Idle) {
+        done = fullCycle_ || !full;
+        advanceCycle(nullptr);
+        finishCycle();
+    }
+    if (!done) {
+        beginCycle(full);
+        if (WorkerPool* pool = workersFor(candidates_.size())) {
+            markParallel(*pool);
+        } else {
+            advanceCycle(nullptr);
+        }
+        finishCycle();
+    }
 
-    bytesAllocatedSinceGC_ = 0;
+    recordPause(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - startTime));
+    stats_.lastGCTime = cyclePause_;
+    cyclePause_ = std::chrono::microseconds{0};
     collectInProgress_ = false;
 }
 
-void GarbageCollector::collectIfNeeded() {
-    if (bytesAllocatedSinceGC_ >= allocationThreshold_) {
-        collect();
-    }
+void GarbageCollector::startIncrementalCollection(bool full) {
+    if (phase_ != Phase::Idle || collectInProgress_ || !autoCollectEnabled_) return;
+    auto startTime = Clock::now();
+    beginCycle(full);
+    recordPause(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - startTime));
 }
 
-void GarbageCollector::markPhase() {
-    // Find root objects (those with external references beyond GC control)
-    std::unordered_set<GCObject*> roots;
-    findRoots(roots);
+void GarbageCollector::step() {
+    if (phase_ == Phase::Idle || collectInProgress_ || !autoCollectEnabled_) return;
 
-    // Mark all objects reachable from roots
-    for (auto* root : roots) {
-        root->mark();
+    collectInProgress_ = true;
+    auto startTime = Clock::now();
+    auto deadline = startTime + sliceBudget_;
+    if (advanceCycle(&deadline)) {
+        finishCycle();
     }
+    stats_.incrementalSlices++;
+    recordPause(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - startTime));
+    if (phase_ == Phase::Idle) {
+        stats_.lastGCTime = cyclePause_;
+        cyclePause_ = std::chrono::microseconds{0};
+    }
+    bytesAllocatedSinceGC_ = 0;
+    collectInProgress_ = false;
 }
 
-void GarbageCollector::sweepPhase() {
-    std::vector<GCObject*> toDelete;
-
-    for (auto* obj : objects_) {
-        if (!obj->isMarked() && obj->refCount() == 0) {
-            toDelete.push_back(obj);
+void GarbageCollector::beginCycle(bool full) {
+    fullCycle_ = full;
+    candidates_.clear();
+    markStack_.clear();
+    auto add = [this](GCObject* obj) {
+        obj->gcIndex_ = candidates_.size();
+        obj->gcRefs_.store(static_cast<int64_t>(obj->refCount_), std::memory_order_relaxed);
+        obj->setColor(GCObject::Color::White);
+        candidates_.push_back(obj);
+    };
+    for (GCObject* obj = young_.head; obj; obj = obj->gcNext_) {
+        add(obj);
+    }
+    if (full) {
+        for (GCObject* obj = old_.head; obj; obj = obj->gcNext_) {
+            add(obj);
         }
     }
+    cursor_ = 0;
+    phase_ = Phase::Subtract;
+    GCObject::barrierActive_ = true;
+}
 
-    // Delete unmarked objects with zero references
-    for (auto* obj : toDelete) {
-        delete obj;
-    }
+void GarbageCollector::shade(GCObject* obj) {
+    obj->setColor(GCObject::Color::Gray);
+    markStack_.push_back(obj->gcIndex_);
 }
 
-void GarbageCollector::findRoots(std::unordered_set<GCObject*>& roots) {
-    // Objects with ref count > 0 are roots
-    // (They have references from outside the GC system)
-    for (auto* obj : objects_) {
-        if (obj->refCount() > 0) {
-            roots.insert(obj);
+// Runs until the marking is complete or the deadline (when given) passes.
+// The clock is only read every few objects.
+bool GarbageCollector::advanceCycle(const Clock::time_point* deadline) {
+    constexpr size_t kObjectsPerClockCheck = 64;
+    size_t work = 0;
+    auto outOfTime = [&]() {
+        return deadline && ++work % kObjectsPerClockCheck == 0 && Clock::now() >= *deadline;
+    };
+    auto phaseStart = Clock::now();
+    auto charge = [&](Clock::duration& phaseTime) {
+        auto now = Clock::now();
+        phaseTime += now - phaseStart;
+        phaseStart = now;
+    };
+
+    if (phase_ == Phase::Subtract) {
+        while (cursor_ < candidates_.size()) {
+            if (GCObject* obj = candidates_[cursor_++]) {
+                refs_.clear();
+                obj->getReferences(refs_);
+                for (GCObject* ref : refs_) {
+                    if (ref && ref->color() != GCObject::Color::None) {
+                        ref->gcRefs_.fetch_sub(1, std::memory_order_relaxed);
+                    }
+                }
+            }
+            if (outOfTime()) {
+                charge(subtractTime_);
+                return false;
+            }
         }
+        charge(subtractTime_);
+        cursor_ = 0;
+        phase_ = Phase::Roots;
     }
-}
 
-void GarbageCollector::detectCycles() {
-    // Use Tarjan's strongly connected components algorithm
-    std::unordered_map<GCObject*, int> indices;
-    std::unordered_map<GCObject*, int> lowlinks;
-    std::vector<GCObject*> stack;
-    std::unordered_set<GCObject*> onStack;
-    std::vector<std::vector<GCObject*>> sccs;
-    int index = 0;
+    if (phase_ == Phase::Roots) {
+        while (cursor_ < candidates_.size()) {
+            GCObject* obj = candidates_[cursor_++];
+            if (obj && obj->color() == GCObject::Color::White &&
+                obj->gcRefs_.load(std::memory_order_relaxed) > 0) {
+                shade(obj);
+            }
+            if (outOfTime()) {
+                charge(markTime_);
+                return false;
+            }
+        }
+        phase_ = Phase::Mark;
+    }
 
-    for (auto* obj : objects_) {
-        if (indices.find(obj) == indices.end()) {
-            strongConnect(obj, index, indices, lowlinks, stack, onStack, sccs);
+    while (!markStack_.empty()) {
+        GCObject* obj = candidates_[markStack_.back()];
+        markStack_.pop_back();
+        if (!obj || obj->color() == GCObject::Color::Black) continue;
+        obj->setColor(GCObject::Color::Black);
+        refs_.clear();
+        obj->getReferences(refs_);
+        for (GCObject* ref : refs_) {
+            if (ref && ref->color() == GCObject::Color::White) {
+                shade(ref);
+            }
+        }
+        if (outOfTime()) {
+            charge(markTime_);
+            return false;
         }
     }
+    charge(markTime_);
+    return true;
+}
 
-    // Process strongly connected components (cycles)
-    for (const auto& scc : sccs) {
-        if (scc.size() > 1) {
-            // This is a cycle
-            bool hasExternalRef = false;
-            for (auto* obj : scc) {
-                // Check if any object in the cycle has external references
-                if (obj->refCount() > 0) {
-                    hasExternalRef = true;
-                    break;
+void GarbageCollector::markParallel(WorkerPool& pool) {
+    size_t workers = pool.size();
+    size_t count = candidates_.size();
+    auto phaseStart = Clock::now();
+
+    pool.run([&](size_t worker) {
+        std::vector<GCObject*> refs;
+        auto [begin, end] = chunkFor(worker, workers, count);
+        for (size_t i = begin; i < end; i++) {
+            GCObject* obj = candidates_[i];
+            if (!obj) continue;
+            refs.clear();
+            obj->getReferences(refs);
+            for (GCObject* ref : refs) {
+                if (ref && ref->color() != GCObject::Color::None) {
+                    ref->gcRefs_.fetch_sub(1, std::memory_order_relaxed);
                 }
             }
+        }
+    });
+    auto now = Clock::now();
+    subtractTime_ += now - phaseStart;
+    phaseStart = now;
+
+    // Marking is over once every worker is idle at the same time: a worker
+    // only goes idle with its own queue empty, and only busy workers add
+    // to queues.
+    std::unique_ptr<MarkQueue[]> queues(new MarkQueue[workers]);
+    std::atomic<size_t> idle{0};
+    pool.run([&](size_t worker) {
+        MarkQueue& own = queues[worker];
+        auto [begin, end] = chunkFor(worker, workers, count);
+        for (size_t i = begin; i < end; i++) {
+            GCObject* obj = candidates_[i];
+            if (obj && obj->gcRefs_.load(std::memory_order_relaxed) > 0 && obj->tryShade()) {
+                own.local.push_back(obj);
+            }
+        }
 
-            if (!hasExternalRef) {
-                // Cycle with no external references - mark for collection
-                for (auto* obj : scc) {
-                    obj->clearMark();
+        auto steal = [&]() -> GCObject* {
+            for (size_t i = 1; i < workers; i++) {
+                if (GCObject* obj = queues[(worker + i) % workers].take(true)) return obj;
+            }
+            return nullptr;
+        };
+        auto anyShared = [&]() {
+            for (size_t i = 0; i < workers; i++) {
+                if (queues[i].sharedSize.load() != 0) return true;
+            }
+            return false;
+        };
+
+        std::vector<GCObject*> refs;
+        for (;;) {
+            GCObject* obj = own.pop();
+            if (!obj) obj = steal();
+            if (obj) {
+                obj->setColor(GCObject::Color::Black);
+                refs.clear();
+                obj->getReferences(refs);
+                for (GCObject* ref : refs) {
+                    if (ref && ref->tryShade()) own.local.push_back(ref);
                 }
-                stats_.cyclesDetected++;
+                own.publish();
+                continue;
             }
+            idle.fetch_add(1);
+            while (!anyShared()) {
+                if (idle.load() == workers) return;
+                std::this_thread::yield();
+            }
+            idle.fetch_sub(1);
         }
-    }
+    });
+    markTime_ += Clock::now() - phaseStart;
+    stats_.parallelCollections++;
 }
 
-void GarbageCollector::strongConnect(
-    GCObject* obj,
-    int& index,
-    std::unordered_map<GCObject*, int>& indices,
-    std::unordered_map<GCObject*, int>& lowlinks,
-    std::vector<GCObject*>& stack,
-    std::unordered_set<GCObject*>& onStack,
-    std::vector<std::vector<GCObject*>>& sccs)
-{
-    indices[obj] = index;
-    lowlinks[obj] = index;
-    index++;
-    stack.push_back(obj);
-    onStack.insert(obj);
-
-    // Get all references from this object
-    std::vector<GCObject*> refs;
-    obj->getReferences(refs);
-
-    for (auto* ref : refs) {
-        if (!ref) continue;
-
-        if (indices.find(ref) == indices.end()) {
-            // Successor has not been visited
-            strongConnect(ref, index, indices, lowlinks, stack, onStack, sccs);
-            lowlinks[obj] = std::min(lowlinks[obj], lowlinks[ref]);
-        } else if (onStack.find(ref) != onStack.end()) {
-            // Successor is in stack and hence in current SCC
-            lowlinks[obj] = std::min(lowlinks[obj], indices[ref]);
+void GarbageCollector::finishCycle() {
+    GCObject::barrierActive_ = false;
+    phase_ = Phase::Sweep;
+    auto sweepStart = Clock::now();
+
+    // Gather the white objects, resetting every color on the way.
+    std::vector<GCObject*> garbage;
+    auto scan = [this](size_t begin, size_t end, std::vector<GCObject*>& found) {
+        for (size_t i = begin; i < end; i++) {
+            GCObject* obj = candidates_[i];
+            if (!obj) continue;
+            if (obj->color() == GCObject::Color::White) {
+                found.push_back(obj);
+            }
+            obj->setColor(GCObject::Color::None);
+        }
+    };
+    if (WorkerPool* pool = workersFor(candidates_.size())) {
+        size_t workers = pool->size();
+        std::vector<std::vector<GCObject*>> found(workers);
+        pool->run([&](size_t worker) {
+            auto [begin, end] = chunkFor(worker, workers, candidates_.size());
+            scan(begin, end, found[worker]);
+        });
+        for (const auto& part : found) {
+            garbage.insert(garbage.end(), part.begin(), part.end());
+        }
+    } else {
+        scan(0, candidates_.size(), garbage);
+    }
+    // Freeing runs destructors and refcount releases, which only the
+    // interpreter thread may do.
+    sweep(garbage);
+
+    // Objects allocated during an incremental collection stay young.
+    for (GCObject* obj : candidates_) {
+        if (obj && obj->generation_ == GCObject::Generation::Young) {
+            unlink(obj);
+            link(obj, old_, GCObject::Generation::Old);
+            stats_.objectsPromoted++;
         }
     }
+    candidates_.clear();
+    markStack_.clear();
+    phase_ = Phase::Idle;
+    sweepTime_ += Clock::now() - sweepStart;
+
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    GCStats::PhaseTimes times;
+    times.subtract = duration_cast<microseconds>(subtractTime_);
+    times.mark = duration_cast<microseconds>(markTime_);
+    times.sweep = duration_cast<microseconds>(sweepTime_);
+    stats_.lastPhaseTimes = times;
+    stats_.totalPhaseTimes.subtract += times.subtract;
+    stats_.totalPhaseTimes.mark += times.mark;
+    stats_.totalPhaseTimes.sweep += times.sweep;
+    subtractTime_ = markTime_ = sweepTime_ = Clock::duration{0};
+
+    stats_.collectionsTriggered++;
+    if (fullCycle_) {
+        stats_.fullCollections++;
+        youngCollectionsSinceFull_ = 0;
+    } else {
+        stats_.youngCollections++;
+        youngCollectionsSinceFull_++;
+    }
+    bytesAllocatedSinceGC_ = 0;
+}
+
+void GarbageCollector::sweep(const std::vector<GCObject*>& garbage) {
+    if (garbage.empty()) return;
+
+    // Hold every unreachable object while their references are cleared, so
+    // none is deleted while another one still points at it. Dropping the
+    // holds then frees them through the usual refcount path.
+    for (GCObject* obj : garbage) {
+        obj->addRef();
+    }
+    for (GCObject* obj : garbage) {
+        obj->clearReferences();
+    }
+    size_t before = stats_.objectCount;
+    for (GCObject* obj : garbage) {
+        obj->release();
+    }
+    stats_.objectsReclaimed += before - stats_.objectCount;
+    stats_.cyclesDetected++;
+}
 
-    // If obj is a root node, pop the stack and generate an SCC
-    if (lowlinks[obj] == indices[obj]) {
-        std::vector<GCObject*> scc;
-        GCObject* w;
-        do {
-            w = stack.back();
-            stack.pop_back();
-            onStack.erase(w);
-            scc.push_back(w);
-        } while (w != obj);
-        sccs.push_back(scc);
+void GarbageCollector::recordPause(std::chrono::microseconds pause) {
+    size_t bucket = 0;
+    while (bucket + 1 < GCStats::kPauseBuckets && (int64_t{1} << bucket) <= pause.count()) {
+        bucket++;
     }
+    stats_.pauseHistogram[bucket]++;
+    stats_.maxPause = std::max(stats_.maxPause, pause);
+    stats_.totalGCTime += pause;
+    cyclePause_ += pause;
 }
 
 size_t GarbageCollector::getCurrentMemoryUsage() const {
@@ -5,6 +5,7 @@
 #include "streams.h"
 #include "wasm_js.h"
 #include "interpreter.h"
+#include <algorithm>
 
 namespace lightjs {
 
@@ -44,6 +45,12 @@ static void addValueReferences(const Value& value, std::vector<GCObject*>& refs)
         if (*transform) refs.push_back(transform->get());
     } else if (auto* env = std::get_if<GCPtr<Environment>>(&value.data)) {
         if (*env) refs.push_back(env->get());
+    } else if (auto* cls = std::get_if<GCPtr<Class>>(&value.data)) {
+        if (*cls) refs.push_back(cls->get());
+    } else if (auto* buffer = std::get_if<GCPtr<ArrayBuffer>>(&value.data)) {
+        if (*buffer) refs.push_back(buffer->get());
+    } else if (auto* view = std::get_if<GCPtr<DataView>>(&value.data)) {
+        if (*view) refs.push_back(view->get());
     }
 }
 
@@ -53,9 +60,15 @@ void Value::getReferences(std::vector<GCObject*>& refs) const {
 
 void Environment::getReferences(std::vector<GCObject*>& refs) const {
     if (parent_) refs.push_back(parent_.get());
-    for (const auto& [name, value] : bindings_) {
-        (void)name;
-        addValueReferences(value, refs);
+    for (const auto& binding : bindings_) {
+        addValueReferences(binding.value, refs);
+    }
+}
+
+void Environment::clearReferences() {
+    parent_.reset();
+    for (auto& binding : bindings_) {
+        binding.value = Value(Undefined{});
     }
 }
 
@@ -67,44 +80,248 @@ void Function::getReferences(std::vector<GCObject*>& refs) const {
     }
 }
 
-void Array::getReferences(std::vector<GCObject*>& refs) const {
-    for (const auto& element : elements) {
-        addValueReferences(element, refs);
+void Function::clearReferences() {
+    closure.reset();
+    properties.clear();
+}
+
+void Class::getReferences(std::vector<GCObject*>& refs) const {
+    if (constructor) refs.push_back(constructor.get());
+    if (superClass) refs.push_back(superClass.get());
+    if (lexicalParentClass) refs.push_back(lexicalParentClass.get());
+    for (const auto* table : {&methods, &staticMethods, &getters, &setters}) {
+        for (const auto& [_, method] : *table) {
+            if (method) refs.push_back(method.get());
+        }
     }
+    if (closure) refs.push_back(closure.get());
     for (const auto& [key, value] : properties) {
         (void)key;
         addValueReferences(value, refs);
     }
 }
 
-bool Object::getSlot(int offset, Value& out) const {
-    if (useSlots && offset >= 0 && static_cast<size_t>(offset) < slots.size()) {
-        out = slots[offset];
-        return true;
+void Class::clearReferences() {
+    constructor.reset();
+    superClass.reset();
+    lexicalParentClass.reset();
+    methods.clear();
+    staticMethods.clear();
+    getters.clear();
+    setters.clear();
+    closure.reset();
+    properties.clear();
+}
+
+void Array::setElement(size_t index, const Value& value) {
+    if (elementKind_ == ElementKind::PackedInt32) {
+        if (value.isInt32()) {
+            int32Elements_[index] = value.asInt32();
+            return;
+        }
+        if (value.isNumber()) {
+            makeDouble();
+        } else {
+            makeGeneric();
+        }
+    }
+    if (elementKind_ == ElementKind::PackedDouble) {
+        if (value.isNumber()) {
+            doubleElements_[index] = value.asNumber();
+            return;
+        }
+        makeGeneric();
+    }
+    elements_[index] = value;
+}
+
+void Array::pushElement(const Value& value) {
+    switch (elementKind_) {
+        case ElementKind::PackedInt32:
+            int32Elements_.push_back(0);
+            break;
+        case ElementKind::PackedDouble:
+            doubleElements_.push_back(0.0);
+            break;
+        case ElementKind::Generic:
+            elements_.push_back(value);
+            return;
+    }
+    setElement(elementCount() - 1, value);
+}
+
+void Array::resizeElements(size_t count) {
+    switch (elementKind_) {
+        case ElementKind::PackedInt32:
+            if (count <= int32Elements_.size()) {
+                int32Elements_.resize(count);
+                return;
+            }
+            break;
+        case ElementKind::PackedDouble:
+            if (count <= doubleElements_.size()) {
+                doubleElements_.resize(count);
+                return;
+            }
+            break;
+        case ElementKind::Generic:
+            break;
+    }
+    elements().resize(count, Value(Undefined{}));
+}
+
+Value Array::popElement() {
+    Value last = element(elementCount() - 1);
+    switch (elementKind_) {
+        case ElementKind::PackedInt32:
+            int32Elements_.pop_back();
+            break;
+        case ElementKind::PackedDouble:
+            doubleElements_.pop_back();
+            break;
+        case ElementKind::Generic:
+            elements_.pop_back();
+            break;
+    }
+    return last;
+}
+
+void Array::eraseElements(size_t index, size_t count) {
+    switch (elementKind_) {
+        case ElementKind::PackedInt32:
+            int32Elements_.erase(int32Elements_.begin() + index, int32Elements_.begin() + index + count);
+            break;
+        case ElementKind::PackedDouble:
+            doubleElements_.erase(doubleElements_.begin() + index, doubleElements_.begin() + index + count);
+            break;
+        case ElementKind::Generic:
+            elements_.erase(elements_.begin() + index, elements_.begin() + index + count);
+            break;
     }
-    return false;
 }
 
-void Object::setSlot(int offset, const Value& value) {
-    if (offset >= 0) {
-        if (static_cast<size_t>(offset) >= slots.size()) {
-            slots.resize(offset + 1);
+void Array::insertElements(size_t index, std::span<const Value> values) {
+    // Widen only as far as the inserted values need
+    for (const auto& value : values) {
+        if (elementKind_ == ElementKind::Generic) break;
+        if (value.isInt32()) continue;
+        if (!value.isNumber()) {
+            makeGeneric();
+        } else if (elementKind_ == ElementKind::PackedInt32) {
+            makeDouble();
+        }
+    }
+    switch (elementKind_) {
+        case ElementKind::PackedInt32: {
+            auto it = int32Elements_.insert(int32Elements_.begin() + index, values.size(), 0);
+            for (const auto& value : values) *it++ = value.asInt32();
+            break;
+        }
+        case ElementKind::PackedDouble: {
+            auto it = doubleElements_.insert(doubleElements_.begin() + index, values.size(), 0.0);
+            for (const auto& value : values) *it++ = value.asNumber();
+            break;
         }
-        slots[offset] = value;
-        const_cast<Object*>(this)->useSlots = true;
+        case ElementKind::Generic:
+            elements_.insert(elements_.begin() + index, values.begin(), values.end());
+            break;
     }
 }
 
-void Object::getReferences(std::vector<GCObject*>& refs) const {
+void Array::reverseElements() {
+    switch (elementKind_) {
+        case ElementKind::PackedInt32:
+            std::reverse(int32Elements_.begin(), int32Elements_.end());
+            break;
+        case ElementKind::PackedDouble:
+            std::reverse(doubleElements_.begin(), doubleElements_.end());
+            break;
+        case ElementKind::Generic:
+            std::reverse(elements_.begin(), elements_.end());
+            break;
+    }
+}
+
+void Array::narrowElements() {
+    if (elementKind_ != ElementKind::Generic) return;
+    std::vector<Value> values;
+    values.swap(elements_);
+    assignElements(std::move(values));
+}
+
+void Array::assignElements(std::vector<Value> values) {
+    ElementKind kind = ElementKind::PackedInt32;
+    for (const auto& value : values) {
+        if (value.isInt32()) continue;
+        if (!value.isNumber()) {
+            kind = ElementKind::Generic;
+            break;
+        }
+        kind = ElementKind::PackedDouble;
+    }
+    int32Elements_.clear();
+    doubleElements_.clear();
+    elements_.clear();
+    elementKind_ = kind;
+    switch (kind) {
+        case ElementKind::PackedInt32:
+            int32Elements_.reserve(values.size());
+            for (const auto& value : values) int32Elements_.push_back(value.asInt32());
+            break;
+        case ElementKind::PackedDouble:
+            doubleElements_.reserve(values.size());
+            for (const auto& value : values) doubleElements_.push_back(value.asNumber());
+            break;
+        case ElementKind::Generic:
+            elements_ = std::move(values);
+            break;
+    }
+}
+
+void Array::makeDouble() {
+    doubleElements_.assign(int32Elements_.begin(), int32Elements_.end());
+    std::vector<int32_t>().swap(int32Elements_);
+    elementKind_ = ElementKind::PackedDouble;
+}
+
+void Array::makeGeneric() {
+    size_t count = elementCount();
+    elements_.clear();
+    elements_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        elements_.push_back(element(i));
+    }
+    std::vector<int32_t>().swap(int32Elements_);
+    std::vector<double>().swap(doubleElements_);
+    elementKind_ = ElementKind::Generic;
+}
+
+void Array::getReferences(std::vector<GCObject*>& refs) const {
+    // Packed elements are plain numbers and hold no references.
+    for (const auto& element : elements_) {
+        addValueReferences(element, refs);
+    }
     for (const auto& [key, value] : properties) {
+        (void)key;
         addValueReferences(value, refs);
     }
-    // Also add references from slots
-    for (const auto& value : slots) {
+}
+
+void Array::clearReferences() {
+    elements_.clear();
+    properties.clear();
+}
+
+void Object::getReferences(std::vector<GCObject*>& refs) const {
+    for (const auto& [key, value] : properties) {
         addValueReferences(value, refs);
     }
 }
 
+void Object::clearReferences() {
+    properties.clear();
+}
+
 void Promise::getReferences(std::vector<GCObject*>& refs) const {
     addValueReferences(result, refs);
     for (const auto& chainedPromise : chainedPromises) {
@@ -116,6 +333,12 @@ void Promise::getReferences(std::vector<GCObject*>& refs) const {
     }
 }
 
+void Promise::clearReferences() {
+    result = Value(Undefined{});
+    chainedPromises.clear();
+    properties.clear();
+}
+
 void Regex::getReferences(std::vector<GCObject*>& refs) const {
     for (const auto& [key, value] : properties) {
         (void)key;
@@ -123,27 +346,43 @@ void Regex::getReferences(std::vector<GCObject*>& refs) const {
     }
 }
 
-void Map::getReferences(std::vector<GCObject*>& refs) const {
-    for (const auto& [key, value] : entries) {
-        addValueReferences(key, refs);
-        addValueReferences(value, refs);
+void Regex::clearReferences() {
+    properties.clear();
+}
+
+void OrderedHashTable::getReferences(std::vector<GCObject*>& refs) const {
+    for (const auto& entry : entries_) {
+        addValueReferences(entry.key, refs);
+        addValueReferences(entry.value, refs);
     }
+}
+
+void Map::getReferences(std::vector<GCObject*>& refs) const {
+    table.getReferences(refs);
     for (const auto& [key, value] : properties) {
         (void)key;
         addValueReferences(value, refs);
     }
 }
 
+void Map::clearReferences() {
+    table.clear();
+    properties.clear();
+}
+
 void Set::getReferences(std::vector<GCObject*>& refs) const {
-    for (const auto& value : values) {
-        addValueReferences(value, refs);
-    }
+    table.getReferences(refs);
     for (const auto& [key, value] : properties) {
         (void)key;
         addValueReferences(value, refs);
     }
 }
 
+void Set::clearReferences() {
+    table.clear();
+    properties.clear();
+}
+
 void Generator::getReferences(std::vector<GCObject*>& refs) const {
     if (function) refs.push_back(function.get());
     if (context) refs.push_back(context.get());
@@ -156,11 +395,24 @@ void Generator::getReferences(std::vector<GCObject*>& refs) const {
     }
 }
 
+// The suspended coroutine is left alone: destroying its frame here would
+// run its cleanup outside of the interpreter's control.
+void Generator::clearReferences() {
+    function.reset();
+    context.reset();
+    properties.clear();
+}
+
 void Proxy::getReferences(std::vector<GCObject*>& refs) const {
     if (target) addValueReferences(*target, refs);
     if (handler) addValueReferences(*handler, refs);
 }
 
+void Proxy::clearReferences() {
+    target.reset();
+    handler.reset();
+}
+
 // WeakMap implementation
 // Helper to extract GCObject* from any GC-held value type
 static GCObject* extractGCObject(const Value& key) {
@@ -184,7 +436,7 @@ static GCObject* extractGCObject(const Value& key) {
 
 void WeakMap::set(const Value& key, const Value& value) {
     if (key.isSymbol()) {
-        symbolEntries[std::get<Symbol>(key.data).id] = value;
+        symbolEntries[key.asSymbol().id] = value;
         return;
     }
     GCObject* keyObj = extractGCObject(key);
@@ -195,7 +447,7 @@ void WeakMap::set(const Value& key, const Value& value) {
 
 bool WeakMap::has(const Value& key) const {
     if (key.isSymbol()) {
-        return symbolEntries.find(std::get<Symbol>(key.data).id) != symbolEntries.end();
+        return symbolEntries.find(key.asSymbol().id) != symbolEntries.end();
     }
     GCObject* keyObj = extractGCObject(key);
     return keyObj && entries.find(keyObj) != entries.end();
@@ -203,7 +455,7 @@ bool WeakMap::has(const Value& key) const {
 
 Value WeakMap::get(const Value& key) const {
     if (key.isSymbol()) {
-        auto it = symbolEntries.find(std::get<Symbol>(key.data).id);
+        auto it = symbolEntries.find(key.asSymbol().id);
         if (it != symbolEntries.end()) return it->second;
         return Value(Undefined{});
     }
@@ -217,7 +469,7 @@ Value WeakMap::get(const Value& key) const {
 
 bool WeakMap::deleteKey(const Value& key) {
     if (key.isSymbol()) {
-        return symbolEntries.erase(std::get<Symbol>(key.data).id) > 0;
+        return symbolEntries.erase(key.asSymbol().id) > 0;
     }
     GCObject* keyObj = extractGCObject(key);
     if (keyObj) {
@@ -239,10 +491,16 @@ void WeakMap::getReferences(std::vector<GCObject*>& refs) const {
     }
 }
 
+void WeakMap::clearReferences() {
+    entries.clear();
+    symbolEntries.clear();
+    properties.clear();
+}
+
 // WeakSet implementation
 bool WeakSet::add(const Value& value) {
     if (value.isSymbol()) {
-        symbolValues.insert(std::get<Symbol>(value.data).id);
+        symbolValues.insert(value.asSymbol().id);
         return true;
     }
     GCObject* obj = extractGCObject(value);
@@ -255,7 +513,7 @@ bool WeakSet::add(const Value& value) {
 
 bool WeakSet::has(const Value& value) const {
     if (value.isSymbol()) {
-        return symbolValues.find(std::get<Symbol>(value.data).id) != symbolValues.end();
+        return symbolValues.find(value.asSymbol().id) != symbolValues.end();
     }
     GCObject* obj = extractGCObject(value);
     return obj && values.find(obj) != values.end();
@@ -263,7 +521,7 @@ bool WeakSet::has(const Value& value) const {
 
 bool WeakSet::deleteValue(const Value& value) {
     if (value.isSymbol()) {
-        return symbolValues.erase(std::get<Symbol>(value.data).id) > 0;
+        return symbolValues.erase(value.asSymbol().id) > 0;
     }
     GCObject* obj = extractGCObject(value);
     if (obj) {
@@ -279,6 +537,10 @@ void WeakSet::getReferences(std::vector<GCObject*>& refs) const {
     }
 }
 
+void WeakSet::clearReferences() {
+    properties.clear();
+}
+
 void Error::getReferences(std::vector<GCObject*>& refs) const {
     for (const auto& [key, value] : properties) {
         (void)key;
@@ -286,6 +548,10 @@ void Error::getReferences(std::vector<GCObject*>& refs) const {
     }
 }
 
+void Error::clearReferences() {
+    properties.clear();
+}
+
 void ArrayBuffer::getReferences(std::vector<GCObject*>& refs) const {
     for (const auto& view : views) {
         if (view) refs.push_back(view.get());
@@ -296,6 +562,11 @@ void ArrayBuffer::getReferences(std::vector<GCObject*>& refs) const {
     }
 }
 
+void ArrayBuffer::clearReferences() {
+    views.clear();
+    properties.clear();
+}
+
 void DataView::getReferences(std::vector<GCObject*>& refs) const {
     if (buffer) refs.push_back(buffer.get());
     for (const auto& [key, value] : properties) {
@@ -304,6 +575,10 @@ void DataView::getReferences(std::vector<GCObject*>& refs) const {
     }
 }
 
+void DataView::clearReferences() {
+    properties.clear();
+}
+
 void TypedArray::getReferences(std::vector<GCObject*>& refs) const {
     if (viewedBuffer) refs.push_back(viewedBuffer.get());
     for (const auto& [key, value] : properties) {
@@ -312,4 +587,8 @@ void TypedArray::getReferences(std::vector<GCObject*>& refs) const {
     }
 }
 
+void TypedArray::clearReferences() {
+    properties.clear();
+}
+
 } // namespace lightjs
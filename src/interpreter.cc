@@ -11,7 +11,7 @@ namespace lightjs {
 static void setArrayPrototype(const GCPtr<Array>& arr, Environment* env) {
   auto arrCtor = env->get("Array");
   if (!arrCtor) return;
-  OrderedMap<std::string, Value>* ctorProps = nullptr;
+  PropertyMap* ctorProps = nullptr;
   if (arrCtor->isFunction()) {
     ctorProps = &std::get<GCPtr<Function>>(arrCtor->data)->properties;
   } else if (arrCtor->isObject()) {
@@ -123,6 +123,10 @@ bool typedArrayConstructorNameToType(const std::string& name, TypedArrayType& ou
 }
 
 int32_t toInt32(double value) {
+  // In-range values (the common case) truncate directly; NaN fails the test.
+  if (value > -2147483649.0 && value < 2147483648.0) {
+    return static_cast<int32_t>(value);
+  }
   if (!std::isfinite(value) || value == 0.0) {
     return 0;
   }
@@ -243,7 +247,7 @@ std::string privateAutoAccessorBackingName(const std::string& privateName) {
   return privateName + "@@accessor_storage";
 }
 
-OrderedMap<std::string, Value>* getHiddenFieldStorage(Value& value) {
+PropertyMap* getHiddenFieldStorage(Value& value) {
   if (value.isObject()) return &value.getGC<Object>()->properties;
   if (value.isArray()) return &value.getGC<Array>()->properties;
   if (value.isFunction()) return &value.getGC<Function>()->properties;
@@ -259,7 +263,7 @@ OrderedMap<std::string, Value>* getHiddenFieldStorage(Value& value) {
   return nullptr;
 }
 
-const OrderedMap<std::string, Value>* getHiddenFieldStorage(const Value& value) {
+const PropertyMap* getHiddenFieldStorage(const Value& value) {
   if (value.isObject()) return &value.getGC<Object>()->properties;
   if (value.isArray()) return &value.getGC<Array>()->properties;
   if (value.isFunction()) return &value.getGC<Function>()->properties;
@@ -412,7 +416,7 @@ GCPtr<Class> getConstructorClassForPrivateAccess(const Value& value, int depth =
   return nullptr;
 }
 
-OrderedMap<std::string, Value>* getPropertyStorageForPrivateAccess(Value& value) {
+PropertyMap* getPropertyStorageForPrivateAccess(Value& value) {
   if (value.isObject()) {
     return &value.getGC<Object>()->properties;
   }
@@ -431,7 +435,7 @@ OrderedMap<std::string, Value>* getPropertyStorageForPrivateAccess(Value& value)
   return nullptr;
 }
 
-const OrderedMap<std::string, Value>* getPropertyStorageForPrivateAccess(const Value& value) {
+const PropertyMap* getPropertyStorageForPrivateAccess(const Value& value) {
   if (value.isObject()) {
     return &value.getGC<Object>()->properties;
   }
@@ -478,6 +482,63 @@ BigIntNumberOrder compareBigIntAndNumber(const bigint::BigIntValue& bi, double n
   return (bi <= floorAsBigInt) ? BigIntNumberOrder::Less : BigIntNumberOrder::Greater;
 }
 
+// Int32 fast path for a binary operator whose operands are both int32-tagged
+// numbers. Returns false when the result is not an int32 (overflow, -0,
+// fractional quotient, >>> above INT32_MAX) so the caller falls back to the
+// double computation, which yields the same Number.
+bool int32BinaryOperation(BinaryExpr::Op op, int32_t l, int32_t r, Value& out) {
+  int64_t wide = 0;
+  switch (op) {
+    case BinaryExpr::Op::Add: wide = static_cast<int64_t>(l) + r; break;
+    case BinaryExpr::Op::Sub: wide = static_cast<int64_t>(l) - r; break;
+    case BinaryExpr::Op::Mul:
+      wide = static_cast<int64_t>(l) * r;
+      if (wide == 0 && (l < 0 || r < 0)) return false;  // -0
+      break;
+    case BinaryExpr::Op::Mod:
+      if (l < 0 || r <= 0) return false;  // Sign of zero, NaN and INT32_MIN % -1
+      out = Value(l % r);
+      return true;
+    case BinaryExpr::Op::BitwiseAnd: out = Value(l & r); return true;
+    case BinaryExpr::Op::BitwiseOr: out = Value(l | r); return true;
+    case BinaryExpr::Op::BitwiseXor: out = Value(l ^ r); return true;
+    case BinaryExpr::Op::LeftShift: out = Value(l << (r & 0x1f)); return true;
+    case BinaryExpr::Op::RightShift: out = Value(l >> (r & 0x1f)); return true;
+    case BinaryExpr::Op::UnsignedRightShift:
+      wide = static_cast<uint32_t>(l) >> (r & 0x1f);
+      break;
+    case BinaryExpr::Op::Less: out = Value(l < r); return true;
+    case BinaryExpr::Op::Greater: out = Value(l > r); return true;
+    case BinaryExpr::Op::LessEqual: out = Value(l <= r); return true;
+    case BinaryExpr::Op::GreaterEqual: out = Value(l >= r); return true;
+    case BinaryExpr::Op::Equal:
+    case BinaryExpr::Op::StrictEqual: out = Value(l == r); return true;
+    case BinaryExpr::Op::NotEqual:
+    case BinaryExpr::Op::StrictNotEqual: out = Value(l != r); return true;
+    default: return false;
+  }
+  if (wide < INT32_MIN || wide > INT32_MAX) return false;
+  out = Value(static_cast<int32_t>(wide));
+  return true;
+}
+
+// The binary operator a compound assignment applies, if it has a plain one.
+std::optional<BinaryExpr::Op> compoundAssignmentBinaryOp(AssignmentExpr::Op op) {
+  switch (op) {
+    case AssignmentExpr::Op::AddAssign: return BinaryExpr::Op::Add;
+    case AssignmentExpr::Op::SubAssign: return BinaryExpr::Op::Sub;
+    case AssignmentExpr::Op::MulAssign: return BinaryExpr::Op::Mul;
+    case AssignmentExpr::Op::ModAssign: return BinaryExpr::Op::Mod;
+    case AssignmentExpr::Op::BitwiseAndAssign: return BinaryExpr::Op::BitwiseAnd;
+    case AssignmentExpr::Op::BitwiseOrAssign: return BinaryExpr::Op::BitwiseOr;
+    case AssignmentExpr::Op::BitwiseXorAssign: return BinaryExpr::Op::BitwiseXor;
+    case AssignmentExpr::Op::LeftShiftAssign: return BinaryExpr::Op::LeftShift;
+    case AssignmentExpr::Op::RightShiftAssign: return BinaryExpr::Op::RightShift;
+    case AssignmentExpr::Op::UnsignedRightShiftAssign: return BinaryExpr::Op::UnsignedRightShift;
+    default: return std::nullopt;
+  }
+}
+
 // Helper: compute result of compound assignment (e.g., +=, -=, <<=, etc.)
 // Does NOT handle AddAssign (needs toPrimitiveValue which requires Interpreter context)
 // Does NOT handle AndAssign/OrAssign/NullishAssign (short-circuit semantics)
@@ -513,13 +574,13 @@ Value computeCompoundOp(AssignmentExpr::Op op, const Value& current, const Value
       return Value(std::pow(current.toNumber(), right.toNumber()));
     case AssignmentExpr::Op::BitwiseAndAssign:
       if (current.isBigInt() && right.isBigInt()) return Value(BigInt(current.toBigInt() & right.toBigInt()));
-      return Value(static_cast<double>(toInt32(current.toNumber()) & toInt32(right.toNumber())));
+      return Value(toInt32(current.toNumber()) & toInt32(right.toNumber()));
     case AssignmentExpr::Op::BitwiseOrAssign:
       if (current.isBigInt() && right.isBigInt()) return Value(BigInt(current.toBigInt() | right.toBigInt()));
-      return Value(static_cast<double>(toInt32(current.toNumber()) | toInt32(right.toNumber())));
+      return Value(toInt32(current.toNumber()) | toInt32(right.toNumber()));
     case AssignmentExpr::Op::BitwiseXorAssign:
       if (current.isBigInt() && right.isBigInt()) return Value(BigInt(current.toBigInt() ^ right.toBigInt()));
-      return Value(static_cast<double>(toInt32(current.toNumber()) ^ toInt32(right.toNumber())));
+      return Value(toInt32(current.toNumber()) ^ toInt32(right.toNumber()));
     case AssignmentExpr::Op::LeftShiftAssign:
       if (current.isBigInt() && right.isBigInt()) {
         bool ok = false;
@@ -527,7 +588,7 @@ Value computeCompoundOp(AssignmentExpr::Op op, const Value& current, const Value
         if (!ok) return Value(Undefined{});
         return Value(BigInt(shifted));
       }
-      return Value(static_cast<double>(toInt32(current.toNumber()) << (toInt32(right.toNumber()) & 0x1f)));
+      return Value(toInt32(current.toNumber()) << (toInt32(right.toNumber()) & 0x1f));
     case AssignmentExpr::Op::RightShiftAssign:
       if (current.isBigInt() && right.isBigInt()) {
         bool ok = false;
@@ -535,7 +596,7 @@ Value computeCompoundOp(AssignmentExpr::Op op, const Value& current, const Value
         if (!ok) return Value(Undefined{});
         return Value(BigInt(shifted));
       }
-      return Value(static_cast<double>(toInt32(current.toNumber()) >> (toInt32(right.toNumber()) & 0x1f)));
+      return Value(toInt32(current.toNumber()) >> (toInt32(right.toNumber()) & 0x1f));
     case AssignmentExpr::Op::UnsignedRightShiftAssign:
       return Value(static_cast<double>(static_cast<uint32_t>(toInt32(current.toNumber())) >> (toInt32(right.toNumber()) & 0x1f)));
     default:
@@ -675,14 +736,14 @@ bool resizeDenseArray(const GCPtr<Array>& array, size_t newSize) {
   if (!denseArrayResizeAllowed(newSize)) {
     return false;
   }
-  array->elements.resize(newSize, Value(Undefined{}));
+  array->resizeElements(newSize);
   return true;
 }
 
 bool growDenseArrayForIndex(const GCPtr<Array>& array,
                             size_t index,
                             bool markIntermediateHoles = false) {
-  size_t oldSize = array->elements.size();
+  size_t oldSize = array->elementCount();
   size_t newSize = 0;
   if (!checked::add(index, static_cast<size_t>(1), newSize) ||
       !resizeDenseArray(array, newSize)) {
@@ -697,6 +758,28 @@ bool growDenseArrayForIndex(const GCPtr<Array>& array,
   return true;
 }
 
+// True when the array's only own non-index property is its prototype link.
+// Holes, accessors, non-writable/non-extensible markers and length overrides
+// all live in `properties`, so such an array's elements are plain writable
+// data properties stored in `elements`.
+bool hasPlainElements(const Array& array) {
+  return array.properties.empty() ||
+         (array.properties.size() == 1 && array.properties.begin()->first == "__proto__");
+}
+
+Value typedArrayElement(const TypedArray& ta, size_t index) {
+  if (index >= ta.currentLength()) {
+    return Value(Undefined{});
+  }
+  if (ta.type == TypedArrayType::BigUint64) {
+    return Value(BigInt(bigint::BigIntValue(ta.getBigUintElement(index))));
+  }
+  if (ta.type == TypedArrayType::BigInt64) {
+    return Value(BigInt(ta.getBigIntElement(index)));
+  }
+  return Value(ta.getElement(index));
+}
+
 // Compare JavaScript strings by UTF-16 code units (ECMAScript relational
 // comparisons use code unit order, not UTF-8 byte order).
 struct Utf16CodeUnitIter {
@@ -815,10 +898,53 @@ bool hasUseStrictDirective(const std::vector<StmtPtr>& body) {
 
 }  // namespace
 
+template <typename FunctionNode>
+const std::shared_ptr<const SharedFunctionInfo>& sharedFunctionInfo(const FunctionNode& node) {
+  if (!node.sharedInfo) {
+    auto info = std::make_shared<SharedFunctionInfo>();
+    bool sawDefault = false;
+    for (const auto& param : node.params) {
+      FunctionParam funcParam;
+      funcParam.name = param.name.name;
+      if (param.defaultValue) {
+        funcParam.defaultValue = std::shared_ptr<void>(const_cast<Expression*>(param.defaultValue.get()), [](void*){});
+        sawDefault = true;
+      } else if (!sawDefault) {
+        info->length++;
+      }
+      info->params.push_back(std::move(funcParam));
+    }
+    if (node.restParam.has_value()) {
+      info->restParam = node.restParam->name;
+    }
+    info->body = std::shared_ptr<void>(const_cast<std::vector<StmtPtr>*>(&node.body), [](void*){});
+    info->destructurePrologue = std::shared_ptr<void>(
+      const_cast<std::vector<StmtPtr>*>(&node.destructurePrologue), [](void*){});
+    info->usesArguments = node.usesArguments;
+    if constexpr (requires { node.id.name; }) {
+      info->name = node.id.name;
+    } else if constexpr (requires { node.key.name; }) {
+      info->name = node.key.name;
+    } else {
+      info->name = node.name;
+    }
+    if constexpr (requires { node.sourceText; }) {
+      info->sourceText = node.sourceText;
+    }
+    node.sharedInfo = std::move(info);
+  }
+  return node.sharedInfo;
+}
+
+template const std::shared_ptr<const SharedFunctionInfo>& sharedFunctionInfo(const FunctionExpr&);
+template const std::shared_ptr<const SharedFunctionInfo>& sharedFunctionInfo(const FunctionDeclaration&);
+template const std::shared_ptr<const SharedFunctionInfo>& sharedFunctionInfo(const MethodDefinition&);
+
 // Forward declaration for TDZ initialization
 static void collectVarHoistNames(const Expression& expr, std::vector<std::string>& names);
 
-Interpreter::Interpreter(GCPtr<Environment> env) : env_(env), maxLoopIterations_(getMaxLoopIterations()) {
+Interpreter::Interpreter(GCPtr<Environment> env)
+    : env_(env), maxLoopIterations_(getMaxLoopIterations()), bytecodeEnabled_(getBytecodeEnabled()) {
   setGlobalInterpreter(this);
 }
 
@@ -1233,98 +1359,50 @@ bool Interpreter::isObjectLike(const Value& value) const {
 }
 
 std::pair<bool, Value> Interpreter::getPropertyForPrimitive(const Value& receiver, const std::string& key) {
-  auto getFromPropertyBag = [&](OrderedMap<std::string, Value>& bag) -> std::pair<bool, Value> {
-    std::string getterKey = "__get_" + key;
-    auto getterIt = bag.find(getterKey);
-    if (getterIt != bag.end()) {
-      if (getterIt->second.isFunction()) {
-        return {true, callFunction(getterIt->second, {}, receiver)};
+  // Own lookup in one property bag: accessor first, then data. A setter-only
+  // accessor exists but reads as undefined.
+  auto getOwn = [&](const PropertyMap& bag) -> std::optional<Value> {
+    if (bag.hasAccessors()) {
+      if (const Value* getter = bag.getter(key)) {
+        if (!getter->isFunction()) {
+          return Value(Undefined{});
+        }
+        Value fn = *getter;  // The call may reshape the bag
+        return callFunction(fn, {}, receiver);
+      }
+      if (bag.setter(key)) {
+        return Value(Undefined{});
       }
-      return {true, Value(Undefined{})};
-    }
-    // Accessor with setter only: Get returns undefined but the property exists.
-    std::string setterKey = "__set_" + key;
-    if (bag.find(setterKey) != bag.end()) {
-      return {true, Value(Undefined{})};
     }
-
-    auto it = bag.find(key);
-    if (it != bag.end()) {
-      return {true, it->second};
+    if (const Value* slot = bag.lookup(key)) {
+      return *slot;
     }
+    return std::nullopt;
+  };
 
-    // Walk the prototype chain through any object-like value.
-    auto protoIt = bag.find("__proto__");
-    if (protoIt == bag.end() || !isObjectLike(protoIt->second)) {
-      return {false, Value(Undefined{})};
-    }
-    if (!protoIt->second.isObject()) {
-      return getPropertyForPrimitive(protoIt->second, key);
-    }
-    auto current = protoIt->second.getGC<Object>();
+  // Walk the prototype chain through any object-like value.
+  auto getFromPropertyBag = [&](const PropertyMap& bag) -> std::pair<bool, Value> {
+    const PropertyMap* current = &bag;
     int depth = 0;
-    while (current && depth <= 16) {
+    while (depth <= 17) {
       depth++;
-      auto protoGetterIt = current->properties.find("__get_" + key);
-      if (protoGetterIt != current->properties.end()) {
-        if (protoGetterIt->second.isFunction()) {
-          return {true, callFunction(protoGetterIt->second, {}, receiver)};
-        }
-        return {true, Value(Undefined{})};
-      }
-      if (current->properties.find("__set_" + key) != current->properties.end()) {
-        return {true, Value(Undefined{})};
-      }
-      auto foundIt = current->properties.find(key);
-      if (foundIt != current->properties.end()) {
-        return {true, foundIt->second};
+      if (auto own = getOwn(*current)) {
+        return {true, *own};
       }
-      auto nextProto = current->properties.find("__proto__");
-      if (nextProto == current->properties.end() || !isObjectLike(nextProto->second)) {
+      const Value* proto = current->prototype();
+      if (!proto || !isObjectLike(*proto)) {
         break;
       }
-      if (!nextProto->second.isObject()) {
-        return getPropertyForPrimitive(nextProto->second, key);
+      if (!proto->isObject()) {
+        return getPropertyForPrimitive(*proto, key);
       }
-      current = nextProto->second.getGC<Object>();
+      current = &proto->getGC<Object>()->properties;
     }
-
     return {false, Value(Undefined{})};
   };
 
   if (receiver.isObject()) {
-    auto current = receiver.getGC<Object>();
-    int depth = 0;
-    while (current && depth <= 16) {
-      depth++;
-
-      std::string getterKey = "__get_" + key;
-      auto getterIt = current->properties.find(getterKey);
-      if (getterIt != current->properties.end()) {
-        if (getterIt->second.isFunction()) {
-          return {true, callFunction(getterIt->second, {}, receiver)};
-        }
-        return {true, Value(Undefined{})};
-      }
-      if (current->properties.find("__set_" + key) != current->properties.end()) {
-        return {true, Value(Undefined{})};
-      }
-
-      auto it = current->properties.find(key);
-      if (it != current->properties.end()) {
-        return {true, it->second};
-      }
-
-      auto protoIt = current->properties.find("__proto__");
-      if (protoIt == current->properties.end() || !isObjectLike(protoIt->second)) {
-        break;
-      }
-      if (!protoIt->second.isObject()) {
-        return getPropertyForPrimitive(protoIt->second, key);
-      }
-      current = protoIt->second.getGC<Object>();
-    }
-    return {false, Value(Undefined{})};
+    return getFromPropertyBag(receiver.getGC<Object>()->properties);
   }
 
   if (receiver.isArray()) {
@@ -1340,7 +1418,7 @@ std::pair<bool, Value> Interpreter::getPropertyForPrimitive(const Value& receive
       if (storedLen != arr->properties.end()) {
         return {true, storedLen->second};
       }
-      return {true, Value(static_cast<double>(arr->elements.size()))};
+      return {true, Value(static_cast<double>(arr->elementCount()))};
     }
 
     auto getterIt = arr->properties.find("__get_" + key);
@@ -1355,11 +1433,11 @@ std::pair<bool, Value> Interpreter::getPropertyForPrimitive(const Value& receive
     }
 
     size_t index = 0;
-    if (parseArrayIndex(key, index) && index < arr->elements.size()) {
+    if (parseArrayIndex(key, index) && index < arr->elementCount()) {
       // Check if element was deleted/is a hole — fall through to prototype
       if (arr->properties.find("__deleted_" + key + "__") == arr->properties.end() &&
           arr->properties.find("__hole_" + key + "__") == arr->properties.end()) {
-        return {true, arr->elements[index]};
+        return {true, arr->element(index)};
       }
     }
 
@@ -1472,6 +1550,9 @@ std::pair<bool, Value> Interpreter::getPropertyForPrimitive(const Value& receive
     if (key == "message") {
       return {true, Value(err->message)};
     }
+    if (key == "stack") {
+      return {true, Value(err->stack())};
+    }
     if (key == "constructor") {
       if (auto ctor = env_->get(err->getName())) {
         return {true, *ctor};
@@ -1569,10 +1650,10 @@ Value Interpreter::toPrimitiveValue(const Value& input, bool preferString, bool
     if (std::string(methodName) == "toString" && input.isArray()) {
       auto arr = input.getGC<Array>();
       std::string out;
-      for (size_t i = 0; i < arr->elements.size(); i++) {
+      for (size_t i = 0; i < arr->elementCount(); i++) {
         if (i > 0) out += ",";
-        if (!arr->elements[i].isUndefined() && !arr->elements[i].isNull()) {
-          out += arr->elements[i].toString();
+        if (!arr->element(i).isUndefined() && !arr->element(i).isNull()) {
+          out += arr->element(i).toString();
         }
       }
       return Value(out);
@@ -1598,9 +1679,9 @@ Value Interpreter::toPrimitiveValue(const Value& input, bool preferString, bool
       if (input.isArray()) {
         auto arr = input.getGC<Array>();
         std::string out;
-        for (size_t i = 0; i < arr->elements.size(); i++) {
+        for (size_t i = 0; i < arr->elementCount(); i++) {
           if (i > 0) out += ",";
-          out += arr->elements[i].toString();
+          out += arr->element(i).toString();
         }
         return Value(out);
       }
@@ -2364,41 +2445,14 @@ Task Interpreter::evaluate(const Statement& stmt) {
       func->closure = env_;
       func->properties["__private_owner_class__"] = Value(cls);
 
-      size_t methodLength = 0;
-      bool sawDefault = false;
-      for (const auto& param : method.params) {
-        FunctionParam funcParam;
-        funcParam.name = param.name.name;
-        if (param.defaultValue) {
-          funcParam.defaultValue = std::shared_ptr<void>(
-              const_cast<Expression*>(param.defaultValue.get()),
-              [](void*) {});
-          sawDefault = true;
-        } else if (!sawDefault) {
-          methodLength++;
-        }
-        func->params.push_back(funcParam);
-      }
-      if (method.restParam.has_value()) {
-        func->restParam = method.restParam->name;
-      }
-
-      // Store the body reference
-      func->body = std::shared_ptr<void>(
-        const_cast<std::vector<StmtPtr>*>(&method.body),
-        [](void*){} // No-op deleter
-      );
-      func->destructurePrologue = std::shared_ptr<void>(
-        const_cast<std::vector<StmtPtr>*>(&method.destructurePrologue),
-        [](void*){} // No-op deleter
-      );
-      func->properties["length"] = Value(static_cast<double>(methodLength));
+      func->shared = sharedFunctionInfo(method);
+      func->properties["length"] = Value(static_cast<double>(func->shared->length));
       if (method.kind == MethodDefinition::Kind::Constructor) {
         func->properties["name"] = Value(std::string("constructor"));
       } else {
         std::string baseName;
         if (propKeyForName.isSymbol()) {
-          const auto& sym = std::get<Symbol>(propKeyForName.data);
+          const auto& sym = propKeyForName.asSymbol();
           baseName = sym.description.empty() ? "" : "[" + sym.description + "]";
         } else {
           baseName = toPropertyKeyString(propKeyForName);
@@ -2479,7 +2533,7 @@ Task Interpreter::evaluate(const Statement& stmt) {
       cls->properties["__non_writable_name"] = Value(true);
       cls->properties["__non_enum_name"] = Value(true);
     }
-    int ctorLen = cls->constructor ? static_cast<int>(cls->constructor->params.size()) : 0;
+    int ctorLen = cls->constructor ? static_cast<int>(cls->constructor->shared->params.size()) : 0;
     if (cls->properties.find("length") == cls->properties.end() &&
         cls->properties.find("__get_length") == cls->properties.end() &&
         cls->properties.find("__set_length") == cls->properties.end()) {
@@ -2512,7 +2566,7 @@ Task Interpreter::evaluate(const Statement& stmt) {
       bool prevStrict = strictMode_;
       env_ = cls->closure;
       env_ = env_->createChild();
-      env_->define("__var_scope__", Value(true), true);
+      env_->markVarScope();
       env_->define("this", Value(cls));
       env_->define("__new_target__", Value(Undefined{}));
       auto superIt = cls->properties.find("__proto__");
@@ -2639,89 +2693,227 @@ Task Interpreter::evaluate(const Statement& stmt) {
   LIGHTJS_RETURN(Value(Empty{}));
 }
 
-Task Interpreter::evaluate(const Expression& expr) {
-  // Stack overflow protection
-  StackGuard guard(stackDepth_, MAX_STACK_DEPTH);
-  if (guard.overflowed()) {
-    throwError(ErrorType::RangeError, "Maximum call stack size exceeded");
-    LIGHTJS_RETURN(Value(Undefined{}));
+const Value* Interpreter::staticBinding(const Identifier& id) {
+  if (!id.staticScope) {
+    return nullptr;
+  }
+  if (id.atom == kNoAtom) {
+    id.atom = atomize(id.name);
+  }
+  bool inTDZ = false;
+  const Value* value = env_->globalSlotValue(id.globalCache, id.atom, inTDZ);
+  if (!value && id.scopeHops != UINT32_MAX) {
+    value = env_->slotValue(id.scopeHops, id.scopeSlot, id.atom, inTDZ);
+  }
+  if (!value && env_->resolveSlot(id.atom, id.scopeHops, id.scopeSlot)) {
+    value = env_->slotValue(id.scopeHops, id.scopeSlot, id.atom, inTDZ);
+    env_->resolveGlobal(id.atom, id.globalCache);
   }
+  // TDZ errors and module bindings take the by-name path.
+  return value && !inTDZ && !value->isModuleBinding() ? value : nullptr;
+}
 
-  if (auto* node = std::get_if<Identifier>(&expr.node)) {
-    // Check for temporal dead zone
-    if (env_->isTDZ(node->name)) {
-      throwError(ErrorType::ReferenceError,
-                 formatError("Cannot access '" + node->name + "' before initialization", expr.loc));
-      LIGHTJS_RETURN(Value(Undefined{}));
+const Value* Interpreter::cachedGlobal(GlobalBindingCache& cache, Atom name) {
+  bool inTDZ = false;
+  const Value* value = env_->globalSlotValue(cache, name, inTDZ);
+  // Names known to resolve below the root skip the walk; stale global
+  // entries (deleted and re-declared bindings) are re-resolved.
+  if (!value && (cache.root != env_->getRoot() || cache.slot != GlobalBindingCache::kNotGlobal) &&
+      env_->resolveGlobal(name, cache)) {
+    value = env_->globalSlotValue(cache, name, inTDZ);
+  }
+  return value && !inTDZ && !value->isModuleBinding() ? value : nullptr;
+}
+
+Value Interpreter::lookupIdentifier(const Identifier& id, const SourceLocation& loc) {
+  if (const Value* value = staticBinding(id)) {
+    return *value;
+  }
+  return lookupIdentifier(id.name, loc, !id.tdzFree);
+}
+
+Value Interpreter::lookupIdentifier(const std::string& name, const SourceLocation& loc,
+                                    bool checkTDZ) {
+  // Check for temporal dead zone
+  if (checkTDZ && env_->isTDZ(name)) {
+    throwError(ErrorType::ReferenceError,
+               formatError("Cannot access '" + name + "' before initialization", loc));
+    return Value(Undefined{});
+  }
+  if (auto withScopeValue = env_->resolveWithScopeValue(name)) {
+    auto withValue = env_->getWithScopeBindingValue(*withScopeValue, name, strictMode_);
+    if (hasError()) {
+      return Value(Undefined{});
     }
-    if (auto withScopeValue = env_->resolveWithScopeValue(node->name)) {
-      auto withValue = env_->getWithScopeBindingValue(*withScopeValue, node->name, strictMode_);
-      if (hasError()) {
-        LIGHTJS_RETURN(Value(Undefined{}));
+    if (withValue.has_value()) {
+      return *withValue;
+    }
+  }
+  if (auto val = env_->getIgnoringWith(name)) {
+    if (val->isModuleBinding()) {
+      const auto& binding = val->asModuleBinding();
+      auto module = binding.module.lock();
+      if (!module) {
+        throwError(ErrorType::ReferenceError,
+                   formatError("Cannot access '" + name + "' before initialization", loc));
+        return Value(Undefined{});
       }
-      if (withValue.has_value()) {
-        LIGHTJS_RETURN(*withValue);
+      auto exportValue = module->getExport(binding.exportName);
+      if (!exportValue) {
+        throwError(ErrorType::ReferenceError,
+                   formatError("Cannot access '" + name + "' before initialization", loc));
+        return Value(Undefined{});
       }
+      return *exportValue;
     }
-    if (auto val = env_->getIgnoringWith(node->name)) {
-      if (val->isModuleBinding()) {
-        const auto& binding = std::get<ModuleBinding>(val->data);
-        auto module = binding.module.lock();
-        if (!module) {
-          throwError(ErrorType::ReferenceError,
-                     formatError("Cannot access '" + node->name + "' before initialization", expr.loc));
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
-        auto exportValue = module->getExport(binding.exportName);
-        if (!exportValue) {
-          throwError(ErrorType::ReferenceError,
-                     formatError("Cannot access '" + node->name + "' before initialization", expr.loc));
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
-        LIGHTJS_RETURN(*exportValue);
-      }
-      LIGHTJS_RETURN(*val);
+    return *val;
+  }
+  for (auto it = activeNamedExpressionStack_.rbegin();
+       it != activeNamedExpressionStack_.rend();
+       ++it) {
+    const auto& fn = *it;
+    auto nameIt = fn->properties.find("name");
+    if (nameIt != fn->properties.end() &&
+        nameIt->second.isString() &&
+        nameIt->second.toString() == name) {
+      return Value(fn);
     }
-    for (auto it = activeNamedExpressionStack_.rbegin();
-         it != activeNamedExpressionStack_.rend();
-         ++it) {
-      const auto& fn = *it;
-      auto nameIt = fn->properties.find("name");
-      if (nameIt != fn->properties.end() &&
-          nameIt->second.isString() &&
-          nameIt->second.toString() == node->name) {
-        LIGHTJS_RETURN(Value(fn));
+  }
+
+  // As a last resort, resolve global object accessors as identifier bindings.
+  // This is needed for cases like:
+  //   Object.defineProperty(globalThis, "y", { get(){...} });
+  //   y; // should invoke getter
+  if (auto globalObj = env_->getGlobal()) {
+    if (const Value* getter = globalObj->properties.getter(name); getter && getter->isFunction()) {
+      Value fn = *getter;
+      Value v = callFunction(fn, {}, Value(globalObj));
+      if (flow_.type == ControlFlow::Type::Throw || hasError()) {
+        return Value(Undefined{});
       }
+      return v;
+    }
+    if (const Value* value = globalObj->properties.lookup(name)) {
+      return *value;
     }
+  }
 
-    // As a last resort, resolve global object accessors as identifier bindings.
-    // This is needed for cases like:
-    //   Object.defineProperty(globalThis, "y", { get(){...} });
-    //   y; // should invoke getter
-    if (auto globalObj = env_->getGlobal()) {
-      auto getterIt = globalObj->properties.find("__get_" + node->name);
-      if (getterIt != globalObj->properties.end() && getterIt->second.isFunction()) {
-        Value v = callFunction(getterIt->second, {}, Value(globalObj));
-        if (flow_.type == ControlFlow::Type::Throw || hasError()) {
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
-        LIGHTJS_RETURN(v);
+  // Throw ReferenceError for undefined variables with line info
+  throwError(ErrorType::ReferenceError, formatError("'" + name + "' is not defined", loc));
+  return Value(Undefined{});
+}
+
+Value Interpreter::resolveThisBinding() {
+  // In derived constructors, `this` is uninitialized before super().
+  if (auto superCalled = env_->get("__super_called__");
+      superCalled && superCalled->isBool() && !superCalled->toBool()) {
+    throwError(ErrorType::ReferenceError,
+               "Must call super constructor in derived class before accessing 'this'");
+    return Value(Undefined{});
+  }
+  // Look up 'this' in the current environment
+  if (auto thisVal = env_->get("this")) {
+    return *thisVal;
+  }
+  return Value(Undefined{});
+}
+
+Task Interpreter::evaluate(const Expression& expr) {
+  if (!expr.canSuspend) {
+    return Task(evaluateSync(expr));
+  }
+  return evaluateSuspendable(expr);
+}
+
+Value Interpreter::evaluateSync(const Expression& expr) {
+  // Kinds evaluated inline by evaluateSuspendable (templates, regex and bigint
+  // literals, super, meta properties) are rare; run its coroutine, which
+  // guards the stack itself.
+  if (std::holds_alternative<TemplateLiteral>(expr.node) ||
+      std::holds_alternative<TemplateObjectExpr>(expr.node) ||
+      std::holds_alternative<RegexLiteral>(expr.node) ||
+      std::holds_alternative<BigIntLiteral>(expr.node) ||
+      std::holds_alternative<SuperExpr>(expr.node) ||
+      std::holds_alternative<MetaProperty>(expr.node)) {
+    auto task = evaluateSuspendable(expr);
+    Value result;
+    LIGHTJS_RUN_TASK_SYNC(task, result);
+    return result;
+  }
+
+  StackGuard guard(stackDepth_, MAX_STACK_DEPTH);
+  if (guard.overflowed()) {
+    throwError(ErrorType::RangeError, "Maximum call stack size exceeded");
+    return Value(Undefined{});
+  }
+
+  if (auto* node = std::get_if<Identifier>(&expr.node)) {
+    return lookupIdentifier(*node, expr.loc);
+  } else if (auto* node = std::get_if<NumberLiteral>(&expr.node)) {
+    return numberValue(node->value);
+  } else if (auto* node = std::get_if<MemberExpr>(&expr.node)) {
+    return evaluateMemberSync(*node);
+  } else if (auto* node = std::get_if<BinaryExpr>(&expr.node)) {
+    return evaluateBinarySync(*node);
+  } else if (auto* node = std::get_if<StringLiteral>(&expr.node)) {
+    return Value(node->value);
+  } else if (auto* node = std::get_if<BoolLiteral>(&expr.node)) {
+    return Value(node->value);
+  } else if (std::holds_alternative<NullLiteral>(expr.node)) {
+    return Value(Null{});
+  } else if (std::holds_alternative<ThisExpr>(expr.node)) {
+    return resolveThisBinding();
+  } else if (auto* node = std::get_if<ConditionalExpr>(&expr.node)) {
+    if (evaluateSync(*node->test).toBool()) {
+      return evaluateSync(*node->consequent);
+    }
+    return evaluateSync(*node->alternate);
+  } else if (auto* node = std::get_if<SequenceExpr>(&expr.node)) {
+    Value last = Value(Undefined{});
+    for (const auto& sequenceExpr : node->expressions) {
+      if (!sequenceExpr) {
+        continue;
       }
-      auto propIt = globalObj->properties.find(node->name);
-      if (propIt != globalObj->properties.end()) {
-        LIGHTJS_RETURN(propIt->second);
+      last = evaluateSync(*sequenceExpr);
+      if (flow_.type != ControlFlow::Type::None) {
+        break;
       }
     }
+    return last;
+  }
+
+  // The remaining kinds keep their coroutine implementation. Nothing below
+  // this node can yield or await, so the task runs to completion here.
+  auto task = [&]() -> Task {
+    if (auto* node = std::get_if<CallExpr>(&expr.node)) return evaluateCall(*node);
+    if (auto* node = std::get_if<AssignmentExpr>(&expr.node)) return evaluateAssignment(*node);
+    if (auto* node = std::get_if<UpdateExpr>(&expr.node)) return evaluateUpdate(*node);
+    if (auto* node = std::get_if<UnaryExpr>(&expr.node)) return evaluateUnary(*node);
+    if (auto* node = std::get_if<ObjectExpr>(&expr.node)) return evaluateObject(*node);
+    if (auto* node = std::get_if<ArrayExpr>(&expr.node)) return evaluateArray(*node);
+    if (auto* node = std::get_if<FunctionExpr>(&expr.node)) return evaluateFunction(*node);
+    if (auto* node = std::get_if<NewExpr>(&expr.node)) return evaluateNew(*node);
+    if (auto* node = std::get_if<ClassExpr>(&expr.node)) return evaluateClass(*node);
+    return Task(Value(Undefined{}));
+  }();
+  Value result;
+  LIGHTJS_RUN_TASK_SYNC(task, result);
+  return result;
+}
 
-    // Throw ReferenceError for undefined variables with line info
-    throwError(ErrorType::ReferenceError, formatError("'" + node->name + "' is not defined", expr.loc));
+Task Interpreter::evaluateSuspendable(const Expression& expr) {
+  // Stack overflow protection
+  StackGuard guard(stackDepth_, MAX_STACK_DEPTH);
+  if (guard.overflowed()) {
+    throwError(ErrorType::RangeError, "Maximum call stack size exceeded");
     LIGHTJS_RETURN(Value(Undefined{}));
+  }
+
+  if (auto* node = std::get_if<Identifier>(&expr.node)) {
+    LIGHTJS_RETURN(lookupIdentifier(*node, expr.loc));
   } else if (auto* node = std::get_if<NumberLiteral>(&expr.node)) {
     // Use cached value for small integers
-    if (SmallIntCache::inRange(node->value)) {
-      LIGHTJS_RETURN(SmallIntCache::get(static_cast<int>(node->value)));
-    }
-    LIGHTJS_RETURN(Value(node->value));
+    LIGHTJS_RETURN(numberValue(node->value));
   } else if (auto* node = std::get_if<BigIntLiteral>(&expr.node)) {
     LIGHTJS_RETURN(Value(BigInt(node->value)));
   } else if (auto* node = std::get_if<StringLiteral>(&expr.node)) {
@@ -2765,12 +2957,12 @@ Task Interpreter::evaluate(const Expression& expr) {
     auto cookedArr = GarbageCollector::makeGC<Array>();
     GarbageCollector::instance().reportAllocation(sizeof(Array));
 
-    rawArr->elements.reserve(node->quasis.size());
-    cookedArr->elements.reserve(node->quasis.size());
+    rawArr->elements().reserve(node->quasis.size());
+    cookedArr->elements().reserve(node->quasis.size());
     for (const auto& q : node->quasis) {
-      rawArr->elements.push_back(Value(q.raw));
-      if (q.cooked.has_value()) cookedArr->elements.push_back(Value(*q.cooked));
-      else cookedArr->elements.push_back(Value(Undefined{}));
+      rawArr->pushElement(Value(q.raw));
+      if (q.cooked.has_value()) cookedArr->pushElement(Value(*q.cooked));
+      else cookedArr->pushElement(Value(Undefined{}));
     }
 
     // Define `.raw` on the cooked array.
@@ -2785,7 +2977,7 @@ Task Interpreter::evaluate(const Expression& expr) {
       arr->properties["__non_writable_length"] = Value(true);
       arr->properties["__non_configurable_length"] = Value(true);
       // Freeze indexed elements.
-      for (size_t idx = 0; idx < arr->elements.size(); idx++) {
+      for (size_t idx = 0; idx < arr->elementCount(); idx++) {
         std::string k = std::to_string(idx);
         arr->properties["__non_writable_" + k] = Value(true);
         arr->properties["__non_configurable_" + k] = Value(true);
@@ -2861,18 +3053,7 @@ Task Interpreter::evaluate(const Expression& expr) {
   } else if (auto* node = std::get_if<ClassExpr>(&expr.node)) {
     { auto _t = evaluateClass(*node); Value _v; LIGHTJS_RUN_TASK(_t, _v); LIGHTJS_RETURN(_v); }
   } else if (std::holds_alternative<ThisExpr>(expr.node)) {
-    // In derived constructors, `this` is uninitialized before super().
-    if (auto superCalled = env_->get("__super_called__");
-        superCalled && superCalled->isBool() && !superCalled->toBool()) {
-      throwError(ErrorType::ReferenceError,
-                 "Must call super constructor in derived class before accessing 'this'");
-      LIGHTJS_RETURN(Value(Undefined{}));
-    }
-    // Look up 'this' in the current environment
-    if (auto thisVal = env_->get("this")) {
-      LIGHTJS_RETURN(*thisVal);
-    }
-    LIGHTJS_RETURN(Value(Undefined{}));
+    LIGHTJS_RETURN(resolveThisBinding());
   } else if (std::holds_alternative<SuperExpr>(expr.node)) {
     // Compute super base from the active function's home object when available
     // (object/class methods), falling back to the environment binding.
@@ -3060,33 +3241,80 @@ Task Interpreter::evaluateBinary(const BinaryExpr& expr) {
     LIGHTJS_RETURN(Value(Undefined{}));
   }
 
+  LIGHTJS_RETURN(binaryOperation(expr.op, left, right));
+}
+
+Value Interpreter::evaluateBinarySync(const BinaryExpr& expr) {
+  // Private `#name in rhs` keeps the coroutine implementation.
+  if (expr.op == BinaryExpr::Op::In) {
+    if (auto* leftIdent = std::get_if<Identifier>(&expr.left->node);
+        leftIdent && !leftIdent->name.empty() && leftIdent->name[0] == '#') {
+      auto task = evaluateBinary(expr);
+      Value result;
+      LIGHTJS_RUN_TASK_SYNC(task, result);
+      return result;
+    }
+  }
+
+  Value left = evaluateSync(*expr.left);
+  if (flow_.type == ControlFlow::Type::Throw) {
+    return Value(Undefined{});
+  }
+
+  // Short-circuit evaluation for logical operators
+  if (expr.op == BinaryExpr::Op::LogicalAnd) {
+    return left.toBool() ? evaluateSync(*expr.right) : left;
+  }
+  if (expr.op == BinaryExpr::Op::LogicalOr) {
+    return left.toBool() ? left : evaluateSync(*expr.right);
+  }
+  if (expr.op == BinaryExpr::Op::NullishCoalescing) {
+    return (!left.isNull() && !left.isUndefined()) ? left : evaluateSync(*expr.right);
+  }
+
+  Value right = evaluateSync(*expr.right);
+  if (flow_.type != ControlFlow::Type::None || hasError()) {
+    return Value(Undefined{});
+  }
+  return binaryOperation(expr.op, left, right);
+}
+
+Value Interpreter::binaryOperation(BinaryExpr::Op op, const Value& left, const Value& right) {
+  // Fastest path: int32 operands whose result is still an int32
+  if (left.isInt32() && right.isInt32()) {
+    Value result;
+    if (int32BinaryOperation(op, left.asInt32(), right.asInt32(), result)) {
+      return result;
+    }
+  }
+
   // Fast path: both operands are numbers (most common case in loops)
   const bool leftIsNum = left.isNumber();
   const bool rightIsNum = right.isNumber();
 
   if (leftIsNum && rightIsNum) {
-    double l = std::get<double>(left.data);
-    double r = std::get<double>(right.data);
-    switch (expr.op) {
-      case BinaryExpr::Op::Add: LIGHTJS_RETURN(Value(l + r));
-      case BinaryExpr::Op::Sub: LIGHTJS_RETURN(Value(l - r));
-      case BinaryExpr::Op::Mul: LIGHTJS_RETURN(Value(l * r));
-      case BinaryExpr::Op::Div: LIGHTJS_RETURN(Value(l / r));
-      case BinaryExpr::Op::Mod: LIGHTJS_RETURN(Value(std::fmod(l, r)));
-      case BinaryExpr::Op::BitwiseAnd: LIGHTJS_RETURN(Value(static_cast<double>(toInt32(l) & toInt32(r))));
-      case BinaryExpr::Op::BitwiseOr: LIGHTJS_RETURN(Value(static_cast<double>(toInt32(l) | toInt32(r))));
-      case BinaryExpr::Op::BitwiseXor: LIGHTJS_RETURN(Value(static_cast<double>(toInt32(l) ^ toInt32(r))));
-      case BinaryExpr::Op::LeftShift: LIGHTJS_RETURN(Value(static_cast<double>(toInt32(l) << (toInt32(r) & 0x1f))));
-      case BinaryExpr::Op::RightShift: LIGHTJS_RETURN(Value(static_cast<double>(toInt32(l) >> (toInt32(r) & 0x1f))));
-      case BinaryExpr::Op::UnsignedRightShift: LIGHTJS_RETURN(Value(static_cast<double>(static_cast<uint32_t>(toInt32(l)) >> (toInt32(r) & 0x1f))));
-      case BinaryExpr::Op::Less: LIGHTJS_RETURN(Value(l < r));
-      case BinaryExpr::Op::Greater: LIGHTJS_RETURN(Value(l > r));
-      case BinaryExpr::Op::LessEqual: LIGHTJS_RETURN(Value(l <= r));
-      case BinaryExpr::Op::GreaterEqual: LIGHTJS_RETURN(Value(l >= r));
+    double l = left.asNumber();
+    double r = right.asNumber();
+    switch (op) {
+      case BinaryExpr::Op::Add: return Value(l + r);
+      case BinaryExpr::Op::Sub: return Value(l - r);
+      case BinaryExpr::Op::Mul: return Value(l * r);
+      case BinaryExpr::Op::Div: return Value(l / r);
+      case BinaryExpr::Op::Mod: return Value(std::fmod(l, r));
+      case BinaryExpr::Op::BitwiseAnd: return Value(toInt32(l) & toInt32(r));
+      case BinaryExpr::Op::BitwiseOr: return Value(toInt32(l) | toInt32(r));
+      case BinaryExpr::Op::BitwiseXor: return Value(toInt32(l) ^ toInt32(r));
+      case BinaryExpr::Op::LeftShift: return Value(toInt32(l) << (toInt32(r) & 0x1f));
+      case BinaryExpr::Op::RightShift: return Value(toInt32(l) >> (toInt32(r) & 0x1f));
+      case BinaryExpr::Op::UnsignedRightShift: return Value(static_cast<double>(static_cast<uint32_t>(toInt32(l)) >> (toInt32(r) & 0x1f)));
+      case BinaryExpr::Op::Less: return Value(l < r);
+      case BinaryExpr::Op::Greater: return Value(l > r);
+      case BinaryExpr::Op::LessEqual: return Value(l <= r);
+      case BinaryExpr::Op::GreaterEqual: return Value(l >= r);
       case BinaryExpr::Op::Equal:
-      case BinaryExpr::Op::StrictEqual: LIGHTJS_RETURN(Value(l == r));
+      case BinaryExpr::Op::StrictEqual: return Value(l == r);
       case BinaryExpr::Op::NotEqual:
-      case BinaryExpr::Op::StrictNotEqual: LIGHTJS_RETURN(Value(l != r));
+      case BinaryExpr::Op::StrictNotEqual: return Value(l != r);
       default: break;  // Fall through for other ops
     }
   }
@@ -3103,7 +3331,7 @@ Task Interpreter::evaluateBinary(const BinaryExpr& expr) {
 
   // Abstract Equality Comparison helpers (ES spec 7.2.14)
   auto sameReference = [&](const Value& a, const Value& b) -> bool {
-    if (a.data.index() != b.data.index()) return false;
+    if (!a.hasSameType(b)) return false;
     if (a.isObject()) return a.getGC<Object>().get() == b.getGC<Object>().get();
     if (a.isArray()) return a.getGC<Array>().get() == b.getGC<Array>().get();
     if (a.isFunction()) return a.getGC<Function>().get() == b.getGC<Function>().get();
@@ -3137,8 +3365,8 @@ Task Interpreter::evaluateBinary(const BinaryExpr& expr) {
       if (x.isBool() && y.isBool()) return x.toBool() == y.toBool();
       if (x.isBigInt() && y.isBigInt()) return x.toBigInt() == y.toBigInt();
       if (x.isSymbol() && y.isSymbol()) {
-        const auto& xs = std::get<Symbol>(x.data);
-        const auto& ys = std::get<Symbol>(y.data);
+        const auto& xs = x.asSymbol();
+        const auto& ys = y.asSymbol();
         return xs.id == ys.id;
       }
       if (isObjectLike(x) && isObjectLike(y)) {
@@ -3211,201 +3439,201 @@ Task Interpreter::evaluateBinary(const BinaryExpr& expr) {
     return false;
   };
 
-  switch (expr.op) {
+  switch (op) {
     case BinaryExpr::Op::Add: {
       Value lhs = isObjectLike(left) ? toPrimitiveValue(left, false, true) : left;
-      if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
+      if (hasError()) return Value(Undefined{});
       Value rhs = isObjectLike(right) ? toPrimitiveValue(right, false, true) : right;
-      if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
+      if (hasError()) return Value(Undefined{});
 
       if ((lhs.isString() || rhs.isString()) && (lhs.isSymbol() || rhs.isSymbol())) {
         throwError(ErrorType::TypeError, "Cannot convert Symbol to string");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
       if (lhs.isString() || rhs.isString()) {
-        LIGHTJS_RETURN(Value(unicode::normalizeUTF8(lhs.toString() + rhs.toString())));
+        return Value(unicode::normalizeUTF8(lhs.toString() + rhs.toString()));
       }
       if (lhs.isBigInt() && rhs.isBigInt()) {
-        LIGHTJS_RETURN(Value(BigInt(lhs.toBigInt() + rhs.toBigInt())));
+        return Value(BigInt(lhs.toBigInt() + rhs.toBigInt()));
       }
       if (lhs.isBigInt() != rhs.isBigInt()) {
         throwError(ErrorType::TypeError, "Cannot mix BigInt and other types");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
       if (lhs.isSymbol() || rhs.isSymbol()) {
         throwError(ErrorType::TypeError, "Cannot convert Symbol to number");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
-      LIGHTJS_RETURN(Value(lhs.toNumber() + rhs.toNumber()));
+      return Value(lhs.toNumber() + rhs.toNumber());
     }
     case BinaryExpr::Op::Sub: {
       Value lhs;
-      if (!toNumericOperand(left, lhs)) LIGHTJS_RETURN(Value(Undefined{}));
+      if (!toNumericOperand(left, lhs)) return Value(Undefined{});
       Value rhs;
-      if (!toNumericOperand(right, rhs)) LIGHTJS_RETURN(Value(Undefined{}));
+      if (!toNumericOperand(right, rhs)) return Value(Undefined{});
 
       if (lhs.isBigInt() && rhs.isBigInt()) {
-        LIGHTJS_RETURN(Value(BigInt(lhs.toBigInt() - rhs.toBigInt())));
+        return Value(BigInt(lhs.toBigInt() - rhs.toBigInt()));
       }
       if (lhs.isBigInt() != rhs.isBigInt()) {
         throwError(ErrorType::TypeError, "Cannot mix BigInt and other types");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
-      LIGHTJS_RETURN(Value(lhs.toNumber() - rhs.toNumber()));
+      return Value(lhs.toNumber() - rhs.toNumber());
     }
     case BinaryExpr::Op::Mul: {
       Value lhs;
-      if (!toNumericOperand(left, lhs)) LIGHTJS_RETURN(Value(Undefined{}));
+      if (!toNumericOperand(left, lhs)) return Value(Undefined{});
       Value rhs;
-      if (!toNumericOperand(right, rhs)) LIGHTJS_RETURN(Value(Undefined{}));
+      if (!toNumericOperand(right, rhs)) return Value(Undefined{});
 
       if (lhs.isBigInt() && rhs.isBigInt()) {
-        LIGHTJS_RETURN(Value(BigInt(lhs.toBigInt() * rhs.toBigInt())));
+        return Value(BigInt(lhs.toBigInt() * rhs.toBigInt()));
       }
       if (lhs.isBigInt() != rhs.isBigInt()) {
         throwError(ErrorType::TypeError, "Cannot mix BigInt and other types");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
-      LIGHTJS_RETURN(Value(lhs.toNumber() * rhs.toNumber()));
+      return Value(lhs.toNumber() * rhs.toNumber());
     }
     case BinaryExpr::Op::Div: {
       Value lhs;
-      if (!toNumericOperand(left, lhs)) LIGHTJS_RETURN(Value(Undefined{}));
+      if (!toNumericOperand(left, lhs)) return Value(Undefined{});
       Value rhs;
-      if (!toNumericOperand(right, rhs)) LIGHTJS_RETURN(Value(Undefined{}));
+      if (!toNumericOperand(right, rhs)) return Value(Undefined{});
 
       if (lhs.isBigInt() && rhs.isBigInt()) {
         auto divisor = rhs.toBigInt();
         if (divisor == 0) {
           throwError(ErrorType::RangeError, "Division by zero");
-          LIGHTJS_RETURN(Value(Undefined{}));
+          return Value(Undefined{});
         }
-        LIGHTJS_RETURN(Value(BigInt(lhs.toBigInt() / divisor)));
+        return Value(BigInt(lhs.toBigInt() / divisor));
       }
       if (lhs.isBigInt() != rhs.isBigInt()) {
         throwError(ErrorType::TypeError, "Cannot mix BigInt and other types");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
-      LIGHTJS_RETURN(Value(lhs.toNumber() / rhs.toNumber()));
+      return Value(lhs.toNumber() / rhs.toNumber());
     }
     case BinaryExpr::Op::Mod: {
       Value lhs;
-      if (!toNumericOperand(left, lhs)) LIGHTJS_RETURN(Value(Undefined{}));
+      if (!toNumericOperand(left, lhs)) return Value(Undefined{});
       Value rhs;
-      if (!toNumericOperand(right, rhs)) LIGHTJS_RETURN(Value(Undefined{}));
+      if (!toNumericOperand(right, rhs)) return Value(Undefined{});
 
       if (lhs.isBigInt() && rhs.isBigInt()) {
         auto divisor = rhs.toBigInt();
         if (divisor == 0) {
           throwError(ErrorType::RangeError, "Division by zero");
-          LIGHTJS_RETURN(Value(Undefined{}));
+          return Value(Undefined{});
         }
-        LIGHTJS_RETURN(Value(BigInt(lhs.toBigInt() % divisor)));
+        return Value(BigInt(lhs.toBigInt() % divisor));
       }
       if (lhs.isBigInt() != rhs.isBigInt()) {
         throwError(ErrorType::TypeError, "Cannot mix BigInt and other types");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
-      LIGHTJS_RETURN(Value(std::fmod(lhs.toNumber(), rhs.toNumber())));
+      return Value(std::fmod(lhs.toNumber(), rhs.toNumber()));
     }
     case BinaryExpr::Op::BitwiseAnd: {
       Value lhs;
-      if (!toNumericOperand(left, lhs)) LIGHTJS_RETURN(Value(Undefined{}));
+      if (!toNumericOperand(left, lhs)) return Value(Undefined{});
       Value rhs;
-      if (!toNumericOperand(right, rhs)) LIGHTJS_RETURN(Value(Undefined{}));
+      if (!toNumericOperand(right, rhs)) return Value(Undefined{});
 
       if (lhs.isBigInt() && rhs.isBigInt()) {
-        LIGHTJS_RETURN(Value(BigInt(lhs.toBigInt() & rhs.toBigInt())));
+        return Value(BigInt(lhs.toBigInt() & rhs.toBigInt()));
       }
       if (lhs.isBigInt() != rhs.isBigInt()) {
         throwError(ErrorType::TypeError, "Cannot mix BigInt and other types in bitwise operations");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
-      LIGHTJS_RETURN(Value(static_cast<double>(toInt32(lhs.toNumber()) & toInt32(rhs.toNumber()))));
+      return Value(toInt32(lhs.toNumber()) & toInt32(rhs.toNumber()));
     }
     case BinaryExpr::Op::BitwiseOr: {
       Value lhs;
-      if (!toNumericOperand(left, lhs)) LIGHTJS_RETURN(Value(Undefined{}));
+      if (!toNumericOperand(left, lhs)) return Value(Undefined{});
       Value rhs;
-      if (!toNumericOperand(right, rhs)) LIGHTJS_RETURN(Value(Undefined{}));
+      if (!toNumericOperand(right, rhs)) return Value(Undefined{});
 
       if (lhs.isBigInt() && rhs.isBigInt()) {
-        LIGHTJS_RETURN(Value(BigInt(lhs.toBigInt() | rhs.toBigInt())));
+        return Value(BigInt(lhs.toBigInt() | rhs.toBigInt()));
       }
       if (lhs.isBigInt() != rhs.isBigInt()) {
         throwError(ErrorType::TypeError, "Cannot mix BigInt and other types in bitwise operations");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
-      LIGHTJS_RETURN(Value(static_cast<double>(toInt32(lhs.toNumber()) | toInt32(rhs.toNumber()))));
+      return Value(toInt32(lhs.toNumber()) | toInt32(rhs.toNumber()));
     }
     case BinaryExpr::Op::BitwiseXor: {
       Value lhs;
-      if (!toNumericOperand(left, lhs)) LIGHTJS_RETURN(Value(Undefined{}));
+      if (!toNumericOperand(left, lhs)) return Value(Undefined{});
       Value rhs;
-      if (!toNumericOperand(right, rhs)) LIGHTJS_RETURN(Value(Undefined{}));
+      if (!toNumericOperand(right, rhs)) return Value(Undefined{});
 
       if (lhs.isBigInt() && rhs.isBigInt()) {
-        LIGHTJS_RETURN(Value(BigInt(lhs.toBigInt() ^ rhs.toBigInt())));
+        return Value(BigInt(lhs.toBigInt() ^ rhs.toBigInt()));
       }
       if (lhs.isBigInt() != rhs.isBigInt()) {
         throwError(ErrorType::TypeError, "Cannot mix BigInt and other types in bitwise operations");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
-      LIGHTJS_RETURN(Value(static_cast<double>(toInt32(lhs.toNumber()) ^ toInt32(rhs.toNumber()))));
+      return Value(toInt32(lhs.toNumber()) ^ toInt32(rhs.toNumber()));
     }
     case BinaryExpr::Op::LeftShift: {
       Value lhs;
-      if (!toNumericOperand(left, lhs)) LIGHTJS_RETURN(Value(Undefined{}));
+      if (!toNumericOperand(left, lhs)) return Value(Undefined{});
       Value rhs;
-      if (!toNumericOperand(right, rhs)) LIGHTJS_RETURN(Value(Undefined{}));
+      if (!toNumericOperand(right, rhs)) return Value(Undefined{});
 
       if (lhs.isBigInt() && rhs.isBigInt()) {
         bool ok = false;
         auto shifted = applyBigIntShiftLeft(lhs.toBigInt(), rhs.toBigInt(), &ok);
         if (!ok) {
           throwError(ErrorType::RangeError, "Invalid BigInt shift count");
-          LIGHTJS_RETURN(Value(Undefined{}));
+          return Value(Undefined{});
         }
-        LIGHTJS_RETURN(Value(BigInt(shifted)));
+        return Value(BigInt(shifted));
       }
       if (lhs.isBigInt() != rhs.isBigInt()) {
         throwError(ErrorType::TypeError, "Cannot mix BigInt and other types in bitwise operations");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
-      LIGHTJS_RETURN(Value(static_cast<double>(toInt32(lhs.toNumber()) << (toInt32(rhs.toNumber()) & 0x1f))));
+      return Value(toInt32(lhs.toNumber()) << (toInt32(rhs.toNumber()) & 0x1f));
     }
     case BinaryExpr::Op::RightShift: {
       Value lhs;
-      if (!toNumericOperand(left, lhs)) LIGHTJS_RETURN(Value(Undefined{}));
+      if (!toNumericOperand(left, lhs)) return Value(Undefined{});
       Value rhs;
-      if (!toNumericOperand(right, rhs)) LIGHTJS_RETURN(Value(Undefined{}));
+      if (!toNumericOperand(right, rhs)) return Value(Undefined{});
 
       if (lhs.isBigInt() && rhs.isBigInt()) {
         bool ok = false;
         auto shifted = applyBigIntShiftRight(lhs.toBigInt(), rhs.toBigInt(), &ok);
         if (!ok) {
           throwError(ErrorType::RangeError, "Invalid BigInt shift count");
-          LIGHTJS_RETURN(Value(Undefined{}));
+          return Value(Undefined{});
         }
-        LIGHTJS_RETURN(Value(BigInt(shifted)));
+        return Value(BigInt(shifted));
       }
       if (lhs.isBigInt() != rhs.isBigInt()) {
         throwError(ErrorType::TypeError, "Cannot mix BigInt and other types in bitwise operations");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
-      LIGHTJS_RETURN(Value(static_cast<double>(toInt32(lhs.toNumber()) >> (toInt32(rhs.toNumber()) & 0x1f))));
+      return Value(toInt32(lhs.toNumber()) >> (toInt32(rhs.toNumber()) & 0x1f));
     }
     case BinaryExpr::Op::UnsignedRightShift: {
       Value lhs;
-      if (!toNumericOperand(left, lhs)) LIGHTJS_RETURN(Value(Undefined{}));
+      if (!toNumericOperand(left, lhs)) return Value(Undefined{});
       Value rhs;
-      if (!toNumericOperand(right, rhs)) LIGHTJS_RETURN(Value(Undefined{}));
+      if (!toNumericOperand(right, rhs)) return Value(Undefined{});
 
       if (lhs.isBigInt() || rhs.isBigInt()) {
         throwError(ErrorType::TypeError, "Cannot use unsigned right shift on BigInt");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
-      LIGHTJS_RETURN(Value(static_cast<double>(static_cast<uint32_t>(toInt32(lhs.toNumber())) >> (toInt32(rhs.toNumber()) & 0x1f))));
+      return Value(static_cast<double>(static_cast<uint32_t>(toInt32(lhs.toNumber())) >> (toInt32(rhs.toNumber()) & 0x1f)));
     }
     case BinaryExpr::Op::Exp: {
       // Evaluation order for **:
@@ -3418,7 +3646,7 @@ Task Interpreter::evaluateBinary(const BinaryExpr& expr) {
       // both operands, so we must ensure ToNumeric(lhs) happens before any
       // ToNumeric(rhs) coercion (Test262 order-of-evaluation).
       Value lhsPrim = isObjectLike(left) ? toPrimitiveValue(left, false) : left;
-      if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
+      if (hasError()) return Value(Undefined{});
 
       Value lhsNumeric;
       if (lhsPrim.isBigInt()) {
@@ -3426,13 +3654,13 @@ Task Interpreter::evaluateBinary(const BinaryExpr& expr) {
       } else {
         if (lhsPrim.isSymbol()) {
           throwError(ErrorType::TypeError, "Cannot convert Symbol to number");
-          LIGHTJS_RETURN(Value(Undefined{}));
+          return Value(Undefined{});
         }
         lhsNumeric = Value(lhsPrim.toNumber());
       }
 
       Value rhsPrim = isObjectLike(right) ? toPrimitiveValue(right, false) : right;
-      if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
+      if (hasError()) return Value(Undefined{});
 
       Value rhsNumeric;
       if (rhsPrim.isBigInt()) {
@@ -3440,7 +3668,7 @@ Task Interpreter::evaluateBinary(const BinaryExpr& expr) {
       } else {
         if (rhsPrim.isSymbol()) {
           throwError(ErrorType::TypeError, "Cannot convert Symbol to number");
-          LIGHTJS_RETURN(Value(Undefined{}));
+          return Value(Undefined{});
         }
         rhsNumeric = Value(rhsPrim.toNumber());
       }
@@ -3450,338 +3678,338 @@ Task Interpreter::evaluateBinary(const BinaryExpr& expr) {
         auto exp = rhsNumeric.toBigInt();
         if (exp < 0) {
           throwError(ErrorType::RangeError, "BigInt negative exponent");
-          LIGHTJS_RETURN(Value(Undefined{}));
+          return Value(Undefined{});
         }
-        LIGHTJS_RETURN(Value(BigInt(powBigInt(base, exp))));
+        return Value(BigInt(powBigInt(base, exp)));
       }
       if (lhsNumeric.isBigInt() != rhsNumeric.isBigInt()) {
         throwError(ErrorType::TypeError, "Cannot mix BigInt and other types");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
 
       double base = lhsNumeric.toNumber();
       double exp = rhsNumeric.toNumber();
       if (std::isinf(exp) && std::fabs(base) == 1.0) {
-        LIGHTJS_RETURN(Value(std::numeric_limits<double>::quiet_NaN()));
+        return Value(std::numeric_limits<double>::quiet_NaN());
       }
-      LIGHTJS_RETURN(Value(std::pow(base, exp)));
+      return Value(std::pow(base, exp));
     }
     case BinaryExpr::Op::Less: {
       Value lhs = isObjectLike(left) ? toPrimitiveValue(left, false) : left;
-      if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
+      if (hasError()) return Value(Undefined{});
       Value rhs = isObjectLike(right) ? toPrimitiveValue(right, false) : right;
-      if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
+      if (hasError()) return Value(Undefined{});
       if (lhs.isString() && rhs.isString()) {
-        LIGHTJS_RETURN(Value(compareStringsByUtf16CodeUnits(lhs.toString(), rhs.toString()) < 0));
+        return Value(compareStringsByUtf16CodeUnits(lhs.toString(), rhs.toString()) < 0);
       }
       if (lhs.isSymbol() || rhs.isSymbol()) {
         throwError(ErrorType::TypeError, "Cannot convert Symbol to number");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
       if (lhs.isBigInt() && rhs.isBigInt()) {
-        LIGHTJS_RETURN(Value(lhs.toBigInt() < rhs.toBigInt()));
+        return Value(lhs.toBigInt() < rhs.toBigInt());
       }
       if (lhs.isBigInt() && rhs.isString()) {
         bigint::BigIntValue parsed = 0;
         if (!parseBigIntString64(rhs.toString(), parsed)) {
-          LIGHTJS_RETURN(Value(false));
+          return Value(false);
         }
-        LIGHTJS_RETURN(Value(lhs.toBigInt() < parsed));
+        return Value(lhs.toBigInt() < parsed);
       }
       if (lhs.isString() && rhs.isBigInt()) {
         bigint::BigIntValue parsed = 0;
         if (!parseBigIntString64(lhs.toString(), parsed)) {
-          LIGHTJS_RETURN(Value(false));
+          return Value(false);
         }
-        LIGHTJS_RETURN(Value(parsed < rhs.toBigInt()));
+        return Value(parsed < rhs.toBigInt());
       }
       if (lhs.isBigInt() && rhs.isNumber()) {
         auto cmp = compareBigIntAndNumber(lhs.toBigInt(), rhs.toNumber());
-        LIGHTJS_RETURN(Value(cmp == BigIntNumberOrder::Less));
+        return Value(cmp == BigIntNumberOrder::Less);
       }
       if (lhs.isNumber() && rhs.isBigInt()) {
         auto cmp = compareBigIntAndNumber(rhs.toBigInt(), lhs.toNumber());
-        LIGHTJS_RETURN(Value(cmp == BigIntNumberOrder::Greater));
+        return Value(cmp == BigIntNumberOrder::Greater);
       }
-      LIGHTJS_RETURN(Value(lhs.toNumber() < rhs.toNumber()));
+      return Value(lhs.toNumber() < rhs.toNumber());
     }
     case BinaryExpr::Op::Greater: {
       Value lhs = isObjectLike(left) ? toPrimitiveValue(left, false) : left;
-      if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
+      if (hasError()) return Value(Undefined{});
       Value rhs = isObjectLike(right) ? toPrimitiveValue(right, false) : right;
-      if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
+      if (hasError()) return Value(Undefined{});
       if (lhs.isString() && rhs.isString()) {
-        LIGHTJS_RETURN(Value(compareStringsByUtf16CodeUnits(lhs.toString(), rhs.toString()) > 0));
+        return Value(compareStringsByUtf16CodeUnits(lhs.toString(), rhs.toString()) > 0);
       }
       if (lhs.isSymbol() || rhs.isSymbol()) {
         throwError(ErrorType::TypeError, "Cannot convert Symbol to number");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
       if (lhs.isBigInt() && rhs.isBigInt()) {
-        LIGHTJS_RETURN(Value(lhs.toBigInt() > rhs.toBigInt()));
+        return Value(lhs.toBigInt() > rhs.toBigInt());
       }
       if (lhs.isBigInt() && rhs.isString()) {
         bigint::BigIntValue parsed = 0;
         if (!parseBigIntString64(rhs.toString(), parsed)) {
-          LIGHTJS_RETURN(Value(false));
+          return Value(false);
         }
-        LIGHTJS_RETURN(Value(lhs.toBigInt() > parsed));
+        return Value(lhs.toBigInt() > parsed);
       }
       if (lhs.isString() && rhs.isBigInt()) {
         bigint::BigIntValue parsed = 0;
         if (!parseBigIntString64(lhs.toString(), parsed)) {
-          LIGHTJS_RETURN(Value(false));
+          return Value(false);
         }
-        LIGHTJS_RETURN(Value(parsed > rhs.toBigInt()));
+        return Value(parsed > rhs.toBigInt());
       }
       if (lhs.isBigInt() && rhs.isNumber()) {
         auto cmp = compareBigIntAndNumber(lhs.toBigInt(), rhs.toNumber());
-        LIGHTJS_RETURN(Value(cmp == BigIntNumberOrder::Greater));
+        return Value(cmp == BigIntNumberOrder::Greater);
       }
       if (lhs.isNumber() && rhs.isBigInt()) {
         auto cmp = compareBigIntAndNumber(rhs.toBigInt(), lhs.toNumber());
-        LIGHTJS_RETURN(Value(cmp == BigIntNumberOrder::Less));
+        return Value(cmp == BigIntNumberOrder::Less);
       }
-      LIGHTJS_RETURN(Value(lhs.toNumber() > rhs.toNumber()));
+      return Value(lhs.toNumber() > rhs.toNumber());
     }
     case BinaryExpr::Op::LessEqual: {
       Value lhs = isObjectLike(left) ? toPrimitiveValue(left, false) : left;
-      if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
+      if (hasError()) return Value(Undefined{});
       Value rhs = isObjectLike(right) ? toPrimitiveValue(right, false) : right;
-      if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
+      if (hasError()) return Value(Undefined{});
       if (lhs.isString() && rhs.isString()) {
-        LIGHTJS_RETURN(Value(compareStringsByUtf16CodeUnits(lhs.toString(), rhs.toString()) <= 0));
+        return Value(compareStringsByUtf16CodeUnits(lhs.toString(), rhs.toString()) <= 0);
       }
       if (lhs.isSymbol() || rhs.isSymbol()) {
         throwError(ErrorType::TypeError, "Cannot convert Symbol to number");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
       if (lhs.isBigInt() && rhs.isBigInt()) {
-        LIGHTJS_RETURN(Value(lhs.toBigInt() <= rhs.toBigInt()));
+        return Value(lhs.toBigInt() <= rhs.toBigInt());
       }
       if (lhs.isBigInt() && rhs.isString()) {
         bigint::BigIntValue parsed = 0;
         if (!parseBigIntString64(rhs.toString(), parsed)) {
-          LIGHTJS_RETURN(Value(false));
+          return Value(false);
         }
-        LIGHTJS_RETURN(Value(lhs.toBigInt() <= parsed));
+        return Value(lhs.toBigInt() <= parsed);
       }
       if (lhs.isString() && rhs.isBigInt()) {
         bigint::BigIntValue parsed = 0;
         if (!parseBigIntString64(lhs.toString(), parsed)) {
-          LIGHTJS_RETURN(Value(false));
+          return Value(false);
         }
-        LIGHTJS_RETURN(Value(parsed <= rhs.toBigInt()));
+        return Value(parsed <= rhs.toBigInt());
       }
       if (lhs.isBigInt() && rhs.isNumber()) {
         auto cmp = compareBigIntAndNumber(lhs.toBigInt(), rhs.toNumber());
-        LIGHTJS_RETURN(Value(cmp == BigIntNumberOrder::Less || cmp == BigIntNumberOrder::Equal));
+        return Value(cmp == BigIntNumberOrder::Less || cmp == BigIntNumberOrder::Equal);
       }
       if (lhs.isNumber() && rhs.isBigInt()) {
         auto cmp = compareBigIntAndNumber(rhs.toBigInt(), lhs.toNumber());
-        LIGHTJS_RETURN(Value(cmp == BigIntNumberOrder::Greater || cmp == BigIntNumberOrder::Equal));
+        return Value(cmp == BigIntNumberOrder::Greater || cmp == BigIntNumberOrder::Equal);
       }
-      LIGHTJS_RETURN(Value(lhs.toNumber() <= rhs.toNumber()));
+      return Value(lhs.toNumber() <= rhs.toNumber());
     }
     case BinaryExpr::Op::GreaterEqual: {
       Value lhs = isObjectLike(left) ? toPrimitiveValue(left, false) : left;
-      if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
+      if (hasError()) return Value(Undefined{});
       Value rhs = isObjectLike(right) ? toPrimitiveValue(right, false) : right;
-      if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
+      if (hasError()) return Value(Undefined{});
       if (lhs.isString() && rhs.isString()) {
-        LIGHTJS_RETURN(Value(compareStringsByUtf16CodeUnits(lhs.toString(), rhs.toString()) >= 0));
+        return Value(compareStringsByUtf16CodeUnits(lhs.toString(), rhs.toString()) >= 0);
       }
       if (lhs.isSymbol() || rhs.isSymbol()) {
         throwError(ErrorType::TypeError, "Cannot convert Symbol to number");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
       if (lhs.isBigInt() && rhs.isBigInt()) {
-        LIGHTJS_RETURN(Value(lhs.toBigInt() >= rhs.toBigInt()));
+        return Value(lhs.toBigInt() >= rhs.toBigInt());
       }
       if (lhs.isBigInt() && rhs.isString()) {
         bigint::BigIntValue parsed = 0;
         if (!parseBigIntString64(rhs.toString(), parsed)) {
-          LIGHTJS_RETURN(Value(false));
+          return Value(false);
         }
-        LIGHTJS_RETURN(Value(lhs.toBigInt() >= parsed));
+        return Value(lhs.toBigInt() >= parsed);
       }
       if (lhs.isString() && rhs.isBigInt()) {
         bigint::BigIntValue parsed = 0;
         if (!parseBigIntString64(lhs.toString(), parsed)) {
-          LIGHTJS_RETURN(Value(false));
+          return Value(false);
         }
-        LIGHTJS_RETURN(Value(parsed >= rhs.toBigInt()));
+        return Value(parsed >= rhs.toBigInt());
       }
       if (lhs.isBigInt() && rhs.isNumber()) {
         auto cmp = compareBigIntAndNumber(lhs.toBigInt(), rhs.toNumber());
-        LIGHTJS_RETURN(Value(cmp == BigIntNumberOrder::Greater || cmp == BigIntNumberOrder::Equal));
+        return Value(cmp == BigIntNumberOrder::Greater || cmp == BigIntNumberOrder::Equal);
       }
       if (lhs.isNumber() && rhs.isBigInt()) {
         auto cmp = compareBigIntAndNumber(rhs.toBigInt(), lhs.toNumber());
-        LIGHTJS_RETURN(Value(cmp == BigIntNumberOrder::Less || cmp == BigIntNumberOrder::Equal));
+        return Value(cmp == BigIntNumberOrder::Less || cmp == BigIntNumberOrder::Equal);
       }
-      LIGHTJS_RETURN(Value(lhs.toNumber() >= rhs.toNumber()));
+      return Value(lhs.toNumber() >= rhs.toNumber());
     }
     case BinaryExpr::Op::Equal: {
       // Abstract Equality Comparison (ES spec 7.2.14)
       bool eq = abstractEqual(left, right);
-      if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-      LIGHTJS_RETURN(Value(eq));
+      if (hasError()) return Value(Undefined{});
+      return Value(eq);
     }
     case BinaryExpr::Op::NotEqual: {
       bool eq = abstractEqual(left, right);
-      if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-      LIGHTJS_RETURN(Value(!eq));
+      if (hasError()) return Value(Undefined{});
+      return Value(!eq);
     }
     case BinaryExpr::Op::StrictEqual: {
       // Strict equality requires same type
-      if (left.data.index() != right.data.index()) {
-        LIGHTJS_RETURN(Value(false));
+      if (!left.hasSameType(right)) {
+        return Value(false);
       }
 
       if (left.isSymbol() && right.isSymbol()) {
-        auto& lsym = std::get<Symbol>(left.data);
-        auto& rsym = std::get<Symbol>(right.data);
-        LIGHTJS_RETURN(Value(lsym.id == rsym.id));
+        auto& lsym = left.asSymbol();
+        auto& rsym = right.asSymbol();
+        return Value(lsym.id == rsym.id);
       }
 
       if (left.isBigInt() && right.isBigInt()) {
-        LIGHTJS_RETURN(Value(left.toBigInt() == right.toBigInt()));
+        return Value(left.toBigInt() == right.toBigInt());
       }
 
       if (left.isNumber() && right.isNumber()) {
-        LIGHTJS_RETURN(Value(left.toNumber() == right.toNumber()));
+        return Value(left.toNumber() == right.toNumber());
       }
 
       if (left.isString() && right.isString()) {
-        LIGHTJS_RETURN(Value(std::get<std::string>(left.data) == std::get<std::string>(right.data)));
+        return Value(left.asString() == right.asString());
       }
 
       if (left.isBool() && right.isBool()) {
-        LIGHTJS_RETURN(Value(std::get<bool>(left.data) == std::get<bool>(right.data)));
+        return Value(std::get<bool>(left.data) == std::get<bool>(right.data));
       }
 
       if ((left.isNull() && right.isNull()) || (left.isUndefined() && right.isUndefined())) {
-        LIGHTJS_RETURN(Value(true));
+        return Value(true);
       }
 
       if (left.isObject() && right.isObject()) {
-        LIGHTJS_RETURN(Value(left.getGC<Object>().get() ==
+        return (Value(left.getGC<Object>().get() ==
                              right.getGC<Object>().get()));
       }
       if (left.isArray() && right.isArray()) {
-        LIGHTJS_RETURN(Value(left.getGC<Array>().get() ==
+        return (Value(left.getGC<Array>().get() ==
                              right.getGC<Array>().get()));
       }
       if (left.isFunction() && right.isFunction()) {
-        LIGHTJS_RETURN(Value(left.getGC<Function>().get() ==
+        return (Value(left.getGC<Function>().get() ==
                              right.getGC<Function>().get()));
       }
       if (left.isTypedArray() && right.isTypedArray()) {
-        LIGHTJS_RETURN(Value(left.getGC<TypedArray>().get() ==
+        return (Value(left.getGC<TypedArray>().get() ==
                              right.getGC<TypedArray>().get()));
       }
       if (left.isPromise() && right.isPromise()) {
-        LIGHTJS_RETURN(Value(left.getGC<Promise>().get() ==
+        return (Value(left.getGC<Promise>().get() ==
                              right.getGC<Promise>().get()));
       }
       if (left.isRegex() && right.isRegex()) {
-        LIGHTJS_RETURN(Value(left.getGC<Regex>().get() ==
+        return (Value(left.getGC<Regex>().get() ==
                              right.getGC<Regex>().get()));
       }
       if (left.isMap() && right.isMap()) {
-        LIGHTJS_RETURN(Value(left.getGC<Map>().get() ==
+        return (Value(left.getGC<Map>().get() ==
                              right.getGC<Map>().get()));
       }
       if (left.isSet() && right.isSet()) {
-        LIGHTJS_RETURN(Value(left.getGC<Set>().get() ==
+        return (Value(left.getGC<Set>().get() ==
                              right.getGC<Set>().get()));
       }
       if (left.isError() && right.isError()) {
-        LIGHTJS_RETURN(Value(left.getGC<Error>().get() ==
+        return (Value(left.getGC<Error>().get() ==
                              right.getGC<Error>().get()));
       }
       if (left.isGenerator() && right.isGenerator()) {
-        LIGHTJS_RETURN(Value(left.getGC<Generator>().get() ==
+        return (Value(left.getGC<Generator>().get() ==
                              right.getGC<Generator>().get()));
       }
       if (left.isProxy() && right.isProxy()) {
-        LIGHTJS_RETURN(Value(left.getGC<Proxy>().get() ==
+        return (Value(left.getGC<Proxy>().get() ==
                              right.getGC<Proxy>().get()));
       }
       if (left.isWeakMap() && right.isWeakMap()) {
-        LIGHTJS_RETURN(Value(std::get<GCPtr<WeakMap>>(left.data).get() ==
+        return (Value(std::get<GCPtr<WeakMap>>(left.data).get() ==
                              std::get<GCPtr<WeakMap>>(right.data).get()));
       }
       if (left.isWeakSet() && right.isWeakSet()) {
-        LIGHTJS_RETURN(Value(std::get<GCPtr<WeakSet>>(left.data).get() ==
+        return (Value(std::get<GCPtr<WeakSet>>(left.data).get() ==
                              std::get<GCPtr<WeakSet>>(right.data).get()));
       }
       if (left.isArrayBuffer() && right.isArrayBuffer()) {
-        LIGHTJS_RETURN(Value(left.getGC<ArrayBuffer>().get() ==
+        return (Value(left.getGC<ArrayBuffer>().get() ==
                              right.getGC<ArrayBuffer>().get()));
       }
       if (left.isDataView() && right.isDataView()) {
-        LIGHTJS_RETURN(Value(left.getGC<DataView>().get() ==
+        return (Value(left.getGC<DataView>().get() ==
                              right.getGC<DataView>().get()));
       }
       if (left.isClass() && right.isClass()) {
-        LIGHTJS_RETURN(Value(left.getGC<Class>().get() ==
+        return (Value(left.getGC<Class>().get() ==
                              right.getGC<Class>().get()));
       }
       if (left.isWasmInstance() && right.isWasmInstance()) {
-        LIGHTJS_RETURN(Value(left.getGC<WasmInstanceJS>().get() ==
+        return (Value(left.getGC<WasmInstanceJS>().get() ==
                              right.getGC<WasmInstanceJS>().get()));
       }
       if (left.isWasmMemory() && right.isWasmMemory()) {
-        LIGHTJS_RETURN(Value(left.getGC<WasmMemoryJS>().get() ==
+        return (Value(left.getGC<WasmMemoryJS>().get() ==
                              right.getGC<WasmMemoryJS>().get()));
       }
       if (left.isReadableStream() && right.isReadableStream()) {
-        LIGHTJS_RETURN(Value(left.getGC<ReadableStream>().get() ==
+        return (Value(left.getGC<ReadableStream>().get() ==
                              right.getGC<ReadableStream>().get()));
       }
       if (left.isWritableStream() && right.isWritableStream()) {
-        LIGHTJS_RETURN(Value(left.getGC<WritableStream>().get() ==
+        return (Value(left.getGC<WritableStream>().get() ==
                              right.getGC<WritableStream>().get()));
       }
       if (left.isTransformStream() && right.isTransformStream()) {
-        LIGHTJS_RETURN(Value(left.getGC<TransformStream>().get() ==
+        return (Value(left.getGC<TransformStream>().get() ==
                              right.getGC<TransformStream>().get()));
       }
 
-      LIGHTJS_RETURN(Value(false));
+      return Value(false);
     }
     case BinaryExpr::Op::StrictNotEqual: {
       // Reuse StrictEqual logic
-      if (left.data.index() != right.data.index()) {
-        LIGHTJS_RETURN(Value(true));
+      if (!left.hasSameType(right)) {
+        return Value(true);
       }
 
       if (left.isSymbol() && right.isSymbol()) {
-        auto& lsym = std::get<Symbol>(left.data);
-        auto& rsym = std::get<Symbol>(right.data);
-        LIGHTJS_RETURN(Value(lsym.id != rsym.id));
+        auto& lsym = left.asSymbol();
+        auto& rsym = right.asSymbol();
+        return Value(lsym.id != rsym.id);
       }
 
       if (left.isBigInt() && right.isBigInt()) {
-        LIGHTJS_RETURN(Value(left.toBigInt() != right.toBigInt()));
+        return Value(left.toBigInt() != right.toBigInt());
       }
 
       if (left.isNumber() && right.isNumber()) {
-        LIGHTJS_RETURN(Value(left.toNumber() != right.toNumber()));
+        return Value(left.toNumber() != right.toNumber());
       }
 
       if (left.isString() && right.isString()) {
-        LIGHTJS_RETURN(Value(std::get<std::string>(left.data) != std::get<std::string>(right.data)));
+        return Value(left.asString() != right.asString());
       }
 
       if (left.isBool() && right.isBool()) {
-        LIGHTJS_RETURN(Value(std::get<bool>(left.data) != std::get<bool>(right.data)));
+        return Value(std::get<bool>(left.data) != std::get<bool>(right.data));
       }
 
       if ((left.isNull() && right.isNull()) || (left.isUndefined() && right.isUndefined())) {
-        LIGHTJS_RETURN(Value(false));
+        return Value(false);
       }
 
       // For all reference types, strict inequality is pointer inequality.
@@ -3872,7 +4100,7 @@ Task Interpreter::evaluateBinary(const BinaryExpr& expr) {
         }
         return false;
       };
-      LIGHTJS_RETURN(Value(!equalByPointer(left, right)));
+      return Value(!equalByPointer(left, right));
     }
     // LogicalAnd, LogicalOr, and NullishCoalescing are handled above
     // with short-circuit evaluation (right side not evaluated if not needed)
@@ -3890,25 +4118,25 @@ Task Interpreter::evaluateBinary(const BinaryExpr& expr) {
             auto trap = trapIt->second.getGC<Function>();
             if (trap->isNative) {
               std::vector<Value> trapArgs = {*proxyPtr->target, toPropertyKeyValue(propName)};
-              LIGHTJS_RETURN(trap->nativeFunc(trapArgs));
+              return trap->nativeFunc(trapArgs);
             }
           }
         }
         // Fall through to check target
         if (proxyPtr->target && proxyPtr->target->isObject()) {
           auto targetObj = std::get<GCPtr<Object>>(proxyPtr->target->data);
-          LIGHTJS_RETURN(Value(targetObj->properties.find(propName) != targetObj->properties.end()));
+          return Value(targetObj->properties.find(propName) != targetObj->properties.end());
         }
-        LIGHTJS_RETURN(Value(false));
+        return Value(false);
       }
 
       if (!isObjectLike(right) && !right.isClass()) {
         throwError(ErrorType::TypeError, "Right-hand side of 'in' should be an object");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
 
       // Helper lambda to walk prototype chain for 'in' operator
-      auto hasPropertyInChain = [&](const OrderedMap<std::string, Value>& props) -> bool {
+      auto hasPropertyInChain = [&](const PropertyMap& props) -> bool {
         if (props.find(propName) != props.end()) return true;
         auto protoIt = props.find("__proto__");
         if (protoIt != props.end() && protoIt->second.isObject()) {
@@ -3947,73 +4175,73 @@ Task Interpreter::evaluateBinary(const BinaryExpr& expr) {
                                     propName) != objPtr->moduleExportNames.end()) ||
                          objPtr->properties.find("__get_" + propName) != objPtr->properties.end() ||
                          objPtr->properties.find(propName) != objPtr->properties.end();
-          LIGHTJS_RETURN(Value(hasProp));
+          return Value(hasProp);
         }
-        LIGHTJS_RETURN(Value(hasPropertyInChain(objPtr->properties)));
+        return Value(hasPropertyInChain(objPtr->properties));
       }
 
       if (right.isArray()) {
         auto arrPtr = right.getGC<Array>();
         size_t idx = 0;
         if (parseArrayIndex(propName, idx)) {
-          if (idx >= arrPtr->elements.size()) LIGHTJS_RETURN(Value(false));
+          if (idx >= arrPtr->elementCount()) return Value(false);
           // Check for holes and deleted elements
           if (arrPtr->properties.find("__deleted_" + propName + "__") != arrPtr->properties.end())
-            LIGHTJS_RETURN(Value(false));
+            return Value(false);
           if (arrPtr->properties.find("__hole_" + propName + "__") != arrPtr->properties.end())
-            LIGHTJS_RETURN(Value(false));
-          LIGHTJS_RETURN(Value(true));
+            return Value(false);
+          return Value(true);
         }
         if (propName == "length") {
           if (arrPtr->properties.find("__deleted_length__") != arrPtr->properties.end())
-            LIGHTJS_RETURN(Value(false));
-          LIGHTJS_RETURN(Value(true));
+            return Value(false);
+          return Value(true);
         }
-        LIGHTJS_RETURN(Value(hasPropertyInChain(arrPtr->properties)));
+        return Value(hasPropertyInChain(arrPtr->properties));
       }
 
       if (right.isFunction()) {
         auto fnPtr = right.getGC<Function>();
-        LIGHTJS_RETURN(Value(hasPropertyInChain(fnPtr->properties)));
+        return Value(hasPropertyInChain(fnPtr->properties));
       }
 
       if (right.isTypedArray()) {
         auto taPtr = right.getGC<TypedArray>();
         size_t idx = 0;
         if (parseArrayIndex(propName, idx)) {
-          LIGHTJS_RETURN(Value(idx < taPtr->currentLength()));
+          return Value(idx < taPtr->currentLength());
         }
         if (propName == "NaN" || propName == "-0" ||
             propName == "Infinity" || propName == "-Infinity") {
-          LIGHTJS_RETURN(Value(false));
+          return Value(false);
         }
-        LIGHTJS_RETURN(Value(hasPropertyInChain(taPtr->properties)));
+        return Value(hasPropertyInChain(taPtr->properties));
       }
 
       if (right.isClass()) {
         auto clsPtr = right.getGC<Class>();
-        LIGHTJS_RETURN(Value(hasPropertyInChain(clsPtr->properties)));
+        return Value(hasPropertyInChain(clsPtr->properties));
       }
 
       if (right.isRegex()) {
         auto regexPtr = right.getGC<Regex>();
-        LIGHTJS_RETURN(Value(hasPropertyInChain(regexPtr->properties)));
+        return Value(hasPropertyInChain(regexPtr->properties));
       }
 
       if (right.isPromise()) {
         auto promisePtr = right.getGC<Promise>();
-        LIGHTJS_RETURN(Value(hasPropertyInChain(promisePtr->properties)));
+        return Value(hasPropertyInChain(promisePtr->properties));
       }
 
       // Unhandled object-like should default to false after object checks.
-      LIGHTJS_RETURN(Value(false));
+      return Value(false);
     }
     case BinaryExpr::Op::Instanceof: {
       // ES2015 12.10.4 Runtime Semantics: InstanceofOperator(O, C)
       // 1. If Type(C) is not Object, throw a TypeError exception.
       if (!isObjectLike(right)) {
         throwError(ErrorType::TypeError, "Right-hand side of instanceof is not an object");
-        LIGHTJS_RETURN(Value(false));
+        return Value(false);
       }
 
       // 2. Let instOfHandler be GetMethod(C, @@hasInstance).
@@ -4024,12 +4252,12 @@ Task Interpreter::evaluateBinary(const BinaryExpr& expr) {
         const std::string& hasInstanceKey = WellKnownSymbols::hasInstanceKey();
         auto [foundHandler, handler] = getPropertyForExternal(right, hasInstanceKey);
         if (hasError()) {
-          LIGHTJS_RETURN(Value(Undefined{}));
+          return Value(Undefined{});
         }
         if (foundHandler && !handler.isUndefined()) {
           if (!handler.isFunction()) {
             throwError(ErrorType::TypeError, "Symbol.hasInstance is not callable");
-            LIGHTJS_RETURN(Value(Undefined{}));
+            return Value(Undefined{});
           }
 
           bool isIntrinsicHasInstance = false;
@@ -4048,14 +4276,14 @@ Task Interpreter::evaluateBinary(const BinaryExpr& expr) {
               }
             }
             if (hasError()) {
-              LIGHTJS_RETURN(Value(Undefined{}));
+              return Value(Undefined{});
             }
           }
 
           if (!isIntrinsicHasInstance) {
             Value result = callFunction(handler, {left}, right);
-            if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-            LIGHTJS_RETURN(Value(result.toBool()));
+            if (hasError()) return Value(Undefined{});
+            return Value(result.toBool());
           }
         }
       }
@@ -4082,7 +4310,7 @@ Task Interpreter::evaluateBinary(const BinaryExpr& expr) {
       // 4. If IsCallable(C) is false, throw a TypeError exception.
       if (!isCallableValue(right)) {
         throwError(ErrorType::TypeError, "Right-hand side of instanceof is not callable");
-        LIGHTJS_RETURN(Value(false));
+        return Value(false);
       }
 
       // Per spec: if LHS is a primitive (not object-like), return false
@@ -4091,7 +4319,7 @@ Task Interpreter::evaluateBinary(const BinaryExpr& expr) {
           !left.isClass() && !left.isProxy() && !left.isGenerator() &&
           !left.isMap() && !left.isSet() && !left.isWeakMap() && !left.isWeakSet() &&
           !left.isTypedArray() && !left.isArrayBuffer() && !left.isDataView()) {
-        LIGHTJS_RETURN(Value(false));
+        return Value(false);
       }
       auto unwrapConstructor = [&](const Value& ctor) -> Value {
         if (ctor.isObject()) {
@@ -4110,7 +4338,7 @@ Task Interpreter::evaluateBinary(const BinaryExpr& expr) {
       };
 
       auto sameCtor = [&](const Value& candidate, const Value& ctor) -> bool {
-        if (candidate.data.index() != ctor.data.index()) {
+        if (!candidate.hasSameType(ctor)) {
           return false;
         }
         if (candidate.isFunction()) {
@@ -4206,11 +4434,11 @@ Task Interpreter::evaluateBinary(const BinaryExpr& expr) {
         if (nameIt != ctor->properties.end() && nameIt->second.isString()) {
           const std::string ctorName = nameIt->second.toString();
           if (ctorName == "TypedArray") {
-            LIGHTJS_RETURN(Value(true));
+            return Value(true);
           }
           TypedArrayType expectedType = TypedArrayType::Uint8;
           if (typedArrayConstructorNameToType(ctorName, expectedType)) {
-            LIGHTJS_RETURN(Value(left.getGC<TypedArray>()->type == expectedType));
+            return Value(left.getGC<TypedArray>()->type == expectedType);
           }
         }
       }
@@ -4220,16 +4448,16 @@ Task Interpreter::evaluateBinary(const BinaryExpr& expr) {
         auto tagIt = ctor->properties.find("__error_type__");
         if (tagIt != ctor->properties.end() && tagIt->second.isNumber()) {
           auto err = left.getGC<Error>();
-          int expected = static_cast<int>(std::get<double>(tagIt->second.data));
+          int expected = static_cast<int>(tagIt->second.asNumber());
           // Exact match (e.g., new TypeError instanceof TypeError)
           if (static_cast<int>(err->type) == expected) {
-            LIGHTJS_RETURN(Value(true));
+            return Value(true);
           }
           // Base Error constructor matches all error types (inheritance)
           if (expected == static_cast<int>(ErrorType::Error)) {
-            LIGHTJS_RETURN(Value(true));
+            return Value(true);
           }
-          LIGHTJS_RETURN(Value(false));
+          return Value(false);
         }
       }
 
@@ -4251,11 +4479,11 @@ Task Interpreter::evaluateBinary(const BinaryExpr& expr) {
       // This is important when RHS is a callable object like Function.prototype
       auto ctorProto = getCtorPrototype(right);
       if (hasError()) {
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
       if (ctorProto.isUndefined()) {
         // Check if prototype property exists but is not an object → TypeError
-        OrderedMap<std::string, Value>* checkProps = nullptr;
+        PropertyMap* checkProps = nullptr;
         if (right.isFunction()) {
           checkProps = &right.getGC<Function>()->properties;
         } else if (right.isObject()) {
@@ -4267,14 +4495,14 @@ Task Interpreter::evaluateBinary(const BinaryExpr& expr) {
               !protoIt->second.isObject() &&
               !protoIt->second.isFunction()) {
             throwError(ErrorType::TypeError, "Function has non-object prototype in instanceof check");
-            LIGHTJS_RETURN(Value(false));
+            return Value(false);
           }
         }
       }
       if (!ctorProto.isUndefined()) {
         // Get the instance's __proto__ chain
         auto getProto = [](const Value& val) -> Value {
-          OrderedMap<std::string, Value>* props = nullptr;
+          PropertyMap* props = nullptr;
           if (val.isObject()) {
             props = &val.getGC<Object>()->properties;
           } else if (val.isArray()) {
@@ -4325,9 +4553,9 @@ Task Interpreter::evaluateBinary(const BinaryExpr& expr) {
         int depth = 0;
         while ((proto.isObject() || proto.isFunction()) && depth < 100) {
           if (sameProtoIdentity(proto, ctorProto)) {
-            LIGHTJS_RETURN(Value(true));
+            return Value(true);
           }
-          OrderedMap<std::string, Value>* props = nullptr;
+          PropertyMap* props = nullptr;
           if (proto.isObject()) {
             props = &proto.getGC<Object>()->properties;
           } else {
@@ -4345,7 +4573,7 @@ Task Interpreter::evaluateBinary(const BinaryExpr& expr) {
 
       // Fallback: check __constructor__ tag (for objects without proper __proto__ chain)
       if ((ctorValue.isFunction() || ctorValue.isClass()) && matchesConstructor(left, ctorValue)) {
-        LIGHTJS_RETURN(Value(true));
+        return Value(true);
       }
 
       // Built-in type checks for instanceof when __proto__ chain not available
@@ -4359,37 +4587,37 @@ Task Interpreter::evaluateBinary(const BinaryExpr& expr) {
             if (left.isObject()) {
               auto obj = left.getGC<Object>();
               if (obj->isModuleNamespace) {
-                LIGHTJS_RETURN(Value(false));
+                return Value(false);
               }
             }
             if (left.isObject() || left.isArray() || left.isFunction() ||
                 left.isRegex() || left.isPromise() || left.isError()) {
-              LIGHTJS_RETURN(Value(true));
+              return Value(true);
             }
           } else if (ctorName == "Array") {
             if (left.isArray()) {
-              LIGHTJS_RETURN(Value(true));
+              return Value(true);
             }
           } else if (ctorName == "Function") {
             if (left.isFunction()) {
-              LIGHTJS_RETURN(Value(true));
+              return Value(true);
             }
           } else if (ctorName == "RegExp") {
             if (left.isRegex()) {
-              LIGHTJS_RETURN(Value(true));
+              return Value(true);
             }
           } else if (ctorName == "Promise") {
             if (left.isPromise()) {
-              LIGHTJS_RETURN(Value(true));
+              return Value(true);
             }
           }
         }
       }
-      LIGHTJS_RETURN(Value(false));
+      return Value(false);
     }
   }
 
-  LIGHTJS_RETURN(Value(Undefined{}));
+  return Value(Undefined{});
 }
 
 Task Interpreter::evaluateUnary(const UnaryExpr& expr) {
@@ -4465,13 +4693,9 @@ Task Interpreter::evaluateUnary(const UnaryExpr& expr) {
         // Fall through to delete from target
         if (proxyPtr->target && proxyPtr->target->isObject()) {
           auto targetObj = std::get<GCPtr<Object>>(proxyPtr->target->data);
-          bool deleted = false;
-          deleted = targetObj->properties.erase(propName) > 0 || deleted;
-          deleted = targetObj->properties.erase("__get_" + propName) > 0 || deleted;
-          deleted = targetObj->properties.erase("__set_" + propName) > 0 || deleted;
-          if (deleted && targetObj->shape) {
-            targetObj->shape = nullptr; // Invalidate shape on delete
-          }
+          targetObj->properties.erase(propName);
+          targetObj->properties.erase("__get_" + propName);
+          targetObj->properties.erase("__set_" + propName);
           LIGHTJS_RETURN(Value(true));
         }
         LIGHTJS_RETURN(deleteFailed());
@@ -4547,13 +4771,9 @@ Task Interpreter::evaluateUnary(const UnaryExpr& expr) {
         if (objPtr->properties.count("__non_configurable_" + propName)) {
           LIGHTJS_RETURN(deleteFailed());
         }
-        bool deleted = false;
-        deleted = objPtr->properties.erase(propName) > 0 || deleted;
-        deleted = objPtr->properties.erase("__get_" + propName) > 0 || deleted;
-        deleted = objPtr->properties.erase("__set_" + propName) > 0 || deleted;
-        if (deleted && objPtr->shape) {
-          objPtr->shape = nullptr; // Invalidate shape on delete
-        }
+        objPtr->properties.erase(propName);
+        objPtr->properties.erase("__get_" + propName);
+        objPtr->properties.erase("__set_" + propName);
         LIGHTJS_RETURN(Value(true));
       }
 
@@ -4578,8 +4798,8 @@ Task Interpreter::evaluateUnary(const UnaryExpr& expr) {
         }
         size_t idx = 0;
         if (parseArrayIndex(propName, idx)) {
-          if (idx < arrPtr->elements.size()) {
-            arrPtr->elements[idx] = Value(Undefined{});
+          if (idx < arrPtr->elementCount()) {
+            arrPtr->setElement(idx, Value(Undefined{}));
             // Mark this index as deleted so hasOwnProperty returns false
             arrPtr->properties["__deleted_" + propName + "__"] = Value(true);
           }
@@ -4761,25 +4981,14 @@ Task Interpreter::evaluateUnary(const UnaryExpr& expr) {
   // For typeof, handle undeclared identifiers specially (return "undefined" instead of throwing)
   if (expr.op == UnaryExpr::Op::Typeof) {
     if (auto* id = std::get_if<Identifier>(&expr.argument->node)) {
-      if (env_->isTDZ(id->name)) {
+      if (!id->tdzFree && env_->isTDZ(id->name)) {
         throwError(ErrorType::ReferenceError,
                    formatError("Cannot access '" + id->name + "' before initialization", expr.argument->loc));
         LIGHTJS_RETURN(Value(Undefined{}));
       }
-      if (!env_->has(id->name)) {
-        // Global object accessor/data properties are resolvable references even
-        // when no declarative binding exists.
-        bool isResolvableGlobal = false;
-        if (auto globalObj = env_->getRoot()->getGlobal()) {
-          isResolvableGlobal =
-            globalObj->properties.count(id->name) > 0 ||
-            globalObj->properties.count("__get_" + id->name) > 0 ||
-            globalObj->properties.count("__set_" + id->name) > 0;
-        }
-        if (!isResolvableGlobal) {
-          // Unresolvable reference: typeof returns "undefined"
-          LIGHTJS_RETURN(Value("undefined"));
-        }
+      if (isUnresolvableReference(id->name)) {
+        // Unresolvable reference: typeof returns "undefined"
+        LIGHTJS_RETURN(Value("undefined"));
       }
     }
   }
@@ -4789,88 +4998,316 @@ Task Interpreter::evaluateUnary(const UnaryExpr& expr) {
   Value arg;
   LIGHTJS_RUN_TASK(argTask, arg);
 
-  switch (expr.op) {
+  LIGHTJS_RETURN(unaryOperation(expr.op, arg));
+}
+
+bool Interpreter::isUnresolvableReference(const std::string& name) {
+  if (env_->has(name)) {
+    return false;
+  }
+  // Global object accessor/data properties are resolvable references even
+  // when no declarative binding exists.
+  if (auto globalObj = env_->getRoot()->getGlobal()) {
+    return globalObj->properties.count(name) == 0 &&
+           globalObj->properties.count("__get_" + name) == 0 &&
+           globalObj->properties.count("__set_" + name) == 0;
+  }
+  return true;
+}
+
+Value Interpreter::unaryOperation(UnaryExpr::Op op, const Value& arg) {
+  switch (op) {
     case UnaryExpr::Op::Not:
-      LIGHTJS_RETURN(Value(!arg.toBool()));
+      return Value(!arg.toBool());
     case UnaryExpr::Op::Minus: {
       Value prim = isObjectLike(arg) ? toPrimitiveValue(arg, false) : arg;
       if (hasError()) {
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
       if (prim.isBigInt()) {
-        LIGHTJS_RETURN(Value(BigInt(-prim.toBigInt())));
+        return Value(BigInt(-prim.toBigInt()));
       }
       if (prim.isSymbol()) {
         throwError(ErrorType::TypeError, "Cannot convert Symbol to number");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
+      }
+      if (prim.isInt32() && prim.asInt32() != 0 && prim.asInt32() != INT32_MIN) {
+        return Value(-prim.asInt32());
       }
-      LIGHTJS_RETURN(Value(-prim.toNumber()));
+      return Value(-prim.toNumber());
     }
     case UnaryExpr::Op::Plus: {
       Value prim = isObjectLike(arg) ? toPrimitiveValue(arg, false) : arg;
       if (hasError()) {
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
       if (prim.isBigInt()) {
         throwError(ErrorType::TypeError, "Cannot convert BigInt value to number");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
       if (prim.isSymbol()) {
         throwError(ErrorType::TypeError, "Cannot convert Symbol to number");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
-      LIGHTJS_RETURN(Value(prim.toNumber()));
+      return Value(prim.toNumber());
     }
     case UnaryExpr::Op::Typeof: {
-      if (arg.isUndefined()) LIGHTJS_RETURN(Value("undefined"));
-      if (arg.isNull()) LIGHTJS_RETURN(Value("object"));
-      if (arg.isBool()) LIGHTJS_RETURN(Value("boolean"));
-      if (arg.isNumber()) LIGHTJS_RETURN(Value("number"));
-      if (arg.isBigInt()) LIGHTJS_RETURN(Value("bigint"));
-      if (arg.isSymbol()) LIGHTJS_RETURN(Value("symbol"));
-      if (arg.isString()) LIGHTJS_RETURN(Value("string"));
-      if (arg.isFunction()) LIGHTJS_RETURN(Value("function"));
-      if (arg.isClass()) LIGHTJS_RETURN(Value("function"));
+      if (arg.isUndefined()) return Value("undefined");
+      if (arg.isNull()) return Value("object");
+      if (arg.isBool()) return Value("boolean");
+      if (arg.isNumber()) return Value("number");
+      if (arg.isBigInt()) return Value("bigint");
+      if (arg.isSymbol()) return Value("symbol");
+      if (arg.isString()) return Value("string");
+      if (arg.isFunction()) return Value("function");
+      if (arg.isClass()) return Value("function");
       if (arg.isProxy()) {
         auto proxy = arg.getGC<Proxy>();
         if (proxy && proxy->isCallable) {
-          LIGHTJS_RETURN(Value("function"));
+          return Value("function");
         }
-        LIGHTJS_RETURN(Value("object"));
+        return Value("object");
       }
       // Check for callable objects (e.g., String, Object constructors)
       if (arg.isObject()) {
         auto obj = arg.getGC<Object>();
         auto it = obj->properties.find("__callable_object__");
         if (it != obj->properties.end() && it->second.isBool() && it->second.toBool()) {
-          LIGHTJS_RETURN(Value("function"));
+          return Value("function");
         }
       }
-      LIGHTJS_RETURN(Value("object"));
+      return Value("object");
     }
     case UnaryExpr::Op::Void:
-      LIGHTJS_RETURN(Value(Undefined{}));
+      return Value(Undefined{});
     case UnaryExpr::Op::BitNot: {
       Value prim = isObjectLike(arg) ? toPrimitiveValue(arg, false) : arg;
       if (hasError()) {
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
       if (prim.isBigInt()) {
-        LIGHTJS_RETURN(Value(BigInt(~prim.toBigInt())));
+        return Value(BigInt(~prim.toBigInt()));
       }
       if (prim.isSymbol()) {
         throwError(ErrorType::TypeError, "Cannot convert Symbol to number");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
       int32_t number = toInt32(prim.toNumber());
-      LIGHTJS_RETURN(Value(static_cast<double>(~number)));
+      return Value(~number);
     }
     case UnaryExpr::Op::Delete:
       // Already handled above
       break;
   }
 
-  LIGHTJS_RETURN(Value(Undefined{}));
+  return Value(Undefined{});
+}
+
+bool Interpreter::computeCompoundAssignment(AssignmentExpr::Op op,
+                                            const Value& current,
+                                            const Value& rhsValue,
+                                            Value& result) {
+  if (current.isInt32() && rhsValue.isInt32()) {
+    if (auto binaryOp = compoundAssignmentBinaryOp(op);
+        binaryOp && int32BinaryOperation(*binaryOp, current.asInt32(), rhsValue.asInt32(), result)) {
+      return true;
+    }
+  }
+
+  auto toNumericOperand = [&](const Value& operand, Value& out) -> bool {
+    out = isObjectLike(operand) ? toPrimitiveValue(operand, false) : operand;
+    if (hasError()) return false;
+    if (out.isSymbol()) {
+      throwError(ErrorType::TypeError, "Cannot convert Symbol to number");
+      return false;
+    }
+    return true;
+  };
+
+  switch (op) {
+    case AssignmentExpr::Op::AddAssign: {
+      Value lhs = isObjectLike(current) ? toPrimitiveValue(current, false, true) : current;
+      Value rhs = isObjectLike(rhsValue) ? toPrimitiveValue(rhsValue, false, true) : rhsValue;
+      if (hasError()) return false;
+      if (lhs.isSymbol() || rhs.isSymbol()) {
+        throwError(ErrorType::TypeError, "Cannot convert Symbol to string");
+        return false;
+      }
+      if (lhs.isString() || rhs.isString()) {
+        result = Value(lhs.toString() + rhs.toString());
+      } else if (lhs.isBigInt() && rhs.isBigInt()) {
+        result = Value(BigInt(lhs.toBigInt() + rhs.toBigInt()));
+      } else if (lhs.isBigInt() != rhs.isBigInt()) {
+        throwError(ErrorType::TypeError, "Cannot mix BigInt and other types");
+        return false;
+      } else {
+        result = Value(lhs.toNumber() + rhs.toNumber());
+      }
+      return true;
+    }
+    case AssignmentExpr::Op::SubAssign:
+    case AssignmentExpr::Op::MulAssign:
+    case AssignmentExpr::Op::DivAssign:
+    case AssignmentExpr::Op::ModAssign:
+    case AssignmentExpr::Op::ExpAssign:
+    case AssignmentExpr::Op::BitwiseAndAssign:
+    case AssignmentExpr::Op::BitwiseOrAssign:
+    case AssignmentExpr::Op::BitwiseXorAssign:
+    case AssignmentExpr::Op::LeftShiftAssign:
+    case AssignmentExpr::Op::RightShiftAssign:
+    case AssignmentExpr::Op::UnsignedRightShiftAssign: {
+      Value lhs;
+      Value rhs;
+      if (!toNumericOperand(current, lhs) || !toNumericOperand(rhsValue, rhs)) {
+        return false;
+      }
+      switch (op) {
+        case AssignmentExpr::Op::SubAssign:
+          if (lhs.isBigInt() && rhs.isBigInt()) {
+            result = Value(BigInt(lhs.toBigInt() - rhs.toBigInt()));
+          } else if (lhs.isBigInt() != rhs.isBigInt()) {
+            throwError(ErrorType::TypeError, "Cannot mix BigInt and other types");
+            return false;
+          } else {
+            result = Value(lhs.toNumber() - rhs.toNumber());
+          }
+          return true;
+        case AssignmentExpr::Op::MulAssign:
+          if (lhs.isBigInt() && rhs.isBigInt()) {
+            result = Value(BigInt(lhs.toBigInt() * rhs.toBigInt()));
+          } else if (lhs.isBigInt() != rhs.isBigInt()) {
+            throwError(ErrorType::TypeError, "Cannot mix BigInt and other types");
+            return false;
+          } else {
+            result = Value(lhs.toNumber() * rhs.toNumber());
+          }
+          return true;
+        case AssignmentExpr::Op::DivAssign:
+          if (lhs.isBigInt() && rhs.isBigInt()) {
+            auto divisor = rhs.toBigInt();
+            if (divisor == 0) {
+              throwError(ErrorType::RangeError, "Division by zero");
+              return false;
+            }
+            result = Value(BigInt(lhs.toBigInt() / divisor));
+          } else if (lhs.isBigInt() != rhs.isBigInt()) {
+            throwError(ErrorType::TypeError, "Cannot mix BigInt and other types");
+            return false;
+          } else {
+            result = Value(lhs.toNumber() / rhs.toNumber());
+          }
+          return true;
+        case AssignmentExpr::Op::ModAssign:
+          if (lhs.isBigInt() && rhs.isBigInt()) {
+            auto divisor = rhs.toBigInt();
+            if (divisor == 0) {
+              throwError(ErrorType::RangeError, "Division by zero");
+              return false;
+            }
+            result = Value(BigInt(lhs.toBigInt() % divisor));
+          } else if (lhs.isBigInt() != rhs.isBigInt()) {
+            throwError(ErrorType::TypeError, "Cannot mix BigInt and other types");
+            return false;
+          } else {
+            result = Value(std::fmod(lhs.toNumber(), rhs.toNumber()));
+          }
+          return true;
+        case AssignmentExpr::Op::ExpAssign:
+          if (lhs.isBigInt() && rhs.isBigInt()) {
+            auto base = lhs.toBigInt();
+            auto exp = rhs.toBigInt();
+            if (exp < 0) {
+              throwError(ErrorType::RangeError, "BigInt negative exponent");
+              return false;
+            }
+            result = Value(BigInt(powBigInt(base, exp)));
+          } else if (lhs.isBigInt() != rhs.isBigInt()) {
+            throwError(ErrorType::TypeError, "Cannot mix BigInt and other types");
+            return false;
+          } else {
+            result = Value(std::pow(lhs.toNumber(), rhs.toNumber()));
+          }
+          return true;
+        case AssignmentExpr::Op::BitwiseAndAssign:
+          if (lhs.isBigInt() && rhs.isBigInt()) {
+            result = Value(BigInt(lhs.toBigInt() & rhs.toBigInt()));
+          } else if (lhs.isBigInt() != rhs.isBigInt()) {
+            throwError(ErrorType::TypeError, "Cannot mix BigInt and other types in bitwise operations");
+            return false;
+          } else {
+            result = Value(toInt32(lhs.toNumber()) & toInt32(rhs.toNumber()));
+          }
+          return true;
+        case AssignmentExpr::Op::BitwiseOrAssign:
+          if (lhs.isBigInt() && rhs.isBigInt()) {
+            result = Value(BigInt(lhs.toBigInt() | rhs.toBigInt()));
+          } else if (lhs.isBigInt() != rhs.isBigInt()) {
+            throwError(ErrorType::TypeError, "Cannot mix BigInt and other types in bitwise operations");
+            return false;
+          } else {
+            result = Value(toInt32(lhs.toNumber()) | toInt32(rhs.toNumber()));
+          }
+          return true;
+        case AssignmentExpr::Op::BitwiseXorAssign:
+          if (lhs.isBigInt() && rhs.isBigInt()) {
+            result = Value(BigInt(lhs.toBigInt() ^ rhs.toBigInt()));
+          } else if (lhs.isBigInt() != rhs.isBigInt()) {
+            throwError(ErrorType::TypeError, "Cannot mix BigInt and other types in bitwise operations");
+            return false;
+          } else {
+            result = Value(toInt32(lhs.toNumber()) ^ toInt32(rhs.toNumber()));
+          }
+          return true;
+        case AssignmentExpr::Op::LeftShiftAssign:
+          if (lhs.isBigInt() && rhs.isBigInt()) {
+            bool ok = false;
+            auto shifted = applyBigIntShiftLeft(lhs.toBigInt(), rhs.toBigInt(), &ok);
+            if (!ok) {
+              throwError(ErrorType::RangeError, "Invalid BigInt shift count");
+              return false;
+            }
+            result = Value(BigInt(shifted));
+          } else if (lhs.isBigInt() != rhs.isBigInt()) {
+            throwError(ErrorType::TypeError, "Cannot mix BigInt and other types in bitwise operations");
+            return false;
+          } else {
+            result = Value(toInt32(lhs.toNumber()) << (toInt32(rhs.toNumber()) & 0x1f));
+          }
+          return true;
+        case AssignmentExpr::Op::RightShiftAssign:
+          if (lhs.isBigInt() && rhs.isBigInt()) {
+            bool ok = false;
+            auto shifted = applyBigIntShiftRight(lhs.toBigInt(), rhs.toBigInt(), &ok);
+            if (!ok) {
+              throwError(ErrorType::RangeError, "Invalid BigInt shift count");
+              return false;
+            }
+            result = Value(BigInt(shifted));
+          } else if (lhs.isBigInt() != rhs.isBigInt()) {
+            throwError(ErrorType::TypeError, "Cannot mix BigInt and other types in bitwise operations");
+            return false;
+          } else {
+            result = Value(toInt32(lhs.toNumber()) >> (toInt32(rhs.toNumber()) & 0x1f));
+          }
+          return true;
+        case AssignmentExpr::Op::UnsignedRightShiftAssign:
+          if (lhs.isBigInt() || rhs.isBigInt()) {
+            throwError(ErrorType::TypeError, "Cannot use unsigned right shift on BigInt");
+            return false;
+          }
+          result = Value(static_cast<double>(static_cast<uint32_t>(toInt32(lhs.toNumber())) >> (toInt32(rhs.toNumber()) & 0x1f)));
+          return true;
+        default:
+          break;
+      }
+      break;
+    }
+    default:
+      break;
+  }
+
+  result = rhsValue;
+  return true;
 }
 
 Task Interpreter::evaluateAssignment(const AssignmentExpr& expr) {
@@ -5212,8 +5649,8 @@ Task Interpreter::evaluateAssignment(const AssignmentExpr& expr) {
         size_t idx = 0;
         bool isIdx = false;
         try { idx = std::stoull(propName); isIdx = true; } catch (...) {}
-        if (!propExists && isIdx && idx < arrPtr->elements.size()) {
-          current = arrPtr->elements[idx];
+        if (!propExists && isIdx && idx < arrPtr->elementCount()) {
+          current = arrPtr->element(idx);
           propExists = true;
         }
       }
@@ -5279,215 +5716,15 @@ Task Interpreter::evaluateAssignment(const AssignmentExpr& expr) {
         } else {
           size_t idx = 0;
           try { idx = std::stoull(propName); } catch (...) {}
-          if (idx < arrPtr->elements.size()) arrPtr->elements[idx] = right2;
+          if (idx < arrPtr->elementCount()) arrPtr->setElement(idx, right2);
         }
       }
       LIGHTJS_RETURN(right2);
     }
   }
 
-  auto computeCompoundValue = [&](AssignmentExpr::Op op,
-                                  const Value& current,
-                                  const Value& rhsValue,
-                                  Value& result) -> bool {
-    auto toNumericOperand = [&](const Value& operand, Value& out) -> bool {
-      out = isObjectLike(operand) ? toPrimitiveValue(operand, false) : operand;
-      if (hasError()) return false;
-      if (out.isSymbol()) {
-        throwError(ErrorType::TypeError, "Cannot convert Symbol to number");
-        return false;
-      }
-      return true;
-    };
-
-    switch (op) {
-      case AssignmentExpr::Op::AddAssign: {
-        Value lhs = isObjectLike(current) ? toPrimitiveValue(current, false, true) : current;
-        Value rhs = isObjectLike(rhsValue) ? toPrimitiveValue(rhsValue, false, true) : rhsValue;
-        if (hasError()) return false;
-        if (lhs.isSymbol() || rhs.isSymbol()) {
-          throwError(ErrorType::TypeError, "Cannot convert Symbol to string");
-          return false;
-        }
-        if (lhs.isString() || rhs.isString()) {
-          result = Value(lhs.toString() + rhs.toString());
-        } else if (lhs.isBigInt() && rhs.isBigInt()) {
-          result = Value(BigInt(lhs.toBigInt() + rhs.toBigInt()));
-        } else if (lhs.isBigInt() != rhs.isBigInt()) {
-          throwError(ErrorType::TypeError, "Cannot mix BigInt and other types");
-          return false;
-        } else {
-          result = Value(lhs.toNumber() + rhs.toNumber());
-        }
-        return true;
-      }
-      case AssignmentExpr::Op::SubAssign:
-      case AssignmentExpr::Op::MulAssign:
-      case AssignmentExpr::Op::DivAssign:
-      case AssignmentExpr::Op::ModAssign:
-      case AssignmentExpr::Op::ExpAssign:
-      case AssignmentExpr::Op::BitwiseAndAssign:
-      case AssignmentExpr::Op::BitwiseOrAssign:
-      case AssignmentExpr::Op::BitwiseXorAssign:
-      case AssignmentExpr::Op::LeftShiftAssign:
-      case AssignmentExpr::Op::RightShiftAssign:
-      case AssignmentExpr::Op::UnsignedRightShiftAssign: {
-        Value lhs;
-        Value rhs;
-        if (!toNumericOperand(current, lhs) || !toNumericOperand(rhsValue, rhs)) {
-          return false;
-        }
-        switch (op) {
-          case AssignmentExpr::Op::SubAssign:
-            if (lhs.isBigInt() && rhs.isBigInt()) {
-              result = Value(BigInt(lhs.toBigInt() - rhs.toBigInt()));
-            } else if (lhs.isBigInt() != rhs.isBigInt()) {
-              throwError(ErrorType::TypeError, "Cannot mix BigInt and other types");
-              return false;
-            } else {
-              result = Value(lhs.toNumber() - rhs.toNumber());
-            }
-            return true;
-          case AssignmentExpr::Op::MulAssign:
-            if (lhs.isBigInt() && rhs.isBigInt()) {
-              result = Value(BigInt(lhs.toBigInt() * rhs.toBigInt()));
-            } else if (lhs.isBigInt() != rhs.isBigInt()) {
-              throwError(ErrorType::TypeError, "Cannot mix BigInt and other types");
-              return false;
-            } else {
-              result = Value(lhs.toNumber() * rhs.toNumber());
-            }
-            return true;
-          case AssignmentExpr::Op::DivAssign:
-            if (lhs.isBigInt() && rhs.isBigInt()) {
-              auto divisor = rhs.toBigInt();
-              if (divisor == 0) {
-                throwError(ErrorType::RangeError, "Division by zero");
-                return false;
-              }
-              result = Value(BigInt(lhs.toBigInt() / divisor));
-            } else if (lhs.isBigInt() != rhs.isBigInt()) {
-              throwError(ErrorType::TypeError, "Cannot mix BigInt and other types");
-              return false;
-            } else {
-              result = Value(lhs.toNumber() / rhs.toNumber());
-            }
-            return true;
-          case AssignmentExpr::Op::ModAssign:
-            if (lhs.isBigInt() && rhs.isBigInt()) {
-              auto divisor = rhs.toBigInt();
-              if (divisor == 0) {
-                throwError(ErrorType::RangeError, "Division by zero");
-                return false;
-              }
-              result = Value(BigInt(lhs.toBigInt() % divisor));
-            } else if (lhs.isBigInt() != rhs.isBigInt()) {
-              throwError(ErrorType::TypeError, "Cannot mix BigInt and other types");
-              return false;
-            } else {
-              result = Value(std::fmod(lhs.toNumber(), rhs.toNumber()));
-            }
-            return true;
-          case AssignmentExpr::Op::ExpAssign:
-            if (lhs.isBigInt() && rhs.isBigInt()) {
-              auto base = lhs.toBigInt();
-              auto exp = rhs.toBigInt();
-              if (exp < 0) {
-                throwError(ErrorType::RangeError, "BigInt negative exponent");
-                return false;
-              }
-              result = Value(BigInt(powBigInt(base, exp)));
-            } else if (lhs.isBigInt() != rhs.isBigInt()) {
-              throwError(ErrorType::TypeError, "Cannot mix BigInt and other types");
-              return false;
-            } else {
-              result = Value(std::pow(lhs.toNumber(), rhs.toNumber()));
-            }
-            return true;
-          case AssignmentExpr::Op::BitwiseAndAssign:
-            if (lhs.isBigInt() && rhs.isBigInt()) {
-              result = Value(BigInt(lhs.toBigInt() & rhs.toBigInt()));
-            } else if (lhs.isBigInt() != rhs.isBigInt()) {
-              throwError(ErrorType::TypeError, "Cannot mix BigInt and other types in bitwise operations");
-              return false;
-            } else {
-              result = Value(static_cast<double>(toInt32(lhs.toNumber()) & toInt32(rhs.toNumber())));
-            }
-            return true;
-          case AssignmentExpr::Op::BitwiseOrAssign:
-            if (lhs.isBigInt() && rhs.isBigInt()) {
-              result = Value(BigInt(lhs.toBigInt() | rhs.toBigInt()));
-            } else if (lhs.isBigInt() != rhs.isBigInt()) {
-              throwError(ErrorType::TypeError, "Cannot mix BigInt and other types in bitwise operations");
-              return false;
-            } else {
-              result = Value(static_cast<double>(toInt32(lhs.toNumber()) | toInt32(rhs.toNumber())));
-            }
-            return true;
-          case AssignmentExpr::Op::BitwiseXorAssign:
-            if (lhs.isBigInt() && rhs.isBigInt()) {
-              result = Value(BigInt(lhs.toBigInt() ^ rhs.toBigInt()));
-            } else if (lhs.isBigInt() != rhs.isBigInt()) {
-              throwError(ErrorType::TypeError, "Cannot mix BigInt and other types in bitwise operations");
-              return false;
-            } else {
-              result = Value(static_cast<double>(toInt32(lhs.toNumber()) ^ toInt32(rhs.toNumber())));
-            }
-            return true;
-          case AssignmentExpr::Op::LeftShiftAssign:
-            if (lhs.isBigInt() && rhs.isBigInt()) {
-              bool ok = false;
-              auto shifted = applyBigIntShiftLeft(lhs.toBigInt(), rhs.toBigInt(), &ok);
-              if (!ok) {
-                throwError(ErrorType::RangeError, "Invalid BigInt shift count");
-                return false;
-              }
-              result = Value(BigInt(shifted));
-            } else if (lhs.isBigInt() != rhs.isBigInt()) {
-              throwError(ErrorType::TypeError, "Cannot mix BigInt and other types in bitwise operations");
-              return false;
-            } else {
-              result = Value(static_cast<double>(toInt32(lhs.toNumber()) << (toInt32(rhs.toNumber()) & 0x1f)));
-            }
-            return true;
-          case AssignmentExpr::Op::RightShiftAssign:
-            if (lhs.isBigInt() && rhs.isBigInt()) {
-              bool ok = false;
-              auto shifted = applyBigIntShiftRight(lhs.toBigInt(), rhs.toBigInt(), &ok);
-              if (!ok) {
-                throwError(ErrorType::RangeError, "Invalid BigInt shift count");
-                return false;
-              }
-              result = Value(BigInt(shifted));
-            } else if (lhs.isBigInt() != rhs.isBigInt()) {
-              throwError(ErrorType::TypeError, "Cannot mix BigInt and other types in bitwise operations");
-              return false;
-            } else {
-              result = Value(static_cast<double>(toInt32(lhs.toNumber()) >> (toInt32(rhs.toNumber()) & 0x1f)));
-            }
-            return true;
-          case AssignmentExpr::Op::UnsignedRightShiftAssign:
-            if (lhs.isBigInt() || rhs.isBigInt()) {
-              throwError(ErrorType::TypeError, "Cannot use unsigned right shift on BigInt");
-              return false;
-            }
-            result = Value(static_cast<double>(static_cast<uint32_t>(toInt32(lhs.toNumber())) >> (toInt32(rhs.toNumber()) & 0x1f)));
-            return true;
-          default:
-            break;
-        }
-        break;
-      }
-      default:
-        break;
-    }
-
-    result = rhsValue;
-    return true;
-  };
-
   if (auto* id = std::get_if<Identifier>(&expr.left->node)) {
-    if (env_->isTDZ(id->name)) {
+    if (!id->tdzFree && env_->isTDZ(id->name)) {
       throwError(ErrorType::ReferenceError,
                  "Cannot access '" + id->name + "' before initialization");
       LIGHTJS_RETURN(Value(Undefined{}));
@@ -5663,7 +5900,7 @@ Task Interpreter::evaluateAssignment(const AssignmentExpr& expr) {
     if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
 
     Value result;
-    if (!computeCompoundValue(expr.op, current, right, result)) {
+    if (!computeCompoundAssignment(expr.op, current, right, result)) {
       LIGHTJS_RETURN(Value(Undefined{}));
     }
     if (!putIdentifierValue(result, false)) {
@@ -5717,12 +5954,24 @@ Task Interpreter::evaluateAssignment(const AssignmentExpr& expr) {
           LIGHTJS_RETURN(Value(Undefined{}));
         }
       }
-      if (keyValue.isNumber()) {
-        double numericKey = keyValue.toNumber();
-        if (std::isfinite(numericKey) && numericKey >= 0.0 && numericKey <= 4294967294.0) {
-          double integerKey = std::trunc(numericKey);
-          if (integerKey == numericKey) {
-            typedArrayNumericIndex = static_cast<size_t>(integerKey);
+      typedArrayNumericIndex = arrayIndexKey(keyValue);
+      if (typedArrayNumericIndex && !isSuperTarget) {
+        if (expr.op == AssignmentExpr::Op::Assign) {
+          if (setIndexedElement(obj, *typedArrayNumericIndex, right)) {
+            LIGHTJS_RETURN(right);
+          }
+        } else if (expr.op != AssignmentExpr::Op::AndAssign &&
+                   expr.op != AssignmentExpr::Op::OrAssign &&
+                   expr.op != AssignmentExpr::Op::NullishAssign &&
+                   obj.isArray() && right.isNumber()) {
+          // Numeric operands make the computation side-effect free, so the
+          // element cannot change shape between the read and the write.
+          Value current;
+          Value result;
+          if (getIndexedElement(obj, *typedArrayNumericIndex, current) && current.isNumber() &&
+              computeCompoundAssignment(expr.op, current, right, result) &&
+              setIndexedElement(obj, *typedArrayNumericIndex, result)) {
+            LIGHTJS_RETURN(result);
           }
         }
       }
@@ -5733,205 +5982,119 @@ Task Interpreter::evaluateAssignment(const AssignmentExpr& expr) {
       }
     }
 
-    // PutValue on a property reference coerces the base with ToObject,
-    // which throws on null/undefined. (RHS has already been evaluated above.)
-    if (obj.isNull() || obj.isUndefined()) {
-      throwError(ErrorType::TypeError,
-                 "Cannot set properties of " + std::string(obj.isNull() ? "null" : "undefined"));
-      LIGHTJS_RETURN(Value(Undefined{}));
-    }
+    LIGHTJS_RETURN(assignMemberValue(expr.op, obj, propName, typedArrayNumericIndex, right,
+                                     member->privateIdentifier, isSuperTarget, superReceiver));
+  }
 
-    if (!member->privateIdentifier && expr.op == AssignmentExpr::Op::Assign &&
-        typedArrayNumericIndex.has_value() && obj.isTypedArray()) {
-      auto taPtr = obj.getGC<TypedArray>();
-      size_t index = *typedArrayNumericIndex;
-      if (taPtr->type == TypedArrayType::BigInt64 || taPtr->type == TypedArrayType::BigUint64) {
-        if (taPtr->type == TypedArrayType::BigUint64) {
-          taPtr->setBigUintElement(index, bigint::toUint64Trunc(right.toBigInt()));
-        } else {
-          taPtr->setBigIntElement(index, bigint::toInt64Trunc(right.toBigInt()));
-        }
+  LIGHTJS_RETURN(right);
+}
+
+Value Interpreter::assignMemberValue(AssignmentExpr::Op op,
+                                     Value obj,
+                                     const std::string& propName,
+                                     std::optional<size_t> typedArrayNumericIndex,
+                                     const Value& right,
+                                     bool privateIdentifier,
+                                     bool isSuperTarget,
+                                     const Value& superReceiver) {
+  // PutValue on a property reference coerces the base with ToObject,
+  // which throws on null/undefined. (RHS has already been evaluated above.)
+  if (obj.isNull() || obj.isUndefined()) {
+    throwError(ErrorType::TypeError,
+               "Cannot set properties of " + std::string(obj.isNull() ? "null" : "undefined"));
+    return Value(Undefined{});
+  }
+
+  if (!privateIdentifier && op == AssignmentExpr::Op::Assign &&
+      typedArrayNumericIndex.has_value() && obj.isTypedArray()) {
+    auto taPtr = obj.getGC<TypedArray>();
+    size_t index = *typedArrayNumericIndex;
+    if (taPtr->type == TypedArrayType::BigInt64 || taPtr->type == TypedArrayType::BigUint64) {
+      if (taPtr->type == TypedArrayType::BigUint64) {
+        taPtr->setBigUintElement(index, bigint::toUint64Trunc(right.toBigInt()));
       } else {
-        taPtr->setElement(index, right.toNumber());
+        taPtr->setBigIntElement(index, bigint::toInt64Trunc(right.toBigInt()));
       }
-      LIGHTJS_RETURN(right);
+    } else {
+      taPtr->setElement(index, right.toNumber());
     }
+    return right;
+  }
 
-    if (member->privateIdentifier) {
-      if (!activePrivateOwnerClass_) {
-        throwError(ErrorType::TypeError,
-                   "Cannot read private member " + propName +
-                       " from an object whose class did not declare it");
-        LIGHTJS_RETURN(Value(Undefined{}));
-      }
-
-      Value privateReceiver = obj;
-      int proxyDepth = 0;
-      while (obj.isProxy() && proxyDepth < 16) {
-        auto proxyPtr = obj.getGC<Proxy>();
-        if (!proxyPtr->target) {
-          throwError(ErrorType::TypeError,
-                     "Cannot read private member " + propName +
-                         " from an object whose class did not declare it");
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
-        obj = *proxyPtr->target;
-        proxyDepth++;
-      }
-      if (obj.isProxy()) {
-        throwError(ErrorType::TypeError,
-                   "Cannot read private member " + propName +
-                       " from an object whose class did not declare it");
-        LIGHTJS_RETURN(Value(Undefined{}));
-      }
+  if (privateIdentifier) {
+    if (!activePrivateOwnerClass_) {
+      throwError(ErrorType::TypeError,
+                 "Cannot read private member " + propName +
+                     " from an object whose class did not declare it");
+      return Value(Undefined{});
+    }
 
-      PrivateNameOwner resolved = resolvePrivateNameOwnerClass(activePrivateOwnerClass_, propName);
-      if (!resolved.owner || resolved.kind == PrivateNameKind::None) {
+    Value privateReceiver = obj;
+    int proxyDepth = 0;
+    while (obj.isProxy() && proxyDepth < 16) {
+      auto proxyPtr = obj.getGC<Proxy>();
+      if (!proxyPtr->target) {
         throwError(ErrorType::TypeError,
                    "Cannot read private member " + propName +
                        " from an object whose class did not declare it");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
+      obj = *proxyPtr->target;
+      proxyDepth++;
+    }
+    if (obj.isProxy()) {
+      throwError(ErrorType::TypeError,
+                 "Cannot read private member " + propName +
+                     " from an object whose class did not declare it");
+      return Value(Undefined{});
+    }
 
-      Value current(Undefined{});
-      bool isMethod = false;
-      bool hasPrivateGetter = false;
-      bool hasPrivateSetter = false;
-      bool hasFieldValue = false;
-      std::string mangledName = privateStorageKey(resolved.owner, propName);
-
-      if (resolved.kind == PrivateNameKind::Static) {
-        if (!obj.isClass() || obj.getGC<Class>().get() != resolved.owner.get()) {
-          throwError(ErrorType::TypeError,
-                     "Cannot read private member " + propName +
-                         " from an object whose class did not declare it");
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
-        auto clsPtr = obj.getGC<Class>();
-        auto getterIt = clsPtr->properties.find("__get_" + mangledName);
-        if (getterIt != clsPtr->properties.end() && getterIt->second.isFunction()) {
-          hasPrivateGetter = true;
-        }
-        auto setterIt = clsPtr->properties.find("__set_" + mangledName);
-        if (setterIt != clsPtr->properties.end() && setterIt->second.isFunction()) {
-          hasPrivateSetter = true;
-        }
-        auto methodIt = clsPtr->staticMethods.find(mangledName);
-        if (methodIt != clsPtr->staticMethods.end()) {
-          isMethod = true;
-          current = Value(methodIt->second);
-        }
-        auto valueIt = clsPtr->properties.find(mangledName);
-        if (valueIt != clsPtr->properties.end()) {
-          hasFieldValue = true;
-          current = valueIt->second;
-        }
-
-        if (expr.op != AssignmentExpr::Op::Assign) {
-          if (hasPrivateGetter) {
-            current = callFunction(getterIt->second, {}, privateReceiver);
-            if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-          } else if (isMethod) {
-            // method already assigned to current
-          } else if (hasFieldValue) {
-            // field value already assigned to current
-          } else {
-            throwError(ErrorType::TypeError,
-                       "Cannot read private member " + propName +
-                           " from an object whose class did not declare it");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-        }
-
-        if (isMethod) {
-          throwError(ErrorType::TypeError, "Cannot assign to private method " + propName);
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
-
-        if (expr.op == AssignmentExpr::Op::Assign) {
-          if (hasPrivateGetter && !hasPrivateSetter) {
-            throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          if (hasPrivateSetter) {
-            callFunction(setterIt->second, {right}, privateReceiver);
-            if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-          } else {
-            if (!hasFieldValue) {
-              throwError(ErrorType::TypeError,
-                         "Cannot write private member " + propName +
-                             " to an object whose class did not declare it");
-              LIGHTJS_RETURN(Value(Undefined{}));
-            }
-            clsPtr->properties[mangledName] = right;
-          }
-          LIGHTJS_RETURN(right);
-        }
+    PrivateNameOwner resolved = resolvePrivateNameOwnerClass(activePrivateOwnerClass_, propName);
+    if (!resolved.owner || resolved.kind == PrivateNameKind::None) {
+      throwError(ErrorType::TypeError,
+                 "Cannot read private member " + propName +
+                     " from an object whose class did not declare it");
+      return Value(Undefined{});
+    }
 
-        Value result;
-        if (!computeCompoundValue(expr.op, current, right, result)) {
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
-        if (hasPrivateGetter && !hasPrivateSetter) {
-          throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
-        if (hasPrivateSetter) {
-          callFunction(setterIt->second, {result}, privateReceiver);
-          if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-        } else {
-          if (!hasFieldValue) {
-            throwError(ErrorType::TypeError,
-                       "Cannot write private member " + propName +
-                           " to an object whose class did not declare it");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          clsPtr->properties[mangledName] = result;
-        }
-        LIGHTJS_RETURN(result);
-      }
+    Value current(Undefined{});
+    bool isMethod = false;
+    bool hasPrivateGetter = false;
+    bool hasPrivateSetter = false;
+    bool hasFieldValue = false;
+    std::string mangledName = privateStorageKey(resolved.owner, propName);
 
-      if (!isObjectLike(obj)) {
-        throwError(ErrorType::TypeError,
-                   "Cannot read private member " + propName +
-                       " from an object whose class did not declare it");
-        LIGHTJS_RETURN(Value(Undefined{}));
-      }
-      GCPtr<Class> targetClass = getConstructorClassForPrivateAccess(obj);
-      if (!targetClass || !isOwnerInClassChain(targetClass, resolved.owner)) {
+    if (resolved.kind == PrivateNameKind::Static) {
+      if (!obj.isClass() || obj.getGC<Class>().get() != resolved.owner.get()) {
         throwError(ErrorType::TypeError,
                    "Cannot read private member " + propName +
                        " from an object whose class did not declare it");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
-
-      auto getterIt = resolved.owner->getters.find(propName);
-      if (getterIt != resolved.owner->getters.end()) {
+      auto clsPtr = obj.getGC<Class>();
+      auto getterIt = clsPtr->properties.find("__get_" + mangledName);
+      if (getterIt != clsPtr->properties.end() && getterIt->second.isFunction()) {
         hasPrivateGetter = true;
       }
-      auto setterIt = resolved.owner->setters.find(propName);
-      if (setterIt != resolved.owner->setters.end()) {
+      auto setterIt = clsPtr->properties.find("__set_" + mangledName);
+      if (setterIt != clsPtr->properties.end() && setterIt->second.isFunction()) {
         hasPrivateSetter = true;
       }
-      auto methodIt = resolved.owner->methods.find(propName);
-      if (methodIt != resolved.owner->methods.end()) {
+      auto methodIt = clsPtr->staticMethods.find(mangledName);
+      if (methodIt != clsPtr->staticMethods.end()) {
         isMethod = true;
         current = Value(methodIt->second);
       }
-
-      auto* storage = getPropertyStorageForPrivateAccess(obj);
-      if (storage) {
-        auto valueIt = storage->find(mangledName);
-        if (valueIt != storage->end()) {
-          hasFieldValue = true;
-          current = valueIt->second;
-        }
+      auto valueIt = clsPtr->properties.find(mangledName);
+      if (valueIt != clsPtr->properties.end()) {
+        hasFieldValue = true;
+        current = valueIt->second;
       }
 
-      if (expr.op != AssignmentExpr::Op::Assign) {
+      if (op != AssignmentExpr::Op::Assign) {
         if (hasPrivateGetter) {
-          current = invokeFunction(getterIt->second, {}, privateReceiver);
-          if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
+          current = callFunction(getterIt->second, {}, privateReceiver);
+          if (hasError()) return Value(Undefined{});
         } else if (isMethod) {
           // method already assigned to current
         } else if (hasFieldValue) {
@@ -5940,1399 +6103,1491 @@ Task Interpreter::evaluateAssignment(const AssignmentExpr& expr) {
           throwError(ErrorType::TypeError,
                      "Cannot read private member " + propName +
                          " from an object whose class did not declare it");
-          LIGHTJS_RETURN(Value(Undefined{}));
+          return Value(Undefined{});
         }
       }
 
       if (isMethod) {
         throwError(ErrorType::TypeError, "Cannot assign to private method " + propName);
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
 
-      if (expr.op == AssignmentExpr::Op::Assign) {
+      if (op == AssignmentExpr::Op::Assign) {
         if (hasPrivateGetter && !hasPrivateSetter) {
           throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
-          LIGHTJS_RETURN(Value(Undefined{}));
+          return Value(Undefined{});
         }
         if (hasPrivateSetter) {
-          invokeFunction(setterIt->second, {right}, privateReceiver);
-          if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
+          callFunction(setterIt->second, {right}, privateReceiver);
+          if (hasError()) return Value(Undefined{});
         } else {
-          if (!storage || !hasFieldValue) {
+          if (!hasFieldValue) {
             throwError(ErrorType::TypeError,
                        "Cannot write private member " + propName +
                            " to an object whose class did not declare it");
-            LIGHTJS_RETURN(Value(Undefined{}));
+            return Value(Undefined{});
           }
-          (*storage)[mangledName] = right;
+          clsPtr->properties[mangledName] = right;
         }
-        LIGHTJS_RETURN(right);
+        return right;
       }
 
       Value result;
-      if (!computeCompoundValue(expr.op, current, right, result)) {
-        LIGHTJS_RETURN(Value(Undefined{}));
+      if (!computeCompoundAssignment(op, current, right, result)) {
+        return Value(Undefined{});
       }
       if (hasPrivateGetter && !hasPrivateSetter) {
         throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
       if (hasPrivateSetter) {
-        invokeFunction(setterIt->second, {result}, privateReceiver);
-        if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
+        callFunction(setterIt->second, {result}, privateReceiver);
+        if (hasError()) return Value(Undefined{});
       } else {
-        if (!storage || !hasFieldValue) {
+        if (!hasFieldValue) {
           throwError(ErrorType::TypeError,
                      "Cannot write private member " + propName +
                          " to an object whose class did not declare it");
-          LIGHTJS_RETURN(Value(Undefined{}));
+          return Value(Undefined{});
         }
-        (*storage)[mangledName] = result;
+        clsPtr->properties[mangledName] = result;
       }
-      LIGHTJS_RETURN(result);
+      return result;
     }
 
-    bool usedPrimitiveWrapper = false;
-    Value primitiveBaseValue = obj;
+    if (!isObjectLike(obj)) {
+      throwError(ErrorType::TypeError,
+                 "Cannot read private member " + propName +
+                     " from an object whose class did not declare it");
+      return Value(Undefined{});
+    }
+    GCPtr<Class> targetClass = getConstructorClassForPrivateAccess(obj);
+    if (!targetClass || !isOwnerInClassChain(targetClass, resolved.owner)) {
+      throwError(ErrorType::TypeError,
+                 "Cannot read private member " + propName +
+                     " from an object whose class did not declare it");
+      return Value(Undefined{});
+    }
 
-    // PutValue on a primitive base: ToObject(base) then [[Set]].
-    if (obj.isNumber() || obj.isString() || obj.isBool() || obj.isSymbol() || obj.isBigInt()) {
-      const char* ctorName = nullptr;
-      if (obj.isNumber()) ctorName = "Number";
-      else if (obj.isString()) ctorName = "String";
-      else if (obj.isBool()) ctorName = "Boolean";
-      else if (obj.isSymbol()) ctorName = "Symbol";
-      else if (obj.isBigInt()) ctorName = "BigInt";
+    auto getterIt = resolved.owner->getters.find(propName);
+    if (getterIt != resolved.owner->getters.end()) {
+      hasPrivateGetter = true;
+    }
+    auto setterIt = resolved.owner->setters.find(propName);
+    if (setterIt != resolved.owner->setters.end()) {
+      hasPrivateSetter = true;
+    }
+    auto methodIt = resolved.owner->methods.find(propName);
+    if (methodIt != resolved.owner->methods.end()) {
+      isMethod = true;
+      current = Value(methodIt->second);
+    }
 
-      auto wrapper = GarbageCollector::makeGC<Object>();
-      GarbageCollector::instance().reportAllocation(sizeof(Object));
-      wrapper->properties["__primitive_value__"] = obj;
-      if (ctorName) {
-        if (auto ctor = env_->get(ctorName)) {
-          auto [foundProto, proto] = getPropertyForPrimitive(*ctor, "prototype");
-          if (foundProto && (proto.isObject() || proto.isNull())) {
-            wrapper->properties["__proto__"] = proto;
-          }
-        }
+    auto* storage = getPropertyStorageForPrivateAccess(obj);
+    if (storage) {
+      auto valueIt = storage->find(mangledName);
+      if (valueIt != storage->end()) {
+        hasFieldValue = true;
+        current = valueIt->second;
       }
-      obj = Value(wrapper);
-      usedPrimitiveWrapper = true;
     }
 
-    // Spec-ish [[Set]] behavior for plain assignment:
-    // if no own property, delegate to prototype's [[Set]] (important for Proxy
-    // prototypes used by Test262 PutValue tests).
-    if (expr.op == AssignmentExpr::Op::Assign && usedPrimitiveWrapper) {
-      Value receiver = usedPrimitiveWrapper ? primitiveBaseValue : obj;
-      if (isSuperTarget && superReceiver.isObject()) {
-        receiver = superReceiver;
+    if (op != AssignmentExpr::Op::Assign) {
+      if (hasPrivateGetter) {
+        current = invokeFunction(getterIt->second, {}, privateReceiver);
+        if (hasError()) return Value(Undefined{});
+      } else if (isMethod) {
+        // method already assigned to current
+      } else if (hasFieldValue) {
+        // field value already assigned to current
+      } else {
+        throwError(ErrorType::TypeError,
+                   "Cannot read private member " + propName +
+                       " from an object whose class did not declare it");
+        return Value(Undefined{});
       }
-      if (isSuperTarget &&
-          receiver.isObject() &&
-          receiver.getGC<Object>()->isModuleNamespace) {
-        if (strictMode_) {
-          throwError(ErrorType::TypeError, "Cannot assign to property '" + propName + "' of module namespace object");
-          LIGHTJS_RETURN(Value(Undefined{}));
+    }
+
+    if (isMethod) {
+      throwError(ErrorType::TypeError, "Cannot assign to private method " + propName);
+      return Value(Undefined{});
+    }
+
+    if (op == AssignmentExpr::Op::Assign) {
+      if (hasPrivateGetter && !hasPrivateSetter) {
+        throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
+        return Value(Undefined{});
+      }
+      if (hasPrivateSetter) {
+        invokeFunction(setterIt->second, {right}, privateReceiver);
+        if (hasError()) return Value(Undefined{});
+      } else {
+        if (!storage || !hasFieldValue) {
+          throwError(ErrorType::TypeError,
+                     "Cannot write private member " + propName +
+                         " to an object whose class did not declare it");
+          return Value(Undefined{});
         }
-        LIGHTJS_RETURN(right);
+        (*storage)[mangledName] = right;
       }
+      return right;
+    }
 
-      auto ordinarySet = [&](auto&& self,
-                             const Value& base,
-                             const Value& recv,
-                             const std::string& key,
-                             const Value& v) -> bool {
-        if (base.isProxy()) {
-          auto proxyPtr = base.getGC<Proxy>();
-          if (proxyPtr->handler && proxyPtr->handler->isObject()) {
-            auto handlerObj = std::get<GCPtr<Object>>(proxyPtr->handler->data);
-            auto trapIt = handlerObj->properties.find("set");
-            if (trapIt != handlerObj->properties.end() && trapIt->second.isFunction()) {
-              auto trap = trapIt->second.getGC<Function>();
-              std::vector<Value> trapArgs = {
-                proxyPtr->target ? *proxyPtr->target : Value(Undefined{}),
-                toPropertyKeyValue(key),
-                v,
-                recv
-              };
-              Value result = trap->isNative ? trap->nativeFunc(trapArgs)
-                                            : invokeFunction(trap, trapArgs, Value(Undefined{}));
-              if (hasError()) return false;
-              return result.toBool();
-            }
-          }
-          // No trap: write through to target if possible.
-          if (proxyPtr->target && proxyPtr->target->isObject() && recv.isObject()) {
-            recv.getGC<Object>()->properties[key] = v;
-            return true;
-          }
-          return false;
-        }
+    Value result;
+    if (!computeCompoundAssignment(op, current, right, result)) {
+      return Value(Undefined{});
+    }
+    if (hasPrivateGetter && !hasPrivateSetter) {
+      throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
+      return Value(Undefined{});
+    }
+    if (hasPrivateSetter) {
+      invokeFunction(setterIt->second, {result}, privateReceiver);
+      if (hasError()) return Value(Undefined{});
+    } else {
+      if (!storage || !hasFieldValue) {
+        throwError(ErrorType::TypeError,
+                   "Cannot write private member " + propName +
+                       " to an object whose class did not declare it");
+        return Value(Undefined{});
+      }
+      (*storage)[mangledName] = result;
+    }
+    return result;
+  }
 
-        if (base.isObject()) {
-          auto baseObj = base.getGC<Object>();
-          if (baseObj->isModuleNamespace) {
-            return false;
-          }
-          std::string getterName = "__get_" + key;
-          std::string setterName = "__set_" + key;
-          auto setterIt = baseObj->properties.find(setterName);
-          if (setterIt != baseObj->properties.end() && setterIt->second.isFunction()) {
-            invokeFunction(setterIt->second.getGC<Function>(), {v}, recv);
-            return !hasError();
-          }
-          auto getterIt = baseObj->properties.find(getterName);
-          if (getterIt != baseObj->properties.end() && getterIt->second.isFunction() &&
-              setterIt == baseObj->properties.end()) {
-            // Getter-only property.
-            return false;
-          }
+  bool usedPrimitiveWrapper = false;
+  Value primitiveBaseValue = obj;
 
-          // If property exists somewhere on the prototype chain, ordinary [[Set]]
-          // still routes through the chain. We approximate by delegating first.
-          auto itOwn = baseObj->properties.find(key);
-          if (itOwn == baseObj->properties.end()) {
-            auto protoIt = baseObj->properties.find("__proto__");
-            if (protoIt != baseObj->properties.end() && !protoIt->second.isNull() && !protoIt->second.isUndefined()) {
-              return self(self, protoIt->second, recv, key, v);
-            }
-          }
+  // PutValue on a primitive base: ToObject(base) then [[Set]].
+  if (obj.isNumber() || obj.isString() || obj.isBool() || obj.isSymbol() || obj.isBigInt()) {
+    const char* ctorName = nullptr;
+    if (obj.isNumber()) ctorName = "Number";
+    else if (obj.isString()) ctorName = "String";
+    else if (obj.isBool()) ctorName = "Boolean";
+    else if (obj.isSymbol()) ctorName = "Symbol";
+    else if (obj.isBigInt()) ctorName = "BigInt";
+
+    auto wrapper = GarbageCollector::makeGC<Object>();
+    GarbageCollector::instance().reportAllocation(sizeof(Object));
+    wrapper->properties["__primitive_value__"] = obj;
+    if (ctorName) {
+      if (auto ctor = env_->get(ctorName)) {
+        auto [foundProto, proto] = getPropertyForPrimitive(*ctor, "prototype");
+        if (foundProto && (proto.isObject() || proto.isNull())) {
+          wrapper->properties["__proto__"] = proto;
+        }
+      }
+    }
+    obj = Value(wrapper);
+    usedPrimitiveWrapper = true;
+  }
 
-          if (!recv.isObject()) return false;
-          auto recvObj = recv.getGC<Object>();
-          if (recvObj->isModuleNamespace) return false;
-          if (recvObj->frozen) return false;
-          if (recvObj->properties.count("__non_writable_" + key)) return false;
-          bool isNew = recvObj->properties.find(key) == recvObj->properties.end();
-          if ((recvObj->sealed || recvObj->nonExtensible) && isNew) return false;
+  // Spec-ish [[Set]] behavior for plain assignment:
+  // if no own property, delegate to prototype's [[Set]] (important for Proxy
+  // prototypes used by Test262 PutValue tests).
+  if (op == AssignmentExpr::Op::Assign && usedPrimitiveWrapper) {
+    Value receiver = usedPrimitiveWrapper ? primitiveBaseValue : obj;
+    if (isSuperTarget && superReceiver.isObject()) {
+      receiver = superReceiver;
+    }
+    if (isSuperTarget &&
+        receiver.isObject() &&
+        receiver.getGC<Object>()->isModuleNamespace) {
+      if (strictMode_) {
+        throwError(ErrorType::TypeError, "Cannot assign to property '" + propName + "' of module namespace object");
+        return Value(Undefined{});
+      }
+      return right;
+    }
 
-          recvObj->properties[key] = v;
+    auto ordinarySet = [&](auto&& self,
+                           const Value& base,
+                           const Value& recv,
+                           const std::string& key,
+                           const Value& v) -> bool {
+      if (base.isProxy()) {
+        auto proxyPtr = base.getGC<Proxy>();
+        if (proxyPtr->handler && proxyPtr->handler->isObject()) {
+          auto handlerObj = std::get<GCPtr<Object>>(proxyPtr->handler->data);
+          auto trapIt = handlerObj->properties.find("set");
+          if (trapIt != handlerObj->properties.end() && trapIt->second.isFunction()) {
+            auto trap = trapIt->second.getGC<Function>();
+            std::vector<Value> trapArgs = {
+              proxyPtr->target ? *proxyPtr->target : Value(Undefined{}),
+              toPropertyKeyValue(key),
+              v,
+              recv
+            };
+            Value result = trap->isNative ? trap->nativeFunc(trapArgs)
+                                          : invokeFunction(trap, trapArgs, Value(Undefined{}));
+            if (hasError()) return false;
+            return result.toBool();
+          }
+        }
+        // No trap: write through to target if possible.
+        if (proxyPtr->target && proxyPtr->target->isObject() && recv.isObject()) {
+          recv.getGC<Object>()->properties[key] = v;
           return true;
         }
+        return false;
+      }
 
-        if (base.isClass()) {
-          auto cls = base.getGC<Class>();
-          auto itOwn = cls->properties.find(key);
-          if (itOwn == cls->properties.end()) {
-            auto protoIt = cls->properties.find("__proto__");
-            if (protoIt != cls->properties.end() && !protoIt->second.isNull() && !protoIt->second.isUndefined()) {
-              return self(self, protoIt->second, recv, key, v);
-            }
-          }
-          if (!recv.isClass() && !recv.isObject()) return false;
-          if (recv.isClass()) {
-            recv.getGC<Class>()->properties[key] = v;
-          } else {
-            recv.getGC<Object>()->properties[key] = v;
+      if (base.isObject()) {
+        auto baseObj = base.getGC<Object>();
+        if (baseObj->isModuleNamespace) {
+          return false;
+        }
+        std::string getterName = "__get_" + key;
+        std::string setterName = "__set_" + key;
+        auto setterIt = baseObj->properties.find(setterName);
+        if (setterIt != baseObj->properties.end() && setterIt->second.isFunction()) {
+          invokeFunction(setterIt->second.getGC<Function>(), {v}, recv);
+          return !hasError();
+        }
+        auto getterIt = baseObj->properties.find(getterName);
+        if (getterIt != baseObj->properties.end() && getterIt->second.isFunction() &&
+            setterIt == baseObj->properties.end()) {
+          // Getter-only property.
+          return false;
+        }
+
+        // If property exists somewhere on the prototype chain, ordinary [[Set]]
+        // still routes through the chain. We approximate by delegating first.
+        auto itOwn = baseObj->properties.find(key);
+        if (itOwn == baseObj->properties.end()) {
+          auto protoIt = baseObj->properties.find("__proto__");
+          if (protoIt != baseObj->properties.end() && !protoIt->second.isNull() && !protoIt->second.isUndefined()) {
+            return self(self, protoIt->second, recv, key, v);
           }
-          return true;
         }
 
-        return false;
-      };
+        if (!recv.isObject()) return false;
+        auto recvObj = recv.getGC<Object>();
+        if (recvObj->isModuleNamespace) return false;
+        if (recvObj->frozen) return false;
+        if (recvObj->properties.count("__non_writable_" + key)) return false;
+        bool isNew = recvObj->properties.find(key) == recvObj->properties.end();
+        if ((recvObj->sealed || recvObj->nonExtensible) && isNew) return false;
 
-      bool ok = ordinarySet(ordinarySet, obj, receiver, propName, right);
-      if (!ok && strictMode_) {
-        throwError(ErrorType::TypeError, "Cannot assign to property '" + propName + "'");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        recvObj->properties[key] = v;
+        return true;
       }
-      LIGHTJS_RETURN(right);
-    }
 
-    // Handle Proxy set trap
-    if (obj.isProxy()) {
-      auto proxyPtr = obj.getGC<Proxy>();
-      if (proxyPtr->handler && proxyPtr->handler->isObject()) {
-        auto handlerObj = std::get<GCPtr<Object>>(proxyPtr->handler->data);
-        auto trapIt = handlerObj->properties.find("set");
-        if (trapIt != handlerObj->properties.end() && trapIt->second.isFunction()) {
-          auto trap = trapIt->second.getGC<Function>();
-          if (trap->isNative) {
-            // Call set trap: handler.set(target, property, value, receiver)
-            std::vector<Value> trapArgs = {*proxyPtr->target, toPropertyKeyValue(propName), right, obj};
-            Value result = trap->nativeFunc(trapArgs);
-            if (!result.toBool()) {
-              // Set trap returned false - throw in strict mode, but we'll just return
-            }
-            LIGHTJS_RETURN(right);
-          } else {
-            // Non-native set trap - call as JS function
-            std::vector<Value> trapArgs = {*proxyPtr->target, toPropertyKeyValue(propName), right, obj};
-            Value result = invokeFunction(trap, trapArgs, Value(Undefined{}));
-            if (!result.toBool()) {
-              // Set trap returned false
-            }
-            LIGHTJS_RETURN(right);
+      if (base.isClass()) {
+        auto cls = base.getGC<Class>();
+        auto itOwn = cls->properties.find(key);
+        if (itOwn == cls->properties.end()) {
+          auto protoIt = cls->properties.find("__proto__");
+          if (protoIt != cls->properties.end() && !protoIt->second.isNull() && !protoIt->second.isUndefined()) {
+            return self(self, protoIt->second, recv, key, v);
           }
         }
+        if (!recv.isClass() && !recv.isObject()) return false;
+        if (recv.isClass()) {
+          recv.getGC<Class>()->properties[key] = v;
+        } else {
+          recv.getGC<Object>()->properties[key] = v;
+        }
+        return true;
       }
-      // No set trap - fall through to set on target
-      if (proxyPtr->target && proxyPtr->target->isObject()) {
-        auto targetObj = std::get<GCPtr<Object>>(proxyPtr->target->data);
-        targetObj->properties[propName] = right;
-        LIGHTJS_RETURN(right);
-      }
+
+      return false;
+    };
+
+    bool ok = ordinarySet(ordinarySet, obj, receiver, propName, right);
+    if (!ok && strictMode_) {
+      throwError(ErrorType::TypeError, "Cannot assign to property '" + propName + "'");
+      return Value(Undefined{});
     }
+    return right;
+  }
 
-    if (obj.isObject()) {
-      auto objPtr = obj.getGC<Object>();
-      auto writeObjPtr = objPtr;
-      if (isSuperTarget && superReceiver.isObject()) {
-        writeObjPtr = superReceiver.getGC<Object>();
-        if (writeObjPtr->isModuleNamespace) {
-          if (strictMode_) {
-            throwError(ErrorType::TypeError, "Cannot assign to property '" + propName + "' of module namespace object");
-            LIGHTJS_RETURN(Value(Undefined{}));
+  // Handle Proxy set trap
+  if (obj.isProxy()) {
+    auto proxyPtr = obj.getGC<Proxy>();
+    if (proxyPtr->handler && proxyPtr->handler->isObject()) {
+      auto handlerObj = std::get<GCPtr<Object>>(proxyPtr->handler->data);
+      auto trapIt = handlerObj->properties.find("set");
+      if (trapIt != handlerObj->properties.end() && trapIt->second.isFunction()) {
+        auto trap = trapIt->second.getGC<Function>();
+        if (trap->isNative) {
+          // Call set trap: handler.set(target, property, value, receiver)
+          std::vector<Value> trapArgs = {*proxyPtr->target, toPropertyKeyValue(propName), right, obj};
+          Value result = trap->nativeFunc(trapArgs);
+          if (!result.toBool()) {
+            // Set trap returned false - throw in strict mode, but we'll just return
           }
-          LIGHTJS_RETURN(right);
+          return right;
+        } else {
+          // Non-native set trap - call as JS function
+          std::vector<Value> trapArgs = {*proxyPtr->target, toPropertyKeyValue(propName), right, obj};
+          Value result = invokeFunction(trap, trapArgs, Value(Undefined{}));
+          if (!result.toBool()) {
+            // Set trap returned false
+          }
+          return right;
         }
       }
+    }
+    // No set trap - fall through to set on target
+    if (proxyPtr->target && proxyPtr->target->isObject()) {
+      auto targetObj = std::get<GCPtr<Object>>(proxyPtr->target->data);
+      targetObj->properties[propName] = right;
+      return right;
+    }
+  }
 
-      // Handle private field assignment (#name)
-      if (member->privateIdentifier) {
-        GCPtr<Class> cls;
-        auto ctorIt = objPtr->properties.find("__constructor__");
-        if (ctorIt != objPtr->properties.end() && ctorIt->second.isClass()) {
-          cls = ctorIt->second.getGC<Class>();
-        }
-        GCPtr<Class> ownerClass = activePrivateOwnerClass_ ? activePrivateOwnerClass_ : cls;
-        auto isOwnerInClassChain = [&](GCPtr<Class> target, const GCPtr<Class>& owner) -> bool {
-          int depth = 0;
-          while (target && depth < 128) {
-            if (target.get() == owner.get()) {
-              return true;
-            }
-            target = target->superClass;
-            depth++;
-          }
-          return false;
-        };
-        if (!ownerClass || !cls || !isOwnerInClassChain(cls, ownerClass)) {
-          throwError(ErrorType::TypeError, "Cannot read private member " + propName + " from an object whose class did not declare it");
-          LIGHTJS_RETURN(Value(Undefined{}));
+  if (obj.isObject()) {
+    auto objPtr = obj.getGC<Object>();
+    auto writeObjPtr = objPtr;
+    if (isSuperTarget && superReceiver.isObject()) {
+      writeObjPtr = superReceiver.getGC<Object>();
+      if (writeObjPtr->isModuleNamespace) {
+        if (strictMode_) {
+          throwError(ErrorType::TypeError, "Cannot assign to property '" + propName + "' of module namespace object");
+          return Value(Undefined{});
         }
+        return right;
+      }
+    }
 
-        Value current(Undefined{});
-        bool isMethod = false;
-        bool hasPrivateGetter = false;
-        bool hasPrivateSetter = false;
-        if (ownerClass) {
-          auto getterIt = ownerClass->getters.find(propName);
-          if (getterIt != ownerClass->getters.end()) {
-            hasPrivateGetter = true;
-            current = invokeFunction(getterIt->second, {}, obj);
-            if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          auto setterIt = ownerClass->setters.find(propName);
-          if (setterIt != ownerClass->setters.end()) {
-            hasPrivateSetter = true;
-          }
-          auto methodIt = ownerClass->methods.find(propName);
-          if (methodIt != ownerClass->methods.end()) {
-            isMethod = true;
-            current = Value(methodIt->second);
+    // Handle private field assignment (#name)
+    if (privateIdentifier) {
+      GCPtr<Class> cls;
+      auto ctorIt = objPtr->properties.find("__constructor__");
+      if (ctorIt != objPtr->properties.end() && ctorIt->second.isClass()) {
+        cls = ctorIt->second.getGC<Class>();
+      }
+      GCPtr<Class> ownerClass = activePrivateOwnerClass_ ? activePrivateOwnerClass_ : cls;
+      auto isOwnerInClassChain = [&](GCPtr<Class> target, const GCPtr<Class>& owner) -> bool {
+        int depth = 0;
+        while (target && depth < 128) {
+          if (target.get() == owner.get()) {
+            return true;
           }
+          target = target->superClass;
+          depth++;
         }
+        return false;
+      };
+      if (!ownerClass || !cls || !isOwnerInClassChain(cls, ownerClass)) {
+        throwError(ErrorType::TypeError, "Cannot read private member " + propName + " from an object whose class did not declare it");
+        return Value(Undefined{});
+      }
 
-        std::string mangledName = privateStorageKey(ownerClass, propName);
-        if (!hasPrivateGetter && !isMethod) {
-          auto it = objPtr->properties.find(mangledName);
-          if (it != objPtr->properties.end()) {
-            current = it->second;
-          }
+      Value current(Undefined{});
+      bool isMethod = false;
+      bool hasPrivateGetter = false;
+      bool hasPrivateSetter = false;
+      if (ownerClass) {
+        auto getterIt = ownerClass->getters.find(propName);
+        if (getterIt != ownerClass->getters.end()) {
+          hasPrivateGetter = true;
+          current = invokeFunction(getterIt->second, {}, obj);
+          if (hasError()) return Value(Undefined{});
         }
-
-        if (isMethod) {
-          throwError(ErrorType::TypeError, "Cannot assign to private method " + propName);
-          LIGHTJS_RETURN(Value(Undefined{}));
+        auto setterIt = ownerClass->setters.find(propName);
+        if (setterIt != ownerClass->setters.end()) {
+          hasPrivateSetter = true;
         }
-
-        if (expr.op == AssignmentExpr::Op::Assign) {
-          if (hasPrivateGetter && !hasPrivateSetter) {
-            throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          if (hasPrivateSetter && ownerClass) {
-            auto setterIt = ownerClass->setters.find(propName);
-            if (setterIt != ownerClass->setters.end()) {
-              invokeFunction(setterIt->second, {right}, obj);
-              if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-            }
-          } else {
-            objPtr->properties[mangledName] = right;
-          }
-          LIGHTJS_RETURN(right);
+        auto methodIt = ownerClass->methods.find(propName);
+        if (methodIt != ownerClass->methods.end()) {
+          isMethod = true;
+          current = Value(methodIt->second);
         }
+      }
 
-        Value result;
-        if (!computeCompoundValue(expr.op, current, right, result)) {
-          LIGHTJS_RETURN(Value(Undefined{}));
+      std::string mangledName = privateStorageKey(ownerClass, propName);
+      if (!hasPrivateGetter && !isMethod) {
+        auto it = objPtr->properties.find(mangledName);
+        if (it != objPtr->properties.end()) {
+          current = it->second;
         }
+      }
+
+      if (isMethod) {
+        throwError(ErrorType::TypeError, "Cannot assign to private method " + propName);
+        return Value(Undefined{});
+      }
+
+      if (op == AssignmentExpr::Op::Assign) {
         if (hasPrivateGetter && !hasPrivateSetter) {
           throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
-          LIGHTJS_RETURN(Value(Undefined{}));
+          return Value(Undefined{});
         }
         if (hasPrivateSetter && ownerClass) {
           auto setterIt = ownerClass->setters.find(propName);
           if (setterIt != ownerClass->setters.end()) {
-            invokeFunction(setterIt->second, {result}, obj);
-            if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
+            invokeFunction(setterIt->second, {right}, obj);
+            if (hasError()) return Value(Undefined{});
           }
         } else {
-          objPtr->properties[mangledName] = result;
+          objPtr->properties[mangledName] = right;
         }
-        LIGHTJS_RETURN(result);
+        return right;
       }
 
-      if (writeObjPtr->isModuleNamespace) {
-        // Module namespace exotic objects reject writes.
-        if (strictMode_) {
-          throwError(ErrorType::TypeError, "Cannot assign to property '" + propName + "' of module namespace object");
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
-        LIGHTJS_RETURN(right);
-      }
-
-      std::string getterName = "__get_" + propName;
-      std::string setterName = "__set_" + propName;
-      auto getterIt = objPtr->properties.find(getterName);
-      auto setterIt = objPtr->properties.find(setterName);
-      bool hasGetter = getterIt != objPtr->properties.end() && getterIt->second.isFunction();
-      bool hasSetter = setterIt != objPtr->properties.end() && setterIt->second.isFunction();
-
-      // If there's no own accessor or data property on the base object, check the prototype chain
-      // for an accessor. This is required for class-defined accessors (stored on the prototype)
-      // to run on instance assignment.
-      bool baseHasDataProp = objPtr->properties.count(propName) > 0;
-      bool inheritedHasGetter = false;
-      bool inheritedHasSetter = false;
-      bool inheritedDataNonWritable = false;
-      Value inheritedGetter(Undefined{});
-      Value inheritedSetter(Undefined{});
-      if (!hasGetter && !hasSetter && !baseHasDataProp) {
-        auto protoIt = objPtr->properties.find("__proto__");
-        if (protoIt != objPtr->properties.end()) {
-          Value protoVal = protoIt->second;
-          int depth = 0;
-          while (depth < 50) {
-            if (protoVal.isNull() || protoVal.isUndefined()) break;
-            if (protoVal.isObject()) {
-              auto proto = protoVal.getGC<Object>();
-              auto gIt = proto->properties.find(getterName);
-              auto sIt = proto->properties.find(setterName);
-              bool g = gIt != proto->properties.end() && gIt->second.isFunction();
-              bool s = sIt != proto->properties.end() && sIt->second.isFunction();
-              if (g || s) {
-                inheritedHasGetter = g;
-                inheritedHasSetter = s;
-                if (g) inheritedGetter = gIt->second;
-                if (s) inheritedSetter = sIt->second;
-                break;
-              }
-              // Data properties shadow accessors further up the chain.
-              if (proto->properties.count(propName) > 0) {
-                inheritedDataNonWritable =
-                  proto->properties.count("__non_writable_" + propName) > 0;
-                break;
-              }
-              auto nextProto = proto->properties.find("__proto__");
-              if (nextProto == proto->properties.end()) break;
-              protoVal = nextProto->second;
-            } else if (protoVal.isClass()) {
-              auto protoCls = protoVal.getGC<Class>();
-              auto gIt = protoCls->properties.find(getterName);
-              auto sIt = protoCls->properties.find(setterName);
-              bool g = gIt != protoCls->properties.end() && gIt->second.isFunction();
-              bool s = sIt != protoCls->properties.end() && sIt->second.isFunction();
-              if (g || s) {
-                inheritedHasGetter = g;
-                inheritedHasSetter = s;
-                if (g) inheritedGetter = gIt->second;
-                if (s) inheritedSetter = sIt->second;
-                break;
-              }
-              if (protoCls->properties.count(propName) > 0) {
-                inheritedDataNonWritable =
-                  protoCls->properties.count("__non_writable_" + propName) > 0;
-                break;
-              }
-              auto nextProto = protoCls->properties.find("__proto__");
-              if (nextProto == protoCls->properties.end()) break;
-              protoVal = nextProto->second;
-            } else {
-              break;
-            }
-            depth++;
-          }
+      Value result;
+      if (!computeCompoundAssignment(op, current, right, result)) {
+        return Value(Undefined{});
+      }
+      if (hasPrivateGetter && !hasPrivateSetter) {
+        throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
+        return Value(Undefined{});
+      }
+      if (hasPrivateSetter && ownerClass) {
+        auto setterIt = ownerClass->setters.find(propName);
+        if (setterIt != ownerClass->setters.end()) {
+          invokeFunction(setterIt->second, {result}, obj);
+          if (hasError()) return Value(Undefined{});
         }
+      } else {
+        objPtr->properties[mangledName] = result;
       }
+      return result;
+    }
 
-      // Accessor writes should run the setter instead of creating an own data property.
-      if (expr.op == AssignmentExpr::Op::Assign) {
-        if (hasSetter) {
-          auto setter = setterIt->second.getGC<Function>();
-          Value setterReceiver = (isSuperTarget && superReceiver.isObject()) ? superReceiver : obj;
-          invokeFunction(setter, {right}, setterReceiver);
-          if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-          LIGHTJS_RETURN(right);
-        }
-        if (inheritedHasSetter) {
-          auto setter = inheritedSetter.getGC<Function>();
-          Value setterReceiver = (isSuperTarget && superReceiver.isObject()) ? superReceiver : obj;
-          invokeFunction(setter, {right}, setterReceiver);
-          if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-          LIGHTJS_RETURN(right);
-        }
-        if ((hasGetter && !hasSetter) || (inheritedHasGetter && !inheritedHasSetter)) {
-          if (strictMode_) {
-            throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
-            LIGHTJS_RETURN(Value(Undefined{}));
+    if (writeObjPtr->isModuleNamespace) {
+      // Module namespace exotic objects reject writes.
+      if (strictMode_) {
+        throwError(ErrorType::TypeError, "Cannot assign to property '" + propName + "' of module namespace object");
+        return Value(Undefined{});
+      }
+      return right;
+    }
+
+    const Value* getterSlot = objPtr->properties.getter(propName);
+    const Value* setterSlot = objPtr->properties.setter(propName);
+    bool hasGetter = getterSlot && getterSlot->isFunction();
+    bool hasSetter = setterSlot && setterSlot->isFunction();
+    Value ownGetter = hasGetter ? *getterSlot : Value(Undefined{});
+    Value ownSetter = hasSetter ? *setterSlot : Value(Undefined{});
+
+    // If there's no own accessor or data property on the base object, check the prototype chain
+    // for an accessor. This is required for class-defined accessors (stored on the prototype)
+    // to run on instance assignment.
+    bool baseHasDataProp = objPtr->properties.lookup(propName) != nullptr;
+    bool inheritedHasGetter = false;
+    bool inheritedHasSetter = false;
+    bool inheritedDataNonWritable = false;
+    Value inheritedGetter(Undefined{});
+    Value inheritedSetter(Undefined{});
+    if (!hasGetter && !hasSetter && !baseHasDataProp) {
+      if (const Value* protoSlot = objPtr->properties.prototype()) {
+        Value protoVal = *protoSlot;
+        int depth = 0;
+        while (depth < 50) {
+          if (protoVal.isNull() || protoVal.isUndefined()) break;
+          const PropertyMap* protoProps = nullptr;
+          if (protoVal.isObject()) {
+            protoProps = &protoVal.getGC<Object>()->properties;
+          } else if (protoVal.isClass()) {
+            protoProps = &protoVal.getGC<Class>()->properties;
+          } else {
+            break;
           }
-          LIGHTJS_RETURN(right);
-        }
-        if (inheritedDataNonWritable) {
-          if (strictMode_) {
-            throwError(ErrorType::TypeError, "Cannot assign to read only property '" + propName + "'");
-            LIGHTJS_RETURN(Value(Undefined{}));
+          const Value* g = protoProps->getter(propName);
+          const Value* s = protoProps->setter(propName);
+          bool hasG = g && g->isFunction();
+          bool hasS = s && s->isFunction();
+          if (hasG || hasS) {
+            inheritedHasGetter = hasG;
+            inheritedHasSetter = hasS;
+            if (hasG) inheritedGetter = *g;
+            if (hasS) inheritedSetter = *s;
+            break;
           }
-          LIGHTJS_RETURN(right);
+          // Data properties shadow accessors further up the chain.
+          if (protoProps->lookup(propName)) {
+            inheritedDataNonWritable =
+              protoProps->count("__non_writable_" + propName) > 0;
+            break;
+          }
+          const Value* nextProto = protoProps->prototype();
+          if (!nextProto) break;
+          protoVal = *nextProto;
+          depth++;
         }
       }
+    }
 
-      // Check if object is frozen (can't modify own properties / add new ones).
-      if (writeObjPtr->frozen) {
+    // Accessor writes should run the setter instead of creating an own data property.
+    if (op == AssignmentExpr::Op::Assign) {
+      if (hasSetter) {
+        auto setter = ownSetter.getGC<Function>();
+        Value setterReceiver = (isSuperTarget && superReceiver.isObject()) ? superReceiver : obj;
+        invokeFunction(setter, {right}, setterReceiver);
+        if (hasError()) return Value(Undefined{});
+        return right;
+      }
+      if (inheritedHasSetter) {
+        auto setter = inheritedSetter.getGC<Function>();
+        Value setterReceiver = (isSuperTarget && superReceiver.isObject()) ? superReceiver : obj;
+        invokeFunction(setter, {right}, setterReceiver);
+        if (hasError()) return Value(Undefined{});
+        return right;
+      }
+      if ((hasGetter && !hasSetter) || (inheritedHasGetter && !inheritedHasSetter)) {
         if (strictMode_) {
-          throwError(ErrorType::TypeError, "Cannot assign to read only property '" + propName + "' of object");
-          LIGHTJS_RETURN(Value(Undefined{}));
+          throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
+          return Value(Undefined{});
         }
-        LIGHTJS_RETURN(right);
+        return right;
       }
-
-      // Check __non_writable_ marker on the receiver.
-      if (writeObjPtr->properties.count("__non_writable_" + propName)) {
+      if (inheritedDataNonWritable) {
         if (strictMode_) {
           throwError(ErrorType::TypeError, "Cannot assign to read only property '" + propName + "'");
-          LIGHTJS_RETURN(Value(Undefined{}));
+          return Value(Undefined{});
         }
-        LIGHTJS_RETURN(right);
+        return right;
       }
+    }
 
-      // Setting [[Prototype]] of a non-extensible object must not succeed.
-      if (propName == "__proto__" && (writeObjPtr->sealed || writeObjPtr->nonExtensible)) {
-        if (strictMode_) {
-          throwError(ErrorType::TypeError, "Cannot set prototype of non-extensible object");
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
-        LIGHTJS_RETURN(right);
+    // Check if object is frozen (can't modify own properties / add new ones).
+    if (writeObjPtr->frozen) {
+      if (strictMode_) {
+        throwError(ErrorType::TypeError, "Cannot assign to read only property '" + propName + "' of object");
+        return Value(Undefined{});
       }
+      return right;
+    }
 
-      // Check if object is sealed (can't add new properties)
-      bool isNewProperty = writeObjPtr->properties.find(propName) == writeObjPtr->properties.end();
-      if ((writeObjPtr->sealed || writeObjPtr->nonExtensible) && isNewProperty) {
-        if (strictMode_) {
-          throwError(ErrorType::TypeError, "Cannot add property " + propName + ", object is not extensible");
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
-        LIGHTJS_RETURN(right);
+    // Check __non_writable_ marker on the receiver.
+    if (writeObjPtr->properties.count("__non_writable_" + propName)) {
+      if (strictMode_) {
+        throwError(ErrorType::TypeError, "Cannot assign to read only property '" + propName + "'");
+        return Value(Undefined{});
       }
+      return right;
+    }
 
-      // Shape tracking disabled - using direct hash map access for simplicity
-
-      if (expr.op == AssignmentExpr::Op::Assign) {
-        writeObjPtr->properties[propName] = right;
-      } else {
-        Value current(Undefined{});
-        if (hasGetter) {
-          Value getterReceiver = (isSuperTarget && superReceiver.isObject()) ? superReceiver : obj;
-          current = callFunction(getterIt->second, {}, getterReceiver);
-          if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-        } else if (inheritedHasGetter) {
-          Value getterReceiver = (isSuperTarget && superReceiver.isObject()) ? superReceiver : obj;
-          current = callFunction(inheritedGetter, {}, getterReceiver);
-          if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-        } else {
-          auto curIt = objPtr->properties.find(propName);
-          if (curIt != objPtr->properties.end()) {
-            current = curIt->second;
-          }
-        }
+    // Setting [[Prototype]] of a non-extensible object must not succeed.
+    if (propName == "__proto__" && (writeObjPtr->sealed || writeObjPtr->nonExtensible)) {
+      if (strictMode_) {
+        throwError(ErrorType::TypeError, "Cannot set prototype of non-extensible object");
+        return Value(Undefined{});
+      }
+      return right;
+    }
 
-        Value result;
-        if (!computeCompoundValue(expr.op, current, right, result)) {
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
+    // Check if object is sealed (can't add new properties)
+    bool isNewProperty = writeObjPtr->properties.find(propName) == writeObjPtr->properties.end();
+    if ((writeObjPtr->sealed || writeObjPtr->nonExtensible) && isNewProperty) {
+      if (strictMode_) {
+        throwError(ErrorType::TypeError, "Cannot add property " + propName + ", object is not extensible");
+        return Value(Undefined{});
+      }
+      return right;
+    }
 
-        if (hasGetter && !hasSetter) {
-          if (strictMode_) {
-            throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          LIGHTJS_RETURN(result);
-        }
+    // Shape tracking disabled - using direct hash map access for simplicity
 
-        if (hasSetter) {
-          auto setter = setterIt->second.getGC<Function>();
-          Value setterReceiver = (isSuperTarget && superReceiver.isObject()) ? superReceiver : obj;
-          invokeFunction(setter, {result}, setterReceiver);
-          if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-          LIGHTJS_RETURN(result);
-        }
-        if (inheritedHasSetter) {
-          auto setter = inheritedSetter.getGC<Function>();
-          Value setterReceiver = (isSuperTarget && superReceiver.isObject()) ? superReceiver : obj;
-          invokeFunction(setter, {result}, setterReceiver);
-          if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-          LIGHTJS_RETURN(result);
-        }
-        if ((inheritedHasGetter && !inheritedHasSetter) || (hasGetter && !hasSetter)) {
-          if (strictMode_) {
-            throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          LIGHTJS_RETURN(result);
-        }
-        if (inheritedDataNonWritable) {
-          if (strictMode_) {
-            throwError(ErrorType::TypeError, "Cannot assign to read only property '" + propName + "'");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          LIGHTJS_RETURN(result);
+    if (op == AssignmentExpr::Op::Assign) {
+      writeObjPtr->properties[propName] = right;
+    } else {
+      Value current(Undefined{});
+      if (hasGetter) {
+        Value getterReceiver = (isSuperTarget && superReceiver.isObject()) ? superReceiver : obj;
+        current = callFunction(ownGetter, {}, getterReceiver);
+        if (hasError()) return Value(Undefined{});
+      } else if (inheritedHasGetter) {
+        Value getterReceiver = (isSuperTarget && superReceiver.isObject()) ? superReceiver : obj;
+        current = callFunction(inheritedGetter, {}, getterReceiver);
+        if (hasError()) return Value(Undefined{});
+      } else {
+        auto curIt = objPtr->properties.find(propName);
+        if (curIt != objPtr->properties.end()) {
+          current = curIt->second;
         }
+      }
 
-        writeObjPtr->properties[propName] = result;
+      Value result;
+      if (!computeCompoundAssignment(op, current, right, result)) {
+        return Value(Undefined{});
       }
-      // Sync globalThis property changes back to root environment bindings.
-      // In JS, global variables ARE properties of the global object, so
-      // this['x'] = 5 must also update the variable binding for x.
-      auto rootEnv = env_->getRoot();
-      auto globalThisVal = rootEnv->get("globalThis");
-      if (globalThisVal && globalThisVal->isObject()) {
-        auto globalObj = std::get<GCPtr<Object>>(globalThisVal->data);
-        if (globalObj.get() == writeObjPtr.get()) {
-          rootEnv->set(propName, writeObjPtr->properties[propName]);
+
+      if (hasGetter && !hasSetter) {
+        if (strictMode_) {
+          throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
+          return Value(Undefined{});
         }
+        return result;
       }
-      LIGHTJS_RETURN(writeObjPtr->properties[propName]);
-    }
 
-    if (obj.isFunction()) {
-      auto funcPtr = obj.getGC<Function>();
-      if (propName == "caller" || propName == "arguments") {
-        // Restricted properties live on %FunctionPrototype% and must not be
-        // created as own data properties.
-        throwError(ErrorType::TypeError, "'caller', 'callee', and 'arguments' properties may not be accessed");
-        LIGHTJS_RETURN(Value(Undefined{}));
+      if (hasSetter) {
+        auto setter = ownSetter.getGC<Function>();
+        Value setterReceiver = (isSuperTarget && superReceiver.isObject()) ? superReceiver : obj;
+        invokeFunction(setter, {result}, setterReceiver);
+        if (hasError()) return Value(Undefined{});
+        return result;
       }
-      // name and length are non-writable on functions
-      if (propName == "name" || propName == "length") {
+      if (inheritedHasSetter) {
+        auto setter = inheritedSetter.getGC<Function>();
+        Value setterReceiver = (isSuperTarget && superReceiver.isObject()) ? superReceiver : obj;
+        invokeFunction(setter, {result}, setterReceiver);
+        if (hasError()) return Value(Undefined{});
+        return result;
+      }
+      if ((inheritedHasGetter && !inheritedHasSetter) || (hasGetter && !hasSetter)) {
         if (strictMode_) {
-          throwError(ErrorType::TypeError, "Cannot assign to read only property '" + propName + "'");
-          LIGHTJS_RETURN(Value(Undefined{}));
+          throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
+          return Value(Undefined{});
         }
-        LIGHTJS_RETURN(right);
+        return result;
       }
-      // Check __non_writable_ marker
-      if (funcPtr->properties.count("__non_writable_" + propName)) {
+      if (inheritedDataNonWritable) {
         if (strictMode_) {
           throwError(ErrorType::TypeError, "Cannot assign to read only property '" + propName + "'");
-          LIGHTJS_RETURN(Value(Undefined{}));
+          return Value(Undefined{});
         }
-        LIGHTJS_RETURN(right);
+        return result;
       }
-      auto getterIt = funcPtr->properties.find("__get_" + propName);
-      auto setterIt = funcPtr->properties.find("__set_" + propName);
-      bool hasGetter = getterIt != funcPtr->properties.end() && getterIt->second.isFunction();
-      bool hasSetter = setterIt != funcPtr->properties.end() && setterIt->second.isFunction();
-      if (expr.op == AssignmentExpr::Op::Assign) {
-        if (hasSetter) {
-          invokeFunction(setterIt->second.getGC<Function>(), {right}, obj);
-          if (hasError()) {
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          LIGHTJS_RETURN(right);
+
+      writeObjPtr->properties[propName] = result;
+    }
+    // Sync globalThis property changes back to root environment bindings.
+    // In JS, global variables ARE properties of the global object, so
+    // this['x'] = 5 must also update the variable binding for x.
+    auto rootEnv = env_->getRoot();
+    auto globalThisVal = rootEnv->get("globalThis");
+    if (globalThisVal && globalThisVal->isObject()) {
+      auto globalObj = std::get<GCPtr<Object>>(globalThisVal->data);
+      if (globalObj.get() == writeObjPtr.get()) {
+        rootEnv->set(propName, writeObjPtr->properties[propName]);
+      }
+    }
+    return writeObjPtr->properties[propName];
+  }
+
+  if (obj.isFunction()) {
+    auto funcPtr = obj.getGC<Function>();
+    if (propName == "caller" || propName == "arguments") {
+      // Restricted properties live on %FunctionPrototype% and must not be
+      // created as own data properties.
+      throwError(ErrorType::TypeError, "'caller', 'callee', and 'arguments' properties may not be accessed");
+      return Value(Undefined{});
+    }
+    // name and length are non-writable on functions
+    if (propName == "name" || propName == "length") {
+      if (strictMode_) {
+        throwError(ErrorType::TypeError, "Cannot assign to read only property '" + propName + "'");
+        return Value(Undefined{});
+      }
+      return right;
+    }
+    // Check __non_writable_ marker
+    if (funcPtr->properties.count("__non_writable_" + propName)) {
+      if (strictMode_) {
+        throwError(ErrorType::TypeError, "Cannot assign to read only property '" + propName + "'");
+        return Value(Undefined{});
+      }
+      return right;
+    }
+    auto getterIt = funcPtr->properties.find("__get_" + propName);
+    auto setterIt = funcPtr->properties.find("__set_" + propName);
+    bool hasGetter = getterIt != funcPtr->properties.end() && getterIt->second.isFunction();
+    bool hasSetter = setterIt != funcPtr->properties.end() && setterIt->second.isFunction();
+    if (op == AssignmentExpr::Op::Assign) {
+      if (hasSetter) {
+        invokeFunction(setterIt->second.getGC<Function>(), {right}, obj);
+        if (hasError()) {
+          return Value(Undefined{});
         }
-        if (hasGetter && !hasSetter) {
-          if (strictMode_) {
-            throwError(ErrorType::TypeError,
-                       "Cannot set property " + propName + " which has only a getter");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          LIGHTJS_RETURN(right);
+        return right;
+      }
+      if (hasGetter && !hasSetter) {
+        if (strictMode_) {
+          throwError(ErrorType::TypeError,
+                     "Cannot set property " + propName + " which has only a getter");
+          return Value(Undefined{});
         }
+        return right;
       }
-      if (expr.op == AssignmentExpr::Op::Assign) {
-        funcPtr->properties[propName] = right;
-      } else {
-        Value current = Value(Undefined{});
-        if (hasGetter) {
-          current = callFunction(getterIt->second, {}, obj);
-          if (hasError()) {
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-        } else if (auto it = funcPtr->properties.find(propName); it != funcPtr->properties.end()) {
-          current = it->second;
+    }
+    if (op == AssignmentExpr::Op::Assign) {
+      funcPtr->properties[propName] = right;
+    } else {
+      Value current = Value(Undefined{});
+      if (hasGetter) {
+        current = callFunction(getterIt->second, {}, obj);
+        if (hasError()) {
+          return Value(Undefined{});
         }
-        Value result;
-        if (!computeCompoundValue(expr.op, current, right, result)) {
-          LIGHTJS_RETURN(Value(Undefined{}));
+      } else if (auto it = funcPtr->properties.find(propName); it != funcPtr->properties.end()) {
+        current = it->second;
+      }
+      Value result;
+      if (!computeCompoundAssignment(op, current, right, result)) {
+        return Value(Undefined{});
+      }
+      if (hasSetter) {
+        invokeFunction(setterIt->second.getGC<Function>(), {result}, obj);
+        if (hasError()) {
+          return Value(Undefined{});
         }
-        if (hasSetter) {
-          invokeFunction(setterIt->second.getGC<Function>(), {result}, obj);
-          if (hasError()) {
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-        } else if (hasGetter && !hasSetter) {
-          if (strictMode_) {
-            throwError(ErrorType::TypeError,
-                       "Cannot set property " + propName + " which has only a getter");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-        } else {
-          funcPtr->properties[propName] = result;
+      } else if (hasGetter && !hasSetter) {
+        if (strictMode_) {
+          throwError(ErrorType::TypeError,
+                     "Cannot set property " + propName + " which has only a getter");
+          return Value(Undefined{});
         }
-        LIGHTJS_RETURN(result);
-      }
-      LIGHTJS_RETURN(right);
-    }
-
-    if (obj.isPromise()) {
-      auto promisePtr = obj.getGC<Promise>();
-      if (expr.op == AssignmentExpr::Op::Assign) {
-        promisePtr->properties[propName] = right;
       } else {
-        Value current = promisePtr->properties[propName];
-        Value result;
-        if (!computeCompoundValue(expr.op, current, right, result)) {
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
-        promisePtr->properties[propName] = result;
-        LIGHTJS_RETURN(result);
+        funcPtr->properties[propName] = result;
       }
-      LIGHTJS_RETURN(right);
+      return result;
     }
+    return right;
+  }
 
-    if (obj.isRegex()) {
-      auto rxPtr = obj.getGC<Regex>();
-      std::string getterName = "__get_" + propName;
-      std::string setterName = "__set_" + propName;
-      auto getterIt = rxPtr->properties.find(getterName);
-      auto setterIt = rxPtr->properties.find(setterName);
-      bool hasGetter = getterIt != rxPtr->properties.end() && getterIt->second.isFunction();
-      bool hasSetter = setterIt != rxPtr->properties.end() && setterIt->second.isFunction();
-      bool baseHasDataProp = rxPtr->properties.count(propName) > 0;
-      bool inheritedHasGetter = false;
-      bool inheritedHasSetter = false;
-      bool inheritedDataNonWritable = false;
-      Value inheritedGetter(Undefined{});
-      Value inheritedSetter(Undefined{});
-      if (!hasGetter && !hasSetter && !baseHasDataProp) {
-        auto protoIt = rxPtr->properties.find("__proto__");
-        if (protoIt != rxPtr->properties.end()) {
-          Value protoVal = protoIt->second;
-          int depth = 0;
-          while (depth < 50) {
-            if (protoVal.isNull() || protoVal.isUndefined()) break;
-            if (protoVal.isObject()) {
-              auto proto = protoVal.getGC<Object>();
-              auto gIt = proto->properties.find(getterName);
-              auto sIt = proto->properties.find(setterName);
-              bool g = gIt != proto->properties.end() && gIt->second.isFunction();
-              bool s = sIt != proto->properties.end() && sIt->second.isFunction();
-              if (g || s) {
-                inheritedHasGetter = g;
-                inheritedHasSetter = s;
-                if (g) inheritedGetter = gIt->second;
-                if (s) inheritedSetter = sIt->second;
-                break;
-              }
-              if (proto->properties.count(propName) > 0) {
-                inheritedDataNonWritable =
-                  proto->properties.count("__non_writable_" + propName) > 0;
-                break;
-              }
-              auto nextProto = proto->properties.find("__proto__");
-              if (nextProto == proto->properties.end()) break;
-              protoVal = nextProto->second;
-            } else if (protoVal.isClass()) {
-              auto protoCls = protoVal.getGC<Class>();
-              auto gIt = protoCls->properties.find(getterName);
-              auto sIt = protoCls->properties.find(setterName);
-              bool g = gIt != protoCls->properties.end() && gIt->second.isFunction();
-              bool s = sIt != protoCls->properties.end() && sIt->second.isFunction();
-              if (g || s) {
-                inheritedHasGetter = g;
-                inheritedHasSetter = s;
-                if (g) inheritedGetter = gIt->second;
-                if (s) inheritedSetter = sIt->second;
-                break;
-              }
-              if (protoCls->properties.count(propName) > 0) {
-                inheritedDataNonWritable =
-                  protoCls->properties.count("__non_writable_" + propName) > 0;
-                break;
-              }
-              auto nextProto = protoCls->properties.find("__proto__");
-              if (nextProto == protoCls->properties.end()) break;
-              protoVal = nextProto->second;
-            } else {
+  if (obj.isPromise()) {
+    auto promisePtr = obj.getGC<Promise>();
+    if (op == AssignmentExpr::Op::Assign) {
+      promisePtr->properties[propName] = right;
+    } else {
+      Value current = promisePtr->properties[propName];
+      Value result;
+      if (!computeCompoundAssignment(op, current, right, result)) {
+        return Value(Undefined{});
+      }
+      promisePtr->properties[propName] = result;
+      return result;
+    }
+    return right;
+  }
+
+  if (obj.isRegex()) {
+    auto rxPtr = obj.getGC<Regex>();
+    std::string getterName = "__get_" + propName;
+    std::string setterName = "__set_" + propName;
+    auto getterIt = rxPtr->properties.find(getterName);
+    auto setterIt = rxPtr->properties.find(setterName);
+    bool hasGetter = getterIt != rxPtr->properties.end() && getterIt->second.isFunction();
+    bool hasSetter = setterIt != rxPtr->properties.end() && setterIt->second.isFunction();
+    bool baseHasDataProp = rxPtr->properties.count(propName) > 0;
+    bool inheritedHasGetter = false;
+    bool inheritedHasSetter = false;
+    bool inheritedDataNonWritable = false;
+    Value inheritedGetter(Undefined{});
+    Value inheritedSetter(Undefined{});
+    if (!hasGetter && !hasSetter && !baseHasDataProp) {
+      auto protoIt = rxPtr->properties.find("__proto__");
+      if (protoIt != rxPtr->properties.end()) {
+        Value protoVal = protoIt->second;
+        int depth = 0;
+        while (depth < 50) {
+          if (protoVal.isNull() || protoVal.isUndefined()) break;
+          if (protoVal.isObject()) {
+            auto proto = protoVal.getGC<Object>();
+            auto gIt = proto->properties.find(getterName);
+            auto sIt = proto->properties.find(setterName);
+            bool g = gIt != proto->properties.end() && gIt->second.isFunction();
+            bool s = sIt != proto->properties.end() && sIt->second.isFunction();
+            if (g || s) {
+              inheritedHasGetter = g;
+              inheritedHasSetter = s;
+              if (g) inheritedGetter = gIt->second;
+              if (s) inheritedSetter = sIt->second;
               break;
             }
-            depth++;
+            if (proto->properties.count(propName) > 0) {
+              inheritedDataNonWritable =
+                proto->properties.count("__non_writable_" + propName) > 0;
+              break;
+            }
+            auto nextProto = proto->properties.find("__proto__");
+            if (nextProto == proto->properties.end()) break;
+            protoVal = nextProto->second;
+          } else if (protoVal.isClass()) {
+            auto protoCls = protoVal.getGC<Class>();
+            auto gIt = protoCls->properties.find(getterName);
+            auto sIt = protoCls->properties.find(setterName);
+            bool g = gIt != protoCls->properties.end() && gIt->second.isFunction();
+            bool s = sIt != protoCls->properties.end() && sIt->second.isFunction();
+            if (g || s) {
+              inheritedHasGetter = g;
+              inheritedHasSetter = s;
+              if (g) inheritedGetter = gIt->second;
+              if (s) inheritedSetter = sIt->second;
+              break;
+            }
+            if (protoCls->properties.count(propName) > 0) {
+              inheritedDataNonWritable =
+                protoCls->properties.count("__non_writable_" + propName) > 0;
+              break;
+            }
+            auto nextProto = protoCls->properties.find("__proto__");
+            if (nextProto == protoCls->properties.end()) break;
+            protoVal = nextProto->second;
+          } else {
+            break;
           }
+          depth++;
         }
       }
+    }
 
-      if (expr.op == AssignmentExpr::Op::Assign) {
-        if (hasSetter) {
-          invokeFunction(setterIt->second.getGC<Function>(), {right}, obj);
-          if (hasError()) {
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          LIGHTJS_RETURN(right);
+    if (op == AssignmentExpr::Op::Assign) {
+      if (hasSetter) {
+        invokeFunction(setterIt->second.getGC<Function>(), {right}, obj);
+        if (hasError()) {
+          return Value(Undefined{});
         }
-        if (inheritedHasSetter) {
-          invokeFunction(inheritedSetter.getGC<Function>(), {right}, obj);
-          if (hasError()) {
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          LIGHTJS_RETURN(right);
+        return right;
+      }
+      if (inheritedHasSetter) {
+        invokeFunction(inheritedSetter.getGC<Function>(), {right}, obj);
+        if (hasError()) {
+          return Value(Undefined{});
         }
-        if ((hasGetter && !hasSetter) || (inheritedHasGetter && !inheritedHasSetter)) {
-          if (strictMode_) {
-            throwError(ErrorType::TypeError,
-                       "Cannot set property " + propName + " which has only a getter");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          LIGHTJS_RETURN(right);
+        return right;
+      }
+      if ((hasGetter && !hasSetter) || (inheritedHasGetter && !inheritedHasSetter)) {
+        if (strictMode_) {
+          throwError(ErrorType::TypeError,
+                     "Cannot set property " + propName + " which has only a getter");
+          return Value(Undefined{});
         }
-        if (rxPtr->properties.count("__non_writable_" + propName) || inheritedDataNonWritable) {
-          if (strictMode_) {
-            throwError(ErrorType::TypeError,
-                       "Cannot assign to read only property '" + propName + "'");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          LIGHTJS_RETURN(right);
+        return right;
+      }
+      if (rxPtr->properties.count("__non_writable_" + propName) || inheritedDataNonWritable) {
+        if (strictMode_) {
+          throwError(ErrorType::TypeError,
+                     "Cannot assign to read only property '" + propName + "'");
+          return Value(Undefined{});
         }
-        rxPtr->properties[propName] = right;
-      } else {
-        Value current = Value(Undefined{});
-        if (hasGetter) {
-          current = callFunction(getterIt->second, {}, obj);
-          if (hasError()) {
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-        } else if (inheritedHasGetter) {
-          current = callFunction(inheritedGetter, {}, obj);
-          if (hasError()) {
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-        } else if (auto it = rxPtr->properties.find(propName); it != rxPtr->properties.end()) {
-          current = it->second;
+        return right;
+      }
+      rxPtr->properties[propName] = right;
+    } else {
+      Value current = Value(Undefined{});
+      if (hasGetter) {
+        current = callFunction(getterIt->second, {}, obj);
+        if (hasError()) {
+          return Value(Undefined{});
         }
-        Value result;
-        if (!computeCompoundValue(expr.op, current, right, result)) {
-          LIGHTJS_RETURN(Value(Undefined{}));
+      } else if (inheritedHasGetter) {
+        current = callFunction(inheritedGetter, {}, obj);
+        if (hasError()) {
+          return Value(Undefined{});
         }
-        if (hasSetter) {
-          invokeFunction(setterIt->second.getGC<Function>(), {result}, obj);
-          if (hasError()) {
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          LIGHTJS_RETURN(result);
+      } else if (auto it = rxPtr->properties.find(propName); it != rxPtr->properties.end()) {
+        current = it->second;
+      }
+      Value result;
+      if (!computeCompoundAssignment(op, current, right, result)) {
+        return Value(Undefined{});
+      }
+      if (hasSetter) {
+        invokeFunction(setterIt->second.getGC<Function>(), {result}, obj);
+        if (hasError()) {
+          return Value(Undefined{});
         }
-        if (inheritedHasSetter) {
-          invokeFunction(inheritedSetter.getGC<Function>(), {result}, obj);
-          if (hasError()) {
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          LIGHTJS_RETURN(result);
+        return result;
+      }
+      if (inheritedHasSetter) {
+        invokeFunction(inheritedSetter.getGC<Function>(), {result}, obj);
+        if (hasError()) {
+          return Value(Undefined{});
         }
-        if ((hasGetter && !hasSetter) || (inheritedHasGetter && !inheritedHasSetter)) {
-          if (strictMode_) {
-            throwError(ErrorType::TypeError,
-                       "Cannot set property " + propName + " which has only a getter");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          LIGHTJS_RETURN(result);
+        return result;
+      }
+      if ((hasGetter && !hasSetter) || (inheritedHasGetter && !inheritedHasSetter)) {
+        if (strictMode_) {
+          throwError(ErrorType::TypeError,
+                     "Cannot set property " + propName + " which has only a getter");
+          return Value(Undefined{});
         }
-        if (rxPtr->properties.count("__non_writable_" + propName) || inheritedDataNonWritable) {
-          if (strictMode_) {
-            throwError(ErrorType::TypeError,
-                       "Cannot assign to read only property '" + propName + "'");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          LIGHTJS_RETURN(result);
+        return result;
+      }
+      if (rxPtr->properties.count("__non_writable_" + propName) || inheritedDataNonWritable) {
+        if (strictMode_) {
+          throwError(ErrorType::TypeError,
+                     "Cannot assign to read only property '" + propName + "'");
+          return Value(Undefined{});
         }
-        rxPtr->properties[propName] = result;
-        LIGHTJS_RETURN(result);
+        return result;
       }
-      LIGHTJS_RETURN(right);
+      rxPtr->properties[propName] = result;
+      return result;
     }
+    return right;
+  }
 
-    if (obj.isError()) {
-      auto errPtr = obj.getGC<Error>();
-      auto syncMessage = [&](const Value& v) {
-        if (propName == "message") {
-          errPtr->message = v.isUndefined() ? "" : v.toString();
-        }
-      };
-      if (expr.op == AssignmentExpr::Op::Assign) {
-        errPtr->properties[propName] = right;
-        syncMessage(right);
-      } else {
-        Value current = Value(Undefined{});
-        auto it = errPtr->properties.find(propName);
-        if (it != errPtr->properties.end()) current = it->second;
-        Value result;
-        if (!computeCompoundValue(expr.op, current, right, result)) {
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
-        errPtr->properties[propName] = result;
-        syncMessage(result);
-        LIGHTJS_RETURN(result);
+  if (obj.isError()) {
+    auto errPtr = obj.getGC<Error>();
+    auto syncMessage = [&](const Value& v) {
+      if (propName == "message") {
+        errPtr->message = v.isUndefined() ? "" : v.toString();
       }
-      LIGHTJS_RETURN(right);
+    };
+    if (op == AssignmentExpr::Op::Assign) {
+      errPtr->properties[propName] = right;
+      syncMessage(right);
+    } else {
+      Value current = Value(Undefined{});
+      auto it = errPtr->properties.find(propName);
+      if (it != errPtr->properties.end()) current = it->second;
+      Value result;
+      if (!computeCompoundAssignment(op, current, right, result)) {
+        return Value(Undefined{});
+      }
+      errPtr->properties[propName] = result;
+      syncMessage(result);
+      return result;
     }
+    return right;
+  }
 
-    if (obj.isArray()) {
-      auto arrPtr = obj.getGC<Array>();
-      bool nonExtensible = false;
-      if (auto itNonExt = arrPtr->properties.find("__non_extensible__");
-          itNonExt != arrPtr->properties.end() &&
-          itNonExt->second.isBool() &&
-          itNonExt->second.toBool()) {
-        nonExtensible = true;
-      }
-      if (expr.op == AssignmentExpr::Op::Assign && propName == "length") {
-        if (arrPtr->properties.find("__non_writable_length") != arrPtr->properties.end()) {
-          if (strictMode_) {
-            throwError(ErrorType::TypeError, "Cannot assign to read only property 'length'");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          LIGHTJS_RETURN(Value(static_cast<double>(arrPtr->elements.size())));
-        }
-        // Arguments objects allow arbitrary length override (configurable data property)
-        bool isArgumentsObject = false;
-        auto isArgsIt = arrPtr->properties.find("__is_arguments_object__");
-        if (isArgsIt != arrPtr->properties.end() && isArgsIt->second.isBool() && isArgsIt->second.toBool()) {
-          isArgumentsObject = true;
-        }
-        if (isArgumentsObject) {
-          arrPtr->properties["__overridden_length__"] = right;
-          LIGHTJS_RETURN(right);
-        }
-        double lenNum = right.toNumber();
-        if (!std::isfinite(lenNum) || lenNum < 0 || std::floor(lenNum) != lenNum) {
-          throwError(ErrorType::RangeError, "Invalid array length");
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
-        size_t newLen = static_cast<size_t>(lenNum);
-        if (newLen < arrPtr->elements.size()) {
-          arrPtr->elements.resize(newLen);
-        } else if (newLen > arrPtr->elements.size()) {
-          if (!resizeDenseArray(arrPtr, newLen)) {
-            throwError(ErrorType::RangeError, "Array length exceeds implementation limit");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
+  if (obj.isArray()) {
+    auto arrPtr = obj.getGC<Array>();
+    bool nonExtensible = false;
+    if (auto itNonExt = arrPtr->properties.find("__non_extensible__");
+        itNonExt != arrPtr->properties.end() &&
+        itNonExt->second.isBool() &&
+        itNonExt->second.toBool()) {
+      nonExtensible = true;
+    }
+    if (op == AssignmentExpr::Op::Assign && propName == "length") {
+      if (arrPtr->properties.find("__non_writable_length") != arrPtr->properties.end()) {
+        if (strictMode_) {
+          throwError(ErrorType::TypeError, "Cannot assign to read only property 'length'");
+          return Value(Undefined{});
         }
-        LIGHTJS_RETURN(Value(static_cast<double>(arrPtr->elements.size())));
+        return Value(static_cast<double>(arrPtr->elementCount()));
       }
-      size_t idx = 0;
-      if (parseArrayIndex(propName, idx)) {
-        auto setterIt = arrPtr->properties.find("__set_" + propName);
-        auto getterIt = arrPtr->properties.find("__get_" + propName);
-        if (expr.op == AssignmentExpr::Op::Assign) {
-          if (setterIt != arrPtr->properties.end() && setterIt->second.isFunction()) {
-            callFunction(setterIt->second, {right}, obj);
-          } else {
-            if (nonExtensible && idx >= arrPtr->elements.size()) {
-              if (strictMode_) {
-                throwError(ErrorType::TypeError, "Cannot add property '" + propName + "', object is not extensible");
-                LIGHTJS_RETURN(Value(Undefined{}));
-              }
-              LIGHTJS_RETURN(right);
-            }
-            if (arrPtr->properties.count("__non_writable_" + propName)) {
-              if (strictMode_) {
-                throwError(ErrorType::TypeError, "Cannot assign to read only property '" + propName + "'");
-                LIGHTJS_RETURN(Value(Undefined{}));
-              }
-              LIGHTJS_RETURN(right);
-            }
-            if (idx >= arrPtr->elements.size()) {
-              if (!growDenseArrayForIndex(arrPtr, idx, true)) {
-                throwError(ErrorType::RangeError, "Array index exceeds implementation limit");
-                LIGHTJS_RETURN(Value(Undefined{}));
-              }
-            }
-            arrPtr->elements[idx] = right;
-            // Clear deleted/hole marker if re-assigning to a deleted index
-            arrPtr->properties.erase("__deleted_" + propName + "__");
-            arrPtr->properties.erase("__hole_" + propName + "__");
-          }
-          LIGHTJS_RETURN(right);
-        }
-        // Compound assignment: read current, compute, write back
-        Value current = Value(Undefined{});
-        if (getterIt != arrPtr->properties.end() && getterIt->second.isFunction()) {
-          current = callFunction(getterIt->second, {}, obj);
-          if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-        } else if (idx < arrPtr->elements.size()) {
-          current = arrPtr->elements[idx];
-        }
-        Value result;
-        if (!computeCompoundValue(expr.op, current, right, result)) {
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
-        if (setterIt == arrPtr->properties.end() &&
-            arrPtr->properties.count("__non_writable_" + propName)) {
-          if (strictMode_) {
-            throwError(ErrorType::TypeError, "Cannot assign to read only property '" + propName + "'");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          LIGHTJS_RETURN(result);
-        }
-        // Only extend array if index is in bounds (compound assignment on
-        // out-of-bounds index matches arguments object behavior where length
-        // doesn't change)
-        if (setterIt != arrPtr->properties.end() && setterIt->second.isFunction()) {
-          callFunction(setterIt->second, {result}, obj);
-        } else if (idx < arrPtr->elements.size()) {
-          arrPtr->elements[idx] = result;
-        }
-        LIGHTJS_RETURN(result);
+      // Arguments objects allow arbitrary length override (configurable data property)
+      bool isArgumentsObject = false;
+      auto isArgsIt = arrPtr->properties.find("__is_arguments_object__");
+      if (isArgsIt != arrPtr->properties.end() && isArgsIt->second.isBool() && isArgsIt->second.toBool()) {
+        isArgumentsObject = true;
       }
-      if (expr.op == AssignmentExpr::Op::Assign) {
-        auto getterIt = arrPtr->properties.find("__get_" + propName);
-        auto setterIt = arrPtr->properties.find("__set_" + propName);
-        bool hasGetter = getterIt != arrPtr->properties.end() && getterIt->second.isFunction();
-        bool hasSetter = setterIt != arrPtr->properties.end() && setterIt->second.isFunction();
-
-        // Accessor assignment should invoke the setter.
-        if (hasSetter) {
-          callFunction(setterIt->second, {right}, obj);
-          if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-          LIGHTJS_RETURN(right);
-        }
-        if (hasGetter && !hasSetter) {
-          if (strictMode_) {
-            throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          LIGHTJS_RETURN(right);
-        }
-
-        // For frozen template objects and similar, arrays also use __non_writable_<name> markers.
-        if (arrPtr->properties.count("__non_writable_" + propName)) {
-          if (strictMode_) {
-            throwError(ErrorType::TypeError, "Cannot assign to read only property '" + propName + "'");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          LIGHTJS_RETURN(right);
-        }
-
-        if (nonExtensible && arrPtr->properties.find(propName) == arrPtr->properties.end()) {
-          if (strictMode_) {
-            throwError(ErrorType::TypeError, "Cannot add property '" + propName + "', object is not extensible");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          LIGHTJS_RETURN(right);
-        }
-
-        arrPtr->properties[propName] = right;
-      } else {
-        auto getterIt = arrPtr->properties.find("__get_" + propName);
-        auto setterIt = arrPtr->properties.find("__set_" + propName);
-        bool hasGetter = getterIt != arrPtr->properties.end() && getterIt->second.isFunction();
-        bool hasSetter = setterIt != arrPtr->properties.end() && setterIt->second.isFunction();
-
-        Value current = Value(Undefined{});
-        if (hasGetter) {
-          current = callFunction(getterIt->second, {}, obj);
-          if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-        } else if (auto it = arrPtr->properties.find(propName); it != arrPtr->properties.end()) {
-          current = it->second;
-        }
-        Value result;
-        if (!computeCompoundValue(expr.op, current, right, result)) {
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
-
-        if (hasGetter && !hasSetter) {
-          if (strictMode_) {
-            throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          LIGHTJS_RETURN(result);
-        }
-
-        if (hasSetter) {
-          callFunction(setterIt->second, {result}, obj);
-          if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-          LIGHTJS_RETURN(result);
-        }
-
-        if (arrPtr->properties.count("__non_writable_" + propName)) {
-          if (strictMode_) {
-            throwError(ErrorType::TypeError, "Cannot assign to read only property '" + propName + "'");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          LIGHTJS_RETURN(result);
-        }
-
-        if (nonExtensible && arrPtr->properties.find(propName) == arrPtr->properties.end()) {
-          if (strictMode_) {
-            throwError(ErrorType::TypeError, "Cannot add property '" + propName + "', object is not extensible");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          LIGHTJS_RETURN(result);
-        }
-
-        arrPtr->properties[propName] = result;
+      if (isArgumentsObject) {
+        arrPtr->properties["__overridden_length__"] = right;
+        return right;
+      }
+      double lenNum = right.toNumber();
+      if (!std::isfinite(lenNum) || lenNum < 0 || std::floor(lenNum) != lenNum) {
+        throwError(ErrorType::RangeError, "Invalid array length");
+        return Value(Undefined{});
       }
-      LIGHTJS_RETURN(arrPtr->properties[propName]);
-    }
-
-    if (obj.isTypedArray()) {
-      auto taPtr = obj.getGC<TypedArray>();
-      size_t idx = 0;
-      if (parseArrayIndex(propName, idx)) {
-        if (taPtr->type == TypedArrayType::BigInt64 || taPtr->type == TypedArrayType::BigUint64) {
-          if (taPtr->type == TypedArrayType::BigUint64) {
-            taPtr->setBigUintElement(idx, bigint::toUint64Trunc(right.toBigInt()));
-          } else {
-            taPtr->setBigIntElement(idx, bigint::toInt64Trunc(right.toBigInt()));
-          }
-        } else {
-          taPtr->setElement(idx, right.toNumber());
+      size_t newLen = static_cast<size_t>(lenNum);
+      if (newLen < arrPtr->elementCount()) {
+        arrPtr->elements().resize(newLen);
+      } else if (newLen > arrPtr->elementCount()) {
+        if (!resizeDenseArray(arrPtr, newLen)) {
+          throwError(ErrorType::RangeError, "Array length exceeds implementation limit");
+          return Value(Undefined{});
         }
-        LIGHTJS_RETURN(right);
       }
-
-      if (expr.op == AssignmentExpr::Op::Assign) {
-        auto setterIt = taPtr->properties.find("__set_" + propName);
-        if (setterIt != taPtr->properties.end() && setterIt->second.isFunction()) {
+      return Value(static_cast<double>(arrPtr->elementCount()));
+    }
+    size_t idx = 0;
+    if (parseArrayIndex(propName, idx)) {
+      auto setterIt = arrPtr->properties.find("__set_" + propName);
+      auto getterIt = arrPtr->properties.find("__get_" + propName);
+      if (op == AssignmentExpr::Op::Assign) {
+        if (setterIt != arrPtr->properties.end() && setterIt->second.isFunction()) {
           callFunction(setterIt->second, {right}, obj);
-          if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
         } else {
-          taPtr->properties[propName] = right;
+          if (nonExtensible && idx >= arrPtr->elementCount()) {
+            if (strictMode_) {
+              throwError(ErrorType::TypeError, "Cannot add property '" + propName + "', object is not extensible");
+              return Value(Undefined{});
+            }
+            return right;
+          }
+          if (arrPtr->properties.count("__non_writable_" + propName)) {
+            if (strictMode_) {
+              throwError(ErrorType::TypeError, "Cannot assign to read only property '" + propName + "'");
+              return Value(Undefined{});
+            }
+            return right;
+          }
+          if (idx >= arrPtr->elementCount()) {
+            if (!growDenseArrayForIndex(arrPtr, idx, true)) {
+              throwError(ErrorType::RangeError, "Array index exceeds implementation limit");
+              return Value(Undefined{});
+            }
+          }
+          arrPtr->setElement(idx, right);
+          // Clear deleted/hole marker if re-assigning to a deleted index
+          arrPtr->properties.erase("__deleted_" + propName + "__");
+          arrPtr->properties.erase("__hole_" + propName + "__");
         }
-        LIGHTJS_RETURN(right);
+        return right;
       }
-
+      // Compound assignment: read current, compute, write back
       Value current = Value(Undefined{});
-      auto getterIt = taPtr->properties.find("__get_" + propName);
-      if (getterIt != taPtr->properties.end() && getterIt->second.isFunction()) {
+      if (getterIt != arrPtr->properties.end() && getterIt->second.isFunction()) {
         current = callFunction(getterIt->second, {}, obj);
-        if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-      } else if (auto it = taPtr->properties.find(propName); it != taPtr->properties.end()) {
-        current = it->second;
+        if (hasError()) return Value(Undefined{});
+      } else if (idx < arrPtr->elementCount()) {
+        current = arrPtr->element(idx);
       }
       Value result;
-      if (!computeCompoundValue(expr.op, current, right, result)) {
-        LIGHTJS_RETURN(Value(Undefined{}));
+      if (!computeCompoundAssignment(op, current, right, result)) {
+        return Value(Undefined{});
       }
-      auto setterIt = taPtr->properties.find("__set_" + propName);
-      if (setterIt != taPtr->properties.end() && setterIt->second.isFunction()) {
+      if (setterIt == arrPtr->properties.end() &&
+          arrPtr->properties.count("__non_writable_" + propName)) {
+        if (strictMode_) {
+          throwError(ErrorType::TypeError, "Cannot assign to read only property '" + propName + "'");
+          return Value(Undefined{});
+        }
+        return result;
+      }
+      // Only extend array if index is in bounds (compound assignment on
+      // out-of-bounds index matches arguments object behavior where length
+      // doesn't change)
+      if (setterIt != arrPtr->properties.end() && setterIt->second.isFunction()) {
         callFunction(setterIt->second, {result}, obj);
-        if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-      } else {
-        taPtr->properties[propName] = result;
+      } else if (idx < arrPtr->elementCount()) {
+        arrPtr->setElement(idx, result);
       }
-      LIGHTJS_RETURN(result);
+      return result;
     }
+    if (op == AssignmentExpr::Op::Assign) {
+      auto getterIt = arrPtr->properties.find("__get_" + propName);
+      auto setterIt = arrPtr->properties.find("__set_" + propName);
+      bool hasGetter = getterIt != arrPtr->properties.end() && getterIt->second.isFunction();
+      bool hasSetter = setterIt != arrPtr->properties.end() && setterIt->second.isFunction();
 
-    if (obj.isArrayBuffer()) {
-      auto bufferPtr = obj.getGC<ArrayBuffer>();
-      if (expr.op == AssignmentExpr::Op::Assign) {
-        auto setterIt = bufferPtr->properties.find("__set_" + propName);
-        if (setterIt != bufferPtr->properties.end() && setterIt->second.isFunction()) {
-          callFunction(setterIt->second, {right}, obj);
-          if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-        } else {
-          bufferPtr->properties[propName] = right;
+      // Accessor assignment should invoke the setter.
+      if (hasSetter) {
+        callFunction(setterIt->second, {right}, obj);
+        if (hasError()) return Value(Undefined{});
+        return right;
+      }
+      if (hasGetter && !hasSetter) {
+        if (strictMode_) {
+          throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
+          return Value(Undefined{});
+        }
+        return right;
+      }
+
+      // For frozen template objects and similar, arrays also use __non_writable_<name> markers.
+      if (arrPtr->properties.count("__non_writable_" + propName)) {
+        if (strictMode_) {
+          throwError(ErrorType::TypeError, "Cannot assign to read only property '" + propName + "'");
+          return Value(Undefined{});
+        }
+        return right;
+      }
+
+      if (nonExtensible && arrPtr->properties.find(propName) == arrPtr->properties.end()) {
+        if (strictMode_) {
+          throwError(ErrorType::TypeError, "Cannot add property '" + propName + "', object is not extensible");
+          return Value(Undefined{});
         }
-        LIGHTJS_RETURN(right);
+        return right;
       }
 
+      arrPtr->properties[propName] = right;
+    } else {
+      auto getterIt = arrPtr->properties.find("__get_" + propName);
+      auto setterIt = arrPtr->properties.find("__set_" + propName);
+      bool hasGetter = getterIt != arrPtr->properties.end() && getterIt->second.isFunction();
+      bool hasSetter = setterIt != arrPtr->properties.end() && setterIt->second.isFunction();
+
       Value current = Value(Undefined{});
-      auto getterIt = bufferPtr->properties.find("__get_" + propName);
-      if (getterIt != bufferPtr->properties.end() && getterIt->second.isFunction()) {
+      if (hasGetter) {
         current = callFunction(getterIt->second, {}, obj);
-        if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-      } else if (auto it = bufferPtr->properties.find(propName); it != bufferPtr->properties.end()) {
+        if (hasError()) return Value(Undefined{});
+      } else if (auto it = arrPtr->properties.find(propName); it != arrPtr->properties.end()) {
         current = it->second;
       }
       Value result;
-      if (!computeCompoundValue(expr.op, current, right, result)) {
-        LIGHTJS_RETURN(Value(Undefined{}));
+      if (!computeCompoundAssignment(op, current, right, result)) {
+        return Value(Undefined{});
       }
-      auto setterIt = bufferPtr->properties.find("__set_" + propName);
-      if (setterIt != bufferPtr->properties.end() && setterIt->second.isFunction()) {
+
+      if (hasGetter && !hasSetter) {
+        if (strictMode_) {
+          throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
+          return Value(Undefined{});
+        }
+        return result;
+      }
+
+      if (hasSetter) {
         callFunction(setterIt->second, {result}, obj);
-        if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-      } else {
-        bufferPtr->properties[propName] = result;
+        if (hasError()) return Value(Undefined{});
+        return result;
       }
-      LIGHTJS_RETURN(result);
+
+      if (arrPtr->properties.count("__non_writable_" + propName)) {
+        if (strictMode_) {
+          throwError(ErrorType::TypeError, "Cannot assign to read only property '" + propName + "'");
+          return Value(Undefined{});
+        }
+        return result;
+      }
+
+      if (nonExtensible && arrPtr->properties.find(propName) == arrPtr->properties.end()) {
+        if (strictMode_) {
+          throwError(ErrorType::TypeError, "Cannot add property '" + propName + "', object is not extensible");
+          return Value(Undefined{});
+        }
+        return result;
+      }
+
+      arrPtr->properties[propName] = result;
     }
+    return arrPtr->properties[propName];
+  }
 
-    if (obj.isDataView()) {
-      auto viewPtr = obj.getGC<DataView>();
-      if (expr.op == AssignmentExpr::Op::Assign) {
-        auto setterIt = viewPtr->properties.find("__set_" + propName);
-        if (setterIt != viewPtr->properties.end() && setterIt->second.isFunction()) {
-          callFunction(setterIt->second, {right}, obj);
-          if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
+  if (obj.isTypedArray()) {
+    auto taPtr = obj.getGC<TypedArray>();
+    size_t idx = 0;
+    if (parseArrayIndex(propName, idx)) {
+      if (taPtr->type == TypedArrayType::BigInt64 || taPtr->type == TypedArrayType::BigUint64) {
+        if (taPtr->type == TypedArrayType::BigUint64) {
+          taPtr->setBigUintElement(idx, bigint::toUint64Trunc(right.toBigInt()));
         } else {
-          viewPtr->properties[propName] = right;
+          taPtr->setBigIntElement(idx, bigint::toInt64Trunc(right.toBigInt()));
         }
-        LIGHTJS_RETURN(right);
+      } else {
+        taPtr->setElement(idx, right.toNumber());
       }
+      return right;
+    }
 
-      Value current = Value(Undefined{});
-      auto getterIt = viewPtr->properties.find("__get_" + propName);
-      if (getterIt != viewPtr->properties.end() && getterIt->second.isFunction()) {
-        current = callFunction(getterIt->second, {}, obj);
-        if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-      } else if (auto it = viewPtr->properties.find(propName); it != viewPtr->properties.end()) {
-        current = it->second;
+    if (op == AssignmentExpr::Op::Assign) {
+      auto setterIt = taPtr->properties.find("__set_" + propName);
+      if (setterIt != taPtr->properties.end() && setterIt->second.isFunction()) {
+        callFunction(setterIt->second, {right}, obj);
+        if (hasError()) return Value(Undefined{});
+      } else {
+        taPtr->properties[propName] = right;
       }
-      Value result;
-      if (!computeCompoundValue(expr.op, current, right, result)) {
-        LIGHTJS_RETURN(Value(Undefined{}));
+      return right;
+    }
+
+    Value current = Value(Undefined{});
+    auto getterIt = taPtr->properties.find("__get_" + propName);
+    if (getterIt != taPtr->properties.end() && getterIt->second.isFunction()) {
+      current = callFunction(getterIt->second, {}, obj);
+      if (hasError()) return Value(Undefined{});
+    } else if (auto it = taPtr->properties.find(propName); it != taPtr->properties.end()) {
+      current = it->second;
+    }
+    Value result;
+    if (!computeCompoundAssignment(op, current, right, result)) {
+      return Value(Undefined{});
+    }
+    auto setterIt = taPtr->properties.find("__set_" + propName);
+    if (setterIt != taPtr->properties.end() && setterIt->second.isFunction()) {
+      callFunction(setterIt->second, {result}, obj);
+      if (hasError()) return Value(Undefined{});
+    } else {
+      taPtr->properties[propName] = result;
+    }
+    return result;
+  }
+
+  if (obj.isArrayBuffer()) {
+    auto bufferPtr = obj.getGC<ArrayBuffer>();
+    if (op == AssignmentExpr::Op::Assign) {
+      auto setterIt = bufferPtr->properties.find("__set_" + propName);
+      if (setterIt != bufferPtr->properties.end() && setterIt->second.isFunction()) {
+        callFunction(setterIt->second, {right}, obj);
+        if (hasError()) return Value(Undefined{});
+      } else {
+        bufferPtr->properties[propName] = right;
       }
+      return right;
+    }
+
+    Value current = Value(Undefined{});
+    auto getterIt = bufferPtr->properties.find("__get_" + propName);
+    if (getterIt != bufferPtr->properties.end() && getterIt->second.isFunction()) {
+      current = callFunction(getterIt->second, {}, obj);
+      if (hasError()) return Value(Undefined{});
+    } else if (auto it = bufferPtr->properties.find(propName); it != bufferPtr->properties.end()) {
+      current = it->second;
+    }
+    Value result;
+    if (!computeCompoundAssignment(op, current, right, result)) {
+      return Value(Undefined{});
+    }
+    auto setterIt = bufferPtr->properties.find("__set_" + propName);
+    if (setterIt != bufferPtr->properties.end() && setterIt->second.isFunction()) {
+      callFunction(setterIt->second, {result}, obj);
+      if (hasError()) return Value(Undefined{});
+    } else {
+      bufferPtr->properties[propName] = result;
+    }
+    return result;
+  }
+
+  if (obj.isDataView()) {
+    auto viewPtr = obj.getGC<DataView>();
+    if (op == AssignmentExpr::Op::Assign) {
       auto setterIt = viewPtr->properties.find("__set_" + propName);
       if (setterIt != viewPtr->properties.end() && setterIt->second.isFunction()) {
-        callFunction(setterIt->second, {result}, obj);
-        if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
+        callFunction(setterIt->second, {right}, obj);
+        if (hasError()) return Value(Undefined{});
       } else {
-        viewPtr->properties[propName] = result;
+        viewPtr->properties[propName] = right;
       }
-      LIGHTJS_RETURN(result);
+      return right;
     }
 
-    if (obj.isRegex()) {
-      auto regexPtr = obj.getGC<Regex>();
-      if (expr.op == AssignmentExpr::Op::Assign) {
-        regexPtr->properties[propName] = right;
-      } else {
-        Value current = regexPtr->properties[propName];
-        Value result;
-        if (!computeCompoundValue(expr.op, current, right, result)) {
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
-        regexPtr->properties[propName] = result;
-        LIGHTJS_RETURN(result);
-      }
-      LIGHTJS_RETURN(right);
+    Value current = Value(Undefined{});
+    auto getterIt = viewPtr->properties.find("__get_" + propName);
+    if (getterIt != viewPtr->properties.end() && getterIt->second.isFunction()) {
+      current = callFunction(getterIt->second, {}, obj);
+      if (hasError()) return Value(Undefined{});
+    } else if (auto it = viewPtr->properties.find(propName); it != viewPtr->properties.end()) {
+      current = it->second;
+    }
+    Value result;
+    if (!computeCompoundAssignment(op, current, right, result)) {
+      return Value(Undefined{});
     }
+    auto setterIt = viewPtr->properties.find("__set_" + propName);
+    if (setterIt != viewPtr->properties.end() && setterIt->second.isFunction()) {
+      callFunction(setterIt->second, {result}, obj);
+      if (hasError()) return Value(Undefined{});
+    } else {
+      viewPtr->properties[propName] = result;
+    }
+    return result;
+  }
 
-    if (obj.isClass()) {
-      auto clsPtr = obj.getGC<Class>();
-      // Handle private static field assignment (#name)
-      if (member->privateIdentifier) {
-        GCPtr<Class> ownerClass = activePrivateOwnerClass_ ? activePrivateOwnerClass_ : clsPtr;
-        if (!ownerClass || ownerClass.get() != clsPtr.get()) {
-          throwError(ErrorType::TypeError,
-                    "Cannot write private member " + propName +
-                        " to an object whose class did not declare it");
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
-        std::string mangledName = privateStorageKey(ownerClass, propName);
-        auto getterIt = clsPtr->properties.find("__get_" + mangledName);
-        auto setterIt = clsPtr->properties.find("__set_" + mangledName);
-        bool hasGetter = getterIt != clsPtr->properties.end() && getterIt->second.isFunction();
-        bool hasSetter = setterIt != clsPtr->properties.end() && setterIt->second.isFunction();
-        bool isMethod = clsPtr->staticMethods.count(mangledName) > 0;
-        bool hasPrivateDecl =
-            clsPtr->properties.count(mangledName) > 0 ||
-            clsPtr->properties.count("__get_" + mangledName) > 0 ||
-            clsPtr->properties.count("__set_" + mangledName) > 0 ||
-            isMethod;
-        if (!hasPrivateDecl) {
-          throwError(ErrorType::TypeError,
-                    "Cannot write private member " + propName +
-                        " to an object whose class did not declare it");
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
-        if (isMethod) {
-          throwError(ErrorType::TypeError, "Cannot assign to private method " + propName);
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
+  if (obj.isRegex()) {
+    auto regexPtr = obj.getGC<Regex>();
+    if (op == AssignmentExpr::Op::Assign) {
+      regexPtr->properties[propName] = right;
+    } else {
+      Value current = regexPtr->properties[propName];
+      Value result;
+      if (!computeCompoundAssignment(op, current, right, result)) {
+        return Value(Undefined{});
+      }
+      regexPtr->properties[propName] = result;
+      return result;
+    }
+    return right;
+  }
 
-        Value current(Undefined{});
-        if (hasGetter) {
-          current = callFunction(getterIt->second, {}, obj);
-          if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-        } else if (auto it = clsPtr->properties.find(mangledName); it != clsPtr->properties.end()) {
-          current = it->second;
-        }
+  if (obj.isClass()) {
+    auto clsPtr = obj.getGC<Class>();
+    // Handle private static field assignment (#name)
+    if (privateIdentifier) {
+      GCPtr<Class> ownerClass = activePrivateOwnerClass_ ? activePrivateOwnerClass_ : clsPtr;
+      if (!ownerClass || ownerClass.get() != clsPtr.get()) {
+        throwError(ErrorType::TypeError,
+                  "Cannot write private member " + propName +
+                      " to an object whose class did not declare it");
+        return Value(Undefined{});
+      }
+      std::string mangledName = privateStorageKey(ownerClass, propName);
+      auto getterIt = clsPtr->properties.find("__get_" + mangledName);
+      auto setterIt = clsPtr->properties.find("__set_" + mangledName);
+      bool hasGetter = getterIt != clsPtr->properties.end() && getterIt->second.isFunction();
+      bool hasSetter = setterIt != clsPtr->properties.end() && setterIt->second.isFunction();
+      bool isMethod = clsPtr->staticMethods.count(mangledName) > 0;
+      bool hasPrivateDecl =
+          clsPtr->properties.count(mangledName) > 0 ||
+          clsPtr->properties.count("__get_" + mangledName) > 0 ||
+          clsPtr->properties.count("__set_" + mangledName) > 0 ||
+          isMethod;
+      if (!hasPrivateDecl) {
+        throwError(ErrorType::TypeError,
+                  "Cannot write private member " + propName +
+                      " to an object whose class did not declare it");
+        return Value(Undefined{});
+      }
+      if (isMethod) {
+        throwError(ErrorType::TypeError, "Cannot assign to private method " + propName);
+        return Value(Undefined{});
+      }
 
-        if (expr.op == AssignmentExpr::Op::Assign) {
-          if (hasGetter && !hasSetter) {
-            throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          if (hasSetter) {
-            callFunction(setterIt->second, {right}, obj);
-            if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-          } else {
-            clsPtr->properties[mangledName] = right;
-          }
-          LIGHTJS_RETURN(right);
-        }
+      Value current(Undefined{});
+      if (hasGetter) {
+        current = callFunction(getterIt->second, {}, obj);
+        if (hasError()) return Value(Undefined{});
+      } else if (auto it = clsPtr->properties.find(mangledName); it != clsPtr->properties.end()) {
+        current = it->second;
+      }
 
-        Value result;
-        if (!computeCompoundValue(expr.op, current, right, result)) {
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
+      if (op == AssignmentExpr::Op::Assign) {
         if (hasGetter && !hasSetter) {
           throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
-          LIGHTJS_RETURN(Value(Undefined{}));
+          return Value(Undefined{});
         }
         if (hasSetter) {
-          callFunction(setterIt->second, {result}, obj);
-          if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
+          callFunction(setterIt->second, {right}, obj);
+          if (hasError()) return Value(Undefined{});
         } else {
-          clsPtr->properties[mangledName] = result;
+          clsPtr->properties[mangledName] = right;
         }
-        LIGHTJS_RETURN(result);
+        return right;
+      }
+
+      Value result;
+      if (!computeCompoundAssignment(op, current, right, result)) {
+        return Value(Undefined{});
+      }
+      if (hasGetter && !hasSetter) {
+        throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
+        return Value(Undefined{});
+      }
+      if (hasSetter) {
+        callFunction(setterIt->second, {result}, obj);
+        if (hasError()) return Value(Undefined{});
+      } else {
+        clsPtr->properties[mangledName] = result;
       }
-      // Check __non_writable_ marker
-      if (clsPtr->properties.count("__non_writable_" + propName)) {
-        if (strictMode_) {
-          throwError(ErrorType::TypeError, "Cannot assign to read only property '" + propName + "'");
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
-        LIGHTJS_RETURN(right);
+      return result;
+    }
+    // Check __non_writable_ marker
+    if (clsPtr->properties.count("__non_writable_" + propName)) {
+      if (strictMode_) {
+        throwError(ErrorType::TypeError, "Cannot assign to read only property '" + propName + "'");
+        return Value(Undefined{});
       }
-      if (expr.op == AssignmentExpr::Op::Assign) {
-        auto setterIt = clsPtr->properties.find("__set_" + propName);
-        if (setterIt != clsPtr->properties.end() && setterIt->second.isFunction()) {
-          callFunction(setterIt->second, {right}, obj);
-          if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-          LIGHTJS_RETURN(right);
-        }
-        // Inherited accessors (e.g. %FunctionPrototype%.caller) should run the
-        // prototype setter instead of creating an own data property.
-        if (clsPtr->properties.count(propName) == 0) {
-          auto protoIt = clsPtr->properties.find("__proto__");
-          if (protoIt != clsPtr->properties.end()) {
-            Value protoVal = protoIt->second;
-            int depth = 0;
-            while (depth < 50) {
-              if (protoVal.isObject()) {
-                auto proto = protoVal.getGC<Object>();
-                auto protoSetterIt = proto->properties.find("__set_" + propName);
-                if (protoSetterIt != proto->properties.end() && protoSetterIt->second.isFunction()) {
-                  callFunction(protoSetterIt->second, {right}, obj);
-                  if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-                  LIGHTJS_RETURN(right);
-                }
-                auto nextProto = proto->properties.find("__proto__");
-                if (nextProto == proto->properties.end()) break;
-                protoVal = nextProto->second;
-              } else if (protoVal.isClass()) {
-                auto protoCls = protoVal.getGC<Class>();
-                auto protoSetterIt = protoCls->properties.find("__set_" + propName);
-                if (protoSetterIt != protoCls->properties.end() && protoSetterIt->second.isFunction()) {
-                  callFunction(protoSetterIt->second, {right}, obj);
-                  if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-                  LIGHTJS_RETURN(right);
-                }
-                auto nextProto = protoCls->properties.find("__proto__");
-                if (nextProto == protoCls->properties.end()) break;
-                protoVal = nextProto->second;
-              } else if (protoVal.isFunction()) {
-                auto protoFn = protoVal.getGC<Function>();
-                auto protoSetterIt = protoFn->properties.find("__set_" + propName);
-                if (protoSetterIt != protoFn->properties.end() && protoSetterIt->second.isFunction()) {
-                  callFunction(protoSetterIt->second, {right}, obj);
-                  if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-                  LIGHTJS_RETURN(right);
-                }
-                auto nextProto = protoFn->properties.find("__proto__");
-                if (nextProto == protoFn->properties.end()) break;
-                protoVal = nextProto->second;
-              } else {
-                break;
+      return right;
+    }
+    if (op == AssignmentExpr::Op::Assign) {
+      auto setterIt = clsPtr->properties.find("__set_" + propName);
+      if (setterIt != clsPtr->properties.end() && setterIt->second.isFunction()) {
+        callFunction(setterIt->second, {right}, obj);
+        if (hasError()) return Value(Undefined{});
+        return right;
+      }
+      // Inherited accessors (e.g. %FunctionPrototype%.caller) should run the
+      // prototype setter instead of creating an own data property.
+      if (clsPtr->properties.count(propName) == 0) {
+        auto protoIt = clsPtr->properties.find("__proto__");
+        if (protoIt != clsPtr->properties.end()) {
+          Value protoVal = protoIt->second;
+          int depth = 0;
+          while (depth < 50) {
+            if (protoVal.isObject()) {
+              auto proto = protoVal.getGC<Object>();
+              auto protoSetterIt = proto->properties.find("__set_" + propName);
+              if (protoSetterIt != proto->properties.end() && protoSetterIt->second.isFunction()) {
+                callFunction(protoSetterIt->second, {right}, obj);
+                if (hasError()) return Value(Undefined{});
+                return right;
+              }
+              auto nextProto = proto->properties.find("__proto__");
+              if (nextProto == proto->properties.end()) break;
+              protoVal = nextProto->second;
+            } else if (protoVal.isClass()) {
+              auto protoCls = protoVal.getGC<Class>();
+              auto protoSetterIt = protoCls->properties.find("__set_" + propName);
+              if (protoSetterIt != protoCls->properties.end() && protoSetterIt->second.isFunction()) {
+                callFunction(protoSetterIt->second, {right}, obj);
+                if (hasError()) return Value(Undefined{});
+                return right;
+              }
+              auto nextProto = protoCls->properties.find("__proto__");
+              if (nextProto == protoCls->properties.end()) break;
+              protoVal = nextProto->second;
+            } else if (protoVal.isFunction()) {
+              auto protoFn = protoVal.getGC<Function>();
+              auto protoSetterIt = protoFn->properties.find("__set_" + propName);
+              if (protoSetterIt != protoFn->properties.end() && protoSetterIt->second.isFunction()) {
+                callFunction(protoSetterIt->second, {right}, obj);
+                if (hasError()) return Value(Undefined{});
+                return right;
               }
-              depth++;
+              auto nextProto = protoFn->properties.find("__proto__");
+              if (nextProto == protoFn->properties.end()) break;
+              protoVal = nextProto->second;
+            } else {
+              break;
             }
+            depth++;
           }
         }
-        clsPtr->properties[propName] = right;
-      } else {
-        auto getterIt = clsPtr->properties.find("__get_" + propName);
-        auto setterIt = clsPtr->properties.find("__set_" + propName);
-        bool hasGetter = getterIt != clsPtr->properties.end() && getterIt->second.isFunction();
-        bool hasSetter = setterIt != clsPtr->properties.end() && setterIt->second.isFunction();
-        Value current(Undefined{});
-        if (hasGetter) {
-          current = callFunction(getterIt->second, {}, obj);
-          if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-        } else if (auto it = clsPtr->properties.find(propName); it != clsPtr->properties.end()) {
-          current = it->second;
-        }
-        Value result;
-        if (!computeCompoundValue(expr.op, current, right, result)) {
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
-        if (hasGetter && !hasSetter) {
-          if (strictMode_) {
-            throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-          LIGHTJS_RETURN(result);
-        }
-        if (hasSetter) {
-          callFunction(setterIt->second, {result}, obj);
-          if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-          LIGHTJS_RETURN(result);
+      }
+      clsPtr->properties[propName] = right;
+    } else {
+      auto getterIt = clsPtr->properties.find("__get_" + propName);
+      auto setterIt = clsPtr->properties.find("__set_" + propName);
+      bool hasGetter = getterIt != clsPtr->properties.end() && getterIt->second.isFunction();
+      bool hasSetter = setterIt != clsPtr->properties.end() && setterIt->second.isFunction();
+      Value current(Undefined{});
+      if (hasGetter) {
+        current = callFunction(getterIt->second, {}, obj);
+        if (hasError()) return Value(Undefined{});
+      } else if (auto it = clsPtr->properties.find(propName); it != clsPtr->properties.end()) {
+        current = it->second;
+      }
+      Value result;
+      if (!computeCompoundAssignment(op, current, right, result)) {
+        return Value(Undefined{});
+      }
+      if (hasGetter && !hasSetter) {
+        if (strictMode_) {
+          throwError(ErrorType::TypeError, "Cannot set property " + propName + " which has only a getter");
+          return Value(Undefined{});
         }
-        clsPtr->properties[propName] = result;
+        return result;
+      }
+      if (hasSetter) {
+        callFunction(setterIt->second, {result}, obj);
+        if (hasError()) return Value(Undefined{});
+        return result;
       }
-      LIGHTJS_RETURN(clsPtr->properties[propName]);
+      clsPtr->properties[propName] = result;
     }
+    return clsPtr->properties[propName];
   }
 
-  LIGHTJS_RETURN(right);
+  return right;
 }
 
-Task Interpreter::evaluateUpdate(const UpdateExpr& expr) {
-  auto applyNumericUpdate = [&](const Value& currentValue,
-                                Value& oldValue,
-                                Value& newValue) -> bool {
-    Value numeric = isObjectLike(currentValue) ? toPrimitiveValue(currentValue, false) : currentValue;
-    if (hasError()) {
-      return false;
-    }
-    if (numeric.isSymbol()) {
-      throwError(ErrorType::TypeError, "Cannot convert Symbol to number");
-      return false;
-    }
-    if (numeric.isBigInt()) {
-      auto oldBigInt = numeric.toBigInt();
-      auto nextBigInt = oldBigInt;
-      if (expr.op == UpdateExpr::Op::Increment) {
-        nextBigInt += 1;
-      } else {
-        nextBigInt -= 1;
-      }
-      oldValue = Value(BigInt(oldBigInt));
-      newValue = Value(BigInt(nextBigInt));
-      return true;
-    }
+bool Interpreter::updateNumericValue(UpdateExpr::Op op,
+                                     const Value& currentValue,
+                                     Value& oldValue,
+                                     Value& newValue) {
+  // Int32 counters stay int32 until they overflow.
+  if (currentValue.isInt32()) {
+    int64_t next = static_cast<int64_t>(currentValue.asInt32()) +
+                   (op == UpdateExpr::Op::Increment ? 1 : -1);
+    oldValue = currentValue;
+    newValue = (next >= INT32_MIN && next <= INT32_MAX) ? Value(static_cast<int32_t>(next))
+                                                       : Value(static_cast<double>(next));
+    return true;
+  }
 
-    double oldNumber = numeric.toNumber();
-    double nextNumber =
-      (expr.op == UpdateExpr::Op::Increment) ? oldNumber + 1.0 : oldNumber - 1.0;
-    oldValue = Value(oldNumber);
-    newValue = Value(nextNumber);
+  Value numeric = isObjectLike(currentValue) ? toPrimitiveValue(currentValue, false) : currentValue;
+  if (hasError()) {
+    return false;
+  }
+  if (numeric.isSymbol()) {
+    throwError(ErrorType::TypeError, "Cannot convert Symbol to number");
+    return false;
+  }
+  if (numeric.isBigInt()) {
+    auto oldBigInt = numeric.toBigInt();
+    auto nextBigInt = oldBigInt;
+    if (op == UpdateExpr::Op::Increment) {
+      nextBigInt += 1;
+    } else {
+      nextBigInt -= 1;
+    }
+    oldValue = Value(BigInt(oldBigInt));
+    newValue = Value(BigInt(nextBigInt));
     return true;
-  };
+  }
+
+  double oldNumber = numeric.toNumber();
+  double nextNumber =
+    (op == UpdateExpr::Op::Increment) ? oldNumber + 1.0 : oldNumber - 1.0;
+  oldValue = Value(oldNumber);
+  newValue = Value(nextNumber);
+  return true;
+}
 
+Task Interpreter::evaluateUpdate(const UpdateExpr& expr) {
   if (auto* id = std::get_if<Identifier>(&expr.argument->node)) {
     // Check const before update
     if (env_->isConst(id->name)) {
@@ -7348,7 +7603,7 @@ Task Interpreter::evaluateUpdate(const UpdateExpr& expr) {
       auto val = env_->get(id->name);
       Value currentVal = val.value_or(Value(Undefined{}));
       Value oldValue, newValue;
-      applyNumericUpdate(currentVal, oldValue, newValue);
+      updateNumericValue(expr.op, currentVal, oldValue, newValue);
       LIGHTJS_RETURN(expr.prefix ? newValue : oldValue);
     }
 
@@ -7394,7 +7649,7 @@ Task Interpreter::evaluateUpdate(const UpdateExpr& expr) {
 
     Value oldValue;
     Value newValue;
-    if (!applyNumericUpdate(currentValue, oldValue, newValue)) {
+    if (!updateNumericValue(expr.op, currentValue, oldValue, newValue)) {
       LIGHTJS_RETURN(Value(Undefined{}));
     }
 
@@ -7538,7 +7793,7 @@ Task Interpreter::evaluateUpdate(const UpdateExpr& expr) {
 
       Value oldValue;
       Value newValue;
-      if (!applyNumericUpdate(currentValue, oldValue, newValue)) {
+      if (!updateNumericValue(expr.op, currentValue, oldValue, newValue)) {
         LIGHTJS_RETURN(Value(Undefined{}));
       }
 
@@ -7586,7 +7841,7 @@ Task Interpreter::evaluateUpdate(const UpdateExpr& expr) {
 
       Value oldValue;
       Value newValue;
-      if (!applyNumericUpdate(currentValue, oldValue, newValue)) {
+      if (!updateNumericValue(expr.op, currentValue, oldValue, newValue)) {
         LIGHTJS_RETURN(Value(Undefined{}));
       }
 
@@ -7623,7 +7878,7 @@ Task Interpreter::evaluateUpdate(const UpdateExpr& expr) {
 
       Value oldValue;
       Value newValue;
-      if (!applyNumericUpdate(currentValue, oldValue, newValue)) {
+      if (!updateNumericValue(expr.op, currentValue, oldValue, newValue)) {
         LIGHTJS_RETURN(Value(Undefined{}));
       }
 
@@ -7657,13 +7912,13 @@ Task Interpreter::evaluateUpdate(const UpdateExpr& expr) {
           if (hasError()) {
             LIGHTJS_RETURN(Value(Undefined{}));
           }
-        } else if (index < arrPtr->elements.size()) {
-          currentValue = arrPtr->elements[index];
+        } else if (index < arrPtr->elementCount()) {
+          currentValue = arrPtr->element(index);
         }
 
         Value oldValue;
         Value newValue;
-        if (!applyNumericUpdate(currentValue, oldValue, newValue)) {
+        if (!updateNumericValue(expr.op, currentValue, oldValue, newValue)) {
           LIGHTJS_RETURN(Value(Undefined{}));
         }
 
@@ -7673,13 +7928,13 @@ Task Interpreter::evaluateUpdate(const UpdateExpr& expr) {
             LIGHTJS_RETURN(Value(Undefined{}));
           }
         } else {
-          if (index >= arrPtr->elements.size()) {
+          if (index >= arrPtr->elementCount()) {
             if (!growDenseArrayForIndex(arrPtr, index, true)) {
               throwError(ErrorType::RangeError, "Array index exceeds implementation limit");
               LIGHTJS_RETURN(Value(Undefined{}));
             }
           }
-          arrPtr->elements[index] = newValue;
+          arrPtr->setElement(index, newValue);
           arrPtr->properties.erase("__hole_" + std::to_string(index) + "__");
         }
         LIGHTJS_RETURN(expr.prefix ? newValue : oldValue);
@@ -7699,7 +7954,7 @@ Task Interpreter::evaluateUpdate(const UpdateExpr& expr) {
 
       Value oldValue;
       Value newValue;
-      if (!applyNumericUpdate(currentValue, oldValue, newValue)) {
+      if (!updateNumericValue(expr.op, currentValue, oldValue, newValue)) {
         LIGHTJS_RETURN(Value(Undefined{}));
       }
       if (setterIt != arrPtr->properties.end() && setterIt->second.isFunction()) {
@@ -7732,7 +7987,7 @@ Task Interpreter::evaluateUpdate(const UpdateExpr& expr) {
       }
       Value oldValue;
       Value newValue;
-      if (!applyNumericUpdate(currentValue, oldValue, newValue)) {
+      if (!updateNumericValue(expr.op, currentValue, oldValue, newValue)) {
         LIGHTJS_RETURN(Value(Undefined{}));
       }
       if (taPtr->type == TypedArrayType::BigInt64 ||
@@ -7795,6 +8050,7 @@ Task Interpreter::evaluateCall(const CallExpr& expr) {
 
         auto func = std::get<GCPtr<Function>>(importFunc->data);
 	  if (func->isNative) {
+          GlobalInterpreterScope interpreterScope(this);
           LIGHTJS_RETURN(func->nativeFunc(args));
         }
       }
@@ -7825,60 +8081,10 @@ Task Interpreter::evaluateCall(const CallExpr& expr) {
     }
   } else {
     if (auto* id = std::get_if<Identifier>(&expr.callee->node)) {
-      auto withBaseValue = env_->resolveWithScopeValue(id->name);
-      if (withBaseValue) {
-        auto withValue = env_->getWithScopeBindingValue(*withBaseValue, id->name, strictMode_);
-        if (flow_.type != ControlFlow::Type::None) {
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
-        if (withValue.has_value()) {
-          callee = *withValue;
-          thisValue = *withBaseValue;
-        } else {
-          throwError(ErrorType::ReferenceError, "'" + id->name + "' is not defined");
-          LIGHTJS_RETURN(Value(Undefined{}));
-        }
-      } else {
-        auto val = env_->getIgnoringWith(id->name);
-        if (val.has_value()) {
-          if (val->isModuleBinding()) {
-            const auto& binding = std::get<ModuleBinding>(val->data);
-            auto module = binding.module.lock();
-            if (!module) {
-              throwError(ErrorType::ReferenceError,
-                         "Cannot access '" + id->name + "' before initialization");
-              LIGHTJS_RETURN(Value(Undefined{}));
-            }
-            auto exportValue = module->getExport(binding.exportName);
-            if (!exportValue) {
-              throwError(ErrorType::ReferenceError,
-                         "Cannot access '" + id->name + "' before initialization");
-              LIGHTJS_RETURN(Value(Undefined{}));
-            }
-            callee = *exportValue;
-          } else {
-            callee = *val;
-          }
-        } else {
-          bool foundNamedExpression = false;
-          for (auto it = activeNamedExpressionStack_.rbegin();
-               it != activeNamedExpressionStack_.rend();
-               ++it) {
-            const auto& fn = *it;
-            auto nameIt = fn->properties.find("name");
-            if (nameIt != fn->properties.end() &&
-                nameIt->second.isString() &&
-                nameIt->second.toString() == id->name) {
-              callee = Value(fn);
-              foundNamedExpression = true;
-              break;
-            }
-          }
-          if (!foundNamedExpression) {
-            throwError(ErrorType::ReferenceError, "'" + id->name + "' is not defined");
-            LIGHTJS_RETURN(Value(Undefined{}));
-          }
-        }
+      if (const Value* bound = staticBinding(*id)) {
+        callee = *bound;
+      } else if (!lookupCallee(id->name, callee, thisValue)) {
+        LIGHTJS_RETURN(Value(Undefined{}));
       }
     } else {
       { auto _t = evaluate(*expr.callee); LIGHTJS_RUN_TASK(_t, callee); }
@@ -8061,6 +8267,72 @@ Task Interpreter::evaluateCall(const CallExpr& expr) {
     }
   }
 
+  LIGHTJS_RETURN(callValue(callee, args, thisValue, isDirectEvalCall));
+}
+
+bool Interpreter::lookupCallee(const std::string& name, Value& callee, Value& thisValue) {
+  auto withBaseValue = env_->resolveWithScopeValue(name);
+  if (withBaseValue) {
+    auto withValue = env_->getWithScopeBindingValue(*withBaseValue, name, strictMode_);
+    if (flow_.type != ControlFlow::Type::None) {
+      return false;
+    }
+    if (withValue.has_value()) {
+      callee = *withValue;
+      thisValue = *withBaseValue;
+    } else {
+      throwError(ErrorType::ReferenceError, "'" + name + "' is not defined");
+      return false;
+    }
+  } else {
+    auto val = env_->getIgnoringWith(name);
+    if (val.has_value()) {
+      if (val->isModuleBinding()) {
+        const auto& binding = val->asModuleBinding();
+        auto module = binding.module.lock();
+        if (!module) {
+          throwError(ErrorType::ReferenceError,
+                     "Cannot access '" + name + "' before initialization");
+          return false;
+        }
+        auto exportValue = module->getExport(binding.exportName);
+        if (!exportValue) {
+          throwError(ErrorType::ReferenceError,
+                     "Cannot access '" + name + "' before initialization");
+          return false;
+        }
+        callee = *exportValue;
+      } else {
+        callee = *val;
+      }
+    } else {
+      bool foundNamedExpression = false;
+      for (auto it = activeNamedExpressionStack_.rbegin();
+           it != activeNamedExpressionStack_.rend();
+           ++it) {
+        const auto& fn = *it;
+        auto nameIt = fn->properties.find("name");
+        if (nameIt != fn->properties.end() &&
+            nameIt->second.isString() &&
+            nameIt->second.toString() == name) {
+          callee = Value(fn);
+          foundNamedExpression = true;
+          break;
+        }
+      }
+      if (!foundNamedExpression) {
+        throwError(ErrorType::ReferenceError, "'" + name + "' is not defined");
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+Value Interpreter::callValue(const Value& callee,
+                             const std::vector<Value>& args,
+                             const Value& thisValue,
+                             bool isDirectEvalCall) {
   // Handle Proxy apply trap for callable proxies
   if (callee.isProxy()) {
     auto proxyPtr = callee.getGC<Proxy>();
@@ -8071,19 +8343,19 @@ Task Interpreter::evaluateCall(const CallExpr& expr) {
         auto trap = trapIt->second.getGC<Function>();
         // Create args array
         auto argsArray = GarbageCollector::makeGC<Array>();
-        argsArray->elements = args;
+        argsArray->assignElements(args);
         // Call apply trap: handler.apply(target, thisArg, argumentsList)
         std::vector<Value> trapArgs = {*proxyPtr->target, thisValue, Value(argsArray)};
         if (trap->isNative) {
-          LIGHTJS_RETURN(trap->nativeFunc(trapArgs));
+          return trap->nativeFunc(trapArgs);
         } else {
-          LIGHTJS_RETURN(invokeFunction(trap, trapArgs, Value(Undefined{})));
+          return invokeFunction(trap, trapArgs, Value(Undefined{}));
         }
       }
     }
     // No apply trap - call the target directly if it's a function
     if (proxyPtr->target && proxyPtr->target->isFunction()) {
-      LIGHTJS_RETURN(callFunction(*proxyPtr->target, args, thisValue));
+      return callFunction(*proxyPtr->target, args, thisValue);
     }
   }
 
@@ -8092,7 +8364,7 @@ Task Interpreter::evaluateCall(const CallExpr& expr) {
     pendingDirectEvalCall_ = isDirectEvalCall;
     Value callResult = callFunction(callee, args, thisValue);
     pendingDirectEvalCall_ = prevPendingDirectEvalCall;
-    LIGHTJS_RETURN(callResult);
+    return callResult;
   }
 
   // Some built-ins are represented as wrapper objects with a callable constructor.
@@ -8105,14 +8377,14 @@ Task Interpreter::evaluateCall(const CallExpr& expr) {
     if (isCallableWrapper) {
       auto ctorIt = objPtr->properties.find("constructor");
       if (ctorIt != objPtr->properties.end() && ctorIt->second.isFunction()) {
-        LIGHTJS_RETURN(callFunction(ctorIt->second, args, thisValue));
+        return callFunction(ctorIt->second, args, thisValue);
       }
     }
   }
 
   // Throw TypeError if trying to call a non-function
   throwError(ErrorType::TypeError, callee.toString() + " is not a function");
-  LIGHTJS_RETURN(Value(Undefined{}));
+  return Value(Undefined{});
 }
 
 Task Interpreter::evaluateMember(const MemberExpr& expr) {
@@ -8161,32 +8433,233 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         LIGHTJS_RETURN(Value(Undefined{}));
       }
     }
-    if (key.isNumber()) {
-      double numericKey = key.toNumber();
-      if (std::isfinite(numericKey) && numericKey >= 0.0 && numericKey <= 4294967294.0) {
-        double integerKey = std::trunc(numericKey);
-        if (integerKey == numericKey) {
-          typedArrayNumericIndex = static_cast<size_t>(integerKey);
-        }
-      }
+    typedArrayNumericIndex = arrayIndexKey(key);
+    Value element;
+    if (typedArrayNumericIndex && !std::holds_alternative<SuperExpr>(expr.object->node) &&
+        getIndexedElement(obj, *typedArrayNumericIndex, element)) {
+      LIGHTJS_RETURN(element);
+    }
+    propName = toPropertyKeyString(key);
+  } else {
+    if (auto* id = std::get_if<Identifier>(&expr.property->node)) {
+      Value cached;
+      if (!expr.privateIdentifier && !std::holds_alternative<SuperExpr>(expr.object->node) &&
+          getCachedProperty(expr.cache, obj, id->name, cached)) {
+        LIGHTJS_RETURN(cached);
+      }
+      propName = id->name;
+    }
+  }
+
+  bool isSuperAccess = expr.object && std::holds_alternative<SuperExpr>(expr.object->node);
+  LIGHTJS_RETURN(getMemberValue(obj, propName, typedArrayNumericIndex, expr.privateIdentifier, isSuperAccess));
+}
+
+Value Interpreter::evaluateMemberSync(const MemberExpr& expr) {
+  Value obj = evaluateSync(*expr.object);
+  if (hasError()) return Value(Undefined{});
+
+  const bool optionalChain = expr.optional || expr.inOptionalChain;
+  if (obj.isNull() || obj.isUndefined()) {
+    if (optionalChain) {
+      return Value(Undefined{});
+    }
+    std::string propName;
+    if (expr.computed) {
+      // Evaluate computed property key first per spec (LHS before RHS)
+      evaluateSync(*expr.property);
+    } else if (auto* id = std::get_if<Identifier>(&expr.property->node)) {
+      propName = id->name;
+    }
+    throwError(ErrorType::TypeError,
+      "Cannot read properties of " + std::string(obj.isNull() ? "null" : "undefined") +
+      (propName.empty() ? "" : " (reading '" + propName + "')"));
+    return Value(Undefined{});
+  }
+
+  std::string propName;
+  std::optional<size_t> typedArrayNumericIndex;
+  if (expr.computed) {
+    Value key = evaluateSync(*expr.property);
+    if (isObjectLike(key)) {
+      key = toPrimitiveValue(key, true);
+      if (hasError()) {
+        return Value(Undefined{});
+      }
+    }
+    typedArrayNumericIndex = arrayIndexKey(key);
+    Value element;
+    if (typedArrayNumericIndex && !std::holds_alternative<SuperExpr>(expr.object->node) &&
+        getIndexedElement(obj, *typedArrayNumericIndex, element)) {
+      return element;
+    }
+    propName = toPropertyKeyString(key);
+  } else if (auto* id = std::get_if<Identifier>(&expr.property->node)) {
+    Value cached;
+    if (!expr.privateIdentifier && !std::holds_alternative<SuperExpr>(expr.object->node) &&
+        getCachedProperty(expr.cache, obj, id->name, cached)) {
+      return cached;
+    }
+    propName = id->name;
+  }
+
+  bool isSuperAccess = expr.object && std::holds_alternative<SuperExpr>(expr.object->node);
+  return getMemberValue(obj, propName, typedArrayNumericIndex, expr.privateIdentifier, isSuperAccess);
+}
+
+std::optional<size_t> Interpreter::arrayIndexKey(const Value& key) {
+  if (key.isInt32()) {
+    int32_t index = key.asInt32();
+    return index >= 0 ? std::optional<size_t>(static_cast<size_t>(index)) : std::nullopt;
+  }
+  if (key.isNumber()) {
+    double numericKey = key.asNumber();
+    if (numericKey >= 0.0 && numericKey <= 4294967294.0 && std::trunc(numericKey) == numericKey) {
+      return static_cast<size_t>(numericKey);
+    }
+  }
+  return std::nullopt;
+}
+
+bool Interpreter::getIndexedElement(const Value& obj, size_t index, Value& out) {
+  if (auto arr = obj.getGC<Array>()) {
+    if (!hasPlainElements(*arr) || index >= arr->elementCount()) {
+      return false;
+    }
+    out = arr->element(index);
+  } else if (auto ta = obj.getGC<TypedArray>()) {
+    out = typedArrayElement(*ta, index);
+  } else {
+    return false;
+  }
+  lastMemberBase_ = obj;
+  hasLastMemberBase_ = true;
+  return true;
+}
+
+bool Interpreter::setIndexedElement(const Value& obj, size_t index, const Value& value) {
+  auto arr = obj.getGC<Array>();
+  if (!arr || !hasPlainElements(*arr) || index > arr->elementCount()) {
+    return false;
+  }
+  if (index == arr->elementCount()) {
+    if (!denseArrayResizeAllowed(index + 1)) {
+      return false;
+    }
+    arr->pushElement(value);
+    return true;
+  }
+  arr->setElement(index, value);
+  return true;
+}
+
+namespace {
+
+// Prototype hits are only recorded this many links up the chain.
+constexpr int kMaxPrototypeHitDepth = 8;
+
+// Walks the receiver's prototype chain for a plain data property `name`
+// stored in a shape-mode map, collecting a validity cell from every map it
+// passes. Returns null when the lookup would involve accessors, module
+// namespaces or a non-Object link.
+std::shared_ptr<const PropertyCache::PrototypeHit> findPrototypeHit(
+    const PropertyMap& receiver, const std::string& name, int& offset) {
+  auto hit = std::make_shared<PropertyCache::PrototypeHit>();
+  const Value* proto = receiver.prototype();
+  for (int depth = 0; depth < kMaxPrototypeHitDepth && proto && proto->isObject(); ++depth) {
+    auto protoObj = proto->getGC<Object>();
+    if (protoObj->isModuleNamespace) {
+      return nullptr;
+    }
+    const PropertyMap& props = protoObj->properties;
+    if (depth == 0) {
+      hit->prototype = &props;
+    }
+    hit->cells.push_back(props.validityCell());
+    if (props.getter(name) || props.setter(name)) {
+      return nullptr;
+    }
+    int slot = props.slotOffset(name);
+    if (slot >= 0) {
+      if (props.slot(static_cast<size_t>(slot)).isModuleBinding()) {
+        return nullptr;
+      }
+      hit->holder = &props;
+      offset = slot;
+      return hit;
+    }
+    if (props.lookup(name)) {
+      return nullptr;  // Held in dictionary mode
+    }
+    proto = props.prototype();
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+bool Interpreter::getCachedProperty(PropertyCache& cache, const Value& obj,
+                                    const std::string& name, Value& out) {
+  auto objPtr = obj.getGC<Object>();
+  if (!objPtr || objPtr->isModuleNamespace) {
+    return false;
+  }
+  ObjectShape::ShapeId shapeId = objPtr->properties.shapeId();
+  if (shapeId == 0) {
+    return false;
+  }
+  const PropertyCache::CacheEntry* entry = cache.find(shapeId);
+  if (!entry) {
+    // Only plain data properties are cached. The shape fixes which marker
+    // keys exist, so an object sharing it has no own getter either.
+    if (name.rfind("__", 0) == 0 ||
+        objPtr->properties.getter(name) ||
+        objPtr->properties.count("__deferred_pending__")) {
+      return false;
+    }
+    int offset = objPtr->properties.slotOffset(name);
+    if (offset >= 0) {
+      cache.update(shapeId, offset);
+    } else if (auto hit = findPrototypeHit(objPtr->properties, name, offset)) {
+      cache.update(shapeId, offset, std::move(hit));
+    } else {
+      return false;
     }
-    propName = toPropertyKeyString(key);
-  } else {
-    if (auto* id = std::get_if<Identifier>(&expr.property->node)) {
-      propName = id->name;
+    entry = cache.find(shapeId);
+  }
+  const PropertyMap* holder = &objPtr->properties;
+  if (const auto& hit = entry->prototypeHit) {
+    // Objects of one shape can still differ in their prototype.
+    const Value* proto = objPtr->properties.prototype();
+    if (!proto || !proto->isObject() || &proto->getGC<Object>()->properties != hit->prototype) {
+      return false;
     }
+    holder = hit->holder;
+  }
+  const Value& value = holder->slot(static_cast<size_t>(entry->offset));
+  if (value.isModuleBinding()) {
+    return false;
   }
+  lastMemberBase_ = obj;
+  hasLastMemberBase_ = true;
+  out = value;
+  return true;
+}
 
+Value Interpreter::getMemberValue(Value obj,
+                                  const std::string& propName,
+                                  std::optional<size_t> typedArrayNumericIndex,
+                                  bool privateIdentifier,
+                                  bool isSuperAccess) {
   // Remember the current base object so method calls can bind `this` without
   // re-evaluating side-effectful member objects.
-  bool isSuperAccess = expr.object && std::holds_alternative<SuperExpr>(expr.object->node);
   if (isSuperAccess) {
     // In derived constructors, `this` is uninitialized before super().
     if (auto superCalled = env_->get("__super_called__");
         superCalled && superCalled->isBool() && !superCalled->toBool()) {
       throwError(ErrorType::ReferenceError,
                  "Must call super constructor in derived class before accessing 'this'");
-      LIGHTJS_RETURN(Value(Undefined{}));
+      return Value(Undefined{});
     }
     if (auto thisValue = env_->get("this")) {
       lastMemberBase_ = *thisValue;
@@ -8199,7 +8672,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
   hasLastMemberBase_ = true;
 
   Value privateAccessReceiver = obj;
-  if (expr.privateIdentifier) {
+  if (privateIdentifier) {
     int proxyDepth = 0;
     while (obj.isProxy() && proxyDepth < 16) {
       auto proxyPtr = obj.getGC<Proxy>();
@@ -8207,7 +8680,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         throwError(ErrorType::TypeError,
                    "Cannot read private member " + propName +
                        " from an object whose class did not declare it");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
       obj = *proxyPtr->target;
       proxyDepth++;
@@ -8216,29 +8689,18 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       throwError(ErrorType::TypeError,
                  "Cannot read private member " + propName +
                      " from an object whose class did not declare it");
-      LIGHTJS_RETURN(Value(Undefined{}));
+      return Value(Undefined{});
     }
     if (!obj.isClass() && !isObjectLike(obj)) {
       throwError(ErrorType::TypeError,
                  "Cannot read private member " + propName +
                      " from an object whose class did not declare it");
-      LIGHTJS_RETURN(Value(Undefined{}));
+      return Value(Undefined{});
     }
   }
 
-  if (!expr.privateIdentifier && typedArrayNumericIndex.has_value() && obj.isTypedArray()) {
-    auto ta = obj.getGC<TypedArray>();
-    size_t index = *typedArrayNumericIndex;
-    if (index >= ta->currentLength()) {
-      LIGHTJS_RETURN(Value(Undefined{}));
-    }
-    if (ta->type == TypedArrayType::BigInt64 || ta->type == TypedArrayType::BigUint64) {
-      if (ta->type == TypedArrayType::BigUint64) {
-        LIGHTJS_RETURN(Value(BigInt(bigint::BigIntValue(ta->getBigUintElement(index)))));
-      }
-      LIGHTJS_RETURN(Value(BigInt(ta->getBigIntElement(index))));
-    }
-    LIGHTJS_RETURN(Value(ta->getElement(index)));
+  if (!privateIdentifier && typedArrayNumericIndex.has_value() && obj.isTypedArray()) {
+    return typedArrayElement(*obj.getGC<TypedArray>(), *typedArrayNumericIndex);
   }
 
   // BigInt primitive member access
@@ -8252,7 +8714,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       valueOfFn->nativeFunc = [bigintValue](const std::vector<Value>&) -> Value {
         return Value(BigInt(bigintValue));
       };
-      LIGHTJS_RETURN(Value(valueOfFn));
+      return Value(valueOfFn);
     }
 
     if (propName == "toString") {
@@ -8270,7 +8732,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         }
         return Value(bigint::toString(bigintValue, radix));
       };
-      LIGHTJS_RETURN(Value(toStringFn));
+      return Value(toStringFn);
     }
 
     // Fallback to BigInt.prototype for user-defined properties.
@@ -8284,7 +8746,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       }
       auto [found, value] = getPropertyForPrimitive(Value(wrapper), propName);
       if (found) {
-        LIGHTJS_RETURN(value);
+        return value;
       }
     }
   }
@@ -8301,14 +8763,14 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       }
       auto [found, value] = getPropertyForPrimitive(Value(wrapper), propName);
       if (found) {
-        LIGHTJS_RETURN(value);
+        return value;
       }
     }
   }
 
   // Proxy trap handling - intercept get operations.
   // Private field access bypasses Proxy [[Get]] and is handled below.
-  if (obj.isProxy() && !expr.privateIdentifier) {
+  if (obj.isProxy() && !privateIdentifier) {
     auto proxyPtr = obj.getGC<Proxy>();
 
     // Check if handler has a 'get' trap
@@ -8325,9 +8787,9 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
           obj  // receiver is the proxy itself
         };
         if (getTrap->isNative) {
-          LIGHTJS_RETURN(getTrap->nativeFunc(trapArgs));
+          return getTrap->nativeFunc(trapArgs);
         } else {
-          LIGHTJS_RETURN(invokeFunction(getTrap, trapArgs, Value(Undefined{})));
+          return invokeFunction(getTrap, trapArgs, Value(Undefined{}));
         }
       }
     }
@@ -8337,10 +8799,10 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       auto targetObj = std::get<GCPtr<Object>>(proxyPtr->target->data);
       auto it = targetObj->properties.find(propName);
       if (it != targetObj->properties.end()) {
-        LIGHTJS_RETURN(it->second);
+        return it->second;
       }
     }
-    LIGHTJS_RETURN(Value(Undefined{}));
+    return Value(Undefined{});
   }
 
   const auto& iteratorKey = WellKnownSymbols::iteratorKey();
@@ -8352,11 +8814,11 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
     std::string promiseGetterName = "__get_" + propName;
     auto promiseGetterIt = promisePtr->properties.find(promiseGetterName);
     if (promiseGetterIt != promisePtr->properties.end() && promiseGetterIt->second.isFunction()) {
-      LIGHTJS_RETURN(callFunction(promiseGetterIt->second, {}, obj));
+      return callFunction(promiseGetterIt->second, {}, obj);
     }
     auto promiseOwnIt = promisePtr->properties.find(propName);
     if (promiseOwnIt != promisePtr->properties.end()) {
-      LIGHTJS_RETURN(promiseOwnIt->second);
+      return promiseOwnIt->second;
     }
 
     auto getIntrinsicPromisePrototype = [&]() -> GCPtr<Object> {
@@ -8380,26 +8842,26 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
     if (auto promiseProto = getIntrinsicPromisePrototype()) {
       auto getterIt = promiseProto->properties.find("__get_" + propName);
       if (getterIt != promiseProto->properties.end() && getterIt->second.isFunction()) {
-        LIGHTJS_RETURN(callFunction(getterIt->second, {}, obj));
+        return callFunction(getterIt->second, {}, obj);
       }
       auto protoIt = promiseProto->properties.find(propName);
       if (protoIt != promiseProto->properties.end()) {
-        LIGHTJS_RETURN(protoIt->second);
+        return protoIt->second;
       }
     }
 
     if (propName == "constructor") {
       auto ctorIt = promisePtr->properties.find("__constructor__");
       if (ctorIt != promisePtr->properties.end()) {
-        LIGHTJS_RETURN(ctorIt->second);
+        return ctorIt->second;
       }
       if (auto intrinsic = env_->get("__intrinsic_Promise__")) {
-        LIGHTJS_RETURN(*intrinsic);
+        return *intrinsic;
       }
       if (auto ctor = env_->get("Promise")) {
-        LIGHTJS_RETURN(*ctor);
+        return *ctor;
       }
-      LIGHTJS_RETURN(Value(Undefined{}));
+      return Value(Undefined{});
     }
 
     // Add toString method for Promise
@@ -8409,7 +8871,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       toStringFn->nativeFunc = [](const std::vector<Value>&) -> Value {
         return Value("[Promise]");
       };
-      LIGHTJS_RETURN(Value(toStringFn));
+      return Value(toStringFn);
     }
 
     // Promise.prototype.then(onFulfilled, onRejected)
@@ -8451,7 +8913,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         auto chainedPromise = promisePtr->then(onFulfilled, onRejected);
         return Value(chainedPromise);
       };
-      LIGHTJS_RETURN(Value(thenFn));
+      return Value(thenFn);
     }
 
     // Promise.prototype.catch(onRejected)
@@ -8477,7 +8939,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         auto chainedPromise = promisePtr->catch_(onRejected);
         return Value(chainedPromise);
       };
-      LIGHTJS_RETURN(Value(catchFn));
+      return Value(catchFn);
     }
 
     // Promise.prototype.finally(onFinally)
@@ -8503,7 +8965,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         auto chainedPromise = promisePtr->finally(onFinally);
         return Value(chainedPromise);
       };
-      LIGHTJS_RETURN(Value(finallyFn));
+      return Value(finallyFn);
     }
 
     if (promisePtr->state == PromiseState::Fulfilled) {
@@ -8512,7 +8974,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         auto objPtr = resolvedValue.getGC<Object>();
         auto it = objPtr->properties.find(propName);
         if (it != objPtr->properties.end()) {
-          LIGHTJS_RETURN(it->second);
+          return it->second;
         }
       }
     }
@@ -8522,10 +8984,10 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
   if (obj.isArrayBuffer()) {
     auto [found, value] = getPropertyForPrimitive(obj, propName);
     if (hasError()) {
-      LIGHTJS_RETURN(Value(Undefined{}));
+      return Value(Undefined{});
     }
     if (found) {
-      LIGHTJS_RETURN(value);
+      return value;
     }
   }
 
@@ -8533,22 +8995,22 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
   if (obj.isDataView()) {
     auto [found, value] = getPropertyForPrimitive(obj, propName);
     if (hasError()) {
-      LIGHTJS_RETURN(Value(Undefined{}));
+      return Value(Undefined{});
     }
     if (found) {
-      LIGHTJS_RETURN(value);
+      return value;
     }
 
     auto viewPtr = obj.getGC<DataView>();
 
     if (propName == "buffer") {
-      LIGHTJS_RETURN(Value(viewPtr->buffer));
+      return Value(viewPtr->buffer);
     }
     if (propName == "byteOffset") {
-      LIGHTJS_RETURN(Value(static_cast<double>(viewPtr->byteOffset)));
+      return Value(static_cast<double>(viewPtr->byteOffset));
     }
     if (propName == "byteLength") {
-      LIGHTJS_RETURN(Value(static_cast<double>(viewPtr->byteLength)));
+      return Value(static_cast<double>(viewPtr->byteLength));
     }
 
     // DataView get methods
@@ -8559,7 +9021,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         if (args.empty()) return Value(GarbageCollector::makeGC<Error>(ErrorType::TypeError, "getInt8 requires offset"));
         return Value(static_cast<double>(viewPtr->getInt8(static_cast<size_t>(args[0].toNumber()))));
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
     if (propName == "getUint8") {
       auto fn = GarbageCollector::makeGC<Function>();
@@ -8568,7 +9030,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         if (args.empty()) return Value(GarbageCollector::makeGC<Error>(ErrorType::TypeError, "getUint8 requires offset"));
         return Value(static_cast<double>(viewPtr->getUint8(static_cast<size_t>(args[0].toNumber()))));
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
     if (propName == "getInt16") {
       auto fn = GarbageCollector::makeGC<Function>();
@@ -8578,7 +9040,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         bool littleEndian = args.size() > 1 ? args[1].toBool() : false;
         return Value(static_cast<double>(viewPtr->getInt16(static_cast<size_t>(args[0].toNumber()), littleEndian)));
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
     if (propName == "getUint16") {
       auto fn = GarbageCollector::makeGC<Function>();
@@ -8588,7 +9050,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         bool littleEndian = args.size() > 1 ? args[1].toBool() : false;
         return Value(static_cast<double>(viewPtr->getUint16(static_cast<size_t>(args[0].toNumber()), littleEndian)));
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
     if (propName == "getInt32") {
       auto fn = GarbageCollector::makeGC<Function>();
@@ -8598,7 +9060,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         bool littleEndian = args.size() > 1 ? args[1].toBool() : false;
         return Value(static_cast<double>(viewPtr->getInt32(static_cast<size_t>(args[0].toNumber()), littleEndian)));
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
     if (propName == "getUint32") {
       auto fn = GarbageCollector::makeGC<Function>();
@@ -8608,7 +9070,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         bool littleEndian = args.size() > 1 ? args[1].toBool() : false;
         return Value(static_cast<double>(viewPtr->getUint32(static_cast<size_t>(args[0].toNumber()), littleEndian)));
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
     if (propName == "getFloat32") {
       auto fn = GarbageCollector::makeGC<Function>();
@@ -8618,7 +9080,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         bool littleEndian = args.size() > 1 ? args[1].toBool() : false;
         return Value(static_cast<double>(viewPtr->getFloat32(static_cast<size_t>(args[0].toNumber()), littleEndian)));
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
     if (propName == "getFloat64") {
       auto fn = GarbageCollector::makeGC<Function>();
@@ -8628,7 +9090,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         bool littleEndian = args.size() > 1 ? args[1].toBool() : false;
         return Value(viewPtr->getFloat64(static_cast<size_t>(args[0].toNumber()), littleEndian));
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
     if (propName == "getBigInt64") {
       auto fn = GarbageCollector::makeGC<Function>();
@@ -8638,7 +9100,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         bool littleEndian = args.size() > 1 ? args[1].toBool() : false;
         return Value(BigInt(viewPtr->getBigInt64(static_cast<size_t>(args[0].toNumber()), littleEndian)));
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
     if (propName == "getBigUint64") {
       auto fn = GarbageCollector::makeGC<Function>();
@@ -8648,7 +9110,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         bool littleEndian = args.size() > 1 ? args[1].toBool() : false;
         return Value(BigInt(bigint::BigIntValue(viewPtr->getBigUint64(static_cast<size_t>(args[0].toNumber()), littleEndian))));
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     // DataView set methods
@@ -8660,7 +9122,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         viewPtr->setInt8(static_cast<size_t>(args[0].toNumber()), static_cast<int8_t>(args[1].toNumber()));
         return Value(Undefined{});
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
     if (propName == "setUint8") {
       auto fn = GarbageCollector::makeGC<Function>();
@@ -8670,7 +9132,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         viewPtr->setUint8(static_cast<size_t>(args[0].toNumber()), static_cast<uint8_t>(args[1].toNumber()));
         return Value(Undefined{});
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
     if (propName == "setInt16") {
       auto fn = GarbageCollector::makeGC<Function>();
@@ -8681,7 +9143,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         viewPtr->setInt16(static_cast<size_t>(args[0].toNumber()), static_cast<int16_t>(args[1].toNumber()), littleEndian);
         return Value(Undefined{});
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
     if (propName == "setUint16") {
       auto fn = GarbageCollector::makeGC<Function>();
@@ -8692,7 +9154,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         viewPtr->setUint16(static_cast<size_t>(args[0].toNumber()), static_cast<uint16_t>(args[1].toNumber()), littleEndian);
         return Value(Undefined{});
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
     if (propName == "setInt32") {
       auto fn = GarbageCollector::makeGC<Function>();
@@ -8703,7 +9165,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         viewPtr->setInt32(static_cast<size_t>(args[0].toNumber()), static_cast<int32_t>(args[1].toNumber()), littleEndian);
         return Value(Undefined{});
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
     if (propName == "setUint32") {
       auto fn = GarbageCollector::makeGC<Function>();
@@ -8714,7 +9176,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         viewPtr->setUint32(static_cast<size_t>(args[0].toNumber()), static_cast<uint32_t>(args[1].toNumber()), littleEndian);
         return Value(Undefined{});
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
     if (propName == "setFloat32") {
       auto fn = GarbageCollector::makeGC<Function>();
@@ -8725,7 +9187,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         viewPtr->setFloat32(static_cast<size_t>(args[0].toNumber()), static_cast<float>(args[1].toNumber()), littleEndian);
         return Value(Undefined{});
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
     if (propName == "setFloat64") {
       auto fn = GarbageCollector::makeGC<Function>();
@@ -8736,7 +9198,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         viewPtr->setFloat64(static_cast<size_t>(args[0].toNumber()), args[1].toNumber(), littleEndian);
         return Value(Undefined{});
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
     if (propName == "setBigInt64") {
       auto fn = GarbageCollector::makeGC<Function>();
@@ -8747,7 +9209,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         viewPtr->setBigInt64(static_cast<size_t>(args[0].toNumber()), bigint::toInt64Trunc(args[1].toBigInt()), littleEndian);
         return Value(Undefined{});
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
     if (propName == "setBigUint64") {
       auto fn = GarbageCollector::makeGC<Function>();
@@ -8758,7 +9220,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         viewPtr->setBigUint64(static_cast<size_t>(args[0].toNumber()), bigint::toUint64Trunc(args[1].toBigInt()), littleEndian);
         return Value(Undefined{});
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
   }
 
@@ -8767,7 +9229,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
     auto streamPtr = obj.getGC<ReadableStream>();
 
     if (propName == "locked") {
-      LIGHTJS_RETURN(Value(streamPtr->locked));
+      return Value(streamPtr->locked);
     }
 
     if (propName == "getReader") {
@@ -8804,7 +9266,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
 
         return Value(readerObj);
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "cancel") {
@@ -8814,7 +9276,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         Value reason = args.empty() ? Value(Undefined{}) : args[0];
         return Value(streamPtr->cancel(reason));
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "pipeTo") {
@@ -8827,7 +9289,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         auto dest = args[0].getGC<WritableStream>();
         return Value(streamPtr->pipeTo(dest));
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "pipeThrough") {
@@ -8841,7 +9303,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         auto result = streamPtr->pipeThrough(transform);
         return result ? Value(result) : Value(Undefined{});
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "tee") {
@@ -8850,11 +9312,11 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       fn->nativeFunc = [streamPtr](const std::vector<Value>& args) -> Value {
         auto [branch1, branch2] = streamPtr->tee();
         auto result = GarbageCollector::makeGC<Array>();
-        result->elements.push_back(Value(branch1));
-        result->elements.push_back(Value(branch2));
+        result->pushElement(Value(branch1));
+        result->pushElement(Value(branch2));
         return Value(result);
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     // Symbol.asyncIterator - returns async iterator for for-await-of
@@ -8896,7 +9358,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
 
         return Value(iteratorObj);
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
   }
 
@@ -8905,7 +9367,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
     auto streamPtr = obj.getGC<WritableStream>();
 
     if (propName == "locked") {
-      LIGHTJS_RETURN(Value(streamPtr->locked));
+      return Value(streamPtr->locked);
     }
 
     if (propName == "getWriter") {
@@ -8966,7 +9428,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
 
         return Value(writerObj);
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "abort") {
@@ -8976,7 +9438,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         Value reason = args.empty() ? Value(Undefined{}) : args[0];
         return Value(streamPtr->abort(reason));
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "close") {
@@ -8985,7 +9447,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       fn->nativeFunc = [streamPtr](const std::vector<Value>& args) -> Value {
         return Value(streamPtr->close());
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
   }
 
@@ -8994,11 +9456,11 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
     auto streamPtr = obj.getGC<TransformStream>();
 
     if (propName == "readable") {
-      LIGHTJS_RETURN(Value(streamPtr->readable));
+      return Value(streamPtr->readable);
     }
 
     if (propName == "writable") {
-      LIGHTJS_RETURN(Value(streamPtr->writable));
+      return Value(streamPtr->writable);
     }
   }
 
@@ -9022,10 +9484,10 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         if (clsPtr->properties.count("__set_" + key) > 0) return Value(true);
         return Value(false);
       };
-      LIGHTJS_RETURN(Value(hopFn));
+      return Value(hopFn);
     }
     // Handle private static field/method access (#name)
-    if (expr.privateIdentifier) {
+    if (privateIdentifier) {
       PrivateNameOwner resolved;
       if (activePrivateOwnerClass_) {
         resolved = resolvePrivateNameOwnerClass(activePrivateOwnerClass_, propName);
@@ -9039,55 +9501,55 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         throwError(ErrorType::TypeError,
                    "Cannot read private member " + propName +
                    " from an object whose class did not declare it");
-        LIGHTJS_RETURN(Value(Undefined{}));
+        return Value(Undefined{});
       }
       std::string mangledName = privateStorageKey(resolved.owner, propName);
       auto privateGetterIt = clsPtr->properties.find("__get_" + mangledName);
       if (privateGetterIt != clsPtr->properties.end() && privateGetterIt->second.isFunction()) {
-        LIGHTJS_RETURN(callFunction(privateGetterIt->second, {}, privateAccessReceiver));
+        return callFunction(privateGetterIt->second, {}, privateAccessReceiver);
       }
       auto it = clsPtr->properties.find(mangledName);
       if (it != clsPtr->properties.end()) {
-        LIGHTJS_RETURN(it->second);
+        return it->second;
       }
       auto staticMethodIt = clsPtr->staticMethods.find(mangledName);
       if (staticMethodIt != clsPtr->staticMethods.end()) {
-        LIGHTJS_RETURN(Value(staticMethodIt->second));
+        return Value(staticMethodIt->second);
       }
       throwError(ErrorType::TypeError, "Cannot read private member " + propName + " from an object whose class did not declare it");
-      LIGHTJS_RETURN(Value(Undefined{}));
+      return Value(Undefined{});
     }
     auto getterIt = clsPtr->properties.find("__get_" + propName);
     if (getterIt != clsPtr->properties.end() && getterIt->second.isFunction()) {
-      LIGHTJS_RETURN(callFunction(getterIt->second, {}, obj));
+      return callFunction(getterIt->second, {}, obj);
     }
     // If only a setter exists (no getter), return undefined (accessor with no get)
     auto setterOnlyIt = clsPtr->properties.find("__set_" + propName);
     if (setterOnlyIt != clsPtr->properties.end() && getterIt == clsPtr->properties.end()) {
-      LIGHTJS_RETURN(Value(Undefined{}));
+      return Value(Undefined{});
     }
     // Check own properties first (name, length, static methods, etc.)
     auto propIt = clsPtr->properties.find(propName);
     if (propIt != clsPtr->properties.end()) {
-      LIGHTJS_RETURN(propIt->second);
+      return propIt->second;
     }
     auto staticIt = clsPtr->staticMethods.find(propName);
     if (staticIt != clsPtr->staticMethods.end()) {
-      LIGHTJS_RETURN(Value(staticIt->second));
+      return Value(staticIt->second);
     }
     if (clsPtr->superClass) {
       auto superGetterIt = clsPtr->superClass->properties.find("__get_" + propName);
       if (superGetterIt != clsPtr->superClass->properties.end() &&
           superGetterIt->second.isFunction()) {
-        LIGHTJS_RETURN(callFunction(superGetterIt->second, {}, obj));
+        return callFunction(superGetterIt->second, {}, obj);
       }
       auto superPropIt = clsPtr->superClass->properties.find(propName);
       if (superPropIt != clsPtr->superClass->properties.end()) {
-        LIGHTJS_RETURN(superPropIt->second);
+        return superPropIt->second;
       }
       auto superStaticIt = clsPtr->superClass->staticMethods.find(propName);
       if (superStaticIt != clsPtr->superClass->staticMethods.end()) {
-        LIGHTJS_RETURN(Value(superStaticIt->second));
+        return Value(superStaticIt->second);
       }
     }
 
@@ -9102,11 +9564,11 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
             auto proto = protoVal.getGC<Object>();
             auto protoGetterIt = proto->properties.find("__get_" + propName);
             if (protoGetterIt != proto->properties.end() && protoGetterIt->second.isFunction()) {
-              LIGHTJS_RETURN(callFunction(protoGetterIt->second, {}, obj));
+              return callFunction(protoGetterIt->second, {}, obj);
             }
             auto found = proto->properties.find(propName);
             if (found != proto->properties.end()) {
-              LIGHTJS_RETURN(found->second);
+              return found->second;
             }
             auto nextProto = proto->properties.find("__proto__");
             if (nextProto == proto->properties.end()) break;
@@ -9115,15 +9577,15 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
             auto protoCls = protoVal.getGC<Class>();
             auto protoGetterIt = protoCls->properties.find("__get_" + propName);
             if (protoGetterIt != protoCls->properties.end() && protoGetterIt->second.isFunction()) {
-              LIGHTJS_RETURN(callFunction(protoGetterIt->second, {}, obj));
+              return callFunction(protoGetterIt->second, {}, obj);
             }
             auto found = protoCls->properties.find(propName);
             if (found != protoCls->properties.end()) {
-              LIGHTJS_RETURN(found->second);
+              return found->second;
             }
             auto foundStatic = protoCls->staticMethods.find(propName);
             if (foundStatic != protoCls->staticMethods.end()) {
-              LIGHTJS_RETURN(Value(foundStatic->second));
+              return Value(foundStatic->second);
             }
             auto nextProto = protoCls->properties.find("__proto__");
             if (nextProto == protoCls->properties.end()) break;
@@ -9132,11 +9594,11 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
             auto protoFn = protoVal.getGC<Function>();
             auto protoGetterIt = protoFn->properties.find("__get_" + propName);
             if (protoGetterIt != protoFn->properties.end() && protoGetterIt->second.isFunction()) {
-              LIGHTJS_RETURN(callFunction(protoGetterIt->second, {}, obj));
+              return callFunction(protoGetterIt->second, {}, obj);
             }
             auto found = protoFn->properties.find(propName);
             if (found != protoFn->properties.end()) {
-              LIGHTJS_RETURN(found->second);
+              return found->second;
             }
             auto nextProto = protoFn->properties.find("__proto__");
             if (nextProto == protoFn->properties.end()) break;
@@ -9150,12 +9612,12 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
     }
   }
 
-  if (expr.privateIdentifier && !obj.isClass()) {
+  if (privateIdentifier && !obj.isClass()) {
     if (!activePrivateOwnerClass_) {
       throwError(ErrorType::TypeError,
                  "Cannot read private member " + propName +
                      " from an object whose class did not declare it");
-      LIGHTJS_RETURN(Value(Undefined{}));
+      return Value(Undefined{});
     }
 
     PrivateNameOwner resolved = resolvePrivateNameOwnerClass(activePrivateOwnerClass_, propName);
@@ -9163,7 +9625,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       throwError(ErrorType::TypeError,
                  "Cannot read private member " + propName +
                      " from an object whose class did not declare it");
-      LIGHTJS_RETURN(Value(Undefined{}));
+      return Value(Undefined{});
     }
 
     GCPtr<Class> targetClass = getConstructorClassForPrivateAccess(obj);
@@ -9171,30 +9633,30 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       throwError(ErrorType::TypeError,
                  "Cannot read private member " + propName +
                      " from an object whose class did not declare it");
-      LIGHTJS_RETURN(Value(Undefined{}));
+      return Value(Undefined{});
     }
 
     auto privateGetterIt = resolved.owner->getters.find(propName);
     if (privateGetterIt != resolved.owner->getters.end()) {
-      LIGHTJS_RETURN(invokeFunction(privateGetterIt->second, {}, privateAccessReceiver));
+      return invokeFunction(privateGetterIt->second, {}, privateAccessReceiver);
     }
     auto privateMethodIt = resolved.owner->methods.find(propName);
     if (privateMethodIt != resolved.owner->methods.end()) {
-      LIGHTJS_RETURN(Value(privateMethodIt->second));
+      return Value(privateMethodIt->second);
     }
 
     std::string mangledName = privateStorageKey(resolved.owner, propName);
     if (const auto* storage = getPropertyStorageForPrivateAccess(obj)) {
       auto it = storage->find(mangledName);
       if (it != storage->end()) {
-        LIGHTJS_RETURN(it->second);
+        return it->second;
       }
     }
 
     throwError(ErrorType::TypeError,
                "Cannot read private member " + propName +
                    " from an object whose class did not declare it");
-    LIGHTJS_RETURN(Value(Undefined{}));
+    return Value(Undefined{});
   }
 
   if (obj.isObject()) {
@@ -9204,11 +9666,11 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       auto protoGetterIt = objPtr->properties.find("__get___own_prop___proto__");
       if (protoGetterIt != objPtr->properties.end() && protoGetterIt->second.isFunction()) {
         auto getter = protoGetterIt->second.getGC<Function>();
-        LIGHTJS_RETURN(invokeFunction(getter, {}, accessorReceiver));
+        return invokeFunction(getter, {}, accessorReceiver);
       }
       auto ownProtoIt = objPtr->properties.find("__own_prop___proto__");
       if (ownProtoIt != objPtr->properties.end()) {
-        LIGHTJS_RETURN(ownProtoIt->second);
+        return ownProtoIt->second;
       }
     }
 
@@ -9224,25 +9686,23 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         auto deferredEvalFn = evalIt->second.getGC<Function>();
         invokeFunction(deferredEvalFn, {}, obj);
         if (hasError()) {
-          LIGHTJS_RETURN(Value(Undefined{}));
+          return Value(Undefined{});
         }
         objPtr->properties["__deferred_pending__"] = Value(false);
       }
     }
 
     // Check for getter first
-    std::string getterName = "__get_" + propName;
-    auto getterIt = objPtr->properties.find(getterName);
-    if (getterIt != objPtr->properties.end() && getterIt->second.isFunction()) {
-      auto getter = getterIt->second.getGC<Function>();
+    const Value* getterSlot = objPtr->properties.getter(propName);
+    if (getterSlot && getterSlot->isFunction()) {
+      auto getter = getterSlot->getGC<Function>();
       // Call the getter with receiver semantics (super uses current this-value).
-      LIGHTJS_RETURN(invokeFunction(getter, {}, accessorReceiver));
+      return invokeFunction(getter, {}, accessorReceiver);
     }
 
     // Direct property lookup
-    auto it = objPtr->properties.find(propName);
-    if (it != objPtr->properties.end()) {
-      LIGHTJS_RETURN(it->second);
+    if (const Value* slot = objPtr->properties.lookup(propName)) {
+      return *slot;
     }
 
     // Walk prototype chain (__proto__)
@@ -9250,29 +9710,28 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       auto proto = objPtr;
       int depth = 0;
       while (depth < 50) {
-        auto protoIt = proto->properties.find("__proto__");
-        if (protoIt == proto->properties.end() || !isObjectLike(protoIt->second)) break;
-        if (!protoIt->second.isObject()) {
-          auto [found, value] = getPropertyForPrimitive(protoIt->second, propName);
+        const Value* protoSlot = proto->properties.prototype();
+        if (!protoSlot || !isObjectLike(*protoSlot)) break;
+        if (!protoSlot->isObject()) {
+          auto [found, value] = getPropertyForPrimitive(*protoSlot, propName);
           if (found) {
-            LIGHTJS_RETURN(value);
+            return value;
           }
           break;
         }
-        proto = protoIt->second.getGC<Object>();
+        proto = protoSlot->getGC<Object>();
         depth++;
         if (proto->isModuleNamespace) {
           triggerDeferredNamespaceIfNeeded(proto, propName);
         }
         // Check getter on prototype
-        auto protoGetterIt = proto->properties.find("__get_" + propName);
-        if (protoGetterIt != proto->properties.end() && protoGetterIt->second.isFunction()) {
-          auto getter = protoGetterIt->second.getGC<Function>();
-          LIGHTJS_RETURN(invokeFunction(getter, {}, accessorReceiver));
+        const Value* protoGetter = proto->properties.getter(propName);
+        if (protoGetter && protoGetter->isFunction()) {
+          auto getter = protoGetter->getGC<Function>();
+          return invokeFunction(getter, {}, accessorReceiver);
         }
-        auto propIt = proto->properties.find(propName);
-        if (propIt != proto->properties.end()) {
-          LIGHTJS_RETURN(propIt->second);
+        if (const Value* slot = proto->properties.lookup(propName)) {
+          return *slot;
         }
       }
     }
@@ -9282,7 +9741,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
     if (auto primIt = objPtr->properties.find("__primitive_value__"); primIt != objPtr->properties.end()) {
       Value prim = primIt->second;
       if (prim.isString()) {
-        std::string str = std::get<std::string>(prim.data);
+        std::string str = prim.asString();
         if (propName == "trim") {
           auto trimFn = GarbageCollector::makeGC<Function>();
           trimFn->isNative = true;
@@ -9290,7 +9749,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
             return Value(stripESWhitespace(str));
           };
           setNativeFnProps(trimFn, "trim", 0);
-      LIGHTJS_RETURN(Value(trimFn));
+      return Value(trimFn);
         }
       } else if (prim.isNumber()) {
         double num = prim.toNumber();
@@ -9305,7 +9764,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
             oss << std::fixed << std::setprecision(digits) << num;
             return Value(oss.str());
           };
-          LIGHTJS_RETURN(Value(toFixedFn));
+          return Value(toFixedFn);
         }
         if (propName == "toExponential") {
           auto toExponentialFn = GarbageCollector::makeGC<Function>();
@@ -9335,7 +9794,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
             }
             return Value(out);
           };
-          LIGHTJS_RETURN(Value(toExponentialFn));
+          return Value(toExponentialFn);
         }
       }
     }
@@ -9389,7 +9848,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
           if (key == "length") return Value(true);
           if (hasOwnPropertyInBag(arrPtr->properties, key)) return Value(true);
           size_t idx = 0;
-          if (parseArrayIndex(key, idx) && idx < arrPtr->elements.size()) return Value(true);
+          if (parseArrayIndex(key, idx) && idx < arrPtr->elementCount()) return Value(true);
           return Value(false);
         }
         if (receiver.isRegex()) {
@@ -9449,7 +9908,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         }
         return Value(false);
       };
-      LIGHTJS_RETURN(Value(hopFn));
+      return Value(hopFn);
     }
 
     if (propName == "propertyIsEnumerable" && !hasNullProto()) {
@@ -9473,7 +9932,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
           auto arrPtr = receiver.getGC<Array>();
           if (key == "length") return Value(false);
           size_t idx = 0;
-          if (parseArrayIndex(key, idx) && idx < arrPtr->elements.size()) return Value(true);
+          if (parseArrayIndex(key, idx) && idx < arrPtr->elementCount()) return Value(true);
           if (!hasOwnPropertyInBag(arrPtr->properties)) return Value(false);
           return Value(isEnumerableForMarkers(arrPtr->properties));
         }
@@ -9512,7 +9971,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         // Fallback: not enumerable.
         return Value(false);
       };
-      LIGHTJS_RETURN(Value(pieFn));
+      return Value(pieFn);
     }
 
     // Some constructor singletons (notably Array) store prototype metadata
@@ -9522,7 +9981,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
           arrayValue && arrayValue->isObject() &&
           std::get<GCPtr<Object>>(arrayValue->data).get() == objPtr.get()) {
         if (auto hiddenArrayProto = env_->get("__array_prototype__")) {
-          LIGHTJS_RETURN(*hiddenArrayProto);
+          return *hiddenArrayProto;
         }
       }
     }
@@ -9536,7 +9995,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
     if ((funcPtr->isStrict || funcPtr->isGenerator || isArrowFunction || isBoundFunction) &&
         (propName == "caller" || propName == "arguments")) {
       throwError(ErrorType::TypeError, "'caller', 'callee', and 'arguments' properties may not be accessed");
-      LIGHTJS_RETURN(Value(Undefined{}));
+      return Value(Undefined{});
     }
     // Use %Function.prototype%.{call,apply,bind} so semantics match built-ins (esp. bound functions).
     auto resolveFunctionPrototypeMethod = [&](const std::string& name) -> std::optional<Value> {
@@ -9581,9 +10040,9 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
 
     if (propName == "call" || propName == "apply" || propName == "bind") {
       if (auto method = resolveFunctionPrototypeMethod(propName); method && method->isFunction()) {
-        LIGHTJS_RETURN(*method);
+        return *method;
       }
-      LIGHTJS_RETURN(Value(Undefined{}));
+      return Value(Undefined{});
     }
 
     // hasOwnProperty from Object.prototype
@@ -9607,20 +10066,20 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
                      funcPtr->properties.count("__get_" + key) > 0 ||
                      funcPtr->properties.count("__set_" + key) > 0);
       };
-      LIGHTJS_RETURN(Value(hopFn));
+      return Value(hopFn);
     }
 
     auto getterIt = funcPtr->properties.find("__get_" + propName);
     if (getterIt != funcPtr->properties.end() && getterIt->second.isFunction()) {
-      LIGHTJS_RETURN(callFunction(getterIt->second, {}, obj));
+      return callFunction(getterIt->second, {}, obj);
     }
     if (funcPtr->properties.find("__set_" + propName) != funcPtr->properties.end()) {
-      LIGHTJS_RETURN(Value(Undefined{}));
+      return Value(Undefined{});
     }
 
     auto it = funcPtr->properties.find(propName);
     if (it != funcPtr->properties.end()) {
-      LIGHTJS_RETURN(it->second);
+      return it->second;
     }
     if (propName == "caller") {
       if (activeFunction_.get() == funcPtr.get() && !callerContextStack_.empty()) {
@@ -9632,12 +10091,12 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
               callerContext.function->properties.find("__bound_target__") != callerContext.function->properties.end();
           if (restrictedCaller) {
             throwError(ErrorType::TypeError, "'caller', 'callee', and 'arguments' properties may not be accessed");
-            LIGHTJS_RETURN(Value(Undefined{}));
+            return Value(Undefined{});
           }
-          LIGHTJS_RETURN(Value(callerContext.function));
+          return Value(callerContext.function);
         }
       }
-      LIGHTJS_RETURN(Value(Undefined{}));
+      return Value(Undefined{});
     }
 
     // Walk prototype chain (__proto__) for functions
@@ -9663,7 +10122,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         Value currentProto = protoValue;
         int depth = 0;
         while ((currentProto.isObject() || currentProto.isFunction()) && depth < 50) {
-          OrderedMap<std::string, Value>* props = nullptr;
+          PropertyMap* props = nullptr;
           if (currentProto.isObject()) {
             auto protoObj = currentProto.getGC<Object>();
             if (!protoObj) break;
@@ -9677,11 +10136,11 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
           auto protoGetterIt = props->find("__get_" + propName);
           if (protoGetterIt != props->end() && protoGetterIt->second.isFunction()) {
             auto getter = protoGetterIt->second.getGC<Function>();
-            LIGHTJS_RETURN(invokeFunction(getter, {}, obj));
+            return invokeFunction(getter, {}, obj);
           }
           auto found = props->find(propName);
           if (found != props->end()) {
-            LIGHTJS_RETURN(found->second);
+            return found->second;
           }
           auto nextProto = props->find("__proto__");
           if (nextProto == props->end() ||
@@ -9820,7 +10279,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       fn->nativeFunc = [genPtr](const std::vector<Value>&) -> Value {
         return Value(genPtr);
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == asyncIteratorKey && isAsyncGenerator) {
@@ -9829,7 +10288,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       fn->nativeFunc = [genPtr](const std::vector<Value>&) -> Value {
         return Value(genPtr);
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "next") {
@@ -9849,7 +10308,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
             return this->runGeneratorNext(genPtr, mode, resumeValue);
           });
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "return") {
@@ -9912,7 +10371,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
 
         return wrapAsyncResult(makeIteratorResult(resultValue, true), false);
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "throw") {
@@ -9954,16 +10413,16 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
 
         return step;
       };
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     // Fallback: look up property via prototype chain (e.g. Iterator.prototype.map)
     auto [genFound, genVal] = getPropertyForPrimitive(obj, propName);
     if (hasError()) {
-      LIGHTJS_RETURN(Value(Undefined{}));
+      return Value(Undefined{});
     }
     if (genFound) {
-      LIGHTJS_RETURN(genVal);
+      return genVal;
     }
   }
 
@@ -9974,14 +10433,14 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       // Arguments objects may have overridden length
       auto overriddenIt = arrPtr->properties.find("__overridden_length__");
       if (overriddenIt != arrPtr->properties.end()) {
-        LIGHTJS_RETURN(overriddenIt->second);
+        return overriddenIt->second;
       }
       // Sparse arrays store length in __array_length__
       auto storedLen = arrPtr->properties.find("__array_length__");
       if (storedLen != arrPtr->properties.end()) {
-        LIGHTJS_RETURN(storedLen->second);
+        return storedLen->second;
       }
-      LIGHTJS_RETURN(Value(static_cast<double>(arrPtr->elements.size())));
+      return Value(static_cast<double>(arrPtr->elementCount()));
     }
 
     if (propName == iteratorKey) {
@@ -9989,12 +10448,12 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       auto ownGetterIt = arrPtr->properties.find("__get_" + propName);
       if (ownGetterIt != arrPtr->properties.end() && ownGetterIt->second.isFunction()) {
         Value out = callFunction(ownGetterIt->second, {}, obj);
-        if (hasError()) LIGHTJS_RETURN(Value(Undefined{}));
-        LIGHTJS_RETURN(out);
+        if (hasError()) return Value(Undefined{});
+        return out;
       }
       auto ownIt = arrPtr->properties.find(propName);
       if (ownIt != arrPtr->properties.end()) {
-        LIGHTJS_RETURN(ownIt->second);
+        return ownIt->second;
       }
 
       // Expose the shared Array.prototype[@@iterator] function.
@@ -10004,10 +10463,10 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         auto arrayProto = arrayProtoVal->getGC<Object>();
         auto it = arrayProto->properties.find(iteratorKey);
         if (it != arrayProto->properties.end()) {
-          LIGHTJS_RETURN(it->second);
+          return it->second;
         }
       }
-      LIGHTJS_RETURN(Value(Undefined{}));
+      return Value(Undefined{});
     }
 
     // Array methods are on Array.prototype and resolved via prototype chain lookup.
@@ -10033,42 +10492,42 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       fn->isNative = true;
       fn->nativeFunc = [arrPtr](const std::vector<Value>& args) -> Value {
         for (const auto& arg : args) {
-          arrPtr->elements.push_back(arg);
+          arrPtr->pushElement(arg);
         }
-        return Value(static_cast<double>(arrPtr->elements.size()));
+        return Value(static_cast<double>(arrPtr->elementCount()));
       };
       setNativeFnProps(fn, "push", 1);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "pop") {
       auto fn = GarbageCollector::makeGC<Function>();
       fn->isNative = true;
       fn->nativeFunc = [arrPtr](const std::vector<Value>& args) -> Value {
-        if (arrPtr->elements.empty()) {
+        if (arrPtr->elements().empty()) {
           return Value(Undefined{});
         }
-        Value result = arrPtr->elements.back();
-        arrPtr->elements.pop_back();
+        Value result = arrPtr->elements().back();
+        arrPtr->elements().pop_back();
         return result;
       };
       setNativeFnProps(fn, "pop", 0);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "shift") {
       auto fn = GarbageCollector::makeGC<Function>();
       fn->isNative = true;
       fn->nativeFunc = [arrPtr](const std::vector<Value>& args) -> Value {
-        if (arrPtr->elements.empty()) {
+        if (arrPtr->elements().empty()) {
           return Value(Undefined{});
         }
-        Value result = arrPtr->elements.front();
-        arrPtr->elements.erase(arrPtr->elements.begin());
+        Value result = arrPtr->elements().front();
+        arrPtr->elements().erase(arrPtr->elements().begin());
         return result;
       };
       setNativeFnProps(fn, "shift", 0);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "unshift") {
@@ -10076,12 +10535,12 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       fn->isNative = true;
       fn->nativeFunc = [arrPtr](const std::vector<Value>& args) -> Value {
         for (size_t i = 0; i < args.size(); ++i) {
-          arrPtr->elements.insert(arrPtr->elements.begin() + i, args[i]);
+          arrPtr->elements().insert(arrPtr->elements().begin() + i, args[i]);
         }
-        return Value(static_cast<double>(arrPtr->elements.size()));
+        return Value(static_cast<double>(arrPtr->elementCount()));
       };
       setNativeFnProps(fn, "unshift", 1);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "slice") {
@@ -10090,29 +10549,29 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       fn->nativeFunc = [arrPtr](const std::vector<Value>& args) -> Value {
         auto result = makeArrayWithPrototype();
 
-        int len = static_cast<int>(arrPtr->elements.size());
+        int len = static_cast<int>(arrPtr->elementCount());
         int start = 0;
         int end = len;
 
         if (args.size() > 0 && args[0].isNumber()) {
-          start = static_cast<int>(std::get<double>(args[0].data));
+          start = static_cast<int>(args[0].asNumber());
           if (start < 0) start = std::max(0, len + start);
           if (start > len) start = len;
         }
 
         if (args.size() > 1 && args[1].isNumber()) {
-          end = static_cast<int>(std::get<double>(args[1].data));
+          end = static_cast<int>(args[1].asNumber());
           if (end < 0) end = std::max(0, len + end);
           if (end > len) end = len;
         }
 
         for (int i = start; i < end; ++i) {
-          result->elements.push_back(arrPtr->elements[i]);
+          result->pushElement(arrPtr->element(i));
         }
         return Value(result);
       };
       setNativeFnProps(fn, "slice", 2);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "splice") {
@@ -10121,36 +10580,36 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       fn->nativeFunc = [arrPtr](const std::vector<Value>& args) -> Value {
         auto removed = makeArrayWithPrototype();
 
-        int len = static_cast<int>(arrPtr->elements.size());
+        int len = static_cast<int>(arrPtr->elementCount());
         int start = 0;
         int deleteCount = len;
 
         if (args.size() > 0 && args[0].isNumber()) {
-          start = static_cast<int>(std::get<double>(args[0].data));
+          start = static_cast<int>(args[0].asNumber());
           if (start < 0) start = std::max(0, len + start);
           if (start > len) start = len;
         }
 
         if (args.size() > 1 && args[1].isNumber()) {
-          deleteCount = std::max(0, static_cast<int>(std::get<double>(args[1].data)));
+          deleteCount = std::max(0, static_cast<int>(args[1].asNumber()));
           deleteCount = std::min(deleteCount, len - start);
         }
 
         // Remove elements
         for (int i = 0; i < deleteCount; ++i) {
-          removed->elements.push_back(arrPtr->elements[start]);
-          arrPtr->elements.erase(arrPtr->elements.begin() + start);
+          removed->pushElement(arrPtr->element(start));
+          arrPtr->elements().erase(arrPtr->elements().begin() + start);
         }
 
         // Insert new elements
         for (size_t i = 2; i < args.size(); ++i) {
-          arrPtr->elements.insert(arrPtr->elements.begin() + start + (i - 2), args[i]);
+          arrPtr->elements().insert(arrPtr->elements().begin() + start + (i - 2), args[i]);
         }
 
         return Value(removed);
       };
       setNativeFnProps(fn, "splice", 2);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "toSpliced") {
@@ -10160,39 +10619,39 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         auto result = makeArrayWithPrototype();
 
         // Copy all elements to new array
-        for (const auto& elem : arrPtr->elements) {
-          result->elements.push_back(elem);
+        for (const auto& elem : arrPtr->elements()) {
+          result->pushElement(elem);
         }
 
-        int len = static_cast<int>(result->elements.size());
+        int len = static_cast<int>(result->elementCount());
         int start = 0;
         int deleteCount = 0;
 
         if (args.size() > 0 && args[0].isNumber()) {
-          start = static_cast<int>(std::get<double>(args[0].data));
+          start = static_cast<int>(args[0].asNumber());
           if (start < 0) start = std::max(0, len + start);
           if (start > len) start = len;
         }
 
         if (args.size() > 1 && args[1].isNumber()) {
-          deleteCount = std::max(0, static_cast<int>(std::get<double>(args[1].data)));
+          deleteCount = std::max(0, static_cast<int>(args[1].asNumber()));
           deleteCount = std::min(deleteCount, len - start);
         }
 
         // Remove elements
         for (int i = 0; i < deleteCount; ++i) {
-          result->elements.erase(result->elements.begin() + start);
+          result->elements().erase(result->elements().begin() + start);
         }
 
         // Insert new elements
         for (size_t i = 2; i < args.size(); ++i) {
-          result->elements.insert(result->elements.begin() + start + (i - 2), args[i]);
+          result->elements().insert(result->elements().begin() + start + (i - 2), args[i]);
         }
 
         return Value(result);
       };
       setNativeFnProps(fn, "toSpliced", 2);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "join") {
@@ -10220,10 +10679,10 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         }
 
         std::string result;
-        for (size_t i = 0; i < arrPtr->elements.size(); ++i) {
+        for (size_t i = 0; i < arrPtr->elementCount(); ++i) {
           if (i > 0) result += separator;
-          if (!arrPtr->elements[i].isUndefined() && !arrPtr->elements[i].isNull()) {
-            result += toStringForJoin(arrPtr->elements[i]);
+          if (!arrPtr->element(i).isUndefined() && !arrPtr->element(i).isNull()) {
+            result += toStringForJoin(arrPtr->element(i));
             if (flow_.type == ControlFlow::Type::Throw) {
               return Value(Undefined{});
             }
@@ -10232,7 +10691,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(result);
       };
       setNativeFnProps(fn, "join", 1);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "indexOf") {
@@ -10240,17 +10699,17 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       fn->isNative = true;
       fn->nativeFunc = [arrPtr](const std::vector<Value>& args) -> Value {
         auto strictEqual = [](const Value& left, const Value& right) -> bool {
-          if (left.data.index() != right.data.index()) {
+          if (!left.hasSameType(right)) {
             return false;
           }
           if (left.isSymbol() && right.isSymbol()) {
-            auto& lsym = std::get<Symbol>(left.data);
-            auto& rsym = std::get<Symbol>(right.data);
+            auto& lsym = left.asSymbol();
+            auto& rsym = right.asSymbol();
             return lsym.id == rsym.id;
           }
           if (left.isBigInt() && right.isBigInt()) return left.toBigInt() == right.toBigInt();
           if (left.isNumber() && right.isNumber()) return left.toNumber() == right.toNumber();
-          if (left.isString() && right.isString()) return std::get<std::string>(left.data) == std::get<std::string>(right.data);
+          if (left.isString() && right.isString()) return left.asString() == right.asString();
           if (left.isBool() && right.isBool()) return std::get<bool>(left.data) == std::get<bool>(right.data);
           if ((left.isNull() && right.isNull()) || (left.isUndefined() && right.isUndefined())) return true;
           if (left.isObject() && right.isObject()) return left.getGC<Object>().get() == right.getGC<Object>().get();
@@ -10290,19 +10749,19 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
             numericIndex = std::trunc(numericIndex);
           }
           fromIndex = static_cast<int>(numericIndex);
-          int len = static_cast<int>(arrPtr->elements.size());
+          int len = static_cast<int>(arrPtr->elementCount());
           if (fromIndex < 0) fromIndex = std::max(0, len + fromIndex);
         }
 
-        for (size_t i = fromIndex; i < arrPtr->elements.size(); ++i) {
-          if (strictEqual(arrPtr->elements[i], searchElement)) {
+        for (size_t i = fromIndex; i < arrPtr->elementCount(); ++i) {
+          if (strictEqual(arrPtr->element(i), searchElement)) {
             return Value(static_cast<double>(i));
           }
         }
         return Value(-1.0);
       };
       setNativeFnProps(fn, "indexOf", 1);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "lastIndexOf") {
@@ -10310,17 +10769,17 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       fn->isNative = true;
       fn->nativeFunc = [arrPtr](const std::vector<Value>& args) -> Value {
         auto strictEqual = [](const Value& left, const Value& right) -> bool {
-          if (left.data.index() != right.data.index()) {
+          if (!left.hasSameType(right)) {
             return false;
           }
           if (left.isSymbol() && right.isSymbol()) {
-            auto& lsym = std::get<Symbol>(left.data);
-            auto& rsym = std::get<Symbol>(right.data);
+            auto& lsym = left.asSymbol();
+            auto& rsym = right.asSymbol();
             return lsym.id == rsym.id;
           }
           if (left.isBigInt() && right.isBigInt()) return left.toBigInt() == right.toBigInt();
           if (left.isNumber() && right.isNumber()) return left.toNumber() == right.toNumber();
-          if (left.isString() && right.isString()) return std::get<std::string>(left.data) == std::get<std::string>(right.data);
+          if (left.isString() && right.isString()) return left.asString() == right.asString();
           if (left.isBool() && right.isBool()) return std::get<bool>(left.data) == std::get<bool>(right.data);
           if ((left.isNull() && right.isNull()) || (left.isUndefined() && right.isUndefined())) return true;
           if (left.isObject() && right.isObject()) return left.getGC<Object>().get() == right.getGC<Object>().get();
@@ -10350,7 +10809,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         if (args.empty()) return Value(-1.0);
 
         Value searchElement = args[0];
-        int len = static_cast<int>(arrPtr->elements.size());
+        int len = static_cast<int>(arrPtr->elementCount());
         int fromIndex = len - 1;
 
         if (args.size() > 1) {
@@ -10372,14 +10831,14 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         }
 
         for (int i = fromIndex; i >= 0; --i) {
-          if (strictEqual(arrPtr->elements[i], searchElement)) {
+          if (strictEqual(arrPtr->element(i), searchElement)) {
             return Value(static_cast<double>(i));
           }
         }
         return Value(-1.0);
       };
       setNativeFnProps(fn, "lastIndexOf", 1);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     // includes is now on Array.prototype
@@ -10390,24 +10849,24 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       fn->nativeFunc = [arrPtr](const std::vector<Value>& args) -> Value {
         if (args.empty()) return Value(Undefined{});
         int index = static_cast<int>(args[0].toNumber());
-        int len = static_cast<int>(arrPtr->elements.size());
+        int len = static_cast<int>(arrPtr->elementCount());
         if (index < 0) index = len + index;
         if (index < 0 || index >= len) return Value(Undefined{});
-        return arrPtr->elements[index];
+        return arrPtr->element(index);
       };
       setNativeFnProps(fn, "at", 1);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "reverse") {
       auto fn = GarbageCollector::makeGC<Function>();
       fn->isNative = true;
       fn->nativeFunc = [arrPtr](const std::vector<Value>& args) -> Value {
-        std::reverse(arrPtr->elements.begin(), arrPtr->elements.end());
+        std::reverse(arrPtr->elements().begin(), arrPtr->elements().end());
         return Value(arrPtr);
       };
       setNativeFnProps(fn, "reverse", 0);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "sort") {
@@ -10416,14 +10875,14 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       fn->nativeFunc = [arrPtr, this](const std::vector<Value>& args) -> Value {
         if (args.empty() || !args[0].isFunction()) {
           // Default sort: convert to strings and compare lexicographically
-          std::sort(arrPtr->elements.begin(), arrPtr->elements.end(),
+          std::sort(arrPtr->elements().begin(), arrPtr->elements().end(),
             [](const Value& a, const Value& b) {
               return a.toString() < b.toString();
             });
         } else {
           // Sort with comparator function
           auto compareFn = args[0].getGC<Function>();
-          std::sort(arrPtr->elements.begin(), arrPtr->elements.end(),
+          std::sort(arrPtr->elements().begin(), arrPtr->elements().end(),
             [compareFn, this](const Value& a, const Value& b) {
               std::vector<Value> compareArgs = {a, b};
               Value result;
@@ -10438,7 +10897,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(arrPtr);
       };
       setNativeFnProps(fn, "sort", 1);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "toSorted") {
@@ -10446,16 +10905,16 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       fn->isNative = true;
       fn->nativeFunc = [arrPtr, this](const std::vector<Value>& args) -> Value {
         auto result = makeArrayWithPrototype();
-        result->elements = arrPtr->elements;  // Copy
+        result->assignElements(arrPtr->elements());  // Copy
 
         if (args.empty() || !args[0].isFunction()) {
-          std::sort(result->elements.begin(), result->elements.end(),
+          std::sort(result->elements().begin(), result->elements().end(),
             [](const Value& a, const Value& b) {
               return a.toString() < b.toString();
             });
         } else {
           auto compareFn = args[0].getGC<Function>();
-          std::sort(result->elements.begin(), result->elements.end(),
+          std::sort(result->elements().begin(), result->elements().end(),
             [compareFn, this](const Value& a, const Value& b) {
               std::vector<Value> compareArgs = {a, b};
               Value r;
@@ -10470,7 +10929,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(result);
       };
       setNativeFnProps(fn, "toSorted", 1);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "toReversed") {
@@ -10478,12 +10937,12 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       fn->isNative = true;
       fn->nativeFunc = [arrPtr](const std::vector<Value>& args) -> Value {
         auto result = makeArrayWithPrototype();
-        result->elements = arrPtr->elements;
-        std::reverse(result->elements.begin(), result->elements.end());
+        result->assignElements(arrPtr->elements());
+        std::reverse(result->elements().begin(), result->elements().end());
         return Value(result);
       };
       setNativeFnProps(fn, "toReversed", 0);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "at") {
@@ -10492,13 +10951,13 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       fn->nativeFunc = [arrPtr](const std::vector<Value>& args) -> Value {
         if (args.empty()) return Value(Undefined{});
         int index = static_cast<int>(args[0].toNumber());
-        int size = static_cast<int>(arrPtr->elements.size());
+        int size = static_cast<int>(arrPtr->elementCount());
         if (index < 0) index = size + index;
         if (index < 0 || index >= size) return Value(Undefined{});
-        return arrPtr->elements[index];
+        return arrPtr->element(index);
       };
       setNativeFnProps(fn, "at", 1);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "with") {
@@ -10507,18 +10966,18 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       fn->nativeFunc = [arrPtr](const std::vector<Value>& args) -> Value {
         if (args.size() < 2) return Value(arrPtr);
         int index = static_cast<int>(args[0].toNumber());
-        int size = static_cast<int>(arrPtr->elements.size());
+        int size = static_cast<int>(arrPtr->elementCount());
         if (index < 0) index = size + index;
         if (index < 0 || index >= size) {
           return Value(GarbageCollector::makeGC<Error>(ErrorType::RangeError, "Invalid index"));
         }
         auto result = makeArrayWithPrototype();
-        result->elements = arrPtr->elements;
-        result->elements[index] = args[1];
+        result->assignElements(arrPtr->elements());
+        result->setElement(index, args[1]);
         return Value(result);
       };
       setNativeFnProps(fn, "with", 2);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "concat") {
@@ -10544,9 +11003,9 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         auto spreadInto = [this, &result](const Value& val) {
           if (val.isArray()) {
             auto otherArr = val.getGC<Array>();
-            result->elements.insert(result->elements.end(),
-                                  otherArr->elements.begin(),
-                                  otherArr->elements.end());
+            result->elements().insert(result->elements().end(),
+                                  otherArr->elements().begin(),
+                                  otherArr->elements().end());
           } else {
             // Array-like: read length and index properties
             auto [foundLen, lenVal] = getPropertyForExternal(val, "length");
@@ -10556,7 +11015,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
             for (size_t i = 0; i < static_cast<size_t>(len); i++) {
               auto [found, elem] = getPropertyForExternal(val, std::to_string(i));
               if (hasError()) { clearError(); break; }
-              result->elements.push_back(found ? elem : Value(Undefined{}));
+              result->pushElement(found ? elem : Value(Undefined{}));
             }
           }
         };
@@ -10565,7 +11024,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         if (isConcatSpreadable(Value(arrPtr))) {
           spreadInto(Value(arrPtr));
         } else {
-          result->elements.push_back(Value(arrPtr));
+          result->pushElement(Value(arrPtr));
         }
 
         // Process arguments
@@ -10573,14 +11032,14 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
           if (isConcatSpreadable(arg)) {
             spreadInto(arg);
           } else {
-            result->elements.push_back(arg);
+            result->pushElement(arg);
           }
         }
 
         return Value(result);
       };
       setNativeFnProps(fn, "concat", 1);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "flat") {
@@ -10589,7 +11048,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       fn->nativeFunc = [arrPtr](const std::vector<Value>& args) -> Value {
         int depth = 1;
         if (args.size() > 0 && args[0].isNumber()) {
-          depth = static_cast<int>(std::get<double>(args[0].data));
+          depth = static_cast<int>(args[0].asNumber());
         }
 
         std::function<void(const std::vector<Value>&, int, std::vector<Value>&)> flattenImpl;
@@ -10597,7 +11056,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
           for (const auto& elem : src) {
             if (d > 0 && elem.isArray()) {
               auto inner = elem.getGC<Array>();
-              flattenImpl(inner->elements, d - 1, dest);
+              flattenImpl(inner->elements(), d - 1, dest);
             } else {
               dest.push_back(elem);
             }
@@ -10605,11 +11064,11 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         };
 
         auto result = makeArrayWithPrototype();
-        flattenImpl(arrPtr->elements, depth, result->elements);
+        flattenImpl(arrPtr->elements(), depth, result->elements());
         return Value(result);
       };
       setNativeFnProps(fn, "flat", 0);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "flatMap") {
@@ -10624,23 +11083,23 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
 
         auto result = makeArrayWithPrototype();
 
-        for (size_t i = 0; i < arrPtr->elements.size(); ++i) {
-          std::vector<Value> callArgs = {arrPtr->elements[i], Value(static_cast<double>(i)), Value(arrPtr)};
+        for (size_t i = 0; i < arrPtr->elementCount(); ++i) {
+          std::vector<Value> callArgs = {arrPtr->element(i), Value(static_cast<double>(i)), Value(arrPtr)};
           Value mapped = invokeFunction(callback, callArgs, thisArg);
 
           if (mapped.isArray()) {
             auto inner = mapped.getGC<Array>();
-            result->elements.insert(result->elements.end(),
-                                  inner->elements.begin(),
-                                  inner->elements.end());
+            result->elements().insert(result->elements().end(),
+                                  inner->elements().begin(),
+                                  inner->elements().end());
           } else {
-            result->elements.push_back(mapped);
+            result->pushElement(mapped);
           }
         }
         return Value(result);
       };
       setNativeFnProps(fn, "flatMap", 1);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "fill") {
@@ -10650,29 +11109,29 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         if (args.empty()) return Value(arrPtr);
 
         Value fillValue = args[0];
-        int len = static_cast<int>(arrPtr->elements.size());
+        int len = static_cast<int>(arrPtr->elementCount());
         int start = 0;
         int end = len;
 
         if (args.size() > 1 && args[1].isNumber()) {
-          start = static_cast<int>(std::get<double>(args[1].data));
+          start = static_cast<int>(args[1].asNumber());
           if (start < 0) start = std::max(0, len + start);
           if (start > len) start = len;
         }
 
         if (args.size() > 2 && args[2].isNumber()) {
-          end = static_cast<int>(std::get<double>(args[2].data));
+          end = static_cast<int>(args[2].asNumber());
           if (end < 0) end = std::max(0, len + end);
           if (end > len) end = len;
         }
 
         for (int i = start; i < end; ++i) {
-          arrPtr->elements[i] = fillValue;
+          arrPtr->setElement(i, fillValue);
         }
         return Value(arrPtr);
       };
       setNativeFnProps(fn, "fill", 1);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "copyWithin") {
@@ -10681,32 +11140,32 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       fn->nativeFunc = [arrPtr](const std::vector<Value>& args) -> Value {
         if (args.empty()) return Value(arrPtr);
 
-        int len = static_cast<int>(arrPtr->elements.size());
-        int target = static_cast<int>(std::get<double>(args[0].data));
+        int len = static_cast<int>(arrPtr->elementCount());
+        int target = static_cast<int>(args[0].asNumber());
         if (target < 0) target = std::max(0, len + target);
 
         int start = 0;
         if (args.size() > 1 && args[1].isNumber()) {
-          start = static_cast<int>(std::get<double>(args[1].data));
+          start = static_cast<int>(args[1].asNumber());
           if (start < 0) start = std::max(0, len + start);
         }
 
         int end = len;
         if (args.size() > 2 && args[2].isNumber()) {
-          end = static_cast<int>(std::get<double>(args[2].data));
+          end = static_cast<int>(args[2].asNumber());
           if (end < 0) end = std::max(0, len + end);
         }
 
         int count = std::min(end - start, len - target);
-        std::vector<Value> temp(arrPtr->elements.begin() + start, arrPtr->elements.begin() + start + count);
+        std::vector<Value> temp(arrPtr->elements().begin() + start, arrPtr->elements().begin() + start + count);
 
         for (int i = 0; i < count && target + i < len; ++i) {
-          arrPtr->elements[target + i] = temp[i];
+          arrPtr->setElement(target + i, temp[i]);
         }
         return Value(arrPtr);
       };
       setNativeFnProps(fn, "copyWithin", 2);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "keys") {
@@ -10719,7 +11178,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         nextFn->isNative = true;
         nextFn->nativeFunc = [arrPtr, indexPtr](const std::vector<Value>&) -> Value {
           auto result = GarbageCollector::makeGC<Object>();
-          if (*indexPtr >= arrPtr->elements.size()) {
+          if (*indexPtr >= arrPtr->elementCount()) {
             result->properties["value"] = Value(Undefined{});
             result->properties["done"] = Value(true);
           } else {
@@ -10732,7 +11191,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(iterObj);
       };
       setNativeFnProps(fn, "keys", 0);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "entries") {
@@ -10745,13 +11204,13 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         nextFn->isNative = true;
         nextFn->nativeFunc = [arrPtr, indexPtr](const std::vector<Value>&) -> Value {
           auto result = GarbageCollector::makeGC<Object>();
-          if (*indexPtr >= arrPtr->elements.size()) {
+          if (*indexPtr >= arrPtr->elementCount()) {
             result->properties["value"] = Value(Undefined{});
             result->properties["done"] = Value(true);
           } else {
             auto pair = GarbageCollector::makeGC<Array>();
-            pair->elements.push_back(Value(static_cast<double>(*indexPtr)));
-            pair->elements.push_back(arrPtr->elements[*indexPtr]);
+            pair->pushElement(Value(static_cast<double>(*indexPtr)));
+            pair->pushElement(arrPtr->element(*indexPtr));
             (*indexPtr)++;
             result->properties["value"] = Value(pair);
             result->properties["done"] = Value(false);
@@ -10762,7 +11221,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(iterObj);
       };
       setNativeFnProps(fn, "entries", 0);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "values") {
@@ -10775,11 +11234,11 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         nextFn->isNative = true;
         nextFn->nativeFunc = [arrPtr, indexPtr](const std::vector<Value>&) -> Value {
           auto result = GarbageCollector::makeGC<Object>();
-          if (*indexPtr >= arrPtr->elements.size()) {
+          if (*indexPtr >= arrPtr->elementCount()) {
             result->properties["value"] = Value(Undefined{});
             result->properties["done"] = Value(true);
           } else {
-            result->properties["value"] = arrPtr->elements[(*indexPtr)++];
+            result->properties["value"] = arrPtr->element((*indexPtr)++);
             result->properties["done"] = Value(false);
           }
           return Value(result);
@@ -10788,32 +11247,32 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(iterObj);
       };
       setNativeFnProps(fn, "values", 0);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     arrayProtoLookup:
     auto getterIt = arrPtr->properties.find("__get_" + propName);
     if (getterIt != arrPtr->properties.end() && getterIt->second.isFunction()) {
-      LIGHTJS_RETURN(callFunction(getterIt->second, {}, obj));
+      return callFunction(getterIt->second, {}, obj);
     }
     // Accessor without getter: return undefined (do not fall back to indexed element).
     auto setterIt = arrPtr->properties.find("__set_" + propName);
     if (getterIt != arrPtr->properties.end() || setterIt != arrPtr->properties.end()) {
-      LIGHTJS_RETURN(Value(Undefined{}));
+      return Value(Undefined{});
     }
     size_t idx = 0;
-    if (parseArrayIndex(propName, idx) && idx < arrPtr->elements.size()) {
+    if (parseArrayIndex(propName, idx) && idx < arrPtr->elementCount()) {
       // Check for hole markers
       if (arrPtr->properties.count("__hole_" + propName + "__") ||
           arrPtr->properties.count("__deleted_" + propName + "__")) {
         // Fall through to prototype chain
       } else {
-        LIGHTJS_RETURN(arrPtr->elements[idx]);
+        return arrPtr->element(idx);
       }
     }
     auto propIt = arrPtr->properties.find(propName);
     if (propIt != arrPtr->properties.end()) {
-      LIGHTJS_RETURN(propIt->second);
+      return propIt->second;
     }
 
     // Walk prototype chain (__proto__) for arrays
@@ -10825,7 +11284,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       } else {
         // Fallback: look up Array.prototype from environment
         if (auto arrayCtor = env_->get("Array")) {
-          OrderedMap<std::string, Value>* ctorProps = nullptr;
+          PropertyMap* ctorProps = nullptr;
           if (arrayCtor->isObject()) ctorProps = &arrayCtor->getGC<Object>()->properties;
           else if (arrayCtor->isFunction()) ctorProps = &arrayCtor->getGC<Function>()->properties;
           if (ctorProps) {
@@ -10841,11 +11300,11 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         auto protoGetterIt = proto->properties.find("__get_" + propName);
         if (protoGetterIt != proto->properties.end() && protoGetterIt->second.isFunction()) {
           auto getter = protoGetterIt->second.getGC<Function>();
-          LIGHTJS_RETURN(invokeFunction(getter, {}, obj));
+          return invokeFunction(getter, {}, obj);
         }
         auto found = proto->properties.find(propName);
         if (found != proto->properties.end()) {
-          LIGHTJS_RETURN(found->second);
+          return found->second;
         }
         auto nextProto = proto->properties.find("__proto__");
         if (nextProto == proto->properties.end() || !nextProto->second.isObject()) break;
@@ -10858,12 +11317,12 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
   if (obj.isMap()) {
     auto mapPtr = obj.getGC<Map>();
     if (propName == "size") {
-      LIGHTJS_RETURN(Value(static_cast<double>(mapPtr->size())));
+      return Value(static_cast<double>(mapPtr->size()));
     }
     // Check Map own properties first
     auto ownIt = mapPtr->properties.find(propName);
     if (ownIt != mapPtr->properties.end()) {
-      LIGHTJS_RETURN(ownIt->second);
+      return ownIt->second;
     }
     // Look up from Map.prototype
     if (auto mapCtor = env_->get("Map"); mapCtor && mapCtor->isFunction()) {
@@ -10872,7 +11331,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         auto proto = protoIt->second.getGC<Object>();
         auto methIt = proto->properties.find(propName);
         if (methIt != proto->properties.end()) {
-          LIGHTJS_RETURN(methIt->second);
+          return methIt->second;
         }
       }
     }
@@ -10882,7 +11341,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
     auto wmPtr = obj.getGC<WeakMap>();
     auto ownIt = wmPtr->properties.find(propName);
     if (ownIt != wmPtr->properties.end()) {
-      LIGHTJS_RETURN(ownIt->second);
+      return ownIt->second;
     }
     if (auto wmCtor = env_->get("WeakMap"); wmCtor && wmCtor->isFunction()) {
       auto protoIt = wmCtor->getGC<Function>()->properties.find("prototype");
@@ -10890,7 +11349,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         auto proto = protoIt->second.getGC<Object>();
         auto methIt = proto->properties.find(propName);
         if (methIt != proto->properties.end()) {
-          LIGHTJS_RETURN(methIt->second);
+          return methIt->second;
         }
       }
     }
@@ -10900,7 +11359,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
     auto wsPtr = obj.getGC<WeakSet>();
     auto ownIt = wsPtr->properties.find(propName);
     if (ownIt != wsPtr->properties.end()) {
-      LIGHTJS_RETURN(ownIt->second);
+      return ownIt->second;
     }
     if (auto wsCtor = env_->get("WeakSet"); wsCtor && wsCtor->isFunction()) {
       auto protoIt = wsCtor->getGC<Function>()->properties.find("prototype");
@@ -10908,7 +11367,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         auto proto = protoIt->second.getGC<Object>();
         auto methIt = proto->properties.find(propName);
         if (methIt != proto->properties.end()) {
-          LIGHTJS_RETURN(methIt->second);
+          return methIt->second;
         }
       }
     }
@@ -10917,12 +11376,12 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
   if (obj.isSet()) {
     auto setPtr = obj.getGC<Set>();
     if (propName == "size") {
-      LIGHTJS_RETURN(Value(static_cast<double>(setPtr->size())));
+      return Value(static_cast<double>(setPtr->size()));
     }
     // Check Set own properties first
     auto ownIt = setPtr->properties.find(propName);
     if (ownIt != setPtr->properties.end()) {
-      LIGHTJS_RETURN(ownIt->second);
+      return ownIt->second;
     }
     // Look up from Set.prototype
     if (auto setCtor = env_->get("Set"); setCtor && setCtor->isFunction()) {
@@ -10931,7 +11390,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         auto proto = protoIt->second.getGC<Object>();
         auto methIt = proto->properties.find(propName);
         if (methIt != proto->properties.end()) {
-          LIGHTJS_RETURN(methIt->second);
+          return methIt->second;
         }
       }
     }
@@ -10940,10 +11399,10 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
   if (obj.isTypedArray()) {
     auto [found, value] = getPropertyForPrimitive(obj, propName);
     if (hasError()) {
-      LIGHTJS_RETURN(Value(Undefined{}));
+      return Value(Undefined{});
     }
     if (found) {
-      LIGHTJS_RETURN(value);
+      return value;
     }
   }
 
@@ -10955,11 +11414,11 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       auto getterIt = regexPtr->properties.find("__get_" + propName);
       if (getterIt != regexPtr->properties.end() && getterIt->second.isFunction()) {
         auto getter = getterIt->second.getGC<Function>();
-        LIGHTJS_RETURN(invokeFunction(getter, {}, obj));
+        return invokeFunction(getter, {}, obj);
       }
       auto propIt = regexPtr->properties.find(propName);
       if (propIt != regexPtr->properties.end()) {
-        LIGHTJS_RETURN(propIt->second);
+        return propIt->second;
       }
     }
 
@@ -10970,11 +11429,11 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       while (proto && depth < 50) {
         auto getterIt = proto->properties.find("__get_" + propName);
         if (getterIt != proto->properties.end() && getterIt->second.isFunction()) {
-          LIGHTJS_RETURN(invokeFunction(getterIt->second.getGC<Function>(), {}, obj));
+          return invokeFunction(getterIt->second.getGC<Function>(), {}, obj);
         }
         auto propIt = proto->properties.find(propName);
         if (propIt != proto->properties.end()) {
-          LIGHTJS_RETURN(propIt->second);
+          return propIt->second;
         }
         auto nextProto = proto->properties.find("__proto__");
         if (nextProto == proto->properties.end() || !nextProto->second.isObject()) {
@@ -10987,35 +11446,35 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
 
     // RegExp flag getters (ES spec 21.2.5.*)
     if (propName == "global") {
-      LIGHTJS_RETURN(Value(regexPtr->flags.find('g') != std::string::npos));
+      return Value(regexPtr->flags.find('g') != std::string::npos);
     }
     if (propName == "ignoreCase") {
-      LIGHTJS_RETURN(Value(regexPtr->flags.find('i') != std::string::npos));
+      return Value(regexPtr->flags.find('i') != std::string::npos);
     }
     if (propName == "multiline") {
-      LIGHTJS_RETURN(Value(regexPtr->flags.find('m') != std::string::npos));
+      return Value(regexPtr->flags.find('m') != std::string::npos);
     }
     if (propName == "dotAll") {
-      LIGHTJS_RETURN(Value(regexPtr->flags.find('s') != std::string::npos));
+      return Value(regexPtr->flags.find('s') != std::string::npos);
     }
     if (propName == "unicode") {
-      LIGHTJS_RETURN(Value(regexPtr->flags.find('u') != std::string::npos));
+      return Value(regexPtr->flags.find('u') != std::string::npos);
     }
     if (propName == "unicodeSets") {
-      LIGHTJS_RETURN(Value(regexPtr->flags.find('v') != std::string::npos));
+      return Value(regexPtr->flags.find('v') != std::string::npos);
     }
     if (propName == "sticky") {
-      LIGHTJS_RETURN(Value(regexPtr->flags.find('y') != std::string::npos));
+      return Value(regexPtr->flags.find('y') != std::string::npos);
     }
     if (propName == "hasIndices") {
-      LIGHTJS_RETURN(Value(regexPtr->flags.find('d') != std::string::npos));
+      return Value(regexPtr->flags.find('d') != std::string::npos);
     }
 
     if (propName == "flags") {
-      LIGHTJS_RETURN(Value(canonicalizeRegexFlags(regexPtr->flags)));
+      return Value(canonicalizeRegexFlags(regexPtr->flags));
     }
     if (propName == "source") {
-      LIGHTJS_RETURN(Value(escapeRegexPatternSource(regexPtr->pattern,
+      return (Value(escapeRegexPatternSource(regexPtr->pattern,
                                                     regexPtr->flags)));
     }
     if (propName == "toString") {
@@ -11026,7 +11485,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
                                                       regexPtr->flags);
         return Value(std::string("/") + source + "/" + canonicalizeRegexFlags(regexPtr->flags));
       };
-      LIGHTJS_RETURN(Value(toStringFn));
+      return Value(toStringFn);
     }
 
     if (propName == "test") {
@@ -11111,7 +11570,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(found);
 #endif
       };
-      LIGHTJS_RETURN(Value(testFn));
+      return Value(testFn);
     }
 
     if (propName == "exec") {
@@ -11243,10 +11702,10 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         auto buildSpecialResult = [regexPtr, &str, &utf16IndexFromByteOffset, makeNullProtoObject](
                                       const SpecialRegexMatchResult& special) {
           auto arr = makeArrayWithPrototype();
-          arr->elements.push_back(Value(special.value));
+          arr->pushElement(Value(special.value));
           for (const auto& capture : special.captures) {
-            if (capture.matched) arr->elements.push_back(Value(capture.value));
-            else arr->elements.push_back(Value(Undefined{}));
+            if (capture.matched) arr->pushElement(Value(capture.value));
+            else arr->pushElement(Value(Undefined{}));
           }
           arr->properties["index"] = Value(utf16IndexFromByteOffset(special.index));
           arr->properties["input"] = Value(str);
@@ -11280,14 +11739,14 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
             auto indices = makeArrayWithPrototype();
             auto pushIndexPair = [&](const GCPtr<Array>& target, size_t start, size_t end) {
               auto pair = makeArrayWithPrototype();
-              pair->elements.push_back(Value(utf16IndexFromByteOffset(start)));
-              pair->elements.push_back(Value(utf16IndexFromByteOffset(end)));
-              target->elements.push_back(Value(pair));
+              pair->pushElement(Value(utf16IndexFromByteOffset(start)));
+              pair->pushElement(Value(utf16IndexFromByteOffset(end)));
+              target->pushElement(Value(pair));
             };
             pushIndexPair(indices, special.index, special.end);
             for (const auto& capture : special.captures) {
               if (capture.matched) pushIndexPair(indices, capture.start, capture.end);
-              else indices->elements.push_back(Value(Undefined{}));
+              else indices->pushElement(Value(Undefined{}));
             }
             if (hasNamedCaptures) {
               auto groups = makeNullProtoObject();
@@ -11301,8 +11760,8 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
                 const std::string& name = regexPtr->captureGroupNames[i];
                 if (!name.empty() && special.captures[i].matched) {
                   auto pair = makeArrayWithPrototype();
-                  pair->elements.push_back(Value(utf16IndexFromByteOffset(special.captures[i].start)));
-                  pair->elements.push_back(Value(utf16IndexFromByteOffset(special.captures[i].end)));
+                  pair->pushElement(Value(utf16IndexFromByteOffset(special.captures[i].start)));
+                  pair->pushElement(Value(utf16IndexFromByteOffset(special.captures[i].end)));
                   groups->properties[name] = Value(pair);
                 }
               }
@@ -11390,10 +11849,10 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         }
         if (found) {
           auto arr = makeArrayWithPrototype();
-          arr->elements.push_back(Value(match.str(0)));
+          arr->pushElement(Value(match.str(0)));
           for (size_t i = 1; i < match.size(); ++i) {
-            if (match[i].matched) arr->elements.push_back(Value(match.str(i)));
-            else arr->elements.push_back(Value(Undefined{}));
+            if (match[i].matched) arr->pushElement(Value(match.str(i)));
+            else arr->pushElement(Value(Undefined{}));
           }
           size_t matchIndex = lastIndex + static_cast<size_t>(match.position(0));
           arr->properties["index"] = Value(utf16IndexFromByteOffset(matchIndex));
@@ -11427,9 +11886,9 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
             auto indices = makeArrayWithPrototype();
             auto pushIndexPair = [&](const GCPtr<Array>& target, size_t start, size_t end) {
               auto pair = makeArrayWithPrototype();
-              pair->elements.push_back(Value(utf16IndexFromByteOffset(start)));
-              pair->elements.push_back(Value(utf16IndexFromByteOffset(end)));
-              target->elements.push_back(Value(pair));
+              pair->pushElement(Value(utf16IndexFromByteOffset(start)));
+              pair->pushElement(Value(utf16IndexFromByteOffset(end)));
+              target->pushElement(Value(pair));
             };
             pushIndexPair(indices, matchIndex, matchIndex + static_cast<size_t>(match.length(0)));
             for (size_t i = 1; i < match.size(); ++i) {
@@ -11437,7 +11896,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
                 size_t start = lastIndex + static_cast<size_t>(match.position(i));
                 pushIndexPair(indices, start, start + static_cast<size_t>(match.length(i)));
               } else {
-                indices->elements.push_back(Value(Undefined{}));
+                indices->pushElement(Value(Undefined{}));
               }
             }
             if (hasNamedCaptures) {
@@ -11453,8 +11912,8 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
                 if (!name.empty() && match[i].matched) {
                   size_t start = lastIndex + static_cast<size_t>(match.position(i));
                   auto pair = makeArrayWithPrototype();
-                  pair->elements.push_back(Value(utf16IndexFromByteOffset(start)));
-                  pair->elements.push_back(Value(
+                  pair->pushElement(Value(utf16IndexFromByteOffset(start)));
+                  pair->pushElement(Value(
                       utf16IndexFromByteOffset(start + static_cast<size_t>(match.length(i)))));
                   groups->properties[name] = Value(pair);
                 }
@@ -11475,15 +11934,15 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         }
         return Value(Null{});
       };
-      LIGHTJS_RETURN(Value(execFn));
+      return Value(execFn);
     }
 
     if (propName == "source") {
-      LIGHTJS_RETURN(Value(regexPtr->pattern));
+      return Value(regexPtr->pattern);
     }
 
     if (propName == "flags") {
-      LIGHTJS_RETURN(Value(canonicalizeRegexFlags(regexPtr->flags)));
+      return Value(canonicalizeRegexFlags(regexPtr->flags));
     }
 
     // Walk prototype chain for methods not handled above
@@ -11496,11 +11955,11 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
           auto protoGetterIt = proto->properties.find("__get_" + propName);
           if (protoGetterIt != proto->properties.end() && protoGetterIt->second.isFunction()) {
             auto getter = protoGetterIt->second.getGC<Function>();
-            LIGHTJS_RETURN(invokeFunction(getter, {}, obj));
+            return invokeFunction(getter, {}, obj);
           }
           auto found = proto->properties.find(propName);
           if (found != proto->properties.end()) {
-            LIGHTJS_RETURN(found->second);
+            return found->second;
           }
           auto nextProto = proto->properties.find("__proto__");
           if (nextProto == proto->properties.end() || !nextProto->second.isObject()) break;
@@ -11543,7 +12002,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
           return Value(enumerable);
         };
       }
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     // Own properties + prototype chain
@@ -11551,11 +12010,11 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       auto getterIt = errorPtr->properties.find("__get_" + propName);
       if (getterIt != errorPtr->properties.end() && getterIt->second.isFunction()) {
         auto getter = getterIt->second.getGC<Function>();
-        LIGHTJS_RETURN(invokeFunction(getter, {}, obj));
+        return invokeFunction(getter, {}, obj);
       }
       auto it = errorPtr->properties.find(propName);
       if (it != errorPtr->properties.end()) {
-        LIGHTJS_RETURN(it->second);
+        return it->second;
       }
       auto protoIt = errorPtr->properties.find("__proto__");
       if (protoIt != errorPtr->properties.end() && protoIt->second.isObject()) {
@@ -11565,11 +12024,11 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
           auto protoGetterIt = proto->properties.find("__get_" + propName);
           if (protoGetterIt != proto->properties.end() && protoGetterIt->second.isFunction()) {
             auto getter = protoGetterIt->second.getGC<Function>();
-            LIGHTJS_RETURN(invokeFunction(getter, {}, obj));
+            return invokeFunction(getter, {}, obj);
           }
           auto found = proto->properties.find(propName);
           if (found != proto->properties.end()) {
-            LIGHTJS_RETURN(found->second);
+            return found->second;
           }
           auto nextProto = proto->properties.find("__proto__");
           if (nextProto == proto->properties.end() || !nextProto->second.isObject()) break;
@@ -11585,27 +12044,31 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       toStringFn->nativeFunc = [errorPtr](const std::vector<Value>&) -> Value {
         return Value(errorPtr->toString());
       };
-      LIGHTJS_RETURN(Value(toStringFn));
+      return Value(toStringFn);
     }
 
     if (propName == "name") {
-      LIGHTJS_RETURN(Value(errorPtr->getName()));
+      return Value(errorPtr->getName());
     }
 
     if (propName == "constructor") {
       if (auto ctor = env_->get(errorPtr->getName())) {
-        LIGHTJS_RETURN(*ctor);
+        return *ctor;
       }
-      LIGHTJS_RETURN(Value(Undefined{}));
+      return Value(Undefined{});
     }
 
     if (propName == "message") {
-      LIGHTJS_RETURN(Value(errorPtr->message));
+      return Value(errorPtr->message);
+    }
+
+    if (propName == "stack") {
+      return Value(errorPtr->stack());
     }
   }
 
   if (obj.isNumber()) {
-    double num = std::get<double>(obj.data);
+    double num = obj.asNumber();
 
     if (propName == "toString") {
       auto toStringFn = GarbageCollector::makeGC<Function>();
@@ -11649,7 +12112,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         if (negative) result = "-" + result;
         return Value(result);
       };
-      LIGHTJS_RETURN(Value(toStringFn));
+      return Value(toStringFn);
     }
 
     // Fallback to Number.prototype / Object.prototype for user-defined properties.
@@ -11664,11 +12127,11 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
           depth++;
           auto getterIt = current->properties.find("__get_" + propName);
           if (getterIt != current->properties.end() && getterIt->second.isFunction()) {
-            LIGHTJS_RETURN(callFunction(getterIt->second, {}, obj));
+            return callFunction(getterIt->second, {}, obj);
           }
           auto propIt = current->properties.find(propName);
           if (propIt != current->properties.end()) {
-            LIGHTJS_RETURN(propIt->second);
+            return propIt->second;
           }
           auto nextProto = current->properties.find("__proto__");
           if (nextProto == current->properties.end() || !nextProto->second.isObject()) break;
@@ -11689,11 +12152,11 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
           depth++;
           auto getterIt = current->properties.find("__get_" + propName);
           if (getterIt != current->properties.end() && getterIt->second.isFunction()) {
-            LIGHTJS_RETURN(callFunction(getterIt->second, {}, obj));
+            return callFunction(getterIt->second, {}, obj);
           }
           auto propIt = current->properties.find(propName);
           if (propIt != current->properties.end()) {
-            LIGHTJS_RETURN(propIt->second);
+            return propIt->second;
           }
           auto nextProto = current->properties.find("__proto__");
           if (nextProto == current->properties.end() || !nextProto->second.isObject()) break;
@@ -11709,13 +12172,13 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       }
       auto [found, value] = getPropertyForPrimitive(Value(wrapper), propName);
       if (found) {
-        LIGHTJS_RETURN(value);
+        return value;
       }
     }
   }
 
   if (obj.isString()) {
-    std::string str = std::get<std::string>(obj.data);
+    std::string str = obj.asString();
 
     if (propName == "toString" || propName == "valueOf") {
       auto toStringFn = GarbageCollector::makeGC<Function>();
@@ -11723,12 +12186,12 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       toStringFn->nativeFunc = [str](const std::vector<Value>&) -> Value {
         return Value(str);
       };
-      LIGHTJS_RETURN(Value(toStringFn));
+      return Value(toStringFn);
     }
 
     if (propName == "length") {
       // JavaScript string length is measured in UTF-16 code units.
-      LIGHTJS_RETURN(Value(static_cast<double>(String_utf16Length(str))));
+      return Value(static_cast<double>(String_utf16Length(str)));
     }
 
     // Support numeric indexing for strings (e.g., str[0])
@@ -11738,10 +12201,10 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       size_t index = std::stoul(propName);
       size_t strLen = String_utf16Length(str);
       if (index < strLen) {
-        std::vector<Value> args = {obj, Value(static_cast<double>(index))};
-        LIGHTJS_RETURN(String_charAt(args));
+        Value indexValue(static_cast<double>(index));
+        return invokeFastNative(String_charAt, obj, std::span<const Value>(&indexValue, 1));
       }
-      LIGHTJS_RETURN(Value(Undefined{}));
+      return Value(Undefined{});
     }
 
     if (propName == iteratorKey) {
@@ -11752,7 +12215,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
           auto protoObj = protoIt->second.getGC<Object>();
           auto methodIt = protoObj->properties.find(iteratorKey);
           if (methodIt != protoObj->properties.end() && methodIt->second.isFunction()) {
-            LIGHTJS_RETURN(methodIt->second);
+            return methodIt->second;
           }
         }
       }
@@ -11762,9 +12225,9 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       while (byteIndex < str.size()) {
         size_t start = byteIndex;
         unicode::decodeUTF8(str, byteIndex);
-        charArray->elements.push_back(Value(str.substr(start, byteIndex - start)));
+        charArray->pushElement(Value(str.substr(start, byteIndex - start)));
       }
-      LIGHTJS_RETURN(createIteratorFactory(charArray));
+      return createIteratorFactory(charArray);
     }
 
     if (propName == "includes") {
@@ -11793,7 +12256,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
           }
         }
 
-        std::string s = std::get<std::string>(obj.data);
+        std::string s = obj.asString();
         std::string searchStr = args.empty() ? "undefined" : toStringForStringBuiltinArg(args[0]);
         double pos = 0;
         if (args.size() > 1 && !args[1].isUndefined()) {
@@ -11812,7 +12275,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(haystack.find(searchStr) != std::string::npos);
       };
       setNativeFnProps(fn, "includes", 1);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "repeat") {
@@ -11835,7 +12298,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(result);
       };
       setNativeFnProps(repeatFn, "repeat", 1);
-      LIGHTJS_RETURN(Value(repeatFn));
+      return Value(repeatFn);
     }
 
     if (propName == "padStart") {
@@ -11844,7 +12307,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       fn->nativeFunc = [obj](const std::vector<Value>& args) -> Value {
         // We'll need to implement String_padStart if we want to redirect
         // For now, let's keep it here but fix it to use UTF-16
-        std::string s = std::get<std::string>(obj.data);
+        std::string s = obj.asString();
         if (args.empty()) return Value(s);
         double maxLen = toIntegerForStringBuiltinArg(args[0]);
         if (std::isnan(maxLen) || maxLen < 0) maxLen = 0;
@@ -11866,14 +12329,14 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(pad + s);
       };
       setNativeFnProps(fn, "padStart", 1);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "padEnd") {
       auto fn = GarbageCollector::makeGC<Function>();
       fn->isNative = true;
       fn->nativeFunc = [obj](const std::vector<Value>& args) -> Value {
-        std::string s = std::get<std::string>(obj.data);
+        std::string s = obj.asString();
         if (args.empty()) return Value(s);
         double maxLen = toIntegerForStringBuiltinArg(args[0]);
         if (std::isnan(maxLen) || maxLen < 0) maxLen = 0;
@@ -11893,7 +12356,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(s + pad);
       };
       setNativeFnProps(fn, "padEnd", 1);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "trim") {
@@ -11904,7 +12367,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return String_trim(fullArgs);
       };
       setNativeFnProps(fn, "trim", 0);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "trimStart" || propName == "trimLeft") {
@@ -11914,7 +12377,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(stripLeadingESWhitespace(str));
       };
       setNativeFnProps(fn, propName, 0);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "trimEnd" || propName == "trimRight") {
@@ -11924,7 +12387,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(stripTrailingESWhitespace(str));
       };
       setNativeFnProps(fn, propName, 0);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "split") {
@@ -11936,7 +12399,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return String_split(fullArgs);
       };
       setNativeFnProps(fn, "split", 2);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "startsWith") {
@@ -11961,7 +12424,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
             throw std::runtime_error("TypeError: First argument to String.prototype.startsWith must not be a regular expression");
           }
         }
-        std::string s = std::get<std::string>(obj.data);
+        std::string s = obj.asString();
         std::string searchStr = args.empty() ? "undefined" : toStringForStringBuiltinArg(args[0]);
         double pos = 0;
         if (args.size() > 1 && !args[1].isUndefined()) {
@@ -11973,7 +12436,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(slice == searchStr);
       };
       setNativeFnProps(fn, "startsWith", 1);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "endsWith") {
@@ -11998,7 +12461,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
             throw std::runtime_error("TypeError: First argument to String.prototype.endsWith must not be a regular expression");
           }
         }
-        std::string s = std::get<std::string>(obj.data);
+        std::string s = obj.asString();
         std::string searchStr = args.empty() ? "undefined" : toStringForStringBuiltinArg(args[0]);
         size_t currentLen = unicode::utf16Length(s);
         double e = static_cast<double>(currentLen);
@@ -12012,7 +12475,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(slice == searchStr);
       };
       setNativeFnProps(fn, "endsWith", 1);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "normalize") {
@@ -12029,7 +12492,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(unicode::normalize(str, form));
       };
       setNativeFnProps(fn, "normalize", 0);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     // String.prototype.isWellFormed (ES2024) - check for lone surrogates
@@ -12071,7 +12534,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(true);
       };
       setNativeFnProps(fn, "isWellFormed", 0);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     // String.prototype.toWellFormed (ES2024) - replace lone surrogates with U+FFFD
@@ -12125,7 +12588,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(result);
       };
       setNativeFnProps(fn, "toWellFormed", 0);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "localeCompare") {
@@ -12139,7 +12602,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(static_cast<double>(result < 0 ? -1 : (result > 0 ? 1 : 0)));
       };
       setNativeFnProps(fn, "localeCompare", 1);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "concat") {
@@ -12160,7 +12623,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(result);
       };
       setNativeFnProps(fn, "concat", 1);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "indexOf") {
@@ -12182,7 +12645,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(static_cast<double>(pos));
       };
       setNativeFnProps(fn, "indexOf", 1);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "lastIndexOf") {
@@ -12207,7 +12670,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(static_cast<double>(pos));
       };
       setNativeFnProps(fn, "lastIndexOf", 1);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "search") {
@@ -12219,7 +12682,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return String_search(fullArgs);
       };
       setNativeFnProps(fn, "search", 1);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "match") {
@@ -12231,7 +12694,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return String_match(fullArgs);
       };
       setNativeFnProps(matchFn, "match", 1);
-      LIGHTJS_RETURN(Value(matchFn));
+      return Value(matchFn);
     }
 
     // String.prototype.matchAll - ES2020
@@ -12243,11 +12706,11 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
           auto protoObj = protoIt->second.getGC<Object>();
           auto methodIt = protoObj->properties.find("matchAll");
           if (methodIt != protoObj->properties.end() && methodIt->second.isFunction()) {
-            LIGHTJS_RETURN(methodIt->second);
+            return methodIt->second;
           }
         }
       }
-      LIGHTJS_RETURN(Value(Undefined{}));
+      return Value(Undefined{});
     }
 
     if (propName == "replace") {
@@ -12259,7 +12722,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return String_replace(fullArgs);
       };
       setNativeFnProps(replaceFn, "replace", 2);
-      LIGHTJS_RETURN(Value(replaceFn));
+      return Value(replaceFn);
     }
 
     if (propName == "replaceAll") {
@@ -12270,7 +12733,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return String_replaceAll(args);
       };
       setNativeFnProps(replaceAllFn, "replaceAll", 2);
-      LIGHTJS_RETURN(Value(replaceAllFn));
+      return Value(replaceAllFn);
     }
 
     if (propName == "repeat") {
@@ -12289,7 +12752,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(result);
       };
       setNativeFnProps(repeatFn, "repeat", 1);
-      LIGHTJS_RETURN(Value(repeatFn));
+      return Value(repeatFn);
     }
 
     if (propName == "padStart") {
@@ -12319,7 +12782,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(result + str);
       };
       setNativeFnProps(padStartFn, "padStart", 1);
-      LIGHTJS_RETURN(Value(padStartFn));
+      return Value(padStartFn);
     }
 
     if (propName == "padEnd") {
@@ -12348,7 +12811,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(str + result);
       };
       setNativeFnProps(padEndFn, "padEnd", 1);
-      LIGHTJS_RETURN(Value(padEndFn));
+      return Value(padEndFn);
     }
 
     if (propName == "trim") {
@@ -12358,7 +12821,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(stripESWhitespace(str));
       };
       setNativeFnProps(trimFn, "trim", 0);
-      LIGHTJS_RETURN(Value(trimFn));
+      return Value(trimFn);
     }
 
     if (propName == "trimStart") {
@@ -12368,7 +12831,7 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(stripLeadingESWhitespace(str));
       };
       setNativeFnProps(trimStartFn, "trimStart", 0);
-      LIGHTJS_RETURN(Value(trimStartFn));
+      return Value(trimStartFn);
     }
 
     if (propName == "trimEnd") {
@@ -12378,63 +12841,57 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
         return Value(stripTrailingESWhitespace(str));
       };
       setNativeFnProps(trimEndFn, "trimEnd", 0);
-      LIGHTJS_RETURN(Value(trimEndFn));
+      return Value(trimEndFn);
     }
 
     if (propName == "substring") {
       auto fn = GarbageCollector::makeGC<Function>();
       fn->isNative = true;
       fn->nativeFunc = [obj](const std::vector<Value>& args) -> Value {
-        std::vector<Value> fullArgs = {obj};
-        fullArgs.insert(fullArgs.end(), args.begin(), args.end());
-        return String_substring(fullArgs);
+        return invokeFastNative(String_substring, obj, args);
       };
       setNativeFnProps(fn, "substring", 2);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "slice") {
       auto fn = GarbageCollector::makeGC<Function>();
       fn->isNative = true;
       fn->nativeFunc = [obj](const std::vector<Value>& args) -> Value {
-        std::vector<Value> fullArgs = {obj};
-        fullArgs.insert(fullArgs.end(), args.begin(), args.end());
-        return String_slice(fullArgs);
+        return invokeFastNative(String_slice, obj, args);
       };
       setNativeFnProps(fn, "slice", 2);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "substr") {
       auto fn = GarbageCollector::makeGC<Function>();
       fn->isNative = true;
       fn->nativeFunc = [obj](const std::vector<Value>& args) -> Value {
-        std::vector<Value> fullArgs = {obj};
-        fullArgs.insert(fullArgs.end(), args.begin(), args.end());
-        return String_substr(fullArgs);
+        return invokeFastNative(String_substr, obj, args);
       };
       setNativeFnProps(fn, "substr", 2);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "toUpperCase" || propName == "toLocaleUpperCase") {
       auto fn = GarbageCollector::makeGC<Function>();
       fn->isNative = true;
       fn->nativeFunc = [str](const std::vector<Value>& args) -> Value {
-        return String_toUpperCase({Value(str)});
+        return invokeFastNative(String_toUpperCase, Value(str), {});
       };
       setNativeFnProps(fn, propName, 0);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     if (propName == "toLowerCase" || propName == "toLocaleLowerCase") {
       auto fn = GarbageCollector::makeGC<Function>();
       fn->isNative = true;
       fn->nativeFunc = [str](const std::vector<Value>& args) -> Value {
-        return String_toLowerCase({Value(str)});
+        return invokeFastNative(String_toLowerCase, Value(str), {});
       };
       setNativeFnProps(fn, propName, 0);
-      LIGHTJS_RETURN(Value(fn));
+      return Value(fn);
     }
 
     // Fallback to String.prototype for user-defined properties.
@@ -12448,12 +12905,12 @@ Task Interpreter::evaluateMember(const MemberExpr& expr) {
       }
       auto [found, value] = getPropertyForPrimitive(Value(wrapper), propName);
       if (found) {
-        LIGHTJS_RETURN(value);
+        return value;
       }
     }
   }
 
-  LIGHTJS_RETURN(Value(Undefined{}));
+  return Value(Undefined{});
 }
 
 Value Interpreter::makeIteratorResult(const Value& value, bool done) {
@@ -12485,10 +12942,10 @@ Value Interpreter::createIteratorFactory(const GCPtr<Array>& arrPtr) {
     auto nextFn = GarbageCollector::makeGC<Function>();
     nextFn->isNative = true;
     nextFn->nativeFunc = [arrPtr, state](const std::vector<Value>&) -> Value {
-      if (!arrPtr || *state >= arrPtr->elements.size()) {
+      if (!arrPtr || *state >= arrPtr->elementCount()) {
         return Interpreter::makeIteratorResult(Value(Undefined{}), true);
       }
-      Value value = arrPtr->elements[(*state)++];
+      Value value = arrPtr->element((*state)++);
       return Interpreter::makeIteratorResult(value, false);
     };
     iteratorObj->properties["next"] = Value(nextFn);
@@ -12535,7 +12992,7 @@ Value Interpreter::runGeneratorNext(const GCPtr<Generator>& genPtr,
       }
     } privateOwnerClassGuard{this, prevPrivateOwnerClass, prevActiveFunction};
 
-    auto bodyPtr = std::static_pointer_cast<std::vector<StmtPtr>>(genPtr->function->body);
+    auto bodyPtr = std::static_pointer_cast<std::vector<StmtPtr>>(genPtr->function->shared->body);
     
     // Resume or start the generator coroutine
     auto prevFlow = flow_;
@@ -12741,7 +13198,7 @@ std::optional<Interpreter::IteratorRecord> Interpreter::getIterator(const Value&
     }
     if (value.isString()) {
       record.kind = IteratorRecord::Kind::String;
-      record.stringValue = std::get<std::string>(value.data);
+      record.stringValue = value.asString();
       record.index = 0;
       return record;
     }
@@ -12758,14 +13215,13 @@ std::optional<Interpreter::IteratorRecord> Interpreter::getIterator(const Value&
       auto nextFn = GarbageCollector::makeGC<Function>();
       nextFn->isNative = true;
       nextFn->nativeFunc = [mapPtr, indexPtr](const std::vector<Value>&) -> Value {
-        if (*indexPtr >= mapPtr->entries.size()) {
+        const auto* entry = mapPtr->table.next(*indexPtr);
+        if (!entry) {
           return makeIteratorResult(Value(Undefined{}), true);
         }
-        auto& entry = mapPtr->entries[*indexPtr];
         auto pair = GarbageCollector::makeGC<Array>();
-        pair->elements.push_back(entry.first);
-        pair->elements.push_back(entry.second);
-        (*indexPtr)++;
+        pair->pushElement(entry->key);
+        pair->pushElement(entry->value);
         return makeIteratorResult(Value(pair), false);
       };
       iterObj->properties["next"] = Value(nextFn);
@@ -12781,12 +13237,11 @@ std::optional<Interpreter::IteratorRecord> Interpreter::getIterator(const Value&
       auto nextFn = GarbageCollector::makeGC<Function>();
       nextFn->isNative = true;
       nextFn->nativeFunc = [setPtr, indexPtr](const std::vector<Value>&) -> Value {
-        if (*indexPtr >= setPtr->values.size()) {
+        const auto* entry = setPtr->table.next(*indexPtr);
+        if (!entry) {
           return makeIteratorResult(Value(Undefined{}), true);
         }
-        Value val = setPtr->values[*indexPtr];
-        (*indexPtr)++;
-        return makeIteratorResult(val, false);
+        return makeIteratorResult(entry->key, false);
       };
       iterObj->properties["next"] = Value(nextFn);
       record.kind = IteratorRecord::Kind::IteratorObject;
@@ -13046,7 +13501,7 @@ Value Interpreter::iteratorNext(IteratorRecord& record) {
       return runGeneratorNext(
         record.generator, ControlFlow::ResumeMode::Next, Value(Undefined{}));
     case IteratorRecord::Kind::Array: {
-      if (!record.array || record.index >= record.array->elements.size()) {
+      if (!record.array || record.index >= record.array->elementCount()) {
         return makeIteratorResult(Value(Undefined{}), true);
       }
       // Check for getter on this index (e.g., Object.defineProperty(arr, '0', {get: ...}))
@@ -13057,7 +13512,7 @@ Value Interpreter::iteratorNext(IteratorRecord& record) {
         Value value = callFunction(getterIt->second, {}, Value(record.array));
         return makeIteratorResult(value, false);
       }
-      Value value = record.array->elements[record.index++];
+      Value value = record.array->element(record.index++);
       return makeIteratorResult(value, false);
     }
     case IteratorRecord::Kind::String: {
@@ -13154,6 +13609,9 @@ Value Interpreter::callFunction(const Value& callee, const std::vector<Value>& a
   }
 
   auto func = callee.getGC<Function>();
+  if (func->fastNative) {
+    return callFastNative(*func, thisValue, args);
+  }
   std::vector<Value> currentArgs = args;
   Value currentThis = thisValue;
   auto namedExprIt = func->properties.find("__named_expression__");
@@ -13218,7 +13676,7 @@ Value Interpreter::callFunction(const Value& callee, const std::vector<Value>& a
         GarbageCollector::instance().reportAllocation(sizeof(Object));
         wrapper->properties["__primitive_value__"] = boundThis;
         if (boundThis.isString()) {
-          const std::string& s = std::get<std::string>(boundThis.data);
+          const std::string& s = boundThis.asString();
           wrapper->properties["length"] = Value(static_cast<double>(String_utf16Length(s)));
           wrapper->properties["__non_writable_length"] = Value(true);
           wrapper->properties["__non_enum_length"] = Value(true);
@@ -13311,11 +13769,13 @@ Value Interpreter::callFunction(const Value& callee, const std::vector<Value>& a
       }
     }
 
+    // Only functions that can observe `arguments` (see resolveScopes) get one.
+    bool needsArguments = !isArrowFunction && func->shared->usesArguments;
     GCPtr<Array> argumentsArray;
-    if (!isArrowFunction) {
+    if (needsArguments) {
       argumentsArray = GarbageCollector::makeGC<Array>();
       GarbageCollector::instance().reportAllocation(sizeof(Array));
-      argumentsArray->elements = currentArgs;
+      argumentsArray->assignElements(currentArgs);
       // Mark as an arguments object (internal, non-observable via builtins).
       argumentsArray->properties["__is_arguments_object__"] = Value(true);
       // Set arguments [[Prototype]] to Object.prototype
@@ -13326,9 +13786,9 @@ Value Interpreter::callFunction(const Value& callee, const std::vector<Value>& a
         }
       }
       // Determine if parameters are simple (no defaults, no rest, no destructuring)
-      bool hasSimpleParamsForCallee = !func->restParam.has_value();
+      bool hasSimpleParamsForCallee = !func->shared->restParam.has_value();
       if (hasSimpleParamsForCallee) {
-        for (const auto& p : func->params) {
+        for (const auto& p : func->shared->params) {
           if (p.defaultValue || p.name.empty() ||
               (p.name.size() > 8 && p.name.substr(0, 8) == "__param_")) {
             hasSimpleParamsForCallee = false; break;
@@ -13376,21 +13836,21 @@ Value Interpreter::callFunction(const Value& callee, const std::vector<Value>& a
     }
 
     // Parameter bindings are created before evaluating default initializers.
-    for (const auto& param : func->params) {
+    for (const auto& param : func->shared->params) {
       targetEnv->defineTDZ(param.name);
     }
-    if (func->restParam.has_value()) {
-      targetEnv->defineTDZ(*func->restParam);
+    if (func->shared->restParam.has_value()) {
+      targetEnv->defineTDZ(*func->shared->restParam);
     }
 
-    for (size_t i = 0; i < func->params.size(); ++i) {
+    for (size_t i = 0; i < func->shared->params.size(); ++i) {
       Value paramValue = (i < currentArgs.size()) ? currentArgs[i] : Value(Undefined{});
 
-      if (func->params[i].defaultValue && paramValue.isUndefined()) {
+      if (func->shared->params[i].defaultValue && paramValue.isUndefined()) {
         auto prevParamInitEval = activeParameterInitializerEvaluation_;
         activeParameterInitializerEvaluation_ = true;
 
-        auto defaultExpr = std::static_pointer_cast<Expression>(func->params[i].defaultValue);
+        auto defaultExpr = std::static_pointer_cast<Expression>(func->shared->params[i].defaultValue);
         auto defaultTask = evaluate(*defaultExpr);
         LIGHTJS_RUN_TASK_SYNC(defaultTask, paramValue);
         activeParameterInitializerEvaluation_ = prevParamInitEval;
@@ -13400,22 +13860,22 @@ Value Interpreter::callFunction(const Value& callee, const std::vector<Value>& a
         }
       }
 
-      targetEnv->define(func->params[i].name, paramValue);
+      targetEnv->define(func->shared->params[i].name, paramValue);
     }
 
     // Mapped arguments: in sloppy mode with simple params, create getters
     // so formal param changes are reflected when iterating arguments
-    if (!isArrowFunction && !func->isStrict && !func->restParam.has_value()) {
+    if (needsArguments && !func->isStrict && !func->shared->restParam.has_value()) {
       bool hasSimpleParams = true;
-      for (const auto& p : func->params) {
+      for (const auto& p : func->shared->params) {
         if (p.defaultValue || p.name.empty() ||
             (p.name.size() > 8 && p.name.substr(0, 8) == "__param_")) {
           hasSimpleParams = false; break;
         }
       }
       if (hasSimpleParams) {
-        for (size_t i = 0; i < func->params.size() && i < currentArgs.size(); ++i) {
-          std::string paramName = func->params[i].name;
+        for (size_t i = 0; i < func->shared->params.size() && i < currentArgs.size(); ++i) {
+          std::string paramName = func->shared->params[i].name;
           std::string idxStr = std::to_string(i);
           argumentsArray->properties["__mapped_arg_index_" + idxStr + "__"] = Value(true);
           auto getter = GarbageCollector::makeGC<Function>();
@@ -13438,19 +13898,19 @@ Value Interpreter::callFunction(const Value& callee, const std::vector<Value>& a
       }
     }
 
-    if (func->restParam.has_value()) {
+    if (func->shared->restParam.has_value()) {
       auto restArr = GarbageCollector::makeGC<Array>();
       GarbageCollector::instance().reportAllocation(sizeof(Array));
       setArrayPrototype(restArr, env_.get());
-      for (size_t i = func->params.size(); i < currentArgs.size(); ++i) {
-        restArr->elements.push_back(currentArgs[i]);
+      for (size_t i = func->shared->params.size(); i < currentArgs.size(); ++i) {
+        restArr->pushElement(currentArgs[i]);
       }
-      targetEnv->define(*func->restParam, Value(restArr));
+      targetEnv->define(*func->shared->restParam, Value(restArr));
     }
 
     // Execute destructuring prologue if present
-    if (func->destructurePrologue) {
-      auto prologuePtr = std::static_pointer_cast<std::vector<StmtPtr>>(func->destructurePrologue);
+    if (func->shared->destructurePrologue) {
+      auto prologuePtr = std::static_pointer_cast<std::vector<StmtPtr>>(func->shared->destructurePrologue);
       for (const auto& stmt : *prologuePtr) {
         auto stmtTask = evaluate(*stmt);
         Value stmtResult = Value(Undefined{});
@@ -13520,7 +13980,7 @@ Value Interpreter::callFunction(const Value& callee, const std::vector<Value>& a
       }
       if (argumentsList.isArray()) {
         auto arr = argumentsList.getGC<Array>();
-        constructArgs = arr->elements;
+        constructArgs = arr->elements();
       } else {
         auto [foundLen, lenValue] = getPropertyForExternal(argumentsList, "length");
         if (flow_.type == ControlFlow::Type::Throw) {
@@ -13565,6 +14025,7 @@ Value Interpreter::callFunction(const Value& callee, const std::vector<Value>& a
       pendingDirectEvalCall_ = false;
     }
 
+    GlobalInterpreterScope interpreterScope(this);
     try {
       auto itUsesThis = func->properties.find("__uses_this_arg__");
       Value nativeResult = Value(Undefined{});
@@ -13586,26 +14047,7 @@ Value Interpreter::callFunction(const Value& callee, const std::vector<Value>& a
       return Value(Undefined{});
     } catch (const std::exception& e) {
       activeDirectEvalInvocation_ = prevActiveDirectEvalInvocation;
-      std::string message = e.what();
-      ErrorType errorType = ErrorType::Error;
-      auto consumePrefix = [&](const std::string& prefix, ErrorType type) {
-        if (message.rfind(prefix, 0) == 0) {
-          errorType = type;
-          message = message.substr(prefix.size());
-          return true;
-        }
-        return false;
-      };
-      if (!consumePrefix("TypeError: ", ErrorType::TypeError) &&
-          !consumePrefix("ReferenceError: ", ErrorType::ReferenceError) &&
-          !consumePrefix("RangeError: ", ErrorType::RangeError) &&
-          !consumePrefix("SyntaxError: ", ErrorType::SyntaxError) &&
-          !consumePrefix("URIError: ", ErrorType::URIError) &&
-          !consumePrefix("EvalError: ", ErrorType::EvalError) &&
-          !consumePrefix("Error: ", ErrorType::Error)) {
-        errorType = ErrorType::Error;
-      }
-      throwError(errorType, message);
+      throwNativeException(e);
       return Value(Undefined{});
     }
   }
@@ -13621,7 +14063,7 @@ Value Interpreter::callFunction(const Value& callee, const std::vector<Value>& a
       }
     }
     genEnv = genEnv->createChild();
-    genEnv->define("__var_scope__", Value(true), true);
+    genEnv->markVarScope();
     auto prevEnv2 = env_;
     bool prevStrict2 = strictMode_;
     auto prevFlow2 = flow_;
@@ -13636,7 +14078,7 @@ Value Interpreter::callFunction(const Value& callee, const std::vector<Value>& a
     }
 
     bool hasParameterExpressions = false;
-    for (const auto& param : func->params) {
+    for (const auto& param : func->shared->params) {
       if (param.defaultValue) {
         hasParameterExpressions = true;
         break;
@@ -13647,7 +14089,7 @@ Value Interpreter::callFunction(const Value& callee, const std::vector<Value>& a
     }
     env_ = genEnv;
 
-    auto bodyPtr = std::static_pointer_cast<std::vector<StmtPtr>>(func->body);
+    auto bodyPtr = std::static_pointer_cast<std::vector<StmtPtr>>(func->shared->body);
     for (const auto& s : *bodyPtr) {
       if (auto* varDecl = std::get_if<VarDeclaration>(&s->node)) {
         if (varDecl->kind == VarDeclaration::Kind::Let ||
@@ -13701,7 +14143,7 @@ Value Interpreter::callFunction(const Value& callee, const std::vector<Value>& a
 
   if (func->isAsync) {
     // Push stack frame for async function calls
-    auto stackFrame = pushStackFrame("<async>");
+    auto stackFrame = pushStackFrame(func->shared.get(), "<async>");
 
     auto initializePromiseIntrinsics = [&](const GCPtr<Promise>& p) {
       if (!p) return;
@@ -13733,7 +14175,7 @@ Value Interpreter::callFunction(const Value& callee, const std::vector<Value>& a
       }
     }
     env_ = env_->createChild();
-    env_->define("__var_scope__", Value(true), true);
+    env_->markVarScope();
 
     flow_.reset();
     bindParameters(env_);
@@ -13754,7 +14196,7 @@ Value Interpreter::callFunction(const Value& callee, const std::vector<Value>& a
     flow_ = prevFlow;
 
     bool hasParameterExpressions = false;
-    for (const auto& param : func->params) {
+    for (const auto& param : func->shared->params) {
       if (param.defaultValue) {
         hasParameterExpressions = true;
         break;
@@ -13764,7 +14206,7 @@ Value Interpreter::callFunction(const Value& callee, const std::vector<Value>& a
       env_ = env_->createChild();
     }
 
-    auto bodyPtr = std::static_pointer_cast<std::vector<StmtPtr>>(func->body);
+    auto bodyPtr = std::static_pointer_cast<std::vector<StmtPtr>>(func->shared->body);
     bool previousStrictMode = strictMode_;
     strictMode_ = func->isStrict;
 
@@ -13967,10 +14409,14 @@ Value Interpreter::callFunction(const Value& callee, const std::vector<Value>& a
   }
 
   // Push stack frame for JavaScript function calls
-  auto stackFrame = pushStackFrame("<function>");
+  auto stackFrame = pushStackFrame(func->shared.get(), "<function>");
+
+  if (auto* bytecode = prepareBytecode(func, currentThis)) {
+    return runBytecodeFunction(func, *bytecode, std::move(currentArgs), currentThis, pushNamedExpr);
+  }
 
   auto prevEnv = env_;
-  auto bodyPtr = std::static_pointer_cast<std::vector<StmtPtr>>(func->body);
+  auto bodyPtr = std::static_pointer_cast<std::vector<StmtPtr>>(func->shared->body);
   bool previousStrictMode = strictMode_;
   strictMode_ = func->isStrict;
   Value result = Value(Undefined{});
@@ -13996,13 +14442,13 @@ Value Interpreter::callFunction(const Value& callee, const std::vector<Value>& a
       }
     }
     env_ = env_->createChild();
-    env_->define("__var_scope__", Value(true), true);
+    env_->markVarScope();
     bindParameters(env_);
     if (flow_.type == ControlFlow::Type::Throw) {
       break;
     }
     bool hasParameterExpressions = false;
-    for (const auto& param : func->params) {
+    for (const auto& param : func->shared->params) {
       if (param.defaultValue) {
         hasParameterExpressions = true;
         break;
@@ -14106,7 +14552,7 @@ Task Interpreter::evaluateArray(const ArrayExpr& expr) {
   // Set __proto__ to Array.prototype for prototype chain resolution
   auto arrCtor = env_->get("Array");
   if (arrCtor) {
-    OrderedMap<std::string, Value>* ctorProps = nullptr;
+    PropertyMap* ctorProps = nullptr;
     if (arrCtor->isFunction()) {
       ctorProps = &std::get<GCPtr<Function>>(arrCtor->data)->properties;
     } else if (arrCtor->isObject()) {
@@ -14123,8 +14569,8 @@ Task Interpreter::evaluateArray(const ArrayExpr& expr) {
   for (const auto& elem : expr.elements) {
     // Handle holes (elision) - nullptr elements are sparse holes
     if (!elem) {
-      size_t holeIdx = arr->elements.size();
-      arr->elements.push_back(Value(Undefined{}));
+      size_t holeIdx = arr->elementCount();
+      arr->pushElement(Value(Undefined{}));
       arr->properties["__hole_" + std::to_string(holeIdx) + "__"] = Value(true);
       continue;
     }
@@ -14181,12 +14627,12 @@ Task Interpreter::evaluateArray(const ArrayExpr& expr) {
             nextValue = valueIt->second;
           }
         }
-        arr->elements.push_back(nextValue);
+        arr->pushElement(nextValue);
       }
     } else {
       auto task = evaluate(*elem);
       LIGHTJS_RUN_TASK_VOID(task);
-      arr->elements.push_back(task.result());
+      arr->pushElement(task.result());
     }
   }
   LIGHTJS_RETURN(Value(arr));
@@ -14204,7 +14650,7 @@ Task Interpreter::evaluateObject(const ObjectExpr& expr) {
   // Set __proto__ to Object.prototype for prototype chain resolution
   auto objCtor = env_->get("Object");
   if (objCtor) {
-    OrderedMap<std::string, Value>* ctorProps = nullptr;
+    PropertyMap* ctorProps = nullptr;
     if (objCtor->isFunction()) {
       ctorProps = &std::get<GCPtr<Function>>(objCtor->data)->properties;
     } else if (objCtor->isObject()) {
@@ -14247,7 +14693,7 @@ Task Interpreter::evaluateObject(const ObjectExpr& expr) {
             }
             if (ownKeysResult.isArray()) {
               auto keyArr = ownKeysResult.getGC<Array>();
-              for (const auto& keyVal : keyArr->elements) {
+              for (const auto& keyVal : keyArr->elements()) {
                 keys.push_back(toPropertyKeyString(keyVal));
               }
             }
@@ -14590,21 +15036,7 @@ Task Interpreter::evaluateFunction(const FunctionExpr& expr) {
   func->isGenerator = expr.isGenerator;
   func->isStrict = strictMode_ || hasUseStrictDirective(expr.body);
 
-  for (const auto& param : expr.params) {
-    FunctionParam funcParam;
-    funcParam.name = param.name.name;
-    if (param.defaultValue) {
-      funcParam.defaultValue = std::shared_ptr<void>(const_cast<Expression*>(param.defaultValue.get()), [](void*){});
-    }
-    func->params.push_back(funcParam);
-  }
-
-  if (expr.restParam.has_value()) {
-    func->restParam = expr.restParam->name;
-  }
-
-  func->body = std::shared_ptr<void>(const_cast<std::vector<StmtPtr>*>(&expr.body), [](void*){});
-  func->destructurePrologue = std::shared_ptr<void>(const_cast<std::vector<StmtPtr>*>(&expr.destructurePrologue), [](void*){});
+  func->shared = sharedFunctionInfo(expr);
   // If evaluating in an eval context, keep the AST alive
   if (sourceKeepAlive_) {
     func->astOwner = sourceKeepAlive_;
@@ -14613,19 +15045,12 @@ Task Interpreter::evaluateFunction(const FunctionExpr& expr) {
   if (activePrivateOwnerClass_) {
     func->properties["__private_owner_class__"] = Value(activePrivateOwnerClass_);
   }
-  // Compute length: number of params before first default parameter
-  size_t funcLength = 0;
-  for (const auto& param : expr.params) {
-    if (param.defaultValue) break;
-    funcLength++;
-  }
-  func->properties["length"] = Value(static_cast<double>(funcLength));
+  func->properties["length"] = Value(static_cast<double>(func->shared->length));
   func->properties["__non_writable_length"] = Value(true);
   func->properties["__non_enum_length"] = Value(true);
   func->properties["name"] = Value(expr.name);
   func->properties["__non_writable_name"] = Value(true);
   func->properties["__non_enum_name"] = Value(true);
-  func->sourceText = expr.sourceText;
   if (expr.isArrow) {
     func->properties["__is_arrow_function__"] = Value(true);
   }
@@ -14791,7 +15216,7 @@ Task Interpreter::evaluateAwait(const AwaitExpr& expr) {
     }
     awaitedPromise->properties["__await_suspend__"] = Value(true);
     flow_.setYieldWithoutAsyncAwait(Value(awaitedPromise));
-    co_await YieldAwaiter{Value(awaitedPromise)};
+    co_await YieldAwaiter{};
 
     auto resumeMode = flow_.takeResumeMode();
     Value resumeValue = flow_.takeResumeValue();
@@ -14959,12 +15384,12 @@ Task Interpreter::evaluateYield(const YieldExpr& expr) {
           value = valueVal;
         }
         flow_.setYieldWithoutAsyncAwait(value);
-        co_await YieldAwaiter{value};
+        co_await YieldAwaiter{};
       } else {
         // Delegation continues: yield the iterator result object itself (no eager
         // access of `.value`).
         flow_.setYieldIteratorResult(innerResult);
-        co_await YieldAwaiter{innerResult};
+        co_await YieldAwaiter{};
       }
 
       resumeMode = flow_.takeResumeMode();
@@ -14977,7 +15402,7 @@ Task Interpreter::evaluateYield(const YieldExpr& expr) {
 
   // Normal yield
   flow_.setYield(yieldedValue);
-  co_await YieldAwaiter{yieldedValue};
+  co_await YieldAwaiter{};
 
   auto mode = flow_.takeResumeMode();
   Value resumeValue = flow_.takeResumeValue();
@@ -15369,7 +15794,7 @@ Task Interpreter::initializeClassInstanceElements(const GCPtr<Class>& cls, Value
   auto prevEnv = env_;
   env_ = cls->closure;
   env_ = env_->createChild();
-  env_->define("__var_scope__", Value(true), true);
+  env_->markVarScope();
   env_->define("this", receiver);
   env_->define("__in_class_field_initializer__", Value(true), true);
   Value instanceSuperBase = getInstanceFieldSuperBase(cls);
@@ -15417,7 +15842,7 @@ Task Interpreter::initializeClassStaticFields(const GCPtr<Class>& cls,
   auto prevEnv = env_;
   env_ = cls->closure;
   env_ = env_->createChild();
-  env_->define("__var_scope__", Value(true), true);
+  env_->markVarScope();
   env_->define("this", Value(cls));
   env_->define("__in_class_field_initializer__", Value(true), true);
   Value staticSuperBase = getStaticFieldSuperBase(cls);
@@ -15513,7 +15938,7 @@ Task Interpreter::constructValue(Value callee, std::vector<Value> args, Value ne
         auto trap = trapIt->second.getGC<Function>();
         // Create args array
         auto argsArray = GarbageCollector::makeGC<Array>();
-        argsArray->elements = args;
+        argsArray->assignElements(args);
         // Call construct trap: handler.construct(target, argumentsList, newTarget)
         std::vector<Value> trapArgs = {*proxyPtr->target, Value(argsArray), effectiveNewTarget};
         Value result;
@@ -15650,7 +16075,7 @@ Task Interpreter::constructValue(Value callee, std::vector<Value> args, Value ne
     wrapper->properties["__primitive_value__"] = primitive;
     if (primitive.isString()) {
       // String exotic object: numeric indexed properties + length
-      const std::string& s = std::get<std::string>(primitive.data);
+      const std::string& s = primitive.asString();
       size_t strLen = String_utf16Length(s);
       for (size_t i = 0; i < strLen; i++) {
         std::string idx = std::to_string(i);
@@ -15731,7 +16156,7 @@ Task Interpreter::constructValue(Value callee, std::vector<Value> args, Value ne
       } strictModeScopeGuard{this, previousStrictMode};
       env_ = cls->closure;
       env_ = env_->createChild();
-      env_->define("__var_scope__", Value(true), true);
+      env_->markVarScope();
       strictMode_ = cls->constructor->isStrict;
       if (derivedConstructor) {
         env_->define("__super_called__", Value(false));
@@ -15778,51 +16203,53 @@ Task Interpreter::constructValue(Value callee, std::vector<Value> args, Value ne
       }
 
       // Bind `arguments` for the constructor body.
-      auto argumentsArray = GarbageCollector::makeGC<Array>();
-      GarbageCollector::instance().reportAllocation(sizeof(Array));
-      argumentsArray->elements = args;
-      auto throwTypeErrorAccessor = getRealmThrowTypeErrorAccessor(env_.get());
-      if (!throwTypeErrorAccessor) {
-        throwTypeErrorAccessor = GarbageCollector::makeGC<Function>();
-        throwTypeErrorAccessor->isNative = true;
-        throwTypeErrorAccessor->nativeFunc = [](const std::vector<Value>&) -> Value {
-          throw std::runtime_error(
-            "TypeError: 'caller', 'callee', and 'arguments' properties may not be accessed");
-        };
-      }
-      argumentsArray->properties["__get_callee"] = Value(throwTypeErrorAccessor);
-      argumentsArray->properties["__set_callee"] = Value(throwTypeErrorAccessor);
-      argumentsArray->properties["__non_enum_callee"] = Value(true);
-      if (auto objProtoVal = env_->getRoot()->get("__object_prototype__");
-          objProtoVal && objProtoVal->isObject()) {
-        argumentsArray->properties["__proto__"] = *objProtoVal;
+      if (cls->constructor->shared->usesArguments) {
+        auto argumentsArray = GarbageCollector::makeGC<Array>();
+        GarbageCollector::instance().reportAllocation(sizeof(Array));
+        argumentsArray->assignElements(args);
+        auto throwTypeErrorAccessor = getRealmThrowTypeErrorAccessor(env_.get());
+        if (!throwTypeErrorAccessor) {
+          throwTypeErrorAccessor = GarbageCollector::makeGC<Function>();
+          throwTypeErrorAccessor->isNative = true;
+          throwTypeErrorAccessor->nativeFunc = [](const std::vector<Value>&) -> Value {
+            throw std::runtime_error(
+              "TypeError: 'caller', 'callee', and 'arguments' properties may not be accessed");
+          };
+        }
+        argumentsArray->properties["__get_callee"] = Value(throwTypeErrorAccessor);
+        argumentsArray->properties["__set_callee"] = Value(throwTypeErrorAccessor);
+        argumentsArray->properties["__non_enum_callee"] = Value(true);
+        if (auto objProtoVal = env_->getRoot()->get("__object_prototype__");
+            objProtoVal && objProtoVal->isObject()) {
+          argumentsArray->properties["__proto__"] = *objProtoVal;
+        }
+        env_->define("arguments", Value(argumentsArray));
       }
-      env_->define("arguments", Value(argumentsArray));
 
       // Bind parameters
       auto func = cls->constructor;
-      for (size_t i = 0; i < func->params.size(); ++i) {
+      for (size_t i = 0; i < func->shared->params.size(); ++i) {
         if (i < args.size()) {
-          env_->define(func->params[i].name, args[i]);
-        } else if (func->params[i].defaultValue) {
-          auto defaultExpr = std::static_pointer_cast<Expression>(func->params[i].defaultValue);
+          env_->define(func->shared->params[i].name, args[i]);
+        } else if (func->shared->params[i].defaultValue) {
+          auto defaultExpr = std::static_pointer_cast<Expression>(func->shared->params[i].defaultValue);
           auto defaultTask = evaluate(*defaultExpr);
           LIGHTJS_RUN_TASK_VOID(defaultTask);
-          env_->define(func->params[i].name, defaultTask.result());
+          env_->define(func->shared->params[i].name, defaultTask.result());
         } else {
-          env_->define(func->params[i].name, Value(Undefined{}));
+          env_->define(func->shared->params[i].name, Value(Undefined{}));
         }
       }
 
       // Handle rest parameter
-      if (func->restParam.has_value()) {
+      if (func->shared->restParam.has_value()) {
         auto restArr = GarbageCollector::makeGC<Array>();
         GarbageCollector::instance().reportAllocation(sizeof(Array));
         setArrayPrototype(restArr, env_.get());
-        for (size_t i = func->params.size(); i < args.size(); ++i) {
-          restArr->elements.push_back(args[i]);
+        for (size_t i = func->shared->params.size(); i < args.size(); ++i) {
+          restArr->pushElement(args[i]);
         }
-        env_->define(*func->restParam, Value(restArr));
+        env_->define(*func->shared->restParam, Value(restArr));
       }
 
       // Set __constructor__ before any instance element initialization.
@@ -15840,7 +16267,7 @@ Task Interpreter::constructValue(Value callee, std::vector<Value> args, Value ne
       }
 
       // Execute constructor body
-      auto bodyPtr = std::static_pointer_cast<std::vector<StmtPtr>>(func->body);
+      auto bodyPtr = std::static_pointer_cast<std::vector<StmtPtr>>(func->shared->body);
 
       initializeLexicalDeclarations(*bodyPtr);
 
@@ -15936,7 +16363,7 @@ Task Interpreter::constructValue(Value callee, std::vector<Value> args, Value ne
         auto p = finalThis.getGC<Promise>();
         p->properties["constructor"] = callee;
       } else if (finalThis.isObject() &&
-                 finalThis.getGC<Object>().get() != instance) {
+                 finalThis.getGC<Object>().get() != instance.get()) {
         auto obj = finalThis.getGC<Object>();
         obj->properties["constructor"] = callee;
       } else if (finalThis.isArray()) {
@@ -16061,7 +16488,7 @@ Task Interpreter::constructValue(Value callee, std::vector<Value> args, Value ne
         if (auto boundArgsIt = func->properties.find("__bound_args__");
             boundArgsIt != func->properties.end() && boundArgsIt->second.isArray()) {
           auto boundArgsArr = boundArgsIt->second.getGC<Array>();
-          finalArgs = boundArgsArr->elements;
+          finalArgs = boundArgsArr->elements();
         }
         finalArgs.insert(finalArgs.end(), args.begin(), args.end());
         // For `new boundFn(...)`, newTarget defaults to the bound function itself.
@@ -16080,6 +16507,7 @@ Task Interpreter::constructValue(Value callee, std::vector<Value> args, Value ne
       }
       // Native constructors (e.g., Array, Object, Map, etc.)
       Value constructed(Undefined{});
+      GlobalInterpreterScope interpreterScope(this);
       try {
         auto nativeConstructIt = func->properties.find("__native_construct__");
         if (nativeConstructIt != func->properties.end() && nativeConstructIt->second.isFunction()) {
@@ -16201,7 +16629,7 @@ Task Interpreter::constructValue(Value callee, std::vector<Value> args, Value ne
     auto prevActiveFunction = activeFunction_;
     env_ = func->closure;
     env_ = env_->createChild();
-    env_->define("__var_scope__", Value(true), true);
+    env_->markVarScope();
     activeFunction_ = func;
     struct ConstructorActiveFunctionGuard {
       Interpreter* interpreter;
@@ -16225,68 +16653,71 @@ Task Interpreter::constructValue(Value callee, std::vector<Value> args, Value ne
     env_->define("__new_target__", effectiveNewTarget);
 
     // Bind `arguments` for the constructor body.
-    auto argumentsArray = GarbageCollector::makeGC<Array>();
-    GarbageCollector::instance().reportAllocation(sizeof(Array));
-    argumentsArray->elements = args;
-    // Determine if parameters are simple
-    bool hasSimpleParamsForCtor = !func->restParam.has_value();
-    if (hasSimpleParamsForCtor) {
-      for (const auto& p : func->params) {
-        if (p.defaultValue || p.name.empty() ||
-            (p.name.size() > 8 && p.name.substr(0, 8) == "__param_")) {
-          hasSimpleParamsForCtor = false; break;
+    GCPtr<Array> argumentsArray;
+    if (func->shared->usesArguments) {
+      argumentsArray = GarbageCollector::makeGC<Array>();
+      GarbageCollector::instance().reportAllocation(sizeof(Array));
+      argumentsArray->assignElements(args);
+      // Determine if parameters are simple
+      bool hasSimpleParamsForCtor = !func->shared->restParam.has_value();
+      if (hasSimpleParamsForCtor) {
+        for (const auto& p : func->shared->params) {
+          if (p.defaultValue || p.name.empty() ||
+              (p.name.size() > 8 && p.name.substr(0, 8) == "__param_")) {
+            hasSimpleParamsForCtor = false; break;
+          }
         }
       }
-    }
-    if (func->isStrict || !hasSimpleParamsForCtor) {
-      auto throwTypeErrorAccessor = getRealmThrowTypeErrorAccessor(env_.get());
-      if (!throwTypeErrorAccessor) {
-        throwTypeErrorAccessor = GarbageCollector::makeGC<Function>();
-        throwTypeErrorAccessor->isNative = true;
-        throwTypeErrorAccessor->nativeFunc = [](const std::vector<Value>&) -> Value {
-          throw std::runtime_error("TypeError: 'caller', 'callee', and 'arguments' properties may not be accessed");
-        };
+      if (func->isStrict || !hasSimpleParamsForCtor) {
+        auto throwTypeErrorAccessor = getRealmThrowTypeErrorAccessor(env_.get());
+        if (!throwTypeErrorAccessor) {
+          throwTypeErrorAccessor = GarbageCollector::makeGC<Function>();
+          throwTypeErrorAccessor->isNative = true;
+          throwTypeErrorAccessor->nativeFunc = [](const std::vector<Value>&) -> Value {
+            throw std::runtime_error("TypeError: 'caller', 'callee', and 'arguments' properties may not be accessed");
+          };
+        }
+        argumentsArray->properties["__get_callee"] = Value(throwTypeErrorAccessor);
+        argumentsArray->properties["__set_callee"] = Value(throwTypeErrorAccessor);
+        argumentsArray->properties["__non_configurable_callee"] = Value(true);
+      } else {
+        argumentsArray->properties["callee"] = callee;
       }
-      argumentsArray->properties["__get_callee"] = Value(throwTypeErrorAccessor);
-      argumentsArray->properties["__set_callee"] = Value(throwTypeErrorAccessor);
-      argumentsArray->properties["__non_configurable_callee"] = Value(true);
-    } else {
-      argumentsArray->properties["callee"] = callee;
-    }
-    argumentsArray->properties["__non_enum_callee"] = Value(true);
-    if (auto objProtoVal = env_->getRoot()->get("__object_prototype__");
-        objProtoVal && objProtoVal->isObject()) {
-      argumentsArray->properties["__proto__"] = *objProtoVal;
+      argumentsArray->properties["__non_enum_callee"] = Value(true);
+      if (auto objProtoVal = env_->getRoot()->get("__object_prototype__");
+          objProtoVal && objProtoVal->isObject()) {
+        argumentsArray->properties["__proto__"] = *objProtoVal;
+      }
+      env_->define("arguments", Value(argumentsArray));
     }
-    env_->define("arguments", Value(argumentsArray));
 
     // Bind parameters
-    for (size_t i = 0; i < func->params.size(); ++i) {
+    for (size_t i = 0; i < func->shared->params.size(); ++i) {
       if (i < args.size()) {
-        env_->define(func->params[i].name, args[i]);
-      } else if (func->params[i].defaultValue) {
-        auto defaultExpr = std::static_pointer_cast<Expression>(func->params[i].defaultValue);
+        env_->define(func->shared->params[i].name, args[i]);
+      } else if (func->shared->params[i].defaultValue) {
+        auto defaultExpr = std::static_pointer_cast<Expression>(func->shared->params[i].defaultValue);
         auto defaultTask = evaluate(*defaultExpr);
         LIGHTJS_RUN_TASK_VOID(defaultTask);
-        env_->define(func->params[i].name, defaultTask.result());
+        env_->define(func->shared->params[i].name, defaultTask.result());
       } else {
-        env_->define(func->params[i].name, Value(Undefined{}));
+        env_->define(func->shared->params[i].name, Value(Undefined{}));
       }
     }
 
     // Mapped arguments: in sloppy mode with simple params and no rest parameter,
     // keep `arguments[i]` and the corresponding formal parameter in sync.
-    if (!func->isStrict && !func->restParam.has_value()) {
+    if (argumentsArray && !func->isStrict && !func->shared->restParam.has_value()) {
       bool hasSimpleParams = true;
-      for (const auto& p : func->params) {
+      for (const auto& p : func->shared->params) {
         if (p.defaultValue || p.name.empty() ||
             (p.name.size() > 8 && p.name.substr(0, 8) == "__param_")) {
           hasSimpleParams = false; break;
         }
       }
       if (hasSimpleParams) {
-        for (size_t i = 0; i < func->params.size() && i < args.size(); ++i) {
-          std::string paramName = func->params[i].name;
+        for (size_t i = 0; i < func->shared->params.size() && i < args.size(); ++i) {
+          std::string paramName = func->shared->params[i].name;
           std::string idxStr = std::to_string(i);
           argumentsArray->properties["__mapped_arg_index_" + idxStr + "__"] = Value(true);
           auto getter = GarbageCollector::makeGC<Function>();
@@ -16310,18 +16741,18 @@ Task Interpreter::constructValue(Value callee, std::vector<Value> args, Value ne
     }
 
     // Handle rest parameter
-    if (func->restParam.has_value()) {
+    if (func->shared->restParam.has_value()) {
       auto restArr = GarbageCollector::makeGC<Array>();
       GarbageCollector::instance().reportAllocation(sizeof(Array));
       setArrayPrototype(restArr, env_.get());
-      for (size_t i = func->params.size(); i < args.size(); ++i) {
-        restArr->elements.push_back(args[i]);
+      for (size_t i = func->shared->params.size(); i < args.size(); ++i) {
+        restArr->pushElement(args[i]);
       }
-      env_->define(*func->restParam, Value(restArr));
+      env_->define(*func->shared->restParam, Value(restArr));
     }
 
     // Execute function body
-    auto bodyPtr = std::static_pointer_cast<std::vector<StmtPtr>>(func->body);
+    auto bodyPtr = std::static_pointer_cast<std::vector<StmtPtr>>(func->shared->body);
 
     initializeLexicalDeclarations(*bodyPtr);
 
@@ -16879,41 +17310,14 @@ Task Interpreter::evaluateClass(const ClassExpr& expr) {
       func->properties["__home_object__"] = Value(classPrototype);
     }
 
-    size_t methodLength = 0;
-    bool sawDefault = false;
-    for (const auto& param : method.params) {
-      FunctionParam funcParam;
-      funcParam.name = param.name.name;
-      if (param.defaultValue) {
-        funcParam.defaultValue = std::shared_ptr<void>(
-            const_cast<Expression*>(param.defaultValue.get()),
-            [](void*) {});
-        sawDefault = true;
-      } else if (!sawDefault) {
-        methodLength++;
-      }
-      func->params.push_back(funcParam);
-    }
-    if (method.restParam.has_value()) {
-      func->restParam = method.restParam->name;
-    }
-
-    // Store the body - we need to cast away const for the shared_ptr
-    func->body = std::shared_ptr<void>(
-      const_cast<std::vector<StmtPtr>*>(&method.body),
-      [](void*){} // No-op deleter since we don't own the memory
-    );
-    func->destructurePrologue = std::shared_ptr<void>(
-      const_cast<std::vector<StmtPtr>*>(&method.destructurePrologue),
-      [](void*){} // No-op deleter
-    );
-    func->properties["length"] = Value(static_cast<double>(methodLength));
+    func->shared = sharedFunctionInfo(method);
+    func->properties["length"] = Value(static_cast<double>(func->shared->length));
     if (method.kind == MethodDefinition::Kind::Constructor) {
       func->properties["name"] = Value(std::string("constructor"));
     } else {
       std::string baseName;
       if (propKeyForName.isSymbol()) {
-        const auto& sym = std::get<Symbol>(propKeyForName.data);
+        const auto& sym = propKeyForName.asSymbol();
         baseName = sym.description.empty() ? "" : "[" + sym.description + "]";
       } else {
         baseName = toPropertyKeyString(propKeyForName);
@@ -16996,7 +17400,7 @@ Task Interpreter::evaluateClass(const ClassExpr& expr) {
   }
 
   // Set length property (constructor parameter count)
-  int ctorLen = cls->constructor ? (int)cls->constructor->params.size() : 0;
+  int ctorLen = cls->constructor ? (int)cls->constructor->shared->params.size() : 0;
   if (cls->properties.find("length") == cls->properties.end() &&
       cls->properties.find("__get_length") == cls->properties.end() &&
       cls->properties.find("__set_length") == cls->properties.end()) {
@@ -17024,7 +17428,7 @@ Task Interpreter::evaluateClass(const ClassExpr& expr) {
     bool prevStrict = strictMode_;
     env_ = cls->closure;
     env_ = env_->createChild();
-    env_->define("__var_scope__", Value(true), true);
+    env_->markVarScope();
     env_->define("this", Value(cls));
     env_->define("__new_target__", Value(Undefined{}));
     auto superIt = cls->properties.find("__proto__");
@@ -17131,7 +17535,7 @@ Task Interpreter::bindDestructuringPattern(const Expression& pattern, Value valu
 
   if (auto* id = std::get_if<Identifier>(&pattern.node)) {
     // Check TDZ before assignment (e.g., assigning to `let` variable before its declaration)
-    if (useSet && env_->isTDZ(id->name)) {
+    if (useSet && !id->tdzFree && env_->isTDZ(id->name)) {
       throwError(ErrorType::ReferenceError,
                  "Cannot access '" + id->name + "' before initialization");
       LIGHTJS_RETURN(Value(Undefined{}));
@@ -17356,16 +17760,16 @@ Task Interpreter::bindDestructuringPattern(const Expression& pattern, Value valu
         }
         size_t index = 0;
         if (parseArrayIndex(key, index)) {
-          if (index < arr->elements.size()) {
+          if (index < arr->elementCount()) {
             if (receiver.isArray()) {
               auto recvArr = receiver.getGC<Array>();
-              if (index >= recvArr->elements.size()) {
+              if (index >= recvArr->elementCount()) {
                 if (!growDenseArrayForIndex(recvArr, index)) {
                   throwError(ErrorType::RangeError, "Array index exceeds implementation limit");
                   return false;
                 }
               }
-              recvArr->elements[index] = assigned;
+              recvArr->setElement(index, assigned);
               return true;
             }
             return false;
@@ -17389,13 +17793,13 @@ Task Interpreter::bindDestructuringPattern(const Expression& pattern, Value valu
         if (receiver.isArray()) {
           auto recvArr = receiver.getGC<Array>();
           if (parseArrayIndex(key, index)) {
-            if (index >= recvArr->elements.size()) {
+            if (index >= recvArr->elementCount()) {
               if (!growDenseArrayForIndex(recvArr, index)) {
                 throwError(ErrorType::RangeError, "Array index exceeds implementation limit");
                 return false;
               }
             }
-            recvArr->elements[index] = assigned;
+            recvArr->setElement(index, assigned);
           } else {
             recvArr->properties[key] = assigned;
           }
@@ -17522,17 +17926,17 @@ Task Interpreter::bindDestructuringPattern(const Expression& pattern, Value valu
               auto valIt = stepObj->properties.find("value");
               elemVal = (valIt != stepObj->properties.end()) ? valIt->second : Value(Undefined{});
             }
-            arr->elements.push_back(elemVal);
+            arr->pushElement(elemVal);
             if (i >= needed && !hasRest) break;
           }
         }
       }
     } else if (value.isString()) {
       // Strings are iterable - convert to array of chars
-      auto str = std::get<std::string>(value.data);
+      auto str = value.asString();
       arr = GarbageCollector::makeGC<Array>();
       for (size_t i = 0; i < str.size(); ++i) {
-        arr->elements.push_back(Value(std::string(1, str[i])));
+        arr->pushElement(Value(std::string(1, str[i])));
       }
     } else if (value.isGenerator()) {
       // Generators are iterable - lazily iterate via next()
@@ -17552,7 +17956,7 @@ Task Interpreter::bindDestructuringPattern(const Expression& pattern, Value valu
         auto doneIt2 = stepObj->properties.find("done");
         if (doneIt2 != stepObj->properties.end() && doneIt2->second.toBool()) { genExhausted = true; break; }
         auto valIt = stepObj->properties.find("value");
-        arr->elements.push_back(valIt != stepObj->properties.end() ? valIt->second : Value(Undefined{}));
+        arr->pushElement(valIt != stepObj->properties.end() ? valIt->second : Value(Undefined{}));
         if (i >= needed && !hasRest) break;
       }
       // Per spec: IteratorClose if iterator not exhausted after destructuring.
@@ -17583,7 +17987,7 @@ Task Interpreter::bindDestructuringPattern(const Expression& pattern, Value valu
           break;
         }
         auto valIt = stepObj->properties.find("value");
-        arr->elements.push_back(valIt != stepObj->properties.end() ? valIt->second : Value(Undefined{}));
+        arr->pushElement(valIt != stepObj->properties.end() ? valIt->second : Value(Undefined{}));
         if (i >= needed && !hasRest) break;
       }
       if (needed > 0 && !hasRest && !exhausted) {
@@ -17740,8 +18144,8 @@ Task Interpreter::bindDestructuringPattern(const Expression& pattern, Value valu
                   auto arrRef = objVal.getGC<Array>();
                   if (memberTarget->computed) {
                     size_t idx = static_cast<size_t>(std::stod(prop));
-                    if (idx < arrRef->elements.size()) {
-                      arrRef->elements[idx] = elemValue;
+                    if (idx < arrRef->elementCount()) {
+                      arrRef->setElement(idx, elemValue);
                     }
                   }
                 }
@@ -17799,7 +18203,7 @@ Task Interpreter::bindDestructuringPattern(const Expression& pattern, Value valu
                   Value v = advanceIterator();
                   if (flow_.type == ControlFlow::Type::Throw) LIGHTJS_RETURN(Value(Undefined{}));
                   if (iteratorDone) break;
-                  restArr->elements.push_back(v);
+                  restArr->pushElement(v);
                 }
 
                 // Bind to pre-evaluated reference
@@ -17819,8 +18223,8 @@ Task Interpreter::bindDestructuringPattern(const Expression& pattern, Value valu
                   auto arrRef = objVal.getGC<Array>();
                   if (memberTarget->computed) {
                     size_t idx = static_cast<size_t>(std::stod(prop));
-                    if (idx < arrRef->elements.size()) {
-                      arrRef->elements[idx] = Value(restArr);
+                    if (idx < arrRef->elementCount()) {
+                      arrRef->setElement(idx, Value(restArr));
                     }
                   }
                 }
@@ -17833,7 +18237,7 @@ Task Interpreter::bindDestructuringPattern(const Expression& pattern, Value valu
                   Value v = advanceIterator();
                   if (flow_.type == ControlFlow::Type::Throw) LIGHTJS_RETURN(Value(Undefined{}));
                   if (iteratorDone) break;
-                  restArr->elements.push_back(v);
+                  restArr->pushElement(v);
                 }
                 { auto t = bindDestructuringPattern(*restActualTarget, Value(restArr), isConst, useSet); LIGHTJS_RUN_TASK_VOID(t); }
                 if (flow_.type != ControlFlow::Type::None && flow_.type != ControlFlow::Type::Yield) { closeOnAbrupt(); LIGHTJS_RETURN(Value(Undefined{})); }
@@ -17864,7 +18268,7 @@ Task Interpreter::bindDestructuringPattern(const Expression& pattern, Value valu
     for (size_t i = 0; i < arrayPat->elements.size(); ++i) {
       if (!arrayPat->elements[i]) continue;  // Skip holes
 
-      Value elemValue = (i < arr->elements.size()) ? arr->elements[i] : Value(Undefined{});
+      Value elemValue = (i < arr->elementCount()) ? arr->element(i) : Value(Undefined{});
 
       // Recursively bind (handles nested patterns)
       { auto t = bindDestructuringPattern(*arrayPat->elements[i], elemValue, isConst, useSet); LIGHTJS_RUN_TASK_VOID(t); }
@@ -17875,8 +18279,8 @@ Task Interpreter::bindDestructuringPattern(const Expression& pattern, Value valu
     if (arrayPat->rest) {
       auto restArr = GarbageCollector::makeGC<Array>();
       setArrayPrototype(restArr, env_.get());
-      for (size_t i = arrayPat->elements.size(); i < arr->elements.size(); ++i) {
-        restArr->elements.push_back(arr->elements[i]);
+      for (size_t i = arrayPat->elements.size(); i < arr->elementCount(); ++i) {
+        restArr->pushElement(arr->element(i));
       }
       { auto t = bindDestructuringPattern(*arrayPat->rest, Value(restArr), isConst, useSet); LIGHTJS_RUN_TASK_VOID(t); }
     }
@@ -17893,13 +18297,13 @@ Task Interpreter::bindDestructuringPattern(const Expression& pattern, Value valu
       // Convert array to object-like representation for destructuring
       auto arr = value.getGC<Array>();
       obj = GarbageCollector::makeGC<Object>();
-      for (size_t i = 0; i < arr->elements.size(); ++i) {
-        obj->properties[std::to_string(i)] = arr->elements[i];
+      for (size_t i = 0; i < arr->elementCount(); ++i) {
+        obj->properties[std::to_string(i)] = arr->element(i);
       }
-      obj->properties["length"] = Value(static_cast<double>(arr->elements.size()));
+      obj->properties["length"] = Value(static_cast<double>(arr->elementCount()));
     } else if (value.isString()) {
       // Convert string to object-like representation for destructuring
-      auto str = std::get<std::string>(value.data);
+      auto str = value.asString();
       obj = GarbageCollector::makeGC<Object>();
       for (size_t i = 0; i < str.size(); ++i) {
         obj->properties[std::to_string(i)] = Value(std::string(1, str[i]));
@@ -18115,8 +18519,8 @@ Task Interpreter::bindDestructuringPattern(const Expression& pattern, Value valu
         } else if (targetObjVal.isArray() && memberComputed) {
           auto targetArr = targetObjVal.getGC<Array>();
           size_t idx = static_cast<size_t>(std::stod(targetProp));
-          if (idx < targetArr->elements.size()) {
-            targetArr->elements[idx] = propValue;
+          if (idx < targetArr->elementCount()) {
+            targetArr->setElement(idx, propValue);
           }
         }
         if (flow_.type == ControlFlow::Type::Throw) LIGHTJS_RETURN(Value(Undefined{}));
@@ -18148,7 +18552,7 @@ Task Interpreter::bindDestructuringPattern(const Expression& pattern, Value valu
               }
               if (ownKeysResult.isArray()) {
                 auto keyArr = ownKeysResult.getGC<Array>();
-                for (const auto& keyVal : keyArr->elements) {
+                for (const auto& keyVal : keyArr->elements()) {
                   keys.push_back(toPropertyKeyString(keyVal));
                 }
               }
@@ -18294,9 +18698,98 @@ Task Interpreter::bindDestructuringPattern(const Expression& pattern, Value valu
 
   LIGHTJS_RETURN(Value(Undefined{}));}
 
+void setFastNative(Function& func, FastNativeFunction fn, bool usesThis) {
+  func.isNative = true;
+  func.fastNative = fn;
+  if (usesThis) {
+    func.properties["__uses_this_arg__"] = Value(true);
+  }
+  func.nativeFunc = [fn, usesThis](const std::vector<Value>& args) -> Value {
+    std::span<const Value> rest(args);
+    Value thisValue(Undefined{});
+    if (usesThis && !rest.empty()) {
+      thisValue = rest.front();
+      rest = rest.subspan(1);
+    }
+    return invokeFastNative(fn, thisValue, rest);
+  };
+}
+
+Value invokeFastNative(FastNativeFunction fn, const Value& thisValue, std::span<const Value> args) {
+  Interpreter* interpreter = getGlobalInterpreter();
+  if (!interpreter) {
+    throw std::runtime_error("TypeError: Native function called without an active interpreter");
+  }
+  NativeThrow thrown;
+  Value result = fn(thisValue, args, *interpreter, thrown);
+  if (thrown.pending) {
+    if (thrown.value) {
+      throw JsValueException(*thrown.value);
+    }
+    throw std::runtime_error(Error(thrown.type).getName() + ": " + thrown.message);
+  }
+  return result;
+}
+
+// Natives report JS errors as exceptions whose message carries the error
+// name ("TypeError: ..."); anything unprefixed becomes a plain Error.
+void Interpreter::throwNativeException(const std::exception& e) {
+  std::string message = e.what();
+  ErrorType errorType = ErrorType::Error;
+  auto consumePrefix = [&](const std::string& prefix, ErrorType type) {
+    if (message.rfind(prefix, 0) == 0) {
+      errorType = type;
+      message = message.substr(prefix.size());
+      return true;
+    }
+    return false;
+  };
+  if (!consumePrefix("TypeError: ", ErrorType::TypeError) &&
+      !consumePrefix("ReferenceError: ", ErrorType::ReferenceError) &&
+      !consumePrefix("RangeError: ", ErrorType::RangeError) &&
+      !consumePrefix("SyntaxError: ", ErrorType::SyntaxError) &&
+      !consumePrefix("URIError: ", ErrorType::URIError) &&
+      !consumePrefix("EvalError: ", ErrorType::EvalError) &&
+      !consumePrefix("Error: ", ErrorType::Error)) {
+    errorType = ErrorType::Error;
+  }
+  throwError(errorType, message);
+}
+
+Value Interpreter::callFastNative(const Function& func, const Value& thisValue,
+                                  std::span<const Value> args) {
+  GlobalInterpreterScope interpreterScope(this);
+  NativeThrow thrown;
+  Value result;
+  try {
+    result = func.fastNative(thisValue, args, *this, thrown);
+  } catch (const JsValueException& e) {
+    flow_.type = ControlFlow::Type::Throw;
+    flow_.value = e.value();
+    return Value(Undefined{});
+  } catch (const std::exception& e) {
+    throwNativeException(e);
+    return Value(Undefined{});
+  }
+  if (thrown.pending) {
+    if (thrown.value) {
+      flow_.type = ControlFlow::Type::Throw;
+      flow_.value = std::move(*thrown.value);
+    } else {
+      throwError(thrown.type, thrown.message);
+    }
+    return Value(Undefined{});
+  }
+  return result;
+}
+
 // Helper to invoke a JavaScript function synchronously (used by native array methods for callbacks)
 Value Interpreter::invokeFunction(GCPtr<Function> func, const std::vector<Value>& args, const Value& thisValue) {
+  if (func->fastNative) {
+    return callFastNative(*func, thisValue, args);
+  }
   if (func->isNative) {
+    GlobalInterpreterScope interpreterScope(this);
     try {
       auto itUsesThis = func->properties.find("__uses_this_arg__");
       if (itUsesThis != func->properties.end() && itUsesThis->second.isBool() && itUsesThis->second.toBool()) {
@@ -18312,26 +18805,7 @@ Value Interpreter::invokeFunction(GCPtr<Function> func, const std::vector<Value>
       flow_.value = e.value();
       return Value(Undefined{});
     } catch (const std::exception& e) {
-      std::string message = e.what();
-      ErrorType errorType = ErrorType::Error;
-      auto consumePrefix = [&](const std::string& prefix, ErrorType type) {
-        if (message.rfind(prefix, 0) == 0) {
-          errorType = type;
-          message = message.substr(prefix.size());
-          return true;
-        }
-        return false;
-      };
-      if (!consumePrefix("TypeError: ", ErrorType::TypeError) &&
-          !consumePrefix("ReferenceError: ", ErrorType::ReferenceError) &&
-          !consumePrefix("RangeError: ", ErrorType::RangeError) &&
-          !consumePrefix("SyntaxError: ", ErrorType::SyntaxError) &&
-          !consumePrefix("URIError: ", ErrorType::URIError) &&
-          !consumePrefix("EvalError: ", ErrorType::EvalError) &&
-          !consumePrefix("Error: ", ErrorType::Error)) {
-        errorType = ErrorType::Error;
-      }
-      throwError(errorType, message);
+      throwNativeException(e);
       return Value(Undefined{});
     }
   }
@@ -18363,7 +18837,7 @@ Value Interpreter::invokeFunction(GCPtr<Function> func, const std::vector<Value>
   auto prevEnv = env_;
   env_ = func->closure;
   env_ = env_->createChild();
-  env_->define("__var_scope__", Value(true), true);
+  env_->markVarScope();
 
   bool isArrowFunction = false;
   auto arrowIt = func->properties.find("__is_arrow_function__");
@@ -18434,10 +18908,10 @@ Value Interpreter::invokeFunction(GCPtr<Function> func, const std::vector<Value>
     }
   }
 
-  if (!isArrowFunction) {
+  if (!isArrowFunction && func->shared->usesArguments) {
     auto argumentsArray = GarbageCollector::makeGC<Array>();
     GarbageCollector::instance().reportAllocation(sizeof(Array));
-    argumentsArray->elements = args;
+    argumentsArray->assignElements(args);
     argumentsArray->properties["__is_arguments_object__"] = Value(true);
     // Set arguments [[Prototype]] to Object.prototype
     if (auto objCtor = env_->get("Object"); objCtor.has_value() && objCtor->isFunction()) {
@@ -18447,9 +18921,9 @@ Value Interpreter::invokeFunction(GCPtr<Function> func, const std::vector<Value>
       }
     }
     // Determine if parameters are simple
-    bool hasSimpleParamsForArgs = !func->restParam.has_value();
+    bool hasSimpleParamsForArgs = !func->shared->restParam.has_value();
     if (hasSimpleParamsForArgs) {
-      for (const auto& p : func->params) {
+      for (const auto& p : func->shared->params) {
         if (p.defaultValue || p.name.empty() ||
             (p.name.size() > 8 && p.name.substr(0, 8) == "__param_")) {
           hasSimpleParamsForArgs = false; break;
@@ -18479,16 +18953,16 @@ Value Interpreter::invokeFunction(GCPtr<Function> func, const std::vector<Value>
     }
     env_->define("arguments", Value(argumentsArray));
   }
-  if (func->restParam.has_value()) {
-    env_->defineTDZ(*func->restParam);
+  if (func->shared->restParam.has_value()) {
+    env_->defineTDZ(*func->shared->restParam);
   }
 
-  for (size_t i = 0; i < func->params.size(); ++i) {
+  for (size_t i = 0; i < func->shared->params.size(); ++i) {
     Value paramValue = (i < args.size()) ? args[i] : Value(Undefined{});
-    if (func->params[i].defaultValue && paramValue.isUndefined()) {
+    if (func->shared->params[i].defaultValue && paramValue.isUndefined()) {
       auto prevParamInitEval = activeParameterInitializerEvaluation_;
       activeParameterInitializerEvaluation_ = true;
-      auto defaultExpr = std::static_pointer_cast<Expression>(func->params[i].defaultValue);
+      auto defaultExpr = std::static_pointer_cast<Expression>(func->shared->params[i].defaultValue);
       auto defaultTask = evaluate(*defaultExpr);
       LIGHTJS_RUN_TASK_VOID_SYNC(defaultTask);
       activeParameterInitializerEvaluation_ = prevParamInitEval;
@@ -18496,25 +18970,25 @@ Value Interpreter::invokeFunction(GCPtr<Function> func, const std::vector<Value>
         env_ = prevEnv;
         return Value(Undefined{});
       }
-      env_->define(func->params[i].name, defaultTask.result());
+      env_->define(func->shared->params[i].name, defaultTask.result());
     } else {
-      env_->define(func->params[i].name, paramValue);
+      env_->define(func->shared->params[i].name, paramValue);
     }
   }
 
   // Handle rest parameter
-  if (func->restParam.has_value()) {
+  if (func->shared->restParam.has_value()) {
     auto restArr = GarbageCollector::makeGC<Array>();
     GarbageCollector::instance().reportAllocation(sizeof(Array));
     setArrayPrototype(restArr, env_.get());
-    for (size_t i = func->params.size(); i < args.size(); ++i) {
-      restArr->elements.push_back(args[i]);
+    for (size_t i = func->shared->params.size(); i < args.size(); ++i) {
+      restArr->pushElement(args[i]);
     }
-    env_->define(*func->restParam, Value(restArr));
+    env_->define(*func->shared->restParam, Value(restArr));
   }
 
-  if (func->destructurePrologue) {
-    auto prologuePtr = std::static_pointer_cast<std::vector<StmtPtr>>(func->destructurePrologue);
+  if (func->shared->destructurePrologue) {
+    auto prologuePtr = std::static_pointer_cast<std::vector<StmtPtr>>(func->shared->destructurePrologue);
     for (const auto& stmt : *prologuePtr) {
       auto stmtTask = evaluate(*stmt);
       Value stmtResult = Value(Undefined{});
@@ -18527,7 +19001,7 @@ Value Interpreter::invokeFunction(GCPtr<Function> func, const std::vector<Value>
   }
 
   bool hasParameterExpressions = false;
-  for (const auto& param : func->params) {
+  for (const auto& param : func->shared->params) {
     if (param.defaultValue) {
       hasParameterExpressions = true;
       break;
@@ -18538,7 +19012,7 @@ Value Interpreter::invokeFunction(GCPtr<Function> func, const std::vector<Value>
   }
 
   // Execute function body
-  auto bodyPtr = std::static_pointer_cast<std::vector<StmtPtr>>(func->body);
+  auto bodyPtr = std::static_pointer_cast<std::vector<StmtPtr>>(func->shared->body);
   bool previousStrictMode = strictMode_;
   strictMode_ = func->isStrict;
 
@@ -18801,21 +19275,7 @@ Task Interpreter::evaluateFuncDecl(const FunctionDeclaration& decl) {
   func->isGenerator = decl.isGenerator;
   func->isStrict = strictMode_ || hasUseStrictDirective(decl.body);
 
-  for (const auto& param : decl.params) {
-    FunctionParam funcParam;
-    funcParam.name = param.name.name;
-    if (param.defaultValue) {
-      funcParam.defaultValue = std::shared_ptr<void>(const_cast<Expression*>(param.defaultValue.get()), [](void*){});
-    }
-    func->params.push_back(funcParam);
-  }
-
-  if (decl.restParam.has_value()) {
-    func->restParam = decl.restParam->name;
-  }
-
-  func->body = std::shared_ptr<void>(const_cast<std::vector<StmtPtr>*>(&decl.body), [](void*){});
-  func->destructurePrologue = std::shared_ptr<void>(const_cast<std::vector<StmtPtr>*>(&decl.destructurePrologue), [](void*){});
+  func->shared = sharedFunctionInfo(decl);
   // If evaluating in an eval context, keep the AST alive
   if (sourceKeepAlive_) {
     func->astOwner = sourceKeepAlive_;
@@ -18824,19 +19284,12 @@ Task Interpreter::evaluateFuncDecl(const FunctionDeclaration& decl) {
   if (activePrivateOwnerClass_) {
     func->properties["__private_owner_class__"] = Value(activePrivateOwnerClass_);
   }
-  // Compute length: number of params before first default parameter
-  size_t funcDeclLen = 0;
-  for (const auto& param : decl.params) {
-    if (param.defaultValue) break;
-    funcDeclLen++;
-  }
-  func->properties["length"] = Value(static_cast<double>(funcDeclLen));
+  func->properties["length"] = Value(static_cast<double>(func->shared->length));
   func->properties["__non_writable_length"] = Value(true);
   func->properties["__non_enum_length"] = Value(true);
   func->properties["name"] = Value(decl.id.name);
   func->properties["__non_writable_name"] = Value(true);
   func->properties["__non_enum_name"] = Value(true);
-  func->sourceText = decl.sourceText;
   // Async functions (non-generator) are not constructors (no MakeConstructor call per spec)
   // Async generators are also not constructors but DO have a .prototype object
   func->isConstructor = !func->isGenerator && !func->isAsync;
@@ -19010,6 +19463,7 @@ Task Interpreter::evaluateWhile(const WhileStmt& stmt) {
       throwError(ErrorType::RangeError, "Maximum loop iterations exceeded");
       LIGHTJS_RETURN(Value(Undefined{}));
     }
+    countLoopIteration();
 
     auto testTask = evaluate(*stmt.test);
     LIGHTJS_RUN_TASK_VOID(testTask);
@@ -19207,9 +19661,10 @@ Task Interpreter::evaluateFor(const ForStmt& stmt) {
   }
 
   // Collect per-iteration let bindings for freshness (ES6 13.7.4.7)
-  // Only let bindings are refreshed per iteration; const bindings are not (they can't change)
+  // Only let bindings are refreshed per iteration; const bindings are not (they can't change).
+  // When no closure in the loop can capture them, the copies are unobservable and skipped.
   std::vector<std::string> perIterationBindings;
-  if (stmt.init) {
+  if (stmt.init && stmt.perIterationBindings) {
     if (auto* varDecl = std::get_if<VarDeclaration>(&stmt.init->node)) {
       if (varDecl->kind == VarDeclaration::Kind::Let) {
         for (const auto& declarator : varDecl->declarations) {
@@ -19253,6 +19708,7 @@ Task Interpreter::evaluateFor(const ForStmt& stmt) {
       env_ = prevEnv;
       LIGHTJS_RETURN(Value(Undefined{}));
     }
+    countLoopIteration();
     if (stmt.test) {
       auto testTask = evaluate(*stmt.test);
       LIGHTJS_RUN_TASK_VOID(testTask);
@@ -19319,6 +19775,7 @@ Task Interpreter::evaluateDoWhile(const DoWhileStmt& stmt) {
       throwError(ErrorType::RangeError, "Maximum loop iterations exceeded");
       LIGHTJS_RETURN(Value(Undefined{}));
     }
+    countLoopIteration();
 
     Value bodyResult;
     auto bodyTask = evaluate(*stmt.body);
@@ -19633,7 +20090,7 @@ Task Interpreter::evaluateForIn(const ForInStmt& stmt) {
   else if (auto* arrPtr = std::get_if<GCPtr<Array>>(&obj.data)) {
     std::vector<std::string> keys;
     // Add numeric indices first (skip holes and deleted)
-    for (size_t i = 0; i < (*arrPtr)->elements.size(); ++i) {
+    for (size_t i = 0; i < (*arrPtr)->elementCount(); ++i) {
       auto iStr = std::to_string(i);
       if ((*arrPtr)->properties.count("__hole_" + iStr + "__")) continue;
       if ((*arrPtr)->properties.count("__deleted_" + iStr + "__")) continue;
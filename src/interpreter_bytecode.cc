@@ -0,0 +1,419 @@
+#define LIGHTJS_INTERPRETER_INTERNAL
+#include "interpreter.h"
+#include "bytecode.h"
+#include <cmath>
+
+namespace lightjs {
+
+namespace {
+
+// Looks up `ctorName` in `env` and returns its "prototype" object, as the
+// tree walker does when it materializes array and object literals.
+Value literalPrototype(Environment& env, const char* ctorName) {
+  auto ctor = env.get(ctorName);
+  if (!ctor) {
+    return Value(Undefined{});
+  }
+  PropertyMap* ctorProps = nullptr;
+  if (ctor->isFunction()) {
+    ctorProps = &std::get<GCPtr<Function>>(ctor->data)->properties;
+  } else if (ctor->isObject()) {
+    ctorProps = &std::get<GCPtr<Object>>(ctor->data)->properties;
+  }
+  if (ctorProps) {
+    auto protoIt = ctorProps->find("prototype");
+    if (protoIt != ctorProps->end() && protoIt->second.isObject()) {
+      return protoIt->second;
+    }
+  }
+  return Value(Undefined{});
+}
+
+bool isPrimitiveThis(const Value& value) {
+  return value.isString() || value.isNumber() || value.isBool() || value.isBigInt();
+}
+
+}  // namespace
+
+const BytecodeFunction* Interpreter::prepareBytecode(const GCPtr<Function>& func,
+                                                     const Value& thisValue) {
+  if (!bytecodeEnabled_ || func->shared->bytecodeIneligible) {
+    return nullptr;
+  }
+  if (!func->shared->bytecode) {
+    if (++func->shared->hotness < BYTECODE_HOTNESS_THRESHOLD) {
+      return nullptr;
+    }
+    func->shared->bytecode = compileFunctionBytecode(*func);
+    if (!func->shared->bytecode) {
+      func->shared->bytecodeIneligible = true;
+      return nullptr;
+    }
+  }
+  const BytecodeFunction* code = func->shared->bytecode.get();
+  // Sloppy functions box primitive receivers; that stays on the tree walker.
+  if (code->usesThis && !code->lexicalThis && !func->isStrict && isPrimitiveThis(thisValue)) {
+    return nullptr;
+  }
+  return code;
+}
+
+Value Interpreter::runBytecodeFunction(const GCPtr<Function>& func,
+                                       const BytecodeFunction& code,
+                                       std::vector<Value> args,
+                                       Value thisValue,
+                                       bool pushNamedExpr) {
+  StackGuard guard(stackDepth_, MAX_STACK_DEPTH);
+  if (guard.overflowed()) {
+    throwError(ErrorType::RangeError, "Maximum call stack size exceeded");
+    return Value(Undefined{});
+  }
+
+  auto prevEnv = env_;
+  bool previousStrictMode = strictMode_;
+  auto prevActiveFunction = activeFunction_;
+  bool prevTailPosition = inTailPosition_;
+  // Calls normally start with a clean completion; only pay for saving the
+  // caller's record when there is one in flight.
+  std::optional<ControlFlow> prevFlow;
+  if (flow_.type != ControlFlow::Type::None) {
+    prevFlow = std::move(flow_);
+    flow_ = ControlFlow{};
+  }
+
+  env_ = func->closure;
+  if (pushNamedExpr) {
+    env_ = env_->createChild();
+    auto nameIt = func->properties.find("name");
+    if (nameIt != func->properties.end() && nameIt->second.isString()) {
+      env_->defineImmutableNFE(nameIt->second.toString(), Value(func));
+    }
+  }
+  strictMode_ = func->isStrict;
+  activeFunction_ = func;
+  inTailPosition_ = false;
+
+  if (code.usesThis && !code.lexicalThis && !func->isStrict &&
+      (thisValue.isUndefined() || thisValue.isNull())) {
+    if (auto globalThisValue = env_->get("globalThis")) {
+      thisValue = *globalThisValue;
+    }
+  }
+
+  Value result = executeBytecode(func, code, args, thisValue);
+
+  if (prevFlow && flow_.type != ControlFlow::Type::Throw) {
+    flow_ = std::move(*prevFlow);
+  }
+  inTailPosition_ = prevTailPosition;
+  activeFunction_ = prevActiveFunction;
+  strictMode_ = previousStrictMode;
+  env_ = prevEnv;
+  return result;
+}
+
+Value Interpreter::executeBytecode(const GCPtr<Function>& func,
+                                   const BytecodeFunction& code,
+                                   std::vector<Value>& args,
+                                   Value& thisValue) {
+  std::vector<Value> registers(code.registerCount);
+  auto resetFrame = [&]() {
+    for (uint32_t i = 0; i < code.registerCount; ++i) {
+      if (i < code.paramCount) {
+        registers[i] = i < args.size() ? args[i] : Value(Undefined{});
+      } else if (i < code.varEnd) {
+        registers[i] = Value(Undefined{});
+      } else {
+        registers[i] = Value(Empty{});
+      }
+    }
+  };
+  resetFrame();
+
+  // Mirrors the computed-key handling in evaluateMember/evaluateAssignment.
+  auto toPropertyKey = [&](Value key, std::string& propName,
+                           std::optional<size_t>& numericIndex) -> bool {
+    if (isObjectLike(key)) {
+      key = toPrimitiveValue(key, true);
+      if (hasError()) {
+        return false;
+      }
+    }
+    numericIndex = arrayIndexKey(key);
+    propName = valueToPropertyKey(key);
+    return true;
+  };
+
+  auto collectArgs = [&](uint32_t first, uint32_t count) {
+    std::vector<Value> callArgs;
+    callArgs.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+      callArgs.push_back(registers[first + i]);
+    }
+    return callArgs;
+  };
+
+  const Value undefined(Undefined{});
+  size_t pc = 0;
+  while (true) {
+    const Instruction& ins = code.code[pc];
+    const SourceLocation& loc = code.locations[pc];
+    ++pc;
+
+    switch (ins.op) {
+      case Opcode::LoadConst:
+        registers[ins.a] = code.constants[ins.b];
+        break;
+      case Opcode::LoadUndefined:
+        registers[ins.a] = undefined;
+        break;
+      case Opcode::LoadEmpty:
+        registers[ins.a] = Value(Empty{});
+        break;
+      case Opcode::Move:
+        registers[ins.a] = registers[ins.b];
+        break;
+      case Opcode::LoadThis:
+        if (code.lexicalThis) {
+          registers[ins.a] = resolveThisBinding();
+          if (hasError()) return undefined;
+        } else {
+          registers[ins.a] = thisValue;
+        }
+        break;
+      case Opcode::CheckInit:
+        if (registers[ins.a].isEmpty()) {
+          throwError(ErrorType::ReferenceError,
+                     formatError("Cannot access '" + code.names[ins.b] + "' before initialization", loc));
+          return undefined;
+        }
+        break;
+      case Opcode::LoadName:
+        if (const Value* global = code.globalNameAtoms[ins.b] != kNoAtom
+                ? cachedGlobal(code.globalCaches[ins.b], code.globalNameAtoms[ins.b])
+                : nullptr) {
+          registers[ins.a] = *global;
+          break;
+        }
+        registers[ins.a] = lookupIdentifier(code.names[ins.b], loc);
+        if (hasError()) return undefined;
+        break;
+      case Opcode::TypeofName: {
+        const std::string& name = code.names[ins.b];
+        if (env_->isTDZ(name)) {
+          throwError(ErrorType::ReferenceError,
+                     formatError("Cannot access '" + name + "' before initialization", loc));
+          return undefined;
+        }
+        if (isUnresolvableReference(name)) {
+          registers[ins.a] = Value("undefined");
+          break;
+        }
+        Value value = lookupIdentifier(name, loc);
+        if (hasError()) return undefined;
+        registers[ins.a] = unaryOperation(UnaryExpr::Op::Typeof, value);
+        break;
+      }
+      case Opcode::LoadCallee: {
+        Value callee;
+        Value calleeThis(Undefined{});
+        if (const Value* global = code.globalNameAtoms[ins.b] != kNoAtom
+                ? cachedGlobal(code.globalCaches[ins.b], code.globalNameAtoms[ins.b])
+                : nullptr) {
+          callee = *global;
+        } else if (!lookupCallee(code.names[ins.b], callee, calleeThis)) {
+          return undefined;
+        }
+        registers[ins.a] = std::move(callee);
+        registers[ins.a + 1] = std::move(calleeThis);
+        break;
+      }
+      case Opcode::Binary:
+        registers[ins.a] = binaryOperation(static_cast<BinaryExpr::Op>(ins.sub),
+                                           registers[ins.b], registers[ins.c]);
+        if (hasError()) return undefined;
+        break;
+      case Opcode::Unary:
+        registers[ins.a] = unaryOperation(static_cast<UnaryExpr::Op>(ins.sub), registers[ins.b]);
+        if (hasError()) return undefined;
+        break;
+      case Opcode::Compound: {
+        Value value;
+        if (!computeCompoundAssignment(static_cast<AssignmentExpr::Op>(ins.sub),
+                                       registers[ins.b], registers[ins.c], value)) {
+          return undefined;
+        }
+        registers[ins.a] = std::move(value);
+        break;
+      }
+      case Opcode::Update: {
+        Value oldValue;
+        Value newValue;
+        if (!updateNumericValue(static_cast<UpdateExpr::Op>(ins.sub), registers[ins.b],
+                                oldValue, newValue)) {
+          return undefined;
+        }
+        registers[ins.c] = std::move(oldValue);
+        registers[ins.a] = std::move(newValue);
+        break;
+      }
+      case Opcode::GetProp: {
+        const Value& obj = registers[ins.b];
+        const std::string& propName = code.names[ins.c];
+        if (obj.isNull() || obj.isUndefined()) {
+          throwError(ErrorType::TypeError,
+                     "Cannot read properties of " + std::string(obj.isNull() ? "null" : "undefined") +
+                         " (reading '" + propName + "')");
+          return undefined;
+        }
+        if (getCachedProperty(code.propertyCaches[ins.c], obj, propName, registers[ins.a])) {
+          break;
+        }
+        Value value = getMemberValue(obj, propName, std::nullopt, false, false);
+        if (hasError()) return undefined;
+        registers[ins.a] = std::move(value);
+        break;
+      }
+      case Opcode::GetElem: {
+        const Value& obj = registers[ins.b];
+        if (obj.isNull() || obj.isUndefined()) {
+          throwError(ErrorType::TypeError,
+                     "Cannot read properties of " + std::string(obj.isNull() ? "null" : "undefined"));
+          return undefined;
+        }
+        if (auto index = arrayIndexKey(registers[ins.c])) {
+          Value element;
+          if (getIndexedElement(obj, *index, element)) {
+            registers[ins.a] = std::move(element);
+            break;
+          }
+        }
+        std::string propName;
+        std::optional<size_t> numericIndex;
+        if (!toPropertyKey(registers[ins.c], propName, numericIndex)) return undefined;
+        Value value = getMemberValue(obj, propName, numericIndex, false, false);
+        if (hasError()) return undefined;
+        registers[ins.a] = std::move(value);
+        break;
+      }
+      case Opcode::SetProp:
+        assignMemberValue(AssignmentExpr::Op::Assign, registers[ins.a], code.names[ins.b],
+                          std::nullopt, registers[ins.c], false, false, undefined);
+        if (hasError()) return undefined;
+        break;
+      case Opcode::SetElem: {
+        if (auto index = arrayIndexKey(registers[ins.b]);
+            index && setIndexedElement(registers[ins.a], *index, registers[ins.c])) {
+          break;
+        }
+        std::string propName;
+        std::optional<size_t> numericIndex;
+        if (!toPropertyKey(registers[ins.b], propName, numericIndex)) return undefined;
+        assignMemberValue(AssignmentExpr::Op::Assign, registers[ins.a], propName, numericIndex,
+                          registers[ins.c], false, false, undefined);
+        if (hasError()) return undefined;
+        break;
+      }
+      case Opcode::NewObject: {
+        if (!checkMemoryLimit(sizeof(Object))) return undefined;
+        auto obj = GarbageCollector::makeGC<Object>();
+        GarbageCollector::instance().reportAllocation(sizeof(Object));
+        Value proto = literalPrototype(*env_, "Object");
+        if (!proto.isUndefined()) {
+          obj->properties["__proto__"] = proto;
+        }
+        registers[ins.a] = Value(obj);
+        break;
+      }
+      case Opcode::InitProp:
+        registers[ins.a].getGC<Object>()->properties[code.names[ins.b]] = registers[ins.c];
+        break;
+      case Opcode::NewArray: {
+        if (!checkMemoryLimit(sizeof(Array))) return undefined;
+        auto arr = GarbageCollector::makeGC<Array>();
+        GarbageCollector::instance().reportAllocation(sizeof(Array));
+        Value proto = literalPrototype(*env_, "Array");
+        if (!proto.isUndefined()) {
+          arr->properties["__proto__"] = proto;
+        }
+        arr->assignElements(collectArgs(ins.b, ins.c));
+        registers[ins.a] = Value(arr);
+        break;
+      }
+      case Opcode::Call: {
+        const Value& callee = registers[ins.b];
+        if (callee.isFunction() && callee.getGC<Function>()->fastNative) {
+          // Fast natives read their arguments straight out of the registers.
+          Value value = callFastNative(*callee.getGC<Function>(), registers[ins.b + 1],
+                                       std::span<const Value>(registers.data() + ins.b + 2, ins.c));
+          if (hasError()) return undefined;
+          registers[ins.a] = std::move(value);
+          break;
+        }
+        Value value = callValue(callee, collectArgs(ins.b + 2, ins.c), registers[ins.b + 1]);
+        if (hasError()) return undefined;
+        registers[ins.a] = std::move(value);
+        break;
+      }
+      case Opcode::TailCall: {
+        const Value& callee = registers[ins.b];
+        if (func->isStrict && callee.isFunction() && callee.getGC<Function>().get() == func.get()) {
+          // Strict self tail call: rebind the parameters and restart the frame
+          // instead of growing the native stack.
+          args = collectArgs(ins.b + 2, ins.c);
+          thisValue = registers[ins.b + 1];
+          resetFrame();
+          pc = 0;
+          break;
+        }
+        Value value = callValue(callee, collectArgs(ins.b + 2, ins.c), registers[ins.b + 1]);
+        if (hasError()) return undefined;
+        return value;
+      }
+      case Opcode::New: {
+        auto task = constructValue(registers[ins.b], collectArgs(ins.b + 1, ins.c), undefined);
+        Value value;
+        LIGHTJS_RUN_TASK_SYNC(task, value);
+        if (hasError()) return undefined;
+        registers[ins.a] = std::move(value);
+        break;
+      }
+      case Opcode::Jump:
+        pc = ins.a;
+        break;
+      case Opcode::JumpIfFalse:
+        if (!registers[ins.b].toBool()) pc = ins.a;
+        break;
+      case Opcode::JumpIfTrue:
+        if (registers[ins.b].toBool()) pc = ins.a;
+        break;
+      case Opcode::JumpIfNotNullish:
+        if (!registers[ins.b].isNull() && !registers[ins.b].isUndefined()) pc = ins.a;
+        break;
+      case Opcode::LoopInit:
+        registers[ins.a] = Value(0.0);
+        break;
+      case Opcode::LoopCheck:
+        if (maxLoopIterations_ > 0) {
+          double iterations = registers[ins.a].toNumber() + 1.0;
+          registers[ins.a] = Value(iterations);
+          if (iterations > static_cast<double>(maxLoopIterations_)) {
+            throwError(ErrorType::RangeError, "Maximum loop iterations exceeded");
+            return undefined;
+          }
+        }
+        break;
+      case Opcode::Throw:
+        flow_.type = ControlFlow::Type::Throw;
+        flow_.value = registers[ins.a];
+        return undefined;
+      case Opcode::ThrowConstAssign:
+        throwError(ErrorType::TypeError, "Assignment to constant variable '" + code.names[ins.a] + "'");
+        return undefined;
+      case Opcode::Return:
+        return registers[ins.a];
+    }
+  }
+}
+
+} // namespace lightjs
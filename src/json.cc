@@ -42,33 +42,31 @@ Value internalizeJSONProperty(Interpreter* interp,
     }
     if (val.isNumber() || val.isString() || val.isBool() || val.isNull() || val.isBigInt()) {
         std::string sourceKey = "__json_source_" + name;
-        OrderedMap<std::string, Value>* holderProps = nullptr;
+        PropertyMap* holderProps = nullptr;
         if (holder.isObject()) holderProps = &holder.getGC<Object>()->properties;
         else if (holder.isArray()) holderProps = &holder.getGC<Array>()->properties;
         if (holderProps) {
             auto srcIt = holderProps->find(sourceKey);
             if (srcIt != holderProps->end() && srcIt->second.isString()) {
-                const std::string& src = std::get<std::string>(srcIt->second.data);
+                const std::string& src = srcIt->second.asString();
                 bool matches = false;
                 if (val.isNull() && src == "null") matches = true;
                 else if (val.isBool() && ((val.toBool() && src == "true") || (!val.toBool() && src == "false"))) matches = true;
                 else if (val.isNumber()) {
                     try {
                         double parsed = std::stod(src);
-                        double actual = std::get<double>(val.data);
+                        double actual = val.asNumber();
                         if (parsed == actual || (std::isnan(parsed) && std::isnan(actual))) matches = true;
                     } catch (...) {
                     }
                 } else if (val.isString()) {
                     if (src.size() >= 2 && src.front() == '"' && src.back() == '"') {
-                        try {
-                            detail::JSONParser srcParser(src);
-                            Value parsed = srcParser.parse();
-                            if (parsed.isString() &&
-                                std::get<std::string>(parsed.data) == std::get<std::string>(val.data)) {
-                                matches = true;
-                            }
-                        } catch (...) {
+                        NativeThrow srcThrown;
+                        detail::JSONParser srcParser(src, srcThrown);
+                        Value parsed = srcParser.parse();
+                        if (!srcThrown.pending && parsed.isString() &&
+                            parsed.asString() == val.asString()) {
+                            matches = true;
                         }
                     }
                 }
@@ -83,48 +81,45 @@ Value internalizeJSONProperty(Interpreter* interp,
 
 }  // namespace
 
-Value JSON_parse(const std::vector<Value>& args) {
+Value JSON_parse(const Value&, std::span<const Value> args, Interpreter& interp, NativeThrow& thrown) {
     if (args.empty()) {
-        throw std::runtime_error("SyntaxError: Unexpected end of JSON input");
+        return thrown.error(ErrorType::SyntaxError, "Unexpected end of JSON input");
     }
 
     std::string jsonStr;
     if (args[0].isString()) {
-        jsonStr = std::get<std::string>(args[0].data);
-    } else {
-        Interpreter* interp = getGlobalInterpreter();
-        if (interp && (args[0].isObject() || args[0].isArray())) {
-            auto [found, toStringFn] = interp->getPropertyForExternal(args[0], "toString");
-            if (found && toStringFn.isFunction()) {
-                Value result = interp->callForHarness(toStringFn, {}, args[0]);
-                if (interp->hasError()) {
-                    Value err = interp->getError();
-                    interp->clearError();
-                    throw std::runtime_error(err.toString());
-                }
-                jsonStr = result.toString();
-            } else {
-                jsonStr = args[0].toString();
+        jsonStr = args[0].asString();
+    } else if (args[0].isObject() || args[0].isArray()) {
+        auto [found, toStringFn] = interp.getPropertyForExternal(args[0], "toString");
+        if (found && toStringFn.isFunction()) {
+            Value result = interp.callForHarness(toStringFn, {}, args[0]);
+            if (interp.hasError()) {
+                Value err = interp.getError();
+                interp.clearError();
+                return thrown.throwValue(err);
             }
+            jsonStr = result.toString();
         } else {
             jsonStr = args[0].toString();
         }
+    } else {
+        jsonStr = args[0].toString();
     }
 
-    detail::JSONParser parser(jsonStr);
+    detail::JSONParser parser(jsonStr, thrown);
     std::string rootSource;
     Value result = parser.parse(&rootSource);
+    if (thrown.pending) {
+        return Value(Undefined{});
+    }
 
     if (args.size() > 1 && args[1].isFunction()) {
-        Interpreter* interp = getGlobalInterpreter();
-        if (interp) {
-            auto wrapper = makeObjectWithPrototype();
-            wrapper->properties[""] = result;
-            if (!rootSource.empty()) {
-                wrapper->properties["__json_source_"] = Value(rootSource);
-            }
-            result = internalizeJSONProperty(interp, Value(wrapper), "", args[1]);
+        auto wrapper = makeObjectWithPrototype();
+        wrapper->properties[""] = result;
+        if (!rootSource.empty()) {
+            wrapper->properties["__json_source_"] = Value(rootSource);
         }
+        result = internalizeJSONProperty(&interp, Value(wrapper), "", args[1]);
     }
 
     return result;
@@ -151,7 +146,7 @@ Value JSON_stringify(const std::vector<Value>& args) {
                 std::string item;
                 bool hasItem = false;
                 if (elem.isString()) {
-                    item = std::get<std::string>(elem.data);
+                    item = elem.asString();
                     hasItem = true;
                 } else if (elem.isNumber()) {
                     item = elem.toString();
@@ -263,7 +258,7 @@ Value JSON_stringify(const std::vector<Value>& args) {
                 stringifier.setGap(std::string(n, ' '));
             }
         } else if (space.isString()) {
-            std::string s = std::get<std::string>(space.data);
+            std::string s = space.asString();
             if (s.size() > 10) s = s.substr(0, 10);
             if (!s.empty()) {
                 stringifier.setGap(s);
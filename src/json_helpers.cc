@@ -28,7 +28,7 @@ Value jsonGetFromPrototypeChain(Interpreter* interp,
                                 const std::string& key) {
     int depth = 0;
     while (isJSONObjectLike(prototype) && depth++ < 32) {
-        OrderedMap<std::string, Value>* props = nullptr;
+        PropertyMap* props = nullptr;
         if (prototype.isObject()) props = &prototype.getGC<Object>()->properties;
         else if (prototype.isFunction()) props = &prototype.getGC<Function>()->properties;
         else if (prototype.isClass()) props = &prototype.getGC<Class>()->properties;
@@ -66,7 +66,7 @@ bool jsonIsOwnEnumerableStringKey(const Value& value, const std::string& key) {
     if (value.isArray()) {
         auto arr = value.getGC<Array>();
         size_t idx = 0;
-        if (parseJSONArrayIndex(key, idx) && idx < arr->elements.size()) {
+        if (parseJSONArrayIndex(key, idx) && idx < arr->elementCount()) {
             return arr->properties.count("__deleted_" + key + "__") == 0 &&
                    arr->properties.count("__hole_" + key + "__") == 0 &&
                    arr->properties.count("__non_enum_" + key) == 0;
@@ -205,8 +205,8 @@ bool jsonDeleteProperty(Interpreter* interp, const Value& receiver, const std::s
         if (arr->properties.find("__non_configurable_" + key) != arr->properties.end()) return false;
         size_t idx = 0;
         if (parseJSONArrayIndex(key, idx)) {
-            if (idx < arr->elements.size()) {
-                arr->elements[idx] = Value(Undefined{});
+            if (idx < arr->elementCount()) {
+                arr->setElement(idx, Value(Undefined{}));
                 arr->properties["__deleted_" + key + "__"] = Value(true);
             }
             arr->properties.erase(key);
@@ -220,7 +220,7 @@ bool jsonDeleteProperty(Interpreter* interp, const Value& receiver, const std::s
         return true;
     }
 
-    OrderedMap<std::string, Value>* props = nullptr;
+    PropertyMap* props = nullptr;
     if (receiver.isObject()) props = &receiver.getGC<Object>()->properties;
     else if (receiver.isError()) props = &receiver.getGC<Error>()->properties;
     if (!props) return true;
@@ -268,8 +268,8 @@ bool jsonCreateDataProperty(Interpreter* interp,
         if (arr->properties.find("__non_configurable_" + key) != arr->properties.end()) return false;
         size_t idx = 0;
         if (parseJSONArrayIndex(key, idx)) {
-            if (idx >= arr->elements.size()) arr->elements.resize(idx + 1, Value(Undefined{}));
-            arr->elements[idx] = value;
+            if (idx >= arr->elementCount()) arr->elements().resize(idx + 1, Value(Undefined{}));
+            arr->setElement(idx, value);
             arr->properties.erase("__deleted_" + key + "__");
             arr->properties.erase("__hole_" + key + "__");
             return true;
@@ -278,7 +278,7 @@ bool jsonCreateDataProperty(Interpreter* interp,
         return true;
     }
 
-    OrderedMap<std::string, Value>* props = nullptr;
+    PropertyMap* props = nullptr;
     if (receiver.isObject()) props = &receiver.getGC<Object>()->properties;
     else if (receiver.isError()) props = &receiver.getGC<Error>()->properties;
     if (!props) return false;
@@ -309,7 +309,7 @@ std::vector<std::string> jsonEnumerableOwnKeys(Interpreter* interp, const Value&
                 if (interp->hasError()) throwInterpreterError(interp);
                 if (ownKeysResult.isArray()) {
                     usedTrap = true;
-                    for (const auto& keyValue : ownKeysResult.getGC<Array>()->elements) {
+                    for (const auto& keyValue : ownKeysResult.getGC<Array>()->elements()) {
                         candidates.push_back(valueToPropertyKey(keyValue));
                     }
                 }
@@ -346,7 +346,7 @@ std::vector<std::string> jsonEnumerableOwnKeys(Interpreter* interp, const Value&
         return keys;
     }
 
-    OrderedMap<std::string, Value>* props = nullptr;
+    PropertyMap* props = nullptr;
     if (value.isObject()) props = &value.getGC<Object>()->properties;
     else if (value.isError()) props = &value.getGC<Error>()->properties;
     else if (value.isArray()) props = &value.getGC<Array>()->properties;
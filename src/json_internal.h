@@ -29,11 +29,15 @@ class JSONParser {
 public:
     static constexpr size_t kMaxNestingDepth = 500;
 
-    explicit JSONParser(const std::string& str);
+    // Syntax errors and the nesting limit are reported through `thrown`
+    // rather than thrown; parse() then returns undefined.
+    JSONParser(const std::string& str, NativeThrow& thrown);
 
     Value parse(std::string* outSource = nullptr);
 
 private:
+    Value fail(const char* message);
+    bool enterNested();
     void skipWhitespace();
     Value parseValue(std::string* outSource = nullptr);
     Value parseString();
@@ -47,6 +51,7 @@ private:
     const std::string& str_;
     size_t pos_;
     size_t depth_ = 0;
+    NativeThrow& thrown_;
 };
 
 class JSONStringifier {
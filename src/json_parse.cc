@@ -1,30 +1,26 @@
 #include "json_internal.h"
 #include <cctype>
-#include <stdexcept>
+#include <cstdlib>
 
 namespace lightjs::detail {
 
-namespace {
+JSONParser::JSONParser(const std::string& str, NativeThrow& thrown) : str_(str), pos_(0), thrown_(thrown) {}
 
-struct JSONNestingGuard {
-    explicit JSONNestingGuard(size_t& depth, size_t limit) : depth_(depth) {
-        if (depth_ >= limit) {
-            throw std::runtime_error("RangeError: JSON nesting exceeds implementation limit");
-        }
-        ++depth_;
+Value JSONParser::fail(const char* message) {
+    if (!thrown_.pending) {
+        thrown_.error(ErrorType::SyntaxError, message);
     }
+    return Value(Undefined{});
+}
 
-    ~JSONNestingGuard() {
-        --depth_;
+bool JSONParser::enterNested() {
+    if (depth_ >= kMaxNestingDepth) {
+        thrown_.error(ErrorType::RangeError, "JSON nesting exceeds implementation limit");
+        return false;
     }
-
-private:
-    size_t& depth_;
-};
-
-}  // namespace
-
-JSONParser::JSONParser(const std::string& str) : str_(str), pos_(0) {}
+    ++depth_;
+    return true;
+}
 
 void JSONParser::skipWhitespace() {
     while (pos_ < str_.size()) {
@@ -40,7 +36,7 @@ void JSONParser::skipWhitespace() {
 Value JSONParser::parseValue(std::string* outSource) {
     skipWhitespace();
     if (pos_ >= str_.size()) {
-        throw std::runtime_error("Unexpected end of JSON input");
+        return fail("Unexpected end of JSON input");
     }
 
     size_t startPos = pos_;
@@ -85,7 +81,10 @@ Value JSONParser::parseValue(std::string* outSource) {
             isPrimitive = true;
             break;
         default:
-            throw std::runtime_error("Unexpected character in JSON");
+            return fail("Unexpected character in JSON");
+    }
+    if (thrown_.pending) {
+        return Value(Undefined{});
     }
     if (outSource && isPrimitive) {
         *outSource = str_.substr(startPos, pos_ - startPos);
@@ -95,7 +94,7 @@ Value JSONParser::parseValue(std::string* outSource) {
 
 Value JSONParser::parseString() {
     if (str_[pos_] != '"') {
-        throw std::runtime_error("Expected '\"' at start of string");
+        return fail("Expected '\"' at start of string");
     }
     pos_++;
 
@@ -104,7 +103,7 @@ Value JSONParser::parseString() {
         if (str_[pos_] == '\\') {
             pos_++;
             if (pos_ >= str_.size()) {
-                throw std::runtime_error("Unexpected end of string");
+                return fail("Unexpected end of string");
             }
             switch (str_[pos_]) {
                 case '"': result += '"'; break;
@@ -118,7 +117,7 @@ Value JSONParser::parseString() {
                 case 'u': {
                     pos_++;
                     if (pos_ + 4 > str_.size()) {
-                        throw std::runtime_error("Invalid unicode escape in JSON string");
+                        return fail("Invalid unicode escape in JSON string");
                     }
                     std::string hex = str_.substr(pos_, 4);
                     pos_ += 3;
@@ -128,12 +127,12 @@ Value JSONParser::parseString() {
                         if (c >= '0' && c <= '9') codePoint |= (c - '0');
                         else if (c >= 'a' && c <= 'f') codePoint |= (c - 'a' + 10);
                         else if (c >= 'A' && c <= 'F') codePoint |= (c - 'A' + 10);
-                        else throw std::runtime_error("Invalid hex digit in unicode escape");
+                        else return fail("Invalid hex digit in unicode escape");
                     }
                     if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
                         if (pos_ + 2 < str_.size() && str_[pos_ + 1] == '\\' && str_[pos_ + 2] == 'u') {
                             pos_ += 3;
-                            if (pos_ + 4 > str_.size()) throw std::runtime_error("Invalid surrogate pair");
+                            if (pos_ + 4 > str_.size()) return fail("Invalid surrogate pair");
                             std::string hex2 = str_.substr(pos_, 4);
                             pos_ += 3;
                             unsigned int low = 0;
@@ -166,12 +165,12 @@ Value JSONParser::parseString() {
                     break;
                 }
                 default:
-                    throw std::runtime_error("Invalid escape sequence");
+                    return fail("Invalid escape sequence");
             }
         } else {
             unsigned char ch = static_cast<unsigned char>(str_[pos_]);
             if (ch < 0x20) {
-                throw std::runtime_error("Unexpected control character in JSON string");
+                return fail("Unexpected control character in JSON string");
             }
             result += str_[pos_];
         }
@@ -179,7 +178,7 @@ Value JSONParser::parseString() {
     }
 
     if (pos_ >= str_.size()) {
-        throw std::runtime_error("Unterminated string");
+        return fail("Unterminated string");
     }
     pos_++;
 
@@ -191,7 +190,7 @@ Value JSONParser::parseNumber() {
     if (str_[pos_] == '-') pos_++;
 
     if (pos_ >= str_.size() || !std::isdigit(static_cast<unsigned char>(str_[pos_]))) {
-        throw std::runtime_error("Invalid number");
+        return fail("Invalid number");
     }
 
     if (str_[pos_] == '0') {
@@ -205,7 +204,7 @@ Value JSONParser::parseNumber() {
     if (pos_ < str_.size() && str_[pos_] == '.') {
         pos_++;
         if (pos_ >= str_.size() || !std::isdigit(static_cast<unsigned char>(str_[pos_]))) {
-            throw std::runtime_error("Invalid number");
+            return fail("Invalid number");
         }
         while (pos_ < str_.size() && std::isdigit(static_cast<unsigned char>(str_[pos_]))) {
             pos_++;
@@ -218,24 +217,22 @@ Value JSONParser::parseNumber() {
             pos_++;
         }
         if (pos_ >= str_.size() || !std::isdigit(static_cast<unsigned char>(str_[pos_]))) {
-            throw std::runtime_error("Invalid number");
+            return fail("Invalid number");
         }
         while (pos_ < str_.size() && std::isdigit(static_cast<unsigned char>(str_[pos_]))) {
             pos_++;
         }
     }
 
+    // The grammar above guarantees strtod consumes the whole token; overflow
+    // yields +/-HUGE_VAL, which is the Infinity JSON.parse wants.
     std::string numStr = str_.substr(start, pos_ - start);
-    try {
-        return Value(std::stod(numStr));
-    } catch (const std::exception&) {
-        throw std::runtime_error("Invalid number");
-    }
+    return Value(std::strtod(numStr.c_str(), nullptr));
 }
 
 Value JSONParser::parseTrue() {
     if (str_.substr(pos_, 4) != "true") {
-        throw std::runtime_error("Invalid literal");
+        return fail("Invalid literal");
     }
     pos_ += 4;
     return Value(true);
@@ -243,7 +240,7 @@ Value JSONParser::parseTrue() {
 
 Value JSONParser::parseFalse() {
     if (str_.substr(pos_, 5) != "false") {
-        throw std::runtime_error("Invalid literal");
+        return fail("Invalid literal");
     }
     pos_ += 5;
     return Value(false);
@@ -251,16 +248,20 @@ Value JSONParser::parseFalse() {
 
 Value JSONParser::parseNull() {
     if (str_.substr(pos_, 4) != "null") {
-        throw std::runtime_error("Invalid literal");
+        return fail("Invalid literal");
     }
     pos_ += 4;
     return Value(Null{});
 }
 
 Value JSONParser::parseObject() {
-    JSONNestingGuard guard(depth_, kMaxNestingDepth);
+    if (!enterNested()) return Value(Undefined{});
+    struct DepthExit {
+        size_t& depth;
+        ~DepthExit() { --depth; }
+    } depthExit{depth_};
     if (str_[pos_] != '{') {
-        throw std::runtime_error("Expected '{'");
+        return fail("Expected '{'");
     }
     pos_++;
 
@@ -275,23 +276,25 @@ Value JSONParser::parseObject() {
     while (true) {
         skipWhitespace();
         if (pos_ >= str_.size()) {
-            throw std::runtime_error("Unexpected end of object");
+            return fail("Unexpected end of object");
         }
 
         Value keyValue = parseString();
+        if (thrown_.pending) return Value(Undefined{});
         if (!keyValue.isString()) {
-            throw std::runtime_error("Object key must be string");
+            return fail("Object key must be string");
         }
-        std::string key = std::get<std::string>(keyValue.data);
+        std::string key = keyValue.asString();
 
         skipWhitespace();
         if (pos_ >= str_.size() || str_[pos_] != ':') {
-            throw std::runtime_error("Expected ':' after object key");
+            return fail("Expected ':' after object key");
         }
         pos_++;
 
         std::string valSource;
         Value value = parseValue(&valSource);
+        if (thrown_.pending) return Value(Undefined{});
         if (key == "__proto__") {
             obj->properties["__own_prop___proto__"] = value;
             if (!valSource.empty()) obj->properties["__json_source___proto__"] = Value(valSource);
@@ -302,7 +305,7 @@ Value JSONParser::parseObject() {
 
         skipWhitespace();
         if (pos_ >= str_.size()) {
-            throw std::runtime_error("Unexpected end of object");
+            return fail("Unexpected end of object");
         }
 
         if (str_[pos_] == '}') {
@@ -312,7 +315,7 @@ Value JSONParser::parseObject() {
             pos_++;
             continue;
         } else {
-            throw std::runtime_error("Expected ',' or '}' in object");
+            return fail("Expected ',' or '}' in object");
         }
     }
 
@@ -320,9 +323,13 @@ Value JSONParser::parseObject() {
 }
 
 Value JSONParser::parseArray() {
-    JSONNestingGuard guard(depth_, kMaxNestingDepth);
+    if (!enterNested()) return Value(Undefined{});
+    struct DepthExit {
+        size_t& depth;
+        ~DepthExit() { --depth; }
+    } depthExit{depth_};
     if (str_[pos_] != '[') {
-        throw std::runtime_error("Expected '['");
+        return fail("Expected '['");
     }
     pos_++;
 
@@ -337,15 +344,16 @@ Value JSONParser::parseArray() {
     while (true) {
         std::string valSource;
         Value value = parseValue(&valSource);
-        size_t idx = arr->elements.size();
-        arr->elements.push_back(value);
+        if (thrown_.pending) return Value(Undefined{});
+        size_t idx = arr->elementCount();
+        arr->pushElement(value);
         if (!valSource.empty()) {
             arr->properties["__json_source_" + std::to_string(idx)] = Value(valSource);
         }
 
         skipWhitespace();
         if (pos_ >= str_.size()) {
-            throw std::runtime_error("Unexpected end of array");
+            return fail("Unexpected end of array");
         }
 
         if (str_[pos_] == ']') {
@@ -355,7 +363,7 @@ Value JSONParser::parseArray() {
             pos_++;
             continue;
         } else {
-            throw std::runtime_error("Expected ',' or ']' in array");
+            return fail("Expected ',' or ']' in array");
         }
     }
 
@@ -364,9 +372,10 @@ Value JSONParser::parseArray() {
 
 Value JSONParser::parse(std::string* outSource) {
     Value result = parseValue(outSource);
+    if (thrown_.pending) return Value(Undefined{});
     skipWhitespace();
     if (pos_ < str_.size()) {
-        throw std::runtime_error("Unexpected trailing characters");
+        return fail("Unexpected trailing characters");
     }
     return result;
 }
@@ -110,7 +110,7 @@ bool JSONStringifier::serializeValue(const Value& holder, const std::string& key
     } else if (value.isBool()) {
         out_ << (std::get<bool>(value.data) ? "true" : "false");
     } else if (value.isNumber()) {
-        double num = std::get<double>(value.data);
+        double num = value.asNumber();
         if (std::isfinite(num)) {
             out_ << ecmaNumberToString(num);
         } else {
@@ -119,7 +119,7 @@ bool JSONStringifier::serializeValue(const Value& holder, const std::string& key
     } else if (value.isBigInt()) {
         throw std::runtime_error("TypeError: Do not know how to serialize a BigInt");
     } else if (value.isString()) {
-        stringifyString(std::get<std::string>(value.data));
+        stringifyString(value.asString());
     } else if (isJSONObjectLike(value) && jsonIsArrayValue(getGlobalInterpreter(), value)) {
         checkCircular(value);
         serializeArray(value);
@@ -130,7 +130,7 @@ bool JSONStringifier::serializeValue(const Value& holder, const std::string& key
             if (rawIt != obj->properties.end() && rawIt->second.isBool() && rawIt->second.toBool()) {
                 auto valIt = obj->properties.find("rawJSON");
                 if (valIt != obj->properties.end() && valIt->second.isString()) {
-                    out_ << std::get<std::string>(valIt->second.data);
+                    out_ << valIt->second.asString();
                     return true;
                 }
             }
@@ -5,6 +5,7 @@
 #include "streams.h"
 #include "wasm_js.h"
 #include <cmath>
+#include <optional>
 #include <cstring>
 #include <random>
 #include <stdexcept>
@@ -14,7 +15,7 @@
 namespace lightjs {
 
 // Math.abs
-Value Math_abs(const std::vector<Value>& args) {
+Value Math_abs(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) {
         return Value(std::numeric_limits<double>::quiet_NaN());
     }
@@ -24,7 +25,7 @@ Value Math_abs(const std::vector<Value>& args) {
 }
 
 // Math.ceil
-Value Math_ceil(const std::vector<Value>& args) {
+Value Math_ceil(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) {
         return Value(std::numeric_limits<double>::quiet_NaN());
     }
@@ -34,7 +35,7 @@ Value Math_ceil(const std::vector<Value>& args) {
 }
 
 // Math.floor
-Value Math_floor(const std::vector<Value>& args) {
+Value Math_floor(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) {
         return Value(std::numeric_limits<double>::quiet_NaN());
     }
@@ -44,7 +45,7 @@ Value Math_floor(const std::vector<Value>& args) {
 }
 
 // Math.round - ES spec: round toward +Infinity for .5
-Value Math_round(const std::vector<Value>& args) {
+Value Math_round(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) {
         return Value(std::numeric_limits<double>::quiet_NaN());
     }
@@ -62,7 +63,7 @@ Value Math_round(const std::vector<Value>& args) {
 }
 
 // Math.trunc
-Value Math_trunc(const std::vector<Value>& args) {
+Value Math_trunc(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) {
         return Value(std::numeric_limits<double>::quiet_NaN());
     }
@@ -72,53 +73,47 @@ Value Math_trunc(const std::vector<Value>& args) {
 }
 
 // Math.max - ES spec: coerce args to number, handle -0/+0
-Value Math_max(const std::vector<Value>& args) {
+Value Math_max(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) {
         return Value(-std::numeric_limits<double>::infinity());
     }
 
-    // ES spec: coerce ALL arguments first, then compute
-    std::vector<double> coerced;
-    coerced.reserve(args.size());
-    for (const auto& arg : args) {
-        coerced.push_back(toNumberES(arg));
-    }
-
+    // ES spec: every argument is coerced, even after a NaN decides the result
     double result = -std::numeric_limits<double>::infinity();
-    for (double val : coerced) {
-        if (std::isnan(val)) return Value(std::numeric_limits<double>::quiet_NaN());
-        if (val > result || (val == result && val == 0.0 && std::signbit(result) && !std::signbit(val))) {
+    bool sawNaN = false;
+    for (const auto& arg : args) {
+        double val = toNumberES(arg);
+        if (std::isnan(val)) {
+            sawNaN = true;
+        } else if (val > result || (val == result && val == 0.0 && std::signbit(result) && !std::signbit(val))) {
             result = val;
         }
     }
-    return Value(result);
+    return Value(sawNaN ? std::numeric_limits<double>::quiet_NaN() : result);
 }
 
 // Math.min - ES spec: coerce args to number, handle -0/+0
-Value Math_min(const std::vector<Value>& args) {
+Value Math_min(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) {
         return Value(std::numeric_limits<double>::infinity());
     }
 
-    // ES spec: coerce ALL arguments first, then compute
-    std::vector<double> coerced;
-    coerced.reserve(args.size());
-    for (const auto& arg : args) {
-        coerced.push_back(toNumberES(arg));
-    }
-
+    // ES spec: every argument is coerced, even after a NaN decides the result
     double result = std::numeric_limits<double>::infinity();
-    for (double val : coerced) {
-        if (std::isnan(val)) return Value(std::numeric_limits<double>::quiet_NaN());
-        if (val < result || (val == result && val == 0.0 && !std::signbit(result) && std::signbit(val))) {
+    bool sawNaN = false;
+    for (const auto& arg : args) {
+        double val = toNumberES(arg);
+        if (std::isnan(val)) {
+            sawNaN = true;
+        } else if (val < result || (val == result && val == 0.0 && !std::signbit(result) && std::signbit(val))) {
             result = val;
         }
     }
-    return Value(result);
+    return Value(sawNaN ? std::numeric_limits<double>::quiet_NaN() : result);
 }
 
 // Math.pow - ES spec Number::exponentiate
-Value Math_pow(const std::vector<Value>& args) {
+Value Math_pow(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.size() < 2) {
         return Value(std::numeric_limits<double>::quiet_NaN());
     }
@@ -136,7 +131,7 @@ Value Math_pow(const std::vector<Value>& args) {
 }
 
 // Math.sqrt
-Value Math_sqrt(const std::vector<Value>& args) {
+Value Math_sqrt(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) {
         return Value(std::numeric_limits<double>::quiet_NaN());
     }
@@ -146,7 +141,7 @@ Value Math_sqrt(const std::vector<Value>& args) {
 }
 
 // Math.sin
-Value Math_sin(const std::vector<Value>& args) {
+Value Math_sin(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) {
         return Value(std::numeric_limits<double>::quiet_NaN());
     }
@@ -156,7 +151,7 @@ Value Math_sin(const std::vector<Value>& args) {
 }
 
 // Math.cos
-Value Math_cos(const std::vector<Value>& args) {
+Value Math_cos(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) {
         return Value(std::numeric_limits<double>::quiet_NaN());
     }
@@ -166,7 +161,7 @@ Value Math_cos(const std::vector<Value>& args) {
 }
 
 // Math.tan
-Value Math_tan(const std::vector<Value>& args) {
+Value Math_tan(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) {
         return Value(std::numeric_limits<double>::quiet_NaN());
     }
@@ -176,7 +171,7 @@ Value Math_tan(const std::vector<Value>& args) {
 }
 
 // Math.random
-Value Math_random(const std::vector<Value>& args) {
+Value Math_random(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     static std::random_device rd;
     static std::mt19937 gen(rd());
     static std::uniform_real_distribution<double> dis(0.0, 1.0);
@@ -185,7 +180,7 @@ Value Math_random(const std::vector<Value>& args) {
 }
 
 // Math.sign
-Value Math_sign(const std::vector<Value>& args) {
+Value Math_sign(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) {
         return Value(std::numeric_limits<double>::quiet_NaN());
     }
@@ -200,7 +195,7 @@ Value Math_sign(const std::vector<Value>& args) {
 }
 
 // Math.log
-Value Math_log(const std::vector<Value>& args) {
+Value Math_log(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) {
         return Value(std::numeric_limits<double>::quiet_NaN());
     }
@@ -210,7 +205,7 @@ Value Math_log(const std::vector<Value>& args) {
 }
 
 // Math.log10
-Value Math_log10(const std::vector<Value>& args) {
+Value Math_log10(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) {
         return Value(std::numeric_limits<double>::quiet_NaN());
     }
@@ -220,7 +215,7 @@ Value Math_log10(const std::vector<Value>& args) {
 }
 
 // Math.exp
-Value Math_exp(const std::vector<Value>& args) {
+Value Math_exp(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) {
         return Value(std::numeric_limits<double>::quiet_NaN());
     }
@@ -230,7 +225,7 @@ Value Math_exp(const std::vector<Value>& args) {
 }
 
 // Math.cbrt - cube root
-Value Math_cbrt(const std::vector<Value>& args) {
+Value Math_cbrt(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) {
         return Value(std::numeric_limits<double>::quiet_NaN());
     }
@@ -240,7 +235,7 @@ Value Math_cbrt(const std::vector<Value>& args) {
 }
 
 // Math.log2 - base 2 logarithm
-Value Math_log2(const std::vector<Value>& args) {
+Value Math_log2(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) {
         return Value(std::numeric_limits<double>::quiet_NaN());
     }
@@ -250,7 +245,7 @@ Value Math_log2(const std::vector<Value>& args) {
 }
 
 // Math.hypot - ES spec: Infinity wins over NaN, coerce args
-Value Math_hypot(const std::vector<Value>& args) {
+Value Math_hypot(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) {
         return Value(0.0);
     }
@@ -278,7 +273,7 @@ Value Math_hypot(const std::vector<Value>& args) {
 }
 
 // Math.expm1 - e^x - 1 (more accurate for small x)
-Value Math_expm1(const std::vector<Value>& args) {
+Value Math_expm1(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) {
         return Value(std::numeric_limits<double>::quiet_NaN());
     }
@@ -288,7 +283,7 @@ Value Math_expm1(const std::vector<Value>& args) {
 }
 
 // Math.log1p - ln(1 + x) (more accurate for small x)
-Value Math_log1p(const std::vector<Value>& args) {
+Value Math_log1p(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) {
         return Value(std::numeric_limits<double>::quiet_NaN());
     }
@@ -298,7 +293,7 @@ Value Math_log1p(const std::vector<Value>& args) {
 }
 
 // Math.fround - round to nearest 32-bit float
-Value Math_fround(const std::vector<Value>& args) {
+Value Math_fround(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) {
         return Value(std::numeric_limits<double>::quiet_NaN());
     }
@@ -325,7 +320,7 @@ static int32_t toInt32(double x) {
 }
 
 // Math.clz32 - count leading zeros in 32-bit integer
-Value Math_clz32(const std::vector<Value>& args) {
+Value Math_clz32(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) {
         return Value(32.0);
     }
@@ -344,7 +339,7 @@ Value Math_clz32(const std::vector<Value>& args) {
 }
 
 // Math.imul - 32-bit integer multiplication
-Value Math_imul(const std::vector<Value>& args) {
+Value Math_imul(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.size() < 2) {
         return Value(0.0);
     }
@@ -354,58 +349,58 @@ Value Math_imul(const std::vector<Value>& args) {
     return Value(static_cast<double>(a * b));
 }
 
-Value Math_asin(const std::vector<Value>& args) {
+Value Math_asin(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) return Value(std::numeric_limits<double>::quiet_NaN());
     return Value(std::asin(toNumberES(args[0])));
 }
 
-Value Math_acos(const std::vector<Value>& args) {
+Value Math_acos(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) return Value(std::numeric_limits<double>::quiet_NaN());
     return Value(std::acos(toNumberES(args[0])));
 }
 
-Value Math_atan(const std::vector<Value>& args) {
+Value Math_atan(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) return Value(std::numeric_limits<double>::quiet_NaN());
     return Value(std::atan(toNumberES(args[0])));
 }
 
-Value Math_atan2(const std::vector<Value>& args) {
+Value Math_atan2(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.size() < 2) return Value(std::numeric_limits<double>::quiet_NaN());
     return Value(std::atan2(toNumberES(args[0]), toNumberES(args[1])));
 }
 
-Value Math_sinh(const std::vector<Value>& args) {
+Value Math_sinh(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) return Value(std::numeric_limits<double>::quiet_NaN());
     return Value(std::sinh(toNumberES(args[0])));
 }
 
-Value Math_cosh(const std::vector<Value>& args) {
+Value Math_cosh(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) return Value(std::numeric_limits<double>::quiet_NaN());
     return Value(std::cosh(toNumberES(args[0])));
 }
 
-Value Math_tanh(const std::vector<Value>& args) {
+Value Math_tanh(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) return Value(std::numeric_limits<double>::quiet_NaN());
     return Value(std::tanh(toNumberES(args[0])));
 }
 
-Value Math_asinh(const std::vector<Value>& args) {
+Value Math_asinh(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) return Value(std::numeric_limits<double>::quiet_NaN());
     return Value(std::asinh(toNumberES(args[0])));
 }
 
-Value Math_acosh(const std::vector<Value>& args) {
+Value Math_acosh(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) return Value(std::numeric_limits<double>::quiet_NaN());
     return Value(std::acosh(toNumberES(args[0])));
 }
 
-Value Math_atanh(const std::vector<Value>& args) {
+Value Math_atanh(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) return Value(std::numeric_limits<double>::quiet_NaN());
     return Value(std::atanh(toNumberES(args[0])));
 }
 
 // Math.f16round - round to IEEE 754 half-precision float
-Value Math_f16round(const std::vector<Value>& args) {
+Value Math_f16round(const Value&, std::span<const Value> args, Interpreter&, NativeThrow&) {
     if (args.empty()) return Value(std::numeric_limits<double>::quiet_NaN());
     double x = toNumberES(args[0]);
     if (std::isnan(x)) return Value(std::numeric_limits<double>::quiet_NaN());
@@ -624,48 +619,47 @@ static Value shewchukSum(const std::vector<double>& numbers) {
 
 
 // Helper: get iterator from a value, returns {iteratorObj, nextFn}
-// Throws TypeError if not iterable
-static std::pair<Value, Value> getIterator(Interpreter* interp, const Value& val) {
-    if (!interp) throw std::runtime_error("TypeError: Math.sumPrecise requires an iterable argument");
-
+// Reports a TypeError through `thrown` if not iterable
+static std::optional<std::pair<Value, Value>> getIterator(Interpreter& interp, const Value& val,
+                                                          NativeThrow& thrown) {
     // Generators are their own iterator: gen[Symbol.iterator]() returns gen
     // Since both Symbol.iterator and next are dynamically created in evaluateMember,
     // we handle generators directly
     if (val.isGenerator()) {
         // Generator is its own iterator - next will be called via generatorNext()
-        return {val, Value(Undefined{})};
+        return std::pair{val, Value(Undefined{})};
     }
 
     // Use interpreter to get Symbol.iterator via property lookup (handles prototype chain)
     const auto& iterKey = WellKnownSymbols::iteratorKey();
-    auto [found, iterMethod] = interp->getPropertyForExternal(val, iterKey);
+    auto [found, iterMethod] = interp.getPropertyForExternal(val, iterKey);
 
     if (!found || !iterMethod.isFunction()) {
-        throw std::runtime_error("TypeError: Math.sumPrecise requires an iterable argument");
+        thrown.error(ErrorType::TypeError, "Math.sumPrecise requires an iterable argument");
+        return std::nullopt;
     }
 
-    Value iteratorObj = interp->callForHarness(iterMethod, {}, val);
-    if (interp->hasError()) {
-        Value err = interp->getError();
-        interp->clearError();
-        throw std::runtime_error(err.toString());
+    Value iteratorObj = interp.callForHarness(iterMethod, {}, val);
+    if (interp.hasError()) {
+        Value err = interp.getError();
+        interp.clearError();
+        thrown.throwValue(err);
+        return std::nullopt;
     }
 
     // If the iterator is a generator, handle its dynamic next()
     if (iteratorObj.isGenerator()) {
-        return {iteratorObj, Value(Undefined{})};
+        return std::pair{iteratorObj, Value(Undefined{})};
     }
 
     // Get next method
-    Value nextFn;
-    auto [nextFound, fn] = interp->getPropertyForExternal(iteratorObj, "next");
-    if (nextFound && fn.isFunction()) {
-        nextFn = fn;
-    } else {
-        throw std::runtime_error("TypeError: iterator does not have a next method");
+    auto [nextFound, nextFn] = interp.getPropertyForExternal(iteratorObj, "next");
+    if (!nextFound || !nextFn.isFunction()) {
+        thrown.error(ErrorType::TypeError, "iterator does not have a next method");
+        return std::nullopt;
     }
 
-    return {iteratorObj, nextFn};
+    return std::pair{iteratorObj, nextFn};
 }
 
 // Helper: close iterator (call return() if present)
@@ -684,35 +678,38 @@ static void closeIterator(Interpreter* interp, const Value& iteratorObj) {
 }
 
 // Math.sumPrecise - precise sum of iterable of numbers
-Value Math_sumPrecise(const std::vector<Value>& args) {
+Value Math_sumPrecise(const Value&, std::span<const Value> args, Interpreter& interpreter, NativeThrow& thrown) {
     if (args.empty()) {
-        throw std::runtime_error("TypeError: Math.sumPrecise requires 1 argument");
+        return thrown.error(ErrorType::TypeError, "Math.sumPrecise requires 1 argument");
     }
 
     // Non-object/non-iterable values are TypeError
     if (args[0].isNumber() || args[0].isString() || args[0].isBool() ||
         args[0].isNull() || args[0].isUndefined() || args[0].isBigInt()) {
-        throw std::runtime_error("TypeError: Math.sumPrecise requires an iterable argument");
+        return thrown.error(ErrorType::TypeError, "Math.sumPrecise requires an iterable argument");
     }
 
-    Interpreter* interpreter = getGlobalInterpreter();
-    auto [iteratorObj, nextFn] = getIterator(interpreter, args[0]);
+    auto iterator = getIterator(interpreter, args[0], thrown);
+    if (!iterator) {
+        return Value(Undefined{});
+    }
+    auto [iteratorObj, nextFn] = *iterator;
 
     std::vector<double> numbers;
     while (true) {
         Value step;
         if (nextFn.isFunction()) {
-            step = interpreter->callForHarness(nextFn, {}, iteratorObj);
+            step = interpreter.callForHarness(nextFn, {}, iteratorObj);
         } else if (iteratorObj.isGenerator()) {
             // Generator's next is dynamically created - use generatorNext
-            step = interpreter->generatorNext(iteratorObj);
+            step = interpreter.generatorNext(iteratorObj);
         } else {
             break;
         }
-        if (interpreter->hasError()) {
-            Value err = interpreter->getError();
-            interpreter->clearError();
-            throw std::runtime_error(err.toString());
+        if (interpreter.hasError()) {
+            Value err = interpreter.getError();
+            interpreter.clearError();
+            return thrown.throwValue(err);
         }
         if (!step.isObject()) break;
         auto stepObj = step.getGC<Object>();
@@ -721,10 +718,10 @@ Value Math_sumPrecise(const std::vector<Value>& args) {
         auto valueIt = stepObj->properties.find("value");
         Value val = (valueIt != stepObj->properties.end()) ? valueIt->second : Value(Undefined{});
         if (!val.isNumber()) {
-            closeIterator(interpreter, iteratorObj);
-            throw std::runtime_error("TypeError: Math.sumPrecise requires an iterable of numbers");
+            closeIterator(&interpreter, iteratorObj);
+            return thrown.error(ErrorType::TypeError, "Math.sumPrecise requires an iterable of numbers");
         }
-        numbers.push_back(std::get<double>(val.data));
+        numbers.push_back(val.asNumber());
     }
 
     return shewchukSum(numbers);
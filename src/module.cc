@@ -1,4 +1,5 @@
 #include "module_internal.h"
+#include "json_internal.h"
 
 namespace lightjs {
 
@@ -8,16 +9,18 @@ Module::Module(const std::string& path, const std::string& source, ModuleType ty
 bool Module::parse() {
   lastError_.reset();
   if (type_ == ModuleType::Json) {
-    try {
-      defaultExport_ = JSON_parse({Value(source_)});
-      ast_ = Program{};
-      ast_->isModule = true;
-      isAsync_ = false;
-      return true;
-    } catch (const std::exception& e) {
-      lastError_ = makeErrorFromExceptionMessage(e.what());
+    NativeThrow thrown;
+    detail::JSONParser parser(source_, thrown);
+    Value parsed = parser.parse();
+    if (thrown.pending) {
+      lastError_ = makeErrorValue(thrown.type, thrown.message);
       return false;
     }
+    defaultExport_ = parsed;
+    ast_ = Program{};
+    ast_->isModule = true;
+    isAsync_ = false;
+    return true;
   }
   if (type_ == ModuleType::Bytes) {
     ast_ = Program{};
@@ -346,7 +346,7 @@ bool Module::rebuildIndirectExports() {
       if (module->environment_ && module->environment_->hasLocal(localName)) {
         auto localValue = module->environment_->get(localName);
         if (localValue && localValue->isModuleBinding()) {
-          const auto& imported = std::get<ModuleBinding>(localValue->data);
+          const auto& imported = localValue->asModuleBinding();
           return resolveBindingIdentityRef(imported.module.lock(),
                                            imported.exportName,
                                            resolveBindingIdentityRef,
@@ -370,7 +370,7 @@ bool Module::rebuildIndirectExports() {
     auto exportIt = module->exports_.find(exportName);
     if (exportIt != module->exports_.end()) {
       if (exportIt->second.isModuleBinding()) {
-        const auto& imported = std::get<ModuleBinding>(exportIt->second.data);
+        const auto& imported = exportIt->second.asModuleBinding();
         return resolveBindingIdentityRef(imported.module.lock(),
                                          imported.exportName,
                                          resolveBindingIdentityRef,
@@ -395,7 +395,7 @@ bool Module::rebuildIndirectExports() {
 
   auto identityForValue = [&](const Value& value) -> std::optional<ResolvedBindingIdentity> {
     if (value.isModuleBinding()) {
-      const auto& binding = std::get<ModuleBinding>(value.data);
+      const auto& binding = value.asModuleBinding();
       std::unordered_set<std::string> visited;
       return resolveBindingIdentity(binding.module.lock(),
                                     binding.exportName,
@@ -546,7 +546,7 @@ std::optional<Value> Module::getExport(const std::string& name) const {
     }
     if (auto value = environment_->get(binding->second)) {
       if (value->isModuleBinding()) {
-        const auto& importedBinding = std::get<ModuleBinding>(value->data);
+        const auto& importedBinding = value->asModuleBinding();
         auto importedModule = importedBinding.module.lock();
         if (!importedModule) {
           return std::nullopt;
@@ -559,7 +559,7 @@ std::optional<Value> Module::getExport(const std::string& name) const {
   auto it = exports_.find(name);
   if (it != exports_.end()) {
     if (it->second.isModuleBinding()) {
-      const auto& binding = std::get<ModuleBinding>(it->second.data);
+      const auto& binding = it->second.asModuleBinding();
       auto module = binding.module.lock();
       if (!module) {
         return std::nullopt;
@@ -608,7 +608,7 @@ void setDefaultExportNameIfNeeded(Value& result) {
     auto nameIt = fn->properties.find("name");
     bool shouldSet = true;
     if (nameIt != fn->properties.end() && nameIt->second.isString()) {
-      shouldSet = std::get<std::string>(nameIt->second.data).empty();
+      shouldSet = nameIt->second.asString().empty();
     }
     if (shouldSet) {
       fn->properties["name"] = Value(std::string("default"));
@@ -620,7 +620,7 @@ void setDefaultExportNameIfNeeded(Value& result) {
     auto cls = result.getGC<Class>();
     auto nameIt = cls->properties.find("name");
     bool shouldSet = nameIt == cls->properties.end() ||
-                     (nameIt->second.isString() && std::get<std::string>(nameIt->second.data).empty());
+                     (nameIt->second.isString() && nameIt->second.asString().empty());
     if (cls->name.empty() && shouldSet) {
       cls->name = "default";
       cls->properties["name"] = Value(std::string("default"));
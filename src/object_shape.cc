@@ -18,36 +18,81 @@ ObjectShape::ObjectShape(std::shared_ptr<ObjectShape> parent)
   if (parent) {
     // Inherit properties from parent
     properties_ = parent->properties_;
+    atoms_ = parent->atoms_;
     propertyMap_ = parent->propertyMap_;
+    accessorCount_ = parent->accessorCount_;
+    prototypeOffset_ = parent->prototypeOffset_;
   }
 }
 
-int ObjectShape::getPropertyOffset(const std::string& name) const {
-  auto it = propertyMap_.find(name);
+int ObjectShape::getPropertyOffset(Atom atom) const {
+  if (atom == kNoAtom) {
+    return -1;
+  }
+  if (propertyMap_.empty()) {
+    for (size_t i = 0; i < atoms_.size(); ++i) {
+      if (atoms_[i] == atom) {
+        return static_cast<int>(i);
+      }
+    }
+    return -1;
+  }
+  auto it = propertyMap_.find(atom);
   if (it != propertyMap_.end()) {
     return static_cast<int>(it->second);
   }
   return -1;
 }
 
-bool ObjectShape::hasProperty(const std::string& name) const {
-  return propertyMap_.find(name) != propertyMap_.end();
+void ObjectShape::appendProperty(Atom atom) {
+  auto& atoms = AtomTable::instance();
+  properties_.push_back(atoms.name(atom));
+  atoms_.push_back(atom);
+  switch (atoms.kind(atom)) {
+    case AtomKind::Getter:
+    case AtomKind::Setter:
+      accessorCount_++;
+      break;
+    case AtomKind::Prototype:
+      prototypeOffset_ = static_cast<int>(atoms_.size() - 1);
+      break;
+    case AtomKind::Plain:
+      break;
+  }
+  if (atoms_.size() > kLinearScanLimit) {
+    if (propertyMap_.empty()) {
+      for (size_t i = 0; i < atoms_.size(); ++i) {
+        propertyMap_[atoms_[i]] = static_cast<uint32_t>(i);
+      }
+    } else {
+      propertyMap_[atom] = static_cast<uint32_t>(atoms_.size() - 1);
+    }
+  }
 }
 
-std::shared_ptr<ObjectShape> ObjectShape::addProperty(const std::string& name) {
+std::shared_ptr<ObjectShape> ObjectShape::addProperty(Atom atom) {
   // Check if we already have a transition for this property
-  auto it = transitions_.find(name);
+  auto it = transitions_.find(atom);
   if (it != transitions_.end()) {
-    return it->second;
+    if (auto shape = it->second.lock()) {
+      return shape;
+    }
+  }
+
+  // Drop transitions to dead shapes before the table grows further.
+  if (transitions_.size() >= transitionSweepThreshold_) {
+    for (auto entry = transitions_.begin(); entry != transitions_.end();) {
+      entry = entry->second.expired() ? transitions_.erase(entry) : std::next(entry);
+    }
+    transitionSweepThreshold_ = std::max<size_t>(16, transitions_.size() * 2);
   }
 
   // Create new shape with this property added
   auto newShape = std::make_shared<ObjectShape>(shared_from_this());
-  newShape->properties_.push_back(name);
-  newShape->propertyMap_[name] = newShape->properties_.size() - 1;
+  newShape->appendProperty(atom);
 
   // Cache the transition
-  transitions_[name] = newShape;
+  transitions_[atom] = newShape;
 
   return newShape;
 }
@@ -61,9 +106,8 @@ std::shared_ptr<ObjectShape> ObjectShape::getShape(const std::vector<std::string
 
   // Create new shape
   auto shape = std::make_shared<ObjectShape>();
-  shape->properties_ = properties;
-  for (size_t i = 0; i < properties.size(); i++) {
-    shape->propertyMap_[properties[i]] = i;
+  for (const auto& name : properties) {
+    shape->appendProperty(atomize(name));
   }
 
   // Cache it
@@ -86,8 +130,4 @@ void ObjectShape::clearShapeCache() {
   nextShapeId_ = 1;
 }
 
-// ShapedObject implementation is currently unused - Object uses direct hash map
-// with inline caching on shape IDs for optimization. ShapedObject can be
-// enabled later if slot-based storage is desired.
-
 } // namespace lightjs
@@ -287,6 +287,8 @@ std::optional<Program> Parser::parse() {
     }
   }
 
+  resolveScopes(program, isEvalContext_);
+
   return program;
 }
 
@@ -0,0 +1,470 @@
+#include "parser.h"
+
+#include <unordered_map>
+
+namespace lightjs {
+
+namespace {
+
+// Post-parse analysis of a program. It atomizes identifier names and
+// records these facts on the AST:
+//
+// - Identifier::staticScope: the reference's scope chain is fixed at parse
+//   time. That holds when it is not inside a `with` body and no enclosing
+//   function (or the script itself) contains a direct eval: those are the
+//   only constructs that can add bindings to a scope after it has been
+//   created or insert an object environment into the chain. For static
+//   references the interpreter caches the binding's (hops, slot)
+//   coordinates on the node.
+// - Identifier::tdzFree: the reference names a let/const/class binding of
+//   its own function that is declared earlier in an enclosing block, outside
+//   any switch case, so the declaration has always run by the time the
+//   reference is evaluated. References from nested functions are never
+//   marked: they can run before the declaration (hoisted calls).
+// - Expression::canSuspend: the expression contains a yield or await that
+//   is not inside a nested function, so it must run as a coroutine.
+// - usesArguments on function nodes: cleared unless the function's own
+//   `arguments` can be read, i.e. it, or an arrow function nested in it,
+//   names `arguments` or contains a direct eval. Calls to the other
+//   functions skip building the arguments object.
+// - ForStmt::perIterationBindings: cleared when the loop contains no
+//   function, class or direct eval, the only things that can capture a
+//   binding. Without a capture, copying the let bindings into a fresh
+//   environment per iteration is unobservable.
+class ScopeResolver {
+public:
+  explicit ScopeResolver(bool markScopes) : markScopes_(markScopes) {}
+
+  void resolve(Program& program) {
+    functions_.emplace_back();
+    block(program.body);
+    finishFunction();
+  }
+
+private:
+  // Lexical names declared directly in one block, mapped to whether the
+  // walk has passed their declaration.
+  struct BlockScope {
+    std::unordered_map<std::string, bool> initialized;
+    bool isSwitch = false;  // Case clauses can jump past declarations
+  };
+
+  struct FunctionScope {
+    std::vector<Identifier*> references;
+    std::vector<BlockScope> blocks;
+    bool hasDirectEval = false;
+    bool isArrow = false;
+    bool usesArguments = false;
+  };
+
+  bool markScopes_;
+  std::vector<FunctionScope> functions_;
+  int withDepth_ = 0;
+  size_t captures_ = 0;  // Functions, classes and direct evals seen so far
+
+  // Returns whether the finished function can read its own `arguments`.
+  bool finishFunction() {
+    FunctionScope scope = std::move(functions_.back());
+    functions_.pop_back();
+    // A direct eval may declare vars in this function's scope, which shadows
+    // outer bindings for every reference inside it, nested functions included.
+    if (scope.hasDirectEval) {
+      for (auto* id : scope.references) {
+        id->staticScope = false;
+        id->tdzFree = false;
+      }
+      return true;
+    }
+    if (!functions_.empty()) {
+      auto& parent = functions_.back().references;
+      parent.insert(parent.end(), scope.references.begin(), scope.references.end());
+    }
+    return scope.usesArguments;
+  }
+
+  // Arrow functions have no `arguments` of their own; reads in them (and
+  // direct evals, which may read it) go to the nearest enclosing function.
+  void markArgumentsUse() {
+    for (auto it = functions_.rbegin(); it != functions_.rend(); ++it) {
+      it->usesArguments = true;
+      if (!it->isArrow) {
+        break;
+      }
+    }
+  }
+
+  void reference(Identifier& id) {
+    id.atom = atomize(id.name);
+    if (id.name == "arguments") {
+      markArgumentsUse();
+    }
+    if (markScopes_ && withDepth_ == 0) {
+      id.staticScope = true;
+      id.tdzFree = declaredBefore(id.name);
+      functions_.back().references.push_back(&id);
+    }
+  }
+
+  // The innermost block of the current function that declares the name
+  // decides; names declared elsewhere (outer functions, globals of earlier
+  // scripts, var and parameters) are not tracked.
+  BlockScope* declaringBlock(const std::string& name) {
+    auto& blocks = functions_.back().blocks;
+    for (auto it = blocks.rbegin(); it != blocks.rend(); ++it) {
+      if (it->initialized.count(name)) {
+        return &*it;
+      }
+    }
+    return nullptr;
+  }
+
+  bool declaredBefore(const std::string& name) {
+    auto* block = declaringBlock(name);
+    return block && block->initialized[name];
+  }
+
+  static void boundNames(const ExprPtr& pattern, std::vector<std::string>& names) {
+    if (!pattern) {
+      return;
+    }
+    if (auto* id = std::get_if<Identifier>(&pattern->node)) {
+      names.push_back(id->name);
+    } else if (auto* array = std::get_if<ArrayPattern>(&pattern->node)) {
+      for (auto& element : array->elements) {
+        boundNames(element, names);
+      }
+      boundNames(array->rest, names);
+    } else if (auto* object = std::get_if<ObjectPattern>(&pattern->node)) {
+      for (auto& prop : object->properties) {
+        boundNames(prop.value, names);
+      }
+      boundNames(object->rest, names);
+    } else if (auto* assign = std::get_if<AssignmentPattern>(&pattern->node)) {
+      boundNames(assign->left, names);
+    } else if (auto* spread = std::get_if<SpreadElement>(&pattern->node)) {
+      boundNames(spread->argument, names);
+    }
+  }
+
+  static void lexicalNames(const StmtPtr& stmt, std::vector<std::string>& names) {
+    if (!stmt) {
+      return;
+    }
+    if (auto* decl = std::get_if<VarDeclaration>(&stmt->node)) {
+      if (decl->kind != VarDeclaration::Kind::Var) {
+        for (auto& d : decl->declarations) {
+          boundNames(d.pattern, names);
+        }
+      }
+    } else if (auto* cls = std::get_if<ClassDeclaration>(&stmt->node)) {
+      names.push_back(cls->id.name);
+    } else if (auto* exported = std::get_if<ExportNamedDeclaration>(&stmt->node)) {
+      lexicalNames(exported->declaration, names);
+    }
+  }
+
+  void enterBlock(const std::vector<std::string>& names, bool isSwitch = false) {
+    auto& block = functions_.back().blocks.emplace_back();
+    block.isSwitch = isSwitch;
+    for (auto& name : names) {
+      block.initialized.emplace(name, false);
+    }
+  }
+
+  void exitBlock() { functions_.back().blocks.pop_back(); }
+
+  void block(std::vector<StmtPtr>& body) {
+    std::vector<std::string> names;
+    for (auto& s : body) {
+      lexicalNames(s, names);
+    }
+    enterBlock(names);
+    statements(body);
+    exitBlock();
+  }
+
+  void initialize(const std::string& name) {
+    if (auto* block = declaringBlock(name); block && !block->isSwitch) {
+      block->initialized[name] = true;
+    }
+  }
+
+  template <typename FunctionNode>
+  void function(FunctionNode& node, bool isArrow = false) {
+    ++captures_;
+    functions_.emplace_back();
+    functions_.back().isArrow = isArrow;
+    for (auto& param : node.params) {
+      expression(param.defaultValue);
+    }
+    statements(node.destructurePrologue);
+    block(node.body);
+    node.usesArguments = finishFunction();
+  }
+
+  // Only the heritage and computed keys run inline with the class definition.
+  bool classBody(ExprPtr& superClass, std::vector<MethodDefinition>& methods) {
+    ++captures_;
+    bool suspends = expression(superClass);
+    for (auto& method : methods) {
+      suspends |= expression(method.computedKey);
+      if (method.initializer) {
+        functions_.emplace_back();
+        expression(method.initializer);
+        finishFunction();
+      }
+      if (method.kind != MethodDefinition::Kind::Field &&
+          method.kind != MethodDefinition::Kind::AutoAccessor) {
+        function(method);
+      }
+    }
+    return suspends;
+  }
+
+  bool expressions(std::vector<ExprPtr>& list) {
+    bool suspends = false;
+    for (auto& e : list) {
+      suspends |= expression(e);
+    }
+    return suspends;
+  }
+
+  void statements(std::vector<StmtPtr>& list) {
+    for (auto& s : list) {
+      statement(s);
+    }
+  }
+
+  bool expression(ExprPtr& ptr) {
+    return ptr && expression(*ptr);
+  }
+
+  bool expression(Expression& expr) {
+    expr.canSuspend = std::visit([this](auto& node) { return visit(node); }, expr.node);
+    return expr.canSuspend;
+  }
+
+  bool visit(Identifier& node) {
+    reference(node);
+    return false;
+  }
+  bool visit(NumberLiteral&) { return false; }
+  bool visit(BigIntLiteral&) { return false; }
+  bool visit(StringLiteral&) { return false; }
+  bool visit(TemplateLiteral& node) { return expressions(node.expressions); }
+  bool visit(TemplateObjectExpr&) { return false; }
+  bool visit(RegexLiteral&) { return false; }
+  bool visit(BoolLiteral&) { return false; }
+  bool visit(NullLiteral&) { return false; }
+  bool visit(BinaryExpr& node) {
+    bool suspends = expression(node.left);
+    return expression(node.right) || suspends;
+  }
+  bool visit(UnaryExpr& node) { return expression(node.argument); }
+  bool visit(AssignmentExpr& node) {
+    bool suspends = expression(node.left);
+    return expression(node.right) || suspends;
+  }
+  bool visit(UpdateExpr& node) { return expression(node.argument); }
+  bool visit(CallExpr& node) {
+    if (node.callee) {
+      if (auto* callee = std::get_if<Identifier>(&node.callee->node);
+          callee && callee->name == "eval") {
+        functions_.back().hasDirectEval = true;
+        ++captures_;
+        markArgumentsUse();
+      }
+    }
+    bool suspends = expression(node.callee);
+    return expressions(node.arguments) || suspends;
+  }
+  bool visit(MemberExpr& node) {
+    bool suspends = expression(node.object);
+    if (node.computed) {
+      suspends |= expression(node.property);
+    } else if (auto* id = node.property ? std::get_if<Identifier>(&node.property->node) : nullptr) {
+      id->atom = atomize(id->name);
+    }
+    return suspends;
+  }
+  bool visit(ConditionalExpr& node) {
+    bool suspends = expression(node.test);
+    suspends |= expression(node.consequent);
+    return expression(node.alternate) || suspends;
+  }
+  bool visit(SequenceExpr& node) { return expressions(node.expressions); }
+  bool visit(ArrayExpr& node) { return expressions(node.elements); }
+  bool visit(ObjectExpr& node) {
+    bool suspends = false;
+    for (auto& prop : node.properties) {
+      if (prop.isComputed || prop.isSpread) {
+        suspends |= expression(prop.key);
+      }
+      suspends |= expression(prop.value);
+    }
+    return suspends;
+  }
+  bool visit(FunctionExpr& node) {
+    function(node, node.isArrow);
+    return false;
+  }
+  bool visit(ClassExpr& node) {
+    // A named class expression binds its name, uninitialized, around the
+    // heritage and computed keys.
+    if (node.name.empty()) {
+      return classBody(node.superClass, node.methods);
+    }
+    enterBlock({node.name});
+    bool suspends = classBody(node.superClass, node.methods);
+    exitBlock();
+    return suspends;
+  }
+  bool visit(AwaitExpr& node) {
+    expression(node.argument);
+    return true;
+  }
+  bool visit(YieldExpr& node) {
+    expression(node.argument);
+    return true;
+  }
+  bool visit(NewExpr& node) {
+    bool suspends = expression(node.callee);
+    return expressions(node.arguments) || suspends;
+  }
+  bool visit(ThisExpr&) { return false; }
+  bool visit(SuperExpr&) { return false; }
+  bool visit(SpreadElement& node) { return expression(node.argument); }
+  bool visit(ArrayPattern& node) {
+    bool suspends = expressions(node.elements);
+    return expression(node.rest) || suspends;
+  }
+  bool visit(ObjectPattern& node) {
+    bool suspends = false;
+    for (auto& prop : node.properties) {
+      if (prop.computed) {
+        suspends |= expression(prop.key);
+      }
+      suspends |= expression(prop.value);
+    }
+    return expression(node.rest) || suspends;
+  }
+  bool visit(AssignmentPattern& node) {
+    bool suspends = expression(node.left);
+    return expression(node.right) || suspends;
+  }
+  bool visit(MetaProperty&) { return false; }
+
+  void statement(StmtPtr& ptr) {
+    if (ptr) {
+      std::visit([this](auto& node) { visitStatement(node); }, ptr->node);
+    }
+  }
+
+  void visitStatement(VarDeclaration& node) {
+    for (auto& decl : node.declarations) {
+      expression(decl.pattern);
+      expression(decl.init);
+      if (node.kind != VarDeclaration::Kind::Var) {
+        std::vector<std::string> names;
+        boundNames(decl.pattern, names);
+        for (auto& name : names) {
+          initialize(name);
+        }
+      }
+    }
+  }
+  void visitStatement(FunctionDeclaration& node) {
+    function(node);
+  }
+  void visitStatement(ClassDeclaration& node) {
+    classBody(node.superClass, node.methods);
+    initialize(node.id.name);
+  }
+  void visitStatement(EmptyStmt&) {}
+  void visitStatement(ReturnStmt& node) { expression(node.argument); }
+  void visitStatement(ExpressionStmt& node) { expression(node.expression); }
+  void visitStatement(BlockStmt& node) { block(node.body); }
+  void visitStatement(IfStmt& node) {
+    expression(node.test);
+    statement(node.consequent);
+    statement(node.alternate);
+  }
+  void visitStatement(WhileStmt& node) {
+    expression(node.test);
+    statement(node.body);
+  }
+  void visitStatement(ForStmt& node) {
+    size_t capturesBefore = captures_;
+    std::vector<std::string> names;
+    lexicalNames(node.init, names);
+    enterBlock(names);
+    statement(node.init);
+    expression(node.test);
+    expression(node.update);
+    statement(node.body);
+    exitBlock();
+    node.perIterationBindings = captures_ != capturesBefore;
+  }
+  void visitStatement(WithStmt& node) {
+    expression(node.object);
+    ++withDepth_;
+    statement(node.body);
+    --withDepth_;
+  }
+  // The head's let/const names are in TDZ while the iterated expression
+  // runs and bound before every iteration of the body.
+  template <typename ForEachNode>
+  void forEach(ForEachNode& node) {
+    std::vector<std::string> names;
+    lexicalNames(node.left, names);
+    enterBlock(names);
+    expression(node.right);
+    statement(node.left);
+    statement(node.body);
+    exitBlock();
+  }
+  void visitStatement(ForInStmt& node) { forEach(node); }
+  void visitStatement(ForOfStmt& node) { forEach(node); }
+  void visitStatement(DoWhileStmt& node) {
+    statement(node.body);
+    expression(node.test);
+  }
+  void visitStatement(SwitchStmt& node) {
+    expression(node.discriminant);
+    std::vector<std::string> names;
+    for (auto& c : node.cases) {
+      for (auto& s : c.consequent) {
+        lexicalNames(s, names);
+      }
+    }
+    enterBlock(names, true);
+    for (auto& c : node.cases) {
+      expression(c.test);
+      statements(c.consequent);
+    }
+    exitBlock();
+  }
+  void visitStatement(BreakStmt&) {}
+  void visitStatement(ContinueStmt&) {}
+  void visitStatement(DebuggerStmt&) {}
+  void visitStatement(LabelledStmt& node) { statement(node.body); }
+  void visitStatement(ThrowStmt& node) { expression(node.argument); }
+  void visitStatement(TryStmt& node) {
+    block(node.block);
+    expression(node.handler.paramPattern);
+    block(node.handler.body);
+    block(node.finalizer);
+  }
+  void visitStatement(ImportDeclaration&) {}
+  void visitStatement(ExportNamedDeclaration& node) { statement(node.declaration); }
+  void visitStatement(ExportDefaultDeclaration& node) { expression(node.declaration); }
+  void visitStatement(ExportAllDeclaration&) {}
+};
+
+}  // namespace
+
+void resolveScopes(Program& program, bool isEvalCode) {
+  ScopeResolver(!isEvalCode).resolve(program);
+}
+
+}  // namespace lightjs
@@ -0,0 +1,238 @@
+#include "property_map.h"
+#include <stdexcept>
+#include <utility>
+
+namespace lightjs {
+
+namespace {
+
+bool isAccessorKey(const std::string& key) {
+  return key.starts_with("__get_") || key.starts_with("__set_");
+}
+
+}  // namespace
+
+PropertyMap::PropertyMap(const PropertyMap& other)
+    : shape_(other.shape_),
+      slots_(other.slots_),
+      dictionary_(other.dictionary_
+                      ? std::make_unique<OrderedMap<std::string, Value>>(*other.dictionary_)
+                      : nullptr),
+      dictionaryAccessors_(other.dictionaryAccessors_) {}
+
+PropertyMap& PropertyMap::operator=(const PropertyMap& other) {
+  if (this != &other) {
+    PropertyMap copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+// A moved-from map is left empty at the root shape, not shapeless.
+PropertyMap::PropertyMap(PropertyMap&& other) noexcept
+    : shape_(std::exchange(other.shape_, ObjectShape::createRootShape())),
+      slots_(std::move(other.slots_)),
+      dictionary_(std::move(other.dictionary_)),
+      dictionaryAccessors_(std::exchange(other.dictionaryAccessors_, 0)) {
+  other.slots_.clear();
+  other.invalidate();
+}
+
+PropertyMap& PropertyMap::operator=(PropertyMap&& other) noexcept {
+  if (this != &other) {
+    invalidate();
+    other.invalidate();
+    shape_ = std::exchange(other.shape_, ObjectShape::createRootShape());
+    slots_ = std::move(other.slots_);
+    dictionary_ = std::move(other.dictionary_);
+    dictionaryAccessors_ = std::exchange(other.dictionaryAccessors_, 0);
+    other.slots_.clear();
+  }
+  return *this;
+}
+
+Value& PropertyMap::operator[](const std::string& key) {
+  if (dictionary_) {
+    return dictionaryInsert(key);
+  }
+  Atom atom = atomize(key);
+  int offset = shape_->getPropertyOffset(atom);
+  if (offset >= 0) {
+    // The caller may be about to replace the prototype.
+    if (atom == AtomTable::kProtoAtom) {
+      invalidate();
+    }
+    return slots_[offset];
+  }
+  if (slots_.size() >= kMaxShapeProperties) {
+    makeDictionary();
+    return dictionaryInsert(key);
+  }
+  invalidate();
+  shape_ = shape_->addProperty(atom);
+  return slots_.push_back();
+}
+
+PropertyMap::iterator PropertyMap::find(const std::string& key) {
+  if (dictionary_) {
+    return iterator(this, dictionary_->find(key));
+  }
+  int offset = shape_->getPropertyOffset(key);
+  return iterator(this, offset >= 0 ? static_cast<size_t>(offset) : slots_.size());
+}
+
+PropertyMap::iterator PropertyMap::find(Atom atom) {
+  if (dictionary_) {
+    return atom == kNoAtom ? end() : find(AtomTable::instance().name(atom));
+  }
+  int offset = shape_->getPropertyOffset(atom);
+  return iterator(this, offset >= 0 ? static_cast<size_t>(offset) : slots_.size());
+}
+
+PropertyMap::const_iterator PropertyMap::find(const std::string& key) const {
+  if (dictionary_) {
+    return const_iterator(this, std::as_const(*dictionary_).find(key));
+  }
+  int offset = shape_->getPropertyOffset(key);
+  return const_iterator(this, offset >= 0 ? static_cast<size_t>(offset) : slots_.size());
+}
+
+PropertyMap::iterator PropertyMap::begin() {
+  return dictionary_ ? iterator(this, dictionary_->begin()) : iterator(this, size_t{0});
+}
+
+PropertyMap::iterator PropertyMap::end() {
+  return dictionary_ ? iterator(this, dictionary_->end()) : iterator(this, slots_.size());
+}
+
+PropertyMap::const_iterator PropertyMap::begin() const {
+  return dictionary_ ? const_iterator(this, std::as_const(*dictionary_).begin())
+                     : const_iterator(this, size_t{0});
+}
+
+PropertyMap::const_iterator PropertyMap::end() const {
+  return dictionary_ ? const_iterator(this, std::as_const(*dictionary_).end())
+                     : const_iterator(this, slots_.size());
+}
+
+PropertyMap::size_type PropertyMap::count(const std::string& key) const {
+  return dictionary_ ? dictionary_->count(key) : (shape_->hasProperty(key) ? 1 : 0);
+}
+
+PropertyMap::size_type PropertyMap::count(Atom atom) const {
+  if (dictionary_) {
+    return atom == kNoAtom ? 0 : dictionary_->count(AtomTable::instance().name(atom));
+  }
+  return shape_->hasProperty(atom) ? 1 : 0;
+}
+
+Value& PropertyMap::at(const std::string& key) {
+  if (dictionary_) {
+    return dictionary_->at(key);
+  }
+  int offset = shape_->getPropertyOffset(key);
+  if (offset < 0) {
+    throw std::out_of_range("PropertyMap::at");
+  }
+  return slots_[offset];
+}
+
+const Value& PropertyMap::at(const std::string& key) const {
+  return const_cast<PropertyMap*>(this)->at(key);
+}
+
+PropertyMap::size_type PropertyMap::erase(const std::string& key) {
+  if (dictionary_) {
+    return dictionaryErase(key);
+  }
+  int offset = shape_->getPropertyOffset(key);
+  if (offset < 0) {
+    return 0;
+  }
+  // Undoing the latest transition keeps the map on the shared tree.
+  if (static_cast<size_t>(offset) + 1 == slots_.size() && shape_->getParent()) {
+    invalidate();
+    shape_ = shape_->getParent();
+    slots_.pop_back();
+    return 1;
+  }
+  makeDictionary();
+  return dictionaryErase(key);
+}
+
+void PropertyMap::clear() {
+  invalidate();
+  shape_ = ObjectShape::createRootShape();
+  slots_.clear();
+  dictionary_.reset();
+  dictionaryAccessors_ = 0;
+}
+
+const Value* PropertyMap::lookup(const std::string& key) const {
+  if (dictionary_) {
+    auto it = std::as_const(*dictionary_).find(key);
+    return it != std::as_const(*dictionary_).end() ? &it->second : nullptr;
+  }
+  int offset = shape_->getPropertyOffset(key);
+  return offset >= 0 ? &slots_[offset] : nullptr;
+}
+
+const Value* PropertyMap::accessorSlot(const std::string& name, AtomKind kind) const {
+  if (dictionary_) {
+    return lookup((kind == AtomKind::Getter ? "__get_" : "__set_") + name);
+  }
+  // Every shape key has an atom, and atomizing an accessor key records it
+  // against its property name, so no key string is built here.
+  auto& atoms = AtomTable::instance();
+  Atom atom = atoms.accessorAtom(atoms.find(name), kind);
+  int offset = shape_->getPropertyOffset(atom);
+  return offset >= 0 ? &slots_[offset] : nullptr;
+}
+
+const Value* PropertyMap::prototype() const {
+  if (dictionary_) {
+    auto it = std::as_const(*dictionary_).find(AtomTable::instance().name(AtomTable::kProtoAtom));
+    return it != std::as_const(*dictionary_).end() ? &it->second : nullptr;
+  }
+  int offset = shape_->getPrototypeOffset();
+  return offset >= 0 ? &slots_[offset] : nullptr;
+}
+
+Value& PropertyMap::dictionaryInsert(const std::string& key) {
+  size_t before = dictionary_->size();
+  Value& value = (*dictionary_)[key];
+  if (dictionary_->size() != before) {
+    invalidate();
+    if (isAccessorKey(key)) {
+      dictionaryAccessors_++;
+    }
+  } else if (validityCell_ && key == "__proto__") {
+    invalidate();
+  }
+  return value;
+}
+
+PropertyMap::size_type PropertyMap::dictionaryErase(const std::string& key) {
+  size_type erased = dictionary_->erase(key);
+  if (erased) {
+    invalidate();
+    if (isAccessorKey(key)) {
+      dictionaryAccessors_--;
+    }
+  }
+  return erased;
+}
+
+void PropertyMap::makeDictionary() {
+  auto dictionary = std::make_unique<OrderedMap<std::string, Value>>();
+  const auto& names = shape_->getPropertyNames();
+  for (size_t i = 0; i < slots_.size(); ++i) {
+    (*dictionary)[names[i]] = std::move(slots_[i]);
+  }
+  dictionary_ = std::move(dictionary);
+  dictionaryAccessors_ = shape_->getAccessorCount();
+  slots_.clear();
+  shape_ = ObjectShape::createRootShape();
+}
+
+}  // namespace lightjs
@@ -349,9 +349,8 @@ void ReadableStream::getReferences(std::vector<GCObject*>& refs) const {
   if (storedError) {
     // storedError is a Value, which manages its own memory
   }
-  if (controller) refs.push_back(controller.get());
-  auto* readerPtr = reader;
-  if (readerPtr) refs.push_back(readerPtr);
+  // The controller (shared_ptr) and reader (raw pointer) are not counted
+  // references, so they must not be reported.
 }
 
 // ===========================================================================
@@ -612,9 +611,8 @@ GCPtr<Promise> WritableStream::close() {
 }
 
 void WritableStream::getReferences(std::vector<GCObject*>& refs) const {
-  if (controller) refs.push_back(controller.get());
-  auto* writerPtr = writer;
-  if (writerPtr) refs.push_back(writerPtr);
+  // The controller (shared_ptr) and writer (raw pointer) are not counted
+  // references, so they must not be reported.
   if (pendingAbortRequest) refs.push_back(pendingAbortRequest.get());
   if (closeRequest) refs.push_back(closeRequest.get());
   if (inFlightWriteRequest) refs.push_back(inFlightWriteRequest.get());
@@ -683,7 +681,6 @@ void TransformStreamDefaultController::getReferences(std::vector<GCObject*>& ref
 void TransformStream::getReferences(std::vector<GCObject*>& refs) const {
   if (readable) refs.push_back(readable.get());
   if (writable) refs.push_back(writable.get());
-  if (controller) refs.push_back(controller.get());
   if (backpressureChangePromise) refs.push_back(backpressureChangePromise.get());
 }
 
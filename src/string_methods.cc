@@ -20,13 +20,13 @@ constexpr size_t kMaxSplitResultElements = (256 * 1024 * 1024) / sizeof(Value);
 void appendSplitResult(const GCPtr<Array>& result,
                        uint32_t limit,
                        const Value& value) {
-    if (result->elements.size() >= limit) {
+    if (result->elementCount() >= limit) {
         return;
     }
-    if (result->elements.size() >= kMaxSplitResultElements) {
+    if (result->elementCount() >= kMaxSplitResultElements) {
         throw std::runtime_error("RangeError: split result exceeds implementation limit");
     }
-    result->elements.push_back(value);
+    result->pushElement(value);
 }
 
 bool isObjectLikeForStringBuiltin(const Value& v) {
@@ -121,6 +121,25 @@ std::string requireStringCoercibleThis(const std::vector<Value>& args, const cha
     return primitive.toString();
 }
 
+const std::string* requireStringCoercibleThis(const Value& thisValue, const char* methodName,
+                                              std::string& storage, NativeThrow& thrown) {
+    if (thisValue.isString()) {
+        return &thisValue.asString();
+    }
+    if (thisValue.isUndefined() || thisValue.isNull()) {
+        thrown.error(ErrorType::TypeError, std::string("String.prototype.") + methodName +
+                                               " called on null or undefined");
+        return nullptr;
+    }
+    Value primitive = toPrimitiveForStringBuiltinImpl(thisValue, true);
+    if (primitive.isSymbol()) {
+        thrown.error(ErrorType::TypeError, "Cannot convert Symbol to string");
+        return nullptr;
+    }
+    storage = primitive.toString();
+    return &storage;
+}
+
 std::string utf16CodeUnitStringAt(const std::string& str, size_t targetIndex) {
     uint16_t codeUnit = 0;
     if (!unicode::utf16CodeUnitAt(str, targetIndex, codeUnit)) {
@@ -171,11 +190,14 @@ std::string String_utf16CodeUnitStringAt(const std::string& str, size_t targetIn
 }
 
 // String.prototype.charAt (UTF-16 code unit based)
-Value String_charAt(const std::vector<Value>& args) {
-    std::string str = requireStringCoercibleThis(args, "charAt");
+Value String_charAt(const Value& thisValue, std::span<const Value> args, Interpreter&, NativeThrow& thrown) {
+    std::string storage;
+    const std::string* thisString = requireStringCoercibleThis(thisValue, "charAt", storage, thrown);
+    if (!thisString) return Value(Undefined{});
+    const std::string& str = *thisString;
     int index = 0;
-    if (args.size() > 1 && !args[1].isUndefined()) {
-        index = static_cast<int>(toIntegerForStringBuiltinArg(args[1]));
+    if (!args.empty() && !args[0].isUndefined()) {
+        index = static_cast<int>(toIntegerForStringBuiltinArg(args[0]));
     }
 
     if (index < 0) {
@@ -190,11 +212,14 @@ Value String_charAt(const std::vector<Value>& args) {
 }
 
 // String.prototype.charCodeAt (UTF-16 code unit based)
-Value String_charCodeAt(const std::vector<Value>& args) {
-    std::string str = requireStringCoercibleThis(args, "charCodeAt");
+Value String_charCodeAt(const Value& thisValue, std::span<const Value> args, Interpreter&, NativeThrow& thrown) {
+    std::string storage;
+    const std::string* thisString = requireStringCoercibleThis(thisValue, "charCodeAt", storage, thrown);
+    if (!thisString) return Value(Undefined{});
+    const std::string& str = *thisString;
     int index = 0;
-    if (args.size() > 1 && !args[1].isUndefined()) {
-        index = static_cast<int>(toIntegerForStringBuiltinArg(args[1]));
+    if (!args.empty() && !args[0].isUndefined()) {
+        index = static_cast<int>(toIntegerForStringBuiltinArg(args[0]));
     }
 
     uint16_t codeUnit = 0;
@@ -205,11 +230,14 @@ Value String_charCodeAt(const std::vector<Value>& args) {
 }
 
 // String.prototype.codePointAt
-Value String_codePointAt(const std::vector<Value>& args) {
-    std::string str = requireStringCoercibleThis(args, "codePointAt");
+Value String_codePointAt(const Value& thisValue, std::span<const Value> args, Interpreter&, NativeThrow& thrown) {
+    std::string storage;
+    const std::string* thisString = requireStringCoercibleThis(thisValue, "codePointAt", storage, thrown);
+    if (!thisString) return Value(Undefined{});
+    const std::string& str = *thisString;
     int index = 0;
-    if (args.size() > 1 && !args[1].isUndefined()) {
-        index = static_cast<int>(toIntegerForStringBuiltinArg(args[1]));
+    if (!args.empty() && !args[0].isUndefined()) {
+        index = static_cast<int>(toIntegerForStringBuiltinArg(args[0]));
     }
 
     if (index < 0 || static_cast<size_t>(index) >= unicode::utf16Length(str)) {
@@ -240,12 +268,15 @@ Value String_codePointAt(const std::vector<Value>& args) {
 }
 
 // String.prototype.at
-Value String_at(const std::vector<Value>& args) {
-    std::string str = requireStringCoercibleThis(args, "at");
+Value String_at(const Value& thisValue, std::span<const Value> args, Interpreter&, NativeThrow& thrown) {
+    std::string storage;
+    const std::string* thisString = requireStringCoercibleThis(thisValue, "at", storage, thrown);
+    if (!thisString) return Value(Undefined{});
+    const std::string& str = *thisString;
     int len = static_cast<int>(unicode::utf16Length(str));
     int index = 0;
-    if (args.size() > 1 && !args[1].isUndefined()) {
-        index = static_cast<int>(toIntegerForStringBuiltinArg(args[1]));
+    if (!args.empty() && !args[0].isUndefined()) {
+        index = static_cast<int>(toIntegerForStringBuiltinArg(args[0]));
     }
 
     if (index < 0) index = len + index;
@@ -257,14 +288,17 @@ Value String_at(const std::vector<Value>& args) {
 }
 
 // String.prototype.indexOf
-Value String_indexOf(const std::vector<Value>& args) {
-    std::string str = requireStringCoercibleThis(args, "indexOf");
-    std::string searchStr = (args.size() > 1) ? toStringForStringBuiltinArg(args[1]) : "undefined";
+Value String_indexOf(const Value& thisValue, std::span<const Value> args, Interpreter&, NativeThrow& thrown) {
+    std::string storage;
+    const std::string* thisString = requireStringCoercibleThis(thisValue, "indexOf", storage, thrown);
+    if (!thisString) return Value(Undefined{});
+    const std::string& str = *thisString;
+    std::string searchStr = (!args.empty()) ? toStringForStringBuiltinArg(args[0]) : "undefined";
     
     int len = static_cast<int>(unicode::utf16Length(str));
     int start = 0;
-    if (args.size() > 2 && !args[2].isUndefined()) {
-        start = static_cast<int>(toIntegerForStringBuiltinArg(args[2]));
+    if (args.size() > 1 && !args[1].isUndefined()) {
+        start = static_cast<int>(toIntegerForStringBuiltinArg(args[1]));
     }
     
     int pos = std::max(0, std::min(start, len));
@@ -291,16 +325,19 @@ Value String_indexOf(const std::vector<Value>& args) {
 }
 
 // String.prototype.lastIndexOf
-Value String_lastIndexOf(const std::vector<Value>& args) {
-    std::string str = requireStringCoercibleThis(args, "lastIndexOf");
-    std::string searchStr = (args.size() > 1) ? toStringForStringBuiltinArg(args[1]) : "undefined";
+Value String_lastIndexOf(const Value& thisValue, std::span<const Value> args, Interpreter&, NativeThrow& thrown) {
+    std::string storage;
+    const std::string* thisString = requireStringCoercibleThis(thisValue, "lastIndexOf", storage, thrown);
+    if (!thisString) return Value(Undefined{});
+    const std::string& str = *thisString;
+    std::string searchStr = (!args.empty()) ? toStringForStringBuiltinArg(args[0]) : "undefined";
     
     int len = static_cast<int>(unicode::utf16Length(str));
     int start = len;
-    if (args.size() > 2 && !args[2].isUndefined()) {
-        double num = toNumberForStringBuiltinArg(args[2]);
+    if (args.size() > 1 && !args[1].isUndefined()) {
+        double num = toNumberForStringBuiltinArg(args[1]);
         if (std::isnan(num)) start = len;
-        else start = static_cast<int>(toIntegerForStringBuiltinArg(args[2]));
+        else start = static_cast<int>(toIntegerForStringBuiltinArg(args[1]));
     }
     
     int pos = std::max(0, std::min(start, len));
@@ -328,8 +365,11 @@ Value String_lastIndexOf(const std::vector<Value>& args) {
 }
 
 // String.prototype.substring
-Value String_substring(const std::vector<Value>& args) {
-    std::string str = requireStringCoercibleThis(args, "substring");
+Value String_substring(const Value& thisValue, std::span<const Value> args, Interpreter&, NativeThrow& thrown) {
+    std::string storage;
+    const std::string* thisString = requireStringCoercibleThis(thisValue, "substring", storage, thrown);
+    if (!thisString) return Value(Undefined{});
+    const std::string& str = *thisString;
     int len = static_cast<int>(unicode::utf16Length(str));
     auto clampSubstringIndex = [len](const Value& value) -> int {
         double number = toNumberForStringBuiltinArg(value);
@@ -339,12 +379,12 @@ Value String_substring(const std::vector<Value>& args) {
     };
 
     int start = 0;
-    if (args.size() > 1 && !args[1].isUndefined()) {
-        start = clampSubstringIndex(args[1]);
+    if (!args.empty() && !args[0].isUndefined()) {
+        start = clampSubstringIndex(args[0]);
     }
     int end = len;
-    if (args.size() > 2 && !args[2].isUndefined()) {
-        end = clampSubstringIndex(args[2]);
+    if (args.size() > 1 && !args[1].isUndefined()) {
+        end = clampSubstringIndex(args[1]);
     }
 
     if (start > end) std::swap(start, end);
@@ -353,18 +393,21 @@ Value String_substring(const std::vector<Value>& args) {
 }
 
 // String.prototype.substr
-Value String_substr(const std::vector<Value>& args) {
-    std::string str = requireStringCoercibleThis(args, "substr");
+Value String_substr(const Value& thisValue, std::span<const Value> args, Interpreter&, NativeThrow& thrown) {
+    std::string storage;
+    const std::string* thisString = requireStringCoercibleThis(thisValue, "substr", storage, thrown);
+    if (!thisString) return Value(Undefined{});
+    const std::string& str = *thisString;
     int len = static_cast<int>(unicode::utf16Length(str));
     int start = 0;
-    if (args.size() > 1 && !args[1].isUndefined()) {
-        start = static_cast<int>(toIntegerForStringBuiltinArg(args[1]));
+    if (!args.empty() && !args[0].isUndefined()) {
+        start = static_cast<int>(toIntegerForStringBuiltinArg(args[0]));
     }
     if (start < 0) start = std::max(0, len + start);
     
     int length = len - start;
-    if (args.size() > 2 && !args[2].isUndefined()) {
-        length = static_cast<int>(toIntegerForStringBuiltinArg(args[2]));
+    if (args.size() > 1 && !args[1].isUndefined()) {
+        length = static_cast<int>(toIntegerForStringBuiltinArg(args[1]));
     }
     if (length <= 0) return Value(std::string(""));
     
@@ -372,8 +415,11 @@ Value String_substr(const std::vector<Value>& args) {
 }
 
 // String.prototype.slice
-Value String_slice(const std::vector<Value>& args) {
-    std::string str = requireStringCoercibleThis(args, "slice");
+Value String_slice(const Value& thisValue, std::span<const Value> args, Interpreter&, NativeThrow& thrown) {
+    std::string storage;
+    const std::string* thisString = requireStringCoercibleThis(thisValue, "slice", storage, thrown);
+    if (!thisString) return Value(Undefined{});
+    const std::string& str = *thisString;
     int len = static_cast<int>(unicode::utf16Length(str));
     auto clampSliceIndex = [len](double index) -> int {
         if (std::isnan(index)) return 0;
@@ -384,12 +430,12 @@ Value String_slice(const std::vector<Value>& args) {
     };
 
     int start = 0;
-    if (args.size() > 1 && !args[1].isUndefined()) {
-        start = clampSliceIndex(toIntegerForStringBuiltinArg(args[1]));
+    if (!args.empty() && !args[0].isUndefined()) {
+        start = clampSliceIndex(toIntegerForStringBuiltinArg(args[0]));
     }
     int end = len;
-    if (args.size() > 2 && !args[2].isUndefined()) {
-        end = clampSliceIndex(toIntegerForStringBuiltinArg(args[2]));
+    if (args.size() > 1 && !args[1].isUndefined()) {
+        end = clampSliceIndex(toIntegerForStringBuiltinArg(args[1]));
     }
 
     if (end < start) {
@@ -398,14 +444,20 @@ Value String_slice(const std::vector<Value>& args) {
     return Value(unicode::utf16Slice(str, start, end));
 }
 // String.prototype.toLowerCase
-Value String_toLowerCase(const std::vector<Value>& args) {
-    std::string str = requireStringCoercibleThis(args, "toLowerCase");
+Value String_toLowerCase(const Value& thisValue, std::span<const Value> args, Interpreter&, NativeThrow& thrown) {
+    std::string storage;
+    const std::string* thisString = requireStringCoercibleThis(thisValue, "toLowerCase", storage, thrown);
+    if (!thisString) return Value(Undefined{});
+    const std::string& str = *thisString;
     return Value(unicode::toLower(str));
 }
 
 // String.prototype.toUpperCase
-Value String_toUpperCase(const std::vector<Value>& args) {
-    std::string str = requireStringCoercibleThis(args, "toUpperCase");
+Value String_toUpperCase(const Value& thisValue, std::span<const Value> args, Interpreter&, NativeThrow& thrown) {
+    std::string storage;
+    const std::string* thisString = requireStringCoercibleThis(thisValue, "toUpperCase", storage, thrown);
+    if (!thisString) return Value(Undefined{});
+    const std::string& str = *thisString;
     return Value(unicode::toUpper(str));
 }
 
@@ -464,7 +516,7 @@ Value String_split(const std::vector<Value>& args) {
     if (limit == 0) return Value(result);
     if (separator.empty()) {
         size_t len = unicode::utf16Length(str);
-        for (size_t i = 0; i < len && result->elements.size() < limit; ++i) {
+        for (size_t i = 0; i < len && result->elementCount() < limit; ++i) {
             uint16_t unit;
             if (unicode::utf16CodeUnitAt(str, i, unit)) {
                 appendSplitResult(result, limit, Value(unicode::encodeUTF8(unit)));
@@ -476,11 +528,11 @@ Value String_split(const std::vector<Value>& args) {
     size_t start = 0;
     size_t pos;
     while ((pos = str.find(separator, start)) != std::string::npos) {
-        if (result->elements.size() >= limit) break;
+        if (result->elementCount() >= limit) break;
         appendSplitResult(result, limit, Value(str.substr(start, pos - start)));
         start = pos + separator.length();
     }
-    if (result->elements.size() < limit) {
+    if (result->elementCount() < limit) {
         appendSplitResult(result, limit, Value(str.substr(start)));
     }
     return Value(result);
@@ -890,7 +942,7 @@ Value String_match(const std::vector<Value>& args) {
         return Value(Null{});
     }
     auto result = makeArrayWithPrototype();
-    result->elements.push_back(Value(searchStr));
+    result->pushElement(Value(searchStr));
     result->properties["index"] = Value(static_cast<double>(pos));
     result->properties["input"] = Value(str);
     return Value(result);
@@ -905,7 +957,7 @@ Value String_iterator(const std::vector<Value>& args) {
     while (byteIndex < str.size()) {
         size_t start = byteIndex;
         unicode::decodeUTF8(str, byteIndex);
-        charArray->elements.push_back(Value(str.substr(start, byteIndex - start)));
+        charArray->pushElement(Value(str.substr(start, byteIndex - start)));
     }
     auto iteratorObj = GarbageCollector::makeGC<Object>();
     GarbageCollector::instance().reportAllocation(sizeof(Object));
@@ -913,10 +965,10 @@ Value String_iterator(const std::vector<Value>& args) {
     auto nextFn = GarbageCollector::makeGC<Function>();
     nextFn->isNative = true;
     nextFn->nativeFunc = [charArray, state](const std::vector<Value>&) -> Value {
-        if (!charArray || *state >= charArray->elements.size()) {
+        if (!charArray || *state >= charArray->elementCount()) {
             return Interpreter::makeIteratorResult(Value(Undefined{}), true);
         }
-        Value value = charArray->elements[(*state)++];
+        Value value = charArray->element((*state)++);
         return Interpreter::makeIteratorResult(value, false);
     };
     iteratorObj->properties["next"] = Value(nextFn);
@@ -74,4 +74,40 @@ void StringTable::resetStats() {
   stats_ = Stats();
 }
 
+AtomTable& AtomTable::instance() {
+  static AtomTable* table = new AtomTable();  // Outlives static destructors
+  return *table;
+}
+
+AtomTable::AtomTable() {
+  atomize("__proto__");
+}
+
+Atom AtomTable::atomize(std::string_view str) {
+  auto it = index_.find(str);
+  if (it != index_.end()) {
+    return it->second;
+  }
+  Atom atom = static_cast<Atom>(names_.size());
+  const std::string& stored = names_.emplace_back(str);
+  AtomKind kind = AtomKind::Plain;
+  if (str == "__proto__") {
+    kind = AtomKind::Prototype;
+  } else if (str.starts_with("__get_")) {
+    kind = AtomKind::Getter;
+  } else if (str.starts_with("__set_")) {
+    kind = AtomKind::Setter;
+  }
+  kinds_.push_back(kind);
+  index_.emplace(std::string_view(stored), atom);
+  if (kind == AtomKind::Getter || kind == AtomKind::Setter) {
+    Atom name = atomize(std::string_view(stored).substr(6));
+    if (accessorAtoms_.size() <= name) {
+      accessorAtoms_.resize(name + 1, {kNoAtom, kNoAtom});
+    }
+    (kind == AtomKind::Getter ? accessorAtoms_[name].first : accessorAtoms_[name].second) = atom;
+  }
+  return atom;
+}
+
 } // namespace lightjs
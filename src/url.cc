@@ -377,7 +377,7 @@ GCPtr<Function> createURLSearchParamsConstructor() {
       auto values = params->getAll(args[0].toString());
       auto arr = GarbageCollector::makeGC<Array>();
       for (const auto& v : values) {
-        arr->elements.push_back(Value(v));
+        arr->pushElement(Value(v));
       }
       return Value(arr);
     };
@@ -5,6 +5,11 @@ namespace lightjs {
 // Initialize static member for Symbol IDs
 size_t Symbol::nextId = 0;
 
+const std::shared_ptr<const SharedFunctionInfo>& SharedFunctionInfo::empty() {
+  static const std::shared_ptr<const SharedFunctionInfo> info = std::make_shared<SharedFunctionInfo>();
+  return info;
+}
+
 namespace {
 constexpr const char* kSymbolPropertyKeyPrefix = "@@sym:";
 }  // namespace
@@ -223,7 +228,7 @@ std::string ecmaNumberToString(double number) {
 
 std::string valueToPropertyKey(const Value& value) {
   if (value.isSymbol()) {
-    return symbolToPropertyKey(std::get<Symbol>(value.data));
+    return symbolToPropertyKey(value.asSymbol());
   }
   if (value.isNumber()) {
     return ecmaNumberToString(value.toNumber());
@@ -242,7 +247,7 @@ std::string valueToPropertyKey(const Value& value) {
       throw JsValueException(err);
     }
     if (primitive.isSymbol()) {
-      return symbolToPropertyKey(std::get<Symbol>(primitive.data));
+      return symbolToPropertyKey(primitive.asSymbol());
     }
     return primitive.toString();
   }
@@ -254,7 +259,7 @@ std::string valueToPropertyKey(const Value& value) {
     auto primIt = obj->properties.find("__primitive_value__");
     if (primIt != obj->properties.end()) {
       if (primIt->second.isSymbol()) {
-        return symbolToPropertyKey(std::get<Symbol>(primIt->second.data));
+        return symbolToPropertyKey(primIt->second.asSymbol());
       }
       return primIt->second.toString();
     }
@@ -264,10 +269,10 @@ std::string valueToPropertyKey(const Value& value) {
     // Arrays: try toString via join
     auto arr = value.getGC<Array>();
     std::string result;
-    for (size_t i = 0; i < arr->elements.size(); i++) {
+    for (size_t i = 0; i < arr->elementCount(); i++) {
       if (i > 0) result += ",";
-      if (!arr->elements[i].isUndefined() && !arr->elements[i].isNull()) {
-        result += arr->elements[i].toString();
+      if (!arr->element(i).isUndefined() && !arr->element(i).isNull()) {
+        result += arr->element(i).toString();
       }
     }
     return result;
@@ -286,12 +291,14 @@ bool Value::toBool() const {
       return arg;
     } else if constexpr (std::is_same_v<T, double>) {
       return arg != 0.0 && !std::isnan(arg);
-    } else if constexpr (std::is_same_v<T, BigInt>) {
-      return arg.value != 0;
-    } else if constexpr (std::is_same_v<T, Symbol>) {
+    } else if constexpr (std::is_same_v<T, int32_t>) {
+      return arg != 0;
+    } else if constexpr (std::is_same_v<T, ValueBox<BigInt>>) {
+      return arg.get().value != 0;
+    } else if constexpr (std::is_same_v<T, ValueBox<Symbol>>) {
       return true;  // Symbols are always truthy
-    } else if constexpr (std::is_same_v<T, std::string>) {
-      return !arg.empty();
+    } else if constexpr (std::is_same_v<T, ValueBox<std::string>>) {
+      return !arg.get().empty();
     } else {
       return true;
     }
@@ -307,12 +314,12 @@ double Value::toNumber() const {
       return 0.0;
     } else if constexpr (std::is_same_v<T, bool>) {
       return arg ? 1.0 : 0.0;
-    } else if constexpr (std::is_same_v<T, double>) {
+    } else if constexpr (std::is_same_v<T, double> || std::is_same_v<T, int32_t>) {
       return arg;
-    } else if constexpr (std::is_same_v<T, BigInt>) {
-      return arg.value.template convert_to<double>();
-    } else if constexpr (std::is_same_v<T, std::string>) {
-      std::string s = stripESWhitespace(arg);
+    } else if constexpr (std::is_same_v<T, ValueBox<BigInt>>) {
+      return arg.get().value.template convert_to<double>();
+    } else if constexpr (std::is_same_v<T, ValueBox<std::string>>) {
+      std::string s = stripESWhitespace(arg.get());
       if (s.empty()) {
         return 0.0;
       }
@@ -415,11 +422,13 @@ bigint::BigIntValue Value::toBigInt() const {
       if (bigint::fromIntegralDouble(arg, out)) return out;
       if (!std::isfinite(arg)) return 0;
       return static_cast<int64_t>(arg);
-    } else if constexpr (std::is_same_v<T, BigInt>) {
-      return arg.value;
-    } else if constexpr (std::is_same_v<T, std::string>) {
+    } else if constexpr (std::is_same_v<T, int32_t>) {
+      return static_cast<int64_t>(arg);
+    } else if constexpr (std::is_same_v<T, ValueBox<BigInt>>) {
+      return arg.get().value;
+    } else if constexpr (std::is_same_v<T, ValueBox<std::string>>) {
       bigint::BigIntValue parsed = 0;
-      if (bigint::parseBigIntString(arg, parsed)) return parsed;
+      if (bigint::parseBigIntString(arg.get(), parsed)) return parsed;
       return 0;
     } else {
       return 0;
@@ -438,17 +447,19 @@ std::string Value::toString() const {
       return arg ? "true" : "false";
     } else if constexpr (std::is_same_v<T, double>) {
       return ecmaNumberToString(arg);
-    } else if constexpr (std::is_same_v<T, BigInt>) {
-      return bigint::toString(arg.value);
-    } else if constexpr (std::is_same_v<T, Symbol>) {
-      if (arg.hasDescription) {
-        return "Symbol(" + arg.description + ")";
+    } else if constexpr (std::is_same_v<T, int32_t>) {
+      return std::to_string(arg);
+    } else if constexpr (std::is_same_v<T, ValueBox<BigInt>>) {
+      return bigint::toString(arg.get().value);
+    } else if constexpr (std::is_same_v<T, ValueBox<Symbol>>) {
+      if (arg.get().hasDescription) {
+        return "Symbol(" + arg.get().description + ")";
       }
       return "Symbol()";
-    } else if constexpr (std::is_same_v<T, ModuleBinding>) {
+    } else if constexpr (std::is_same_v<T, ValueBox<ModuleBinding>>) {
       return "[ModuleBinding]";
-    } else if constexpr (std::is_same_v<T, std::string>) {
-      return arg;
+    } else if constexpr (std::is_same_v<T, ValueBox<std::string>>) {
+      return arg.get();
     } else if constexpr (std::is_same_v<T, GCPtr<Function>>) {
       return "[Function]";
     } else if constexpr (std::is_same_v<T, GCPtr<Class>>) {
@@ -492,7 +503,7 @@ std::string Value::toString() const {
 
 std::string Value::toDisplayString() const {
   if (isBigInt()) {
-    return bigint::toString(std::get<BigInt>(data).value) + "n";
+    return bigint::toString(asBigInt().value) + "n";
   }
   return toString();
 }
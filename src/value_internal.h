@@ -208,7 +208,7 @@ void resolveChainedPromise(const GCPtr<Promise>& target, const Value& value) {
       return;
     }
     if (nested.get() == target.get()) {
-      target->reject(Value(std::make_shared<Error>(
+      target->reject(Value(GarbageCollector::makeGC<Error>(
         ErrorType::TypeError, "Cannot resolve promise with itself")));
       return;
     }
@@ -296,7 +296,7 @@ static std::vector<std::string> sortOwnPropertyKeys(
 
 // Object static methods implementation
 // Helper to get the OrderedMap properties from any object-like value
-static OrderedMap<std::string, Value>* getPropertiesMap(const Value& val) {
+static PropertyMap* getPropertiesMap(const Value& val) {
   if (val.isObject()) return &val.getGC<Object>()->properties;
   if (val.isFunction()) return &val.getGC<Function>()->properties;
   if (val.isArray()) return &val.getGC<Array>()->properties;
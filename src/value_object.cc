@@ -16,12 +16,12 @@ Value Object_keys(const std::vector<Value>& args) {
 
   // Handle string primitives: Object.keys("abc") → ["0","1","2"]
   if (arg.isString()) {
-    const std::string& str = std::get<std::string>(arg.data);
+    const std::string& str = arg.asString();
     // Count code points for proper Unicode support
     size_t cpIdx = 0;
     size_t bytePos = 0;
     while (bytePos < str.size()) {
-      result->elements.push_back(Value(std::to_string(cpIdx)));
+      result->pushElement(Value(std::to_string(cpIdx)));
       // Skip UTF-8 bytes
       unsigned char c = str[bytePos];
       if (c < 0x80) bytePos += 1;
@@ -45,7 +45,7 @@ Value Object_keys(const std::vector<Value>& args) {
             getter->nativeFunc({});
           }
         }
-        result->elements.push_back(Value(key));
+        result->pushElement(Value(key));
       }
       return Value(result);
     }
@@ -59,14 +59,14 @@ Value Object_keys(const std::vector<Value>& args) {
   // For Arrays, include numeric indices first
   if (arg.isArray()) {
     auto arr = arg.getGC<Array>();
-    for (size_t i = 0; i < arr->elements.size(); ++i) {
+    for (size_t i = 0; i < arr->elementCount(); ++i) {
       std::string key = std::to_string(i);
       // Skip non-enumerable
       if (arr->properties.count("__non_enum_" + key)) continue;
       // Skip holes (deleted or never-set elements)
       if (arr->properties.count("__deleted_" + key + "__")) continue;
       if (arr->properties.count("__hole_" + key + "__")) continue;
-      result->elements.push_back(Value(key));
+      result->pushElement(Value(key));
     }
     // Then add non-index enumerable properties (including large indices stored as properties)
     for (const auto& key : arr->properties.orderedKeys()) {
@@ -74,9 +74,9 @@ Value Object_keys(const std::vector<Value>& args) {
       if (key.find("__") == 0) continue; // skip internal markers
       // Skip numeric indices already added from elements array
       uint32_t idx = 0;
-      if (isArrayIndex(key, idx) && idx < arr->elements.size()) continue;
+      if (isArrayIndex(key, idx) && idx < arr->elementCount()) continue;
       if (key == "length") continue; // length is not enumerable
-      result->elements.push_back(Value(key));
+      result->pushElement(Value(key));
     }
     return Value(result);
   }
@@ -86,7 +86,7 @@ Value Object_keys(const std::vector<Value>& args) {
 
   for (const auto& key : sortOwnPropertyKeys(props->orderedKeys())) {
     if (props->count("__non_enum_" + key)) continue;
-    result->elements.push_back(Value(key));
+    result->pushElement(Value(key));
   }
 
   return Value(result);
@@ -105,7 +105,7 @@ Value Object_values(const std::vector<Value>& args) {
 
   // Handle string primitives: Object.values("abc") → ["a","b","c"]
   if (arg.isString()) {
-    const std::string& str = std::get<std::string>(arg.data);
+    const std::string& str = arg.asString();
     size_t bytePos = 0;
     while (bytePos < str.size()) {
       unsigned char c = str[bytePos];
@@ -115,7 +115,7 @@ Value Object_values(const std::vector<Value>& args) {
         else if ((c & 0xF0) == 0xE0) len = 3;
         else len = 4;
       }
-      result->elements.push_back(Value(str.substr(bytePos, len)));
+      result->pushElement(Value(str.substr(bytePos, len)));
       bytePos += len;
     }
     return Value(result);
@@ -129,15 +129,15 @@ Value Object_values(const std::vector<Value>& args) {
   if (arg.isArray()) {
     auto arr = arg.getGC<Array>();
     Interpreter* interp = getGlobalInterpreter();
-    for (size_t i = 0; i < arr->elements.size(); ++i) {
+    for (size_t i = 0; i < arr->elementCount(); ++i) {
       std::string key = std::to_string(i);
       if (!arr->properties.count("__non_enum_" + key)) {
         if (interp) {
           auto [found, val] = interp->getPropertyForExternal(arg, key);
           if (interp->hasError()) { Value err = interp->getError(); interp->clearError(); throw JsValueException(err); }
-          if (found) result->elements.push_back(val);
+          if (found) result->pushElement(val);
         } else {
-          result->elements.push_back(arr->elements[i]);
+          result->pushElement(arr->element(i));
         }
       }
     }
@@ -153,10 +153,10 @@ Value Object_values(const std::vector<Value>& args) {
     if (interp) {
       auto [found, val] = interp->getPropertyForExternal(arg, key);
       if (interp->hasError()) { Value err = interp->getError(); interp->clearError(); throw JsValueException(err); }
-      if (found) result->elements.push_back(val);
+      if (found) result->pushElement(val);
     } else {
       auto it = props->find(key);
-      result->elements.push_back(it->second);
+      result->pushElement(it->second);
     }
   }
 
@@ -176,7 +176,7 @@ Value Object_entries(const std::vector<Value>& args) {
 
   // Handle string primitives: Object.entries("abc") → [["0","a"],["1","b"],["2","c"]]
   if (arg.isString()) {
-    const std::string& str = std::get<std::string>(arg.data);
+    const std::string& str = arg.asString();
     size_t cpIdx = 0;
     size_t bytePos = 0;
     while (bytePos < str.size()) {
@@ -188,9 +188,9 @@ Value Object_entries(const std::vector<Value>& args) {
         else len = 4;
       }
       auto entry = makeArrayWithPrototype();
-      entry->elements.push_back(Value(std::to_string(cpIdx)));
-      entry->elements.push_back(Value(str.substr(bytePos, len)));
-      result->elements.push_back(Value(entry));
+      entry->pushElement(Value(std::to_string(cpIdx)));
+      entry->pushElement(Value(str.substr(bytePos, len)));
+      result->pushElement(Value(entry));
       bytePos += len;
       cpIdx++;
     }
@@ -205,19 +205,19 @@ Value Object_entries(const std::vector<Value>& args) {
   if (arg.isArray()) {
     auto arr = arg.getGC<Array>();
     Interpreter* interp = getGlobalInterpreter();
-    for (size_t i = 0; i < arr->elements.size(); ++i) {
+    for (size_t i = 0; i < arr->elementCount(); ++i) {
       std::string key = std::to_string(i);
       if (!arr->properties.count("__non_enum_" + key)) {
         auto entry = makeArrayWithPrototype();
-        entry->elements.push_back(Value(key));
+        entry->pushElement(Value(key));
         if (interp) {
           auto [found, val] = interp->getPropertyForExternal(arg, key);
           if (interp->hasError()) { Value err = interp->getError(); interp->clearError(); throw JsValueException(err); }
-          entry->elements.push_back(found ? val : Value(Undefined{}));
+          entry->pushElement(found ? val : Value(Undefined{}));
         } else {
-          entry->elements.push_back(arr->elements[i]);
+          entry->pushElement(arr->element(i));
         }
-        result->elements.push_back(Value(entry));
+        result->pushElement(Value(entry));
       }
     }
     return Value(result);
@@ -230,7 +230,7 @@ Value Object_entries(const std::vector<Value>& args) {
   for (const auto& key : sortOwnPropertyKeys(props->orderedKeys())) {
     if (props->count("__non_enum_" + key)) continue;
     auto entry = makeArrayWithPrototype();
-    entry->elements.push_back(Value(key));
+    entry->pushElement(Value(key));
     if (interp) {
       auto [found, val] = interp->getPropertyForExternal(arg, key);
       if (interp->hasError()) {
@@ -238,12 +238,12 @@ Value Object_entries(const std::vector<Value>& args) {
         interp->clearError();
         throw JsValueException(err);
       }
-      entry->elements.push_back(found ? val : Value(Undefined{}));
+      entry->pushElement(found ? val : Value(Undefined{}));
     } else {
       auto it = props->find(key);
-      entry->elements.push_back(it->second);
+      entry->pushElement(it->second);
     }
-    result->elements.push_back(Value(entry));
+    result->pushElement(Value(entry));
   }
 
   return Value(result);
@@ -256,7 +256,7 @@ static std::vector<std::pair<std::string, Value>> getEnumerableOwnProperties(con
 
   // String sources: each character is an enumerable indexed property
   if (source.isString()) {
-    const std::string& str = std::get<std::string>(source.data);
+    const std::string& str = source.asString();
     // Iterate by UTF-16 code units for ES compat
     size_t i = 0;
     size_t idx = 0;
@@ -284,13 +284,13 @@ static std::vector<std::pair<std::string, Value>> getEnumerableOwnProperties(con
   if (source.isArray()) {
     auto arr = source.getGC<Array>();
     // Add array elements (indexed, enumerable by default)
-    for (size_t i = 0; i < arr->elements.size(); i++) {
+    for (size_t i = 0; i < arr->elementCount(); i++) {
       std::string key = std::to_string(i);
       // Skip deleted elements and holes
       if (arr->properties.find("__deleted_" + key + "__") != arr->properties.end()) continue;
       if (arr->properties.find("__hole_" + key + "__") != arr->properties.end()) continue;
       if (arr->properties.find("__non_enum_" + key) != arr->properties.end()) continue;
-      result.push_back({key, arr->elements[i]});
+      result.push_back({key, arr->element(i)});
     }
     // Add non-indexed own properties
     for (const auto& key : arr->properties.orderedKeys()) {
@@ -299,9 +299,9 @@ static std::vector<std::pair<std::string, Value>> getEnumerableOwnProperties(con
       if (arr->properties.count("__non_enum_" + key)) continue;
       // Skip numeric indices already handled
       uint32_t idx2;
-      if (isArrayIndex(key, idx2) && idx2 < arr->elements.size()) continue;
+      if (isArrayIndex(key, idx2) && idx2 < arr->elementCount()) continue;
       if (key == "length") {
-        result.push_back({key, Value(static_cast<double>(arr->elements.size()))});
+        result.push_back({key, Value(static_cast<double>(arr->elementCount()))});
         continue;
       }
       auto it = arr->properties.find(key);
@@ -313,7 +313,7 @@ static std::vector<std::pair<std::string, Value>> getEnumerableOwnProperties(con
   }
 
   // Generic object-like types: Object, Function, Class, etc.
-  OrderedMap<std::string, Value>* props = nullptr;
+  PropertyMap* props = nullptr;
   if (source.isObject()) props = &source.getGC<Object>()->properties;
   else if (source.isFunction()) props = &source.getGC<Function>()->properties;
   else if (source.isClass()) props = &source.getGC<Class>()->properties;
@@ -395,27 +395,27 @@ static void assignToTarget(Value& target, const std::string& key, const Value& v
     if (key == "length" && value.isNumber()) {
       double newLen = value.toNumber();
       uint32_t len = static_cast<uint32_t>(newLen);
-      if (len < arr->elements.size()) {
-        arr->elements.resize(len);
-      } else if (len > arr->elements.size()) {
-        arr->elements.resize(len, Value(Undefined{}));
+      if (len < arr->elementCount()) {
+        arr->elements().resize(len);
+      } else if (len > arr->elementCount()) {
+        arr->elements().resize(len, Value(Undefined{}));
       }
       return;
     }
     // Handle numeric index
     uint32_t idx;
     if (isArrayIndex(key, idx)) {
-      if (idx >= arr->elements.size()) {
-        arr->elements.resize(idx + 1, Value(Undefined{}));
+      if (idx >= arr->elementCount()) {
+        arr->elements().resize(idx + 1, Value(Undefined{}));
       }
-      arr->elements[idx] = value;
+      arr->setElement(idx, value);
       return;
     }
     arr->properties[key] = value;
     return;
   }
 
-  OrderedMap<std::string, Value>* props = nullptr;
+  PropertyMap* props = nullptr;
   if (target.isObject()) props = &target.getGC<Object>()->properties;
   else if (target.isFunction()) props = &target.getGC<Function>()->properties;
   else if (target.isClass()) props = &target.getGC<Class>()->properties;
@@ -478,7 +478,7 @@ Value Object_assign(const std::vector<Value>& args) {
 
     // For string targets, add indexed characters as non-writable, non-configurable, enumerable
     if (target.isString()) {
-      const std::string& str = std::get<std::string>(target.data);
+      const std::string& str = target.asString();
       size_t i = 0, idx = 0;
       while (i < str.size()) {
         unsigned char c = str[i];
@@ -516,7 +516,7 @@ Value Object_assign(const std::vector<Value>& args) {
         else if (target.isBigInt()) ctorName = "BigInt";
         if (!ctorName.empty()) {
           if (auto ctor = env->get(ctorName)) {
-            OrderedMap<std::string, Value>* ctorProps = nullptr;
+            PropertyMap* ctorProps = nullptr;
             if (ctor->isFunction()) {
               ctorProps = &ctor->getGC<Function>()->properties;
             } else if (ctor->isObject()) {
@@ -554,26 +554,26 @@ Value Object_assign(const std::vector<Value>& args) {
   return targetVal;
 }
 
-Value Object_hasOwnProperty(const std::vector<Value>& args) {
-  if (args.size() < 2) {
+Value Object_hasOwnProperty(const Value& thisValue, std::span<const Value> args, Interpreter&, NativeThrow& thrown) {
+  if (args.empty()) {
     // Still need to check this value
-    if (!args.empty() && (args[0].isUndefined() || args[0].isNull())) {
-      throw std::runtime_error("TypeError: Cannot convert undefined or null to object");
+    if (thisValue.isUndefined() || thisValue.isNull()) {
+      return thrown.error(ErrorType::TypeError, "Cannot convert undefined or null to object");
     }
     return Value(false);
   }
 
   // Step 1: ToPropertyKey(V) - must happen before ToObject(this)
-  std::string key = valueToPropertyKey(args[1]);
+  std::string key = valueToPropertyKey(args[0]);
 
   // Step 2: ToObject(this) - throw TypeError for undefined/null
-  if (args[0].isUndefined() || args[0].isNull()) {
-    throw std::runtime_error("TypeError: Cannot convert undefined or null to object");
+  if (thisValue.isUndefined() || thisValue.isNull()) {
+    return thrown.error(ErrorType::TypeError, "Cannot convert undefined or null to object");
   }
 
   // Handle Function objects
-  if (args[0].isFunction()) {
-    auto fn = args[0].getGC<Function>();
+  if (thisValue.isFunction()) {
+    auto fn = thisValue.getGC<Function>();
     // Internal properties are not own properties
     if (isInternalProperty(key)) return Value(false);
     if (fn->properties.find(key) != fn->properties.end()) return Value(true);
@@ -583,8 +583,8 @@ Value Object_hasOwnProperty(const std::vector<Value>& args) {
   }
 
   // Handle Class objects
-  if (args[0].isClass()) {
-    auto cls = args[0].getGC<Class>();
+  if (thisValue.isClass()) {
+    auto cls = thisValue.getGC<Class>();
     if (isInternalProperty(key)) return Value(false);
     if (cls->properties.find(key) != cls->properties.end()) return Value(true);
     if (cls->properties.find("__get_" + key) != cls->properties.end()) return Value(true);
@@ -593,8 +593,8 @@ Value Object_hasOwnProperty(const std::vector<Value>& args) {
   }
 
   // Handle Array objects
-  if (args[0].isArray()) {
-    auto arr = args[0].getGC<Array>();
+  if (thisValue.isArray()) {
+    auto arr = thisValue.getGC<Array>();
     if (isInternalProperty(key)) return Value(false);
     // Arrays always have an own `length` data property (unless deleted from arguments).
     if (key == "length") {
@@ -605,7 +605,7 @@ Value Object_hasOwnProperty(const std::vector<Value>& args) {
     }
     try {
       size_t idx = std::stoull(key);
-      if (idx < arr->elements.size()) {
+      if (idx < arr->elementCount()) {
         // Check if this index was deleted or is a hole
         if (arr->properties.find("__deleted_" + key + "__") != arr->properties.end()) {
           return Value(false);
@@ -622,8 +622,8 @@ Value Object_hasOwnProperty(const std::vector<Value>& args) {
     return Value(false);
   }
 
-  if (args[0].isRegex()) {
-    auto rx = args[0].getGC<Regex>();
+  if (thisValue.isRegex()) {
+    auto rx = thisValue.getGC<Regex>();
     if (isInternalProperty(key)) return Value(false);
     if (rx->properties.find(key) != rx->properties.end()) return Value(true);
     if (rx->properties.find("__get_" + key) != rx->properties.end()) return Value(true);
@@ -631,8 +631,8 @@ Value Object_hasOwnProperty(const std::vector<Value>& args) {
     return Value(false);
   }
 
-  if (args[0].isPromise()) {
-    auto p = args[0].getGC<Promise>();
+  if (thisValue.isPromise()) {
+    auto p = thisValue.getGC<Promise>();
     if (isInternalProperty(key)) return Value(false);
     if (p->properties.find(key) != p->properties.end()) return Value(true);
     if (p->properties.find("__get_" + key) != p->properties.end()) return Value(true);
@@ -640,8 +640,8 @@ Value Object_hasOwnProperty(const std::vector<Value>& args) {
     return Value(false);
   }
 
-  if (args[0].isError()) {
-    auto e = args[0].getGC<Error>();
+  if (thisValue.isError()) {
+    auto e = thisValue.getGC<Error>();
     if (isInternalProperty(key)) return Value(false);
     if (e->properties.find(key) != e->properties.end()) return Value(true);
     if (e->properties.find("__get_" + key) != e->properties.end()) return Value(true);
@@ -649,8 +649,8 @@ Value Object_hasOwnProperty(const std::vector<Value>& args) {
     return Value(false);
   }
 
-  if (args[0].isMap()) {
-    auto m = args[0].getGC<Map>();
+  if (thisValue.isMap()) {
+    auto m = thisValue.getGC<Map>();
     if (isInternalProperty(key)) return Value(false);
     if (m->properties.find(key) != m->properties.end()) return Value(true);
     if (m->properties.find("__get_" + key) != m->properties.end()) return Value(true);
@@ -658,8 +658,8 @@ Value Object_hasOwnProperty(const std::vector<Value>& args) {
     return Value(false);
   }
 
-  if (args[0].isSet()) {
-    auto s = args[0].getGC<Set>();
+  if (thisValue.isSet()) {
+    auto s = thisValue.getGC<Set>();
     if (isInternalProperty(key)) return Value(false);
     if (s->properties.find(key) != s->properties.end()) return Value(true);
     if (s->properties.find("__get_" + key) != s->properties.end()) return Value(true);
@@ -667,8 +667,8 @@ Value Object_hasOwnProperty(const std::vector<Value>& args) {
     return Value(false);
   }
 
-  if (args[0].isWeakMap()) {
-    auto wm = args[0].getGC<WeakMap>();
+  if (thisValue.isWeakMap()) {
+    auto wm = thisValue.getGC<WeakMap>();
     if (isInternalProperty(key)) return Value(false);
     if (wm->properties.find(key) != wm->properties.end()) return Value(true);
     if (wm->properties.find("__get_" + key) != wm->properties.end()) return Value(true);
@@ -676,8 +676,8 @@ Value Object_hasOwnProperty(const std::vector<Value>& args) {
     return Value(false);
   }
 
-  if (args[0].isWeakSet()) {
-    auto ws = args[0].getGC<WeakSet>();
+  if (thisValue.isWeakSet()) {
+    auto ws = thisValue.getGC<WeakSet>();
     if (isInternalProperty(key)) return Value(false);
     if (ws->properties.find(key) != ws->properties.end()) return Value(true);
     if (ws->properties.find("__get_" + key) != ws->properties.end()) return Value(true);
@@ -685,8 +685,8 @@ Value Object_hasOwnProperty(const std::vector<Value>& args) {
     return Value(false);
   }
 
-  if (args[0].isTypedArray()) {
-    auto ta = args[0].getGC<TypedArray>();
+  if (thisValue.isTypedArray()) {
+    auto ta = thisValue.getGC<TypedArray>();
     if (isInternalProperty(key)) return Value(false);
     if (key == "length" || key == "byteLength" || key == "buffer" || key == "byteOffset") return Value(true);
     if (!key.empty() && std::all_of(key.begin(), key.end(), ::isdigit)) {
@@ -702,8 +702,8 @@ Value Object_hasOwnProperty(const std::vector<Value>& args) {
     return Value(false);
   }
 
-  if (args[0].isArrayBuffer()) {
-    auto b = args[0].getGC<ArrayBuffer>();
+  if (thisValue.isArrayBuffer()) {
+    auto b = thisValue.getGC<ArrayBuffer>();
     if (isInternalProperty(key)) return Value(false);
     if (key == "byteLength") return Value(true);
     if (b->properties.find(key) != b->properties.end()) return Value(true);
@@ -712,8 +712,8 @@ Value Object_hasOwnProperty(const std::vector<Value>& args) {
     return Value(false);
   }
 
-  if (args[0].isDataView()) {
-    auto v = args[0].getGC<DataView>();
+  if (thisValue.isDataView()) {
+    auto v = thisValue.getGC<DataView>();
     if (isInternalProperty(key)) return Value(false);
     if (v->properties.find(key) != v->properties.end()) return Value(true);
     if (v->properties.find("__get_" + key) != v->properties.end()) return Value(true);
@@ -721,8 +721,8 @@ Value Object_hasOwnProperty(const std::vector<Value>& args) {
     return Value(false);
   }
 
-  if (args[0].isGenerator()) {
-    auto g = args[0].getGC<Generator>();
+  if (thisValue.isGenerator()) {
+    auto g = thisValue.getGC<Generator>();
     if (isInternalProperty(key)) return Value(false);
     if (g->properties.find(key) != g->properties.end()) return Value(true);
     if (g->properties.find("__get_" + key) != g->properties.end()) return Value(true);
@@ -730,11 +730,11 @@ Value Object_hasOwnProperty(const std::vector<Value>& args) {
     return Value(false);
   }
 
-  if (!args[0].isObject()) {
+  if (!thisValue.isObject()) {
     return Value(false);
   }
 
-  auto obj = args[0].getGC<Object>();
+  auto obj = thisValue.getGC<Object>();
 
   if (obj->isModuleNamespace) {
     if (key == WellKnownSymbols::toStringTagKey()) {
@@ -14,11 +14,11 @@ Value Object_getOwnPropertyNames(const std::vector<Value>& args) {
     return Value(result); // No own string-keyed properties
   }
   if (args[0].isString()) {
-    const auto& str = std::get<std::string>(args[0].data);
+    const auto& str = args[0].asString();
     // String objects have indices 0..n-1 and "length"
     size_t cpIdx = 0, bytePos = 0;
     while (bytePos < str.size()) {
-      result->elements.push_back(Value(std::to_string(cpIdx)));
+      result->pushElement(Value(std::to_string(cpIdx)));
       unsigned char c = str[bytePos];
       if (c < 0x80) bytePos += 1;
       else if ((c & 0xE0) == 0xC0) bytePos += 2;
@@ -26,7 +26,7 @@ Value Object_getOwnPropertyNames(const std::vector<Value>& args) {
       else bytePos += 4;
       cpIdx++;
     }
-    result->elements.push_back(Value(std::string("length")));
+    result->pushElement(Value(std::string("length")));
     return Value(result);
   }
 
@@ -63,13 +63,13 @@ Value Object_getOwnPropertyNames(const std::vector<Value>& args) {
     std::sort(indexKeys.begin(), indexKeys.end(),
               [](const auto& a, const auto& b) { return a.first < b.first; });
     for (const auto& [_, k] : indexKeys) {
-      result->elements.push_back(Value(k));
+      result->pushElement(Value(k));
     }
     if (prioritizeLengthName) {
       auto emitFirst = [&](const char* key) {
         for (size_t i = 0; i < stringKeys.size(); i++) {
           if (stringKeys[i] == key) {
-            result->elements.push_back(Value(stringKeys[i]));
+            result->pushElement(Value(stringKeys[i]));
             stringKeys.erase(stringKeys.begin() + static_cast<long>(i));
             return;
           }
@@ -79,7 +79,7 @@ Value Object_getOwnPropertyNames(const std::vector<Value>& args) {
       emitFirst("name");
     }
     for (const auto& k : stringKeys) {
-      result->elements.push_back(Value(k));
+      result->pushElement(Value(k));
     }
   };
 
@@ -129,7 +129,7 @@ Value Object_getOwnPropertyNames(const std::vector<Value>& args) {
     auto arr = args[0].getGC<Array>();
     // Add numeric index keys for non-hole, non-deleted elements
     std::vector<std::string> keys;
-    for (size_t i = 0; i < arr->elements.size(); i++) {
+    for (size_t i = 0; i < arr->elementCount(); i++) {
       std::string key = std::to_string(i);
       if (arr->properties.find("__deleted_" + key + "__") != arr->properties.end()) continue;
       if (arr->properties.find("__hole_" + key + "__") != arr->properties.end()) continue;
@@ -150,7 +150,7 @@ Value Object_getOwnPropertyNames(const std::vector<Value>& args) {
       keys.push_back(rawKey);
     }
     for (const auto& k : keys) {
-      result->elements.push_back(Value(k));
+      result->pushElement(Value(k));
     }
     return Value(result);
   }
@@ -204,7 +204,7 @@ Value Object_getOwnPropertyNames(const std::vector<Value>& args) {
   if (obj->isModuleNamespace) {
     triggerDeferredNamespaceOwnKeys(obj);
     for (const auto& key : moduleNamespaceExportNames(obj)) {
-      result->elements.push_back(Value(key));
+      result->pushElement(Value(key));
     }
     return Value(result);
   }
@@ -430,7 +430,7 @@ Value Object_fromEntries(const std::vector<Value>& args) {
 
     // String entries: "ab" → key=0, value=1 (char at index 0 and 1)
     if (entry.isString()) {
-      const std::string& str = std::get<std::string>(entry.data);
+      const std::string& str = entry.asString();
       // Strings are array-like; access [0] and [1] via getPropertyForExternal
       auto [k0, key] = interp->getPropertyForExternal(entry, "0");
       auto [k1, val] = interp->getPropertyForExternal(entry, "1");
@@ -455,20 +455,20 @@ void TypedArray::getElements(double* values, size_t offset, size_t count) const
 
 // Helper function for value equality in Map/Set
 static bool valuesEqual(const Value& a, const Value& b) {
-  if (a.data.index() != b.data.index()) return false;
+  if (!a.hasSameType(b)) return false;
 
   if (a.isNumber() && b.isNumber()) {
-    double an = std::get<double>(a.data);
-    double bn = std::get<double>(b.data);
+    double an = a.asNumber();
+    double bn = b.asNumber();
     // Handle NaN
     if (std::isnan(an) && std::isnan(bn)) return true;
     return an == bn;
   }
 
-  if (a.isString()) return std::get<std::string>(a.data) == std::get<std::string>(b.data);
+  if (a.isString()) return a.asString() == b.asString();
   if (a.isBool()) return std::get<bool>(a.data) == std::get<bool>(b.data);
-  if (a.isBigInt()) return std::get<BigInt>(a.data).value == std::get<BigInt>(b.data).value;
-  if (a.isSymbol()) return std::get<Symbol>(a.data).id == std::get<Symbol>(b.data).id;
+  if (a.isBigInt()) return a.asBigInt().value == b.asBigInt().value;
+  if (a.isSymbol()) return a.asSymbol().id == b.asSymbol().id;
   if (a.isNull() || a.isUndefined()) return true;
 
   // For objects, compare by reference
@@ -491,71 +491,143 @@ static bool valuesEqual(const Value& a, const Value& b) {
   return false;
 }
 
-// Map implementation
-void Map::set(const Value& key, const Value& value) {
-  for (auto& entry : entries) {
-    if (valuesEqual(entry.first, key)) {
-      entry.second = value;
-      return;
+// SameValueZero hash: equal numbers hash alike whatever their
+// representation (int32, -0, any NaN); objects hash by identity.
+static size_t sameValueZeroHash(const Value& value) {
+  return std::visit([](const auto& arg) -> size_t {
+    using T = std::decay_t<decltype(arg)>;
+    if constexpr (std::is_same_v<T, double> || std::is_same_v<T, int32_t>) {
+      double number = static_cast<double>(arg);
+      if (number == 0.0) number = 0.0;
+      if (std::isnan(number)) return 0x7ff8000000000000ull;
+      return std::hash<double>{}(number);
+    } else if constexpr (std::is_same_v<T, bool>) {
+      return arg ? 1 : 2;
+    } else if constexpr (std::is_same_v<T, ValueBox<std::string>>) {
+      return std::hash<std::string>{}(arg.get());
+    } else if constexpr (std::is_same_v<T, ValueBox<Symbol>>) {
+      return std::hash<size_t>{}(arg.get().id);
+    } else if constexpr (std::is_same_v<T, ValueBox<BigInt>>) {
+      return std::hash<std::string>{}(bigint::toString(arg.get().value));
+    } else if constexpr (std::is_same_v<T, ValueBox<ModuleBinding>>) {
+      return 3;
+    } else if constexpr (std::is_empty_v<T>) {
+      return 4;
+    } else {
+      return std::hash<const void*>{}(arg.get());
     }
-  }
-  entries.push_back({key, value});
-}
-
-bool Map::has(const Value& key) const {
-  for (const auto& entry : entries) {
-    if (valuesEqual(entry.first, key)) {
-      return true;
-    }
-  }
-  return false;
-}
-
-Value Map::get(const Value& key) const {
-  for (const auto& entry : entries) {
-    if (valuesEqual(entry.first, key)) {
-      return entry.second;
-    }
-  }
-  return Value(Undefined{});
+  }, value.data);
 }
 
-bool Map::deleteKey(const Value& key) {
-  for (auto it = entries.begin(); it != entries.end(); ++it) {
-    if (valuesEqual(it->first, key)) {
-      entries.erase(it);
-      return true;
+OrderedHashTable::Entry* OrderedHashTable::lookup(const Value& key, size_t hash) {
+  if (buckets_.empty()) return nullptr;
+  for (uint32_t index = buckets_[hash & (buckets_.size() - 1)]; index != kNoEntry;
+       index = entries_[index].chain) {
+    Entry& entry = entries_[index];
+    if (!entry.deleted && valuesEqual(entry.key, key)) {
+      return &entry;
     }
   }
-  return false;
+  return nullptr;
 }
 
-// Set implementation
-bool Set::add(const Value& value) {
-  if (!has(value)) {
-    values.push_back(value);
-    return true;
-  }
-  return false;
+const OrderedHashTable::Entry* OrderedHashTable::find(const Value& key) const {
+  return const_cast<OrderedHashTable*>(this)->lookup(key, sameValueZeroHash(key));
 }
 
-bool Set::has(const Value& value) const {
-  for (const auto& v : values) {
-    if (valuesEqual(v, value)) {
-      return true;
-    }
+bool OrderedHashTable::set(const Value& key, const Value& value) {
+  size_t hash = sameValueZeroHash(key);
+  if (Entry* entry = lookup(key, hash)) {
+    entry->value = value;
+    return false;
   }
-  return false;
+  // Two entries per bucket. Grow only when the table is mostly live;
+  // otherwise compacting the tombstones makes enough room.
+  if (entries_.size() >= buckets_.size() * 2) {
+    size_t bucketCount = buckets_.empty() ? 4 : buckets_.size();
+    if (liveCount_ >= entries_.size() / 2) bucketCount *= 2;
+    rehash(bucketCount);
+  }
+  // -0 is normalized so that the stored key reads back as +0.
+  Value storedKey = key;
+  if (key.isNumber() && key.asNumber() == 0.0) storedKey = numberValue(0.0);
+  size_t bucket = hash & (buckets_.size() - 1);
+  entries_.push_back(Entry{storedKey, value, nextOrdinal_++, buckets_[bucket], false});
+  buckets_[bucket] = static_cast<uint32_t>(entries_.size() - 1);
+  ++liveCount_;
+  return true;
+}
+
+bool OrderedHashTable::remove(const Value& key) {
+  Entry* entry = lookup(key, sameValueZeroHash(key));
+  if (!entry) return false;
+  // The tombstone keeps its place in the bucket chain until the next
+  // rehash; drop the references it held now.
+  entry->deleted = true;
+  entry->key = Value(Undefined{});
+  entry->value = Value(Undefined{});
+  --liveCount_;
+  if (entries_.size() > 16 && liveCount_ < entries_.size() / 4) {
+    rehash(buckets_.size() / 2);
+  }
+  return true;
+}
+
+void OrderedHashTable::clear() {
+  // Ordinals keep counting so that live cursors only see later insertions.
+  entries_.clear();
+  buckets_.clear();
+  liveCount_ = 0;
+}
+
+void OrderedHashTable::rehash(size_t bucketCount) {
+  std::vector<Entry> live;
+  live.reserve(std::max(liveCount_, bucketCount));
+  for (auto& entry : entries_) {
+    if (!entry.deleted) live.push_back(std::move(entry));
+  }
+  entries_ = std::move(live);
+  buckets_.assign(bucketCount, kNoEntry);
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    size_t bucket = sameValueZeroHash(entries_[i].key) & (bucketCount - 1);
+    entries_[i].chain = buckets_[bucket];
+    buckets_[bucket] = static_cast<uint32_t>(i);
+  }
+}
+
+const OrderedHashTable::Entry* OrderedHashTable::next(size_t& cursor) const {
+  if (entries_.empty()) return nullptr;
+  // Without a compaction since the cursor was taken, its entry sits at a
+  // fixed offset from the first one; otherwise search the ordinals.
+  size_t first = entries_.front().ordinal;
+  size_t pos = cursor > first ? cursor - first : 0;
+  if (pos >= entries_.size() || entries_[pos].ordinal != std::max(cursor, first)) {
+    pos = static_cast<size_t>(
+      std::lower_bound(entries_.begin(), entries_.end(), cursor,
+                       [](const Entry& entry, size_t ordinal) { return entry.ordinal < ordinal; }) -
+      entries_.begin());
+  }
+  while (pos < entries_.size() && entries_[pos].deleted) ++pos;
+  if (pos == entries_.size()) return nullptr;
+  cursor = entries_[pos].ordinal + 1;
+  return &entries_[pos];
+}
+
+std::vector<Value> OrderedHashTable::keys() const {
+  std::vector<Value> result;
+  result.reserve(liveCount_);
+  for (const auto& entry : entries_) {
+    if (!entry.deleted) result.push_back(entry.key);
+  }
+  return result;
 }
 
-bool Set::deleteValue(const Value& value) {
-  for (auto it = values.begin(); it != values.end(); ++it) {
-    if (valuesEqual(*it, value)) {
-      values.erase(it);
-      return true;
-    }
+// Map implementation
+Value Map::get(const Value& key) const {
+  if (const auto* entry = table.find(key)) {
+    return entry->value;
   }
-  return false;
+  return Value(Undefined{});
 }
 
 // Promise implementation
@@ -767,7 +839,7 @@ GCPtr<Promise> Promise::all(const std::vector<GCPtr<Promise>>& promises) {
         (*resolvedCount)++;
         if (*resolvedCount == promiseCount) {
           auto arrayResult = GarbageCollector::makeGC<Array>();
-          arrayResult->elements = *results;
+          arrayResult->assignElements(*results);
           resultPromise->resolve(Value(arrayResult));
         }
         return v;
@@ -11,15 +11,15 @@ namespace lightjs {
 
 // Convert JavaScript Value to WASM Value
 std::optional<wasm::WasmValue> wasm_js::valueToWasm(const Value& val) {
-    if (std::holds_alternative<double>(val.data)) {
-        double d = std::get<double>(val.data);
+    if (val.isNumber()) {
+        double d = val.asNumber();
         // Check if it's an integer
         if (d == static_cast<int32_t>(d)) {
             return wasm::WasmValue(static_cast<int32_t>(d));
         }
         return wasm::WasmValue(d);
-    } else if (std::holds_alternative<BigInt>(val.data)) {
-        return wasm::WasmValue(bigint::toInt64Trunc(std::get<BigInt>(val.data).value));
+    } else if (val.isBigInt()) {
+        return wasm::WasmValue(bigint::toInt64Trunc(val.asBigInt().value));
     } else if (std::holds_alternative<bool>(val.data)) {
         return wasm::WasmValue(static_cast<int32_t>(std::get<bool>(val.data)));
     }
@@ -29,7 +29,7 @@ std::optional<wasm::WasmValue> wasm_js::valueToWasm(const Value& val) {
 // Convert WASM Value to JavaScript Value
 Value wasm_js::wasmToValue(const wasm::WasmValue& val) {
     if (std::holds_alternative<int32_t>(val.data)) {
-        return Value(static_cast<double>(std::get<int32_t>(val.data)));
+        return Value(std::get<int32_t>(val.data));
     } else if (std::holds_alternative<int64_t>(val.data)) {
         return Value(BigInt(std::get<int64_t>(val.data)));
     } else if (std::holds_alternative<float>(val.data)) {
@@ -64,9 +64,9 @@ Value wasm_js::createWebAssemblyGlobal() {
         } else if (std::holds_alternative<GCPtr<ArrayBuffer>>(bufferArg.data)) {
             auto arrayBuffer = bufferArg.getGC<ArrayBuffer>();
             wasmBytes = arrayBuffer->data;
-        } else if (std::holds_alternative<std::string>(bufferArg.data)) {
+        } else if (bufferArg.isString()) {
             // Allow reading from file path (extension for convenience)
-            const auto& path = std::get<std::string>(bufferArg.data);
+            const auto& path = bufferArg.asString();
             std::ifstream file(path, std::ios::binary);
             if (!file.is_open()) {
                 return Value(Undefined{});
@@ -13,7 +13,7 @@ namespace lightjs {
 
 namespace {
 bool isSameValue(const Value& actual, const Value& expected) {
-  if (actual.data.index() != expected.data.index()) {
+  if (!actual.hasSameType(expected)) {
     return false;
   }
 
@@ -24,8 +24,8 @@ bool isSameValue(const Value& actual, const Value& expected) {
     return std::get<bool>(actual.data) == std::get<bool>(expected.data);
   }
   if (actual.isNumber()) {
-    double a = std::get<double>(actual.data);
-    double b = std::get<double>(expected.data);
+    double a = actual.asNumber();
+    double b = expected.asNumber();
     if (std::isnan(a) && std::isnan(b)) {
       return true;
     }
@@ -35,13 +35,13 @@ bool isSameValue(const Value& actual, const Value& expected) {
     return a == b;
   }
   if (actual.isBigInt()) {
-    return std::get<BigInt>(actual.data).value == std::get<BigInt>(expected.data).value;
+    return actual.asBigInt().value == expected.asBigInt().value;
   }
   if (actual.isSymbol()) {
-    return std::get<Symbol>(actual.data).id == std::get<Symbol>(expected.data).id;
+    return actual.asSymbol().id == expected.asSymbol().id;
   }
   if (actual.isString()) {
-    return std::get<std::string>(actual.data) == std::get<std::string>(expected.data);
+    return actual.asString() == expected.asString();
   }
   if (actual.isFunction()) {
     return std::get<GCPtr<Function>>(actual.data) ==
@@ -455,8 +455,8 @@ void installTest262Harness(GCPtr<Environment> env) {
 
   auto extractArrayLike = [](const Value& value, std::vector<std::string>& out) -> bool {
     if (auto* arr = std::get_if<GCPtr<Array>>(&value.data)) {
-      out.reserve((*arr)->elements.size());
-      for (const auto& element : (*arr)->elements) {
+      out.reserve((*arr)->elementCount());
+      for (const auto& element : (*arr)->elements()) {
         out.push_back(element.toString());
       }
       return true;
@@ -589,8 +589,8 @@ void installTest262Harness(GCPtr<Environment> env) {
   buildString->nativeFunc = [](const std::vector<Value>& args) -> Value {
     std::string result;
     for (const auto& arg : args) {
-      if (std::holds_alternative<double>(arg.data)) {
-        int count = static_cast<int>(std::get<double>(arg.data));
+      if (arg.isNumber()) {
+        int count = static_cast<int>(arg.asNumber());
         result += std::string(count, 'x');
       } else {
         result += arg.toString();
@@ -41,9 +41,9 @@ int main() {
 
         if (result.isArray()) {
             auto arr = std::get<GCPtr<Array>>(result.data);
-            std::cout << "Array size: " << arr->elements.size() << std::endl;
-            for (size_t i = 0; i < arr->elements.size(); ++i) {
-                std::cout << "Element " << i << ": " << arr->elements[i].toString() << std::endl;
+            std::cout << "Array size: " << arr->elementCount() << std::endl;
+            for (size_t i = 0; i < arr->elementCount(); ++i) {
+                std::cout << "Element " << i << ": " << arr->element(i).toString() << std::endl;
             }
         }
 
@@ -12,7 +12,7 @@ int main() {
     std::cout << "Debug Test 2 - Direct function call" << std::endl;
 
     // Test Object_keys directly
-    auto obj = std::make_shared<Object>();
+    auto obj = GarbageCollector::makeGC<Object>();
     obj->properties["a"] = Value(1.0);
     obj->properties["b"] = Value(2.0);
     obj->properties["c"] = Value(3.0);
@@ -28,14 +28,14 @@ int main() {
 
         if (result.isArray()) {
             auto arr = std::get<GCPtr<Array>>(result.data);
-            std::cout << "Array size: " << arr->elements.size() << std::endl;
+            std::cout << "Array size: " << arr->elementCount() << std::endl;
 
-            for (size_t i = 0; i < arr->elements.size(); ++i) {
-                const Value& elem = arr->elements[i];
+            for (size_t i = 0; i < arr->elementCount(); ++i) {
+                const Value& elem = arr->element(i);
                 std::cout << "Element " << i << " type: " << (int)elem.data.index() << std::endl;
                 std::cout << "Element " << i << " isString: " << elem.isString() << std::endl;
                 if (elem.isString()) {
-                    std::cout << "Element " << i << " value: " << std::get<std::string>(elem.data) << std::endl;
+                    std::cout << "Element " << i << " value: " << elem.asString() << std::endl;
                 }
                 std::cout << "Element " << i << " toString: " << elem.toString() << std::endl;
             }
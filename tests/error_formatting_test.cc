@@ -50,12 +50,12 @@ void testStackTrace() {
 
       std::cout << "Error Type: " << error->getName() << "\n";
       std::cout << "Error Message: " << error->message << "\n\n";
-      std::cout << "Stack Trace:\n" << error->stack << "\n";
+      std::cout << "Stack Trace:\n" << error->stack() << "\n";
 
       // Verify stack trace contains expected information
-      bool hasReferenceError = error->stack.find("ReferenceError") != std::string::npos;
-      bool hasUndefinedVariable = error->stack.find("undefinedVariable") != std::string::npos ||
-                                   error->stack.find("is not defined") != std::string::npos;
+      bool hasReferenceError = error->stack().find("ReferenceError") != std::string::npos;
+      bool hasUndefinedVariable = error->stack().find("undefinedVariable") != std::string::npos ||
+                                   error->stack().find("is not defined") != std::string::npos;
 
       std::cout << "\nVerification:\n";
       std::cout << "  Has ReferenceError: " << (hasReferenceError ? "YES" : "NO") << "\n";
@@ -113,11 +113,11 @@ void testStackOverflowError() {
 
       std::cout << "Error Type: " << error->getName() << "\n";
       std::cout << "Error Message: " << error->message << "\n\n";
-      std::cout << "Stack Trace:\n" << error->stack << "\n";
+      std::cout << "Stack Trace:\n" << error->stack() << "\n";
 
       // Verify error type and message
       bool isRangeError = error->type == ErrorType::RangeError;
-      bool hasStackMessage = error->stack.find("Maximum call stack size exceeded") != std::string::npos;
+      bool hasStackMessage = error->stack().find("Maximum call stack size exceeded") != std::string::npos;
 
       std::cout << "\nVerification:\n";
       std::cout << "  Is RangeError: " << (isRangeError ? "YES" : "NO") << "\n";
@@ -173,8 +173,8 @@ void testTypeError() {
       std::cout << "Error Type: " << error->getName() << "\n";
       std::cout << "Error Message: " << error->message << "\n";
 
-      if (!error->stack.empty()) {
-        std::cout << "\nStack Trace:\n" << error->stack << "\n";
+      if (!error->stack().empty()) {
+        std::cout << "\nStack Trace:\n" << error->stack() << "\n";
       }
 
       // Verify error type
@@ -116,6 +116,142 @@ int main() {
     std::cout << "  Objects allocated: " << stats.currentlyAllocated << "\n";
     std::cout << "  Total freed: " << stats.totalFreed << "\n";
 
+    // Unreachable cycles are reclaimed; objects still referenced are not
+    std::cout << "\nCollecting an unreachable cycle...\n";
+    size_t objectsBefore = gc.getStats().objectCount;
+    {
+        auto a = GarbageCollector::makeGC<Object>();
+        auto b = GarbageCollector::makeGC<Object>();
+        a->properties["ref"] = Value(b);
+        b->properties["ref"] = Value(a);
+    }
+    auto kept = GarbageCollector::makeGC<Object>();
+    kept->properties["self"] = Value(kept);
+    gc.collectYoung();
+    stats = gc.getStats();
+    std::cout << "  Objects reclaimed: " << stats.objectsReclaimed << "\n";
+    std::cout << "  Objects promoted: " << stats.objectsPromoted << "\n";
+    if (stats.objectCount != objectsBefore + 1 || !kept->properties["self"].isObject()) {
+        std::cerr << "Cycle collection failed: " << stats.objectCount << " objects, expected "
+                  << objectsBefore + 1 << "\n";
+        return 1;
+    }
+
+    // Incremental collection: references created while marking runs keep
+    // their targets alive, unreachable cycles are still reclaimed
+    std::cout << "\nRunning an incremental collection...\n";
+    gc.setIncremental(true);
+    gc.setSliceBudget(std::chrono::microseconds(0));
+    gc.setThreshold(64 * 1024 * 1024);  // Only the collection started below
+    objectsBefore = gc.getStats().objectCount;
+    auto holder = GarbageCollector::makeGC<Object>();
+    for (int i = 0; i < 1000; i++) {
+        auto a = GarbageCollector::makeGC<Object>();
+        auto b = GarbageCollector::makeGC<Object>();
+        a->properties["ref"] = Value(b);
+        b->properties["ref"] = Value(a);
+        if (i % 2 == 0) holder->properties["item" + std::to_string(i)] = Value(a);
+    }
+    gc.startIncrementalCollection();
+    auto moved = GarbageCollector::makeGC<Object>();
+    size_t slices = 0;
+    for (int i = 0; gc.isCollecting(); i += 2, slices++) {
+        // Move an item out of the holder mid-collection
+        if (i < 1000) {
+            std::string key = "item" + std::to_string(i);
+            moved->properties[key] = holder->properties[key];
+            holder->properties[key] = Value(Undefined{});
+        }
+        gc.step();
+    }
+    stats = gc.getStats();
+    std::cout << "  Slices: " << slices << "\n";
+    std::cout << "  Max pause: " << stats.maxPause.count() << " microseconds\n";
+    size_t pauses = 0;
+    for (size_t count : stats.pauseHistogram) pauses += count;
+    bool movedIntact = true;
+    for (int i = 0; i < 1000; i += 2) {
+        Value item = moved->properties["item" + std::to_string(i)];
+        if (item.isUndefined()) item = holder->properties["item" + std::to_string(i)];
+        auto* a = item.isObject() ? item.getGC<Object>().get() : nullptr;
+        auto* b = a && a->properties["ref"].isObject() ? a->properties["ref"].getGC<Object>().get() : nullptr;
+        movedIntact = movedIntact && b && b->properties["ref"].isObject();
+    }
+    gc.setIncremental(false);
+    if (!movedIntact || stats.objectCount != objectsBefore + 1002 || slices < 2 || pauses == 0) {
+        std::cerr << "Incremental collection failed: " << stats.objectCount << " objects, expected "
+                  << objectsBefore + 1002 << ", " << slices << " slices\n";
+        return 1;
+    }
+
+    // Parallel collection: a heap large enough for the worker pool, with a
+    // long chain and a wide fan-out spread across the mark queues
+    std::cout << "\nRunning a parallel collection...\n";
+    gc.setThreadCount(4);
+    objectsBefore = gc.getStats().objectCount;
+    size_t parallelBefore = gc.getStats().parallelCollections;
+    auto root = GarbageCollector::makeGC<Object>();
+    {
+        GCPtr<Object> tail = root;
+        for (int i = 0; i < 2000; i++) {
+            auto next = GarbageCollector::makeGC<Object>();
+            tail->properties["next"] = Value(next);
+            tail = next;
+        }
+    }
+    for (int i = 0; i < 16000; i++) {
+        auto a = GarbageCollector::makeGC<Object>();
+        auto b = GarbageCollector::makeGC<Object>();
+        a->properties["ref"] = Value(b);
+        b->properties["ref"] = Value(a);
+        if (i % 2 == 0) root->properties["fan" + std::to_string(i)] = Value(a);
+    }
+    gc.collect();
+    stats = gc.getStats();
+    std::cout << "  Threads: " << gc.getThreadCount() << "\n";
+    std::cout << "  Subtract: " << stats.lastPhaseTimes.subtract.count() << " microseconds\n";
+    std::cout << "  Mark: " << stats.lastPhaseTimes.mark.count() << " microseconds\n";
+    std::cout << "  Sweep: " << stats.lastPhaseTimes.sweep.count() << " microseconds\n";
+    size_t chainLength = 0;
+    for (Object* node = root.get(); node->properties["next"].isObject(); chainLength++) {
+        node = node->properties["next"].getGC<Object>().get();
+    }
+    bool fanIntact = true;
+    for (int i = 0; i < 16000; i += 2) {
+        Value item = root->properties["fan" + std::to_string(i)];
+        auto* a = item.isObject() ? item.getGC<Object>().get() : nullptr;
+        fanIntact = fanIntact && a && a->properties["ref"].isObject();
+    }
+    gc.setThreadCount(1);
+    if (chainLength != 2000 || !fanIntact || stats.objectCount != objectsBefore + 18001 ||
+        stats.parallelCollections != parallelBefore + 1) {
+        std::cerr << "Parallel collection failed: " << stats.objectCount << " objects, expected "
+                  << objectsBefore + 18001 << ", chain of " << chainLength << "\n";
+        return 1;
+    }
+
+    // Arena: a freed slot is reused, and the pages of dead objects go back
+    std::cout << "\nChecking the object arena...\n";
+    void* slot = nullptr;
+    {
+        auto probe = GarbageCollector::makeGC<Object>();
+        slot = probe.get();
+    }
+    bool slotReused = GarbageCollector::makeGC<Object>().get() == slot;
+    size_t pagesBefore = gc.getStats().arenaPages;
+    size_t pagesGrown = 0;
+    {
+        std::vector<GCPtr<Object>> batch;
+        for (int i = 0; i < 20000; i++) batch.push_back(GarbageCollector::makeGC<Object>());
+        pagesGrown = gc.getStats().arenaPages;
+    }
+    size_t pagesAfter = gc.getStats().arenaPages;
+    std::cout << "  Pages: " << pagesBefore << " -> " << pagesGrown << " -> " << pagesAfter << "\n";
+    if (!slotReused || pagesGrown <= pagesBefore || pagesAfter > pagesBefore + 1) {
+        std::cerr << "Arena check failed\n";
+        return 1;
+    }
+
     std::cout << "\nGarbage collection test complete!\n";
 
     return 0;
@@ -97,7 +97,7 @@ void testMemoryTracking() {
 
   auto [result, hasError] = runScript(script);
   assert(!hasError && "Script should not error");
-  assert(result.isNumber() && std::get<double>(result.data) == 100);
+  assert(result.isNumber() && result.asNumber() == 100);
 
   // Check memory was tracked
   auto stats = gc.getStats();
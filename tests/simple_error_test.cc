@@ -34,7 +34,7 @@ int main() {
       auto error = *errorPtr;
       std::cout << "Error Type: " << error->getName() << "\n";
       std::cout << "Error Message: " << error->message << "\n";
-      std::cout << "Stack Trace:\n" << error->stack << "\n";
+      std::cout << "Stack Trace:\n" << error->stack() << "\n";
     }
     return 0;
   } else {
@@ -67,6 +67,62 @@ void runTest(const std::string& name, const std::string& code, const std::string
   std::cout << std::endl;
 }
 
+// Like runTest, but the result must be an array still stored as `kind`;
+// `expected` is its elements joined with ",".
+void runElementKindTest(const std::string& name, const std::string& code, const std::string& expected,
+                        Array::ElementKind kind) {
+  gTotalTests++;
+  std::cout << "Test: " << name << std::endl;
+
+  try {
+    Lexer lexer(code);
+    auto tokens = lexer.tokenize();
+
+    Parser parser(tokens);
+    auto program = parser.parse();
+    if (!program) {
+      std::cout << "  Parse error!" << std::endl;
+      gFailedTests++;
+      return;
+    }
+
+    auto env = Environment::createGlobal();
+    Interpreter interpreter(env);
+    setGlobalInterpreter(&interpreter);
+
+    auto task = interpreter.evaluate(*program);
+    Value result;
+    LIGHTJS_RUN_TASK(task, result);
+
+    std::string joined;
+    bool kindMatches = false;
+    if (result.isArray()) {
+      auto arr = result.getGC<Array>();
+      for (size_t i = 0; i < arr->elementCount(); ++i) {
+        if (i > 0) joined += ",";
+        joined += arr->element(i).toString();
+      }
+      kindMatches = arr->elementKind() == kind;
+    }
+    std::cout << "  Result: " << joined << std::endl;
+
+    if (joined != expected || !kindMatches) {
+      std::cout << "  FAILED! Expected: " << expected
+                << (kindMatches ? "" : " (element kind changed)") << std::endl;
+      gFailedTests++;
+    } else {
+      std::cout << "  PASSED" << std::endl;
+    }
+  } catch (const std::exception& e) {
+    std::cout << "  Error: " << e.what() << std::endl;
+    gFailedTests++;
+  }
+
+  setGlobalInterpreter(nullptr);
+
+  std::cout << std::endl;
+}
+
 int main() {
   std::cout << "=== LightJS C++20 Test Suite ===" << std::endl << std::endl;
 
@@ -2979,6 +3035,420 @@ int main() {
     ].join("|")
   )", "true|true|true|true|true|true");
 
+  runTest("Bytecode tier: hot loops and recursion", R"(
+    function fib(n) { return n < 2 ? n : fib(n - 1) + fib(n - 2); }
+    function sum(n) {
+      let total = 0;
+      for (let i = 0; i < n; i++) {
+        if (i % 3 === 0) continue;
+        total += i;
+      }
+      return total;
+    }
+    [fib(15), sum(10), sum(100), sum(1000)].join("|")
+  )", "610|27|3267|332667");
+
+  runTest("Bytecode tier: methods, globals and literals", R"(
+    let counter = 0;
+    class Point {
+      constructor(x, y) { this.x = x; this.y = y; }
+      norm1() { return Math.abs(this.x) + Math.abs(this.y); }
+    }
+    function bump(o) { counter++; o.hits = (o.hits ?? 0) + 1; return [o.hits, { n: counter }]; }
+    const o = {};
+    let out = [];
+    for (let i = 0; i < 100; i++) out.push(new Point(i, -i).norm1(), bump(o)[1].n);
+    out.slice(0, 4).join(",") + "," + out.slice(-4).join(",") + ":" + o.hits
+  )", "0,1,2,2,196,99,198,100:100");
+
+  runTest("Bytecode tier: TDZ and const errors stay intact", R"(
+    function tdz(flag) { if (flag) { return x; } let x = 1; return x; }
+    function constWrite() { const c = 1; c = 2; }
+    function readNull(o) { return o.p; }
+    // Before and after the functions turn hot, the errors are the same
+    const seen = new Set();
+    for (let i = 0; i < 100; i++) {
+      let msgs = [];
+      try { tdz(true); } catch (e) { msgs.push(e.name); }
+      try { constWrite(); } catch (e) { msgs.push(e.name); }
+      try { readNull(null); } catch (e) { msgs.push(e.name); }
+      seen.add(msgs.join(","));
+    }
+    [...seen].join("/") + "|" + tdz(false)
+  )", "ReferenceError,TypeError,TypeError|1");
+
+  runTest("Bytecode tier: strict self tail calls", R"(
+    "use strict";
+    function count(n, acc) { if (n === 0) return acc; return count(n - 1, acc + 1); }
+    count(1, 0) + count(2, 0) + count(50000, 0)
+  )", "50003");
+
+  runTest("Resolved identifiers respect eval, with and shadowing", R"(
+    var g = "global";
+    let out = [];
+    function shadow() {
+      let r = [];
+      for (let i = 0; i < 2; i++) r.push(g);
+      { let g = "inner"; r.push(g); }
+      return r.join(",");
+    }
+    function withScope(o) { let x = "local"; with (o) { return x; } }
+    function evalShadow(src) { var x = "fn"; function inner() { return x; } eval(src); return inner(); }
+    function mk(v) { return () => v; }
+    const a = mk(1), b = mk(2);
+    for (let i = 0; i < 2; i++) {
+      out.push(shadow(), withScope(i ? { x: "obj" } : {}), evalShadow(i ? "var x = 'eval'" : ""), a() + b());
+    }
+    out.join("|")
+  )", "global,global,inner|local|fn|3|global,global,inner|obj|eval|3");
+
+  runTest("Yield inside nested expressions of a generator", R"(
+    function* g(o) {
+      const a = o.x + (yield o.y) * 2;
+      const b = (yield a) ? o.x : (o.y, yield "no");
+      return [a, b].join(",");
+    }
+    const it = g({ x: 1, y: 5 });
+    const seen = [it.next().value, it.next(10).value, it.next(true).value];
+    seen.join("|")
+  )", "5|21|21,1");
+
+  runTest("Boxed string, symbol and BigInt values survive copies", R"(
+    const s = "abc".repeat(3);
+    const t = s;
+    const sym = Symbol("d");
+    const o = { [sym]: 1n << 70n };
+    const copy = { ...o };
+    [t, s === t, copy[sym] * 2n, String(sym), sym === Object.getOwnPropertySymbols(copy)[0]].join(",")
+  )", "abcabcabc,true,2361183241434822606848,Symbol(d),true");
+
+  runTest("Promise resolved with itself rejects with TypeError", R"(
+    const p = Promise.resolve(1).then(() => p);
+    let r;
+    try { await p; r = "fulfilled"; } catch (e) { r = e instanceof TypeError; }
+    r
+  )", "true", true);
+
+  runTest("Int32 arithmetic promotes to double on overflow and -0", R"(
+    const r = [2147483647 + 1, -2147483648 - 1, 65536 * 65536, 1 / (0 * -5), 1 / (-7 % 7),
+               -1 >>> 0, 7 % 3, -7 % 3, (1 << 31), -(-2147483648)];
+    let i = 2147483647; i++;
+    let k = 5; k *= -0;
+    r.push(i, 1 / k);
+    const m = new Map([[1, "one"]]);
+    r.push(m.get(0.5 * 2), new Set([3, 3.0, 6 / 2]).size, Object.is(4, 8 / 2));
+    r.join(",")
+  )", "2147483648,-2147483649,4294967296,-Infinity,-Infinity,4294967295,1,-1,-2147483648,2147483648,2147483648,-Infinity,one,1,true");
+
+  runTest("Integer-keyed element access keeps array semantics", R"(
+    const r = [];
+    const a = [1, 2, 3];
+    a[1] = 20; a[3] = 4; a[2] += 5; a[0] |= 8;
+    r.push(a.join("|"), a.length);
+    const h = [1, , 3];
+    Array.prototype[1] = "proto"; r.push(h[1]); delete Array.prototype[1];
+    const f = Object.freeze([1, 2]); f[0] = 9; r.push(f[0]);
+    const g = [0]; Object.defineProperty(g, 0, { get() { return "getter"; } }); r.push(g[0]);
+    const t = new Int16Array(2); t[0] = 70000; t[1] += 3; r.push(t[0], t[1], t[5]);
+    r.join(",")
+  )", "9|20|8|4,4,proto,1,getter,4464,3,");
+
+  runTest("Array element kinds widen from int32 to double to generic", R"(
+    const r = [];
+    const a = [1, 2, 3];
+    a.push(4); a[1] = 2.5; a[4] = -0;
+    r.push(a.join("|"), 1 / a[4], a.length);
+    a[2] = "x"; a.push(NaN);
+    r.push(a.join("|"), a.length);
+    const b = [3, 1, 2]; b.sort();
+    r.push(b.join("|"), b.map(x => x / 2).join("|"), b.reduce((s, x) => s + x, 0));
+    const c = [1, , 3]; r.push(1 in c, c.indexOf(3));
+    const d = [1, 2, 3]; d.length = 1; d.push(0.5); r.push(d.join("|"));
+    r.join(",")
+  )", "1|2.5|3|4|0,-Infinity,5,1|2.5|x|4|0|NaN,6,1|2|3,0.5|1|1.5,6,false,2,1|0.5");
+
+  runTest("Map and Set hash lookups keep order and live iteration", R"(
+    const r = [];
+    const m = new Map();
+    for (let i = 0; i < 2000; i++) m.set("k" + i, i);
+    for (let i = 0; i < 1990; i++) m.delete("k" + i);
+    r.push(m.size, [...m.keys()].join("|"), m.get("k1995"), m.has("k5"));
+    const s = new Set([1, 2, 3, 4, 5]);
+    const seen = [];
+    for (const v of s) {
+      seen.push(v);
+      if (v === 1) { s.delete(2); s.add(6); }
+      if (v === 3) s.delete(4);
+    }
+    r.push(seen.join("|"));
+    const z = new Set([-0, 0, NaN, NaN, 1, 1.0]);
+    r.push(z.size, Object.is([...z][0], 0));
+    const o = {};
+    const keys = new Map([[o, "obj"], [10n, "big"], ["10", "str"]]);
+    r.push(keys.get(o), keys.get(10n), keys.get(10), keys.get("10"));
+    const c = new Map([[1, "a"], [2, "b"]]);
+    const it = c.values();
+    r.push(it.next().value);
+    c.clear(); c.set(3, "c");
+    r.push(it.next().value, it.next().done);
+    r.join(",")
+  )", "10,k1990|k1991|k1992|k1993|k1994|k1995|k1996|k1997|k1998|k1999,1995,false,1|3|5|6,3,true,obj,big,,str,a,c,true");
+
+  runTest("Shaped objects keep property order and cached reads", R"(
+    const r = [];
+    function P(x, y) { this.x = x; this.y = y; }
+    const pts = [new P(1, 2), new P(3, 4), { y: 5, x: 6 }, { get x() { return 7; }, y: 8 }];
+    let sum = 0;
+    for (let k = 0; k < 3; k++) for (const p of pts) sum += p.x * 10 + p.y;
+    r.push(sum);
+    const o = { a: 1, b: 2, c: 3 };
+    delete o.b; o.d = 4; o.b = 5;
+    r.push(Object.keys(o).join("|"), o.b);
+    const last = { a: 1, b: 2 }; delete last.b; last.c = 3;
+    r.push(Object.keys(last).join("|"));
+    const big = {};
+    for (let i = 0; i < 100; i++) big["k" + i] = i;
+    r.push(Object.keys(big).length, big.k99, Object.keys(big)[64]);
+    const f = Object.freeze({ v: 1 }); f.v = 2; r.push(f.v);
+    r.join(",")
+  )", "567,a|c|d|b,5,a|c,100,99,k64,1");
+
+  runTest("Atom-keyed scopes and shapes resolve many names", R"(
+    const r = [];
+    function wide() {
+      let a = 1, b = 2, c = 3, d = 4, e = 5, f = 6, g = 7, h = 8, i = 9, j = 10;
+      const inner = () => a + j + (() => { let j = 100; return j + i; })();
+      return inner() + b + c + d + e + f + g + h;
+    }
+    r.push(wide());
+    const small = { p: 1, q: 2 };
+    const large = { a: 1, b: 2, c: 3, d: 4, e: 5, f: 6, g: 7, h: 8, i: 9, j: 10 };
+    r.push(small.q, large.j, large.a, "j" in large, "z" in large);
+    var gone = 1;
+    r.push(typeof globalThis.gone, delete globalThis.undeclaredName);
+    globalThis.later = 42;
+    r.push(later);
+    r.join(",")
+  )", "155,2,10,1,true,false,number,true,42");
+
+  runTest("Accessor and prototype slots resolve through shapes and dictionaries", R"(
+    const r = [];
+    const base = { get v() { return this.k * 2; }, set w(x) { this.k = x; } };
+    const o = Object.create(base);
+    o.k = 4;
+    r.push(o.v, o.w);
+    o.w = 10;
+    r.push(o.v);
+    const big = Object.create(base);
+    for (let i = 0; i < 80; i++) big["p" + i] = i;
+    Object.defineProperty(big, "g", { get() { return "dict"; }, configurable: true });
+    big.k = 1;
+    r.push(big.g, big.v, big.p79);
+    delete big.g;
+    r.push(big.g);
+    const leaf = {};
+    Object.setPrototypeOf(leaf, { inherited: "yes" });
+    r.push(leaf.inherited, "inherited" in leaf);
+    r.join(",")
+  )", "8,,20,dict,2,79,,yes,true");
+
+  runTest("Prototype inline caches follow chain changes", R"(
+    const r = [];
+    class A { m() { return "A"; } }
+    class B extends A {}
+    const objs = [new B(), new B()];
+    const call = () => objs.map(o => o.m()).join("");
+    r.push(call());
+    A.prototype.m = function() { return "a"; };
+    r.push(call());
+    B.prototype.m = function() { return "b"; };
+    r.push(call());
+    Object.setPrototypeOf(objs[1], { m() { return "x"; } });
+    r.push(call());
+    delete B.prototype.m;
+    r.push(call());
+    Object.defineProperty(A.prototype, "m", { get() { return () => "g"; }, configurable: true });
+    r.push(call());
+    r.join(",")
+  )", "AA,aa,bb,bx,ax,gx");
+
+  runTest("Global binding caches track redefinition and shadowing", R"(
+    var counter = 0;
+    function bump(n) { return n + 1; }
+    function run() { let s = 0; for (let i = 0; i < 5; i++) s += bump(Math.abs(-i)); return s; }
+    const r = [run()];
+    bump = function(n) { return n * 10; };
+    r.push(run());
+    function shadow(Math) { return Math; }
+    r.push(shadow(7));
+    function readLater() { return typeof later === "undefined" ? "none" : later; }
+    r.push(readLater());
+    globalThis.later = "prop";
+    r.push(readLater());
+    var reg = "one";
+    const readReg = () => reg;
+    r.push(readReg());
+    reg = "two";
+    r.push(readReg());
+    r.join(",")
+  )", "15,100,7,none,prop,one,two");
+
+  runTest("Closures from one site share a template but keep their own state", R"(
+    const makers = [];
+    for (let i = 0; i < 200; i++) {
+      makers.push(function (x, y = i, ...rest) { return x * 1000 + y + rest.length; });
+    }
+    const adders = [];
+    for (let i = 0; i < 50; i++) adders.push(x => x + i);
+    let sum = 0;
+    for (let k = 0; k < 300; k++) for (const add of adders) sum += add(1);
+    class P { m(a, b = 2) { return a + b; } }
+    const f = new Function("a", "b", "return a - b;");
+    makers[3].tag = "own";
+    [makers[0](1), makers[199](2, undefined, 9, 9), makers[7].length, makers[7].tag === undefined,
+     makers[3].tag, sum, new P().m(1), P.prototype.m.length, f(9, 4), f.length].join(",")
+  )", "1000,2201,1,true,own,382500,3,1,5,2");
+
+  runTest("Arguments objects are built only where they can be observed", R"(
+    function count() { return arguments.length; }
+    function viaArrow() { return (() => arguments[1])(); }
+    function viaEval() { return eval("arguments[0]"); }
+    function mapped(a) { arguments[0] = 9; return a; }
+    function plain(a, b) { return typeof a + typeof b; }
+    function inner() { return function () { return typeof arguments; }(); }
+    function shadow() { var arguments = 3; return arguments; }
+    class C { constructor() { this.n = arguments.length; } }
+    function f() { eval("var v = 1"); return typeof v; }
+    [count(1, 2, 3), viaArrow(4, 5), viaEval(6), mapped(1), plain(1), inner(),
+     shadow(), new C(1, 2).n, f()].join(",")
+  )", "3,5,6,9,numberundefined,object,3,2,number");
+
+  runTest("Native builtins throw typed errors without exceptions", R"(
+    function kind(f) { try { f(); return "none"; } catch (e) { return e.constructor.name + ":" + (e instanceof Error); } }
+    let deep = "[".repeat(600) + "]".repeat(600);
+    let thrown = {};
+    let it = { [Symbol.iterator]() { throw thrown; } };
+    let rethrown = false;
+    try { Math.sumPrecise(it); } catch (e) { rethrown = e === thrown; }
+    [kind(() => JSON.parse("{bad")), kind(() => JSON.parse(deep)),
+     kind(() => String.prototype.at.call(null, 0)), kind(() => Map.prototype.get.call({}, 1)),
+     kind(() => Math.sumPrecise(1)), rethrown, JSON.parse("[1,{\"a\":2}]")[1].a].join(",")
+  )", "SyntaxError:true,RangeError:true,TypeError:true,TypeError:true,TypeError:true,true,2");
+
+  runTest("Stack traces are captured at throw and formatted on read", R"(
+    function inner() { null.x; }
+    function outer() { inner(); }
+    let caught;
+    try { outer(); } catch (e) { caught = e; }
+    let s = caught.stack;
+    let outerAt = s.indexOf("at outer"), innerAt = s.indexOf("at inner");
+    caught.stack = "replaced";
+    [s.startsWith("TypeError: "), outerAt > 0, innerAt > outerAt, caught.stack].join(",")
+  )", "true,true,true,replaced");
+
+  runTest("For-let loops copy bindings per iteration only when captured", R"(
+    let sum = 0;
+    for (let i = 0, j = 10; i < 5; i++, j--) { let k = i * j; sum += k; }
+    let fns = [];
+    for (let i = 0; i < 3; i++) { fns.push(() => i); }
+    let evals = [];
+    for (let i = 0; i < 2; i++) { evals.push(eval("i")); }
+    let classes = [];
+    for (let i = 0; i < 2; i++) { classes.push(class { static v = i; }); }
+    [sum, fns.map(f => f()).join(""), evals.join(""), classes[0].v + classes[1].v].join(",")
+  )", "70,012,01,1");
+
+  runTest("Recycled scopes do not leak bindings into captured ones", R"(
+    let kept = [];
+    function make(n) {
+      let a = n, b = n * 2;
+      { let c = a + b; if (n % 3 === 0) kept.push(() => a + b + c); }
+      return a;
+    }
+    let total = 0;
+    for (let i = 0; i < 300; i++) { total += make(i); { let x = i; total -= x; } }
+    function deep(n) { let v = n; return n === 0 ? v : deep(n - 1) + v; }
+    [total, kept.length, kept[0](), kept[5](), kept[99](), deep(50)].join(",")
+  )", "0,100,0,90,1782,1275");
+
+  runTest("Fast-convention builtins keep their receiver and error behavior", R"(
+    let order = [];
+    let a = { valueOf() { order.push("a"); return NaN; } };
+    let b = { valueOf() { order.push("b"); return 1; } };
+    let r = [Math.max(a, b), order.join(""), Math.min(), Math.max(-0, 0)];
+    r.push("abc".charAt(1), new String("xyz").slice(-2), String.prototype.toUpperCase.call(12));
+    let m = new Map();
+    r.push(m.set("k", 1) === m, m.get("k"), m.has("x"), m.delete("k"), m.size);
+    try { Map.prototype.get.call({}, "k"); } catch (e) { r.push(e instanceof TypeError); }
+    let arr = [1];
+    r.push(arr.push(2, 3), Array.prototype.push.apply(arr, [4]), arr.join(""));
+    r.push({ x: 1 }.hasOwnProperty("x"), Object.prototype.hasOwnProperty.call([5], "0"));
+    function hot(s, i) { return s.charCodeAt(i) + Math.abs(-i); }
+    let sum = 0;
+    for (let i = 0; i < 2000; i++) sum += hot("ab", i % 2);
+    r.push(sum);
+    r.join(",");
+  )", "NaN,ab,Infinity,0,b,yz,12,true,1,false,true,0,true,3,4,1234,true,true,196000");
+
+  runTest("Reads after a let declaration skip TDZ checks; earlier ones still throw", R"(
+    let r = [];
+    function tdz(f) { try { f(); return "ok"; } catch (e) { return e.constructor.name; } }
+    r.push(tdz(() => { let x = 1; { x; let x = 2; } }));
+    r.push(tdz(() => { early(); let v = 1; function early() { return v; } }));
+    r.push(tdz(() => { let x = [1]; for (let x of x) {} }));
+    r.push(tdz(() => { let [a, b = a] = [3]; typeof a; a = b; }));
+    let total = 0;
+    for (let i = 0, j = i; i < 100; i++) { const k = i; total += k + j; }
+    for (const [k, v] of [[1, 2]]) { let w = k + v; total += w; }
+    r.push(total);
+    r.join(",");
+  )", "ReferenceError,ReferenceError,ReferenceError,ok,4953");
+
+  const std::string packedStackOps = R"(
+    let a = [1, 2, 3, 4, 5];
+    a.push(6);
+    a.pop();
+    a.shift();
+    a.unshift(0, 1);
+    a.splice(1, 2, 7, 8, 9);
+    a.reverse();
+    let b = a.slice(1, 4);
+    b.push(a.pop());
+  )";
+  runElementKindTest("Int arrays stay packed across stack operations", packedStackOps + "a",
+                     "5,4,3,9,8,7", Array::ElementKind::PackedInt32);
+  runElementKindTest("Slice of a packed array is packed", packedStackOps + "b",
+                     "4,3,9,0", Array::ElementKind::PackedInt32);
+  runElementKindTest("Splice widens only as far as needed", R"(
+    let a = [1, 2, 3];
+    a.splice(1, 1, 2.5);
+    a
+  )", "1,2.5,3", Array::ElementKind::PackedDouble);
+
+  runTest("Array and Set builtins on the fast native convention", R"(
+    const r = [];
+    const boom = { tag: "boom" };
+    try { [1, 2].map(() => { throw boom; }); } catch (e) { r.push(e === boom); }
+    try { Array.prototype.forEach.call(null, () => {}); } catch (e) { r.push(e instanceof TypeError); }
+    r.push(Array.prototype.indexOf.call({ length: 2, 0: "a", 1: "b" }, "b"));
+    r.push([3, 1, 2].sort((x, y) => x - y).join("-"));
+    const s = new Set();
+    r.push(s.add(1) === s, s.has(1), s.delete(1), s.has(1));
+    try { Set.prototype.has.call({}, 1); } catch (e) { r.push(e instanceof TypeError); }
+    r.join(",");
+  )", "true,true,1,1-2-3,true,true,true,false,true");
+
+  runTest("Array builtins report errors as throw completions", R"(
+    const r = [];
+    const boom = { tag: "boom" };
+    try { Array.from([1], () => { throw boom; }); } catch (e) { r.push(e === boom); }
+    try { new Array(-1); } catch (e) { r.push(e instanceof RangeError); }
+    try { [][Symbol.iterator]().next.call({}); } catch (e) { r.push(e instanceof TypeError); }
+    try { [{ toLocaleString() { throw boom; } }].toLocaleString(); } catch (e) { r.push(e === boom); }
+    r.push(Array.from({ length: 2, 0: "x" }).length, [...[1, 2].entries()].join(";"), String([1, [2, 3]]));
+    r.join(",");
+  )", "true,true,true,true,2,0,1;1,2,1,2,3");
+
   std::cout << "=== All tests completed ===" << std::endl;
   std::cout << "Summary: " << (gTotalTests - gFailedTests) << "/" << gTotalTests
             << " passed, " << gFailedTests << " failed" << std::endl;